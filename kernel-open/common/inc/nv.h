@@ -458,6 +458,52 @@ typedef struct nv_state_t
 
 } nv_state_t;
 
+/*
+ * Per-function GSP RPC latency profile, as reported by rm_get_rpc_profile().
+ */
+#define NV_RPC_PROFILE_MAX_ENTRIES      32
+#define NV_RPC_PROFILE_FUNCTION_END     0xFFFFFFFF
+
+typedef struct
+{
+    NvU32 function;
+    NvU64 count;
+    NvU64 p50Ns;
+    NvU64 p99Ns;
+    NvU64 maxNs;
+    NvU64 totalNs;
+    NvU64 bytesSent;
+    NvU64 bytesReceived;
+} nv_rpc_profile_entry_t;
+
+/*
+ * RM control cache counters, as reported by rm_get_control_cache_stats().
+ */
+typedef struct
+{
+    NvU64 hits;
+    NvU64 misses;
+    NvU64 evictions;
+    NvU64 entries;
+    NvU64 maxEntries;
+} nv_control_cache_stats_t;
+
+/*
+ * Resource server slab allocator counters for one size class, as reported by
+ * rm_get_resserv_slab_stats().
+ */
+#define NV_RESSERV_SLAB_SIZE_CLASS_COUNT 6
+
+typedef struct
+{
+    NvU64 objectSize;
+    NvU64 allocs;
+    NvU64 frees;
+    NvU64 cacheMisses;
+    NvU64 cacheOverflows;
+    NvU64 depotExchanges;
+} nv_resserv_slab_stats_t;
+
 // These define need to be in sync with defines in system.h
 #define OS_TYPE_LINUX   0x1
 #define OS_TYPE_FREEBSD 0x2
@@ -920,6 +966,9 @@ char*      NV_API_CALL  rm_get_gpu_uuid          (nvidia_stack_t *, nv_state_t *
 const NvU8* NV_API_CALL rm_get_gpu_uuid_raw      (nvidia_stack_t *, nv_state_t *);
 void       NV_API_CALL  rm_set_rm_firmware_requested(nvidia_stack_t *, nv_state_t *);
 void       NV_API_CALL  rm_get_firmware_version  (nvidia_stack_t *, nv_state_t *, char *, NvLength);
+NV_STATUS  NV_API_CALL  rm_get_rpc_profile       (nvidia_stack_t *, nv_state_t *, NvU32 *, nv_rpc_profile_entry_t *, NvU32 *);
+NV_STATUS  NV_API_CALL  rm_get_control_cache_stats(nvidia_stack_t *, nv_control_cache_stats_t *);
+NV_STATUS  NV_API_CALL  rm_get_resserv_slab_stats(nvidia_stack_t *, nv_resserv_slab_stats_t *);
 void       NV_API_CALL  rm_cleanup_file_private  (nvidia_stack_t *, nv_state_t *, nv_file_private_t *);
 void       NV_API_CALL  rm_unbind_lock           (nvidia_stack_t *, nv_state_t *);
 NV_STATUS  NV_API_CALL  rm_read_registry_dword   (nvidia_stack_t *, nv_state_t *, const char *, NvU32 *);
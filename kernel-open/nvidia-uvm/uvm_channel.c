@@ -324,11 +324,13 @@ NV_STATUS uvm_channel_begin_push(uvm_channel_t *channel, uvm_push_t *push)
 
 
 
+    // The pushbuffer uses the channel to pick a chunk
+    push->channel = channel;
+
     status = uvm_pushbuffer_begin_push(manager->pushbuffer, push);
     if (status != NV_OK)
         return status;
 
-    push->channel = channel;
     push->channel_tracking_value = 0;
     push->push_info_index = channel_get_available_push_info_index(channel);
 
@@ -462,8 +462,10 @@ static void gpu_info_print_common(uvm_gpu_t *gpu, struct seq_file *s)
                              gpu->parent->fault_buffer_info.max_batch_size);
         UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_replay_policy        %s\n",
                              uvm_perf_fault_replay_policy_string(gpu->parent->fault_buffer_info.replayable.replay_policy));
+        UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_service_workers      %u\n",
+                             max(gpu->parent->fault_buffer_info.replayable.parallel.num_workers, 1u));
         UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults_num_faults           %llu\n",
-                             gpu->parent->stats.num_replayable_faults);
+                             (NvU64)atomic64_read(&gpu->parent->stats.num_replayable_faults));
     }
     if (gpu->parent->isr.non_replayable_faults.handling) {
         UVM_SEQ_OR_DBG_PRINT(s, "non_replayable_faults_bh               %llu\n",
@@ -517,6 +519,38 @@ static void gpu_info_print_common(uvm_gpu_t *gpu, struct seq_file *s)
                          mapped_cpu_pages_size / PAGE_SIZE,
                          mapped_cpu_pages_size / (1024u * 1024u));
 
+    if (uvm_gpu_supports_eviction(gpu)) {
+        NvU64 num_refaults = atomic64_read(&gpu->pmm.eviction.num_refaults);
+        NvU64 refault_distance_sum = atomic64_read(&gpu->pmm.eviction.refault_distance_sum);
+
+        UVM_SEQ_OR_DBG_PRINT(s, "eviction_policy                        %s\n",
+                             uvm_pmm_gpu_eviction_policy_string(gpu->pmm.eviction.policy));
+        UVM_SEQ_OR_DBG_PRINT(s, "eviction_root_chunks                   %llu\n",
+                             (NvU64)atomic64_read(&gpu->pmm.eviction.num_evictions));
+        UVM_SEQ_OR_DBG_PRINT(s, "eviction_second_chances                %llu\n",
+                             gpu->pmm.eviction.num_second_chances);
+        UVM_SEQ_OR_DBG_PRINT(s, "eviction_refaults                      %llu\n", num_refaults);
+        UVM_SEQ_OR_DBG_PRINT(s, "eviction_refault_distance_avg          %llu\n",
+                             num_refaults ? refault_distance_sum / num_refaults : 0);
+    }
+
+    if (gpu->pmm.zero_pool.enabled) {
+        NvU64 bytes_claimed = atomic64_read(&gpu->pmm.zero_pool.bytes_claimed);
+
+        UVM_SEQ_OR_DBG_PRINT(s, "zero_pool_depth                        %u root chunks\n",
+                             uvm_pmm_gpu_zero_pool_depth(&gpu->pmm));
+        UVM_SEQ_OR_DBG_PRINT(s, "zero_pool_zeroed                       %llu root chunks\n",
+                             (NvU64)atomic64_read(&gpu->pmm.zero_pool.num_zeroed));
+        UVM_SEQ_OR_DBG_PRINT(s, "zero_pool_claimed                      %llu (%llu MB)\n",
+                             bytes_claimed,
+                             bytes_claimed / (1024u * 1024u));
+    }
+
+    UVM_SEQ_OR_DBG_PRINT(s, "evicted_masks_compact                  %llu\n",
+                         (NvU64)atomic64_read(&gpu->va_block_evicted_masks.num_compact));
+    UVM_SEQ_OR_DBG_PRINT(s, "evicted_masks_full                     %llu\n",
+                         (NvU64)atomic64_read(&gpu->va_block_evicted_masks.num_full));
+
     gpu_info_print_ce_caps(gpu, s);
 
 
@@ -535,18 +569,19 @@ gpu_fault_stats_print_common(uvm_parent_gpu_t *parent_gpu, struct seq_file *s)
 
     UVM_ASSERT(uvm_procfs_is_debug_enabled());
 
-    UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults      %llu\n", parent_gpu->stats.num_replayable_faults);
+    UVM_SEQ_OR_DBG_PRINT(s, "replayable_faults      %llu\n",
+                         (NvU64)atomic64_read(&parent_gpu->stats.num_replayable_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "duplicates             %llu\n",
-                         parent_gpu->fault_buffer_info.replayable.stats.num_duplicate_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer_info.replayable.stats.num_duplicate_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "faults_by_access_type:\n");
     UVM_SEQ_OR_DBG_PRINT(s, "  prefetch             %llu\n",
-                         parent_gpu->fault_buffer_info.replayable.stats.num_prefetch_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer_info.replayable.stats.num_prefetch_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "  read                 %llu\n",
-                         parent_gpu->fault_buffer_info.replayable.stats.num_read_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer_info.replayable.stats.num_read_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "  write                %llu\n",
-                         parent_gpu->fault_buffer_info.replayable.stats.num_write_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer_info.replayable.stats.num_write_faults));
     UVM_SEQ_OR_DBG_PRINT(s, "  atomic               %llu\n",
-                         parent_gpu->fault_buffer_info.replayable.stats.num_atomic_faults);
+                         (NvU64)atomic64_read(&parent_gpu->fault_buffer_info.replayable.stats.num_atomic_faults));
     num_pages_out = atomic64_read(&parent_gpu->fault_buffer_info.replayable.stats.num_pages_out);
     num_pages_in = atomic64_read(&parent_gpu->fault_buffer_info.replayable.stats.num_pages_in);
     UVM_SEQ_OR_DBG_PRINT(s, "migrations:\n");
@@ -559,6 +594,17 @@ gpu_fault_stats_print_common(uvm_parent_gpu_t *parent_gpu, struct seq_file *s)
                          parent_gpu->fault_buffer_info.replayable.stats.num_replays);
     UVM_SEQ_OR_DBG_PRINT(s, "  start_ack_all        %llu\n",
                          parent_gpu->fault_buffer_info.replayable.stats.num_replays_ack_all);
+    UVM_SEQ_OR_DBG_PRINT(s, "parallel_batches       %llu\n",
+                         parent_gpu->fault_buffer_info.replayable.stats.num_parallel_batches);
+    UVM_SEQ_OR_DBG_PRINT(s, "time_by_phase_ns:\n");
+    UVM_SEQ_OR_DBG_PRINT(s, "  fetch                %llu\n",
+                         parent_gpu->fault_buffer_info.replayable.stats.fetch_time_ns);
+    UVM_SEQ_OR_DBG_PRINT(s, "  preprocess           %llu\n",
+                         parent_gpu->fault_buffer_info.replayable.stats.preprocess_time_ns);
+    UVM_SEQ_OR_DBG_PRINT(s, "  service              %llu\n",
+                         parent_gpu->fault_buffer_info.replayable.stats.service_time_ns);
+    UVM_SEQ_OR_DBG_PRINT(s, "  replay               %llu\n",
+                         parent_gpu->fault_buffer_info.replayable.stats.replay_time_ns);
     UVM_SEQ_OR_DBG_PRINT(s, "non_replayable_faults  %llu\n", parent_gpu->stats.num_non_replayable_faults);
     UVM_SEQ_OR_DBG_PRINT(s, "faults_by_access_type:\n");
     UVM_SEQ_OR_DBG_PRINT(s, "  read                 %llu\n",
@@ -1230,6 +1276,12 @@ static NV_STATUS init_gpu(uvm_gpu_t *gpu, const UvmGpuInfo *gpu_info)
         return status;
     }
 
+    status = uvm_pmm_gpu_zero_pool_start(&gpu->pmm);
+    if (status != NV_OK) {
+        UVM_ERR_PRINT("Failed to start the PMM zero pool: %s, GPU %s\n", nvstatusToString(status), uvm_gpu_name(gpu));
+        return status;
+    }
+
     return NV_OK;
 }
 
@@ -1450,6 +1502,10 @@ static void deinit_gpu(uvm_gpu_t *gpu)
 {
     uvm_gpu_t *other_gpu;
 
+    // Stop zeroing free root chunks before any of the GPU state it relies on
+    // is torn down.
+    uvm_pmm_gpu_zero_pool_stop(&gpu->pmm);
+
     // Remove any pointers to this GPU from other GPUs' trackers.
     for_each_global_gpu(other_gpu) {
         UVM_ASSERT(other_gpu != gpu);
@@ -1632,25 +1688,25 @@ static void update_stats_gpu_fault_instance(uvm_gpu_t *gpu,
     switch (fault_entry->fault_access_type)
     {
         case UVM_FAULT_ACCESS_TYPE_PREFETCH:
-            ++gpu->parent->fault_buffer_info.replayable.stats.num_prefetch_faults;
+            atomic64_inc(&gpu->parent->fault_buffer_info.replayable.stats.num_prefetch_faults);
             break;
         case UVM_FAULT_ACCESS_TYPE_READ:
-            ++gpu->parent->fault_buffer_info.replayable.stats.num_read_faults;
+            atomic64_inc(&gpu->parent->fault_buffer_info.replayable.stats.num_read_faults);
             break;
         case UVM_FAULT_ACCESS_TYPE_WRITE:
-            ++gpu->parent->fault_buffer_info.replayable.stats.num_write_faults;
+            atomic64_inc(&gpu->parent->fault_buffer_info.replayable.stats.num_write_faults);
             break;
         case UVM_FAULT_ACCESS_TYPE_ATOMIC_WEAK:
         case UVM_FAULT_ACCESS_TYPE_ATOMIC_STRONG:
-            ++gpu->parent->fault_buffer_info.replayable.stats.num_atomic_faults;
+            atomic64_inc(&gpu->parent->fault_buffer_info.replayable.stats.num_atomic_faults);
             break;
         default:
             break;
     }
     if (is_duplicate || fault_entry->filtered)
-        ++gpu->parent->fault_buffer_info.replayable.stats.num_duplicate_faults;
+        atomic64_inc(&gpu->parent->fault_buffer_info.replayable.stats.num_duplicate_faults);
 
-    ++gpu->parent->stats.num_replayable_faults;
+    atomic64_inc(&gpu->parent->stats.num_replayable_faults);
 }
 
 static void update_stats_fault_cb(uvm_perf_event_t event_id, uvm_perf_event_data_t *event_data)
@@ -3062,6 +3118,55 @@ exit_unlock:
     return status;
 }
 
+static NvU32 instance_ptr_cache_slot(uvm_gpu_phys_address_t instance_ptr, NvU32 tag)
+{
+    // Instance pointers are 4K-aligned
+    return (NvU32)((instance_ptr.address >> 12) ^ tag) % UVM_INSTANCE_PTR_CACHE_SIZE;
+}
+
+void uvm_instance_ptr_cache_reset(uvm_instance_ptr_cache_t *cache)
+{
+    // Generation 0 is never valid, so all the entries need to be cleared on
+    // wrap-around
+    if (++cache->generation == 0) {
+        memset(cache->entries, 0, sizeof(cache->entries));
+        cache->generation = 1;
+    }
+}
+
+bool uvm_instance_ptr_cache_find(uvm_instance_ptr_cache_t *cache,
+                                 uvm_gpu_phys_address_t instance_ptr,
+                                 NvU32 tag,
+                                 uvm_va_space_t **out_va_space)
+{
+    NvU32 slot = instance_ptr_cache_slot(instance_ptr, tag);
+
+    UVM_ASSERT(cache->generation != 0);
+
+    if (cache->entries[slot].generation != cache->generation ||
+        cache->entries[slot].tag != tag ||
+        uvm_gpu_phys_addr_cmp(cache->entries[slot].instance_ptr, instance_ptr) != 0)
+        return false;
+
+    *out_va_space = cache->entries[slot].va_space;
+    return true;
+}
+
+void uvm_instance_ptr_cache_insert(uvm_instance_ptr_cache_t *cache,
+                                   uvm_gpu_phys_address_t instance_ptr,
+                                   NvU32 tag,
+                                   uvm_va_space_t *va_space)
+{
+    NvU32 slot = instance_ptr_cache_slot(instance_ptr, tag);
+
+    UVM_ASSERT(cache->generation != 0);
+
+    cache->entries[slot].instance_ptr = instance_ptr;
+    cache->entries[slot].tag = tag;
+    cache->entries[slot].generation = cache->generation;
+    cache->entries[slot].va_space = va_space;
+}
+
 void uvm_gpu_remove_user_channel(uvm_gpu_t *gpu, uvm_user_channel_t *user_channel)
 {
     uvm_va_space_t *va_space;
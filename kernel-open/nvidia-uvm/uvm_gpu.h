@@ -44,6 +44,7 @@
 #include "uvm_va_block_types.h"
 #include "uvm_perf_module.h"
 #include "uvm_rb_tree.h"
+#include "uvm_radix_sort.h"
 #include "nv-kthread-q.h"
 
 
@@ -77,6 +78,31 @@ typedef struct
     uvm_fault_buffer_entry_t *last_fault;
 } uvm_fault_utlb_info_t;
 
+#define UVM_INSTANCE_PTR_CACHE_SIZE 16
+
+// Direct-mapped cache of instance pointer to VA space translations. The bottom
+// halves use it to look up each {instance_ptr, tag} pair of a batch in the
+// GPU's instance_ptr_table only once, without sorting the batch by instance
+// pointer first. Channels can be destroyed between batches, so the cache must
+// be reset before each one. See uvm_instance_ptr_cache_reset.
+typedef struct
+{
+    struct
+    {
+        uvm_gpu_phys_address_t instance_ptr;
+
+        // Caller-defined discriminator, such as the subcontext id
+        NvU32 tag;
+
+        // The entry is valid only if it matches the cache generation
+        NvU32 generation;
+
+        uvm_va_space_t *va_space;
+    } entries[UVM_INSTANCE_PTR_CACHE_SIZE];
+
+    NvU32 generation;
+} uvm_instance_ptr_cache_t;
+
 struct uvm_service_block_context_struct
 {
     //
@@ -201,13 +227,28 @@ struct uvm_fault_service_batch_context_struct
 
     uvm_tracker_t tracker;
 
-    // Boolean used to avoid sorting the fault batch by instance_ptr if we
-    // determine at fetch time that all the faults in the batch report the same
+    // Boolean used to avoid instance_ptr translation lookups if we determine
+    // at fetch time that all the faults in the batch report the same
     // instance_ptr
     bool is_single_instance_ptr;
 
     // Last fetched fault. Used for fault filtering.
     uvm_fault_buffer_entry_t *last_fault;
+
+    // Translations of the instance pointers seen in the current batch
+    uvm_instance_ptr_cache_t instance_ptr_cache;
+
+    // Arrays used to radix sort the ordered view of the batch. The number of
+    // elements in each array is exactly max_faults
+    uvm_radix_sort_entry_t *sort_entries;
+
+    uvm_radix_sort_entry_t *sort_scratch;
+
+    // VA range of the last managed fault serviced, used to skip the VA range
+    // tree walk for the following faults of the sorted batch. It is reset
+    // whenever the VA space lock is dropped. See
+    // uvm_va_block_find_create_hint.
+    uvm_va_range_t *va_range_hint;
 };
 
 struct uvm_ats_fault_invalidate_struct
@@ -219,6 +260,37 @@ struct uvm_ats_fault_invalidate_struct
     uvm_tlb_batch_t write_faults_tlb_batch;
 };
 
+// State of one of the threads servicing a replayable fault batch in parallel.
+// See uvm_perf_fault_service_workers in uvm_gpu_replayable_faults.c.
+typedef struct
+{
+    // Queue and item used to run the worker. They are not initialized for the
+    // first worker, which always runs on the bottom-half thread.
+    nv_kthread_q_t q;
+
+    nv_kthread_q_item_t q_item;
+
+    uvm_parent_gpu_t *parent_gpu;
+
+    // Private view of the batch being serviced. The fault arrays are shared
+    // with the bottom-half batch context, while the counters, flags and
+    // tracker are merged back into it once all the workers are done.
+    uvm_fault_service_batch_context_t batch_context;
+
+    // Structure used to coalesce fault servicing in a VA block
+    uvm_service_block_context_t block_service_context;
+
+    // Information required to invalidate stale ATS PTEs from the GPU TLBs
+    uvm_ats_fault_invalidate_t ats_invalidate;
+
+    // Result of the last servicing pass of this worker
+    NV_STATUS status;
+
+    // VA space whose GPU VA space was found to need a fault buffer flush in
+    // the last servicing pass, if any
+    uvm_va_space_t *flush_va_space;
+} uvm_fault_service_worker_t;
+
 typedef struct
 {
     // Fault buffer information and structures provided by RM
@@ -255,20 +327,21 @@ typedef struct
         NvU32 replay_update_put_ratio;
 
         // Fault statistics. These fields are per-GPU and most of them are only
-        // updated during fault servicing, and can be safely incremented.
-        // Migrations may be triggered by different GPUs and need to be
+        // updated by the bottom-half thread, and can be safely incremented.
+        // Per-fault counters are updated by the fault service workers, and
+        // migrations may be triggered by different GPUs, so both need to be
         // incremented using atomics
         struct
         {
-            NvU64 num_prefetch_faults;
+            atomic64_t num_prefetch_faults;
 
-            NvU64 num_read_faults;
+            atomic64_t num_read_faults;
 
-            NvU64 num_write_faults;
+            atomic64_t num_write_faults;
 
-            NvU64 num_atomic_faults;
+            atomic64_t num_atomic_faults;
 
-            NvU64 num_duplicate_faults;
+            atomic64_t num_duplicate_faults;
 
             atomic64_t num_pages_out;
 
@@ -277,6 +350,21 @@ typedef struct
             NvU64 num_replays;
 
             NvU64 num_replays_ack_all;
+
+            // Number of batches serviced by more than one worker
+            NvU64 num_parallel_batches;
+
+            // Accumulated time in nanoseconds spent in each phase of fault
+            // servicing: fetching entries from the fault buffer, sorting and
+            // translating them, servicing them, and issuing replays or
+            // cancels
+            NvU64 fetch_time_ns;
+
+            NvU64 preprocess_time_ns;
+
+            NvU64 service_time_ns;
+
+            NvU64 replay_time_ns;
         } stats;
 
         // Number of uTLBs in the chip
@@ -290,6 +378,34 @@ typedef struct
 
         // Information required to invalidate stale ATS PTEs from the GPU TLBs
         uvm_ats_fault_invalidate_t ats_invalidate;
+
+        // State used to service the VA block runs of a sorted batch in
+        // parallel
+        struct
+        {
+            // Number of entries in workers. Servicing is serial if it is less
+            // than two.
+            NvU32 num_workers;
+
+            uvm_fault_service_worker_t *workers;
+
+            // GPU whose faults are being serviced by the workers
+            uvm_gpu_t *gpu;
+
+            // Index in ordered_fault_cache of the first fault of each run.
+            // The entry after the last run is num_coalesced_faults. The
+            // number of elements in this array is max_batch_size + 1
+            NvU32 *run_starts;
+
+            NvU32 num_runs;
+
+            // Index in run_starts of the next run to be claimed by a worker
+            atomic_t next_run;
+
+            // Set by a worker that found a GPU VA space that needs a fault
+            // buffer flush. Remaining runs are not serviced.
+            atomic_t flush_required;
+        } parallel;
     } replayable;
 
     struct uvm_non_replayable_fault_buffer_info_struct
@@ -373,10 +489,13 @@ struct uvm_access_counter_service_batch_context_struct
 
         NvU32                             num_notifications;
 
-        // Boolean used to avoid sorting the fault batch by instance_ptr if we
-        // determine at fetch time that all the access counter notifications in the
-        // batch report the same instance_ptr
+        // Boolean used to avoid instance_ptr translation lookups if we
+        // determine at fetch time that all the access counter notifications in
+        // the batch report the same instance_ptr
         bool is_single_instance_ptr;
+
+        // Translations of the instance pointers seen in the current batch
+        uvm_instance_ptr_cache_t instance_ptr_cache;
     } virt;
 
     struct
@@ -392,6 +511,12 @@ struct uvm_access_counter_service_batch_context_struct
         bool                              is_single_aperture;
     } phys;
 
+    // Arrays used to radix sort the virt and phys notifications. The number of
+    // elements in each array is exactly max_notifications
+    uvm_radix_sort_entry_t *sort_entries;
+
+    uvm_radix_sort_entry_t *sort_scratch;
+
     // Helper page mask to compute the accessed pages within a VA block
     uvm_page_mask_t accessed_pages;
 
@@ -684,6 +809,10 @@ struct uvm_gpu_struct
     // mappings (instead of kernel), and it is used in most configurations.
     uvm_pmm_sysmem_mappings_t pmm_reverse_sysmem_mappings;
 
+    // Representation counts of the evicted page masks of all VA block states
+    // on this GPU. See uvm_va_block_gpu_state_t::evicted.
+    uvm_page_mask_compact_stats_t va_block_evicted_masks;
+
 
 
 
@@ -1013,7 +1142,7 @@ struct uvm_parent_gpu_struct
     // updated during fault servicing, and can be safely incremented.
     struct
     {
-        NvU64          num_replayable_faults;
+        atomic64_t     num_replayable_faults;
 
         NvU64      num_non_replayable_faults;
 
@@ -1420,6 +1549,23 @@ NV_STATUS uvm_gpu_access_counter_entry_to_va_space(uvm_gpu_t *gpu,
                                                    uvm_access_counter_buffer_entry_t *entry,
                                                    uvm_va_space_t **out_va_space);
 
+// Invalidate all the translations in the cache
+void uvm_instance_ptr_cache_reset(uvm_instance_ptr_cache_t *cache);
+
+// Look up the VA space of the given {instance_ptr, tag} pair. Returns false
+// if it is not in the cache. The cached VA space may be NULL if a failed
+// translation was inserted.
+bool uvm_instance_ptr_cache_find(uvm_instance_ptr_cache_t *cache,
+                                 uvm_gpu_phys_address_t instance_ptr,
+                                 NvU32 tag,
+                                 uvm_va_space_t **out_va_space);
+
+// Insert a translation, replacing any other one that maps to the same slot
+void uvm_instance_ptr_cache_insert(uvm_instance_ptr_cache_t *cache,
+                                   uvm_gpu_phys_address_t instance_ptr,
+                                   NvU32 tag,
+                                   uvm_va_space_t *va_space);
+
 typedef enum
 {
     UVM_GPU_BUFFER_FLUSH_MODE_CACHED_PUT,
@@ -20,7 +20,6 @@
     DEALINGS IN THE SOFTWARE.
 *******************************************************************************/
 
-#include "linux/sort.h"
 #include "nv_uvm_interface.h"
 #include "uvm_gpu_access_counters.h"
 #include "uvm_global.h"
@@ -473,6 +472,20 @@ NV_STATUS uvm_gpu_init_access_counters(uvm_parent_gpu_t *parent_gpu)
         goto fail;
     }
 
+    batch_context->sort_entries = uvm_kvmalloc(access_counters->max_notifications *
+                                               sizeof(*batch_context->sort_entries));
+    if (!batch_context->sort_entries) {
+        status = NV_ERR_NO_MEMORY;
+        goto fail;
+    }
+
+    batch_context->sort_scratch = uvm_kvmalloc(access_counters->max_notifications *
+                                               sizeof(*batch_context->sort_scratch));
+    if (!batch_context->sort_scratch) {
+        status = NV_ERR_NO_MEMORY;
+        goto fail;
+    }
+
     return NV_OK;
 
 fail:
@@ -501,10 +514,14 @@ void uvm_gpu_deinit_access_counters(uvm_parent_gpu_t *parent_gpu)
     uvm_kvfree(batch_context->virt.notifications);
     uvm_kvfree(batch_context->phys.notifications);
     uvm_kvfree(batch_context->phys.translations);
+    uvm_kvfree(batch_context->sort_entries);
+    uvm_kvfree(batch_context->sort_scratch);
     batch_context->notification_cache = NULL;
     batch_context->virt.notifications = NULL;
     batch_context->phys.notifications = NULL;
     batch_context->phys.translations = NULL;
+    batch_context->sort_entries = NULL;
+    batch_context->sort_scratch = NULL;
 }
 
 bool uvm_gpu_access_counters_required(const uvm_parent_gpu_t *parent_gpu)
@@ -748,30 +765,18 @@ static inline int cmp_access_counter_instance_ptr(const uvm_access_counter_buffe
     return UVM_CMP_DEFAULT(a->virtual_info.ve_id, b->virtual_info.ve_id);
 }
 
-// Sort comparator for pointers to GVA access counter notification buffer
-// entries that sorts by instance pointer
-static int cmp_sort_virt_notifications_by_instance_ptr(const void *_a, const void *_b)
-{
-    const uvm_access_counter_buffer_entry_t *a = *(const uvm_access_counter_buffer_entry_t **)_a;
-    const uvm_access_counter_buffer_entry_t *b = *(const uvm_access_counter_buffer_entry_t **)_b;
-
-    UVM_ASSERT(a->address.is_virtual);
-    UVM_ASSERT(b->address.is_virtual);
-
-    return cmp_access_counter_instance_ptr(a, b);
-}
-
-// Sort comparator for pointers to GPA access counter notification buffer
-// entries that sorts by physical address' aperture
-static int cmp_sort_phys_notifications_by_processor_id(const void *_a, const void *_b)
+// Stable sort of the given notifications by the keys already stored in
+// sort_entries
+static void sort_notifications(uvm_access_counter_buffer_entry_t **notifications,
+                               NvU32 num_notifications,
+                               uvm_access_counter_service_batch_context_t *batch_context)
 {
-    const uvm_access_counter_buffer_entry_t *a = *(const uvm_access_counter_buffer_entry_t **)_a;
-    const uvm_access_counter_buffer_entry_t *b = *(const uvm_access_counter_buffer_entry_t **)_b;
+    NvU32 i;
 
-    UVM_ASSERT(!a->address.is_virtual);
-    UVM_ASSERT(!b->address.is_virtual);
+    uvm_radix_sort(batch_context->sort_entries, batch_context->sort_scratch, num_notifications);
 
-    return uvm_id_cmp(a->physical_info.resident_id, b->physical_info.resident_id);
+    for (i = 0; i < num_notifications; ++i)
+        notifications[i] = batch_context->sort_entries[i].value;
 }
 
 typedef enum
@@ -895,43 +900,64 @@ static void translate_virt_notifications_instance_ptrs(uvm_gpu_t *gpu,
 {
     NvU32 i;
     NV_STATUS status;
+    uvm_instance_ptr_cache_t *instance_ptr_cache = &batch_context->virt.instance_ptr_cache;
+
+    uvm_instance_ptr_cache_reset(instance_ptr_cache);
 
     for (i = 0; i < batch_context->virt.num_notifications; ++i) {
         uvm_access_counter_buffer_entry_t *current_entry = batch_context->virt.notifications[i];
 
-        if (i == 0 ||
-            cmp_access_counter_instance_ptr(current_entry, batch_context->virt.notifications[i - 1]) != 0) {
-            // If instance_ptr is different, make a new translation. If the
-            // translation fails then va_space will be NULL and the entry will
-            // simply be ignored in subsequent processing.
-            status = uvm_gpu_access_counter_entry_to_va_space(gpu,
-                                                              current_entry,
-                                                              &current_entry->virtual_info.va_space);
-            if (status != NV_OK)
-                UVM_ASSERT(current_entry->virtual_info.va_space == NULL);
-        }
-        else {
+        if (i != 0 &&
+            (batch_context->virt.is_single_instance_ptr ||
+             cmp_access_counter_instance_ptr(current_entry, batch_context->virt.notifications[i - 1]) == 0)) {
             current_entry->virtual_info.va_space = batch_context->virt.notifications[i - 1]->virtual_info.va_space;
+            continue;
         }
+
+        if (uvm_instance_ptr_cache_find(instance_ptr_cache,
+                                        current_entry->virtual_info.instance_ptr,
+                                        current_entry->virtual_info.ve_id,
+                                        &current_entry->virtual_info.va_space))
+            continue;
+
+        // If the translation fails then va_space will be NULL and the entry
+        // will simply be ignored in subsequent processing. Failed translations
+        // are cached too.
+        status = uvm_gpu_access_counter_entry_to_va_space(gpu,
+                                                          current_entry,
+                                                          &current_entry->virtual_info.va_space);
+        if (status != NV_OK)
+            UVM_ASSERT(current_entry->virtual_info.va_space == NULL);
+
+        uvm_instance_ptr_cache_insert(instance_ptr_cache,
+                                      current_entry->virtual_info.instance_ptr,
+                                      current_entry->virtual_info.ve_id,
+                                      current_entry->virtual_info.va_space);
     }
 }
 
 // GVA notifications provide an instance_ptr and ve_id that can be directly
-// translated to a VA space. In order to minimize translations, we sort the
-// entries by instance_ptr.
+// translated to a VA space. Translations are cached for the duration of the
+// batch, and then the entries are sorted by VA space and address so that
+// notifications on the same VA block are next to each other.
 static void preprocess_virt_notifications(uvm_gpu_t *gpu,
                                           uvm_access_counter_service_batch_context_t *batch_context)
 {
-    if (!batch_context->virt.is_single_instance_ptr) {
-        // Sort by instance_ptr
-        sort(batch_context->virt.notifications,
-             batch_context->virt.num_notifications,
-             sizeof(*batch_context->virt.notifications),
-             cmp_sort_virt_notifications_by_instance_ptr,
-             NULL);
-    }
+    NvU32 i;
 
     translate_virt_notifications_instance_ptrs(gpu, batch_context);
+
+    for (i = 0; i < batch_context->virt.num_notifications; ++i) {
+        uvm_access_counter_buffer_entry_t *entry = batch_context->virt.notifications[i];
+
+        UVM_ASSERT(entry->address.is_virtual);
+
+        batch_context->sort_entries[i].key_high = (NvU64)(uintptr_t)entry->virtual_info.va_space;
+        batch_context->sort_entries[i].key_low  = entry->address.address;
+        batch_context->sort_entries[i].value    = entry;
+    }
+
+    sort_notifications(batch_context->virt.notifications, batch_context->virt.num_notifications, batch_context);
 }
 
 static NV_STATUS service_virt_notifications(uvm_gpu_t *gpu,
@@ -958,14 +984,24 @@ static NV_STATUS service_virt_notifications(uvm_gpu_t *gpu,
 // processor.
 static void preprocess_phys_notifications(uvm_access_counter_service_batch_context_t *batch_context)
 {
-    if (!batch_context->phys.is_single_aperture) {
-        // Sort by instance_ptr
-        sort(batch_context->phys.notifications,
-             batch_context->phys.num_notifications,
-             sizeof(*batch_context->phys.notifications),
-             cmp_sort_phys_notifications_by_processor_id,
-             NULL);
+    NvU32 i;
+
+    if (batch_context->phys.is_single_aperture)
+        return;
+
+    // Sort by processor id. The sort is stable, so notifications on the same
+    // processor keep their arrival order.
+    for (i = 0; i < batch_context->phys.num_notifications; ++i) {
+        uvm_access_counter_buffer_entry_t *entry = batch_context->phys.notifications[i];
+
+        UVM_ASSERT(!entry->address.is_virtual);
+
+        batch_context->sort_entries[i].key_high = 0;
+        batch_context->sort_entries[i].key_low  = uvm_id_value(entry->physical_info.resident_id);
+        batch_context->sort_entries[i].value    = entry;
     }
+
+    sort_notifications(batch_context->phys.notifications, batch_context->phys.num_notifications, batch_context);
 }
 
 static NV_STATUS service_va_block_locked(uvm_processor_id_t processor,
@@ -1010,6 +1046,11 @@ static NV_STATUS service_va_block_locked(uvm_processor_id_t processor,
     service_context->read_duplicate_count = 0;
     service_context->thrashing_pin_count = 0;
 
+    // The accessed pages are hot wherever they are resident. Let PMM know
+    // before filtering them, so that GPU memory being accessed remotely or
+    // through stale notifications is not picked for eviction.
+    uvm_va_block_mark_gpu_chunks_referenced(va_block, accessed_pages);
+
     // If the page is already resident on the accessing processor, the
     // notification for this page is stale. Skip it.
     if (residency_mask)
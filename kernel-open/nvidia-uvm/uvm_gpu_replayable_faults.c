@@ -38,6 +38,7 @@
 #include "uvm_gpu_non_replayable_faults.h"
 #include "uvm_ats_faults.h"
 #include "uvm_test.h"
+#include "uvm_test_rng.h"
 
 // The documentation at the beginning of uvm_gpu_non_replayable_faults.c
 // provides some background for understanding replayable faults, non-replayable
@@ -96,6 +97,18 @@ module_param(uvm_perf_fault_max_throttle_per_service, uint, S_IRUGO);
 static unsigned uvm_perf_fault_coalesce = 1;
 module_param(uvm_perf_fault_coalesce, uint, S_IRUGO);
 
+#define UVM_PERF_FAULT_SERVICE_WORKERS_DEFAULT 1
+#define UVM_PERF_FAULT_SERVICE_WORKERS_MAX 16
+
+// Number of threads, including the bottom-half thread, that service the VA
+// block runs of a fault batch in parallel. 1 means that batches are serviced
+// serially by the bottom half. Parallel servicing is only used on GPUs that
+// support cancelling faults by VA, and not with the per-VA-block replay policy.
+static unsigned uvm_perf_fault_service_workers = UVM_PERF_FAULT_SERVICE_WORKERS_DEFAULT;
+module_param(uvm_perf_fault_service_workers, uint, S_IRUGO);
+
+static void fault_service_worker_entry(void *args);
+
 // This function is used for both the initial fault buffer initialization and
 // the power management resume path.
 static void fault_buffer_reinit_replayable_faults(uvm_parent_gpu_t *parent_gpu)
@@ -116,6 +129,90 @@ static void fault_buffer_reinit_replayable_faults(uvm_parent_gpu_t *parent_gpu)
         parent_gpu->arch_hal->disable_prefetch_faults(parent_gpu);
 }
 
+static void fault_service_workers_deinit(uvm_parent_gpu_t *parent_gpu)
+{
+    uvm_replayable_fault_buffer_info_t *replayable_faults = &parent_gpu->fault_buffer_info.replayable;
+    NvU32 i;
+
+    // The bottom half has already been stopped, so no worker can be running.
+    // It is safe to call nv_kthread_q_stop on queues that were not initialized.
+    for (i = 0; i < replayable_faults->parallel.num_workers; ++i) {
+        uvm_fault_service_worker_t *worker = &replayable_faults->parallel.workers[i];
+
+        nv_kthread_q_stop(&worker->q);
+        uvm_tracker_deinit(&worker->batch_context.tracker);
+    }
+
+    uvm_kvfree(replayable_faults->parallel.workers);
+    uvm_kvfree(replayable_faults->parallel.run_starts);
+    replayable_faults->parallel.workers     = NULL;
+    replayable_faults->parallel.run_starts  = NULL;
+    replayable_faults->parallel.num_workers = 0;
+}
+
+// There is no error handling in this function. The caller is in charge of
+// calling fault_service_workers_deinit on failure.
+static NV_STATUS fault_service_workers_init(uvm_parent_gpu_t *parent_gpu)
+{
+    uvm_replayable_fault_buffer_info_t *replayable_faults = &parent_gpu->fault_buffer_info.replayable;
+    NvU32 num_workers = min(uvm_perf_fault_service_workers, (unsigned)UVM_PERF_FAULT_SERVICE_WORKERS_MAX);
+    NvU32 i;
+
+    if (num_workers != uvm_perf_fault_service_workers) {
+        pr_info("Invalid uvm_perf_fault_service_workers value on GPU %s: %u. Valid range [1:%u] Using %u instead\n",
+                parent_gpu->name,
+                uvm_perf_fault_service_workers,
+                UVM_PERF_FAULT_SERVICE_WORKERS_MAX,
+                num_workers);
+    }
+
+    // Pascal GPUs need to split big PTEs on the VA blocks with fatal faults
+    // while servicing the batch, which relies on the serial order of the
+    // batch. Keep them serial.
+    if (num_workers < 2 || !parent_gpu->fault_cancel_va_supported)
+        return NV_OK;
+
+    replayable_faults->parallel.run_starts =
+        uvm_kvmalloc_zero((parent_gpu->fault_buffer_info.max_batch_size + 1) *
+                          sizeof(*replayable_faults->parallel.run_starts));
+    if (!replayable_faults->parallel.run_starts)
+        return NV_ERR_NO_MEMORY;
+
+    replayable_faults->parallel.workers = uvm_kvmalloc_zero(num_workers * sizeof(*replayable_faults->parallel.workers));
+    if (!replayable_faults->parallel.workers)
+        return NV_ERR_NO_MEMORY;
+
+    for (i = 0; i < num_workers; ++i) {
+        uvm_fault_service_worker_t *worker = &replayable_faults->parallel.workers[i];
+        char kthread_name[TASK_COMM_LEN + 1];
+        NV_STATUS status;
+
+        worker->parent_gpu = parent_gpu;
+        uvm_tracker_init(&worker->batch_context.tracker);
+        ++replayable_faults->parallel.num_workers;
+
+        // The first worker runs on the bottom-half thread
+        if (i == 0)
+            continue;
+
+        nv_kthread_q_item_init(&worker->q_item, fault_service_worker_entry, worker);
+
+        snprintf(kthread_name, sizeof(kthread_name), "UVM GPU%u FW%u", uvm_id_value(parent_gpu->id), i);
+        status = errno_to_nv_status(nv_kthread_q_init_on_node(&worker->q,
+                                                              kthread_name,
+                                                              parent_gpu->closest_cpu_numa_node));
+        if (status != NV_OK) {
+            UVM_ERR_PRINT("Failed in nv_kthread_q_init for fault service worker %u: %s, GPU %s\n",
+                          i,
+                          nvstatusToString(status),
+                          parent_gpu->name);
+            return status;
+        }
+    }
+
+    return NV_OK;
+}
+
 // There is no error handling in this function. The caller is in charge of
 // calling fault_buffer_deinit_replayable_faults on failure.
 static NV_STATUS fault_buffer_init_replayable_faults(uvm_parent_gpu_t *parent_gpu)
@@ -157,6 +254,14 @@ static NV_STATUS fault_buffer_init_replayable_faults(uvm_parent_gpu_t *parent_gp
     if (!batch_context->ordered_fault_cache)
         return NV_ERR_NO_MEMORY;
 
+    batch_context->sort_entries = uvm_kvmalloc(replayable_faults->max_faults * sizeof(*batch_context->sort_entries));
+    if (!batch_context->sort_entries)
+        return NV_ERR_NO_MEMORY;
+
+    batch_context->sort_scratch = uvm_kvmalloc(replayable_faults->max_faults * sizeof(*batch_context->sort_scratch));
+    if (!batch_context->sort_scratch)
+        return NV_ERR_NO_MEMORY;
+
     // This value must be initialized by HAL
     UVM_ASSERT(replayable_faults->utlb_count > 0);
 
@@ -196,6 +301,10 @@ static NV_STATUS fault_buffer_init_replayable_faults(uvm_parent_gpu_t *parent_gp
     // Re-enable fault prefetching just in case it was disabled in a previous run
     parent_gpu->fault_buffer_info.prefetch_faults_enabled = parent_gpu->prefetch_fault_supported;
 
+    status = fault_service_workers_init(parent_gpu);
+    if (status != NV_OK)
+        return status;
+
     fault_buffer_reinit_replayable_faults(parent_gpu);
 
     return NV_OK;
@@ -206,6 +315,8 @@ static void fault_buffer_deinit_replayable_faults(uvm_parent_gpu_t *parent_gpu)
     uvm_replayable_fault_buffer_info_t *replayable_faults = &parent_gpu->fault_buffer_info.replayable;
     uvm_fault_service_batch_context_t *batch_context = &replayable_faults->batch_service_context;
 
+    fault_service_workers_deinit(parent_gpu);
+
     if (batch_context->fault_cache) {
         UVM_ASSERT(uvm_tracker_is_empty(&replayable_faults->replay_tracker));
         uvm_tracker_deinit(&replayable_faults->replay_tracker);
@@ -220,9 +331,13 @@ static void fault_buffer_deinit_replayable_faults(uvm_parent_gpu_t *parent_gpu)
     uvm_kvfree(batch_context->fault_cache);
     uvm_kvfree(batch_context->ordered_fault_cache);
     uvm_kvfree(batch_context->utlbs);
+    uvm_kvfree(batch_context->sort_entries);
+    uvm_kvfree(batch_context->sort_scratch);
     batch_context->fault_cache         = NULL;
     batch_context->ordered_fault_cache = NULL;
     batch_context->utlbs               = NULL;
+    batch_context->sort_entries        = NULL;
+    batch_context->sort_scratch        = NULL;
 }
 
 NV_STATUS uvm_gpu_fault_buffer_init(uvm_parent_gpu_t *parent_gpu)
@@ -863,18 +978,10 @@ done:
     batch_context->num_coalesced_faults = num_coalesced_faults;
 }
 
-// Sort comparator for pointers to fault buffer entries that sorts by
-// instance pointer
-static int cmp_sort_fault_entry_by_instance_ptr(const void *_a, const void *_b)
-{
-    const uvm_fault_buffer_entry_t **a = (const uvm_fault_buffer_entry_t **)_a;
-    const uvm_fault_buffer_entry_t **b = (const uvm_fault_buffer_entry_t **)_b;
-
-    return cmp_fault_instance_ptr(*a, *b);
-}
-
 // Sort comparator for pointers to fault buffer entries that sorts by va_space,
-// fault address and fault access type
+// fault address and fault access type. Fault batches are sorted with
+// sort_fault_entries, which yields the same order; this comparator is the
+// reference used to test it.
 static int cmp_sort_fault_entry_by_va_space_address_access_type(const void *_a, const void *_b)
 {
     const uvm_fault_buffer_entry_t **a = (const uvm_fault_buffer_entry_t **)_a;
@@ -893,8 +1000,23 @@ static int cmp_sort_fault_entry_by_va_space_address_access_type(const void *_a,
     return cmp_access_type((*a)->fault_access_type, (*b)->fault_access_type);
 }
 
-// Translate all instance pointers to VA spaces. Since the buffer is ordered by
-// instance_ptr, we minimize the number of translations
+// Key used to look up the translation of a fault in the instance pointer
+// cache. Faults from HUB clients are translated to the channel's VA space
+// regardless of the subcontext, so they must not share entries with GPC faults
+// on the same subcontext id.
+static NvU32 fault_instance_ptr_cache_tag(const uvm_fault_buffer_entry_t *fault)
+{
+    NvU32 tag = fault->fault_source.ve_id;
+
+    if (fault->fault_source.client_type == UVM_FAULT_CLIENT_TYPE_HUB)
+        tag |= 1u << 31;
+
+    return tag;
+}
+
+// Translate all instance pointers to VA spaces. Faults in the batch are not
+// ordered by instance_ptr, so translations are looked up in a per-batch cache
+// to minimize the number of lookups in the GPU's instance_ptr_table
 //
 // This function returns NV_WARN_MORE_PROCESSING_REQUIRED if a fault buffer
 // flush occurred and executed successfully, or the error code if it failed.
@@ -904,19 +1026,29 @@ static NV_STATUS translate_instance_ptrs(uvm_gpu_t *gpu,
 {
     NvU32 i;
     NV_STATUS status;
+    uvm_instance_ptr_cache_t *instance_ptr_cache = &batch_context->instance_ptr_cache;
+
+    uvm_instance_ptr_cache_reset(instance_ptr_cache);
 
     for (i = 0; i < batch_context->num_coalesced_faults; ++i) {
         uvm_fault_buffer_entry_t *current_entry;
+        NvU32 tag;
 
         current_entry = batch_context->ordered_fault_cache[i];
 
         // If this instance pointer matches the previous instance pointer, just
         // copy over the already-translated va_space and move on.
-        if (i != 0 && cmp_fault_instance_ptr(current_entry, batch_context->ordered_fault_cache[i - 1]) == 0) {
+        if (i != 0 &&
+            (batch_context->is_single_instance_ptr ||
+             cmp_fault_instance_ptr(current_entry, batch_context->ordered_fault_cache[i - 1]) == 0)) {
             current_entry->va_space = batch_context->ordered_fault_cache[i - 1]->va_space;
             continue;
         }
 
+        tag = fault_instance_ptr_cache_tag(current_entry);
+        if (uvm_instance_ptr_cache_find(instance_ptr_cache, current_entry->instance_ptr, tag, &current_entry->va_space))
+            continue;
+
         status = uvm_gpu_fault_entry_to_va_space(gpu, current_entry, &current_entry->va_space);
         if (status != NV_OK) {
             if (status == NV_ERR_PAGE_TABLE_NOT_AVAIL) {
@@ -968,27 +1100,62 @@ static NV_STATUS translate_instance_ptrs(uvm_gpu_t *gpu,
         else {
             UVM_ASSERT(current_entry->va_space);
         }
+
+        uvm_instance_ptr_cache_insert(instance_ptr_cache, current_entry->instance_ptr, tag, current_entry->va_space);
     }
 
     return NV_OK;
 }
 
+// Sort the given fault entries by va_space, fault address and access type
+// "intrusiveness", as cmp_sort_fault_entry_by_va_space_address_access_type
+// does, using a radix sort over packed keys. Fault addresses are 4K-aligned,
+// so the access type fits in the low bits of the address.
+// Faults on the same VA block end up next to each other, in page order.
+//
+// sort_entries and sort_scratch must have room for count elements.
+static void sort_fault_entries(uvm_fault_buffer_entry_t **entries,
+                               NvU32 count,
+                               uvm_radix_sort_entry_t *sort_entries,
+                               uvm_radix_sort_entry_t *sort_scratch)
+{
+    NvU32 i;
+
+    // More intrusive access types must be sorted first
+    BUILD_BUG_ON(UVM_FAULT_ACCESS_TYPE_COUNT > UVM_PAGE_SIZE_4K);
+
+    for (i = 0; i < count; ++i) {
+        const uvm_fault_buffer_entry_t *entry = entries[i];
+
+        UVM_ASSERT(IS_ALIGNED(entry->fault_address, UVM_PAGE_SIZE_4K));
+        UVM_ASSERT(entry->fault_access_type < UVM_FAULT_ACCESS_TYPE_COUNT);
+
+        sort_entries[i].key_high = (NvU64)(uintptr_t)entry->va_space;
+        sort_entries[i].key_low  = entry->fault_address | (UVM_FAULT_ACCESS_TYPE_COUNT - 1 - entry->fault_access_type);
+        sort_entries[i].value    = entries[i];
+    }
+
+    uvm_radix_sort(sort_entries, sort_scratch, count);
+
+    for (i = 0; i < count; ++i)
+        entries[i] = sort_entries[i].value;
+}
+
 // Fault cache preprocessing for fault coalescing
 //
 // This function generates an ordered view of the given fault_cache in which
 // faults are sorted by VA space, fault address (aligned to 4K) and access type
 // "intrusiveness". In order to minimize the number of instance_ptr to VA space
-// translations we perform a first sort by instance_ptr.
+// translations we cache them for the duration of the batch.
 //
 // This function returns NV_WARN_MORE_PROCESSING_REQUIRED if a fault buffer
 // flush occurred during instance_ptr translation and executed successfully, or
 // the error code if it failed. NV_OK otherwise.
 //
 // Current scheme:
-// 1) sort by instance_ptr
-// 2) translate all instance_ptrs to VA spaces
-// 3) sort by va_space, fault address (fault_address is page-aligned at this
-//    point) and access type
+// 1) translate all instance_ptrs to VA spaces
+// 2) radix sort by va_space, fault address (fault_address is page-aligned at
+//    this point) and access type
 static NV_STATUS preprocess_fault_batch(uvm_gpu_t *gpu, uvm_fault_service_batch_context_t *batch_context)
 {
     NV_STATUS status;
@@ -1009,27 +1176,17 @@ static NV_STATUS preprocess_fault_batch(uvm_gpu_t *gpu, uvm_fault_service_batch_
     }
     UVM_ASSERT(j == batch_context->num_coalesced_faults);
 
-    // 1) if the fault batch contains more than one, sort by instance_ptr
-    if (!batch_context->is_single_instance_ptr) {
-        sort(ordered_fault_cache,
-             batch_context->num_coalesced_faults,
-             sizeof(*ordered_fault_cache),
-             cmp_sort_fault_entry_by_instance_ptr,
-             NULL);
-    }
-
-    // 2) translate all instance_ptrs to VA spaces
+    // 1) translate all instance_ptrs to VA spaces
     status = translate_instance_ptrs(gpu, batch_context);
     if (status != NV_OK)
         return status;
 
-    // 3) sort by va_space, fault address (GPU already reports 4K-aligned
+    // 2) sort by va_space, fault address (GPU already reports 4K-aligned
     // address) and access type
-    sort(ordered_fault_cache,
-         batch_context->num_coalesced_faults,
-         sizeof(*ordered_fault_cache),
-         cmp_sort_fault_entry_by_va_space_address_access_type,
-         NULL);
+    sort_fault_entries(ordered_fault_cache,
+                       batch_context->num_coalesced_faults,
+                       batch_context->sort_entries,
+                       batch_context->sort_scratch);
 
     return NV_OK;
 }
@@ -1120,6 +1277,7 @@ static NV_STATUS service_batch_managed_faults_in_block_locked(uvm_gpu_t *gpu,
                                                               uvm_va_block_retry_t *va_block_retry,
                                                               NvU32 first_fault_index,
                                                               uvm_fault_service_batch_context_t *batch_context,
+                                                              uvm_service_block_context_t *block_context,
                                                               NvU32 *block_faults)
 {
     NV_STATUS status = NV_OK;
@@ -1128,9 +1286,7 @@ static NV_STATUS service_batch_managed_faults_in_block_locked(uvm_gpu_t *gpu,
     uvm_page_index_t last_page_index;
     NvU32 page_fault_count = 0;
     uvm_range_group_range_iter_t iter;
-    uvm_replayable_fault_buffer_info_t *replayable_faults = &gpu->parent->fault_buffer_info.replayable;
     uvm_fault_buffer_entry_t **ordered_fault_cache = batch_context->ordered_fault_cache;
-    uvm_service_block_context_t *block_context = &replayable_faults->block_service_context;
     uvm_va_space_t *va_space = uvm_va_block_get_va_space(va_block);
     NvU64 end;
 
@@ -1352,12 +1508,12 @@ static NV_STATUS service_batch_managed_faults_in_block(uvm_gpu_t *gpu,
                                                        uvm_va_block_t *va_block,
                                                        NvU32 first_fault_index,
                                                        uvm_fault_service_batch_context_t *batch_context,
+                                                       uvm_service_block_context_t *fault_block_context,
                                                        NvU32 *block_faults)
 {
     NV_STATUS status;
     uvm_va_block_retry_t va_block_retry;
     NV_STATUS tracker_status;
-    uvm_service_block_context_t *fault_block_context = &gpu->parent->fault_buffer_info.replayable.block_service_context;
 
     fault_block_context->operation = UVM_SERVICE_OPERATION_REPLAYABLE_FAULTS;
     fault_block_context->num_retries = 0;
@@ -1371,6 +1527,7 @@ static NV_STATUS service_batch_managed_faults_in_block(uvm_gpu_t *gpu,
                                                                                     &va_block_retry,
                                                                                     first_fault_index,
                                                                                     batch_context,
+                                                                                    fault_block_context,
                                                                                     block_faults));
 
     tracker_status = uvm_tracker_add_tracker_safe(&batch_context->tracker, &va_block->tracker);
@@ -1476,9 +1633,318 @@ static NV_STATUS service_non_managed_fault(uvm_fault_buffer_entry_t *current_ent
     return status;
 }
 
+// Service the faults that start at first_fault_index in the ordered view of
+// the batch. The caller must hold the lock of the VA space of the fault, and
+// its mm if any. On return, block_faults contains the number of entries that
+// were consumed, and is_managed_block tells whether they were serviced as a
+// managed VA block.
+//
+// Entries before run_start_index may be serviced concurrently by a different
+// thread, so they are not used to detect duplicates.
+static NV_STATUS service_fault_batch_block(uvm_gpu_t *gpu,
+                                           uvm_gpu_va_space_t *gpu_va_space,
+                                           struct mm_struct *mm,
+                                           NvU32 first_fault_index,
+                                           NvU32 run_start_index,
+                                           uvm_fault_service_batch_context_t *batch_context,
+                                           uvm_service_block_context_t *block_context,
+                                           uvm_ats_fault_invalidate_t *ats_invalidate,
+                                           NvU32 *block_faults,
+                                           bool *is_managed_block)
+{
+    NV_STATUS status;
+    uvm_va_block_t *va_block;
+    uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[first_fault_index];
+    uvm_fault_utlb_info_t *utlb = &batch_context->utlbs[current_entry->fault_source.utlb_id];
+    uvm_va_space_t *va_space = current_entry->va_space;
+    const uvm_fault_buffer_entry_t *previous_entry = NULL;
+
+    *block_faults = 1;
+    *is_managed_block = false;
+
+    // Some faults could be already fatal if they cannot be handled by
+    // the UVM driver
+    if (current_entry->is_fatal) {
+        batch_context->has_fatal_faults = true;
+        utlb->has_fatal_faults = true;
+        UVM_ASSERT(utlb->num_pending_faults > 0);
+        return NV_OK;
+    }
+
+    if (!uvm_processor_mask_test(&va_space->registered_gpu_va_spaces, gpu->parent->id)) {
+        // If there is no GPU VA space for the GPU, ignore the fault. This
+        // can happen if a GPU VA space is destroyed without explicitly
+        // freeing all memory ranges (destroying the VA range triggers a
+        // flush of the fault buffer) and there are stale entries in the
+        // buffer that got fixed by the servicing in a previous batch.
+        return NV_OK;
+    }
+
+    // TODO: Bug 2103669: Service more than one ATS fault at a time so we
+    //       don't do an unconditional VA range lookup for every ATS fault.
+    status = uvm_va_block_find_create_hint(va_space,
+                                           mm,
+                                           current_entry->fault_address,
+                                           &block_context->block_context,
+                                           &batch_context->va_range_hint,
+                                           &va_block);
+    if (status == NV_OK) {
+        *is_managed_block = true;
+
+        return service_batch_managed_faults_in_block(gpu_va_space->gpu,
+                                                     mm,
+                                                     va_block,
+                                                     first_fault_index,
+                                                     batch_context,
+                                                     block_context,
+                                                     block_faults);
+    }
+
+    if (first_fault_index > run_start_index)
+        previous_entry = batch_context->ordered_fault_cache[first_fault_index - 1];
+
+    return service_non_managed_fault(current_entry,
+                                     previous_entry,
+                                     status,
+                                     gpu_va_space,
+                                     mm,
+                                     batch_context,
+                                     ats_invalidate,
+                                     utlb);
+}
+
+// Split the ordered view of the batch into runs of faults that belong to the
+// same VA space and UVM_VA_BLOCK_SIZE-aligned region. VA blocks never cross
+// those regions, so different runs can be serviced concurrently. Returns the
+// number of runs.
+static NvU32 compute_fault_batch_runs(uvm_fault_service_batch_context_t *batch_context, NvU32 *run_starts)
+{
+    NvU32 i;
+    NvU32 num_runs = 0;
+    uvm_fault_buffer_entry_t **ordered_fault_cache = batch_context->ordered_fault_cache;
+
+    for (i = 0; i < batch_context->num_coalesced_faults; ++i) {
+        const uvm_fault_buffer_entry_t *current_entry = ordered_fault_cache[i];
+        const uvm_fault_buffer_entry_t *previous_entry = i == 0? NULL : ordered_fault_cache[i - 1];
+
+        if (!previous_entry ||
+            current_entry->va_space != previous_entry->va_space ||
+            UVM_VA_BLOCK_ALIGN_DOWN(current_entry->fault_address) !=
+                UVM_VA_BLOCK_ALIGN_DOWN(previous_entry->fault_address)) {
+            run_starts[num_runs++] = i;
+        }
+    }
+
+    run_starts[num_runs] = batch_context->num_coalesced_faults;
+
+    return num_runs;
+}
+
+// Service runs of the current batch until there are none left to claim. Each
+// worker takes the mm and VA space locks itself, in the same order as
+// service_fault_batch, since lock tracking is per thread. The bottom half does
+// not hold them while it waits for the workers, so they cannot deadlock
+// behind a pending writer.
+static void service_fault_batch_runs(uvm_fault_service_worker_t *worker)
+{
+    NV_STATUS status = NV_OK;
+    uvm_replayable_fault_buffer_info_t *replayable_faults = &worker->parent_gpu->fault_buffer_info.replayable;
+    uvm_gpu_t *gpu = replayable_faults->parallel.gpu;
+    uvm_fault_service_batch_context_t *batch_context = &worker->batch_context;
+    uvm_ats_fault_invalidate_t *ats_invalidate = &worker->ats_invalidate;
+    uvm_va_space_t *va_space = NULL;
+    uvm_gpu_va_space_t *gpu_va_space = NULL;
+    struct mm_struct *mm = NULL;
+
+    ats_invalidate->write_faults_in_batch = false;
+    worker->flush_va_space = NULL;
+
+    while (!atomic_read(&replayable_faults->parallel.flush_required)) {
+        NvU32 run = atomic_inc_return(&replayable_faults->parallel.next_run) - 1;
+        NvU32 run_start;
+        NvU32 run_end;
+        NvU32 i;
+
+        if (run >= replayable_faults->parallel.num_runs)
+            break;
+
+        run_start = replayable_faults->parallel.run_starts[run];
+        run_end = replayable_faults->parallel.run_starts[run + 1];
+
+        if (batch_context->ordered_fault_cache[run_start]->va_space != va_space) {
+            if (va_space != NULL) {
+                // TLB entries are invalidated per GPU VA space
+                status = uvm_ats_invalidate_tlbs(gpu_va_space, ats_invalidate, &batch_context->tracker);
+                if (status != NV_OK)
+                    break;
+
+                uvm_va_space_up_read(va_space);
+                uvm_va_space_mm_release_unlock(va_space, mm);
+                mm = NULL;
+            }
+
+            va_space = batch_context->ordered_fault_cache[run_start]->va_space;
+            UVM_ASSERT(va_space);
+
+            batch_context->va_range_hint = NULL;
+
+            mm = uvm_va_space_mm_retain_lock(va_space);
+
+            uvm_va_space_down_read(va_space);
+
+            // The flush is issued by the bottom half once all the workers are
+            // done. The flag is also cleared there, under the VA space lock.
+            gpu_va_space = uvm_gpu_va_space_get_by_parent_gpu(va_space, gpu->parent);
+            if (gpu_va_space && gpu_va_space->needs_fault_buffer_flush) {
+                worker->flush_va_space = va_space;
+                atomic_set(&replayable_faults->parallel.flush_required, 1);
+                break;
+            }
+        }
+
+        for (i = run_start; i < run_end;) {
+            NvU32 block_faults;
+            bool is_managed_block;
+
+            status = service_fault_batch_block(gpu,
+                                               gpu_va_space,
+                                               mm,
+                                               i,
+                                               run_start,
+                                               batch_context,
+                                               &worker->block_service_context,
+                                               ats_invalidate,
+                                               &block_faults,
+                                               &is_managed_block);
+            if (status != NV_OK)
+                break;
+
+            i += block_faults;
+        }
+
+        if (status != NV_OK)
+            break;
+    }
+
+    if (va_space != NULL) {
+        if (status == NV_OK)
+            status = uvm_ats_invalidate_tlbs(gpu_va_space, ats_invalidate, &batch_context->tracker);
+
+        uvm_va_space_up_read(va_space);
+        uvm_va_space_mm_release_unlock(va_space, mm);
+    }
+
+    // Global errors cancel the whole batch, so stop the remaining workers
+    if (status != NV_OK)
+        atomic_set(&replayable_faults->parallel.next_run, replayable_faults->parallel.num_runs);
+
+    worker->status = status;
+}
+
+static void fault_service_worker_entry(void *args)
+{
+    UVM_ENTRY_VOID(service_fault_batch_runs((uvm_fault_service_worker_t *)args));
+}
+
+// Service the runs computed by compute_fault_batch_runs on num_workers
+// threads, and merge the results of the workers into batch_context. Replays
+// and cancels are issued afterwards by the bottom half, as in the serial path.
+//
+// This function returns NV_WARN_MORE_PROCESSING_REQUIRED if the fault buffer
+// was flushed because the needs_fault_buffer_flush flag was set on some GPU VA
+// space
+static NV_STATUS service_fault_batch_parallel(uvm_gpu_t *gpu,
+                                              uvm_fault_service_batch_context_t *batch_context,
+                                              NvU32 num_workers)
+{
+    NV_STATUS status = NV_OK;
+    NvU32 i;
+    uvm_replayable_fault_buffer_info_t *replayable_faults = &gpu->parent->fault_buffer_info.replayable;
+    uvm_fault_service_worker_t *workers = replayable_faults->parallel.workers;
+    uvm_va_space_t *flush_va_space = NULL;
+    uvm_gpu_va_space_t *gpu_va_space;
+
+    UVM_ASSERT(num_workers > 1);
+    UVM_ASSERT(num_workers <= replayable_faults->parallel.num_workers);
+
+    replayable_faults->parallel.gpu = gpu;
+    atomic_set(&replayable_faults->parallel.next_run, 0);
+    atomic_set(&replayable_faults->parallel.flush_required, 0);
+
+    for (i = 0; i < num_workers; ++i) {
+        uvm_fault_service_batch_context_t *worker_batch_context = &workers[i].batch_context;
+
+        worker_batch_context->ordered_fault_cache         = batch_context->ordered_fault_cache;
+        worker_batch_context->utlbs                       = batch_context->utlbs;
+        worker_batch_context->num_coalesced_faults        = batch_context->num_coalesced_faults;
+        worker_batch_context->batch_id                    = batch_context->batch_id;
+        worker_batch_context->num_invalid_prefetch_faults = 0;
+        worker_batch_context->num_duplicate_faults        = 0;
+        worker_batch_context->has_fatal_faults            = false;
+        worker_batch_context->has_throttled_faults        = false;
+
+        if (i > 0)
+            nv_kthread_q_schedule_q_item(&workers[i].q, &workers[i].q_item);
+    }
+
+    service_fault_batch_runs(&workers[0]);
+
+    for (i = 1; i < num_workers; ++i)
+        nv_kthread_q_flush(&workers[i].q);
+
+    for (i = 0; i < num_workers; ++i) {
+        uvm_fault_service_batch_context_t *worker_batch_context = &workers[i].batch_context;
+        NV_STATUS tracker_status;
+
+        batch_context->num_invalid_prefetch_faults += worker_batch_context->num_invalid_prefetch_faults;
+        batch_context->num_duplicate_faults        += worker_batch_context->num_duplicate_faults;
+        batch_context->has_fatal_faults            |= worker_batch_context->has_fatal_faults;
+        batch_context->has_throttled_faults        |= worker_batch_context->has_throttled_faults;
+
+        tracker_status = uvm_tracker_add_tracker_safe(&batch_context->tracker, &worker_batch_context->tracker);
+        uvm_tracker_clear(&worker_batch_context->tracker);
+
+        if (status == NV_OK)
+            status = workers[i].status != NV_OK? workers[i].status : tracker_status;
+
+        if (!flush_va_space)
+            flush_va_space = workers[i].flush_va_space;
+    }
+
+    ++replayable_faults->stats.num_parallel_batches;
+
+    if (status != NV_OK || !flush_va_space)
+        return status;
+
+    // Flush and clear the flag under the VA space lock, as service_fault_batch
+    // does, so that a concurrent unmap cannot set it in between. Other GPU VA
+    // spaces that need a flush are found again in the next batch.
+    uvm_va_space_down_read(flush_va_space);
+
+    status = fault_buffer_flush_locked(gpu,
+                                       UVM_GPU_BUFFER_FLUSH_MODE_UPDATE_PUT,
+                                       UVM_FAULT_REPLAY_TYPE_START,
+                                       batch_context);
+
+    gpu_va_space = uvm_gpu_va_space_get_by_parent_gpu(flush_va_space, gpu->parent);
+    if (gpu_va_space)
+        gpu_va_space->needs_fault_buffer_flush = false;
+
+    uvm_va_space_up_read(flush_va_space);
+
+    if (status == NV_OK)
+        status = NV_WARN_MORE_PROCESSING_REQUIRED;
+
+    return status;
+}
+
 // Scan the ordered view of faults and group them by different va_blocks.
 // Service faults for each va_block, in batch.
 //
+// If more than one fault service worker is available, the batch is split into
+// independent runs of VA blocks which are serviced in parallel. See
+// service_fault_batch_parallel.
+//
 // This function returns NV_WARN_MORE_PROCESSING_REQUIRED if the fault buffer
 // was flushed because the needs_fault_buffer_flush flag was set on some GPU VA
 // space
@@ -1490,22 +1956,33 @@ static NV_STATUS service_fault_batch(uvm_gpu_t *gpu,
     NvU32 i;
     uvm_va_space_t *va_space = NULL;
     uvm_gpu_va_space_t *gpu_va_space = NULL;
-    uvm_ats_fault_invalidate_t *ats_invalidate = &gpu->parent->fault_buffer_info.replayable.ats_invalidate;
+    uvm_replayable_fault_buffer_info_t *replayable_faults = &gpu->parent->fault_buffer_info.replayable;
+    uvm_ats_fault_invalidate_t *ats_invalidate = &replayable_faults->ats_invalidate;
     const bool replay_per_va_block = service_mode != FAULT_SERVICE_MODE_CANCEL &&
-                                     gpu->parent->fault_buffer_info.replayable.replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BLOCK;
+                                     replayable_faults->replay_policy == UVM_PERF_FAULT_REPLAY_POLICY_BLOCK;
     struct mm_struct *mm = NULL;
-    uvm_va_block_context_t *va_block_context =
-        &gpu->parent->fault_buffer_info.replayable.block_service_context.block_context;
 
     UVM_ASSERT(gpu->parent->replayable_faults_supported);
 
+    if (service_mode == FAULT_SERVICE_MODE_REGULAR &&
+        !replay_per_va_block &&
+        replayable_faults->parallel.num_workers > 1) {
+        replayable_faults->parallel.num_runs = compute_fault_batch_runs(batch_context,
+                                                                        replayable_faults->parallel.run_starts);
+        if (replayable_faults->parallel.num_runs > 1) {
+            return service_fault_batch_parallel(gpu,
+                                                batch_context,
+                                                min(replayable_faults->parallel.num_workers,
+                                                    replayable_faults->parallel.num_runs));
+        }
+    }
+
     ats_invalidate->write_faults_in_batch = false;
 
     for (i = 0; i < batch_context->num_coalesced_faults;) {
-        uvm_va_block_t *va_block;
         NvU32 block_faults;
+        bool is_managed_block;
         uvm_fault_buffer_entry_t *current_entry = batch_context->ordered_fault_cache[i];
-        uvm_fault_utlb_info_t *utlb = &batch_context->utlbs[current_entry->fault_source.utlb_id];
 
         UVM_ASSERT(current_entry->va_space);
 
@@ -1523,6 +2000,7 @@ static NV_STATUS service_fault_batch(uvm_gpu_t *gpu,
             }
 
             va_space = current_entry->va_space;
+            batch_context->va_range_hint = NULL;
 
             // ... and take the lock of the new one
 
@@ -1553,71 +2031,26 @@ static NV_STATUS service_fault_batch(uvm_gpu_t *gpu,
             // VA space is handled next
         }
 
-        // Some faults could be already fatal if they cannot be handled by
-        // the UVM driver
-        if (current_entry->is_fatal) {
-            ++i;
-            batch_context->has_fatal_faults = true;
-            utlb->has_fatal_faults = true;
-            UVM_ASSERT(utlb->num_pending_faults > 0);
-            continue;
-        }
-
-        if (!uvm_processor_mask_test(&va_space->registered_gpu_va_spaces, gpu->parent->id)) {
-            // If there is no GPU VA space for the GPU, ignore the fault. This
-            // can happen if a GPU VA space is destroyed without explicitly
-            // freeing all memory ranges (destroying the VA range triggers a
-            // flush of the fault buffer) and there are stale entries in the
-            // buffer that got fixed by the servicing in a previous batch.
-            ++i;
-            continue;
-        }
-
-        // TODO: Bug 2103669: Service more than one ATS fault at a time so we
-        //       don't do an unconditional VA range lookup for every ATS fault.
-        status = uvm_va_block_find_create(va_space,
-                                          mm,
-                                          current_entry->fault_address,
-                                          va_block_context,
-                                          &va_block);
-        if (status == NV_OK) {
-            status = service_batch_managed_faults_in_block(gpu_va_space->gpu,
-                                                           mm,
-                                                           va_block,
-                                                           i,
-                                                           batch_context,
-                                                           &block_faults);
-
-            // When service_batch_managed_faults_in_block returns != NV_OK
-            // something really bad happened
-            if (status != NV_OK)
-                goto fail;
-
-            i += block_faults;
-        }
-        else {
-            const uvm_fault_buffer_entry_t *previous_entry = i == 0? NULL : batch_context->ordered_fault_cache[i - 1];
-
-            status = service_non_managed_fault(current_entry,
-                                               previous_entry,
-                                               status,
-                                               gpu_va_space,
-                                               mm,
-                                               batch_context,
-                                               ats_invalidate,
-                                               utlb);
-
-            // When service_non_managed_fault returns != NV_OK something really
-            // bad happened
-            if (status != NV_OK)
-                goto fail;
+        status = service_fault_batch_block(gpu,
+                                           gpu_va_space,
+                                           mm,
+                                           i,
+                                           0,
+                                           batch_context,
+                                           &replayable_faults->block_service_context,
+                                           ats_invalidate,
+                                           &block_faults,
+                                           &is_managed_block);
+
+        // When service_fault_batch_block returns != NV_OK something really bad
+        // happened
+        if (status != NV_OK)
+            goto fail;
 
-            ++i;
-            continue;
-        }
+        i += block_faults;
 
         // Don't issue replays in cancel mode
-        if (replay_per_va_block) {
+        if (replay_per_va_block && is_managed_block) {
             status = push_replay_on_gpu(gpu, UVM_FAULT_REPLAY_TYPE_START, batch_context);
             if (status != NV_OK)
                 goto fail;
@@ -1880,6 +2313,7 @@ static NV_STATUS cancel_faults_precise_va(uvm_gpu_t *gpu,
                 uvm_va_space_up_read(va_space);
 
             va_space = current_entry->va_space;
+            batch_context->va_range_hint = NULL;
 
             // ... and take the lock of the new one
             uvm_va_space_down_read(va_space);
@@ -2176,12 +2610,24 @@ static void enable_disable_prefetch_faults(uvm_parent_gpu_t *parent_gpu, uvm_fau
     }
 }
 
+// Add the time elapsed since timestamp to the given phase counter, and return
+// the current time so it can be used as the start of the next phase.
+static NvU64 update_phase_time(NvU64 *phase_time_ns, NvU64 timestamp)
+{
+    NvU64 now = NV_GETTIME();
+
+    *phase_time_ns += now - timestamp;
+
+    return now;
+}
+
 void uvm_gpu_service_replayable_faults(uvm_gpu_t *gpu)
 {
     NvU32 num_replays = 0;
     NvU32 num_batches = 0;
     NvU32 num_throttled = 0;
     NV_STATUS status = NV_OK;
+    NvU64 timestamp;
     uvm_replayable_fault_buffer_info_t *replayable_faults = &gpu->parent->fault_buffer_info.replayable;
     uvm_fault_service_batch_context_t *batch_context = &replayable_faults->batch_service_context;
 
@@ -2202,13 +2648,16 @@ void uvm_gpu_service_replayable_faults(uvm_gpu_t *gpu)
         batch_context->has_fatal_faults            = false;
         batch_context->has_throttled_faults        = false;
 
+        timestamp = NV_GETTIME();
         fetch_fault_buffer_entries(gpu, batch_context, FAULT_FETCH_MODE_BATCH_READY);
+        timestamp = update_phase_time(&replayable_faults->stats.fetch_time_ns, timestamp);
         if (batch_context->num_cached_faults == 0)
             break;
 
         ++batch_context->batch_id;
 
         status = preprocess_fault_batch(gpu, batch_context);
+        timestamp = update_phase_time(&replayable_faults->stats.preprocess_time_ns, timestamp);
 
         num_replays += batch_context->num_replays;
 
@@ -2218,6 +2667,7 @@ void uvm_gpu_service_replayable_faults(uvm_gpu_t *gpu)
             break;
 
         status = service_fault_batch(gpu, FAULT_SERVICE_MODE_REGULAR, batch_context);
+        timestamp = update_phase_time(&replayable_faults->stats.service_time_ns, timestamp);
 
         // We may have issued replays even if status != NV_OK if
         // UVM_PERF_FAULT_REPLAY_POLICY_BLOCK is being used or the fault buffer
@@ -2237,6 +2687,7 @@ void uvm_gpu_service_replayable_faults(uvm_gpu_t *gpu)
             // the cancel operation since this path is already returning an
             // error code.
             cancel_fault_batch(gpu, batch_context, uvm_tools_status_to_fatal_fault_reason(status));
+            update_phase_time(&replayable_faults->stats.replay_time_ns, timestamp);
             break;
         }
 
@@ -2245,6 +2696,7 @@ void uvm_gpu_service_replayable_faults(uvm_gpu_t *gpu)
             if (status == NV_OK)
                 status = cancel_faults_precise(gpu, batch_context);
 
+            update_phase_time(&replayable_faults->stats.replay_time_ns, timestamp);
             break;
         }
 
@@ -2271,6 +2723,8 @@ void uvm_gpu_service_replayable_faults(uvm_gpu_t *gpu)
                 break;
         }
 
+        update_phase_time(&replayable_faults->stats.replay_time_ns, timestamp);
+
         if (batch_context->has_throttled_faults)
             ++num_throttled;
 
@@ -2381,3 +2835,117 @@ NV_STATUS uvm_test_drain_replayable_faults(UVM_TEST_DRAIN_REPLAYABLE_FAULTS_PARA
 
     return status;
 }
+
+static void fault_batch_sort_benchmark_fill(uvm_fault_buffer_entry_t *faults,
+                                            UVM_TEST_FAULT_BATCH_SORT_BENCHMARK_PARAMS *params,
+                                            uvm_test_rng_t *rng)
+{
+    NvU32 i;
+
+    for (i = 0; i < params->batchSize; ++i) {
+        uvm_fault_buffer_entry_t *fault = &faults[i];
+        NvU32 va_space_index = uvm_test_rng_range_32(rng, 0, params->vaSpaceCount - 1);
+        NvU64 block_index = uvm_test_rng_range_64(rng, 0, params->blockCount - 1);
+        NvU64 page_index = uvm_test_rng_range_64(rng, 0, PAGES_PER_UVM_VA_BLOCK - 1);
+
+        // VA spaces are never dereferenced by the sorts, so any distinct
+        // pointer values will do
+        fault->va_space = (uvm_va_space_t *)(uintptr_t)((va_space_index + 1) * PAGE_SIZE);
+        fault->fault_address = (block_index + 1) * UVM_VA_BLOCK_SIZE + page_index * PAGE_SIZE;
+        fault->fault_access_type = uvm_test_rng_range_32(rng, 0, UVM_FAULT_ACCESS_TYPE_COUNT - 1);
+    }
+}
+
+NV_STATUS uvm_test_fault_batch_sort_benchmark(UVM_TEST_FAULT_BATCH_SORT_BENCHMARK_PARAMS *params, struct file *filp)
+{
+    uvm_fault_buffer_entry_t *faults = NULL;
+    uvm_fault_buffer_entry_t **radix_order = NULL;
+    uvm_fault_buffer_entry_t **generic_order = NULL;
+    uvm_radix_sort_entry_t *sort_entries = NULL;
+    uvm_radix_sort_entry_t *sort_scratch = NULL;
+    uvm_test_rng_t rng;
+    NV_STATUS status = NV_OK;
+    NvU32 iteration;
+    NvU32 i;
+
+    if (params->batchSize == 0 ||
+        params->batchSize > UVM_TEST_FAULT_BATCH_SORT_BENCHMARK_MAX_BATCH_SIZE ||
+        params->iterations == 0 ||
+        params->vaSpaceCount == 0 ||
+        params->blockCount == 0)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    faults = uvm_kvmalloc_zero(params->batchSize * sizeof(*faults));
+    radix_order = uvm_kvmalloc(params->batchSize * sizeof(*radix_order));
+    generic_order = uvm_kvmalloc(params->batchSize * sizeof(*generic_order));
+    sort_entries = uvm_kvmalloc(params->batchSize * sizeof(*sort_entries));
+    sort_scratch = uvm_kvmalloc(params->batchSize * sizeof(*sort_scratch));
+    if (!faults || !radix_order || !generic_order || !sort_entries || !sort_scratch) {
+        status = NV_ERR_NO_MEMORY;
+        goto done;
+    }
+
+    uvm_test_rng_init(&rng, params->seed);
+
+    params->radixSortNs = 0;
+    params->genericSortNs = 0;
+
+    for (iteration = 0; iteration < params->iterations; ++iteration) {
+        NvU64 start;
+
+        fault_batch_sort_benchmark_fill(faults, params, &rng);
+
+        for (i = 0; i < params->batchSize; ++i) {
+            radix_order[i] = &faults[i];
+            generic_order[i] = &faults[i];
+        }
+
+        start = NV_GETTIME();
+        sort_fault_entries(radix_order, params->batchSize, sort_entries, sort_scratch);
+        params->radixSortNs += NV_GETTIME() - start;
+
+        start = NV_GETTIME();
+        sort(generic_order,
+             params->batchSize,
+             sizeof(*generic_order),
+             cmp_sort_fault_entry_by_va_space_address_access_type,
+             NULL);
+        params->genericSortNs += NV_GETTIME() - start;
+
+        // The generic sort is not stable, so only the keys can be compared
+        for (i = 0; i < params->batchSize; ++i) {
+            if (cmp_sort_fault_entry_by_va_space_address_access_type(&radix_order[i], &generic_order[i]) != 0) {
+                UVM_TEST_PRINT("Sort mismatch at index %u of iteration %u\n", i, iteration);
+                status = NV_ERR_INVALID_STATE;
+                goto done;
+            }
+        }
+
+        // The radix sort is stable: faults with the same key stay in batch
+        // order, which is also their order in the faults array
+        for (i = 1; i < params->batchSize; ++i) {
+            if (cmp_sort_fault_entry_by_va_space_address_access_type(&radix_order[i - 1], &radix_order[i]) == 0 &&
+                radix_order[i - 1] > radix_order[i]) {
+                UVM_TEST_PRINT("Unstable sort at index %u of iteration %u\n", i, iteration);
+                status = NV_ERR_INVALID_STATE;
+                goto done;
+            }
+        }
+
+        if (fatal_signal_pending(current)) {
+            status = NV_ERR_SIGNAL_PENDING;
+            goto done;
+        }
+
+        cond_resched();
+    }
+
+done:
+    uvm_kvfree(sort_scratch);
+    uvm_kvfree(sort_entries);
+    uvm_kvfree(generic_order);
+    uvm_kvfree(radix_order);
+    uvm_kvfree(faults);
+
+    return status;
+}
@@ -1048,6 +1048,45 @@ typedef struct
     NV_STATUS               rmStatus;                                          // OUT
 } UVM_MAP_EXTERNAL_SPARSE_PARAMS;
 
+//
+// Initialize an event queue made of subQueueCount independent rings. Events
+// recorded on CPU n go to ring (n % subQueueCount), so producers on different
+// CPUs do not contend. queueBuffer holds subQueueCount consecutive rings of
+// queueBufferSize UvmEventEntry each, and controlBuffer holds subQueueCount
+// consecutive UvmToolsEventControlData, one per ring. Each ring follows the
+// same get/put protocol as a UVM_TOOLS_INIT_EVENT_TRACKER queue; consumers
+// either drain the rings separately or merge them by timestamp.
+//
+#define UVM_TOOLS_INIT_PER_CPU_EVENT_QUEUE                            UVM_IOCTL_BASE(75)
+typedef struct
+{
+    NvU64           queueBuffer        NV_ALIGN_BYTES(8); // IN
+    NvU64           queueBufferSize    NV_ALIGN_BYTES(8); // IN, entries per ring
+    NvU64           controlBuffer      NV_ALIGN_BYTES(8); // IN
+    NvU32           subQueueCount;                        // IN
+    NvU32           uvmFd;                                // IN
+    NV_STATUS       rmStatus;                             // OUT
+} UVM_TOOLS_INIT_PER_CPU_EVENT_QUEUE_PARAMS;
+
+//
+// Initialize a counter tracker like UVM_TOOLS_INIT_EVENT_TRACKER with a zero
+// queueBufferSize, but with an explicitly sized counter array.
+// controlBufferSize is the size in bytes of the NvU64 array at controlBuffer,
+// indexed by UvmCounterName. It must cover at least UVM_TOTAL_COUNTERS
+// entries, and only counters it covers can be enabled. Entries past
+// UVM_TOTAL_COUNTERS_EXTENDED are left untouched.
+//
+#define UVM_TOOLS_INIT_COUNTER_TRACKER                                UVM_IOCTL_BASE(76)
+typedef struct
+{
+    NvU64           controlBuffer      NV_ALIGN_BYTES(8); // IN
+    NvU64           controlBufferSize  NV_ALIGN_BYTES(8); // IN
+    NvProcessorUuid processor;                            // IN
+    NvU32           allProcessors;                        // IN
+    NvU32           uvmFd;                                // IN
+    NV_STATUS       rmStatus;                             // OUT
+} UVM_TOOLS_INIT_COUNTER_TRACKER_PARAMS;
+
 //
 // Temporary ioctls which should be removed before UVM 8 release
 // Number backwards from 2047 - highest custom ioctl function number
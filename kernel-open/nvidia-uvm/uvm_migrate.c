@@ -39,6 +39,7 @@
 #include "uvm_migrate.h"
 #include "uvm_migrate_pageable.h"
 #include "uvm_va_space_mm.h"
+#include "uvm_test.h"
 #include "nv_speculation_barrier.h"
 
 typedef enum
@@ -207,6 +208,8 @@ NV_STATUS uvm_va_block_migrate_locked(uvm_va_block_t *va_block,
 
     uvm_assert_mutex_locked(&va_block->lock);
 
+    uvm_page_mask_zero(&va_block_context->make_resident.pages_changed_residency);
+
     if (uvm_va_policy_is_read_duplicate(va_block_context->policy, va_space)) {
         status = uvm_va_block_make_resident_read_duplicate(va_block,
                                                            va_block_retry,
@@ -228,6 +231,11 @@ NV_STATUS uvm_va_block_migrate_locked(uvm_va_block_t *va_block,
                                             UVM_MAKE_RESIDENT_CAUSE_API_MIGRATE);
     }
 
+    if (status == NV_OK) {
+        va_block_context->migrated_bytes +=
+            uvm_page_mask_weight(&va_block_context->make_resident.pages_changed_residency) * PAGE_SIZE;
+    }
+
     if (status == NV_OK && mode == UVM_MIGRATE_MODE_MAKE_RESIDENT_AND_MAP) {
         // block_migrate_add_mappings will acquire the work from the above
         // make_resident call and update the VA block tracker.
@@ -590,7 +598,8 @@ static NV_STATUS uvm_migrate(uvm_va_space_t *va_space,
                              NvU64 length,
                              uvm_processor_id_t dest_id,
                              NvU32 migrate_flags,
-                             uvm_tracker_t *out_tracker)
+                             uvm_tracker_t *out_tracker,
+                             NvU64 *out_migrated_bytes)
 {
     NV_STATUS status = NV_OK;
     uvm_va_range_t *first_va_range = uvm_va_space_iter_first(va_space, base, base);
@@ -670,6 +679,9 @@ static NV_STATUS uvm_migrate(uvm_va_space_t *va_space,
                                     out_tracker);
     }
 
+    if (out_migrated_bytes)
+        *out_migrated_bytes += va_block_context->migrated_bytes;
+
     uvm_va_block_context_free(va_block_context);
 
     return status;
@@ -833,6 +845,8 @@ NV_STATUS uvm_api_migrate(UVM_MIGRATE_PARAMS *params, struct file *filp)
     NV_STATUS status = NV_OK;
     bool flush_events = false;
     const bool synchronous = !(params->flags & UVM_MIGRATE_FLAG_ASYNC);
+    NvU64 start_time = NV_GETTIME();
+    NvU64 migrated_bytes = 0;
 
     // We temporarily allow 0 length in the IOCTL parameters as a signal to
     // only release the semaphore. This is because user-space is in charge of
@@ -912,7 +926,8 @@ NV_STATUS uvm_api_migrate(UVM_MIGRATE_PARAMS *params, struct file *filp)
                                  params->length,
                                  (dest_gpu ? dest_gpu->id : UVM_ID_CPU),
                                  params->flags,
-                                 tracker_ptr);
+                                 tracker_ptr,
+                                 &migrated_bytes);
         }
         else if (status == NV_WARN_NOTHING_TO_DO) {
             uvm_migrate_args_t uvm_migrate_args =
@@ -972,6 +987,14 @@ done:
         uvm_tracker_deinit(tracker_ptr);
     }
 
+    // Only synchronous migrations are known to be complete at this point
+    if (synchronous && status == NV_OK) {
+        uvm_tools_record_migration_throughput(va_space,
+                                              dest_gpu ? dest_gpu->id : UVM_ID_CPU,
+                                              migrated_bytes,
+                                              NV_GETTIME() - start_time);
+    }
+
     uvm_va_space_up_read(va_space);
 
     // If the migration is known to be complete, eagerly dispatch the migration
@@ -1029,7 +1052,7 @@ NV_STATUS uvm_api_migrate_range_group(UVM_MIGRATE_RANGE_GROUP_PARAMS *params, st
         if (gpu && !uvm_gpu_can_address(gpu, start, length))
             status = NV_ERR_OUT_OF_RANGE;
         else
-            status = uvm_migrate(va_space, mm, start, length, dest_id, migrate_flags, &local_tracker);
+            status = uvm_migrate(va_space, mm, start, length, dest_id, migrate_flags, &local_tracker, NULL);
 
         if (status != NV_OK)
             goto done;
@@ -1056,3 +1079,79 @@ done:
 
     return status == NV_OK? tracker_status : status;
 }
+
+NV_STATUS uvm_test_migrate_benchmark(UVM_TEST_MIGRATE_BENCHMARK_PARAMS *params, struct file *filp)
+{
+    uvm_va_space_t *va_space = uvm_va_space_get(filp);
+    uvm_tracker_t tracker = UVM_TRACKER_INIT();
+    uvm_processor_id_t dest_id = UVM_ID_CPU;
+    struct mm_struct *mm;
+    NV_STATUS status = NV_OK, tracker_status;
+    NvU64 migrated_bytes = 0;
+    NvU64 start_time;
+    NvU64 offset;
+
+    if (uvm_api_range_invalid(params->base, params->length))
+        return NV_ERR_INVALID_ADDRESS;
+
+    if (params->chunkSize == 0 || !PAGE_ALIGNED(params->chunkSize))
+        return NV_ERR_INVALID_ARGUMENT;
+
+    mm = uvm_va_space_mm_or_current_retain_lock(va_space);
+    uvm_va_space_down_read(va_space);
+
+    if (!uvm_uuid_is_cpu(&params->destinationUuid)) {
+        uvm_gpu_t *dest_gpu = uvm_va_space_get_gpu_by_uuid_with_gpu_va_space(va_space, &params->destinationUuid);
+
+        if (!dest_gpu) {
+            status = NV_ERR_INVALID_DEVICE;
+            goto done;
+        }
+
+        dest_id = dest_gpu->id;
+    }
+
+    start_time = NV_GETTIME();
+
+    // Push all the chunks before waiting, so that the copies of a chunk
+    // overlap with the mapping updates of the previous ones
+    for (offset = 0; offset < params->length; offset += params->chunkSize) {
+        status = uvm_migrate(va_space,
+                             mm,
+                             params->base + offset,
+                             min(params->chunkSize, params->length - offset),
+                             dest_id,
+                             0,
+                             &tracker,
+                             &migrated_bytes);
+        if (status != NV_OK)
+            break;
+
+        if (fatal_signal_pending(current)) {
+            status = NV_ERR_SIGNAL_PENDING;
+            break;
+        }
+    }
+
+    tracker_status = uvm_tracker_wait(&tracker);
+    if (status == NV_OK)
+        status = tracker_status;
+
+    params->durationNs = NV_GETTIME() - start_time;
+    params->migratedBytes = migrated_bytes;
+
+    if (status == NV_OK)
+        uvm_tools_record_migration_throughput(va_space, dest_id, migrated_bytes, params->durationNs);
+
+done:
+    uvm_tracker_deinit(&tracker);
+
+    if (mm) {
+        uvm_up_read_mmap_lock_out_of_order(mm);
+        uvm_va_space_mm_or_current_release(va_space, mm);
+    }
+
+    uvm_va_space_up_read(va_space);
+
+    return status;
+}
@@ -28,6 +28,7 @@
 #include "uvm_kvmalloc.h"
 #include "uvm_va_block.h"
 #include "uvm_va_range.h"
+#include "uvm_tools.h"
 #include "uvm_test.h"
 
 // Global cache to allocate the per-VA block prefetch detection structures
@@ -55,6 +56,106 @@ typedef struct
     NvU16 fault_migrations_to_last_proc;
 } block_prefetch_info_t;
 
+//
+// Cross-block stream prediction
+//
+// The bitmap tree only looks at the faulting VA block. The stream predictor
+// instead watches the order in which the blocks of each VA range are first
+// touched by each processor. Once the same block stride is seen twice in a
+// row it predicts the next block of the stream, and when that block is
+// touched it is prefetched whole instead of growing the prefetch region fault
+// by fault. The accuracy of the predictions also steers the bitmap tree
+// threshold of the VA space: regular access patterns lower it, and
+// mispredictions bring it back up to uvm_perf_prefetch_threshold.
+//
+
+// Number of streams tracked per VA space
+#define UVM_PREFETCH_STREAM_COUNT             16
+
+// Largest stride, in blocks, that continues an existing stream
+#define UVM_PREFETCH_STREAM_MAX_STRIDE        16
+
+// Number of consecutive equal strides needed to make a prediction
+#define UVM_PREFETCH_STREAM_CONFIDENCE_MIN    2
+#define UVM_PREFETCH_STREAM_CONFIDENCE_MAX    3
+
+// The threshold is adapted once per this many predictions
+#define UVM_PREFETCH_ADAPT_WINDOW             16
+#define UVM_PREFETCH_ADAPT_STEP               5
+#define UVM_PREFETCH_ADAPT_HIGH_ACCURACY      75
+#define UVM_PREFETCH_ADAPT_LOW_ACCURACY       50
+#define UVM_PREFETCH_THRESHOLD_ADAPTIVE_MIN   25
+
+typedef struct
+{
+    // Opaque identifier of the VA range. 0 for unused entries.
+    NvU64 tag;
+
+    NvU32 processor;
+
+    NvU64 last_block;
+
+    NvS64 stride;
+
+    NvU32 confidence;
+
+    bool has_prediction;
+
+    NvU64 predicted_block;
+
+    NvU64 last_use;
+} prefetch_stream_t;
+
+typedef struct
+{
+    prefetch_stream_t streams[UVM_PREFETCH_STREAM_COUNT];
+
+    NvU64 clock;
+
+    // Bitmap tree threshold in use and the value it is adapted back to
+    unsigned threshold;
+    unsigned base_threshold;
+
+    NvU32 window_predictions;
+    NvU32 window_hits;
+
+    NvU64 first_touches;
+    NvU64 predictions;
+    NvU64 hits;
+} prefetch_predictor_t;
+
+typedef struct
+{
+    // The touched block had been predicted
+    bool hit;
+
+    // A prediction was made for the next block of the stream
+    bool predicted;
+} prefetch_observation_t;
+
+typedef struct
+{
+    const char *name;
+
+    // Record the first touch of block_index, out of block_count blocks in the
+    // VA range identified by tag, by the given processor. NULL for predictors
+    // that only use the bitmap tree.
+    void (*observe)(prefetch_predictor_t *predictor,
+                    NvU64 tag,
+                    NvU32 processor,
+                    NvU64 block_index,
+                    NvU64 block_count,
+                    prefetch_observation_t *observation);
+} prefetch_predictor_ops_t;
+
+// Per-VA space prefetch state
+typedef struct
+{
+    uvm_spinlock_t lock;
+
+    prefetch_predictor_t predictor;
+} va_space_prefetch_info_t;
+
 //
 // Tunables for prefetch detection/prevention (configurable via module parameters)
 //
@@ -71,6 +172,18 @@ static unsigned uvm_perf_prefetch_enable = 1;
 // Valid values 1-100
 static unsigned uvm_perf_prefetch_threshold  = UVM_PREFETCH_THRESHOLD_DEFAULT;
 
+typedef enum
+{
+    UVM_PREFETCH_PREDICTOR_NONE = 0,
+    UVM_PREFETCH_PREDICTOR_STRIDE,
+    UVM_PREFETCH_PREDICTOR_COUNT
+} uvm_prefetch_predictor_t;
+
+// Cross-block predictor used on top of the bitmap tree
+//
+// Valid values: 0 (none), 1 (stride)
+static unsigned uvm_perf_prefetch_predictor = UVM_PREFETCH_PREDICTOR_STRIDE;
+
 #define UVM_PREFETCH_MIN_FAULTS_MIN     1
 #define UVM_PREFETCH_MIN_FAULTS_DEFAULT 1
 #define UVM_PREFETCH_MIN_FAULTS_MAX     20
@@ -83,15 +196,154 @@ static unsigned uvm_perf_prefetch_min_faults = UVM_PREFETCH_MIN_FAULTS_DEFAULT;
 module_param(uvm_perf_prefetch_enable, uint, S_IRUGO);
 module_param(uvm_perf_prefetch_threshold, uint, S_IRUGO);
 module_param(uvm_perf_prefetch_min_faults, uint, S_IRUGO);
+module_param(uvm_perf_prefetch_predictor, uint, S_IRUGO);
 
 static bool g_uvm_perf_prefetch_enable;
 static unsigned g_uvm_perf_prefetch_threshold;
 static unsigned g_uvm_perf_prefetch_min_faults;
 
+static void stride_predictor_observe(prefetch_predictor_t *predictor,
+                                     NvU64 tag,
+                                     NvU32 processor,
+                                     NvU64 block_index,
+                                     NvU64 block_count,
+                                     prefetch_observation_t *observation);
+
+static const prefetch_predictor_ops_t g_prefetch_predictors[UVM_PREFETCH_PREDICTOR_COUNT] = {
+    [UVM_PREFETCH_PREDICTOR_NONE]   = { "none",   NULL                     },
+    [UVM_PREFETCH_PREDICTOR_STRIDE] = { "stride", stride_predictor_observe },
+};
+
+static const prefetch_predictor_ops_t *g_prefetch_predictor;
+
 // Callback declaration for the performance heuristics events
 static void prefetch_block_destroy_cb(uvm_perf_event_t event_id, uvm_perf_event_data_t *event_data);
+static void prefetch_range_destroy_cb(uvm_perf_event_t event_id, uvm_perf_event_data_t *event_data);
 
-static uvm_va_block_region_t compute_prefetch_region(uvm_page_index_t page_index, block_prefetch_info_t *prefetch_info)
+static void predictor_init(prefetch_predictor_t *predictor)
+{
+    memset(predictor, 0, sizeof(*predictor));
+    predictor->threshold = g_uvm_perf_prefetch_threshold;
+    predictor->base_threshold = g_uvm_perf_prefetch_threshold;
+}
+
+// Move the bitmap tree threshold according to the accuracy of the last window
+// of predictions
+static void predictor_adapt_threshold(prefetch_predictor_t *predictor)
+{
+    unsigned floor = min((unsigned)UVM_PREFETCH_THRESHOLD_ADAPTIVE_MIN, predictor->base_threshold);
+    NvU32 accuracy;
+
+    if (predictor->window_predictions < UVM_PREFETCH_ADAPT_WINDOW)
+        return;
+
+    accuracy = min(predictor->window_hits, predictor->window_predictions) * 100 / predictor->window_predictions;
+
+    if (accuracy >= UVM_PREFETCH_ADAPT_HIGH_ACCURACY) {
+        if (predictor->threshold >= floor + UVM_PREFETCH_ADAPT_STEP)
+            predictor->threshold -= UVM_PREFETCH_ADAPT_STEP;
+        else
+            predictor->threshold = floor;
+    }
+    else if (accuracy < UVM_PREFETCH_ADAPT_LOW_ACCURACY) {
+        predictor->threshold = min(predictor->threshold + UVM_PREFETCH_ADAPT_STEP, predictor->base_threshold);
+    }
+
+    predictor->window_predictions = 0;
+    predictor->window_hits = 0;
+}
+
+static void stride_predictor_observe(prefetch_predictor_t *predictor,
+                                     NvU64 tag,
+                                     NvU32 processor,
+                                     NvU64 block_index,
+                                     NvU64 block_count,
+                                     prefetch_observation_t *observation)
+{
+    prefetch_stream_t *stream = NULL;
+    prefetch_stream_t *victim = &predictor->streams[0];
+    NvS64 next_block;
+    NvS64 distance;
+    NvU32 i;
+
+    UVM_ASSERT(tag != 0);
+    UVM_ASSERT(block_index < block_count);
+
+    observation->hit = false;
+    observation->predicted = false;
+
+    ++predictor->clock;
+
+    for (i = 0; i < UVM_PREFETCH_STREAM_COUNT; i++) {
+        prefetch_stream_t *candidate = &predictor->streams[i];
+
+        if (candidate->tag == tag && candidate->processor == processor) {
+            // Repeated notification for the block the stream is already on
+            if (candidate->last_block == block_index) {
+                candidate->last_use = predictor->clock;
+                return;
+            }
+
+            if (candidate->has_prediction && candidate->predicted_block == block_index) {
+                stream = candidate;
+                observation->hit = true;
+                break;
+            }
+
+            distance = (NvS64)(block_index - candidate->last_block);
+            if (!stream && distance >= -UVM_PREFETCH_STREAM_MAX_STRIDE && distance <= UVM_PREFETCH_STREAM_MAX_STRIDE)
+                stream = candidate;
+        }
+
+        if (candidate->last_use < victim->last_use)
+            victim = candidate;
+    }
+
+    ++predictor->first_touches;
+
+    if (!stream) {
+        memset(victim, 0, sizeof(*victim));
+        victim->tag = tag;
+        victim->processor = processor;
+        victim->last_block = block_index;
+        victim->last_use = predictor->clock;
+        return;
+    }
+
+    distance = (NvS64)(block_index - stream->last_block);
+    if (observation->hit) {
+        ++predictor->hits;
+        ++predictor->window_hits;
+        stream->confidence = min(stream->confidence + 1, (NvU32)UVM_PREFETCH_STREAM_CONFIDENCE_MAX);
+    }
+    else if (distance == stream->stride) {
+        stream->confidence = min(stream->confidence + 1, (NvU32)UVM_PREFETCH_STREAM_CONFIDENCE_MAX);
+    }
+    else {
+        stream->stride = distance;
+        stream->confidence = 1;
+    }
+
+    stream->last_block = block_index;
+    stream->last_use = predictor->clock;
+    stream->has_prediction = false;
+
+    next_block = (NvS64)block_index + stream->stride;
+    if (stream->confidence >= UVM_PREFETCH_STREAM_CONFIDENCE_MIN && next_block >= 0 && next_block < (NvS64)block_count) {
+        stream->has_prediction = true;
+        stream->predicted_block = next_block;
+        observation->predicted = true;
+
+        ++predictor->predictions;
+        ++predictor->window_predictions;
+    }
+
+    predictor_adapt_threshold(predictor);
+}
+
+static uvm_va_block_region_t compute_prefetch_region(uvm_page_index_t page_index,
+                                                     block_prefetch_info_t *prefetch_info,
+                                                     unsigned threshold)
 {
     NvU16 counter;
     uvm_va_block_bitmap_tree_iter_t iter;
@@ -104,7 +356,7 @@ static uvm_va_block_region_t compute_prefetch_region(uvm_page_index_t page_index
         NvU16 subregion_pages = uvm_va_block_region_num_pages(subregion);
 
         UVM_ASSERT(counter <= subregion_pages);
-        if (counter * 100 > subregion_pages * g_uvm_perf_prefetch_threshold)
+        if (counter * 100 > subregion_pages * threshold)
             prefetch_region = subregion;
     }
 
@@ -126,9 +378,54 @@ static uvm_perf_module_t g_module_prefetch;
 static uvm_perf_module_event_callback_desc_t g_callbacks_prefetch[] = {
     { UVM_PERF_EVENT_BLOCK_DESTROY, prefetch_block_destroy_cb },
     { UVM_PERF_EVENT_MODULE_UNLOAD, prefetch_block_destroy_cb },
-    { UVM_PERF_EVENT_BLOCK_SHRINK,  prefetch_block_destroy_cb }
+    { UVM_PERF_EVENT_BLOCK_SHRINK,  prefetch_block_destroy_cb },
+    { UVM_PERF_EVENT_RANGE_DESTROY, prefetch_range_destroy_cb }
 };
 
+static va_space_prefetch_info_t *va_space_prefetch_info_get(uvm_va_space_t *va_space)
+{
+    return uvm_perf_module_type_data(va_space->perf_modules_data, UVM_PERF_MODULE_TYPE_PREFETCH);
+}
+
+// Feed the first touch of va_block by new_residency to the stream predictor.
+// Returns true if the touch had been predicted.
+static bool prefetch_predictor_observe(uvm_va_block_t *va_block, uvm_processor_id_t new_residency)
+{
+    uvm_va_space_t *va_space = uvm_va_block_get_va_space(va_block);
+    va_space_prefetch_info_t *va_space_prefetch_info = va_space_prefetch_info_get(va_space);
+    uvm_va_range_t *va_range = va_block->va_range;
+    prefetch_observation_t observation;
+    NvU64 block_count;
+
+    if (!g_prefetch_predictor->observe || !va_space_prefetch_info || uvm_va_block_is_hmm(va_block))
+        return false;
+
+    block_count = uvm_va_range_num_blocks(va_range);
+
+    uvm_spin_lock(&va_space_prefetch_info->lock);
+    g_prefetch_predictor->observe(&va_space_prefetch_info->predictor,
+                                  (NvU64)(uintptr_t)va_range,
+                                  uvm_id_value(new_residency),
+                                  uvm_va_range_block_index(va_range, va_block->start),
+                                  block_count,
+                                  &observation);
+    uvm_spin_unlock(&va_space_prefetch_info->lock);
+
+    uvm_tools_record_prefetch_prediction(va_space, new_residency, observation.predicted, observation.hit);
+
+    return observation.hit;
+}
+
+static unsigned prefetch_threshold(uvm_va_space_t *va_space)
+{
+    va_space_prefetch_info_t *va_space_prefetch_info = va_space_prefetch_info_get(va_space);
+
+    if (!va_space_prefetch_info)
+        return g_uvm_perf_prefetch_threshold;
+
+    return READ_ONCE(va_space_prefetch_info->predictor.threshold);
+}
+
 // Get the prefetch detection struct for the given block
 static block_prefetch_info_t *prefetch_info_get(uvm_va_block_t *va_block)
 {
@@ -251,6 +548,7 @@ void uvm_perf_prefetch_prenotify_fault_migrations(uvm_va_block_t *va_block,
     const uvm_page_mask_t *thrashing_pages = NULL;
     uvm_va_space_t *va_space = uvm_va_block_get_va_space(va_block);
     uvm_va_policy_t *policy = va_block_context->policy;
+    unsigned threshold;
 
     uvm_assert_rwsem_locked(&va_space->lock);
 
@@ -271,6 +569,15 @@ void uvm_perf_prefetch_prenotify_fault_migrations(uvm_va_block_t *va_block,
     if (UVM_ID_IS_CPU(new_residency) || va_block->gpus[uvm_id_gpu_index(new_residency)] != NULL)
         resident_mask = uvm_va_block_resident_mask_get(va_block, new_residency);
 
+    // If the stream predictor expected new_residency to move on to this block,
+    // bring in all of it now rather than one density step per fault
+    if ((!resident_mask || uvm_page_mask_empty(resident_mask)) &&
+        prefetch_predictor_observe(va_block, new_residency)) {
+        thrashing_pages = uvm_perf_thrashing_get_thrashing_pages(va_block);
+        uvm_page_mask_region_fill(&prefetch_info->prefetch_pages, uvm_va_block_region_from_block(va_block));
+        goto done;
+    }
+
     // If this is a first-touch fault and the destination processor is the
     // preferred location, populate the whole VA block
     if (uvm_processor_mask_empty(&va_block->resident) &&
@@ -325,10 +632,12 @@ void uvm_perf_prefetch_prenotify_fault_migrations(uvm_va_block_t *va_block,
         uvm_page_mask_copy(&prefetch_info->migrate_pages, faulted_pages);
 
     // Update the tree using the migration mask to compute the pages to prefetch
+    threshold = prefetch_threshold(va_space);
     uvm_page_mask_zero(&prefetch_info->prefetch_pages);
     for_each_va_block_page_in_region_mask(page_index, &prefetch_info->migrate_pages, region) {
         uvm_va_block_region_t prefetch_region = compute_prefetch_region(page_index + prefetch_info->region.first,
-                                                                        prefetch_info);
+                                                                        prefetch_info,
+                                                                        threshold);
         uvm_page_mask_region_fill(&prefetch_info->prefetch_pages, prefetch_region);
 
         // Early out if we have already prefetched until the end of the VA block
@@ -444,20 +753,72 @@ void prefetch_block_destroy_cb(uvm_perf_event_t event_id, uvm_perf_event_data_t
     prefetch_info_destroy(va_block);
 }
 
+// Forget the streams of a destroyed VA range so that a new range allocated at
+// the same address does not inherit them
+void prefetch_range_destroy_cb(uvm_perf_event_t event_id, uvm_perf_event_data_t *event_data)
+{
+    uvm_va_range_t *va_range = event_data->range_destroy.range;
+    va_space_prefetch_info_t *va_space_prefetch_info;
+    NvU64 tag = (NvU64)(uintptr_t)va_range;
+    NvU32 i;
+
+    UVM_ASSERT(g_uvm_perf_prefetch_enable);
+    UVM_ASSERT(event_id == UVM_PERF_EVENT_RANGE_DESTROY);
+
+    va_space_prefetch_info = va_space_prefetch_info_get(va_range->va_space);
+    if (!va_space_prefetch_info)
+        return;
+
+    uvm_spin_lock(&va_space_prefetch_info->lock);
+    for (i = 0; i < UVM_PREFETCH_STREAM_COUNT; i++) {
+        prefetch_stream_t *stream = &va_space_prefetch_info->predictor.streams[i];
+
+        if (stream->tag == tag)
+            memset(stream, 0, sizeof(*stream));
+    }
+    uvm_spin_unlock(&va_space_prefetch_info->lock);
+}
+
 NV_STATUS uvm_perf_prefetch_load(uvm_va_space_t *va_space)
 {
+    va_space_prefetch_info_t *va_space_prefetch_info;
+    NV_STATUS status;
+
     if (!g_uvm_perf_prefetch_enable)
         return NV_OK;
 
-    return uvm_perf_module_load(&g_module_prefetch, va_space);
+    status = uvm_perf_module_load(&g_module_prefetch, va_space);
+    if (status != NV_OK)
+        return status;
+
+    va_space_prefetch_info = uvm_kvmalloc_zero(sizeof(*va_space_prefetch_info));
+    if (!va_space_prefetch_info) {
+        uvm_perf_module_unload(&g_module_prefetch, va_space);
+        return NV_ERR_NO_MEMORY;
+    }
+
+    uvm_spin_lock_init(&va_space_prefetch_info->lock, UVM_LOCK_ORDER_LEAF);
+    predictor_init(&va_space_prefetch_info->predictor);
+
+    uvm_perf_module_type_set_data(va_space->perf_modules_data, va_space_prefetch_info, UVM_PERF_MODULE_TYPE_PREFETCH);
+
+    return NV_OK;
 }
 
 void uvm_perf_prefetch_unload(uvm_va_space_t *va_space)
 {
+    va_space_prefetch_info_t *va_space_prefetch_info;
+
     if (!g_uvm_perf_prefetch_enable)
         return;
 
     uvm_perf_module_unload(&g_module_prefetch, va_space);
+
+    va_space_prefetch_info = va_space_prefetch_info_get(va_space);
+    if (va_space_prefetch_info) {
+        uvm_perf_module_type_unset_data(va_space->perf_modules_data, UVM_PERF_MODULE_TYPE_PREFETCH);
+        uvm_kvfree(va_space_prefetch_info);
+    }
 }
 
 NV_STATUS uvm_perf_prefetch_init()
@@ -495,6 +856,16 @@ NV_STATUS uvm_perf_prefetch_init()
         g_uvm_perf_prefetch_min_faults = UVM_PREFETCH_MIN_FAULTS_DEFAULT;
     }
 
+    if (uvm_perf_prefetch_predictor < UVM_PREFETCH_PREDICTOR_COUNT) {
+        g_prefetch_predictor = &g_prefetch_predictors[uvm_perf_prefetch_predictor];
+    }
+    else {
+        pr_info("Invalid value %u for uvm_perf_prefetch_predictor. Using %u instead\n",
+                uvm_perf_prefetch_predictor, UVM_PREFETCH_PREDICTOR_STRIDE);
+
+        g_prefetch_predictor = &g_prefetch_predictors[UVM_PREFETCH_PREDICTOR_STRIDE];
+    }
+
     return NV_OK;
 }
 
@@ -524,3 +895,51 @@ NV_STATUS uvm_test_set_page_prefetch_policy(UVM_TEST_SET_PAGE_PREFETCH_POLICY_PA
 
     return NV_OK;
 }
+
+NV_STATUS uvm_test_prefetch_predictor_replay(UVM_TEST_PREFETCH_PREDICTOR_REPLAY_PARAMS *params, struct file *filp)
+{
+    prefetch_predictor_t *predictor;
+    NvU32 i;
+
+    if (params->traceLength > UVM_TEST_PREFETCH_PREDICTOR_TRACE_MAX_LENGTH)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    for (i = 0; i < params->traceLength; i++) {
+        if (params->trace[i].rangeTag == 0 || params->trace[i].blockIndex >= params->blockCount)
+            return NV_ERR_INVALID_ARGUMENT;
+    }
+
+    predictor = uvm_kvmalloc(sizeof(*predictor));
+    if (!predictor)
+        return NV_ERR_NO_MEMORY;
+
+    // Replay against the stride predictor even if it is not the one in use,
+    // and with the configured threshold even if prefetching is disabled
+    predictor_init(predictor);
+    if (!g_uvm_perf_prefetch_enable) {
+        predictor->threshold = UVM_PREFETCH_THRESHOLD_DEFAULT;
+        predictor->base_threshold = UVM_PREFETCH_THRESHOLD_DEFAULT;
+    }
+
+    for (i = 0; i < params->traceLength; i++) {
+        prefetch_observation_t observation;
+
+        stride_predictor_observe(predictor,
+                                 params->trace[i].rangeTag,
+                                 params->trace[i].processor,
+                                 params->trace[i].blockIndex,
+                                 params->blockCount,
+                                 &observation);
+
+        params->hit[i] = observation.hit;
+    }
+
+    params->firstTouches = predictor->first_touches;
+    params->predictions = predictor->predictions;
+    params->hits = predictor->hits;
+    params->threshold = predictor->threshold;
+
+    uvm_kvfree(predictor);
+
+    return NV_OK;
+}
@@ -100,8 +100,12 @@
 // All allocated user memory root chunks are tracked in an LRU list
 // (root_chunks.va_block_used). A root chunk is moved to the tail of that list
 // whenever any of its subchunks is allocated (unpinned) by a VA block (see
-// uvm_pmm_gpu_unpin_temp()). When a root chunk is selected for eviction, it has
-// the eviction flag set (see pick_root_chunk_to_evict()). This flag affects
+// uvm_pmm_gpu_unpin_temp()). With the CLOCK eviction policy, root chunks also
+// have a reference bit set when fault servicing or access counters touch them
+// (see uvm_pmm_gpu_mark_root_chunk_referenced()), and the eviction sweep moves
+// referenced chunks to the tail instead of evicting them. When a root chunk is
+// selected for eviction, it has the eviction flag set (see
+// pick_root_chunk_to_evict()). This flag affects
 // many of the PMM operations on all of the subchunks of the root chunk being
 // evicted. See usage of (root_)chunk_is_in_eviction(), in particular in
 // chunk_free_locked() and claim_free_chunk().
@@ -166,11 +170,13 @@
 #include "uvm_pmm_gpu.h"
 #include "uvm_mem.h"
 #include "uvm_mmu.h"
+#include "uvm_push.h"
 #include "uvm_global.h"
 #include "uvm_kvmalloc.h"
 #include "uvm_va_space.h"
 #include "uvm_va_block.h"
 #include "uvm_test.h"
+#include "uvm_test_rng.h"
 #include "uvm_linux.h"
 
 
@@ -188,6 +194,24 @@ MODULE_PARM_DESC(uvm_global_oversubscription, "Enable (1) or disable (0) global
 static unsigned uvm_perf_pma_batch_nonpinned_order = UVM_PERF_PMA_BATCH_NONPINNED_ORDER_DEFAULT;
 module_param(uvm_perf_pma_batch_nonpinned_order, uint, S_IRUGO);
 
+// Policy used to pick the root chunks to evict. See
+// uvm_pmm_gpu_eviction_policy_t.
+static unsigned uvm_perf_pmm_eviction_policy = UVM_PMM_GPU_EVICTION_POLICY_CLOCK;
+module_param(uvm_perf_pmm_eviction_policy, uint, S_IRUGO);
+
+#define UVM_PERF_PMM_ZERO_POOL_LOW_WATERMARK_DEFAULT  4
+#define UVM_PERF_PMM_ZERO_POOL_HIGH_WATERMARK_DEFAULT 16
+
+// Number of zero root chunks kept by the background zeroing of free root
+// chunks. Zeroing is kicked once fewer than the low watermark zero root chunks
+// are free, and it stops once the high watermark is reached. A high watermark
+// of 0 disables background zeroing.
+static unsigned uvm_perf_pmm_zero_pool_low_watermark = UVM_PERF_PMM_ZERO_POOL_LOW_WATERMARK_DEFAULT;
+module_param(uvm_perf_pmm_zero_pool_low_watermark, uint, S_IRUGO);
+
+static unsigned uvm_perf_pmm_zero_pool_high_watermark = UVM_PERF_PMM_ZERO_POOL_HIGH_WATERMARK_DEFAULT;
+module_param(uvm_perf_pmm_zero_pool_high_watermark, uint, S_IRUGO);
+
 // Helper type for refcounting cache
 typedef struct
 {
@@ -274,6 +298,17 @@ const char *uvm_pmm_gpu_chunk_state_string(uvm_pmm_gpu_chunk_state_t state)
     }
 }
 
+const char *uvm_pmm_gpu_eviction_policy_string(uvm_pmm_gpu_eviction_policy_t policy)
+{
+    BUILD_BUG_ON(UVM_PMM_GPU_EVICTION_POLICY_COUNT != 2);
+
+    switch (policy) {
+        UVM_ENUM_STRING_CASE(UVM_PMM_GPU_EVICTION_POLICY_ALLOC_LRU);
+        UVM_ENUM_STRING_CASE(UVM_PMM_GPU_EVICTION_POLICY_CLOCK);
+        UVM_ENUM_STRING_DEFAULT();
+    }
+}
+
 // The PMA APIs that can be called from PMA eviction callbacks (pmaPinPages and
 // pmaFreePages*) need to be called differently depending whether it's as part
 // of PMA eviction or not. The PMM context is used to plumb that information
@@ -321,6 +356,8 @@ static NV_STATUS split_gpu_chunk(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 static void free_chunk(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 static void free_chunk_with_merges(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 static bool free_next_available_root_chunk(uvm_pmm_gpu_t *pmm, uvm_pmm_gpu_memory_type_t type);
+static bool zero_pool_keep_root_chunk(uvm_pmm_gpu_t *pmm, uvm_pmm_gpu_memory_type_t type);
+static void zero_pool_chunk_claimed_locked(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 static struct list_head *find_free_list(uvm_pmm_gpu_t *pmm,
                                         uvm_pmm_gpu_memory_type_t type,
                                         uvm_chunk_size_t chunk_size,
@@ -1683,6 +1720,8 @@ static void chunk_start_eviction(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk)
 
     list_del_init(&chunk->list);
     uvm_gpu_chunk_set_in_eviction(chunk, true);
+
+    clear_bit(root_chunk_index(pmm, root_chunk), pmm->eviction.referenced);
 }
 
 static void root_chunk_update_eviction_list(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk, struct list_head *list)
@@ -1715,6 +1754,76 @@ void uvm_pmm_gpu_mark_root_chunk_unused(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chu
     root_chunk_update_eviction_list(pmm, chunk, &pmm->root_chunks.va_block_unused);
 }
 
+void uvm_pmm_gpu_mark_root_chunk_referenced(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk)
+{
+    size_t index;
+
+    UVM_ASSERT(uvm_pmm_gpu_memory_type_is_user(chunk->type));
+
+    if (pmm->eviction.policy != UVM_PMM_GPU_EVICTION_POLICY_CLOCK)
+        return;
+
+    index = root_chunk_index(pmm, root_chunk_from_chunk(pmm, chunk));
+
+    // Avoid dirtying the cache line if the bit is already set, which is the
+    // common case for hot chunks
+    if (!test_bit(index, pmm->eviction.referenced))
+        set_bit(index, pmm->eviction.referenced);
+}
+
+void uvm_pmm_gpu_record_refault(uvm_pmm_gpu_t *pmm, NvU64 evicted_at)
+{
+    NvU64 now = uvm_pmm_gpu_eviction_clock(pmm);
+
+    UVM_ASSERT(evicted_at != 0);
+    UVM_ASSERT(evicted_at <= now);
+
+    atomic64_inc(&pmm->eviction.num_refaults);
+    atomic64_add(now - evicted_at, &pmm->eviction.refault_distance_sum);
+}
+
+// Pick the first root chunk in list whose reference bit is clear, clearing
+// the bits of the chunks skipped and moving them to the tail of the list. If
+// all the chunks are referenced, the sweep stops after a full rotation and the
+// chunk that was at the head of the list is returned. Root chunks are
+// identified in referenced by their address divided by UVM_CHUNK_SIZE_MAX.
+//
+// This is also used by uvm_test_pmm_eviction_policy_replay() on a simulated
+// list, so it must not depend on the PMM state.
+static uvm_gpu_chunk_t *clock_pick_chunk(struct list_head *list, unsigned long *referenced, NvU64 *num_second_chances)
+{
+    uvm_gpu_chunk_t *first_rotated = NULL;
+    uvm_gpu_chunk_t *chunk;
+
+    while ((chunk = list_first_chunk(list)) != NULL) {
+        if (chunk == first_rotated)
+            break;
+
+        if (!test_and_clear_bit(chunk->address / UVM_CHUNK_SIZE_MAX, referenced))
+            break;
+
+        if (!first_rotated)
+            first_rotated = chunk;
+
+        list_move_tail(&chunk->list, list);
+        ++*num_second_chances;
+    }
+
+    return chunk;
+}
+
+static uvm_gpu_chunk_t *pick_used_root_chunk(uvm_pmm_gpu_t *pmm)
+{
+    uvm_assert_spinlock_locked(&pmm->list_lock);
+
+    if (pmm->eviction.policy == UVM_PMM_GPU_EVICTION_POLICY_CLOCK)
+        return clock_pick_chunk(&pmm->root_chunks.va_block_used,
+                                pmm->eviction.referenced,
+                                &pmm->eviction.num_second_chances);
+
+    return list_first_chunk(&pmm->root_chunks.va_block_used);
+}
+
 
 
 
@@ -1744,13 +1853,15 @@ static uvm_gpu_root_chunk_t *pick_root_chunk_to_evict(uvm_pmm_gpu_t *pmm)
             UVM_ASSERT(chunk->is_zero);
     }
 
-    if (!chunk)
+    if (!chunk) {
         chunk = list_first_chunk(&pmm->root_chunks.va_block_unused);
 
-    // TODO: Bug 1765193: Move the chunks to the tail of the used list whenever
-    // they get mapped.
-    if (!chunk)
-        chunk = list_first_chunk(&pmm->root_chunks.va_block_used);
+        if (!chunk)
+            chunk = pick_used_root_chunk(pmm);
+
+        if (chunk)
+            atomic64_inc(&pmm->eviction.num_evictions);
+    }
 
     if (chunk)
         chunk_start_eviction(pmm, chunk);
@@ -1896,7 +2007,9 @@ static uvm_gpu_chunk_t *claim_free_chunk(uvm_pmm_gpu_t *pmm, uvm_pmm_gpu_memory_
     // allocation functions, so we don't waste zero chunks.
     chunk = find_free_chunk_locked(pmm, type, chunk_size, UVM_PMM_LIST_ZERO);
 
-    if (!chunk)
+    if (chunk)
+        zero_pool_chunk_claimed_locked(pmm, chunk);
+    else
         chunk = find_free_chunk_locked(pmm, type, chunk_size, UVM_PMM_LIST_NO_ZERO);
 
     if (!chunk)
@@ -2685,8 +2798,10 @@ static void free_chunk(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk)
     // has been dropped, any other thread could have come in and allocated the
     // chunk in the meantime. Therefore, this next step just looks for a
     // root chunk to free, without assuming that one is actually there.
+    //
+    // Free root chunks are kept around instead if the zero pool needs them.
 
-    if (try_free)
+    if (try_free && !zero_pool_keep_root_chunk(pmm, type))
         (void)free_next_available_root_chunk(pmm, type);
 }
 
@@ -2735,6 +2850,273 @@ bool free_next_available_root_chunk(uvm_pmm_gpu_t *pmm, uvm_pmm_gpu_memory_type_
     return false;
 }
 
+// Count the free root chunks of the given type and zero type, stopping at
+// limit.
+static NvU32 count_free_root_chunks_locked(uvm_pmm_gpu_t *pmm,
+                                          uvm_pmm_gpu_memory_type_t type,
+                                          uvm_pmm_list_zero_t zero_type,
+                                          NvU32 limit)
+{
+    uvm_gpu_chunk_t *chunk;
+    NvU32 count = 0;
+
+    uvm_assert_spinlock_locked(&pmm->list_lock);
+
+    list_for_each_entry(chunk, find_free_list(pmm, type, UVM_CHUNK_SIZE_MAX, zero_type), list) {
+        if (++count == limit)
+            break;
+    }
+
+    return count;
+}
+
+NvU32 uvm_pmm_gpu_zero_pool_depth(uvm_pmm_gpu_t *pmm)
+{
+    NvU32 depth;
+
+    uvm_spin_lock(&pmm->list_lock);
+    depth = count_free_root_chunks_locked(pmm, UVM_PMM_GPU_MEMORY_TYPE_USER, UVM_PMM_LIST_ZERO, UINT_MAX);
+    uvm_spin_unlock(&pmm->list_lock);
+
+    return depth;
+}
+
+static void zero_pool_schedule_locked(uvm_pmm_gpu_t *pmm)
+{
+    uvm_assert_spinlock_locked(&pmm->list_lock);
+    UVM_ASSERT(pmm->zero_pool.enabled);
+
+    // Nothing to zero
+    if (list_empty(find_free_list(pmm, UVM_PMM_GPU_MEMORY_TYPE_USER, UVM_CHUNK_SIZE_MAX, UVM_PMM_LIST_NO_ZERO)))
+        return;
+
+    nv_kthread_q_schedule_q_item(&pmm->zero_pool.q, &pmm->zero_pool.q_item);
+}
+
+// Called by the allocator after claiming a chunk from the zero free lists
+static void zero_pool_chunk_claimed_locked(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk)
+{
+    uvm_assert_spinlock_locked(&pmm->list_lock);
+    UVM_ASSERT(chunk->is_zero);
+
+    if (!pmm->zero_pool.enabled || chunk->type != UVM_PMM_GPU_MEMORY_TYPE_USER)
+        return;
+
+    atomic64_add(uvm_gpu_chunk_get_size(chunk), &pmm->zero_pool.bytes_claimed);
+
+    // The claimed chunk is still on the zero list at this point, so the low
+    // watermark is hit once it's the last one below it.
+    if (count_free_root_chunks_locked(pmm,
+                                      UVM_PMM_GPU_MEMORY_TYPE_USER,
+                                      UVM_PMM_LIST_ZERO,
+                                      pmm->zero_pool.low_watermark + 1) <= pmm->zero_pool.low_watermark)
+        zero_pool_schedule_locked(pmm);
+}
+
+// Returns true if the free root chunks of the given type should be kept in PMM
+// for background zeroing instead of being released to PMA. Free root chunks,
+// whether already zeroed or still waiting to be, are capped at the high
+// watermark.
+static bool zero_pool_keep_root_chunk(uvm_pmm_gpu_t *pmm, uvm_pmm_gpu_memory_type_t type)
+{
+    bool keep = false;
+
+    if (type != UVM_PMM_GPU_MEMORY_TYPE_USER)
+        return false;
+
+    uvm_spin_lock(&pmm->list_lock);
+
+    if (pmm->zero_pool.enabled) {
+        NvU32 high = pmm->zero_pool.high_watermark;
+        NvU32 count = count_free_root_chunks_locked(pmm, type, UVM_PMM_LIST_ZERO, high + 1);
+
+        if (count <= high)
+            count += count_free_root_chunks_locked(pmm, type, UVM_PMM_LIST_NO_ZERO, high - count + 1);
+
+        // The root chunk that was just freed is included in the count
+        if (count <= high) {
+            zero_pool_schedule_locked(pmm);
+            keep = true;
+        }
+    }
+
+    uvm_spin_unlock(&pmm->list_lock);
+
+    return keep;
+}
+
+// Take a non-zero free root chunk to be zeroed if the pool is below the high
+// watermark. The chunk is returned pinned.
+static uvm_gpu_chunk_t *zero_pool_claim_root_chunk(uvm_pmm_gpu_t *pmm)
+{
+    const uvm_pmm_gpu_memory_type_t type = UVM_PMM_GPU_MEMORY_TYPE_USER;
+    uvm_gpu_chunk_t *chunk = NULL;
+
+    uvm_spin_lock(&pmm->list_lock);
+
+    if (pmm->zero_pool.enabled &&
+        count_free_root_chunks_locked(pmm,
+                                      type,
+                                      UVM_PMM_LIST_ZERO,
+                                      pmm->zero_pool.high_watermark) < pmm->zero_pool.high_watermark) {
+        chunk = find_free_chunk_locked(pmm, type, UVM_CHUNK_SIZE_MAX, UVM_PMM_LIST_NO_ZERO);
+        if (chunk) {
+            UVM_ASSERT(chunk->state == UVM_PMM_GPU_CHUNK_STATE_FREE);
+            UVM_ASSERT(!chunk_is_in_eviction(pmm, chunk));
+
+            chunk_pin(pmm, chunk);
+            chunk_update_lists_locked(pmm, chunk);
+        }
+    }
+
+    uvm_spin_unlock(&pmm->list_lock);
+
+    return chunk;
+}
+
+static NV_STATUS zero_root_chunk(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk)
+{
+    uvm_gpu_t *gpu = uvm_pmm_to_gpu(pmm);
+    uvm_gpu_root_chunk_t *root_chunk = root_chunk_from_chunk(pmm, chunk);
+    uvm_tracker_t tracker = UVM_TRACKER_INIT();
+    uvm_gpu_address_t address;
+    uvm_push_t push;
+    NV_STATUS status;
+
+    root_chunk_lock(pmm, root_chunk);
+    uvm_tracker_remove_completed(&root_chunk->tracker);
+    status = uvm_tracker_add_tracker_safe(&tracker, &root_chunk->tracker);
+    root_chunk_unlock(pmm, root_chunk);
+    if (status != NV_OK)
+        goto out;
+
+    status = uvm_mmu_chunk_map(chunk);
+    if (status != NV_OK)
+        goto out;
+
+    if (uvm_mmu_gpu_needs_static_vidmem_mapping(gpu) || uvm_mmu_gpu_needs_dynamic_vidmem_mapping(gpu))
+        address = uvm_gpu_address_virtual_from_vidmem_phys(gpu, chunk->address);
+    else
+        address = uvm_gpu_address_physical(UVM_APERTURE_VID, chunk->address);
+
+    status = uvm_push_begin_acquire(gpu->channel_manager,
+                                    UVM_CHANNEL_TYPE_GPU_INTERNAL,
+                                    &tracker,
+                                    &push,
+                                    "Zero out free root chunk [0x%llx, 0x%llx)",
+                                    chunk->address,
+                                    chunk->address + UVM_CHUNK_SIZE_MAX);
+    if (status != NV_OK) {
+        uvm_mmu_chunk_unmap(chunk, NULL);
+        goto out;
+    }
+
+    gpu->parent->ce_hal->memset_8(&push, address, 0, UVM_CHUNK_SIZE_MAX);
+
+    uvm_push_end(&push);
+
+    uvm_tracker_overwrite_with_push(&tracker, &push);
+
+    uvm_mmu_chunk_unmap(chunk, &tracker);
+
+    // The next user of the chunk picks up the memset through the root chunk
+    // tracker, see uvm_pmm_gpu_alloc().
+    root_chunk_lock(pmm, root_chunk);
+    status = uvm_tracker_add_tracker_safe(&root_chunk->tracker, &tracker);
+    root_chunk_unlock(pmm, root_chunk);
+
+    if (status != NV_OK)
+        status = uvm_tracker_wait(&tracker);
+
+out:
+    uvm_tracker_deinit(&tracker);
+
+    return status;
+}
+
+static void zero_pool_fill(uvm_pmm_gpu_t *pmm)
+{
+    uvm_gpu_chunk_t *chunk;
+
+    while ((chunk = zero_pool_claim_root_chunk(pmm)) != NULL) {
+        NV_STATUS status = zero_root_chunk(pmm, chunk);
+
+        uvm_spin_lock(&pmm->list_lock);
+
+        chunk_unpin(pmm, chunk, UVM_PMM_GPU_CHUNK_STATE_FREE);
+        chunk->is_zero = (status == NV_OK);
+        chunk_update_lists_locked(pmm, chunk);
+
+        uvm_spin_unlock(&pmm->list_lock);
+
+        if (status != NV_OK)
+            break;
+
+        atomic64_inc(&pmm->zero_pool.num_zeroed);
+
+        // Zero one root chunk at a time to limit the interference with other
+        // work on the GPU
+        cond_resched();
+    }
+}
+
+static void zero_pool_fill_entry(void *args)
+{
+    UVM_ENTRY_VOID(zero_pool_fill(args));
+}
+
+NV_STATUS uvm_pmm_gpu_zero_pool_start(uvm_pmm_gpu_t *pmm)
+{
+    uvm_gpu_t *gpu = uvm_pmm_to_gpu(pmm);
+    char q_name[32];
+    int ret;
+
+    UVM_ASSERT(!pmm->zero_pool.enabled);
+
+    atomic64_set(&pmm->zero_pool.num_zeroed, 0);
+    atomic64_set(&pmm->zero_pool.bytes_claimed, 0);
+
+    if (!pmm->initialized || gpu->mem_info.size == 0 || uvm_perf_pmm_zero_pool_high_watermark == 0)
+        return NV_OK;
+
+    pmm->zero_pool.high_watermark = uvm_perf_pmm_zero_pool_high_watermark;
+    pmm->zero_pool.low_watermark = uvm_perf_pmm_zero_pool_low_watermark;
+    if (pmm->zero_pool.low_watermark > pmm->zero_pool.high_watermark) {
+        pr_info("Invalid zero pool low watermark value on GPU %s: %u. Using %u instead\n",
+                uvm_gpu_name(gpu),
+                pmm->zero_pool.low_watermark,
+                pmm->zero_pool.high_watermark);
+        pmm->zero_pool.low_watermark = pmm->zero_pool.high_watermark;
+    }
+
+    snprintf(q_name, sizeof(q_name), "UVM GPU%u ZERO", uvm_id_value(gpu->id));
+    ret = nv_kthread_q_init_on_node(&pmm->zero_pool.q, q_name, gpu->parent->closest_cpu_numa_node);
+    if (ret != 0)
+        return errno_to_nv_status(ret);
+
+    nv_kthread_q_item_init(&pmm->zero_pool.q_item, zero_pool_fill_entry, pmm);
+
+    uvm_spin_lock(&pmm->list_lock);
+    pmm->zero_pool.enabled = true;
+    uvm_spin_unlock(&pmm->list_lock);
+
+    return NV_OK;
+}
+
+void uvm_pmm_gpu_zero_pool_stop(uvm_pmm_gpu_t *pmm)
+{
+    if (!pmm->zero_pool.enabled)
+        return;
+
+    // Once disabled, no new work is scheduled and the queue stops claiming
+    // chunks. The kept free root chunks are released at PMM deinit.
+    uvm_spin_lock(&pmm->list_lock);
+    pmm->zero_pool.enabled = false;
+    uvm_spin_unlock(&pmm->list_lock);
+
+    nv_kthread_q_stop(&pmm->zero_pool.q);
+}
+
 // Get free list for the given chunk size and type
 struct list_head *find_free_list(uvm_pmm_gpu_t *pmm,
                                  uvm_pmm_gpu_memory_type_t type,
@@ -3399,6 +3781,23 @@ NV_STATUS uvm_pmm_gpu_init(uvm_pmm_gpu_t *pmm)
     if (status != NV_OK)
         goto cleanup;
 
+    pmm->eviction.referenced = uvm_kvmalloc_zero(BITS_TO_LONGS(pmm->root_chunks.count) * sizeof(unsigned long));
+    if (!pmm->eviction.referenced) {
+        status = NV_ERR_NO_MEMORY;
+        goto cleanup;
+    }
+
+    pmm->eviction.policy = uvm_perf_pmm_eviction_policy < UVM_PMM_GPU_EVICTION_POLICY_COUNT?
+                               uvm_perf_pmm_eviction_policy:
+                               UVM_PMM_GPU_EVICTION_POLICY_CLOCK;
+
+    if (pmm->eviction.policy != uvm_perf_pmm_eviction_policy) {
+        pr_info("Invalid uvm_perf_pmm_eviction_policy value on GPU %s: %u. Using %u instead\n",
+                uvm_gpu_name(gpu),
+                uvm_perf_pmm_eviction_policy,
+                pmm->eviction.policy);
+    }
+
     if (gpu->mem_info.size != 0) {
         status = uvm_rm_locked_call(nvUvmInterfaceGetPmaObject(uvm_gpu_device_handle(gpu), &pmm->pma, &pmm->pma_stats));
 
@@ -3483,6 +3882,8 @@ void uvm_pmm_gpu_deinit(uvm_pmm_gpu_t *pmm)
         }
     }
     uvm_kvfree(pmm->root_chunks.array);
+    uvm_kvfree(pmm->eviction.referenced);
+    pmm->eviction.referenced = NULL;
 
     deinit_caches(pmm);
 
@@ -3834,3 +4235,125 @@ NV_STATUS uvm_test_pmm_query_pma_stats(UVM_TEST_PMM_QUERY_PMA_STATS_PARAMS *para
     uvm_gpu_release(gpu);
     return NV_OK;
 }
+
+NV_STATUS uvm_test_pmm_eviction_policy_replay(UVM_TEST_PMM_EVICTION_POLICY_REPLAY_PARAMS *params,
+                                              struct file *filp)
+{
+    uvm_gpu_chunk_t *chunks = NULL;
+    unsigned long *resident = NULL;
+    unsigned long *referenced = NULL;
+    NvU64 *evicted_at = NULL;
+    size_t bitmap_size;
+    LIST_HEAD(used);
+    uvm_test_rng_t rng;
+    NvU32 num_resident = 0;
+    NvU32 scan_index = 0;
+    NV_STATUS status = NV_OK;
+    NvU64 i;
+
+    if (params->policy >= UVM_PMM_GPU_EVICTION_POLICY_COUNT ||
+        params->chunkCount == 0 ||
+        params->chunkCount > UVM_TEST_PMM_EVICTION_POLICY_REPLAY_MAX_CHUNKS ||
+        params->capacity == 0 ||
+        params->capacity > params->chunkCount ||
+        params->hotCount > params->chunkCount ||
+        params->hotPercent > 100)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    bitmap_size = BITS_TO_LONGS(params->chunkCount) * sizeof(unsigned long);
+
+    chunks = uvm_kvmalloc_zero(params->chunkCount * sizeof(*chunks));
+    evicted_at = uvm_kvmalloc_zero(params->chunkCount * sizeof(*evicted_at));
+    resident = uvm_kvmalloc_zero(bitmap_size);
+    referenced = uvm_kvmalloc_zero(bitmap_size);
+    if (!chunks || !evicted_at || !resident || !referenced) {
+        status = NV_ERR_NO_MEMORY;
+        goto done;
+    }
+
+    // Only the address and the list node of the simulated chunks are used
+    for (i = 0; i < params->chunkCount; ++i) {
+        INIT_LIST_HEAD(&chunks[i].list);
+        chunks[i].address = i * UVM_CHUNK_SIZE_MAX;
+    }
+
+    uvm_test_rng_init(&rng, params->seed);
+
+    params->hits = 0;
+    params->misses = 0;
+    params->evictions = 0;
+    params->secondChances = 0;
+    params->refaults = 0;
+    params->refaultDistanceSum = 0;
+
+    for (i = 0; i < params->traceLength; ++i) {
+        NvU32 index;
+
+        if (params->hotCount == params->chunkCount ||
+            (params->hotCount > 0 && uvm_test_rng_range_32(&rng, 1, 100) <= params->hotPercent)) {
+            index = uvm_test_rng_range_32(&rng, 0, params->hotCount - 1);
+        }
+        else {
+            index = params->hotCount + scan_index;
+            scan_index = (scan_index + 1) % (params->chunkCount - params->hotCount);
+        }
+
+        if (test_bit(index, resident)) {
+            ++params->hits;
+
+            if (params->policy == UVM_PMM_GPU_EVICTION_POLICY_CLOCK)
+                set_bit(index, referenced);
+
+            continue;
+        }
+
+        ++params->misses;
+
+        if (num_resident == params->capacity) {
+            uvm_gpu_chunk_t *victim;
+            size_t victim_index;
+
+            if (params->policy == UVM_PMM_GPU_EVICTION_POLICY_CLOCK)
+                victim = clock_pick_chunk(&used, referenced, &params->secondChances);
+            else
+                victim = list_first_chunk(&used);
+
+            UVM_ASSERT(victim);
+
+            victim_index = victim - chunks;
+            list_del_init(&victim->list);
+            clear_bit(victim_index, resident);
+            clear_bit(victim_index, referenced);
+            --num_resident;
+
+            evicted_at[victim_index] = ++params->evictions;
+        }
+
+        if (evicted_at[index] != 0) {
+            ++params->refaults;
+            params->refaultDistanceSum += params->evictions - evicted_at[index];
+            evicted_at[index] = 0;
+        }
+
+        list_add_tail(&chunks[index].list, &used);
+        set_bit(index, resident);
+        ++num_resident;
+
+        if (i % 4096 == 0) {
+            if (fatal_signal_pending(current)) {
+                status = NV_ERR_SIGNAL_PENDING;
+                goto done;
+            }
+
+            cond_resched();
+        }
+    }
+
+done:
+    uvm_kvfree(referenced);
+    uvm_kvfree(resident);
+    uvm_kvfree(evicted_at);
+    uvm_kvfree(chunks);
+
+    return status;
+}
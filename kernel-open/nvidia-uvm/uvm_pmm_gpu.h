@@ -158,6 +158,25 @@ typedef enum
 
 const char *uvm_pmm_gpu_chunk_state_string(uvm_pmm_gpu_chunk_state_t state);
 
+// Policy used to pick the user root chunk to evict among the ones backing VA
+// blocks. Unused root chunks are always evicted first.
+typedef enum
+{
+    // Evict the root chunk whose subchunks were least recently allocated.
+    // Accesses to already populated memory are not taken into account.
+    UVM_PMM_GPU_EVICTION_POLICY_ALLOC_LRU,
+
+    // CLOCK (second chance) over the allocation order. Root chunks touched by
+    // fault servicing or reported by access counters since the last sweep are
+    // moved to the tail of the list instead of being evicted.
+    UVM_PMM_GPU_EVICTION_POLICY_CLOCK,
+
+    // Number of policies - MUST BE LAST
+    UVM_PMM_GPU_EVICTION_POLICY_COUNT
+} uvm_pmm_gpu_eviction_policy_t;
+
+const char *uvm_pmm_gpu_eviction_policy_string(uvm_pmm_gpu_eviction_policy_t policy);
+
 typedef enum
 {
     // No flags passed
@@ -364,6 +383,54 @@ typedef struct
         uvm_gpu_root_chunk_indirect_peer_t indirect_peer[UVM_ID_MAX_GPUS];
     } root_chunks;
 
+    struct
+    {
+        uvm_pmm_gpu_eviction_policy_t policy;
+
+        // Reference bits for the CLOCK policy with 1 bit per each root chunk.
+        // Set locklessly by uvm_pmm_gpu_mark_root_chunk_referenced() and
+        // cleared by the eviction sweep under the list lock.
+        unsigned long *referenced;
+
+        // Number of root chunks picked for eviction from the VA block lists.
+        // Also used as the clock for refault distances.
+        atomic64_t num_evictions;
+
+        // Number of referenced root chunks skipped by the CLOCK sweep.
+        // Protected by the list lock.
+        NvU64 num_second_chances;
+
+        // Number of VA blocks that repopulated this GPU after having their
+        // chunks evicted, and the sum of the number of evictions between each
+        // eviction and its refault. See uvm_pmm_gpu_record_refault().
+        atomic64_t num_refaults;
+        atomic64_t refault_distance_sum;
+    } eviction;
+
+    // Background zeroing of free USER root chunks. Freed root chunks are kept
+    // in PMM instead of being returned to PMA, and are zeroed by the queue
+    // until high_watermark zero root chunks are available. Allocations
+    // consuming zero chunks kick the queue once fewer than low_watermark zero
+    // root chunks are left.
+    struct
+    {
+        nv_kthread_q_t q;
+        nv_kthread_q_item_t q_item;
+
+        // Whether the pool is running. Protected by the list lock.
+        bool enabled;
+
+        NvU32 low_watermark;
+        NvU32 high_watermark;
+
+        // Number of root chunks zeroed by the queue
+        atomic64_t num_zeroed;
+
+        // Number of bytes of zero USER chunks handed out by the allocator, i.e.
+        // zeroing avoided on the allocation path
+        atomic64_t bytes_claimed;
+    } zero_pool;
+
     // Lock protecting PMA allocation, freeing and eviction
     uvm_rw_semaphore_t pma_lock;
 
@@ -397,6 +464,16 @@ NV_STATUS uvm_pmm_gpu_init(uvm_pmm_gpu_t *pmm);
 // Deinitialize the PMM on GPU
 void uvm_pmm_gpu_deinit(uvm_pmm_gpu_t *pmm);
 
+// Start and stop the background zeroing of free root chunks. Starting requires
+// the GPU's channels and flat mappings to be initialized, and the pool has to
+// be stopped before they are torn down. Stopping a pool that was never started
+// is a no-op.
+NV_STATUS uvm_pmm_gpu_zero_pool_start(uvm_pmm_gpu_t *pmm);
+void uvm_pmm_gpu_zero_pool_stop(uvm_pmm_gpu_t *pmm);
+
+// Number of zero USER root chunks currently on the free lists
+NvU32 uvm_pmm_gpu_zero_pool_depth(uvm_pmm_gpu_t *pmm);
+
 static uvm_chunk_size_t uvm_gpu_chunk_get_size(uvm_gpu_chunk_t *chunk)
 {
     return ((uvm_chunk_size_t)1) << chunk->log2_size;
@@ -603,6 +680,22 @@ void uvm_pmm_gpu_mark_root_chunk_used(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk
 // Mark an allocated user chunk as unused
 void uvm_pmm_gpu_mark_root_chunk_unused(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
 
+// Mark the root chunk of an allocated user chunk as recently accessed, so that
+// the CLOCK eviction policy gives it a second chance. This doesn't take any
+// locks and can be called with the VA block lock held.
+void uvm_pmm_gpu_mark_root_chunk_referenced(uvm_pmm_gpu_t *pmm, uvm_gpu_chunk_t *chunk);
+
+// Return the current value of the eviction clock, to be passed to
+// uvm_pmm_gpu_record_refault() once the evicted memory is repopulated.
+static NvU64 uvm_pmm_gpu_eviction_clock(uvm_pmm_gpu_t *pmm)
+{
+    return atomic64_read(&pmm->eviction.num_evictions);
+}
+
+// Record that memory evicted when the eviction clock was at evicted_at has been
+// repopulated on the GPU
+void uvm_pmm_gpu_record_refault(uvm_pmm_gpu_t *pmm, NvU64 evicted_at);
+
 static bool uvm_gpu_chunk_same_root(uvm_gpu_chunk_t *chunk1, uvm_gpu_chunk_t *chunk2)
 {
     return UVM_ALIGN_DOWN(chunk1->address, UVM_CHUNK_SIZE_MAX) == UVM_ALIGN_DOWN(chunk2->address, UVM_CHUNK_SIZE_MAX);
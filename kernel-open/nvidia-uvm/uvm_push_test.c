@@ -38,6 +38,9 @@
 
 #define TEST_PUSH_INTERLEAVING_NUM_PAUSED_PUSHES 2
 
+#define TEST_CONCURRENT_PUSH_THREADS 8
+#define TEST_CONCURRENT_PUSHES_PER_THREAD 1024
+
 static NvU32 get_push_end_size(uvm_channel_t *channel)
 {
     if (uvm_channel_is_ce(channel))
@@ -634,6 +637,128 @@ done:
     return status;
 }
 
+typedef struct
+{
+    uvm_gpu_t *gpu;
+    uvm_channel_type_t channel_type;
+    nv_kthread_q_t q;
+    nv_kthread_q_item_t q_item;
+    NV_STATUS status;
+} concurrent_push_thread_t;
+
+static void concurrent_push_thread_func(concurrent_push_thread_t *thread)
+{
+    uvm_gpu_t *gpu = thread->gpu;
+    uvm_tracker_t tracker = UVM_TRACKER_INIT();
+    NV_STATUS status = NV_OK;
+    NvU32 i;
+
+    for (i = 0; i < TEST_CONCURRENT_PUSHES_PER_THREAD; ++i) {
+        uvm_push_t push;
+
+        status = uvm_push_begin(gpu->channel_manager, thread->channel_type, &push, "Concurrent push %u", i);
+        if (status != NV_OK)
+            break;
+
+        gpu->parent->host_hal->noop(&push, UVM_METHOD_SIZE);
+        uvm_push_end(&push);
+
+        uvm_tracker_remove_completed(&tracker);
+        status = uvm_tracker_add_push_safe(&tracker, &push);
+        if (status != NV_OK)
+            break;
+    }
+
+    if (status == NV_OK)
+        status = uvm_tracker_wait_deinit(&tracker);
+    else
+        uvm_tracker_deinit(&tracker);
+
+    thread->status = status;
+}
+
+static void concurrent_push_thread_entry(void *args)
+{
+    UVM_ENTRY_VOID(concurrent_push_thread_func(args));
+}
+
+// Push from several threads at the same time, cycling through the channel
+// types so that pushes from multiple channel pools race for the pushbuffer
+// chunks. The pushbuffer has to be completely idle again afterwards.
+static NV_STATUS test_concurrent_push_throughput_on_gpu(uvm_gpu_t *gpu, NvU64 *num_pushes, NvU64 *time_ns)
+{
+    NV_STATUS status = NV_OK;
+    uvm_pushbuffer_t *pushbuffer = gpu->channel_manager->pushbuffer;
+    concurrent_push_thread_t *threads;
+    NvU64 claims_before;
+    NvU64 start_time;
+    NvU32 i;
+
+    threads = uvm_kvmalloc_zero(sizeof(*threads) * TEST_CONCURRENT_PUSH_THREADS);
+    if (!threads)
+        return NV_ERR_NO_MEMORY;
+
+    claims_before = atomic64_read(&pushbuffer->stats.claims);
+    start_time = NV_GETTIME();
+
+    for (i = 0; i < TEST_CONCURRENT_PUSH_THREADS; ++i) {
+        concurrent_push_thread_t *thread = &threads[i];
+
+        thread->gpu = gpu;
+        thread->channel_type = i % (UVM_CHANNEL_TYPE_MEMOPS + 1);
+
+        if (nv_kthread_q_init(&thread->q, "uvm_push_test") != 0) {
+            status = NV_ERR_NO_MEMORY;
+            break;
+        }
+
+        nv_kthread_q_item_init(&thread->q_item, concurrent_push_thread_entry, thread);
+        nv_kthread_q_schedule_q_item(&thread->q, &thread->q_item);
+    }
+
+    // Stopping the queues waits for the scheduled pushes to finish
+    for (i = 0; i < TEST_CONCURRENT_PUSH_THREADS; ++i)
+        nv_kthread_q_stop(&threads[i].q);
+
+    *time_ns += NV_GETTIME() - start_time;
+
+    TEST_NV_CHECK_GOTO(status, done);
+
+    for (i = 0; i < TEST_CONCURRENT_PUSH_THREADS; ++i)
+        TEST_NV_CHECK_GOTO(threads[i].status, done);
+
+    *num_pushes += TEST_CONCURRENT_PUSH_THREADS * TEST_CONCURRENT_PUSHES_PER_THREAD;
+
+    TEST_CHECK_GOTO(atomic64_read(&pushbuffer->stats.claims) - claims_before >=
+                    TEST_CONCURRENT_PUSH_THREADS * TEST_CONCURRENT_PUSHES_PER_THREAD, done);
+
+    TEST_NV_CHECK_GOTO(uvm_channel_manager_wait(gpu->channel_manager), done);
+
+    if (test_count_idle_chunks(pushbuffer) != UVM_PUSHBUFFER_CHUNKS) {
+        UVM_TEST_PRINT("Unexpected count of idle chunks in the pushbuffer %u\n", test_count_idle_chunks(pushbuffer));
+        uvm_pushbuffer_print(pushbuffer);
+        status = NV_ERR_INVALID_STATE;
+    }
+
+done:
+    uvm_kvfree(threads);
+
+    return status;
+}
+
+static NV_STATUS test_concurrent_push_throughput(uvm_va_space_t *va_space, NvU64 *num_pushes, NvU64 *time_ns)
+{
+    uvm_gpu_t *gpu;
+
+    *num_pushes = 0;
+    *time_ns = 0;
+
+    for_each_va_space_gpu(gpu, va_space)
+        TEST_NV_CHECK_RET(test_concurrent_push_throughput_on_gpu(gpu, num_pushes, time_ns));
+
+    return NV_OK;
+}
+
 static NV_STATUS test_pushbuffer(uvm_va_space_t *va_space)
 {
     uvm_gpu_t *gpu;
@@ -891,6 +1016,10 @@ NV_STATUS uvm_test_push_sanity(UVM_TEST_PUSH_SANITY_PARAMS *params, struct file
     if (status != NV_OK)
         goto done;
 
+    status = test_concurrent_push_throughput(va_space, &params->concurrentPushes, &params->concurrentPushTimeNs);
+    if (status != NV_OK)
+        goto done;
+
     if (!params->skipTimestampTest) {
         status = test_timestamp(va_space);
         if (status != NV_OK)
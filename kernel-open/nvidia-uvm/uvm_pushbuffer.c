@@ -87,8 +87,6 @@ NV_STATUS uvm_pushbuffer_create(uvm_channel_manager_t *channel_manager, uvm_push
 
     pushbuffer->channel_manager = channel_manager;
 
-    uvm_spin_lock_init(&pushbuffer->lock, UVM_LOCK_ORDER_LEAF);
-
     // Currently the pushbuffer supports UVM_PUSHBUFFER_CHUNKS of concurrent
     // pushes.
     uvm_sema_init(&pushbuffer->concurrent_pushes_sema, UVM_PUSHBUFFER_CHUNKS, UVM_LOCK_ORDER_PUSH);
@@ -108,8 +106,10 @@ NV_STATUS uvm_pushbuffer_create(uvm_channel_manager_t *channel_manager, uvm_push
     bitmap_fill(pushbuffer->idle_chunks, UVM_PUSHBUFFER_CHUNKS);
     bitmap_fill(pushbuffer->available_chunks, UVM_PUSHBUFFER_CHUNKS);
 
-    for (i = 0; i < UVM_PUSHBUFFER_CHUNKS; ++i)
+    for (i = 0; i < UVM_PUSHBUFFER_CHUNKS; ++i) {
         INIT_LIST_HEAD(&pushbuffer->chunks[i].pending_gpfifos);
+        uvm_spin_lock_init(&pushbuffer->chunks[i].lock, UVM_LOCK_ORDER_LEAF);
+    }
 
     status = create_procfs(pushbuffer);
     if (status != NV_OK)
@@ -124,28 +124,6 @@ error:
     return status;
 }
 
-static uvm_pushbuffer_chunk_t *get_chunk_in_mask(uvm_pushbuffer_t *pushbuffer, unsigned long *mask)
-{
-    NvU32 index = find_first_bit(mask, UVM_PUSHBUFFER_CHUNKS);
-
-    uvm_assert_spinlock_locked(&pushbuffer->lock);
-
-    if (index == UVM_PUSHBUFFER_CHUNKS)
-        return NULL;
-
-    return &pushbuffer->chunks[index];
-}
-
-static uvm_pushbuffer_chunk_t *get_available_chunk(uvm_pushbuffer_t *pushbuffer)
-{
-    return get_chunk_in_mask(pushbuffer, pushbuffer->available_chunks);
-}
-
-static uvm_pushbuffer_chunk_t *get_idle_chunk(uvm_pushbuffer_t *pushbuffer)
-{
-    return get_chunk_in_mask(pushbuffer, pushbuffer->idle_chunks);
-}
-
 static NvU32 chunk_get_index(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chunk_t *chunk)
 {
     NvU32 index = chunk - pushbuffer->chunks;
@@ -162,51 +140,84 @@ static void set_chunk(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chunk_t *chun
 {
     NvU32 index = chunk_get_index(pushbuffer, chunk);
 
-    uvm_assert_spinlock_locked(&pushbuffer->lock);
+    uvm_assert_spinlock_locked(&chunk->lock);
 
-    __set_bit(index, mask);
+    // Make the chunk state, notably next_push_start, visible before the chunk
+    // can be claimed by another CPU.
+    smp_mb__before_atomic();
+    set_bit(index, mask);
 }
 
-static void clear_chunk(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chunk_t *chunk, unsigned long *mask)
+// Index of the first chunk to look at for a push on the given channel. Channel
+// pools are spread evenly across the pushbuffer.
+static NvU32 chunk_affinity_index(uvm_pushbuffer_t *pushbuffer, uvm_channel_t *channel)
 {
-    NvU32 index = chunk_get_index(pushbuffer, chunk);
+    uvm_channel_manager_t *channel_manager = pushbuffer->channel_manager;
+    NvU32 pool_index = channel->pool - channel_manager->channel_pools;
 
-    uvm_assert_spinlock_locked(&pushbuffer->lock);
+    UVM_ASSERT(pool_index < channel_manager->num_channel_pools);
 
-    __clear_bit(index, mask);
+    return (pool_index * UVM_PUSHBUFFER_CHUNKS) / channel_manager->num_channel_pools;
 }
 
-static uvm_pushbuffer_chunk_t *pick_chunk(uvm_pushbuffer_t *pushbuffer)
+// Try to claim the chunk at the given index for the push. Clearing the chunk's
+// bit in available_chunks reserves it, and the chunk lock is only taken to
+// publish the push.
+static bool try_claim_chunk_index(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, NvU32 index)
 {
-    uvm_pushbuffer_chunk_t *chunk = get_idle_chunk(pushbuffer);
+    uvm_pushbuffer_chunk_t *chunk = &pushbuffer->chunks[index];
+    bool claimed;
+
+    if (!test_and_clear_bit(index, pushbuffer->available_chunks))
+        return false;
+
+    uvm_spin_lock(&chunk->lock);
+
+    // A completed push can make the chunk available again between clearing
+    // the bit above and taking the lock, so a concurrent push could have
+    // claimed the chunk in the meantime. The first one to take the lock wins.
+    claimed = chunk->current_push == NULL;
+    if (claimed) {
+        chunk->current_push = push;
+        clear_bit(index, pushbuffer->available_chunks);
+        clear_bit(index, pushbuffer->idle_chunks);
+    }
 
-    uvm_assert_spinlock_locked(&pushbuffer->lock);
+    uvm_spin_unlock(&chunk->lock);
 
-    if (chunk == NULL)
-        chunk = get_available_chunk(pushbuffer);
+    if (!claimed)
+        atomic64_inc(&pushbuffer->stats.claim_races);
 
-    return chunk;
+    return claimed;
 }
 
 static bool try_claim_chunk(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm_pushbuffer_chunk_t **chunk_out)
 {
-    uvm_pushbuffer_chunk_t *chunk;
+    NvU32 first_index = chunk_affinity_index(pushbuffer, push->channel);
+    NvU32 i;
 
-    uvm_spin_lock(&pushbuffer->lock);
+    // Idle chunks are always used first
+    for (i = 0; i < UVM_PUSHBUFFER_CHUNKS; ++i) {
+        NvU32 index = (first_index + i) % UVM_PUSHBUFFER_CHUNKS;
 
-    chunk = pick_chunk(pushbuffer);
-    if (!chunk)
-        goto done;
+        if (test_bit(index, pushbuffer->idle_chunks) && try_claim_chunk_index(pushbuffer, push, index)) {
+            *chunk_out = &pushbuffer->chunks[index];
+            return true;
+        }
+    }
 
-    chunk->current_push = push;
-    clear_chunk(pushbuffer, chunk, pushbuffer->idle_chunks);
-    clear_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
+    for (i = 0; i < UVM_PUSHBUFFER_CHUNKS; ++i) {
+        NvU32 index = (first_index + i) % UVM_PUSHBUFFER_CHUNKS;
 
-done:
-    uvm_spin_unlock(&pushbuffer->lock);
-    *chunk_out = chunk;
+        if (test_bit(index, pushbuffer->available_chunks) && try_claim_chunk_index(pushbuffer, push, index)) {
+            *chunk_out = &pushbuffer->chunks[index];
+            return true;
+        }
+    }
+
+    *chunk_out = NULL;
 
-    return chunk != NULL;
+    return false;
 }
 
 static NvU32 *chunk_get_next_push_start_addr(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chunk_t *chunk)
@@ -225,10 +236,15 @@ static NV_STATUS claim_chunk(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm
     NV_STATUS status = NV_OK;
     uvm_channel_manager_t *channel_manager = pushbuffer->channel_manager;
     uvm_spin_loop_t spin;
+    NvU64 wait_start;
+
+    atomic64_inc(&pushbuffer->stats.claims);
 
     if (try_claim_chunk(pushbuffer, push, chunk_out))
         return NV_OK;
 
+    wait_start = NV_GETTIME();
+
     uvm_channel_manager_update_progress(channel_manager);
 
     uvm_spin_loop_init(&spin);
@@ -238,6 +254,9 @@ static NV_STATUS claim_chunk(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm
         uvm_channel_manager_update_progress(channel_manager);
     }
 
+    atomic64_inc(&pushbuffer->stats.waits);
+    atomic64_add(NV_GETTIME() - wait_start, &pushbuffer->stats.wait_time_ns);
+
     return status;
 }
 
@@ -248,6 +267,7 @@ NV_STATUS uvm_pushbuffer_begin_push(uvm_pushbuffer_t *pushbuffer, uvm_push_t *pu
 
     UVM_ASSERT(pushbuffer);
     UVM_ASSERT(push);
+    UVM_ASSERT(push->channel);
 
     // Note that this semaphore is uvm_up()ed in end_push().
     uvm_down(&pushbuffer->concurrent_pushes_sema);
@@ -281,7 +301,7 @@ static NvU32 chunk_get_cpu_put(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chun
 {
     uvm_gpfifo_entry_t *gpfifo = chunk_get_last_gpfifo(chunk);
 
-    uvm_assert_spinlock_locked(&pushbuffer->lock);
+    uvm_assert_spinlock_locked(&chunk->lock);
 
     if (gpfifo != NULL)
         return gpfifo->pushbuffer_offset + gpfifo->pushbuffer_size - chunk_get_offset(pushbuffer, chunk);
@@ -294,7 +314,7 @@ static NvU32 chunk_get_gpu_get(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chun
 {
     uvm_gpfifo_entry_t *gpfifo = chunk_get_first_gpfifo(chunk);
 
-    uvm_assert_spinlock_locked(&pushbuffer->lock);
+    uvm_assert_spinlock_locked(&chunk->lock);
 
     if (gpfifo != NULL)
         return gpfifo->pushbuffer_offset - chunk_get_offset(pushbuffer, chunk);
@@ -307,7 +327,7 @@ static void update_chunk(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chunk_t *c
     NvU32 gpu_get = chunk_get_gpu_get(pushbuffer, chunk);
     NvU32 cpu_put = chunk_get_cpu_put(pushbuffer, chunk);
 
-    uvm_assert_spinlock_locked(&pushbuffer->lock);
+    uvm_assert_spinlock_locked(&chunk->lock);
 
     if (gpu_get == cpu_put) {
         // cpu_put can be equal to gpu_get both when the chunk is full and empty. We
@@ -317,35 +337,35 @@ static void update_chunk(uvm_pushbuffer_t *pushbuffer, uvm_pushbuffer_chunk_t *c
             return;
 
         // Chunk completely idle
-        set_chunk(pushbuffer, chunk, pushbuffer->idle_chunks);
-        set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
         UVM_ASSERT_MSG(cpu_put == 0, "cpu put %u\n", cpu_put);
 
         // For a completely idle chunk, always start at the very beginning. This
         // helps avoid the waste that can happen at the very end of the chunk
         // described at the top of uvm_pushbuffer.h.
         chunk->next_push_start = 0;
+        set_chunk(pushbuffer, chunk, pushbuffer->idle_chunks);
+        set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
     }
     else if (gpu_get > cpu_put) {
         if (gpu_get - cpu_put >= UVM_MAX_PUSH_SIZE) {
             // Enough space between put and get
-            set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
             chunk->next_push_start = cpu_put;
+            set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
         }
     }
     else if (UVM_PUSHBUFFER_CHUNK_SIZE >= cpu_put + UVM_MAX_PUSH_SIZE) {
         UVM_ASSERT_MSG(gpu_get < cpu_put, "gpu_get %u cpu_put %u\n", gpu_get, cpu_put);
 
         // Enough space at the end
-        set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
         chunk->next_push_start = cpu_put;
+        set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
     }
     else if (gpu_get >= UVM_MAX_PUSH_SIZE) {
         UVM_ASSERT_MSG(gpu_get < cpu_put, "gpu_get %u cpu_put %u\n", gpu_get, cpu_put);
 
         // Enough space at the beginning
-        set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
         chunk->next_push_start = 0;
+        set_chunk(pushbuffer, chunk, pushbuffer->available_chunks);
     }
 }
 
@@ -385,7 +405,7 @@ void uvm_pushbuffer_mark_completed(uvm_pushbuffer_t *pushbuffer, uvm_gpfifo_entr
     push_info->on_complete = NULL;
     push_info->on_complete_data = NULL;
 
-    uvm_spin_lock(&pushbuffer->lock);
+    uvm_spin_lock(&chunk->lock);
 
     if (gpfifo == chunk_get_first_gpfifo(chunk))
         need_to_update_chunk = true;
@@ -399,7 +419,7 @@ void uvm_pushbuffer_mark_completed(uvm_pushbuffer_t *pushbuffer, uvm_gpfifo_entr
     if (need_to_update_chunk && chunk->current_push == NULL)
         update_chunk(pushbuffer, chunk);
 
-    uvm_spin_unlock(&pushbuffer->lock);
+    uvm_spin_unlock(&chunk->lock);
 }
 
 NvU32 uvm_pushbuffer_get_offset_for_push(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push)
@@ -428,7 +448,7 @@ void uvm_pushbuffer_end_push(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm
 
     uvm_assert_spinlock_locked(&push->channel->pool->lock);
 
-    uvm_spin_lock(&pushbuffer->lock);
+    uvm_spin_lock(&chunk->lock);
 
     list_add_tail(&gpfifo->pending_list_node, &chunk->pending_gpfifos);
 
@@ -437,7 +457,7 @@ void uvm_pushbuffer_end_push(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm
     UVM_ASSERT(chunk->current_push == push);
     chunk->current_push = NULL;
 
-    uvm_spin_unlock(&pushbuffer->lock);
+    uvm_spin_unlock(&chunk->lock);
 
     // uvm_pushbuffer_end_push() needs to be called with the channel lock held
     // while the concurrent pushes sema has a higher lock order. To keep the
@@ -447,15 +467,8 @@ void uvm_pushbuffer_end_push(uvm_pushbuffer_t *pushbuffer, uvm_push_t *push, uvm
 
 bool uvm_pushbuffer_has_space(uvm_pushbuffer_t *pushbuffer)
 {
-    bool has_space;
-
-    uvm_spin_lock(&pushbuffer->lock);
-
-    has_space = pick_chunk(pushbuffer) != NULL;
-
-    uvm_spin_unlock(&pushbuffer->lock);
-
-    return has_space;
+    // Idle chunks are always available, too
+    return !bitmap_empty(pushbuffer->available_chunks, UVM_PUSHBUFFER_CHUNKS);
 }
 
 void uvm_pushbuffer_print_common(uvm_pushbuffer_t *pushbuffer, struct seq_file *s)
@@ -464,22 +477,29 @@ void uvm_pushbuffer_print_common(uvm_pushbuffer_t *pushbuffer, struct seq_file *
 
     UVM_SEQ_OR_DBG_PRINT(s, "Pushbuffer for GPU %s\n", uvm_gpu_name(pushbuffer->channel_manager->gpu));
     UVM_SEQ_OR_DBG_PRINT(s, " has space: %d\n", uvm_pushbuffer_has_space(pushbuffer));
-
-    uvm_spin_lock(&pushbuffer->lock);
+    UVM_SEQ_OR_DBG_PRINT(s, " claims %llu races %llu waits %llu wait time %llu us\n",
+                         (NvU64)atomic64_read(&pushbuffer->stats.claims),
+                         (NvU64)atomic64_read(&pushbuffer->stats.claim_races),
+                         (NvU64)atomic64_read(&pushbuffer->stats.waits),
+                         (NvU64)atomic64_read(&pushbuffer->stats.wait_time_ns) / 1000);
 
     for (i = 0; i < UVM_PUSHBUFFER_CHUNKS; ++i) {
         uvm_pushbuffer_chunk_t *chunk = &pushbuffer->chunks[i];
-        NvU32 cpu_put = chunk_get_cpu_put(pushbuffer, chunk);
-        NvU32 gpu_get = chunk_get_gpu_get(pushbuffer, chunk);
+        NvU32 cpu_put;
+        NvU32 gpu_get;
+
+        uvm_spin_lock(&chunk->lock);
+
+        cpu_put = chunk_get_cpu_put(pushbuffer, chunk);
+        gpu_get = chunk_get_gpu_get(pushbuffer, chunk);
         UVM_SEQ_OR_DBG_PRINT(s, " chunk %u put %u get %u next %u available %d idle %d\n",
                 i,
                 cpu_put, gpu_get, chunk->next_push_start,
                 test_bit(i, pushbuffer->available_chunks) ? 1 : 0,
                 test_bit(i, pushbuffer->idle_chunks) ? 1 : 0);
 
+        uvm_spin_unlock(&chunk->lock);
     }
-
-    uvm_spin_unlock(&pushbuffer->lock);
 }
 
 void uvm_pushbuffer_print(uvm_pushbuffer_t *pushbuffer)
@@ -64,6 +64,14 @@
 // the CPU spin waits on the GPU to complete some of the pending pushes making
 // space for a new one.
 //
+// The bitmaps are updated with atomic bit operations, so that finding and
+// claiming a chunk doesn't need any lock shared by the whole pushbuffer. Each
+// channel pool starts looking for a chunk at a different position in the
+// bitmaps, which keeps pushes on different engines from racing for the same
+// chunks. The rest of a chunk's state is protected by a per-chunk lock, and a
+// claim is only final once the chunk is found without an on-going push under
+// that lock.
+//
 // To explain how chunks track pending pushes we will go through an example
 // modifying a chunk's state. Let's start with a few pending pushes in the
 // chunk:
@@ -167,6 +175,11 @@ typedef struct
 
     // Currently on-going push in the chunk. There can be only one at a time.
     uvm_push_t *current_push;
+
+    // Lock protecting the chunk state above. The chunk's bits in the
+    // pushbuffer bitmaps are only set with the lock held, but they are
+    // cleared locklessly when claiming the chunk.
+    uvm_spinlock_t lock;
 } uvm_pushbuffer_chunk_t;
 
 struct uvm_pushbuffer_struct
@@ -186,8 +199,21 @@ struct uvm_pushbuffer_struct
     // Chunks that do not have an on-going push nor any pending pushes.
     DECLARE_BITMAP(idle_chunks, UVM_PUSHBUFFER_CHUNKS);
 
-    // Lock protecting chunk state and the bitmaps.
-    uvm_spinlock_t lock;
+    // Chunk reservation statistics reported in the procfs info file
+    struct
+    {
+        // Number of chunks claimed for pushes
+        atomic64_t claims;
+
+        // Number of times a chunk claimed from the bitmaps turned out to be
+        // already taken by a concurrent push
+        atomic64_t claim_races;
+
+        // Number of claims that had to wait for the GPU to complete pushes,
+        // and the total time spent waiting
+        atomic64_t waits;
+        atomic64_t wait_time_ns;
+    } stats;
 
     // Semaphore enforcing a limited number of concurrent pushes.
     // Decremented in uvm_pushbuffer_begin_push(), incremented in
@@ -0,0 +1,123 @@
+/*******************************************************************************
+    Copyright (c) 2022 NVIDIA Corporation
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to
+    deal in the Software without restriction, including without limitation the
+    rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+    sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+        The above copyright notice and this permission notice shall be
+        included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*******************************************************************************/
+
+#include "uvm_radix_sort.h"
+#include "uvm_linux.h"
+
+#define RADIX_SORT_DIGIT_BITS 8
+#define RADIX_SORT_DIGIT_COUNT (128 / RADIX_SORT_DIGIT_BITS)
+#define RADIX_SORT_BUCKET_COUNT (1 << RADIX_SORT_DIGIT_BITS)
+
+// Below this number of entries, the histogram passes cost more than comparing
+// the keys directly
+#define RADIX_SORT_INSERTION_THRESHOLD 32
+
+static bool key_less(const uvm_radix_sort_entry_t *a, const uvm_radix_sort_entry_t *b)
+{
+    if (a->key_high != b->key_high)
+        return a->key_high < b->key_high;
+
+    return a->key_low < b->key_low;
+}
+
+static void insertion_sort(uvm_radix_sort_entry_t *entries, NvU32 count)
+{
+    NvU32 i;
+
+    for (i = 1; i < count; ++i) {
+        uvm_radix_sort_entry_t entry = entries[i];
+        NvU32 j = i;
+
+        while (j > 0 && key_less(&entry, &entries[j - 1])) {
+            entries[j] = entries[j - 1];
+            --j;
+        }
+
+        entries[j] = entry;
+    }
+}
+
+// Digit 0 is the least significant byte of key_low, and digit
+// RADIX_SORT_DIGIT_COUNT - 1 the most significant byte of key_high
+static unsigned entry_digit(const uvm_radix_sort_entry_t *entry, unsigned digit)
+{
+    NvU64 key = digit < RADIX_SORT_DIGIT_COUNT / 2? entry->key_low : entry->key_high;
+    unsigned shift = (digit % (RADIX_SORT_DIGIT_COUNT / 2)) * RADIX_SORT_DIGIT_BITS;
+
+    return (key >> shift) & (RADIX_SORT_BUCKET_COUNT - 1);
+}
+
+void uvm_radix_sort(uvm_radix_sort_entry_t *entries, uvm_radix_sort_entry_t *scratch, NvU32 count)
+{
+    NvU32 offsets[RADIX_SORT_BUCKET_COUNT];
+    uvm_radix_sort_entry_t *src = entries;
+    uvm_radix_sort_entry_t *dst = scratch;
+    NvU64 diff_low = 0;
+    NvU64 diff_high = 0;
+    unsigned digit;
+    NvU32 i;
+
+    if (count <= RADIX_SORT_INSERTION_THRESHOLD) {
+        insertion_sort(entries, count);
+        return;
+    }
+
+    // Find the key bits that are not the same in all the entries
+    for (i = 1; i < count; ++i) {
+        diff_low |= entries[i].key_low ^ entries[0].key_low;
+        diff_high |= entries[i].key_high ^ entries[0].key_high;
+    }
+
+    for (digit = 0; digit < RADIX_SORT_DIGIT_COUNT; ++digit) {
+        NvU64 diff = digit < RADIX_SORT_DIGIT_COUNT / 2? diff_low : diff_high;
+        unsigned shift = (digit % (RADIX_SORT_DIGIT_COUNT / 2)) * RADIX_SORT_DIGIT_BITS;
+        uvm_radix_sort_entry_t *tmp;
+        NvU32 offset = 0;
+        unsigned bucket;
+
+        if (((diff >> shift) & (RADIX_SORT_BUCKET_COUNT - 1)) == 0)
+            continue;
+
+        memset(offsets, 0, sizeof(offsets));
+
+        for (i = 0; i < count; ++i)
+            ++offsets[entry_digit(&src[i], digit)];
+
+        for (bucket = 0; bucket < RADIX_SORT_BUCKET_COUNT; ++bucket) {
+            NvU32 bucket_count = offsets[bucket];
+
+            offsets[bucket] = offset;
+            offset += bucket_count;
+        }
+
+        for (i = 0; i < count; ++i)
+            dst[offsets[entry_digit(&src[i], digit)]++] = src[i];
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != entries)
+        memcpy(entries, src, count * sizeof(*entries));
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+    Copyright (c) 2022 NVIDIA Corporation
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to
+    deal in the Software without restriction, including without limitation the
+    rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+    sell copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+        The above copyright notice and this permission notice shall be
+        included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef __UVM_RADIX_SORT_H__
+#define __UVM_RADIX_SORT_H__
+
+#include "nvtypes.h"
+
+// Least-significant-digit radix sort over 128-bit keys, used by the bottom
+// halves to order fault and access counter batches without the indirect
+// comparisons of the generic kernel sort().
+//
+// Callers pack the fields they want to sort by into key_high and key_low, most
+// significant field first. Key bytes that have the same value in all the
+// entries are skipped, so the number of passes depends on how much the keys
+// actually differ, not on their width. For example, a batch of faults on a
+// single VA space within a few MBs takes three or four passes.
+//
+// All locking is up to the caller.
+
+typedef struct
+{
+    // Keys are compared as unsigned 128-bit integers, with key_high being the
+    // most significant half
+    NvU64 key_high;
+    NvU64 key_low;
+
+    void *value;
+} uvm_radix_sort_entry_t;
+
+// Sort count entries in ascending key order. The sort is stable. scratch must
+// have room for count entries and its contents are clobbered. The sorted
+// entries are always returned in entries.
+void uvm_radix_sort(uvm_radix_sort_entry_t *entries, uvm_radix_sort_entry_t *scratch, NvU32 count);
+
+#endif // __UVM_RADIX_SORT_H__
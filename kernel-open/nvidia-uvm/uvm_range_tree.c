@@ -237,6 +237,38 @@ uvm_range_tree_node_t *uvm_range_tree_find(uvm_range_tree_t *tree, NvU64 addr)
     return range_node_find(tree, addr, NULL, NULL);
 }
 
+uvm_range_tree_node_t *uvm_range_tree_find_hint(uvm_range_tree_t *tree, uvm_range_tree_node_t *hint, NvU64 addr)
+{
+    uvm_range_tree_node_t *neighbor;
+
+    if (!hint)
+        return uvm_range_tree_find(tree, addr);
+
+    if (addr > hint->end) {
+        // Nodes are disjoint and the list is sorted, so if addr falls before
+        // the next node it is not contained in any node.
+        neighbor = uvm_range_tree_next(tree, hint);
+        if (!neighbor || addr < neighbor->start)
+            return NULL;
+
+        if (addr <= neighbor->end)
+            return neighbor;
+    }
+    else if (addr < hint->start) {
+        neighbor = uvm_range_tree_prev(tree, hint);
+        if (!neighbor || addr > neighbor->end)
+            return NULL;
+
+        if (addr >= neighbor->start)
+            return neighbor;
+    }
+    else {
+        return hint;
+    }
+
+    return uvm_range_tree_find(tree, addr);
+}
+
 uvm_range_tree_node_t *uvm_range_tree_iter_first(uvm_range_tree_t *tree, NvU64 start, NvU64 end)
 {
     uvm_range_tree_node_t *node, *next;
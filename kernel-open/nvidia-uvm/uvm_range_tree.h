@@ -100,6 +100,14 @@ uvm_range_tree_node_t *uvm_range_tree_merge_next(uvm_range_tree_t *tree, uvm_ran
 // Returns the node containing addr, if any
 uvm_range_tree_node_t *uvm_range_tree_find(uvm_range_tree_t *tree, NvU64 addr);
 
+// Same as uvm_range_tree_find, but hint and its neighbors in address order are
+// checked before walking the tree. This makes runs of lookups with nearby or
+// increasing addresses, like those of a sorted fault batch, avoid the tree walk
+// in the common case. hint may be NULL, otherwise it must be a node currently
+// in the tree. The caller is responsible for dropping hints to nodes removed
+// from the tree.
+uvm_range_tree_node_t *uvm_range_tree_find_hint(uvm_range_tree_t *tree, uvm_range_tree_node_t *hint, NvU64 addr);
+
 // Returns the prev/next node in address order, or NULL if none exists
 static uvm_range_tree_node_t *uvm_range_tree_prev(uvm_range_tree_t *tree, uvm_range_tree_node_t *node)
 {
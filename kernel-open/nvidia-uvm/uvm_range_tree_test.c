@@ -346,6 +346,22 @@ static NV_STATUS rtt_check_node(rtt_state_t *state, uvm_range_tree_node_t *node)
         TEST_CHECK_RET(uvm_range_tree_iter_next(&state->tree, node, ULLONG_MAX) == NULL);
     }
 
+    // Hinted lookups must return the same node regardless of the hint
+    TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, NULL, mid) == node);
+    TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, node, mid) == node);
+    if (prev) {
+        TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, prev, start) == node);
+        TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, node, prev->end) == prev);
+        if (prev->end + 1 < start)
+            TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, node, start - 1) == NULL);
+    }
+    if (next) {
+        TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, next, end) == node);
+        TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, prev ? prev : next, end) == node);
+        if (end + 1 < next->start)
+            TEST_CHECK_RET(uvm_range_tree_find_hint(&state->tree, node, end + 1) == NULL);
+    }
+
     return NV_OK;
 }
 
@@ -1463,3 +1479,96 @@ NV_STATUS uvm_test_range_tree_random(UVM_TEST_RANGE_TREE_RANDOM_PARAMS *params,
     rtt_state_destroy(state);
     return status;
 }
+
+// ---------------------------- Benchmark Test ---------------------------- //
+
+#define RTT_BENCHMARK_DEFAULT_NUM_RANGES 1000000
+
+// Distance between the start of consecutive ranges. Ranges are half that size
+// so there are gaps between them, like between real allocations.
+#define RTT_BENCHMARK_STRIDE (4ull * 1024 * 1024)
+
+NV_STATUS uvm_test_range_tree_benchmark(UVM_TEST_RANGE_TREE_BENCHMARK_PARAMS *params, struct file *filp)
+{
+    uvm_range_tree_t tree;
+    uvm_range_tree_node_t *nodes;
+    uvm_range_tree_node_t *node;
+    uvm_range_tree_node_t *hint = NULL;
+    uvm_test_rng_t rng;
+    NvU64 num_ranges = params->numRanges ? params->numRanges : RTT_BENCHMARK_DEFAULT_NUM_RANGES;
+    NvU64 start_time;
+    NvU64 i;
+    NV_STATUS status = NV_OK;
+
+    if (num_ranges > ULLONG_MAX / RTT_BENCHMARK_STRIDE)
+        return NV_ERR_INVALID_PARAMETER;
+
+    nodes = uvm_kvmalloc_zero(num_ranges * sizeof(*nodes));
+    if (!nodes)
+        return NV_ERR_NO_MEMORY;
+
+    uvm_range_tree_init(&tree);
+    uvm_test_rng_init(&rng, params->seed);
+
+    // Insert the ranges in random order, so the tree doesn't benefit from
+    // sorted insertions. Start with a Fisher-Yates shuffle of the slots.
+    for (i = 0; i < num_ranges; i++)
+        nodes[i].start = i;
+
+    for (i = num_ranges - 1; i > 0; i--) {
+        NvU64 j = uvm_test_rng_range_64(&rng, 0, i);
+        swap(nodes[i].start, nodes[j].start);
+    }
+
+    for (i = 0; i < num_ranges; i++) {
+        nodes[i].start *= RTT_BENCHMARK_STRIDE;
+        nodes[i].end = nodes[i].start + RTT_BENCHMARK_STRIDE / 2 - 1;
+    }
+
+    start_time = NV_GETTIME();
+    for (i = 0; i < num_ranges; i++) {
+        TEST_NV_CHECK_GOTO(uvm_range_tree_add(&tree, &nodes[i]), out);
+
+        if (fatal_signal_pending(current)) {
+            status = NV_ERR_SIGNAL_PENDING;
+            goto out;
+        }
+    }
+    params->insertNs = NV_GETTIME() - start_time;
+
+    // Random lookups, half of which hit a range
+    start_time = NV_GETTIME();
+    for (i = 0; i < num_ranges; i++) {
+        NvU64 addr = uvm_test_rng_range_64(&rng, 0, num_ranges * RTT_BENCHMARK_STRIDE - 1);
+
+        node = uvm_range_tree_find(&tree, addr);
+        TEST_CHECK_GOTO(!node || (node->start <= addr && addr <= node->end), out);
+    }
+    params->randomLookupNs = NV_GETTIME() - start_time;
+
+    // Increasing addresses, several per range, like a sorted fault batch
+    start_time = NV_GETTIME();
+    for (i = 0; i < num_ranges * 4; i++) {
+        NvU64 addr = i * (RTT_BENCHMARK_STRIDE / 8);
+
+        node = uvm_range_tree_find(&tree, addr);
+        TEST_CHECK_GOTO(!!node == ((addr % RTT_BENCHMARK_STRIDE) < RTT_BENCHMARK_STRIDE / 2), out);
+    }
+    params->sortedLookupNs = NV_GETTIME() - start_time;
+
+    // Same as above, starting each lookup from the last hit
+    start_time = NV_GETTIME();
+    for (i = 0; i < num_ranges * 4; i++) {
+        NvU64 addr = i * (RTT_BENCHMARK_STRIDE / 8);
+
+        node = uvm_range_tree_find_hint(&tree, hint, addr);
+        TEST_CHECK_GOTO(!!node == ((addr % RTT_BENCHMARK_STRIDE) < RTT_BENCHMARK_STRIDE / 2), out);
+        if (node)
+            hint = node;
+    }
+    params->sortedHintLookupNs = NV_GETTIME() - start_time;
+
+out:
+    uvm_kvfree(nodes);
+    return status;
+}
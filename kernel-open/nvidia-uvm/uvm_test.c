@@ -260,6 +260,7 @@ long uvm_test_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_FAULT_BUFFER_FLUSH,           uvm_test_fault_buffer_flush);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_INJECT_TOOLS_EVENT,           uvm_test_inject_tools_event);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_INCREMENT_TOOLS_COUNTER,      uvm_test_increment_tools_counter);
+        UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_TOOLS_EVENT_QUEUE_STRESS,     uvm_test_tools_event_queue_stress);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_MEM_SANITY,                   uvm_test_mem_sanity);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_MAKE_CHANNEL_STOPS_IMMEDIATE, uvm_test_make_channel_stops_immediate);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_VA_BLOCK_INJECT_ERROR,        uvm_test_va_block_inject_error);
@@ -274,6 +275,11 @@ long uvm_test_ioctl(struct file *filp, unsigned int cmd, unsigned long arg)
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_FLUSH_DEFERRED_WORK,          uvm_test_flush_deferred_work);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_NV_KTHREAD_Q,                 uvm_test_nv_kthread_q);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_SET_PAGE_PREFETCH_POLICY,     uvm_test_set_page_prefetch_policy);
+        UVM_ROUTE_CMD_ALLOC_INIT_CHECK(UVM_TEST_PREFETCH_PREDICTOR_REPLAY,    uvm_test_prefetch_predictor_replay);
+        UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_FAULT_BATCH_SORT_BENCHMARK,   uvm_test_fault_batch_sort_benchmark);
+        UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_PMM_EVICTION_POLICY_REPLAY,   uvm_test_pmm_eviction_policy_replay);
+        UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_MIGRATE_BENCHMARK,            uvm_test_migrate_benchmark);
+        UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_RANGE_TREE_BENCHMARK,         uvm_test_range_tree_benchmark);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_RANGE_GROUP_TREE,             uvm_test_range_group_tree);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_RANGE_GROUP_RANGE_INFO,       uvm_test_range_group_range_info);
         UVM_ROUTE_CMD_STACK_INIT_CHECK(UVM_TEST_RANGE_GROUP_RANGE_COUNT,      uvm_test_range_group_range_count);
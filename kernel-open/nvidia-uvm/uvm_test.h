@@ -103,6 +103,7 @@ long uvm_test_ioctl(struct file *filp, unsigned int cmd, unsigned long arg);
 
 NV_STATUS uvm_test_range_tree_directed(UVM_TEST_RANGE_TREE_DIRECTED_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_range_tree_random(UVM_TEST_RANGE_TREE_RANDOM_PARAMS *params, struct file *filp);
+NV_STATUS uvm_test_range_tree_benchmark(UVM_TEST_RANGE_TREE_BENCHMARK_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_range_allocator_sanity(UVM_TEST_RANGE_ALLOCATOR_SANITY_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_page_tree(UVM_TEST_PAGE_TREE_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_rm_mem_sanity(UVM_TEST_RM_MEM_SANITY_PARAMS *params, struct file *filp);
@@ -154,6 +155,11 @@ NV_STATUS uvm_test_evict_chunk(UVM_TEST_EVICT_CHUNK_PARAMS *params, struct file
 NV_STATUS uvm_test_flush_deferred_work(UVM_TEST_FLUSH_DEFERRED_WORK_PARAMS *params, struct file *filp);
 
 NV_STATUS uvm_test_set_page_prefetch_policy(UVM_TEST_SET_PAGE_PREFETCH_POLICY_PARAMS *params, struct file *filp);
+NV_STATUS uvm_test_prefetch_predictor_replay(UVM_TEST_PREFETCH_PREDICTOR_REPLAY_PARAMS *params, struct file *filp);
+NV_STATUS uvm_test_fault_batch_sort_benchmark(UVM_TEST_FAULT_BATCH_SORT_BENCHMARK_PARAMS *params, struct file *filp);
+NV_STATUS uvm_test_pmm_eviction_policy_replay(UVM_TEST_PMM_EVICTION_POLICY_REPLAY_PARAMS *params,
+                                             struct file *filp);
+NV_STATUS uvm_test_migrate_benchmark(UVM_TEST_MIGRATE_BENCHMARK_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_get_page_thrashing_policy(UVM_TEST_GET_PAGE_THRASHING_POLICY_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_set_page_thrashing_policy(UVM_TEST_SET_PAGE_THRASHING_POLICY_PARAMS *params, struct file *filp);
 
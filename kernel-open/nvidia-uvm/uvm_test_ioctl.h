@@ -322,6 +322,11 @@ typedef struct
 typedef struct
 {
     NvBool    skipTimestampTest;      // In
+
+    // Number of pushes done by the concurrent push throughput test across all
+    // GPUs, and the time it took
+    NvU64     concurrentPushes        NV_ALIGN_BYTES(8); // Out
+    NvU64     concurrentPushTimeNs    NV_ALIGN_BYTES(8); // Out
     NV_STATUS rmStatus;               // Out
 } UVM_TEST_PUSH_SANITY_PARAMS;
 
@@ -1404,6 +1409,170 @@ typedef struct
     NV_STATUS rmStatus;                                  // Out
 } UVM_TEST_CGROUP_ACCOUNTING_SUPPORTED_PARAMS;
 
+// Record eventsPerProducer copies of entry into the calling process's tools
+// event queues from producerCount kernel threads at once. Queues must be
+// created and have the event enabled beforehand. eventsDropped is the growth
+// of the queues' dropped counters for the event type during the run, and
+// eventsPerSec is the rate at which events were offered to the queues.
+#define UVM_TEST_TOOLS_EVENT_QUEUE_STRESS                UVM_TEST_IOCTL_BASE(97)
+typedef struct
+{
+    UvmEventEntry entry;                                 // In
+    NvU32         producerCount;                         // In
+    NvU32         eventsPerProducer;                     // In
+    NvU64         eventsRecorded NV_ALIGN_BYTES(8);      // Out
+    NvU64         eventsDropped  NV_ALIGN_BYTES(8);      // Out
+    NvU64         elapsedNs      NV_ALIGN_BYTES(8);      // Out
+    NvU64         eventsPerSec   NV_ALIGN_BYTES(8);      // Out
+    NV_STATUS     rmStatus;                              // Out
+} UVM_TEST_TOOLS_EVENT_QUEUE_STRESS_PARAMS;
+
+#define UVM_TEST_PREFETCH_PREDICTOR_TRACE_MAX_LENGTH     512
+
+typedef struct
+{
+    NvU64 blockIndex NV_ALIGN_BYTES(8);
+    NvU32 rangeTag;                                      // Must be non-zero
+    NvU32 processor;
+} UVM_TEST_PREFETCH_TRACE_ENTRY;
+
+// Replay a synthetic trace of VA block first touches against a fresh instance
+// of the prefetch stream predictor. rangeTag stands in for the VA range of
+// each touch, and blockIndex must be below blockCount. hit[i] is set if entry
+// i had been predicted. threshold is the adapted bitmap tree threshold at the
+// end of the trace.
+//
+// Error returns:
+// NV_ERR_INVALID_ARGUMENT
+//  - traceLength is too large, or an entry has a zero rangeTag or an
+//    out-of-bounds blockIndex
+#define UVM_TEST_PREFETCH_PREDICTOR_REPLAY               UVM_TEST_IOCTL_BASE(98)
+typedef struct
+{
+    UVM_TEST_PREFETCH_TRACE_ENTRY trace[UVM_TEST_PREFETCH_PREDICTOR_TRACE_MAX_LENGTH]; // In
+    NvU64 blockCount                NV_ALIGN_BYTES(8);   // In
+    NvU32 traceLength;                                   // In
+
+    NvU64 firstTouches              NV_ALIGN_BYTES(8);   // Out
+    NvU64 predictions               NV_ALIGN_BYTES(8);   // Out
+    NvU64 hits                      NV_ALIGN_BYTES(8);   // Out
+    NvU32 threshold;                                     // Out
+    NvU8  hit[UVM_TEST_PREFETCH_PREDICTOR_TRACE_MAX_LENGTH]; // Out
+    NV_STATUS rmStatus;                                  // Out
+} UVM_TEST_PREFETCH_PREDICTOR_REPLAY_PARAMS;
+
+#define UVM_TEST_FAULT_BATCH_SORT_BENCHMARK_MAX_BATCH_SIZE 65536
+
+// Sort iterations synthetic replayable fault batches of batchSize entries with
+// the radix sort used by the fault servicing path and, as a reference, with
+// the generic comparison sort it replaced. Faults are spread over
+// vaSpaceCount fake VA spaces and blockCount VA blocks per VA space. The two
+// sorts must produce the same key order, and the radix sort must keep faults
+// with the same key in batch order. radixSortNs and genericSortNs are the
+// total times spent in each sort.
+//
+// Error returns:
+// NV_ERR_INVALID_ARGUMENT
+//  - batchSize, iterations, vaSpaceCount or blockCount is zero, or batchSize
+//    is too large
+// NV_ERR_INVALID_STATE
+//  - the two sorts disagree, or the radix sort is not stable
+#define UVM_TEST_FAULT_BATCH_SORT_BENCHMARK              UVM_TEST_IOCTL_BASE(99)
+typedef struct
+{
+    NvU32 batchSize;                                     // In
+    NvU32 iterations;                                    // In
+    NvU32 vaSpaceCount;                                  // In
+    NvU32 blockCount;                                    // In
+    NvU32 seed;                                          // In
+    NvU64 radixSortNs               NV_ALIGN_BYTES(8);   // Out
+    NvU64 genericSortNs             NV_ALIGN_BYTES(8);   // Out
+    NV_STATUS rmStatus;                                  // Out
+} UVM_TEST_FAULT_BATCH_SORT_BENCHMARK_PARAMS;
+
+#define UVM_TEST_PMM_EVICTION_POLICY_REPLAY_MAX_CHUNKS   (1024 * 1024)
+
+// Replay a synthetic trace of root chunk accesses against a simulated GPU
+// memory of capacity root chunks, using the PMM eviction policy policy (a
+// uvm_pmm_gpu_eviction_policy_t value). Each access goes with hotPercent
+// probability to a random chunk among the first hotCount chunks, and otherwise
+// to the next chunk of a cyclic scan over the remaining chunkCount - hotCount
+// chunks. Accesses to non-resident chunks are misses that populate the chunk,
+// evicting another one if the memory is full. refaults counts misses on
+// previously evicted chunks, and refaultDistanceSum the number of evictions
+// between each of those evictions and its refault.
+//
+// Error returns:
+// NV_ERR_INVALID_ARGUMENT
+//  - policy is invalid, chunkCount is zero or too large, capacity is zero or
+//    larger than chunkCount, hotCount is larger than chunkCount or
+//    hotPercent is larger than 100
+#define UVM_TEST_PMM_EVICTION_POLICY_REPLAY              UVM_TEST_IOCTL_BASE(100)
+typedef struct
+{
+    NvU32 policy;                                        // In
+    NvU32 capacity;                                      // In
+    NvU32 chunkCount;                                    // In
+    NvU32 hotCount;                                      // In
+    NvU32 hotPercent;                                    // In
+    NvU32 seed;                                          // In
+    NvU64 traceLength               NV_ALIGN_BYTES(8);   // In
+
+    NvU64 hits                      NV_ALIGN_BYTES(8);   // Out
+    NvU64 misses                    NV_ALIGN_BYTES(8);   // Out
+    NvU64 evictions                 NV_ALIGN_BYTES(8);   // Out
+    NvU64 secondChances             NV_ALIGN_BYTES(8);   // Out
+    NvU64 refaults                  NV_ALIGN_BYTES(8);   // Out
+    NvU64 refaultDistanceSum        NV_ALIGN_BYTES(8);   // Out
+    NV_STATUS rmStatus;                                  // Out
+} UVM_TEST_PMM_EVICTION_POLICY_REPLAY_PARAMS;
+
+// Migrate the managed range [base, base + length) to destinationUuid with one
+// UvmMigrate-equivalent operation per chunkSize bytes, without waiting between
+// chunks, and wait for all of them to complete. migratedBytes is the number of
+// bytes that changed residency and durationNs the time it took.
+//
+// Error returns:
+// NV_ERR_INVALID_ADDRESS
+//  - base or length are not page-aligned, or the range is not managed memory
+// NV_ERR_INVALID_ARGUMENT
+//  - chunkSize is zero or not page-aligned
+// NV_ERR_INVALID_DEVICE
+//  - destinationUuid is not the CPU or a GPU with a GPU VA space
+#define UVM_TEST_MIGRATE_BENCHMARK                       UVM_TEST_IOCTL_BASE(101)
+typedef struct
+{
+    NvU64 base                      NV_ALIGN_BYTES(8);   // In
+    NvU64 length                    NV_ALIGN_BYTES(8);   // In
+    NvU64 chunkSize                 NV_ALIGN_BYTES(8);   // In
+    NvProcessorUuid destinationUuid;                     // In
+
+    NvU64 migratedBytes             NV_ALIGN_BYTES(8);   // Out
+    NvU64 durationNs                NV_ALIGN_BYTES(8);   // Out
+    NV_STATUS rmStatus;                                  // Out
+} UVM_TEST_MIGRATE_BENCHMARK_PARAMS;
+
+// Insert numRanges disjoint ranges (1000000 if zero) into a range tree in
+// random order, then time numRanges random lookups and two passes of lookups
+// at increasing addresses, several per range: one with uvm_range_tree_find
+// and one with uvm_range_tree_find_hint starting from the last hit.
+//
+// Error returns:
+// NV_ERR_INVALID_PARAMETER
+//  - numRanges is too large for the ranges to fit in the address space
+#define UVM_TEST_RANGE_TREE_BENCHMARK                    UVM_TEST_IOCTL_BASE(102)
+typedef struct
+{
+    NvU64 numRanges                 NV_ALIGN_BYTES(8);   // In
+    NvU32 seed;                                          // In
+
+    NvU64 insertNs                  NV_ALIGN_BYTES(8);   // Out
+    NvU64 randomLookupNs            NV_ALIGN_BYTES(8);   // Out
+    NvU64 sortedLookupNs            NV_ALIGN_BYTES(8);   // Out
+    NvU64 sortedHintLookupNs        NV_ALIGN_BYTES(8);   // Out
+    NV_STATUS rmStatus;                                  // Out
+} UVM_TEST_RANGE_TREE_BENCHMARK_PARAMS;
+
 #ifdef __cplusplus
 }
 #endif
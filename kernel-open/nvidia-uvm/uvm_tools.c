@@ -49,6 +49,18 @@ typedef struct
     NvU32 put_behind;
 } uvm_tools_queue_snapshot_t;
 
+// One ring of a per-CPU event queue. Producers claim slots by advancing
+// reserve with a cmpxchg, copy their entry, and then publish it by advancing
+// commit (and the user-visible put pointers) in reservation order.
+typedef struct
+{
+    UvmEventEntry *queue;
+    UvmToolsEventControlData *control;
+
+    atomic_t reserve;
+    atomic_t commit;
+} uvm_tools_sub_queue_t;
+
 typedef struct
 {
     uvm_spinlock_t lock;
@@ -66,13 +78,26 @@ typedef struct
     wait_queue_head_t wait_queue;
     bool is_wakeup_get_valid;
     NvU32 wakeup_get;
+
+    // Per-CPU queues only. queue and control above then cover all of the
+    // rings, and queue_buffer_count is the size of each ring. lock is only
+    // taken by the consumer side.
+    NvU32 sub_queue_count;
+    uvm_tools_sub_queue_t *sub_queues;
+
+    // Set by the first producer to cross the notification threshold and
+    // cleared by poll, so a burst of events causes a single wakeup.
+    atomic_t wakeup_pending;
 } uvm_tools_queue_t;
 
 typedef struct
 {
-    struct list_head counter_nodes[UVM_TOTAL_COUNTERS];
+    struct list_head counter_nodes[UVM_TOTAL_COUNTERS_EXTENDED];
     NvU64 subscribed_counters;
 
+    // Number of entries in the user counter array. Only counters below it
+    // can be enabled.
+    NvU32 counter_count;
     struct page **counter_buffer_pages;
     NvU64 *counters;
 
@@ -355,6 +380,32 @@ static bool queue_needs_wakeup(uvm_tools_queue_t *queue, uvm_tools_queue_snapsho
     return ((queue->queue_buffer_count + sn->put_behind - sn->get_ahead) & queue_mask) >= queue->notification_threshold;
 }
 
+static NvU32 queue_ring_count(uvm_tools_queue_t *queue)
+{
+    return max(queue->sub_queue_count, 1u);
+}
+
+static bool sub_queue_needs_wakeup(uvm_tools_queue_t *queue, uvm_tools_sub_queue_t *sub_queue)
+{
+    NvU32 queue_mask = queue->queue_buffer_count - 1;
+    NvU32 put_behind = atomic_read(&sub_queue->commit);
+    NvU32 get_ahead = atomic_read((atomic_t *)&sub_queue->control->get_ahead);
+
+    return ((queue->queue_buffer_count + put_behind - get_ahead) & queue_mask) >= READ_ONCE(queue->notification_threshold);
+}
+
+static bool per_cpu_queue_needs_wakeup(uvm_tools_queue_t *queue)
+{
+    NvU32 i;
+
+    for (i = 0; i < queue->sub_queue_count; i++) {
+        if (sub_queue_needs_wakeup(queue, queue->sub_queues + i))
+            return true;
+    }
+
+    return false;
+}
+
 static void destroy_event_tracker(uvm_tools_event_tracker_t *event_tracker)
 {
     if (event_tracker->uvm_file != NULL) {
@@ -377,28 +428,30 @@ static void destroy_event_tracker(uvm_tools_event_tracker_t *event_tracker)
             if (queue->queue != NULL) {
                 unmap_user_pages(queue->queue_buffer_pages,
                                  queue->queue,
-                                 queue->queue_buffer_count * sizeof(UvmEventEntry));
+                                 (NvU64)queue_ring_count(queue) * queue->queue_buffer_count * sizeof(UvmEventEntry));
             }
 
             if (queue->control != NULL) {
                 unmap_user_pages(queue->control_buffer_pages,
                                  queue->control,
-                                 sizeof(UvmToolsEventControlData));
+                                 queue_ring_count(queue) * sizeof(UvmToolsEventControlData));
             }
+
+            uvm_kvfree(queue->sub_queues);
         }
         else {
             uvm_tools_counter_t *counters = &event_tracker->counter;
 
             remove_event_tracker(va_space,
                                  counters->counter_nodes,
-                                 UVM_TOTAL_COUNTERS,
+                                 UVM_TOTAL_COUNTERS_EXTENDED,
                                  counters->subscribed_counters,
                                  &counters->subscribed_counters);
 
             if (counters->counters != NULL) {
                 unmap_user_pages(counters->counter_buffer_pages,
                                  counters->counters,
-                                 UVM_TOTAL_COUNTERS * sizeof(NvU64));
+                                 counters->counter_count * sizeof(NvU64));
             }
         }
 
@@ -464,6 +517,67 @@ unlock:
     uvm_spin_unlock(&queue->lock);
 }
 
+// Lock-free counterpart of enqueue_event for per-CPU queues. Producers that
+// map to the same ring (more CPUs than rings) claim distinct slots with a
+// cmpxchg on the ring's reserve index and then publish them in order. Like
+// enqueue_event, this must not be called from interrupt context: an
+// interrupted producer would never commit its slot.
+static void enqueue_event_per_cpu(const UvmEventEntry *entry, uvm_tools_queue_t *queue)
+{
+    uvm_tools_sub_queue_t *sub_queue;
+    UvmToolsEventControlData *ctrl;
+    NvU32 queue_size = queue->queue_buffer_count;
+    NvU32 queue_mask = queue_size - 1;
+    NvU32 put_behind;
+    NvU32 put_ahead;
+    NvU32 get_behind;
+    NvU32 get_ahead;
+
+    // See enqueue_event
+    nv_speculation_barrier();
+
+    // Staying on the CPU bounds how long another producer of the same ring may
+    // spin on this one's commit below.
+    sub_queue = queue->sub_queues + (get_cpu() % queue->sub_queue_count);
+    ctrl = sub_queue->control;
+
+    do {
+        put_behind = atomic_read(&sub_queue->reserve);
+        put_ahead = (put_behind + 1) & queue_mask;
+
+        // ctrl is mapped into user space with read and write permissions,
+        // so its values cannot be trusted.
+        get_behind = atomic_read((atomic_t *)&ctrl->get_behind) & queue_mask;
+
+        // one free element means that the queue is full
+        if (((queue_size + get_behind - put_behind) & queue_mask) == 1) {
+            atomic64_inc((atomic64_t *)&ctrl->dropped + entry->eventData.eventType);
+            goto done;
+        }
+    } while (atomic_cmpxchg(&sub_queue->reserve, put_behind, put_ahead) != put_behind);
+
+    memcpy(sub_queue->queue + put_behind, entry, sizeof(*entry));
+
+    while (atomic_read(&sub_queue->commit) != put_behind)
+        cpu_relax();
+
+    // The entry must be visible before the consumer can see the new put
+    // pointer. As in enqueue_event, put_ahead and put_behind are kept equal.
+    smp_wmb();
+    atomic_set((atomic_t *)&ctrl->put_ahead, put_ahead);
+    atomic_set((atomic_t *)&ctrl->put_behind, put_ahead);
+    atomic_set_release(&sub_queue->commit, put_ahead);
+
+    get_ahead = atomic_read((atomic_t *)&ctrl->get_ahead);
+    if (((queue_size + put_ahead - get_ahead) & queue_mask) >= READ_ONCE(queue->notification_threshold) &&
+        atomic_cmpxchg(&queue->wakeup_pending, 0, 1) == 0) {
+        wake_up_all(&queue->wait_queue);
+    }
+
+done:
+    put_cpu();
+}
+
 static void uvm_tools_record_event(uvm_va_space_t *va_space, const UvmEventEntry *entry)
 {
     NvU8 eventType = entry->eventData.eventType;
@@ -473,8 +587,12 @@ static void uvm_tools_record_event(uvm_va_space_t *va_space, const UvmEventEntry
 
     uvm_assert_rwsem_locked(&va_space->tools.lock);
 
-    list_for_each_entry(queue, va_space->tools.queues + eventType, queue_nodes[eventType])
-        enqueue_event(entry, queue);
+    list_for_each_entry(queue, va_space->tools.queues + eventType, queue_nodes[eventType]) {
+        if (queue->sub_queue_count != 0)
+            enqueue_event_per_cpu(entry, queue);
+        else
+            enqueue_event(entry, queue);
+    }
 }
 
 static void uvm_tools_broadcast_event(const UvmEventEntry *entry)
@@ -505,7 +623,7 @@ static void uvm_tools_inc_counter(uvm_va_space_t *va_space,
                                   NvU64 amount,
                                   const NvProcessorUuid *processor)
 {
-    UVM_ASSERT((NvU32)counter < UVM_TOTAL_COUNTERS);
+    UVM_ASSERT((NvU32)counter < UVM_TOTAL_COUNTERS_EXTENDED);
     uvm_assert_rwsem_locked(&va_space->tools.lock);
 
     if (amount > 0) {
@@ -532,7 +650,7 @@ static bool tools_is_counter_enabled(uvm_va_space_t *va_space, UvmCounterName co
 {
     uvm_assert_rwsem_locked(&va_space->tools.lock);
 
-    UVM_ASSERT(counter < UVM_TOTAL_COUNTERS);
+    UVM_ASSERT(counter < UVM_TOTAL_COUNTERS_EXTENDED);
     return !list_empty(va_space->tools.counters + counter);
 }
 
@@ -561,7 +679,7 @@ static bool tools_are_enabled(uvm_va_space_t *va_space)
 
     uvm_assert_rwsem_locked(&va_space->tools.lock);
 
-    for (i = 0; i < UVM_TOTAL_COUNTERS; i++) {
+    for (i = 0; i < UVM_TOTAL_COUNTERS_EXTENDED; i++) {
         if (tools_is_counter_enabled(va_space, i))
             return true;
     }
@@ -618,6 +736,8 @@ static long uvm_tools_unlocked_ioctl(struct file *filp, unsigned int cmd, unsign
 {
     switch (cmd) {
         UVM_ROUTE_CMD_STACK_NO_INIT_CHECK(UVM_TOOLS_INIT_EVENT_TRACKER,         uvm_api_tools_init_event_tracker);
+        UVM_ROUTE_CMD_STACK_NO_INIT_CHECK(UVM_TOOLS_INIT_PER_CPU_EVENT_QUEUE,   uvm_api_tools_init_per_cpu_event_queue);
+        UVM_ROUTE_CMD_STACK_NO_INIT_CHECK(UVM_TOOLS_INIT_COUNTER_TRACKER,       uvm_api_tools_init_counter_tracker);
         UVM_ROUTE_CMD_STACK_NO_INIT_CHECK(UVM_TOOLS_SET_NOTIFICATION_THRESHOLD, uvm_api_tools_set_notification_threshold);
         UVM_ROUTE_CMD_STACK_NO_INIT_CHECK(UVM_TOOLS_EVENT_QUEUE_ENABLE_EVENTS,  uvm_api_tools_event_queue_enable_events);
         UVM_ROUTE_CMD_STACK_NO_INIT_CHECK(UVM_TOOLS_EVENT_QUEUE_DISABLE_EVENTS, uvm_api_tools_event_queue_disable_events);
@@ -651,13 +771,23 @@ static unsigned uvm_tools_poll(struct file *filp, poll_table *wait)
 
     uvm_spin_lock(&event_tracker->queue.lock);
 
-    event_tracker->queue.is_wakeup_get_valid = false;
-    ctrl = event_tracker->queue.control;
-    sn.get_ahead = atomic_read((atomic_t *)&ctrl->get_ahead);
-    sn.put_behind = atomic_read((atomic_t *)&ctrl->put_behind);
+    if (event_tracker->queue.sub_queue_count != 0) {
+        // The exchange orders re-arming the wakeup before the checks below, so
+        // an event committed concurrently is either seen here or wakes us.
+        atomic_xchg(&event_tracker->queue.wakeup_pending, 0);
+
+        if (per_cpu_queue_needs_wakeup(&event_tracker->queue))
+            flags = POLLIN | POLLRDNORM;
+    }
+    else {
+        event_tracker->queue.is_wakeup_get_valid = false;
+        ctrl = event_tracker->queue.control;
+        sn.get_ahead = atomic_read((atomic_t *)&ctrl->get_ahead);
+        sn.put_behind = atomic_read((atomic_t *)&ctrl->put_behind);
 
-    if (queue_needs_wakeup(&event_tracker->queue, &sn))
-        flags = POLLIN | POLLRDNORM;
+        if (queue_needs_wakeup(&event_tracker->queue, &sn))
+            flags = POLLIN | POLLRDNORM;
+    }
 
     uvm_spin_unlock(&event_tracker->queue.lock);
 
@@ -1436,6 +1566,51 @@ void uvm_tools_record_throttling_end(uvm_va_space_t *va_space, NvU64 address, uv
     uvm_up_read(&va_space->tools.lock);
 }
 
+void uvm_tools_record_prefetch_prediction(uvm_va_space_t *va_space,
+                                          uvm_processor_id_t processor,
+                                          bool predicted,
+                                          bool hit)
+{
+    NvProcessorUuid uuid;
+
+    UVM_ASSERT(UVM_ID_IS_VALID(processor));
+
+    uvm_assert_rwsem_locked(&va_space->lock);
+
+    if (!va_space->tools.enabled)
+        return;
+
+    uvm_va_space_processor_uuid(va_space, &uuid, processor);
+
+    uvm_down_read(&va_space->tools.lock);
+    uvm_tools_inc_counter(va_space, UvmCounterNamePrefetchFirstTouchBlockCount, 1, &uuid);
+    uvm_tools_inc_counter(va_space, UvmCounterNamePrefetchPredictionCount, predicted ? 1 : 0, &uuid);
+    uvm_tools_inc_counter(va_space, UvmCounterNamePrefetchPredictionHitCount, hit ? 1 : 0, &uuid);
+    uvm_up_read(&va_space->tools.lock);
+}
+
+void uvm_tools_record_migration_throughput(uvm_va_space_t *va_space,
+                                           uvm_processor_id_t processor,
+                                           NvU64 bytes,
+                                           NvU64 duration_ns)
+{
+    NvProcessorUuid uuid;
+
+    UVM_ASSERT(UVM_ID_IS_VALID(processor));
+
+    uvm_assert_rwsem_locked(&va_space->lock);
+
+    if (!va_space->tools.enabled || bytes == 0)
+        return;
+
+    uvm_va_space_processor_uuid(va_space, &uuid, processor);
+
+    uvm_down_read(&va_space->tools.lock);
+    uvm_tools_inc_counter(va_space, UvmCounterNameMigrateBytes, bytes, &uuid);
+    uvm_tools_inc_counter(va_space, UvmCounterNameMigrateTimeNs, duration_ns, &uuid);
+    uvm_up_read(&va_space->tools.lock);
+}
+
 static void record_map_remote_events(void *args)
 {
     block_map_remote_data_t *block_map_remote = (block_map_remote_data_t *)args;
@@ -1579,7 +1754,7 @@ done:
     uvm_up_read(&va_space->tools.lock);
 }
 
-NV_STATUS uvm_api_tools_init_event_tracker(UVM_TOOLS_INIT_EVENT_TRACKER_PARAMS *params, struct file *filp)
+static NV_STATUS tools_event_tracker_alloc(NvU32 uvm_fd, uvm_tools_event_tracker_t **event_tracker_out)
 {
     NV_STATUS status = NV_OK;
     uvm_tools_event_tracker_t *event_tracker;
@@ -1588,7 +1763,7 @@ NV_STATUS uvm_api_tools_init_event_tracker(UVM_TOOLS_INIT_EVENT_TRACKER_PARAMS *
     if (event_tracker == NULL)
         return NV_ERR_NO_MEMORY;
 
-    event_tracker->uvm_file = fget(params->uvmFd);
+    event_tracker->uvm_file = fget(uvm_fd);
     if (event_tracker->uvm_file == NULL) {
         status = NV_ERR_INSUFFICIENT_PERMISSIONS;
         goto fail;
@@ -1608,57 +1783,213 @@ NV_STATUS uvm_api_tools_init_event_tracker(UVM_TOOLS_INIT_EVENT_TRACKER_PARAMS *
         goto fail;
     }
 
-    event_tracker->is_queue = params->queueBufferSize != 0;
-    if (event_tracker->is_queue) {
-        uvm_tools_queue_t *queue = &event_tracker->queue;
-        uvm_spin_lock_init(&queue->lock, UVM_LOCK_ORDER_LEAF);
-        init_waitqueue_head(&queue->wait_queue);
+    *event_tracker_out = event_tracker;
+    return NV_OK;
 
-        if (params->queueBufferSize > UINT_MAX) {
-            status = NV_ERR_INVALID_ARGUMENT;
-            goto fail;
-        }
+fail:
+    destroy_event_tracker(event_tracker);
+    return status;
+}
+
+// A sub_queue_count of 0 creates a single ring shared by all CPUs, which
+// producers fill under queue->lock.
+static NV_STATUS tools_queue_init(uvm_tools_queue_t *queue,
+                                  NvU64 queue_buffer,
+                                  NvU64 queue_buffer_size,
+                                  NvU64 control_buffer,
+                                  NvU32 sub_queue_count)
+{
+    NV_STATUS status;
+    NvU32 i;
 
-        queue->queue_buffer_count = (NvU32)params->queueBufferSize;
-        queue->notification_threshold = queue->queue_buffer_count / 2;
+    uvm_spin_lock_init(&queue->lock, UVM_LOCK_ORDER_LEAF);
+    init_waitqueue_head(&queue->wait_queue);
+    atomic_set(&queue->wakeup_pending, 0);
 
-        // queue_buffer_count must be a power of 2, of at least 2
-        if (!is_power_of_2(queue->queue_buffer_count) || queue->queue_buffer_count < 2) {
-            status = NV_ERR_INVALID_ARGUMENT;
-            goto fail;
-        }
+    if (queue_buffer_size > UINT_MAX)
+        return NV_ERR_INVALID_ARGUMENT;
 
-        status = map_user_pages(params->queueBuffer,
-                                queue->queue_buffer_count * sizeof(UvmEventEntry),
-                                (void **)&queue->queue,
-                                &queue->queue_buffer_pages);
-        if (status != NV_OK)
-            goto fail;
+    queue->queue_buffer_count = (NvU32)queue_buffer_size;
+    queue->notification_threshold = queue->queue_buffer_count / 2;
+
+    // queue_buffer_count must be a power of 2, of at least 2
+    if (!is_power_of_2(queue->queue_buffer_count) || queue->queue_buffer_count < 2)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    // Rings beyond the number of CPUs would never receive events
+    if (sub_queue_count > num_possible_cpus())
+        return NV_ERR_INVALID_ARGUMENT;
+
+    // Set before mapping so that destroy_event_tracker unmaps the full ranges
+    queue->sub_queue_count = sub_queue_count;
+
+    status = map_user_pages(queue_buffer,
+                            (NvU64)queue_ring_count(queue) * queue->queue_buffer_count * sizeof(UvmEventEntry),
+                            (void **)&queue->queue,
+                            &queue->queue_buffer_pages);
+    if (status != NV_OK)
+        return status;
+
+    status = map_user_pages(control_buffer,
+                            queue_ring_count(queue) * sizeof(UvmToolsEventControlData),
+                            (void **)&queue->control,
+                            &queue->control_buffer_pages);
+    if (status != NV_OK)
+        return status;
+
+    if (sub_queue_count == 0)
+        return NV_OK;
+
+    queue->sub_queues = uvm_kvmalloc_zero(sub_queue_count * sizeof(*queue->sub_queues));
+    if (queue->sub_queues == NULL)
+        return NV_ERR_NO_MEMORY;
+
+    for (i = 0; i < sub_queue_count; i++) {
+        uvm_tools_sub_queue_t *sub_queue = queue->sub_queues + i;
+        NvU32 put_behind;
+
+        sub_queue->queue = queue->queue + (NvU64)i * queue->queue_buffer_count;
+        sub_queue->control = queue->control + i;
+
+        // Continue from wherever the consumer initialized the ring
+        put_behind = atomic_read((atomic_t *)&sub_queue->control->put_behind) & (queue->queue_buffer_count - 1);
+        atomic_set(&sub_queue->reserve, put_behind);
+        atomic_set(&sub_queue->commit, put_behind);
+    }
+
+    return NV_OK;
+}
+
+static NV_STATUS tools_event_tracker_install(uvm_tools_event_tracker_t *event_tracker, struct file *filp)
+{
+    if (nv_atomic_long_cmpxchg((atomic_long_t *)&filp->private_data, 0, (long)event_tracker) != 0)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    return NV_OK;
+}
+
+static NV_STATUS tools_counter_init(uvm_tools_counter_t *counter,
+                                    NvU64 counter_buffer_va,
+                                    NvU32 counter_count,
+                                    NvU32 all_processors,
+                                    const NvProcessorUuid *processor)
+{
+    NV_STATUS status;
 
-        status = map_user_pages(params->controlBuffer,
-                                sizeof(UvmToolsEventControlData),
-                                (void **)&queue->control,
-                                &queue->control_buffer_pages);
+    counter->all_processors = all_processors;
+    counter->processor = *processor;
 
+    status = map_user_pages(counter_buffer_va,
+                            sizeof(NvU64) * counter_count,
+                            (void **)&counter->counters,
+                            &counter->counter_buffer_pages);
+    if (status != NV_OK)
+        return status;
+
+    counter->counter_count = counter_count;
+    return NV_OK;
+}
+
+NV_STATUS uvm_api_tools_init_event_tracker(UVM_TOOLS_INIT_EVENT_TRACKER_PARAMS *params, struct file *filp)
+{
+    NV_STATUS status;
+    uvm_tools_event_tracker_t *event_tracker;
+
+    status = tools_event_tracker_alloc(params->uvmFd, &event_tracker);
+    if (status != NV_OK)
+        return status;
+
+    event_tracker->is_queue = params->queueBufferSize != 0;
+    if (event_tracker->is_queue) {
+        status = tools_queue_init(&event_tracker->queue,
+                                  params->queueBuffer,
+                                  params->queueBufferSize,
+                                  params->controlBuffer,
+                                  0);
         if (status != NV_OK)
             goto fail;
     }
     else {
-        uvm_tools_counter_t *counter = &event_tracker->counter;
-        counter->all_processors = params->allProcessors;
-        counter->processor = params->processor;
-        status = map_user_pages(params->controlBuffer,
-                                sizeof(NvU64) * UVM_TOTAL_COUNTERS,
-                                (void **)&counter->counters,
-                                &counter->counter_buffer_pages);
+        status = tools_counter_init(&event_tracker->counter,
+                                    params->controlBuffer,
+                                    UVM_TOTAL_COUNTERS,
+                                    params->allProcessors,
+                                    &params->processor);
         if (status != NV_OK)
             goto fail;
     }
 
-    if (nv_atomic_long_cmpxchg((atomic_long_t *)&filp->private_data, 0, (long)event_tracker) != 0) {
-        status = NV_ERR_INVALID_ARGUMENT;
+    status = tools_event_tracker_install(event_tracker, filp);
+    if (status != NV_OK)
+        goto fail;
+
+    return NV_OK;
+
+fail:
+    destroy_event_tracker(event_tracker);
+    return status;
+}
+
+NV_STATUS uvm_api_tools_init_per_cpu_event_queue(UVM_TOOLS_INIT_PER_CPU_EVENT_QUEUE_PARAMS *params, struct file *filp)
+{
+    NV_STATUS status;
+    uvm_tools_event_tracker_t *event_tracker;
+
+    if (params->subQueueCount == 0)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    status = tools_event_tracker_alloc(params->uvmFd, &event_tracker);
+    if (status != NV_OK)
+        return status;
+
+    event_tracker->is_queue = true;
+    status = tools_queue_init(&event_tracker->queue,
+                              params->queueBuffer,
+                              params->queueBufferSize,
+                              params->controlBuffer,
+                              params->subQueueCount);
+    if (status != NV_OK)
+        goto fail;
+
+    status = tools_event_tracker_install(event_tracker, filp);
+    if (status != NV_OK)
+        goto fail;
+
+    return NV_OK;
+
+fail:
+    destroy_event_tracker(event_tracker);
+    return status;
+}
+
+NV_STATUS uvm_api_tools_init_counter_tracker(UVM_TOOLS_INIT_COUNTER_TRACKER_PARAMS *params, struct file *filp)
+{
+    NV_STATUS status;
+    uvm_tools_event_tracker_t *event_tracker;
+    NvU64 counter_count = params->controlBufferSize / sizeof(NvU64);
+
+    if ((params->controlBufferSize % sizeof(NvU64)) != 0 || counter_count < UVM_TOTAL_COUNTERS)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    // Newer user mode may know of counters this driver does not implement.
+    counter_count = min(counter_count, (NvU64)UVM_TOTAL_COUNTERS_EXTENDED);
+
+    status = tools_event_tracker_alloc(params->uvmFd, &event_tracker);
+    if (status != NV_OK)
+        return status;
+
+    event_tracker->is_queue = false;
+    status = tools_counter_init(&event_tracker->counter,
+                                params->controlBuffer,
+                                (NvU32)counter_count,
+                                params->allProcessors,
+                                &params->processor);
+    if (status != NV_OK)
+        goto fail;
+
+    status = tools_event_tracker_install(event_tracker, filp);
+    if (status != NV_OK)
         goto fail;
-    }
 
     return NV_OK;
 
@@ -1678,14 +2009,20 @@ NV_STATUS uvm_api_tools_set_notification_threshold(UVM_TOOLS_SET_NOTIFICATION_TH
 
     uvm_spin_lock(&event_tracker->queue.lock);
 
-    event_tracker->queue.notification_threshold = params->notificationThreshold;
+    WRITE_ONCE(event_tracker->queue.notification_threshold, params->notificationThreshold);
 
-    ctrl = event_tracker->queue.control;
-    sn.put_behind = atomic_read((atomic_t *)&ctrl->put_behind);
-    sn.get_ahead = atomic_read((atomic_t *)&ctrl->get_ahead);
+    if (event_tracker->queue.sub_queue_count != 0) {
+        if (per_cpu_queue_needs_wakeup(&event_tracker->queue))
+            wake_up_all(&event_tracker->queue.wait_queue);
+    }
+    else {
+        ctrl = event_tracker->queue.control;
+        sn.put_behind = atomic_read((atomic_t *)&ctrl->put_behind);
+        sn.get_ahead = atomic_read((atomic_t *)&ctrl->get_ahead);
 
-    if (queue_needs_wakeup(&event_tracker->queue, &sn))
-        wake_up_all(&event_tracker->queue.wait_queue);
+        if (queue_needs_wakeup(&event_tracker->queue, &sn))
+            wake_up_all(&event_tracker->queue.wait_queue);
+    }
 
     uvm_spin_unlock(&event_tracker->queue.lock);
 
@@ -1884,10 +2221,15 @@ NV_STATUS uvm_api_tools_enable_counters(UVM_TOOLS_ENABLE_COUNTERS_PARAMS *params
     uvm_tools_event_tracker_t *event_tracker = tools_event_tracker(filp);
     NV_STATUS status = NV_OK;
     NvU64 inserted_lists;
+    NvU64 counter_flags;
 
     if (!tracker_is_counter(event_tracker))
         return NV_ERR_INVALID_ARGUMENT;
 
+    // Counters past the end of the user counter array are ignored, as unknown
+    // counters always were for UVM_TOOLS_INIT_EVENT_TRACKER trackers.
+    counter_flags = params->counterTypeFlags & ((1ULL << event_tracker->counter.counter_count) - 1);
+
     va_space = tools_event_tracker_va_space(event_tracker);
 
     uvm_down_write(&g_tools_va_space_list_lock);
@@ -1896,8 +2238,8 @@ NV_STATUS uvm_api_tools_enable_counters(UVM_TOOLS_ENABLE_COUNTERS_PARAMS *params
 
     insert_event_tracker(va_space,
                          event_tracker->counter.counter_nodes,
-                         UVM_TOTAL_COUNTERS,
-                         params->counterTypeFlags,
+                         UVM_TOTAL_COUNTERS_EXTENDED,
+                         counter_flags,
                          &event_tracker->counter.subscribed_counters,
                          va_space->tools.counters,
                          &inserted_lists);
@@ -1907,7 +2249,7 @@ NV_STATUS uvm_api_tools_enable_counters(UVM_TOOLS_ENABLE_COUNTERS_PARAMS *params
     if (status != NV_OK) {
         remove_event_tracker(va_space,
                              event_tracker->counter.counter_nodes,
-                             UVM_TOTAL_COUNTERS,
+                             UVM_TOTAL_COUNTERS_EXTENDED,
                              inserted_lists,
                              &event_tracker->counter.subscribed_counters);
     }
@@ -1935,7 +2277,7 @@ NV_STATUS uvm_api_tools_disable_counters(UVM_TOOLS_DISABLE_COUNTERS_PARAMS *para
     uvm_down_write(&va_space->tools.lock);
     remove_event_tracker(va_space,
                          event_tracker->counter.counter_nodes,
-                         UVM_TOTAL_COUNTERS,
+                         UVM_TOTAL_COUNTERS_EXTENDED,
                          params->counterTypeFlags,
                          &event_tracker->counter.subscribed_counters);
 
@@ -2150,7 +2492,7 @@ NV_STATUS uvm_test_increment_tools_counter(UVM_TEST_INCREMENT_TOOLS_COUNTER_PARA
     NvU32 i;
     uvm_va_space_t *va_space = uvm_va_space_get(filp);
 
-    if (params->counter >= UVM_TOTAL_COUNTERS)
+    if (params->counter >= UVM_TOTAL_COUNTERS_EXTENDED)
         return NV_ERR_INVALID_ARGUMENT;
 
     uvm_down_read(&va_space->tools.lock);
@@ -2161,6 +2503,115 @@ NV_STATUS uvm_test_increment_tools_counter(UVM_TEST_INCREMENT_TOOLS_COUNTER_PARA
     return NV_OK;
 }
 
+#define UVM_TOOLS_STRESS_MAX_PRODUCERS 64
+
+typedef struct
+{
+    nv_kthread_q_t q;
+    nv_kthread_q_item_t q_item;
+    uvm_va_space_t *va_space;
+    const UvmEventEntry *entry;
+    NvU32 count;
+} tools_stress_producer_t;
+
+static void tools_stress_producer(void *args)
+{
+    tools_stress_producer_t *producer = (tools_stress_producer_t *)args;
+    NvU32 i;
+
+    uvm_down_read(&producer->va_space->tools.lock);
+    for (i = 0; i < producer->count; i++)
+        uvm_tools_record_event(producer->va_space, producer->entry);
+    uvm_up_read(&producer->va_space->tools.lock);
+}
+
+static void tools_stress_producer_entry(void *args)
+{
+    UVM_ENTRY_VOID(tools_stress_producer(args));
+}
+
+static NvU64 tools_dropped_event_count(uvm_va_space_t *va_space, NvU8 eventType)
+{
+    uvm_tools_queue_t *queue;
+    NvU64 dropped = 0;
+
+    uvm_assert_rwsem_locked(&va_space->tools.lock);
+
+    list_for_each_entry(queue, va_space->tools.queues + eventType, queue_nodes[eventType]) {
+        NvU32 i;
+
+        for (i = 0; i < queue_ring_count(queue); i++)
+            dropped += atomic64_read((atomic64_t *)&queue->control[i].dropped[eventType]);
+    }
+
+    return dropped;
+}
+
+NV_STATUS uvm_test_tools_event_queue_stress(UVM_TEST_TOOLS_EVENT_QUEUE_STRESS_PARAMS *params, struct file *filp)
+{
+    NV_STATUS status = NV_OK;
+    uvm_va_space_t *va_space = uvm_va_space_get(filp);
+    NvU8 eventType = params->entry.eventData.eventType;
+    tools_stress_producer_t *producers;
+    NvU64 dropped;
+    NvU64 start;
+    NvU32 i;
+
+    if (eventType >= UvmEventNumTypesAll)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    if (params->producerCount == 0 || params->producerCount > UVM_TOOLS_STRESS_MAX_PRODUCERS)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    producers = uvm_kvmalloc_zero(params->producerCount * sizeof(*producers));
+    if (producers == NULL)
+        return NV_ERR_NO_MEMORY;
+
+    for (i = 0; i < params->producerCount; i++) {
+        producers[i].va_space = va_space;
+        producers[i].entry = &params->entry;
+        producers[i].count = params->eventsPerProducer;
+        nv_kthread_q_item_init(&producers[i].q_item, tools_stress_producer_entry, &producers[i]);
+
+        if (nv_kthread_q_init(&producers[i].q, "uvm_tools_stress") != 0) {
+            status = NV_ERR_NO_MEMORY;
+            goto done;
+        }
+    }
+
+    // The producers take tools.lock themselves, so it must not be held while
+    // waiting for them: a queued writer would block them behind us.
+    uvm_down_read(&va_space->tools.lock);
+    dropped = tools_dropped_event_count(va_space, eventType);
+    uvm_up_read(&va_space->tools.lock);
+
+    start = NV_GETTIME();
+
+    for (i = 0; i < params->producerCount; i++)
+        nv_kthread_q_schedule_q_item(&producers[i].q, &producers[i].q_item);
+
+    for (i = 0; i < params->producerCount; i++)
+        nv_kthread_q_flush(&producers[i].q);
+
+    params->elapsedNs = NV_GETTIME() - start;
+
+    uvm_down_read(&va_space->tools.lock);
+    params->eventsDropped = tools_dropped_event_count(va_space, eventType) - dropped;
+    uvm_up_read(&va_space->tools.lock);
+
+    params->eventsRecorded = (NvU64)params->producerCount * params->eventsPerProducer;
+    params->eventsPerSec = params->eventsRecorded * (NSEC_PER_SEC / NSEC_PER_USEC) /
+                           max(params->elapsedNs / NSEC_PER_USEC, 1ULL);
+
+done:
+    for (i = 0; i < params->producerCount; i++)
+        nv_kthread_q_stop(&producers[i].q);
+
+    uvm_kvfree(producers);
+
+    return status;
+}
+
 NV_STATUS uvm_api_tools_get_processor_uuid_table(UVM_TOOLS_GET_PROCESSOR_UUID_TABLE_PARAMS *params, struct file *filp)
 {
     NvProcessorUuid *uuids;
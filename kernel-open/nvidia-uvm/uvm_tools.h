@@ -34,6 +34,7 @@
 NV_STATUS uvm_test_inject_tools_event(UVM_TEST_INJECT_TOOLS_EVENT_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_increment_tools_counter(UVM_TEST_INCREMENT_TOOLS_COUNTER_PARAMS *params, struct file *filp);
 NV_STATUS uvm_test_tools_flush_replay_events(UVM_TEST_TOOLS_FLUSH_REPLAY_EVENTS_PARAMS *params, struct file *filp);
+NV_STATUS uvm_test_tools_event_queue_stress(UVM_TEST_TOOLS_EVENT_QUEUE_STRESS_PARAMS *params, struct file *filp);
 
 NV_STATUS uvm_api_tools_read_process_memory(UVM_TOOLS_READ_PROCESS_MEMORY_PARAMS *params, struct file *filp);
 NV_STATUS uvm_api_tools_write_process_memory(UVM_TOOLS_WRITE_PROCESS_MEMORY_PARAMS *params, struct file *filp);
@@ -77,6 +78,21 @@ void uvm_tools_record_throttling_start(uvm_va_space_t *va_space, NvU64 address,
 
 void uvm_tools_record_throttling_end(uvm_va_space_t *va_space, NvU64 address, uvm_processor_id_t processor);
 
+// Account a VA block first touch by processor in the prefetch predictor
+// counters. predicted is set if the predictor made a new prediction from this
+// touch, and hit if the touch itself had been predicted.
+void uvm_tools_record_prefetch_prediction(uvm_va_space_t *va_space,
+                                          uvm_processor_id_t processor,
+                                          bool predicted,
+                                          bool hit);
+
+// Account a synchronous migration of bytes to processor that took duration_ns
+// in the migration counters
+void uvm_tools_record_migration_throughput(uvm_va_space_t *va_space,
+                                           uvm_processor_id_t processor,
+                                           NvU64 bytes,
+                                           NvU64 duration_ns);
+
 void uvm_tools_record_map_remote(uvm_va_block_t *va_block,
                                  uvm_push_t *push,
                                  uvm_processor_id_t processor,
@@ -289,7 +289,43 @@ typedef enum
     // number of faults reported on the GPU
     //
     UvmCounterNameGpuPageFaultCount = 9,
-    UVM_TOTAL_COUNTERS
+    //
+    // Size of the counter array of trackers created with
+    // UVM_TOOLS_INIT_EVENT_TRACKER. This is part of the user ABI and must not
+    // change.
+    //
+    UVM_TOTAL_COUNTERS,
+    //
+    // The counters below are only available to trackers created with
+    // UVM_TOOLS_INIT_COUNTER_TRACKER whose counter array covers them.
+    //
+    // number of VA blocks first touched by a processor while the prefetch
+    // stream predictor was active
+    //
+    UvmCounterNamePrefetchFirstTouchBlockCount = UVM_TOTAL_COUNTERS,
+    //
+    // number of next-block predictions made by the prefetch stream predictor
+    //
+    UvmCounterNamePrefetchPredictionCount = 11,
+    //
+    // number of first touches that had been predicted. Divided by
+    // UvmCounterNamePrefetchPredictionCount this gives the prediction
+    // accuracy, and divided by UvmCounterNamePrefetchFirstTouchBlockCount
+    // the prediction coverage.
+    //
+    UvmCounterNamePrefetchPredictionHitCount = 12,
+    //
+    // number of bytes that changed residency to the processor in synchronous
+    // UvmMigrate calls
+    //
+    UvmCounterNameMigrateBytes = 13,
+    //
+    // time in nanoseconds spent in the synchronous UvmMigrate calls accounted
+    // in UvmCounterNameMigrateBytes. The achieved bandwidth of a migration is
+    // the change in bytes divided by the change in time.
+    //
+    UvmCounterNameMigrateTimeNs = 14,
+    UVM_TOTAL_COUNTERS_EXTENDED
 } UvmCounterName;
 
 #define UVM_COUNTER_NAME_FLAG_BYTES_XFER_HTD 0x1
@@ -302,6 +338,11 @@ typedef enum
 #define UVM_COUNTER_NAME_FLAG_PREFETCH_BYTES_XFER_HTD 0x80
 #define UVM_COUNTER_NAME_FLAG_PREFETCH_BYTES_XFER_DTH 0x100
 #define UVM_COUNTER_NAME_FLAG_GPU_PAGE_FAULT_COUNT 0x200
+#define UVM_COUNTER_NAME_FLAG_PREFETCH_FIRST_TOUCH_BLOCK_COUNT 0x400
+#define UVM_COUNTER_NAME_FLAG_PREFETCH_PREDICTION_COUNT 0x800
+#define UVM_COUNTER_NAME_FLAG_PREFETCH_PREDICTION_HIT_COUNT 0x1000
+#define UVM_COUNTER_NAME_FLAG_MIGRATE_BYTES 0x2000
+#define UVM_COUNTER_NAME_FLAG_MIGRATE_TIME_NS 0x4000
 
 //------------------------------------------------------------------------------
 // UVM counter config structure
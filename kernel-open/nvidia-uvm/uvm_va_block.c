@@ -798,6 +798,117 @@ static void block_gpu_unmap_all_chunks_indirect_peer(uvm_va_block_t *block,
     }
 }
 
+void uvm_page_mask_compact_init(uvm_page_mask_compact_t *compact, uvm_page_mask_compact_stats_t *stats)
+{
+    memset(compact, 0, sizeof(*compact));
+
+    if (stats)
+        atomic64_inc(&stats->num_compact);
+}
+
+void uvm_page_mask_compact_deinit(uvm_page_mask_compact_t *compact, uvm_page_mask_compact_stats_t *stats)
+{
+    if (uvm_page_mask_compact_is_full(compact)) {
+        uvm_kvfree(compact->full);
+        if (stats)
+            atomic64_dec(&stats->num_full);
+    }
+    else if (stats) {
+        atomic64_dec(&stats->num_compact);
+    }
+
+    memset(compact, 0, sizeof(*compact));
+}
+
+void uvm_page_mask_compact_get(const uvm_page_mask_compact_t *compact, uvm_page_mask_t *mask_out)
+{
+    NvU8 i;
+
+    if (uvm_page_mask_compact_is_full(compact)) {
+        uvm_page_mask_copy(mask_out, compact->full);
+        return;
+    }
+
+    uvm_page_mask_zero(mask_out);
+    for (i = 0; i < compact->num_extents; i++)
+        uvm_page_mask_region_fill(mask_out, compact->extents[i]);
+}
+
+// Store the extents of mask_in in extents_out, stopping early if there are
+// more than max_extents of them. Returns the number of extents found, or
+// max_extents + 1 if they didn't fit.
+static NvU32 page_mask_get_extents(const uvm_page_mask_t *mask_in,
+                                   uvm_va_block_region_t *extents_out,
+                                   NvU32 max_extents)
+{
+    uvm_va_block_region_t region = uvm_va_block_region(0, PAGES_PER_UVM_VA_BLOCK);
+    uvm_va_block_region_t subregion;
+    NvU32 num_extents = 0;
+
+    for_each_va_block_subregion_in_mask(subregion, mask_in, region) {
+        if (num_extents == max_extents)
+            return max_extents + 1;
+
+        extents_out[num_extents++] = subregion;
+    }
+
+    return num_extents;
+}
+
+NV_STATUS uvm_page_mask_compact_reserve(uvm_page_mask_compact_t *compact, uvm_page_mask_compact_stats_t *stats)
+{
+    uvm_page_mask_t *full;
+
+    if (uvm_page_mask_compact_is_full(compact))
+        return NV_OK;
+
+    full = uvm_kvmalloc(sizeof(*full));
+    if (!full)
+        return NV_ERR_NO_MEMORY;
+
+    uvm_page_mask_compact_get(compact, full);
+    compact->full = full;
+    compact->num_extents = UVM_PAGE_MASK_COMPACT_FULL;
+
+    if (stats) {
+        atomic64_dec(&stats->num_compact);
+        atomic64_inc(&stats->num_full);
+    }
+
+    return NV_OK;
+}
+
+NV_STATUS uvm_page_mask_compact_set(uvm_page_mask_compact_t *compact,
+                                    const uvm_page_mask_t *mask_in,
+                                    uvm_page_mask_compact_stats_t *stats)
+{
+    uvm_va_block_region_t extents[UVM_PAGE_MASK_COMPACT_MAX_EXTENTS];
+    NvU32 num_extents;
+    NV_STATUS status;
+
+    num_extents = page_mask_get_extents(mask_in, extents, UVM_PAGE_MASK_COMPACT_MAX_EXTENTS);
+    if (num_extents <= UVM_PAGE_MASK_COMPACT_MAX_EXTENTS) {
+        if (uvm_page_mask_compact_is_full(compact)) {
+            uvm_kvfree(compact->full);
+            if (stats) {
+                atomic64_dec(&stats->num_full);
+                atomic64_inc(&stats->num_compact);
+            }
+        }
+
+        memcpy(compact->extents, extents, num_extents * sizeof(extents[0]));
+        compact->num_extents = num_extents;
+        return NV_OK;
+    }
+
+    status = uvm_page_mask_compact_reserve(compact, stats);
+    if (status != NV_OK)
+        return status;
+
+    uvm_page_mask_copy(compact->full, mask_in);
+    return NV_OK;
+}
+
 // Retrieves the gpu_state for the given GPU, allocating it if it doesn't exist
 static uvm_va_block_gpu_state_t *block_gpu_state_get_alloc(uvm_va_block_t *block, uvm_gpu_t *gpu)
 {
@@ -811,6 +922,8 @@ static uvm_va_block_gpu_state_t *block_gpu_state_get_alloc(uvm_va_block_t *block
     if (!gpu_state)
         return NULL;
 
+    uvm_page_mask_compact_init(&gpu_state->evicted, &gpu->va_block_evicted_masks);
+
     gpu_state->chunks = uvm_kvmalloc_zero(block_num_gpu_chunks(block, gpu) * sizeof(gpu_state->chunks[0]));
     if (!gpu_state->chunks)
         goto error;
@@ -832,6 +945,7 @@ error:
         if (gpu_state->chunks)
             uvm_kvfree(gpu_state->chunks);
         uvm_cpu_chunk_gpu_mapping_free(block, gpu->id);
+        uvm_page_mask_compact_deinit(&gpu_state->evicted, &gpu->va_block_evicted_masks);
         kmem_cache_free(g_uvm_va_block_gpu_state_cache, gpu_state);
     }
     block->gpus[uvm_id_gpu_index(gpu->id)] = NULL;
@@ -1400,12 +1514,52 @@ const uvm_page_mask_t *uvm_va_block_map_mask_get(uvm_va_block_t *block, uvm_proc
     return block_map_with_prot_mask_get(block, processor, UVM_PROT_READ_ONLY);
 }
 
-static const uvm_page_mask_t *block_evicted_mask_get(uvm_va_block_t *block, uvm_gpu_id_t gpu_id)
+static void block_evicted_mask_get(uvm_va_block_t *block, uvm_gpu_id_t gpu_id, uvm_page_mask_t *evicted_mask)
 {
     uvm_va_block_gpu_state_t *gpu_state = uvm_va_block_gpu_state_get(block, gpu_id);
     UVM_ASSERT(gpu_state);
 
-    return &gpu_state->evicted;
+    uvm_page_mask_compact_get(&gpu_state->evicted, evicted_mask);
+}
+
+// Make sure that a following block_evicted_mask_update call on the given GPU
+// can't fail.
+static NV_STATUS block_evicted_mask_reserve(uvm_va_block_t *block, uvm_gpu_id_t gpu_id)
+{
+    uvm_va_block_gpu_state_t *gpu_state = uvm_va_block_gpu_state_get(block, gpu_id);
+    UVM_ASSERT(gpu_state);
+
+    return uvm_page_mask_compact_reserve(&gpu_state->evicted, &block_get_gpu(block, gpu_id)->va_block_evicted_masks);
+}
+
+// Set or clear the given pages in the evicted mask of the GPU.
+// block_evicted_mask_reserve must have been called beforehand. Returns whether
+// any evicted pages are left.
+static bool block_evicted_mask_update(uvm_va_block_t *block,
+                                      uvm_gpu_id_t gpu_id,
+                                      const uvm_page_mask_t *page_mask,
+                                      bool evicted)
+{
+    uvm_va_block_gpu_state_t *gpu_state = uvm_va_block_gpu_state_get(block, gpu_id);
+    uvm_page_mask_t evicted_mask;
+    bool any_evicted = true;
+    NV_STATUS status;
+
+    UVM_ASSERT(gpu_state);
+    UVM_ASSERT(uvm_page_mask_compact_is_full(&gpu_state->evicted));
+
+    uvm_page_mask_compact_get(&gpu_state->evicted, &evicted_mask);
+    if (evicted)
+        uvm_page_mask_or(&evicted_mask, &evicted_mask, page_mask);
+    else
+        any_evicted = uvm_page_mask_andnot(&evicted_mask, &evicted_mask, page_mask);
+
+    status = uvm_page_mask_compact_set(&gpu_state->evicted,
+                                       &evicted_mask,
+                                       &block_get_gpu(block, gpu_id)->va_block_evicted_masks);
+    UVM_ASSERT(status == NV_OK);
+
+    return any_evicted;
 }
 
 static bool block_is_page_resident_anywhere(uvm_va_block_t *block, uvm_page_index_t page_index)
@@ -1943,6 +2097,11 @@ static NV_STATUS block_populate_gpu_chunk(uvm_va_block_t *block,
     block_retry_add_used_chunk(retry, chunk);
     gpu_state->chunks[chunk_index] = chunk;
 
+    if (gpu_state->evicted_at != 0) {
+        uvm_pmm_gpu_record_refault(&gpu->pmm, gpu_state->evicted_at);
+        gpu_state->evicted_at = 0;
+    }
+
     return NV_OK;
 
 chunk_unmap_indirect_peers:
@@ -2296,6 +2455,46 @@ static void block_mark_memory_used(uvm_va_block_t *block, uvm_processor_id_t id)
     }
 }
 
+void uvm_va_block_mark_gpu_chunks_referenced(uvm_va_block_t *va_block, const uvm_page_mask_t *page_mask)
+{
+    uvm_gpu_id_t gpu_id;
+
+    uvm_assert_mutex_locked(&va_block->lock);
+
+    for_each_gpu_id_in_mask(gpu_id, &va_block->resident) {
+        uvm_gpu_t *gpu = block_get_gpu(va_block, gpu_id);
+        uvm_va_block_gpu_state_t *gpu_state = uvm_va_block_gpu_state_get(va_block, gpu_id);
+        uvm_va_block_region_t region = uvm_va_block_region_from_block(va_block);
+        uvm_page_index_t page_index;
+
+        if (!uvm_gpu_supports_eviction(gpu))
+            continue;
+
+        // Visit each chunk once, starting from the first accessed page that
+        // it backs
+        page_index = uvm_va_block_first_page_in_mask(region, page_mask);
+        while (page_index < region.outer) {
+            uvm_chunk_size_t chunk_size;
+            size_t chunk_index = block_gpu_chunk_index(va_block, gpu, page_index, &chunk_size);
+            uvm_gpu_chunk_t *chunk = gpu_state->chunks[chunk_index];
+
+            if (!uvm_page_mask_test(&gpu_state->resident, page_index)) {
+                page_index = uvm_va_block_next_page_in_mask(region, page_mask, page_index);
+                continue;
+            }
+
+            UVM_ASSERT(chunk);
+            uvm_pmm_gpu_mark_root_chunk_referenced(&gpu->pmm, chunk);
+
+            page_index = uvm_va_block_next_page_in_mask(region,
+                                                        page_mask,
+                                                        uvm_va_block_chunk_region(va_block,
+                                                                                  chunk_size,
+                                                                                  page_index).outer - 1);
+        }
+    }
+}
+
 static void block_set_resident_processor(uvm_va_block_t *block, uvm_processor_id_t id)
 {
     UVM_ASSERT(!uvm_page_mask_empty(uvm_va_block_resident_mask_get(block, id)));
@@ -2401,6 +2600,74 @@ static uvm_va_block_region_t block_phys_contig_region(uvm_va_block_t *block,
     }
 }
 
+// A run of pages copied with a single CE operation. The run keeps growing as
+// long as the source and destination addresses of the next page follow the
+// ones of the previous page, even across chunk boundaries.
+typedef struct
+{
+    uvm_gpu_address_t src_address;
+    uvm_gpu_address_t dst_address;
+    size_t size;
+    uvm_page_index_t last_page_index;
+
+    // Number of copies pushed so far. All but the first one are pipelined.
+    NvU32 num_copies;
+} block_copy_run_t;
+
+static bool block_copy_run_try_extend(block_copy_run_t *run,
+                                      uvm_page_index_t page_index,
+                                      uvm_gpu_address_t src_address,
+                                      uvm_gpu_address_t dst_address)
+{
+    uvm_gpu_address_t next_src_address = run->src_address;
+    uvm_gpu_address_t next_dst_address = run->dst_address;
+
+    if (run->size == 0 || page_index != run->last_page_index + 1)
+        return false;
+
+    next_src_address.address += run->size;
+    next_dst_address.address += run->size;
+
+    if (uvm_gpu_addr_cmp(src_address, next_src_address) != 0 || uvm_gpu_addr_cmp(dst_address, next_dst_address) != 0)
+        return false;
+
+    run->size += PAGE_SIZE;
+    run->last_page_index = page_index;
+
+    return true;
+}
+
+static void block_copy_run_push(block_copy_run_t *run, uvm_push_t *push)
+{
+    uvm_gpu_t *copying_gpu = uvm_push_get_gpu(push);
+
+    if (run->size == 0)
+        return;
+
+    // Pipeline the copies since they never overlap with each other
+    if (run->num_copies++ > 0)
+        uvm_push_set_flag(push, UVM_PUSH_FLAG_CE_NEXT_PIPELINED);
+
+    // A single membar is pushed at the end of the push for all copies
+    uvm_push_set_flag(push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
+    copying_gpu->parent->ce_hal->memcopy(push, run->dst_address, run->src_address, run->size);
+
+    run->size = 0;
+}
+
+static void block_copy_run_start(block_copy_run_t *run,
+                                 uvm_page_index_t page_index,
+                                 uvm_gpu_address_t src_address,
+                                 uvm_gpu_address_t dst_address)
+{
+    UVM_ASSERT(run->size == 0);
+
+    run->src_address = src_address;
+    run->dst_address = dst_address;
+    run->size = PAGE_SIZE;
+    run->last_page_index = page_index;
+}
+
 // Copies pages resident on the src_id processor to the dst_id processor
 //
 // The function adds the pages that were successfully copied to the output
@@ -2440,6 +2707,7 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
     const bool is_dst_phys_contig = is_block_phys_contig(block, dst_id);
     uvm_gpu_address_t contig_src_address = {0};
     uvm_gpu_address_t contig_dst_address = {0};
+    block_copy_run_t copy_run = {0};
     uvm_va_range_t *va_range = block->va_range;
     uvm_va_space_t *va_space = uvm_va_block_get_va_space(block);
     const uvm_va_block_transfer_mode_t block_transfer_mode = get_block_transfer_mode_from_internal(transfer_mode);
@@ -2458,6 +2726,16 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
     if (!uvm_page_mask_andnot(copy_mask, copy_mask, dst_resident_mask))
         return NV_OK;
 
+    // The evicted pages are updated after the copy, when it's too late to fail.
+    // Reserve the space needed by the update upfront.
+    if (cause == UVM_MAKE_RESIDENT_CAUSE_EVICTION)
+        status = block_evicted_mask_reserve(block, src_id);
+    else if (UVM_ID_IS_GPU(dst_id) && uvm_processor_mask_test(&block->evicted_gpus, dst_id))
+        status = block_evicted_mask_reserve(block, dst_id);
+
+    if (status != NV_OK)
+        return status;
+
     // uvm_range_group_range_iter_first should only be called when the va_space
     // lock is held, which is always the case unless an eviction is taking
     // place.
@@ -2473,6 +2751,8 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
         uvm_make_resident_cause_t page_cause = (may_prefetch && uvm_page_mask_test(prefetch_page_mask, page_index))?
                                                 UVM_MAKE_RESIDENT_CAUSE_PREFETCH:
                                                 cause;
+        uvm_gpu_address_t src_address;
+        uvm_gpu_address_t dst_address;
 
         UVM_ASSERT(block_check_resident_proximity(block, page_index, dst_id));
 
@@ -2548,9 +2828,6 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
             // of contig_cause
             uvm_tools_record_block_migration_begin(block, &push, dst_id, src_id, page_start, cause);
         }
-        else {
-            uvm_push_set_flag(&push, UVM_PUSH_FLAG_CE_NEXT_PIPELINED);
-        }
 
         block_update_page_dirty_state(block, dst_id, src_id, page_index);
 
@@ -2573,23 +2850,10 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
             size_t contig_region_size = uvm_va_block_region_size(contig_region);
             UVM_ASSERT(uvm_va_block_region_contains_region(region, contig_region));
 
-            // If both src and dst are physically-contiguous, consolidate copies
-            // of contiguous pages into a single method.
-            if (is_src_phys_contig && is_dst_phys_contig) {
-                uvm_gpu_address_t src_address = contig_src_address;
-                uvm_gpu_address_t dst_address = contig_dst_address;
-
-                src_address.address += contig_start_index * PAGE_SIZE;
-                dst_address.address += contig_start_index * PAGE_SIZE;
-
-                uvm_push_set_flag(&push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
-
-
-
-
-
-                copying_gpu->parent->ce_hal->memcopy(&push, dst_address, src_address, contig_region_size);
-            }
+            // The pending copy run may cover the notified region, and listeners
+            // expect its copy to be in the push already. This also keeps runs
+            // from spanning regions with different causes.
+            block_copy_run_push(&copy_run, &push);
 
             uvm_perf_event_notify_migration(&va_space->perf_events,
                                             &push,
@@ -2606,33 +2870,30 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
             contig_cause = page_cause;
         }
 
-        if (is_src_phys_contig)
+        if (is_src_phys_contig) {
             UVM_ASSERT(block_phys_copy_contig_check(block, page_index, &contig_src_address, src_id, copying_gpu));
-        if (is_dst_phys_contig)
-            UVM_ASSERT(block_phys_copy_contig_check(block, page_index, &contig_dst_address, dst_id, copying_gpu));
-
-        if (!is_src_phys_contig || !is_dst_phys_contig) {
-            uvm_gpu_address_t src_address;
-            uvm_gpu_address_t dst_address;
-
-            if (is_src_phys_contig) {
-                src_address = contig_src_address;
-                src_address.address += page_index * PAGE_SIZE;
-            }
-            else {
-                src_address = block_phys_page_copy_address(block, block_phys_page(src_id, page_index), copying_gpu);
-            }
+            src_address = contig_src_address;
+            src_address.address += page_index * PAGE_SIZE;
+        }
+        else {
+            src_address = block_phys_page_copy_address(block, block_phys_page(src_id, page_index), copying_gpu);
+        }
 
-            if (is_dst_phys_contig) {
-                dst_address = contig_dst_address;
-                dst_address.address += page_index * PAGE_SIZE;
-            }
-            else {
-                dst_address = block_phys_page_copy_address(block, block_phys_page(dst_id, page_index), copying_gpu);
-            }
+        if (is_dst_phys_contig) {
+            UVM_ASSERT(block_phys_copy_contig_check(block, page_index, &contig_dst_address, dst_id, copying_gpu));
+            dst_address = contig_dst_address;
+            dst_address.address += page_index * PAGE_SIZE;
+        }
+        else {
+            dst_address = block_phys_page_copy_address(block, block_phys_page(dst_id, page_index), copying_gpu);
+        }
 
-            uvm_push_set_flag(&push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
-            copying_gpu->parent->ce_hal->memcopy(&push, dst_address, src_address, PAGE_SIZE);
+        // Consolidate copies of pages whose source and destination are both
+        // physically contiguous into a single method, also when only parts of
+        // the block storage are contiguous.
+        if (!block_copy_run_try_extend(&copy_run, page_index, src_address, dst_address)) {
+            block_copy_run_push(&copy_run, &push);
+            block_copy_run_start(&copy_run, page_index, src_address, dst_address);
         }
 
         last_index = page_index;
@@ -2644,16 +2905,7 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
         size_t contig_region_size = uvm_va_block_region_size(contig_region);
         UVM_ASSERT(uvm_va_block_region_contains_region(region, contig_region));
 
-        if (is_src_phys_contig && is_dst_phys_contig) {
-            uvm_gpu_address_t src_address = contig_src_address;
-            uvm_gpu_address_t dst_address = contig_dst_address;
-
-            src_address.address += contig_start_index * PAGE_SIZE;
-            dst_address.address += contig_start_index * PAGE_SIZE;
-
-            uvm_push_set_flag(&push, UVM_PUSH_FLAG_NEXT_MEMBAR_NONE);
-            copying_gpu->parent->ce_hal->memcopy(&push, dst_address, src_address, contig_region_size);
-        }
+        block_copy_run_push(&copy_run, &push);
 
         uvm_perf_event_notify_migration(&va_space->perf_events,
                                         &push,
@@ -2723,14 +2975,11 @@ static NV_STATUS block_copy_resident_pages_between(uvm_va_block_t *block,
             UVM_ASSERT(src_gpu_state);
             UVM_ASSERT(UVM_ID_IS_CPU(dst_id));
 
-            uvm_page_mask_or(&src_gpu_state->evicted, &src_gpu_state->evicted, copy_mask);
+            block_evicted_mask_update(block, src_id, copy_mask, true);
             uvm_processor_mask_set(&block->evicted_gpus, src_id);
         }
         else if (UVM_ID_IS_GPU(dst_id) && uvm_processor_mask_test(&block->evicted_gpus, dst_id)) {
-            uvm_va_block_gpu_state_t *dst_gpu_state = uvm_va_block_gpu_state_get(block, dst_id);
-            UVM_ASSERT(dst_gpu_state);
-
-            if (!uvm_page_mask_andnot(&dst_gpu_state->evicted, &dst_gpu_state->evicted, copy_mask))
+            if (!block_evicted_mask_update(block, dst_id, copy_mask, false))
                 uvm_processor_mask_clear(&block->evicted_gpus, dst_id);
         }
     }
@@ -3869,11 +4118,13 @@ static bool block_check_mappings(uvm_va_block_t *block)
         UVM_ASSERT(uvm_processor_mask_test(&block->mapped, id) == !uvm_page_mask_empty(map_mask));
 
         if (UVM_ID_IS_GPU(id)) {
-            const uvm_page_mask_t *evicted_mask = block_evicted_mask_get(block, id);
-            UVM_ASSERT(uvm_processor_mask_test(&block->evicted_gpus, id) == !uvm_page_mask_empty(evicted_mask));
+            uvm_page_mask_t evicted_mask;
+
+            block_evicted_mask_get(block, id, &evicted_mask);
+            UVM_ASSERT(uvm_processor_mask_test(&block->evicted_gpus, id) == !uvm_page_mask_empty(&evicted_mask));
 
             // Pages cannot be resident if they are marked as evicted
-            UVM_ASSERT(!uvm_page_mask_intersects(evicted_mask, resident_mask));
+            UVM_ASSERT(!uvm_page_mask_intersects(&evicted_mask, resident_mask));
 
             // Pages cannot be resident on a GPU with no memory
             if (!block_processor_has_memory(block, id))
@@ -6938,6 +7189,7 @@ static void block_destroy_gpu_state(uvm_va_block_t *block, uvm_gpu_id_t id)
     uvm_cpu_chunk_gpu_mapping_free(block, gpu->id);
     uvm_processor_mask_clear(&block->evicted_gpus, id);
 
+    uvm_page_mask_compact_deinit(&gpu_state->evicted, &gpu->va_block_evicted_masks);
     kmem_cache_free(g_uvm_va_block_gpu_state_cache, gpu_state);
     block->gpus[uvm_id_gpu_index(id)] = NULL;
 }
@@ -7746,6 +7998,7 @@ static NV_STATUS block_split_preallocate_no_retry(uvm_va_block_t *existing, uvm_
 {
     NV_STATUS status;
     uvm_gpu_t *gpu;
+    uvm_va_block_gpu_state_t *new_gpu_state;
     uvm_gpu_id_t id;
     uvm_page_index_t split_page_index;
     uvm_va_range_t *existing_va_range = existing->va_range;
@@ -7764,10 +8017,18 @@ static NV_STATUS block_split_preallocate_no_retry(uvm_va_block_t *existing, uvm_
         if (status != NV_OK)
             goto error;
 
-        if (!block_gpu_state_get_alloc(new, gpu)) {
+        new_gpu_state = block_gpu_state_get_alloc(new, gpu);
+        if (!new_gpu_state) {
             status = NV_ERR_NO_MEMORY;
             goto error;
         }
+
+        // See block_split_evicted_mask
+        if (uvm_page_mask_compact_is_full(&uvm_va_block_gpu_state_get(existing, id)->evicted)) {
+            status = uvm_page_mask_compact_reserve(&new_gpu_state->evicted, &gpu->va_block_evicted_masks);
+            if (status != NV_OK)
+                goto error;
+        }
     }
 
     if (existing_va_range && existing_va_range->inject_split_error) {
@@ -7870,7 +8131,7 @@ static void block_set_processor_masks(uvm_va_block_t *block)
         else
             block_set_resident_processor(block, id);
 
-        if (uvm_page_mask_region_empty(&gpu_state->evicted, block_region))
+        if (uvm_page_mask_compact_empty(&gpu_state->evicted))
             uvm_processor_mask_clear(&block->evicted_gpus, id);
         else
             uvm_processor_mask_set(&block->evicted_gpus, id);
@@ -7896,6 +8157,35 @@ static void block_split_page_mask(uvm_page_mask_t *existing_mask,
     uvm_page_mask_region_clear(existing_mask, uvm_va_block_region(existing_pages, existing_pages + new_pages));
 }
 
+// Split the evicted mask of the given GPU. This can't fail since any full
+// masks that may be needed were reserved by block_split_preallocate_no_retry.
+static void block_split_evicted_mask(uvm_va_block_t *existing,
+                                     uvm_va_block_t *new,
+                                     uvm_gpu_t *gpu,
+                                     size_t existing_pages,
+                                     size_t new_pages)
+{
+    uvm_va_block_gpu_state_t *existing_gpu_state = uvm_va_block_gpu_state_get(existing, gpu->id);
+    uvm_va_block_gpu_state_t *new_gpu_state = uvm_va_block_gpu_state_get(new, gpu->id);
+    uvm_page_mask_t existing_mask;
+    uvm_page_mask_t new_mask;
+    NV_STATUS status;
+
+    // The extents of each half are a subset of the extents of existing, so
+    // only a full existing mask may need full masks after the split.
+    UVM_ASSERT(!uvm_page_mask_compact_is_full(&existing_gpu_state->evicted) ||
+               uvm_page_mask_compact_is_full(&new_gpu_state->evicted));
+
+    uvm_page_mask_compact_get(&existing_gpu_state->evicted, &existing_mask);
+    block_split_page_mask(&existing_mask, existing_pages, &new_mask, new_pages);
+
+    status = uvm_page_mask_compact_set(&existing_gpu_state->evicted, &existing_mask, &gpu->va_block_evicted_masks);
+    UVM_ASSERT(status == NV_OK);
+
+    status = uvm_page_mask_compact_set(&new_gpu_state->evicted, &new_mask, &gpu->va_block_evicted_masks);
+    UVM_ASSERT(status == NV_OK);
+}
+
 // Split the CPU state within the existing block. existing's start is correct
 // but its end has not yet been adjusted.
 static void block_split_cpu(uvm_va_block_t *existing, uvm_va_block_t *new)
@@ -8211,7 +8501,7 @@ static void block_split_gpu(uvm_va_block_t *existing, uvm_va_block_t *new, uvm_g
         existing_gpu_state->activated_4k = false;
     }
 
-    block_split_page_mask(&existing_gpu_state->evicted, existing_pages, &new_gpu_state->evicted, new_pages);
+    block_split_evicted_mask(existing, new, gpu, existing_pages, new_pages);
 }
 
 NV_STATUS uvm_va_block_split(uvm_va_block_t *existing_va_block,
@@ -9194,6 +9484,11 @@ NV_STATUS uvm_va_block_service_locked(uvm_processor_id_t processor_id,
             // an ECC check before establishing the CPU mappings.
             uvm_processor_mask_copy(&processors_involved_in_cpu_migration, all_involved_processors);
         }
+        else {
+            // The serviced pages are now resident on the GPU and about to be
+            // accessed, so keep their chunks away from eviction
+            uvm_va_block_mark_gpu_chunks_referenced(va_block, new_residency_mask);
+        }
 
         if (UVM_ID_IS_CPU(processor_id) && !uvm_processor_mask_empty(all_involved_processors))
             service_context->cpu_fault.did_migrate = true;
@@ -9704,11 +9999,26 @@ NV_STATUS uvm_va_block_find_create(uvm_va_space_t *va_space,
                                    NvU64 addr,
                                    uvm_va_block_context_t *va_block_context,
                                    uvm_va_block_t **out_block)
+{
+    uvm_va_range_t *va_range_hint = NULL;
+
+    return uvm_va_block_find_create_hint(va_space, mm, addr, va_block_context, &va_range_hint, out_block);
+}
+
+NV_STATUS uvm_va_block_find_create_hint(uvm_va_space_t *va_space,
+                                        struct mm_struct *mm,
+                                        NvU64 addr,
+                                        uvm_va_block_context_t *va_block_context,
+                                        uvm_va_range_t **va_range_hint,
+                                        uvm_va_block_t **out_block)
 {
     uvm_va_range_t *va_range;
     size_t index;
 
-    va_range = uvm_va_range_find(va_space, addr);
+    va_range = uvm_va_range_find_hint(va_space, *va_range_hint, addr);
+    if (va_range)
+        *va_range_hint = va_range;
+
     if (!va_range) {
         if (!mm)
             return NV_ERR_INVALID_ADDRESS;
@@ -9862,6 +10172,23 @@ NV_STATUS uvm_va_block_read_to_cpu(uvm_va_block_t *va_block, uvm_mem_t *dst_mem,
     return uvm_push_end_and_wait(&push);
 }
 
+// Add remote mappings from the given GPU to the pages evicted from it
+static NV_STATUS block_add_eviction_mappings(uvm_va_block_t *va_block,
+                                             uvm_va_block_context_t *block_context,
+                                             uvm_gpu_id_t gpu_id)
+{
+    uvm_page_mask_t *evicted_mask = &block_context->caller_page_mask;
+
+    block_evicted_mask_get(va_block, gpu_id, evicted_mask);
+
+    return uvm_va_block_add_mappings(va_block,
+                                     block_context,
+                                     gpu_id,
+                                     uvm_va_block_region_from_block(va_block),
+                                     evicted_mask,
+                                     UvmEventMapRemoteCauseEviction);
+}
+
 // Deferred work item reestablishing accessed by mappings after eviction. On
 // GPUs with access counters enabled, the evicted GPU will also get remote
 // mappings.
@@ -9923,24 +10250,16 @@ static void block_deferred_eviction_mappings(void *args)
 
             for_each_gpu_id_in_mask(id, &map_processors) {
                 uvm_gpu_t *gpu = uvm_va_space_get_gpu(va_space, id);
-                uvm_va_block_gpu_state_t *gpu_state;
 
                 if (!gpu->parent->access_counters_supported)
                     continue;
 
-                gpu_state = uvm_va_block_gpu_state_get(va_block, id);
-                UVM_ASSERT(gpu_state);
-
                 // TODO: Bug 2096389: uvm_va_block_add_mappings does not add
                 // remote mappings to read-duplicated pages. Add support for it
                 // or create a new function.
-                status = UVM_VA_BLOCK_LOCK_RETRY(va_block, NULL,
-                                                 uvm_va_block_add_mappings(va_block,
-                                                                           block_context,
-                                                                           id,
-                                                                           uvm_va_block_region_from_block(va_block),
-                                                                           &gpu_state->evicted,
-                                                                           UvmEventMapRemoteCauseEviction));
+                status = UVM_VA_BLOCK_LOCK_RETRY(va_block,
+                                                 NULL,
+                                                 block_add_eviction_mappings(va_block, block_context, id));
                 if (status != NV_OK)
                     break;
             }
@@ -10149,6 +10468,7 @@ NV_STATUS uvm_va_block_evict_chunks(uvm_va_block_t *va_block,
 
         uvm_pmm_gpu_mark_chunk_evicted(&gpu->pmm, gpu_state->chunks[i]);
         gpu_state->chunks[i] = NULL;
+        gpu_state->evicted_at = uvm_pmm_gpu_eviction_clock(&gpu->pmm);
     }
 
 out:
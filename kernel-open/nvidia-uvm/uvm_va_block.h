@@ -107,8 +107,10 @@ typedef struct
     // physical GPU memory is tracked by an array of GPU chunks below.
     uvm_page_mask_t resident;
 
-    // Pages that have been evicted to sysmem
-    uvm_page_mask_t evicted;
+    // Pages that have been evicted to sysmem. Most blocks are never evicted,
+    // or get evicted in a few contiguous runs, so this is stored as a compact
+    // mask.
+    uvm_page_mask_compact_t evicted;
 
     NvU64 *cpu_chunks_dma_addrs;
 
@@ -164,6 +166,11 @@ typedef struct
     // could lead to wrong fault attribution.
     bool force_4k_ptes;
 
+    // PMM eviction clock at the time chunks of this block were last evicted
+    // from this GPU, or 0 if no eviction is pending a refault. Used to report
+    // refault distances to PMM. See uvm_pmm_gpu_record_refault().
+    NvU64 evicted_at;
+
     // This table shows the HW PTE states given all permutations of pte_is_2m,
     // big_ptes, and pte_bits. Note that the first row assumes that the 4k page
     // tables have been allocated (if not, then no PDEs are allocated either).
@@ -636,6 +643,7 @@ static void uvm_va_block_context_init(uvm_va_block_context_t *va_block_context,
         memset(va_block_context, 0xff, sizeof(*va_block_context));
 
     va_block_context->mm = mm;
+    va_block_context->migrated_bytes = 0;
 }
 
 // TODO: Bug 1766480: Using only page masks instead of a combination of regions
@@ -1199,6 +1207,17 @@ NV_STATUS uvm_va_block_find_create(uvm_va_space_t *va_space,
                                    uvm_va_block_context_t *va_block_context,
                                    uvm_va_block_t **out_block);
 
+// Same as uvm_va_block_find_create, but the VA range lookup starts from
+// *va_range_hint, which is updated to the VA range containing addr, or left
+// unmodified if there is none. See uvm_va_range_find_hint. *va_range_hint may
+// be NULL, and must be reset to NULL whenever the VA space lock is dropped.
+NV_STATUS uvm_va_block_find_create_hint(uvm_va_space_t *va_space,
+                                        struct mm_struct *mm,
+                                        NvU64 addr,
+                                        uvm_va_block_context_t *va_block_context,
+                                        uvm_va_range_t **va_range_hint,
+                                        uvm_va_block_t **out_block);
+
 // Same as uvm_va_block_find_create except that only UVM managed va_blocks are
 // created if not already present in the VA range.
 static NV_STATUS uvm_va_block_find_create_managed(uvm_va_space_t *va_space,
@@ -1227,7 +1246,8 @@ typedef enum
 // The caller needs to handle allocation-retry. va_block_retry can be NULL if
 // the destination is the CPU.
 //
-// va_block_context must not be NULL.
+// va_block_context must not be NULL. The number of bytes that changed
+// residency is added to va_block_context->migrated_bytes.
 //
 // LOCKING: The caller must hold the va_block lock. If va_block_context->mm !=
 //          NULL, va_block_context->mm->mmap_lock must be held in at least
@@ -1268,6 +1288,13 @@ void uvm_va_block_retry_init(uvm_va_block_retry_t *uvm_va_block_retry);
 // Frees all the remaining free chunks and unpins all the used chunks.
 void uvm_va_block_retry_deinit(uvm_va_block_retry_t *uvm_va_block_retry, uvm_va_block_t *va_block);
 
+// Let PMM know that the GPU chunks backing the given pages of the block were
+// accessed, so that the eviction policy favors evicting other root chunks. Only
+// the GPUs the pages are resident on are considered.
+//
+// LOCKING: The caller must hold the va_block lock
+void uvm_va_block_mark_gpu_chunks_referenced(uvm_va_block_t *va_block, const uvm_page_mask_t *page_mask);
+
 // Evict all chunks from the block that are subchunks of the passed in root_chunk.
 //
 // Add all the work tracking the eviction to the tracker.
@@ -1710,6 +1737,48 @@ static NvU64 uvm_reverse_map_end(const uvm_reverse_map_t *reverse_map)
 #define for_each_va_block_page(page_index, va_block)                                         \
     for_each_va_block_page_in_region((page_index), uvm_va_block_region_from_block(va_block))
 
+// Compact page masks. See uvm_page_mask_compact_t.
+//
+// The stats pointer passed to the functions updating a mask may be NULL. When
+// provided, it must be the same for the whole lifetime of the mask.
+
+// Initialize an empty compact mask
+void uvm_page_mask_compact_init(uvm_page_mask_compact_t *compact, uvm_page_mask_compact_stats_t *stats);
+
+// Free the full mask, if any
+void uvm_page_mask_compact_deinit(uvm_page_mask_compact_t *compact, uvm_page_mask_compact_stats_t *stats);
+
+// Expand the compact mask into mask_out
+void uvm_page_mask_compact_get(const uvm_page_mask_compact_t *compact, uvm_page_mask_t *mask_out);
+
+// Replace the contents of the compact mask with mask_in, promoting or demoting
+// the representation as needed.
+//
+// Returns NV_ERR_NO_MEMORY if a promotion was needed and the full mask could
+// not be allocated, in which case the compact mask is left unmodified. This
+// can't fail if uvm_page_mask_compact_reserve has been called beforehand.
+NV_STATUS uvm_page_mask_compact_set(uvm_page_mask_compact_t *compact,
+                                    const uvm_page_mask_t *mask_in,
+                                    uvm_page_mask_compact_stats_t *stats);
+
+// Promote the compact mask to a full mask ahead of an update which must not
+// fail. A following uvm_page_mask_compact_set call will demote it again if the
+// new contents are sparse.
+NV_STATUS uvm_page_mask_compact_reserve(uvm_page_mask_compact_t *compact, uvm_page_mask_compact_stats_t *stats);
+
+static bool uvm_page_mask_compact_is_full(const uvm_page_mask_compact_t *compact)
+{
+    return compact->num_extents == UVM_PAGE_MASK_COMPACT_FULL;
+}
+
+static bool uvm_page_mask_compact_empty(const uvm_page_mask_compact_t *compact)
+{
+    if (uvm_page_mask_compact_is_full(compact))
+        return uvm_page_mask_empty(compact->full);
+
+    return compact->num_extents == 0;
+}
+
 static void uvm_va_block_bitmap_tree_init_from_page_count(uvm_va_block_bitmap_tree_t *bitmap_tree, size_t page_count)
 {
     bitmap_tree->leaf_count  = page_count;
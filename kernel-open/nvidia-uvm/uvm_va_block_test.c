@@ -95,12 +95,102 @@ static NV_STATUS test_chunk_index(uvm_gpu_t *gpu)
     return NV_OK;
 }
 
+static bool page_mask_compact_matches(const uvm_page_mask_compact_t *compact, const uvm_page_mask_t *mask)
+{
+    uvm_page_mask_t compact_mask;
+
+    uvm_page_mask_compact_get(compact, &compact_mask);
+
+    return uvm_page_mask_subset(&compact_mask, mask) && uvm_page_mask_subset(mask, &compact_mask);
+}
+
+static NV_STATUS test_page_mask_compact(void)
+{
+    uvm_page_mask_compact_stats_t stats;
+    uvm_page_mask_compact_t compact;
+    uvm_page_mask_t mask;
+    NvU32 i;
+    NV_STATUS status = NV_OK;
+
+    atomic64_set(&stats.num_compact, 0);
+    atomic64_set(&stats.num_full, 0);
+
+    uvm_page_mask_compact_init(&compact, &stats);
+    TEST_CHECK_GOTO(uvm_page_mask_compact_empty(&compact), done);
+    TEST_CHECK_GOTO(!uvm_page_mask_compact_is_full(&compact), done);
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_compact) == 1, done);
+
+    // Add disjoint extents one at a time. The mask is promoted once there are
+    // more extents than fit inline.
+    uvm_page_mask_zero(&mask);
+    for (i = 0; i <= UVM_PAGE_MASK_COMPACT_MAX_EXTENTS; i++) {
+        uvm_page_mask_region_fill(&mask, uvm_va_block_region(3 * i, 3 * i + 2));
+        TEST_NV_CHECK_GOTO(uvm_page_mask_compact_set(&compact, &mask, &stats), done);
+        TEST_CHECK_GOTO(page_mask_compact_matches(&compact, &mask), done);
+        TEST_CHECK_GOTO(uvm_page_mask_compact_is_full(&compact) == (i == UVM_PAGE_MASK_COMPACT_MAX_EXTENTS), done);
+        TEST_CHECK_GOTO(!uvm_page_mask_compact_empty(&compact), done);
+    }
+
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_compact) == 0, done);
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_full) == 1, done);
+
+    // Joining the extents demotes the mask
+    uvm_page_mask_region_fill(&mask, uvm_va_block_region(0, PAGES_PER_UVM_VA_BLOCK));
+    TEST_NV_CHECK_GOTO(uvm_page_mask_compact_set(&compact, &mask, &stats), done);
+    TEST_CHECK_GOTO(!uvm_page_mask_compact_is_full(&compact), done);
+    TEST_CHECK_GOTO(page_mask_compact_matches(&compact, &mask), done);
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_compact) == 1, done);
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_full) == 0, done);
+
+    // Extents touching both ends of the block
+    uvm_page_mask_zero(&mask);
+    uvm_page_mask_set(&mask, 0);
+    uvm_page_mask_set(&mask, PAGES_PER_UVM_VA_BLOCK - 1);
+    TEST_NV_CHECK_GOTO(uvm_page_mask_compact_set(&compact, &mask, &stats), done);
+    TEST_CHECK_GOTO(!uvm_page_mask_compact_is_full(&compact), done);
+    TEST_CHECK_GOTO(page_mask_compact_matches(&compact, &mask), done);
+
+    // Reserving promotes the mask without changing its contents, and the next
+    // update demotes it again.
+    TEST_NV_CHECK_GOTO(uvm_page_mask_compact_reserve(&compact, &stats), done);
+    TEST_CHECK_GOTO(uvm_page_mask_compact_is_full(&compact), done);
+    TEST_CHECK_GOTO(page_mask_compact_matches(&compact, &mask), done);
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_full) == 1, done);
+
+    uvm_page_mask_zero(&mask);
+    TEST_NV_CHECK_GOTO(uvm_page_mask_compact_set(&compact, &mask, &stats), done);
+    TEST_CHECK_GOTO(!uvm_page_mask_compact_is_full(&compact), done);
+    TEST_CHECK_GOTO(uvm_page_mask_compact_empty(&compact), done);
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_compact) == 1, done);
+    TEST_CHECK_GOTO(atomic64_read(&stats.num_full) == 0, done);
+
+    // Every other page set is the worst case for extents
+    for (i = 0; i < PAGES_PER_UVM_VA_BLOCK; i += 2)
+        uvm_page_mask_set(&mask, i);
+
+    TEST_NV_CHECK_GOTO(uvm_page_mask_compact_set(&compact, &mask, &stats), done);
+    TEST_CHECK_GOTO(uvm_page_mask_compact_is_full(&compact), done);
+    TEST_CHECK_GOTO(page_mask_compact_matches(&compact, &mask), done);
+
+done:
+    uvm_page_mask_compact_deinit(&compact, &stats);
+
+    if (status == NV_OK) {
+        TEST_CHECK_RET(atomic64_read(&stats.num_compact) == 0);
+        TEST_CHECK_RET(atomic64_read(&stats.num_full) == 0);
+    }
+
+    return status;
+}
+
 NV_STATUS uvm_test_va_block(UVM_TEST_VA_BLOCK_PARAMS *params, struct file *filp)
 {
     uvm_va_space_t *va_space = uvm_va_space_get(filp);
     uvm_gpu_t *gpu;
     NV_STATUS status = NV_OK;
 
+    TEST_NV_CHECK_RET(test_page_mask_compact());
+
     uvm_va_space_down_read(va_space);
 
     for_each_va_space_gpu(gpu, va_space)
@@ -75,6 +75,39 @@ typedef struct
     DECLARE_BITMAP(bitmap, PAGES_PER_UVM_VA_BLOCK);
 } uvm_page_mask_t;
 
+#define UVM_PAGE_MASK_COMPACT_MAX_EXTENTS 4
+
+// num_extents value of a compact mask which has been promoted to a full mask
+#define UVM_PAGE_MASK_COMPACT_FULL        NV_U8_MAX
+
+// Space-efficient page mask for state which is empty or made of a few
+// contiguous runs of pages in most blocks. Up to
+// UVM_PAGE_MASK_COMPACT_MAX_EXTENTS sorted, disjoint and non-adjacent extents
+// are stored inline. Masks needing more extents are promoted to a separately
+// allocated uvm_page_mask_t, and demoted back once they fit inline again.
+//
+// Use the uvm_page_mask_compact_* functions to access these masks.
+typedef struct
+{
+    union
+    {
+        uvm_va_block_region_t extents[UVM_PAGE_MASK_COMPACT_MAX_EXTENTS];
+
+        uvm_page_mask_t *full;
+    };
+
+    // Number of valid entries in extents, or UVM_PAGE_MASK_COMPACT_FULL
+    NvU8 num_extents;
+} uvm_page_mask_compact_t;
+
+// Counts of compact masks in each representation.
+typedef struct
+{
+    atomic64_t num_compact;
+
+    atomic64_t num_full;
+} uvm_page_mask_compact_stats_t;
+
 // Encapsulates a counter tree built on top of a page mask bitmap in
 // which each leaf represents a page in the block. It contains
 // leaf_count and level_count so that it can use some macros for
@@ -254,6 +287,11 @@ typedef struct
 
     uvm_va_policy_t *policy;
 
+    // Number of bytes that changed residency in the
+    // uvm_va_block_migrate_locked() calls made with this context. Reset by
+    // uvm_va_block_context_init().
+    NvU64 migrated_bytes;
+
 
 #if UVM_IS_CONFIG_HMM()
     struct
@@ -1209,6 +1209,16 @@ uvm_va_range_t *uvm_va_range_find(uvm_va_space_t *va_space, NvU64 addr)
     return uvm_va_range_container(uvm_range_tree_find(&va_space->va_range_tree, addr));
 }
 
+uvm_va_range_t *uvm_va_range_find_hint(uvm_va_space_t *va_space, uvm_va_range_t *hint, NvU64 addr)
+{
+    uvm_assert_rwsem_locked(&va_space->lock);
+    UVM_ASSERT(!hint || hint->va_space == va_space);
+
+    return uvm_va_range_container(uvm_range_tree_find_hint(&va_space->va_range_tree,
+                                                           hint ? &hint->node : NULL,
+                                                           addr));
+}
+
 uvm_va_range_t *uvm_va_space_iter_first(uvm_va_space_t *va_space, NvU64 start, NvU64 end)
 {
     uvm_range_tree_node_t *node = uvm_range_tree_iter_first(&va_space->va_range_tree, start, end);
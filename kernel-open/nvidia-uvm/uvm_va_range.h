@@ -540,6 +540,11 @@ NV_STATUS uvm_va_range_split(uvm_va_range_t *existing_va_range,
 // Returns the va_range containing addr, if any
 uvm_va_range_t *uvm_va_range_find(uvm_va_space_t *va_space, NvU64 addr);
 
+// Same as uvm_va_range_find, but starts the search from hint. See
+// uvm_range_tree_find_hint. hint may be NULL. The VA space lock must have been
+// held since hint was looked up.
+uvm_va_range_t *uvm_va_range_find_hint(uvm_va_space_t *va_space, uvm_va_range_t *hint, NvU64 addr);
+
 static uvm_ext_gpu_map_t *uvm_ext_gpu_map_container(uvm_range_tree_node_t *node)
 {
     if (!node)
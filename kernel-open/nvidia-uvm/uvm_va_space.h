@@ -316,7 +316,7 @@ struct uvm_va_space_struct
         uvm_rw_semaphore_t lock;
 
         // Lists of counters listening for events on this VA space
-        struct list_head counters[UVM_TOTAL_COUNTERS];
+        struct list_head counters[UVM_TOTAL_COUNTERS_EXTENDED];
         struct list_head queues[UvmEventNumTypesAll];
 
         // Node for this va_space in global subscribers list
@@ -241,6 +241,146 @@ nv_procfs_read_power(
 
 NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(power);
 
+static int
+nv_procfs_read_rpc_profile(
+    struct seq_file *s,
+    void *v
+)
+{
+    nv_state_t *nv = s->private;
+    nvidia_stack_t *sp = NULL;
+    nv_rpc_profile_entry_t *entries;
+    NvU32 function = 0;
+    NvU32 count, i;
+    NV_STATUS status;
+
+    NV_KMALLOC(entries, sizeof(*entries) * NV_RPC_PROFILE_MAX_ENTRIES);
+    if (entries == NULL)
+    {
+        return 0;
+    }
+
+    if (nv_kmem_cache_alloc_stack(&sp) != 0)
+    {
+        NV_KFREE(entries, sizeof(*entries) * NV_RPC_PROFILE_MAX_ENTRIES);
+        return 0;
+    }
+
+    do
+    {
+        status = rm_get_rpc_profile(sp, nv, &function, entries, &count);
+        if (status == NV_ERR_INVALID_STATE)
+        {
+            seq_printf(s, "RPC profiling is disabled\n");
+            break;
+        }
+        else if (status != NV_OK)
+        {
+            seq_printf(s, "RPC profile: N/A\n");
+            break;
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            seq_printf(s, "function %3u: count %llu p50 %llu ns p99 %llu ns "
+                          "max %llu ns total %llu ns sent %llu B received %llu B\n",
+                       entries[i].function, entries[i].count,
+                       entries[i].p50Ns, entries[i].p99Ns, entries[i].maxNs,
+                       entries[i].totalNs, entries[i].bytesSent,
+                       entries[i].bytesReceived);
+        }
+    } while (function != NV_RPC_PROFILE_FUNCTION_END);
+
+    nv_kmem_cache_free_stack(sp);
+    NV_KFREE(entries, sizeof(*entries) * NV_RPC_PROFILE_MAX_ENTRIES);
+    return 0;
+}
+
+NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(rpc_profile);
+
+static int
+nv_procfs_read_control_cache(
+    struct seq_file *s,
+    void *v
+)
+{
+    nvidia_stack_t *sp = NULL;
+    nv_control_cache_stats_t stats;
+    NV_STATUS status;
+
+    if (nv_kmem_cache_alloc_stack(&sp) != 0)
+    {
+        return 0;
+    }
+
+    status = rm_get_control_cache_stats(sp, &stats);
+    if (status == NV_ERR_INVALID_STATE)
+    {
+        seq_printf(s, "Control cache is disabled\n");
+    }
+    else if (status != NV_OK)
+    {
+        seq_printf(s, "Control cache: N/A\n");
+    }
+    else
+    {
+        seq_printf(s, "Hits:        %llu\n", stats.hits);
+        seq_printf(s, "Misses:      %llu\n", stats.misses);
+        seq_printf(s, "Evictions:   %llu\n", stats.evictions);
+        seq_printf(s, "Entries:     %llu\n", stats.entries);
+        seq_printf(s, "Max entries: %llu\n", stats.maxEntries);
+    }
+
+    nv_kmem_cache_free_stack(sp);
+    return 0;
+}
+
+NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(control_cache);
+
+static int
+nv_procfs_read_resserv_slab(
+    struct seq_file *s,
+    void *v
+)
+{
+    nvidia_stack_t *sp = NULL;
+    nv_resserv_slab_stats_t stats[NV_RESSERV_SLAB_SIZE_CLASS_COUNT];
+    NV_STATUS status;
+    unsigned int i;
+
+    if (nv_kmem_cache_alloc_stack(&sp) != 0)
+    {
+        return 0;
+    }
+
+    status = rm_get_resserv_slab_stats(sp, stats);
+    if (status == NV_ERR_NOT_SUPPORTED)
+    {
+        seq_printf(s, "Slab allocator is disabled\n");
+    }
+    else if (status != NV_OK)
+    {
+        seq_printf(s, "Slab allocator: N/A\n");
+    }
+    else
+    {
+        seq_printf(s, "%6s %12s %12s %12s %12s %12s\n", "Size", "Allocs",
+                   "Frees", "Misses", "Overflows", "Exchanges");
+        for (i = 0; i < NV_RESSERV_SLAB_SIZE_CLASS_COUNT; i++)
+        {
+            seq_printf(s, "%6llu %12llu %12llu %12llu %12llu %12llu\n",
+                       stats[i].objectSize, stats[i].allocs, stats[i].frees,
+                       stats[i].cacheMisses, stats[i].cacheOverflows,
+                       stats[i].depotExchanges);
+        }
+    }
+
+    nv_kmem_cache_free_stack(sp);
+    return 0;
+}
+
+NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(resserv_slab);
+
 static int
 nv_procfs_read_version(
     struct seq_file *s,
@@ -1377,6 +1517,14 @@ int nv_procfs_init(void)
     if (!entry)
         goto failed;
 
+    entry = NV_CREATE_PROC_FILE("control_cache", proc_nvidia, control_cache, NULL);
+    if (!entry)
+        goto failed;
+
+    entry = NV_CREATE_PROC_FILE("resserv_slab", proc_nvidia, resserv_slab, NULL);
+    if (!entry)
+        goto failed;
+
     proc_nvidia_gpus = NV_CREATE_PROC_DIR("gpus", proc_nvidia);
     if (!proc_nvidia_gpus)
         goto failed;
@@ -1428,6 +1576,10 @@ int nv_procfs_add_gpu(nv_linux_state_t *nvl)
     if (!entry)
         goto failed;
 
+    entry = NV_CREATE_PROC_FILE("rpc_profile", proc_nvidia_gpu, rpc_profile, nv);
+    if (!entry)
+        goto failed;
+
     if (IS_EXERCISE_ERROR_FORWARDING_ENABLED())
     {
         entry = NV_CREATE_PROC_FILE("exercise_error_forwarding", proc_nvidia_gpu,
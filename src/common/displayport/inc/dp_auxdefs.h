@@ -50,6 +50,22 @@
 //
 #define DPCD_MESSAGE_REPLY_TIMEOUT              4000
 
+//
+//  MSG_SEQ_NO is a single bit, so a branch can track at most two
+//  outstanding down requests from us at any one time.
+//
+#define DPCD_MESSAGE_MAX_OUTSTANDING_PER_TARGET 2
+
+//
+//  Default limit on down requests in flight across the whole topology.
+//  One serializes every down request, as MST discovery always has.
+//  NV_DP_REGKEY_MST_MAX_OUTSTANDING_DOWN_REQUESTS opts in to a larger
+//  window; simulated discovery stops getting faster past four
+//  (test/dp_discovery_test), since sink detection still waits on
+//  POWER_UP_PHY synchronously.
+//
+#define DPCD_MESSAGE_MAX_OUTSTANDING_DEFAULT    1
+
 #define DPCD_LINK_ADDRESS_MESSAGE_RETRIES       20  // 20 retries
 #define DPCD_LINK_ADDRESS_MESSAGE_COOLDOWN      10  // 10ms between attempts
 
@@ -53,6 +53,13 @@ namespace DisplayPort
         // Read 1-32 bits from stream.  Returns 'default' on failure.
         unsigned  readOrDefault(unsigned bits, unsigned defaultValue);
 
+        //
+        //  Read 'count' bytes into 'data'.  Byte aligned streams are copied
+        //  directly.  If the stream is too short, the whole bytes left are
+        //  read, the rest of 'data' is zeroed and false is returned.
+        //
+        bool readBytes(NvU8 * data, unsigned count);
+
         // Skip bits until we're aligned to the power of two alignment
         bool align(unsigned align);
 
@@ -81,6 +88,18 @@ namespace DisplayPort
         //
         bool write(unsigned value, unsigned bits);
 
+        //
+        //  Write 'count' bytes from 'data'.  Byte aligned streams are copied
+        //  directly.
+        //
+        bool writeBytes(const NvU8 * data, unsigned count);
+
+        //
+        //  Grow the target buffer's allocation so that 'bits' more bits can be
+        //  written without reallocating.  The buffer length is unchanged.
+        //
+        bool reserve(unsigned bits);
+
         //
         // Emit zero's until the offset is divisible by align.
         //  CAVEAT: align must be a power of 2 (eg 8)
@@ -36,6 +36,7 @@ namespace DisplayPort
 {
     unsigned dpCalculateHeaderCRC(BitStreamReader * reader);
     unsigned dpCalculateBodyCRC(BitStreamReader * writer);
+    unsigned dpCalculateBodyCRC(const NvU8 * data, unsigned length);
 }
 
 #endif //INCLUDED_DP_CRC_H
@@ -57,7 +57,8 @@ namespace DisplayPort
             bool        videoSink;          // Should be true when a video sink is supported
             NvU64       maxTmdsClkRate;
 
-            Device():peerDevice(None),SDPStreams(0),SDPStreamSinks(0),dirty(false),videoSink(false)
+            Device():legacy(false),branch(false),peerDevice(None),dpcdRevisionMajor(0),dpcdRevisionMinor(0),
+                     SDPStreams(0),SDPStreamSinks(0),dirty(false),videoSink(false),maxTmdsClkRate(0)
             {
                 portMap.validMap = portMap.inputMap = portMap.internalMap = 0;
             }
@@ -119,6 +119,16 @@ namespace DisplayPort
         // Properties from regkey
         bool                bNoReplyTimerForBusyWaiting;
         bool                bDpcdProbingForBusyWaiting;
+        unsigned            maxOutstandingDownRequests;
+
+        //
+        //  Set while transmitAwaitingDownRequests walks notYetSentDownRequest.
+        //  Every change to that queue, including a message being dequeued by
+        //  a walk, bumps downRequestQueueEdits so an outer walk knows to
+        //  restart.
+        //
+        bool                bTransmittingDownRequests;
+        unsigned            downRequestQueueEdits;
 
         List                messageReceivers;
         List                notYetSentDownRequest;    // Down Messages yet to be processed
@@ -128,6 +138,7 @@ namespace DisplayPort
         void onUpRequestReceived(bool status, EncodedMessage * message);
         void onDownReplyReceived(bool status, EncodedMessage * message);
         void transmitAwaitingDownRequests();
+        unsigned freeMessageNumber(const Address & target);
         void transmitAwaitingUpReplies();
 
         // IncomingTransactionManager
@@ -163,6 +174,23 @@ namespace DisplayPort
                       "All regkeys are invalid because dpRegkeyDatabase is not initialized!");
             bNoReplyTimerForBusyWaiting  = dpRegkeyDatabase.bNoReplyTimerForBusyWaiting;
             bDpcdProbingForBusyWaiting   = dpRegkeyDatabase.bDpcdProbingForBusyWaiting;
+            setMaxOutstandingDownRequests(dpRegkeyDatabase.mstMaxOutstandingDownRequests);
+        }
+
+        //
+        //  Limit on down requests awaiting a reply across all targets.
+        //  A single branch never gets more than two since MSG_SEQ_NO is
+        //  one bit wide.  One serializes all down requests; zero restores
+        //  the default.
+        //
+        void setMaxOutstandingDownRequests(unsigned limit)
+        {
+            maxOutstandingDownRequests = limit ? limit : DPCD_MESSAGE_MAX_OUTSTANDING_DEFAULT;
+        }
+
+        unsigned getMaxOutstandingDownRequests()
+        {
+            return maxOutstandingDownRequests;
         }
 
         MessageManager(DPCDHAL * hal, Timer * timer)
@@ -171,7 +199,10 @@ namespace DisplayPort
             splitterUpReply(hal, timer),
             mergerUpRequest(hal, timer, Address(0), this),
             mergerDownReply(hal, timer, Address(0), this),
-            isBeingDestroyed(false)
+            isBeingDestroyed(false),
+            maxOutstandingDownRequests(DPCD_MESSAGE_MAX_OUTSTANDING_DEFAULT),
+            bTransmittingDownRequests(false),
+            downRequestQueueEdits(0)
         {
         }
 
@@ -286,6 +317,7 @@ namespace DisplayPort
                 if (parent) {
                     parent->timer->cancelCallbacks(this);
                     parent->splitterDownRequest.cancel(this);
+                    parent->downRequestQueueEdits++;
                 }
 
                 parent = 0;
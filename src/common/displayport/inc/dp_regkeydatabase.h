@@ -75,6 +75,14 @@
 
 #define NV_DP_REGKEY_DPCD_PROBING_FOR_BUSY_WAITING     "DP_DPCD_PROBING_FOR_BUSY_WAITING"
 
+//
+// Maximum number of MST down requests kept in flight at once. Zero keeps
+// the default of DPCD_MESSAGE_MAX_OUTSTANDING_DEFAULT, which serializes
+// discovery; larger values let more sibling branches be probed at once,
+// still capped at two outstanding requests per branch.
+//
+#define NV_DP_REGKEY_MST_MAX_OUTSTANDING_DOWN_REQUESTS "DP_MST_MAX_OUTSTANDING_DOWN_REQUESTS"
+
 //
 // Data Base used to store all the regkey values.
 // The actual data base is declared statically in dp_evoadapter.cpp.
@@ -110,6 +118,7 @@ struct DP_REGKEY_DATABASE
     bool  bDscOptimizeLTBug3534707;
     bool  bNoReplyTimerForBusyWaiting;
     bool  bDpcdProbingForBusyWaiting;
+    NvU32 mstMaxOutstandingDownRequests;
 };
 
 #endif //INCLUDED_DP_REGKEYDATABASE_H
@@ -60,41 +60,91 @@ namespace DisplayPort
     public:
         struct TimerCallback
         {
+            TimerCallback() : firstPending((unsigned)-1) {}
             virtual void expired(const  void * context) = 0;
+
+            // First slot of the list of callbacks queued against this
+            // target, so cancelling them only visits the target's own.
+            unsigned firstPending;
         };
 
+        //
+        //  Handle to a single queued callback.  Zero is never a valid handle,
+        //  and a handle goes stale once its callback fires or is cancelled.
+        //
+        typedef NvU64 CallbackHandle;
+
     private:
         RawTimer * raw;
         NvU64      nextTimestamp;
-        List       pending;
-        struct PendingCallback : ListElement
+
+        //
+        //  Pending callbacks live in a pooled array of slots, recycled through
+        //  a free list.  Two binary min-heaps of slot indices, ordered by
+        //  (timestamp, sequence), track the callbacks that may run from
+        //  sleep() and those that may not.  The slots queued against each
+        //  target are also linked together, starting at its firstPending.
+        //
+        enum
+        {
+            HEAP_EXECUTE_IN_SLEEP = 0,
+            HEAP_NO_EXECUTE_IN_SLEEP,
+            HEAP_COUNT
+        };
+
+        struct PendingCallback
         {
             TimerCallback *    target;
             const void *       context;
             NvU64              timestamp; // in usec
+            NvU64              sequence;  // FIFO order between equal timestamps
+            unsigned           heapIndex;
+            unsigned           targetPrev;
+            unsigned           targetNext;
+            unsigned           generation;
+            unsigned           nextFree;
             bool               executeInSleep;
-
+            bool               inUse;
         };
 
+        PendingCallback * slots;
+        unsigned          slotCount;
+        unsigned          freeSlot;
+        NvU64             nextSequence;
+        unsigned *        heap[HEAP_COUNT];
+        unsigned          heapSize[HEAP_COUNT];
+
         virtual void expired();
         unsigned fire(bool fromSleep);
 
         void _pump(unsigned milliseconds, bool fromSleep);
+
+        bool growSlots();
+        bool before(unsigned slotA, unsigned slotB);
+        void heapPlace(unsigned which, unsigned index, unsigned slot);
+        void heapSiftUp(unsigned which, unsigned index);
+        void heapSiftDown(unsigned which, unsigned index);
+        void heapRemove(unsigned which, unsigned index);
+        CallbackHandle insertCallback(Timer::TimerCallback * target, const void * context, NvU64 timestamp, NvU64 sequence, bool executeInSleep);
+        void releaseCallback(unsigned slot);
+        void removeCallback(unsigned slot);
+
     public:
-        Timer(RawTimer * raw) : raw(raw) {}
-        virtual ~Timer() {}
+        Timer(RawTimer * raw);
+        virtual ~Timer();
 
         //
         //  Queue a timer callback.
         //      Unless the dont-execute-in-sleep flag is
         //
-        void queueCallback(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep = true);
+        CallbackHandle queueCallback(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep = true);
         NvU64 getTimeUs();
         void sleep(unsigned milliseconds);
         void cancelCallbacks(Timer::TimerCallback * to);
 
         void cancelCallback(Timer::TimerCallback * to, const void * context);
-        void queueCallbackInOrder(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep);
+        bool cancelCallback(CallbackHandle handle);
+        CallbackHandle queueCallbackInOrder(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep);
         void cancelCallbacksWithoutContext(const  void * context);
         void cancelAllCallbacks();
         bool checkCallbacksOfSameContext(const void * context);
@@ -70,6 +70,21 @@ namespace DisplayPort
             unsigned int   laneCount;
         } dpOverrideOptimalLinkConfig;
     };
+
+    //
+    // Connector state that the OUI based workarounds may set.  Members a
+    // matching workaround does not touch are left as they were.
+    //
+    struct OuiWorkAroundState
+    {
+        bool        bKeepOptLinkAlive;
+        bool        bNoFallbackInPostLQA;
+        NvU32       LT2FecLatencyMs;
+        bool        bDscCapBasedOnParent;
+    };
+
+    void applyOuiWorkArounds(unsigned ouiId, const char * modelName,
+                             bool bDscMstCapBug3143315, OuiWorkAroundState & state);
 }
 
 #endif // INCLUDED_DP_WARDATABASE_H
@@ -32,45 +32,75 @@
 #include "dp_bitstream.h"
 
 using namespace DisplayPort;
+
+//
+//  Fields are at most 32 bits wide, so any field lives within a window of
+//  at most 5 bytes.  Both directions load that window into a 64 bit value,
+//  and extract/insert the field with a single shift and mask.
+//
 bool BitStreamReader::read(unsigned * value, unsigned bits)
 {
-    unsigned topbit = (7- (this->bitsOffset & 7));
+    DP_ASSERT(bits <= 32);
 
     if (this->bitsOffset + bits > this->bitsEnd)
     {
         return false;
     }
 
-    //
-    //  We're filling the byte down from 'topbit' towards 0.
-    //    Can we fit all of the bits starting at topbit before
-    //    overflowing to the next byte?
-    //
-    if (bits <= (topbit+1)) 
+    if (bits == 0)
     {
-        int bottombit = topbit - (bits-1);
-        *value = (this->buffer()->data[this->bitsOffset / 8] >> bottombit) & ((1 << bits)-1);
-
-        this->bitsOffset+=bits;
+        *value = 0;
         return true;
     }
 
-    //
-    //  We're either reading too many bits or we're straddling
-    //  a byte boundary.  Serialize bit by bit.
-    //  NOTE: This scenario is entire unlikely.  Don't optimize.
-    //
+    const NvU8 * data = this->buffer()->data;
+    unsigned firstByte = this->bitsOffset / 8;
+    unsigned lastByte = (this->bitsOffset + bits - 1) / 8;
+    unsigned shift = (lastByte + 1) * 8 - (this->bitsOffset + bits);
+    NvU64 window = data[firstByte];
 
-    *value = 0;
-    while (bits) 
+    for (unsigned i = firstByte + 1; i <= lastByte; i++)
     {
-        unsigned bit;
-        if (!read(&bit, 1))
+        window = (window << 8) | data[i];
+    }
+
+    *value = (unsigned)((window >> shift) & ((1ULL << bits) - 1));
+    this->bitsOffset += bits;
+    return true;
+}
+
+bool BitStreamReader::readBytes(NvU8 * data, unsigned count)
+{
+    unsigned available = 0;
+    unsigned copied;
+
+    if (this->bitsOffset < this->bitsEnd)
+    {
+        available = (this->bitsEnd - this->bitsOffset) / 8;
+    }
+
+    copied = DP_MIN(count, available);
+
+    if ((this->bitsOffset & 7) == 0)
+    {
+        if (copied)
         {
-            return false;
+            dpMemCopy(data, &this->buffer()->data[this->bitsOffset / 8], copied);
+        }
+        this->bitsOffset += copied * 8;
+    }
+    else
+    {
+        for (unsigned i = 0; i < copied; i++)
+        {
+            data[i] = (NvU8)readOrDefault(8, 0);
         }
-        *value = *value * 2 + bit;
-        bits--;
+    }
+
+    if (copied < count)
+    {
+        dpMemZero(&data[copied], count - copied);
+        return false;
     }
 
     return true;
@@ -108,42 +138,119 @@ bool BitStreamReader::align(unsigned align)
     return this->bitsOffset <= this->bitsEnd;
 }
 
+bool BitStreamWriter::reserve(unsigned bits)
+{
+    Buffer * target = this->buffer();
+    unsigned bytesNeeded = (this->bitsOffset + bits + 7) / 8;
+
+    if (bytesNeeded <= target->capacity)
+    {
+        return true;
+    }
+
+    // Grow the allocation, but leave the bytes used alone
+    unsigned length = target->length;
+    if (!target->resize(bytesNeeded))
+    {
+        return false;
+    }
+    target->length = length;
+
+    return true;
+}
+
 bool BitStreamWriter::write(unsigned value, unsigned bits)
 {
+    DP_ASSERT(bits <= 32);
     DP_ASSERT((value < (1ULL << bits)) && "Value out of range");
-    unsigned topbit = (7- (this->bitsOffset & 7));
 
-    if (this->bitsOffset + bits > this->buffer()->length * 8)
+    if (bits == 0)
+    {
+        return true;
+    }
+
+    Buffer * target = this->buffer();
+    unsigned bytesNeeded = (this->bitsOffset + bits + 7) / 8;
+
+    if (bytesNeeded > target->length)
+    {
+        //
+        //  Only go through the allocator if the buffer wasn't pre-sized
+        //  by reserve().
+        //
+        if (bytesNeeded <= target->capacity)
+        {
+            target->length = bytesNeeded;
+        }
+        else if (!target->resize(bytesNeeded))
+        {
+            return false;
+        }
+    }
+
+    NvU8 * data = target->data;
+    unsigned firstByte = this->bitsOffset / 8;
+    unsigned lastByte = bytesNeeded - 1;
+    unsigned shift = (lastByte + 1) * 8 - (this->bitsOffset + bits);
+    NvU64 mask = ((1ULL << bits) - 1) << shift;
+    NvU64 window = data[firstByte];
+    unsigned i;
+
+    for (i = firstByte + 1; i <= lastByte; i++)
     {
-        this->buffer()->resize((this->bitsOffset + bits+7)/8);
+        window = (window << 8) | data[i];
     }
 
-    //
-    //  We're filling the byte down from 'topbit' towards 0.
-    //    Can we fit all of the bits starting at topbit before
-    //    overflowing to the next byte?
-    //
-    if (bits <= (topbit+1)) 
+    window = (window & ~mask) | (((NvU64)value << shift) & mask);
+
+    for (i = lastByte; i > firstByte; i--)
     {
-        int bottombit = topbit - (bits-1);
-        NvU8  clearmask = ((1 << bits)-1) << bottombit;
+        data[i] = (NvU8)window;
+        window >>= 8;
+    }
+    data[firstByte] = (NvU8)window;
 
-        this->buffer()->data[this->bitsOffset / 8] = (NvU8)((this->buffer()->data[this->bitsOffset / 8] &~ clearmask) | (value << bottombit));
+    this->bitsOffset += bits;
+    return true;
+}
 
-        this->bitsOffset+=bits;
+bool BitStreamWriter::writeBytes(const NvU8 * data, unsigned count)
+{
+    if (count == 0)
+    {
         return true;
     }
 
-    //
-    //  We're either writing too many bits or we're straddling
-    //  a byte boundary.  Serialize bit by bit.
-    //  NOTE: This scenario is entire unlikely.  Don't optimize.
-    //
+    if ((this->bitsOffset & 7) == 0)
+    {
+        unsigned bytesNeeded = this->bitsOffset / 8 + count;
+        Buffer * target = this->buffer();
+
+        if (bytesNeeded > target->length)
+        {
+            if (bytesNeeded <= target->capacity)
+            {
+                target->length = bytesNeeded;
+            }
+            else if (!target->resize(bytesNeeded))
+            {
+                return false;
+            }
+        }
+
+        dpMemCopy(&target->data[this->bitsOffset / 8], data, count);
+        this->bitsOffset += count * 8;
+        return true;
+    }
+
+    if (!reserve(count * 8))
+    {
+        return false;
+    }
 
-    while (bits)
+    for (unsigned i = 0; i < count; i++)
     {
-        bits --;
-        if (!write( (value >> bits) & 1, 1))
+        if (!write(data[i], 8))
         {
             return false;
         }
@@ -32,34 +32,109 @@
 #include "dp_crc.h"
 using namespace DisplayPort;
 
+//
+//  Lookup tables for the sideband CRCs, generated from the polynomials below.
+//
+//  Entry 'i' holds the remainder left after shifting the 8 bits of 'i' MSB
+//  first through a zeroed CRC register.  The header CRC is only 4 bits wide,
+//  so its current remainder is folded into the high nibble of the index; the
+//  first 16 entries double as the nibble-wide table.
+//
+//    Header: x^4 + x + 1                         (0x13)
+//    Body:   x^8 + x^7 + x^6 + x^4 + x^2 + 1     (0xD5)
+//
+static const NvU8 dpHeaderCrcTable[256] =
+{
+    0x00, 0x03, 0x06, 0x05, 0x0C, 0x0F, 0x0A, 0x09, 0x0B, 0x08, 0x0D, 0x0E, 0x07, 0x04, 0x01, 0x02,
+    0x05, 0x06, 0x03, 0x00, 0x09, 0x0A, 0x0F, 0x0C, 0x0E, 0x0D, 0x08, 0x0B, 0x02, 0x01, 0x04, 0x07,
+    0x0A, 0x09, 0x0C, 0x0F, 0x06, 0x05, 0x00, 0x03, 0x01, 0x02, 0x07, 0x04, 0x0D, 0x0E, 0x0B, 0x08,
+    0x0F, 0x0C, 0x09, 0x0A, 0x03, 0x00, 0x05, 0x06, 0x04, 0x07, 0x02, 0x01, 0x08, 0x0B, 0x0E, 0x0D,
+    0x07, 0x04, 0x01, 0x02, 0x0B, 0x08, 0x0D, 0x0E, 0x0C, 0x0F, 0x0A, 0x09, 0x00, 0x03, 0x06, 0x05,
+    0x02, 0x01, 0x04, 0x07, 0x0E, 0x0D, 0x08, 0x0B, 0x09, 0x0A, 0x0F, 0x0C, 0x05, 0x06, 0x03, 0x00,
+    0x0D, 0x0E, 0x0B, 0x08, 0x01, 0x02, 0x07, 0x04, 0x06, 0x05, 0x00, 0x03, 0x0A, 0x09, 0x0C, 0x0F,
+    0x08, 0x0B, 0x0E, 0x0D, 0x04, 0x07, 0x02, 0x01, 0x03, 0x00, 0x05, 0x06, 0x0F, 0x0C, 0x09, 0x0A,
+    0x0E, 0x0D, 0x08, 0x0B, 0x02, 0x01, 0x04, 0x07, 0x05, 0x06, 0x03, 0x00, 0x09, 0x0A, 0x0F, 0x0C,
+    0x0B, 0x08, 0x0D, 0x0E, 0x07, 0x04, 0x01, 0x02, 0x00, 0x03, 0x06, 0x05, 0x0C, 0x0F, 0x0A, 0x09,
+    0x04, 0x07, 0x02, 0x01, 0x08, 0x0B, 0x0E, 0x0D, 0x0F, 0x0C, 0x09, 0x0A, 0x03, 0x00, 0x05, 0x06,
+    0x01, 0x02, 0x07, 0x04, 0x0D, 0x0E, 0x0B, 0x08, 0x0A, 0x09, 0x0C, 0x0F, 0x06, 0x05, 0x00, 0x03,
+    0x09, 0x0A, 0x0F, 0x0C, 0x05, 0x06, 0x03, 0x00, 0x02, 0x01, 0x04, 0x07, 0x0E, 0x0D, 0x08, 0x0B,
+    0x0C, 0x0F, 0x0A, 0x09, 0x00, 0x03, 0x06, 0x05, 0x07, 0x04, 0x01, 0x02, 0x0B, 0x08, 0x0D, 0x0E,
+    0x03, 0x00, 0x05, 0x06, 0x0F, 0x0C, 0x09, 0x0A, 0x08, 0x0B, 0x0E, 0x0D, 0x04, 0x07, 0x02, 0x01,
+    0x06, 0x05, 0x00, 0x03, 0x0A, 0x09, 0x0C, 0x0F, 0x0D, 0x0E, 0x0B, 0x08, 0x01, 0x02, 0x07, 0x04,
+};
+
+static const NvU8 dpBodyCrcTable[256] =
+{
+    0x00, 0xD5, 0x7F, 0xAA, 0xFE, 0x2B, 0x81, 0x54, 0x29, 0xFC, 0x56, 0x83, 0xD7, 0x02, 0xA8, 0x7D,
+    0x52, 0x87, 0x2D, 0xF8, 0xAC, 0x79, 0xD3, 0x06, 0x7B, 0xAE, 0x04, 0xD1, 0x85, 0x50, 0xFA, 0x2F,
+    0xA4, 0x71, 0xDB, 0x0E, 0x5A, 0x8F, 0x25, 0xF0, 0x8D, 0x58, 0xF2, 0x27, 0x73, 0xA6, 0x0C, 0xD9,
+    0xF6, 0x23, 0x89, 0x5C, 0x08, 0xDD, 0x77, 0xA2, 0xDF, 0x0A, 0xA0, 0x75, 0x21, 0xF4, 0x5E, 0x8B,
+    0x9D, 0x48, 0xE2, 0x37, 0x63, 0xB6, 0x1C, 0xC9, 0xB4, 0x61, 0xCB, 0x1E, 0x4A, 0x9F, 0x35, 0xE0,
+    0xCF, 0x1A, 0xB0, 0x65, 0x31, 0xE4, 0x4E, 0x9B, 0xE6, 0x33, 0x99, 0x4C, 0x18, 0xCD, 0x67, 0xB2,
+    0x39, 0xEC, 0x46, 0x93, 0xC7, 0x12, 0xB8, 0x6D, 0x10, 0xC5, 0x6F, 0xBA, 0xEE, 0x3B, 0x91, 0x44,
+    0x6B, 0xBE, 0x14, 0xC1, 0x95, 0x40, 0xEA, 0x3F, 0x42, 0x97, 0x3D, 0xE8, 0xBC, 0x69, 0xC3, 0x16,
+    0xEF, 0x3A, 0x90, 0x45, 0x11, 0xC4, 0x6E, 0xBB, 0xC6, 0x13, 0xB9, 0x6C, 0x38, 0xED, 0x47, 0x92,
+    0xBD, 0x68, 0xC2, 0x17, 0x43, 0x96, 0x3C, 0xE9, 0x94, 0x41, 0xEB, 0x3E, 0x6A, 0xBF, 0x15, 0xC0,
+    0x4B, 0x9E, 0x34, 0xE1, 0xB5, 0x60, 0xCA, 0x1F, 0x62, 0xB7, 0x1D, 0xC8, 0x9C, 0x49, 0xE3, 0x36,
+    0x19, 0xCC, 0x66, 0xB3, 0xE7, 0x32, 0x98, 0x4D, 0x30, 0xE5, 0x4F, 0x9A, 0xCE, 0x1B, 0xB1, 0x64,
+    0x72, 0xA7, 0x0D, 0xD8, 0x8C, 0x59, 0xF3, 0x26, 0x5B, 0x8E, 0x24, 0xF1, 0xA5, 0x70, 0xDA, 0x0F,
+    0x20, 0xF5, 0x5F, 0x8A, 0xDE, 0x0B, 0xA1, 0x74, 0x09, 0xDC, 0x76, 0xA3, 0xF7, 0x22, 0x88, 0x5D,
+    0xD6, 0x03, 0xA9, 0x7C, 0x28, 0xFD, 0x57, 0x82, 0xFF, 0x2A, 0x80, 0x55, 0x01, 0xD4, 0x7E, 0xAB,
+    0x84, 0x51, 0xFB, 0x2E, 0x7A, 0xAF, 0x05, 0xD0, 0xAD, 0x78, 0xD2, 0x07, 0x53, 0x86, 0x2C, 0xF9,
+};
+
+//
+//  Bit-serial CRC steps.  These only handle the unaligned edges of a stream;
+//  everything byte aligned goes through the tables above.
+//
+static inline unsigned dpHeaderCrcBit(unsigned remainder, unsigned bit)
+{
+    unsigned top = ((remainder >> 3) ^ bit) & 1;
+    remainder = (remainder << 1) & 0xF;
+    return top ? (remainder ^ 0x3) : remainder;
+}
+
+static inline unsigned dpBodyCrcBit(unsigned remainder, unsigned bit)
+{
+    unsigned top = ((remainder >> 7) ^ bit) & 1;
+    remainder = (remainder << 1) & 0xFF;
+    return top ? (remainder ^ 0xD5) : remainder;
+}
+
 //
 //  DP CRC for transactions headers
-//  
+//
 unsigned DisplayPort::dpCalculateHeaderCRC(BitStreamReader * reader)
 {
     unsigned remainder = 0;
-    unsigned bit, i;
+    unsigned value;
+
+    // Serialize bit by bit up to the first byte boundary
+    while ((reader->offset() & 7) && reader->read(&value, 1))
+    {
+        remainder = dpHeaderCrcBit(remainder, value);
+    }
+
+    while (reader->read(&value, 8))
+    {
+        remainder = dpHeaderCrcTable[(remainder << 4) ^ value];
+    }
 
-    while (reader->read(&bit, 1))
+    //
+    //  Headers are LCT/LCR/RAD nibbles followed by the flag byte, so the
+    //  stream normally ends on a nibble.
+    //
+    if (reader->read(&value, 4))
     {
-        remainder <<= 1;
-        remainder |= bit; 
-        if ((remainder & 0x10) == 0x10)
-        {
-            remainder ^= 0x13;
-        }
+        remainder = dpHeaderCrcTable[remainder ^ value];
     }
 
-    for (i = 4; i != 0; i--)
+    while (reader->read(&value, 1))
     {
-        remainder <<= 1;
-        if ((remainder & 0x10) != 0)
-        {
-            remainder ^= 0x13;
-        }
+        remainder = dpHeaderCrcBit(remainder, value);
     }
 
-    return remainder & 0xF;
+    return remainder;
 }
 
 //
@@ -68,26 +143,38 @@ unsigned DisplayPort::dpCalculateHeaderCRC(BitStreamReader * reader)
 unsigned DisplayPort::dpCalculateBodyCRC(BitStreamReader * reader)
 {
     unsigned remainder = 0;
-    unsigned bit, i;
+    unsigned value;
+
+    // Serialize bit by bit up to the first byte boundary
+    while ((reader->offset() & 7) && reader->read(&value, 1))
+    {
+        remainder = dpBodyCrcBit(remainder, value);
+    }
+
+    while (reader->read(&value, 8))
+    {
+        remainder = dpBodyCrcTable[remainder ^ value];
+    }
 
-    while (reader->read(&bit, 1))
+    while (reader->read(&value, 1))
     {
-        remainder <<= 1;
-        remainder |= bit; 
-        if ((remainder & 0x100) == 0x100)
-        {
-            remainder ^= 0xD5;
-        }
+        remainder = dpBodyCrcBit(remainder, value);
     }
 
-    for (i = 8; i != 0; i--)
+    return remainder;
+}
+
+//
+//  DP CRC for a byte aligned body
+//
+unsigned DisplayPort::dpCalculateBodyCRC(const NvU8 * data, unsigned length)
+{
+    unsigned remainder = 0;
+
+    while (length--)
     {
-        remainder <<= 1;
-        if ((remainder & 0x100) != 0)
-        {
-            remainder ^= 0xD5;
-        }
+        remainder = dpBodyCrcTable[remainder ^ *data++];
     }
 
-    return remainder & 0xFF;
+    return remainder;
 }
@@ -100,11 +100,11 @@ EncodedMessage * MessageTransactionMerger::pushTransaction(MessageHeader * heade
     //
     //  Verify transaction CRC
     //
-    BitStreamReader bsr(data, header->headerSizeBits, (header->payloadBytes-1)*8);
-    NvU8 dataCrc = (NvU8)dpCalculateBodyCRC(&bsr);
-
     DP_ASSERT(header->headerSizeBits  % 8 == 0 && "Header must be byte aligned");
 
+    NvU8 dataCrc = header->payloadBytes ?
+        (NvU8)dpCalculateBodyCRC(&data->data[header->headerSizeBits/8], header->payloadBytes-1) : 0;
+
     if (dataCrc != data->data[header->headerSizeBits/8 + header->payloadBytes - 1] ||
         header->payloadBytes == 0)
     {
@@ -400,10 +400,8 @@ ParseResponseStatus RemoteDpcdReadMessage::parseResponseAck(EncodedMessage * mes
     reader->readOrDefault(4 /*zeroes*/, 0);
     reply.portNumber = reader->readOrDefault(4 /*Port_Number*/, 0xF);
     reply.numBytesReadDPCD = reader->readOrDefault(8 /*Num_Of_Bytes_Read*/, 0x0);
-    for (unsigned i=0; i<reply.numBytesReadDPCD; i++)
-    {
-        reply.readData[i] = (NvU8)reader->readOrDefault(8 /*data*/, 0x0);
-    }
+    // A short reply keeps the bytes that did arrive, the rest reads as zero.
+    reader->readBytes(reply.readData, DP_MIN(reply.numBytesReadDPCD, (unsigned)REMOTE_READ_BUFFER_SIZE));
 
     if (this->getSinkPort() != reply.portNumber)
         return ParseResponseWrong;
@@ -425,6 +423,7 @@ void RemoteDpcdWriteMessage::set
 {
     clear();
     BitStreamWriter writer(&encodedMessage.buffer, 0);
+    writer.reserve((5 + nBytesToWrite) * 8);
 
     DP_ASSERT(writeData || (!nBytesToWrite));
 
@@ -436,11 +435,7 @@ void RemoteDpcdWriteMessage::set
     writer.write(port, 4);
     writer.write(dpcdAddress, 20);
     writer.write(nBytesToWrite, 8);
-
-    for (unsigned i=0; i<nBytesToWrite; i++)
-    {
-        writer.write(writeData[i], 8);
-    }
+    writer.writeBytes(writeData, nBytesToWrite);
 
     encodedMessage.isPathMessage = false;
     encodedMessage.isBroadcast  = false;
@@ -481,6 +476,15 @@ void RemoteI2cReadMessage::set
 
     DP_ASSERT(transactions || (!nWriteTransactions));
 
+    // Size the message once up front: 2 header bytes, 3 bytes per write
+    // transaction plus its data, and 2 bytes for the read request
+    unsigned messageBytes = 4;
+    for (unsigned i=0; i<nWriteTransactions; i++)
+    {
+        messageBytes += 3 + transactions[i].NumBytes;
+    }
+    writer.reserve(messageBytes * 8);
+
     //    Write request identifier
     writer.write(0 /*zero*/, 1);
     writer.write(requestIdentifier, 7);
@@ -495,10 +499,7 @@ void RemoteI2cReadMessage::set
         writer.write(0/*zero*/, 1);
         writer.write(transactions[i].WriteI2cDeviceId, 7);
         writer.write(transactions[i].NumBytes, 8);
-        for(unsigned j=0; j<transactions[i].NumBytes; j++)
-        {
-            writer.write(transactions[i].I2cData[j], 8);
-        }
+        writer.writeBytes(transactions[i].I2cData, transactions[i].NumBytes);
         writer.write(0/*zeroes*/, 3);
         writer.write(transactions[i].NoStopBit ? 1 : 0, 1);
         writer.write(transactions[i].I2cTransactionDelay, 4);
@@ -518,10 +519,8 @@ ParseResponseStatus RemoteI2cReadMessage::parseResponseAck(EncodedMessage * mess
     reader->readOrDefault(4 /*zeroes*/, 0);
     reply.portNumber = reader->readOrDefault(4 /*Port_Number*/, 0xF);
     reply.numBytesReadI2C = reader->readOrDefault(8 /*Num_Of_Bytes_Read*/, 0x0);
-    for (unsigned i=0; i<reply.numBytesReadI2C; i++)
-    {
-        reply.readData[i] = (NvU8)reader->readOrDefault(8 /*data*/, 0x0);
-    }
+    // A short reply keeps the bytes that did arrive, the rest reads as zero.
+    reader->readBytes(reply.readData, DP_MIN(reply.numBytesReadI2C, (unsigned)REMOTE_READ_BUFFER_SIZE));
 
     if (this->getSinkPort() != reply.portNumber)
         return ParseResponseWrong;
@@ -544,6 +543,7 @@ void RemoteI2cWriteMessage::set
     clear();
 
     BitStreamWriter writer(&encodedMessage.buffer, 0);
+    writer.reserve((4 + nBytesToWrite) * 8);
 
     DP_ASSERT(writeData || (!nBytesToWrite));
 
@@ -556,11 +556,7 @@ void RemoteI2cWriteMessage::set
     writer.write(0/*zero*/, 5);
     writer.write(writeI2cDeviceId, 7);
     writer.write(nBytesToWrite, 8);
-
-    for (unsigned i=0; i<nBytesToWrite; i++)
-    {
-        writer.write(writeData[i], 8);
-    }
+    writer.writeBytes(writeData, nBytesToWrite);
 
     encodedMessage.isPathMessage = false;
     encodedMessage.isBroadcast  = false;
@@ -114,18 +114,7 @@ bool MessageManager::send(MessageManager::Message * message, NakData & nakData)
 
 bool DisplayPort::extractGUID(BitStreamReader * reader, GUID * guid)
 {
-    for (unsigned i=0; i < 128; i += 8)
-    {
-        unsigned data;
-        if (!reader->read(&data, 8))
-        {
-            return false;
-        }
-
-        guid->data[i/8] = (NvU8)data;
-    }
-
-    return true;
+    return reader->readBytes(&guid->data[0], sizeof(guid->data));
 }
 
 void  MessageManager::messagedReceived(IncomingTransactionManager * from, EncodedMessage * message)
@@ -178,8 +167,12 @@ void MessageManager::Message::splitterTransmitted(OutgoingTransactionManager * f
             // Start the countdown timer for the reply
             parent->timer->queueCallback(this, "SPLI", DPCD_MESSAGE_REPLY_TIMEOUT);
         }
-        // Tell the message manager he may begin sending the next message
-        parent->transmitAwaitingDownRequests();
+        //
+        // Tell the message manager he may begin sending the next message,
+        // unless he is already walking his queue and will carry on anyway
+        //
+        if (!parent->bTransmittingDownRequests)
+            parent->transmitAwaitingDownRequests();
     }
     else    // UpReply
     {
@@ -226,35 +219,89 @@ void  MessageManager::Message::expired(const void * tag)
 }
 
 //
-//  Enqueue the next message to the splitterDownRequest
+//  Return a message number that is not awaiting a reply at 'target',
+//  or DPCD_MESSAGE_MAX_OUTSTANDING_PER_TARGET if both are in use
+//
+unsigned MessageManager::freeMessageNumber(const Address & target)
+{
+    unsigned busyMessageNumbers = 0;
+    unsigned messageNumber;
+
+    for (ListElement * i = awaitingReplyDownRequest.begin(); i!=awaitingReplyDownRequest.end(); i=i->next)
+    {
+        Message * a = (Message *)i;
+        if (a->state.target == target)
+            busyMessageNumbers |= 1 << a->state.messageNumber;
+    }
+
+    for (messageNumber = 0; messageNumber < DPCD_MESSAGE_MAX_OUTSTANDING_PER_TARGET; messageNumber++)
+    {
+        if (!(busyMessageNumbers & (1 << messageNumber)))
+            break;
+    }
+
+    return messageNumber;
+}
+
+//
+//  Enqueue as many messages to the splitterDownRequest as the
+//  outstanding-request window allows.  Messages to a busy branch stay
+//  queued while we move on to its siblings.
 //
 void MessageManager::transmitAwaitingDownRequests()
 {
-    for (ListElement * i = notYetSentDownRequest.begin(); i!=notYetSentDownRequest.end(); )
+    bool     bWasTransmitting = bTransmittingDownRequests;
+    unsigned outstanding;
+    unsigned queueEdits;
+
+    bTransmittingDownRequests = true;
+
+restart:
+    outstanding = 0;
+    for (ListElement * i = awaitingReplyDownRequest.begin(); i!=awaitingReplyDownRequest.end(); i=i->next)
+        outstanding++;
+
+    queueEdits = downRequestQueueEdits;
+
+    //
+    //  A single pass: the cursor only has to restart if a callback made
+    //  during a send changed the queue behind our back. That includes a
+    //  nested walk, e.g. from splitterFailed after a synchronous AUX NAK,
+    //  which moves messages to awaitingReplyDownRequest and can leave our
+    //  cursor on a node that is no longer in notYetSentDownRequest.
+    //
+    for (ListElement * i = notYetSentDownRequest.begin();
+         i!=notYetSentDownRequest.end() && outstanding < maxOutstandingDownRequests; )
     {
         Message * m = (Message *)i;
-        i = i->next;                    // Do this first since we may unlink the current node
+        i = i->next;                    // Do this first since we unlink the current node
 
-        if (awaitingReplyDownRequest.isEmpty())
-        {
-            //
-            //    Set the message number, and unlink from the outgoing queue
-            //
-            m->encodedMessage.messageNumber = 0;
-            m->state.messageNumber = 0;
+        unsigned messageNumber = freeMessageNumber(m->state.target);
+        if (messageNumber == DPCD_MESSAGE_MAX_OUTSTANDING_PER_TARGET)
+            continue;
 
-            notYetSentDownRequest.remove(m);
-            awaitingReplyDownRequest.insertBack(m);
+        //
+        //    Set the message number, and unlink from the outgoing queue
+        //
+        m->encodedMessage.messageNumber = messageNumber;
+        m->state.messageNumber = messageNumber;
 
-            //
-            //  This call can cause transmitAwaitingDownRequests to be called again
-            //
-            bool sent = splitterDownRequest.send(m->encodedMessage, m);
-            DP_ASSERT(sent);
+        notYetSentDownRequest.remove(m);
+        awaitingReplyDownRequest.insertBack(m);
+        outstanding++;
+        queueEdits = ++downRequestQueueEdits;
 
-            return;
-        }
+        //
+        //  This call can cause transmitAwaitingDownRequests to be called again
+        //
+        bool sent = splitterDownRequest.send(m->encodedMessage, m);
+        DP_ASSERT(sent);
+
+        if (queueEdits != downRequestQueueEdits)
+            goto restart;
     }
+
+    bTransmittingDownRequests = bWasTransmitting;
 }
 
 //
@@ -284,6 +331,8 @@ void MessageManager::postReply(Message * message, Message::MessageEventSink * si
 
 void MessageManager::cancelAllByType(unsigned type)
 {
+    downRequestQueueEdits++;
+
     for (ListElement * i = notYetSentDownRequest.begin(); i!=notYetSentDownRequest.end(); )
     {
         Message * m = (Message *)i;
@@ -305,6 +354,8 @@ void MessageManager::cancelAllByType(unsigned type)
 
 void MessageManager::cancelAll(Message * message)
 {
+    downRequestQueueEdits++;
+
     for (ListElement * i = notYetSentDownRequest.begin(); i!=notYetSentDownRequest.end(); )
     {
         Message * m = (Message *)i;
@@ -384,6 +435,7 @@ void MessageManager::post(Message * message, Message::MessageEventSink * sink, b
             }
             notYetSentDownRequest.insertBefore(msg->next, message);
         }
+        downRequestQueueEdits++;
         transmitAwaitingDownRequests();
     }
 }
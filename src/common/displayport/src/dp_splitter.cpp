@@ -92,6 +92,7 @@ bool MessageTransactionSplitter::get(Buffer & assemblyBuffer)
     isTransactionEnd = (assemblyTransmitted + payloadSize - 1) == messageOutstanding->buffer.length;
 
     BitStreamWriter writer(&assemblyBuffer, 0);
+    writer.reserve(headerSizeBits + payloadSize * 8);
 
     //
     //  Write the header
@@ -131,12 +132,10 @@ bool MessageTransactionSplitter::get(Buffer & assemblyBuffer)
     //
     //    Generate body CRC
     //
-    BitStreamReader bodyReader(&this->messageOutstanding->buffer, this->assemblyTransmitted * 8, (payloadSize - 1) * 8);
-    NvU8 bodyCrc = (NvU8)dpCalculateBodyCRC(&bodyReader);
+    NvU8 bodyCrc = (NvU8)dpCalculateBodyCRC(&this->messageOutstanding->buffer.data[this->assemblyTransmitted], payloadSize - 1);
 
     // Copy in remaining buffer (leaving room for the CRC)
-    for (i = 0; i < payloadSize - 1; ++i)
-        writer.write(this->messageOutstanding->buffer.data[i + this->assemblyTransmitted], 8);
+    writer.writeBytes(&this->messageOutstanding->buffer.data[this->assemblyTransmitted], payloadSize - 1);
     writer.write(bodyCrc, 8);
 
     this->assemblyTransmitted += payloadSize - 1;
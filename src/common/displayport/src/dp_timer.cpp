@@ -30,6 +30,230 @@
 #include "dp_timer.h"
 using namespace DisplayPort;
 
+#define DP_TIMER_INVALID_SLOT   ((unsigned)-1)
+#define DP_TIMER_INITIAL_SLOTS  16
+
+Timer::Timer(RawTimer * raw)
+    : raw(raw), nextTimestamp(0), slots(0), slotCount(0),
+      freeSlot(DP_TIMER_INVALID_SLOT), nextSequence(0)
+{
+    for (unsigned which = 0; which < HEAP_COUNT; which++)
+    {
+        heap[which] = 0;
+        heapSize[which] = 0;
+    }
+}
+
+Timer::~Timer()
+{
+    for (unsigned which = 0; which < HEAP_COUNT; which++)
+    {
+        if (heap[which])
+            dpFree(heap[which]);
+    }
+
+    if (slots)
+        dpFree(slots);
+}
+
+//
+//  Double the slot pool.  Both heaps are sized to the pool so that
+//  inserting never needs a second allocation.
+//
+bool Timer::growSlots()
+{
+    unsigned newCount = slotCount ? slotCount * 2 : DP_TIMER_INITIAL_SLOTS;
+    PendingCallback * newSlots = (PendingCallback *)dpMalloc(sizeof(PendingCallback) * newCount);
+    unsigned * newHeap[HEAP_COUNT];
+    unsigned which, i;
+
+    for (which = 0; which < HEAP_COUNT; which++)
+        newHeap[which] = (unsigned *)dpMalloc(sizeof(unsigned) * newCount);
+
+    if (!newSlots || !newHeap[HEAP_EXECUTE_IN_SLEEP] || !newHeap[HEAP_NO_EXECUTE_IN_SLEEP])
+    {
+        if (newSlots)
+            dpFree(newSlots);
+        for (which = 0; which < HEAP_COUNT; which++)
+            if (newHeap[which])
+                dpFree(newHeap[which]);
+        return false;
+    }
+
+    dpMemZero(newSlots, sizeof(PendingCallback) * newCount);
+
+    if (slots)
+    {
+        dpMemCopy(newSlots, slots, sizeof(PendingCallback) * slotCount);
+        dpFree(slots);
+    }
+
+    for (which = 0; which < HEAP_COUNT; which++)
+    {
+        if (heap[which])
+        {
+            dpMemCopy(newHeap[which], heap[which], sizeof(unsigned) * heapSize[which]);
+            dpFree(heap[which]);
+        }
+        heap[which] = newHeap[which];
+    }
+
+    // Thread the new slots onto the free list
+    for (i = newCount; i > slotCount; i--)
+    {
+        newSlots[i - 1].nextFree = freeSlot;
+        freeSlot = i - 1;
+    }
+
+    slots = newSlots;
+    slotCount = newCount;
+    return true;
+}
+
+bool Timer::before(unsigned slotA, unsigned slotB)
+{
+    if (slots[slotA].timestamp != slots[slotB].timestamp)
+        return slots[slotA].timestamp < slots[slotB].timestamp;
+
+    return slots[slotA].sequence < slots[slotB].sequence;
+}
+
+void Timer::heapPlace(unsigned which, unsigned index, unsigned slot)
+{
+    heap[which][index] = slot;
+    slots[slot].heapIndex = index;
+}
+
+void Timer::heapSiftUp(unsigned which, unsigned index)
+{
+    unsigned slot = heap[which][index];
+
+    while (index)
+    {
+        unsigned parent = (index - 1) / 2;
+        if (!before(slot, heap[which][parent]))
+            break;
+
+        heapPlace(which, index, heap[which][parent]);
+        index = parent;
+    }
+
+    heapPlace(which, index, slot);
+}
+
+void Timer::heapSiftDown(unsigned which, unsigned index)
+{
+    unsigned slot = heap[which][index];
+    unsigned size = heapSize[which];
+
+    for (;;)
+    {
+        unsigned child = index * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && before(heap[which][child + 1], heap[which][child]))
+            child++;
+
+        if (!before(heap[which][child], slot))
+            break;
+
+        heapPlace(which, index, heap[which][child]);
+        index = child;
+    }
+
+    heapPlace(which, index, slot);
+}
+
+void Timer::heapRemove(unsigned which, unsigned index)
+{
+    unsigned last = --heapSize[which];
+
+    if (index == last)
+        return;
+
+    // Move the last entry into the hole; it may need to go either way
+    unsigned moved = heap[which][last];
+    heapPlace(which, index, moved);
+    heapSiftDown(which, index);
+    if (slots[moved].heapIndex == index)
+        heapSiftUp(which, index);
+}
+
+Timer::CallbackHandle Timer::insertCallback(Timer::TimerCallback * target, const void * context, NvU64 timestamp, NvU64 sequence, bool executeInSleep)
+{
+    if (freeSlot == DP_TIMER_INVALID_SLOT && !growSlots())
+    {
+        DP_LOG(("DP> %s: Failed to allocate callback",
+                    __FUNCTION__));
+        return 0;
+    }
+
+    unsigned slot = freeSlot;
+    unsigned which = executeInSleep ? HEAP_EXECUTE_IN_SLEEP : HEAP_NO_EXECUTE_IN_SLEEP;
+    PendingCallback * callback = &slots[slot];
+
+    freeSlot = callback->nextFree;
+
+    callback->target = target;
+    callback->context = context;
+    callback->timestamp = timestamp;
+    callback->sequence = sequence;
+    callback->executeInSleep = executeInSleep;
+    callback->inUse = true;
+    callback->generation++;
+
+    // Link the callback at the head of its target's list
+    callback->targetPrev = DP_TIMER_INVALID_SLOT;
+    callback->targetNext = DP_TIMER_INVALID_SLOT;
+    if (target)
+    {
+        callback->targetNext = target->firstPending;
+        if (target->firstPending != DP_TIMER_INVALID_SLOT)
+            slots[target->firstPending].targetPrev = slot;
+        target->firstPending = slot;
+    }
+
+    heapPlace(which, heapSize[which]++, slot);
+    heapSiftUp(which, callback->heapIndex);
+
+    return ((NvU64)callback->generation << 32) | (slot + 1);
+}
+
+//
+//  Unlink a callback from its target and return its slot to the free list.
+//  The caller takes care of the heap.
+//
+void Timer::releaseCallback(unsigned slot)
+{
+    PendingCallback * callback = &slots[slot];
+
+    if (callback->target)
+    {
+        if (callback->targetPrev != DP_TIMER_INVALID_SLOT)
+            slots[callback->targetPrev].targetNext = callback->targetNext;
+        else
+            callback->target->firstPending = callback->targetNext;
+
+        if (callback->targetNext != DP_TIMER_INVALID_SLOT)
+            slots[callback->targetNext].targetPrev = callback->targetPrev;
+    }
+
+    callback->target = 0;
+    callback->inUse = false;
+    callback->nextFree = freeSlot;
+    freeSlot = slot;
+}
+
+void Timer::removeCallback(unsigned slot)
+{
+    PendingCallback * callback = &slots[slot];
+
+    heapRemove(callback->executeInSleep ? HEAP_EXECUTE_IN_SLEEP : HEAP_NO_EXECUTE_IN_SLEEP,
+               callback->heapIndex);
+    releaseCallback(slot);
+}
+
 void Timer::expired()
 {
     fire(false);
@@ -43,35 +267,40 @@ unsigned Timer::fire(bool fromSleep) // returns min time to next item to be fire
     restart:
 
     NvU64 now = getTimeUs();
-    NvU64 nearest = (NvU64)-1;
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); )
+    unsigned next = DP_TIMER_INVALID_SLOT;
+
+    //
+    //  The earliest callback is at the root of one of the heaps.  Callbacks
+    //  that may not run from sleep() are not considered at all in that case.
+    //
+    if (heapSize[HEAP_EXECUTE_IN_SLEEP])
+        next = heap[HEAP_EXECUTE_IN_SLEEP][0];
+
+    if (!fromSleep && heapSize[HEAP_NO_EXECUTE_IN_SLEEP])
     {
-        if (fromSleep && !i->executeInSleep) {
-            i = (PendingCallback*)i->next;
-            continue;
-        }
+        unsigned candidate = heap[HEAP_NO_EXECUTE_IN_SLEEP][0];
+        if (next == DP_TIMER_INVALID_SLOT || before(candidate, next))
+            next = candidate;
+    }
 
-        if (now >= i->timestamp)
-        {
-            const void * context = i->context;
-            TimerCallback * target = i->target;
-            delete i;
-            if (target)
-                target->expired(context);           // Take care, the client may have made
-                                                    // a recursive call to fire in here.
-                                                    // Easy solution: Restart at front of list.
-                                                    //    current time may have also changed
-                                                    //    drastically from a nested sleep
-            goto restart;
-        }
-        else
-        {
-            if (i->timestamp < nearest)
-                nearest = i->timestamp;
-            i = (PendingCallback*)i->next;
-        }
+    if (next == DP_TIMER_INVALID_SLOT)
+        return (unsigned)(((NvU64)-1 - now + 999) / 1000);
+
+    if (now >= slots[next].timestamp)
+    {
+        const void * context = slots[next].context;
+        TimerCallback * target = slots[next].target;
+        removeCallback(next);
+        if (target)
+            target->expired(context);           // Take care, the client may have made
+                                                // a recursive call to fire in here.
+                                                // Easy solution: Restart from the heap root.
+                                                //    current time may have also changed
+                                                //    drastically from a nested sleep
+        goto restart;
     }
-    unsigned minleft = (unsigned)((nearest - now + 999)/ 1000);
+
+    unsigned minleft = (unsigned)((slots[next].timestamp - now + 999)/ 1000);
     return minleft;
 }
 
@@ -93,22 +322,16 @@ void Timer::_pump(unsigned milliseconds, bool fromSleep)
 //  Queue a timer callback.
 //      Unless the dont-execute-in-sleep flag is set
 //
-void Timer::queueCallback(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep) 
+Timer::CallbackHandle Timer::queueCallback(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep) 
 {
     NvU64 now = getTimeUs();
-    PendingCallback * callback = new PendingCallback();
-    if (callback == NULL)
-    {
-        DP_LOG(("DP> %s: Failed to allocate callback",
-                    __FUNCTION__));
-        return;
-    }
-    callback->target = target;
-    callback->context = context;
-    callback->timestamp = now + milliseconds * 1000;
-    callback->executeInSleep = executeInSleep;
-    pending.insertBack(callback);
+    CallbackHandle handle = insertCallback(target, context, now + milliseconds * 1000,
+                                           nextSequence++, executeInSleep);
+    if (!handle)
+        return 0;
+
     raw->queueCallback(this, milliseconds);
+    return handle;
 }
 
 NvU64 Timer::getTimeUs() 
@@ -127,73 +350,100 @@ void Timer::cancelCallbacks(Timer::TimerCallback * to)
 {
     if (!to)
         return;
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        if (i->target == to)
-            i->target = 0;
+
+    while (to->firstPending != DP_TIMER_INVALID_SLOT)
+    {
+        DP_ASSERT(slots[to->firstPending].target == to);
+        removeCallback(to->firstPending);
+    }
 }
 
 void Timer::cancelCallback(Timer::TimerCallback * to, const void * context) 
 {
     if (!to)
         return;
-    for (PendingCallback * i = (PendingCallback *)pending.begin(); i!=pending.end(); i = (PendingCallback*)i->next)
-        if (i->target == to && i->context == context) 
-            i->target = 0;
+
+    unsigned slot = to->firstPending;
+    while (slot != DP_TIMER_INVALID_SLOT)
+    {
+        unsigned next = slots[slot].targetNext;
+
+        DP_ASSERT(slots[slot].target == to);
+        if (slots[slot].context == context)
+            removeCallback(slot);
+        slot = next;
+    }
 }
 
-// Queue callbacks in order.
-void Timer::queueCallbackInOrder(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep) 
+//
+//  Cancel the single callback identified by a handle from queueCallback.
+//  Returns false if that callback already fired or was cancelled.
+//
+bool Timer::cancelCallback(CallbackHandle handle)
 {
-    NvU64 now = getTimeUs();
-    PendingCallback * callback = new PendingCallback();
-    callback->target = target;
-    callback->context = context;
-    callback->timestamp = now + milliseconds * 1000;
-    callback->executeInSleep = executeInSleep;
+    unsigned slot = (unsigned)(handle & 0xFFFFFFFF) - 1;
 
-    //Figure out where to insert the current callback
-    Timer::PendingCallback* i;
-
-    for (i = (PendingCallback*)pending.begin(); i != pending.end();)
-    {
-        // only for the given context.
-        if(i->context == context)
-        {
-            if(i->timestamp > callback->timestamp)
-                break;
-        }
-        i = (PendingCallback*) i->next;
-    }
-    if (i == pending.end())
-    {
-        pending.insertBack(callback);
-    }
-    else 
+    if (!handle || slot >= slotCount ||
+        !slots[slot].inUse || slots[slot].generation != (unsigned)(handle >> 32))
     {
-        pending.insertBefore(i, callback);
+        return false;
     }
 
-    raw->queueCallback(this, milliseconds);
+    removeCallback(slot);
+    return true;
+}
+
+//
+//  Queue callbacks in order.
+//      Callbacks with equal timestamps already fire in the order they were
+//      queued, so callbacks on one context always complete in order.
+//
+Timer::CallbackHandle Timer::queueCallbackInOrder(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep) 
+{
+    return queueCallback(target, context, milliseconds, executeInSleep);
 }
 
 void Timer::cancelAllCallbacks()
 {
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        i->target = 0;
+    for (unsigned which = 0; which < HEAP_COUNT; which++)
+    {
+        for (unsigned i = 0; i < heapSize[which]; i++)
+            releaseCallback(heap[which][i]);
+        heapSize[which] = 0;
+    }
 }
 
+//
+//  Walks the pending callbacks once, keeping those of the given context,
+//  and rebuilds the heaps from what is left.
+//
 void Timer::cancelCallbacksWithoutContext(const  void * context)
 {
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        if(i->context != context)
-            i->target = 0;
+    for (unsigned which = 0; which < HEAP_COUNT; which++)
+    {
+        unsigned kept = 0;
+
+        for (unsigned i = 0; i < heapSize[which]; i++)
+        {
+            unsigned slot = heap[which][i];
+            if (slots[slot].context == context)
+                heapPlace(which, kept++, slot);
+            else
+                releaseCallback(slot);
+        }
+
+        heapSize[which] = kept;
+        for (unsigned i = kept / 2; i > 0; i--)
+            heapSiftDown(which, i - 1);
+    }
 }
 
 bool Timer::checkCallbacksOfSameContext(const void * context)
 {
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        if(i->context == context)
-            return true;
+    for (unsigned which = 0; which < HEAP_COUNT; which++)
+        for (unsigned i = 0; i < heapSize[which]; i++)
+            if (slots[heap[which][i]].context == context)
+                return true;
 
     return false;
 }
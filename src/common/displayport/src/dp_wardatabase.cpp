@@ -33,568 +33,642 @@
 
 using namespace DisplayPort;
 
+//
+//  The work around database is kept as data rather than code.  Each quirk
+//  is a row keyed by (OUI, model name) or (manufacturer ID, product ID range,
+//  year/week range), and yields a mask of WAR flags.  The EDID table is sorted
+//  by manufacturer ID then product ID, with no overlapping product ranges for
+//  a manufacturer, so a lookup is a single binary search.
+//
+
+enum
+{
+    DP_OUI_WAR_KEEP_OPT_LINK_ALIVE          = (1 << 0),
+    DP_OUI_WAR_NO_FALLBACK_IN_POST_LQA      = (1 << 1),
+    DP_OUI_WAR_LT2FEC_LATENCY               = (1 << 2),
+    DP_OUI_WAR_DSC_CAP_BASED_ON_PARENT      = (1 << 3),
+};
+
+struct OuiWorkAround
+{
+    unsigned     ouiId;
+    const char * modelName;         // Prefix of the sink's model name
+    NvU32        flags;
+};
+
+static const OuiWorkAround ouiWorkArounds[] =
+{
+    //
+    // Megachips Mystique
+    //
+    // Mystique based link box for HTC Vive has a peculiar behaviour
+    // of sending a link retraining pulse if the link is powered down in the absence
+    // of an active stream. Bug# 1793084. Set the flag so that link is not powered down.
+    //
+    { 0xE18000, "Dp1.1",    DP_OUI_WAR_KEEP_OPT_LINK_ALIVE },
+
+    //
+    // ASUS monitor loses link sometimes during assessing link or link training.
+    // So if we retrain link by lowering config from HBR2 to HBR we see black screen
+    // Set the flag so that we first retry link training with same link config
+    // before following link training fallback. Bug #1846925
+    //
+    { 0xE18000, "Dp1.2",    DP_OUI_WAR_NO_FALLBACK_IN_POST_LQA },
+
+    //
+    // Synaptics
+    //
+    // Extended latency from link-train end to FEC enable pattern
+    // to avoid link lost or blank screen with Synaptics branch.
+    // (Bug 2561206)
+    //
+    // Synaptics branch device doesn't support Virtual Peer Devices so DSC
+    // capability of downstream device should be decided based on device's own
+    // and its parent's DSC capability
+    //
+    // Dock SKU ID:
+    // Dell    Salomon-WD19TB SYNAS1
+    // HP      Hook           SYNAS3
+    // HP      Adira-A        SYNAS#
+    // Lenovo                 SYNAS" / SYNAS2
+    //
+    { 0x24CC90, "SYNAS1",   DP_OUI_WAR_LT2FEC_LATENCY | DP_OUI_WAR_DSC_CAP_BASED_ON_PARENT },
+    { 0x24CC90, "SYNAS2",   DP_OUI_WAR_LT2FEC_LATENCY | DP_OUI_WAR_DSC_CAP_BASED_ON_PARENT },
+    { 0x24CC90, "SYNAS3",   DP_OUI_WAR_LT2FEC_LATENCY | DP_OUI_WAR_DSC_CAP_BASED_ON_PARENT },
+    { 0x24CC90, "SYNAS#",   DP_OUI_WAR_LT2FEC_LATENCY | DP_OUI_WAR_DSC_CAP_BASED_ON_PARENT },
+    { 0x24CC90, "SYNAS\"",  DP_OUI_WAR_LT2FEC_LATENCY | DP_OUI_WAR_DSC_CAP_BASED_ON_PARENT },
+};
+
+static NvU32 lookupOuiWARs(unsigned ouiId, const char * modelName)
+{
+    NvU32 flags = 0;
+
+    for (unsigned i = 0; i < sizeof(ouiWorkArounds) / sizeof(ouiWorkArounds[0]); i++)
+    {
+        const OuiWorkAround & war = ouiWorkArounds[i];
+        unsigned j;
+
+        if (war.ouiId != ouiId)
+            continue;
+
+        for (j = 0; war.modelName[j] && (modelName[j] == war.modelName[j]); j++)
+            ;
+
+        if (!war.modelName[j])
+            flags |= war.flags;
+    }
+
+    return flags;
+}
+
+void DisplayPort::applyOuiWorkArounds(unsigned ouiId, const char * modelName,
+                                      bool bDscMstCapBug3143315, OuiWorkAroundState & state)
+{
+    NvU32 flags = lookupOuiWARs(ouiId, modelName);
+
+    if (flags & DP_OUI_WAR_KEEP_OPT_LINK_ALIVE)
+    {
+        state.bKeepOptLinkAlive = true;
+    }
+
+    if (flags & DP_OUI_WAR_NO_FALLBACK_IN_POST_LQA)
+    {
+        state.bNoFallbackInPostLQA = true;
+    }
+
+    if (flags & DP_OUI_WAR_LT2FEC_LATENCY)
+    {
+        state.LT2FecLatencyMs = 57;
+    }
+
+    if ((flags & DP_OUI_WAR_DSC_CAP_BASED_ON_PARENT) && bDscMstCapBug3143315)
+    {
+        state.bDscCapBasedOnParent = true;
+    }
+}
+
 void ConnectorImpl::applyOuiWARs()
 {
-    switch (ouiId)
+    OuiWorkAroundState state;
+
+    state.bKeepOptLinkAlive = bKeepOptLinkAlive;
+    state.bNoFallbackInPostLQA = bNoFallbackInPostLQA;
+    state.LT2FecLatencyMs = LT2FecLatencyMs;
+    state.bDscCapBasedOnParent = bDscCapBasedOnParent;
+
+    applyOuiWorkArounds(ouiId, modelName, bDscMstCapBug3143315, state);
+
+    bKeepOptLinkAlive = state.bKeepOptLinkAlive;
+    bNoFallbackInPostLQA = state.bNoFallbackInPostLQA;
+    LT2FecLatencyMs = state.LT2FecLatencyMs;
+    bDscCapBasedOnParent = state.bDscCapBasedOnParent;
+}
+
+enum
+{
+    DP_EDID_WAR_EXTENSION_COUNT_DISABLED    = (1 << 0),
+    DP_EDID_WAR_DATA_FORCED                 = (1 << 1),
+    DP_EDID_WAR_DISABLE_DPCD_POWER_OFF      = (1 << 2),
+    DP_EDID_WAR_FORCE_MAX_LINK_CONFIG       = (1 << 3),
+    DP_EDID_WAR_POWER_ON_BEFORE_LT          = (1 << 4),
+    DP_EDID_WAR_IGNORE_REDUNDANT_HOTPLUG    = (1 << 5),
+    DP_EDID_WAR_DELAY_AFTER_D3              = (1 << 6),
+    DP_EDID_WAR_KEEP_LINK_ALIVE             = (1 << 7),
+    DP_EDID_WAR_USE_LEGACY_ADDRESS          = (1 << 8),
+    DP_EDID_WAR_REASSESS_MAX_LINK           = (1 << 9),
+    DP_EDID_WAR_IGNORE_DSC_CAP              = (1 << 10),
+};
+
+//
+//  Optional per-quirk hook.  It may verify more of the EDID (eg. the panel
+//  name) and patch the EDID data.  The quirk's flags only apply if it
+//  returns true.
+//
+typedef bool (*EdidWorkAroundFixup)(Buffer * buffer);
+
+struct EdidWorkAround
+{
+    NvU16               manufId;
+    NvU16               productIdFirst;
+    NvU16               productIdLast;
+    NvU16               yearWeekFirst;
+    NvU16               yearWeekLast;
+    NvU32               flags;
+    EdidWorkAroundFixup fixup;
+    const char *        description;
+};
+
+static bool edidMatchesName(Buffer * buffer, unsigned offset, const char * name)
+{
+    for (unsigned i = 0; name[i]; i++)
     {
-        // Megachips Mystique
-        case 0xE18000:
-            if (((modelName[0] == 'D') && (modelName[1] == 'p') && (modelName[2] == '1') &&
-                        (modelName[3] == '.') && (modelName[4] == '1')))
-            {
-                //
-                // Mystique based link box for HTC Vive has a peculiar behaviour
-                // of sending a link retraining pulse if the link is powered down in the absence
-                // of an active stream. Bug# 1793084. Set the flag so that link is not powered down.
-                //
-                bKeepOptLinkAlive = true;
-            }
-
-            if (((modelName[0] == 'D') && (modelName[1] == 'p') && (modelName[2] == '1') &&
-                        (modelName[3] == '.') && (modelName[4] == '2')))
-            {
-                //
-                // ASUS monitor loses link sometimes during assessing link or link training.
-                // So if we retrain link by lowering config from HBR2 to HBR we see black screen
-                // Set the flag so that we first retry link training with same link config
-                // before following link training fallback. Bug #1846925
-                //
-                bNoFallbackInPostLQA = true;
-            }
-            break;
-
-        // Synaptics
-        case 0x24CC90:
-            if ((modelName[0] == 'S') && (modelName[1] == 'Y') && (modelName[2] == 'N') &&
-                (modelName[3] == 'A') && (modelName[4] == 'S') &&
-                ((modelName[5] == '1') || (modelName[5] == '2') ||
-                 (modelName[5] == '3') || (modelName[5] == '#') ||
-                 (modelName[5] == '\"')))
-            {
-                //
-                // Extended latency from link-train end to FEC enable pattern
-                // to avoid link lost or blank screen with Synaptics branch.
-                // (Bug 2561206)
-                //
-                // Dock SKU ID:
-                // Dell    Salomon-WD19TB SYNAS1
-                // HP      Hook           SYNAS3
-                // HP      Adira-A        SYNAS#
-                // Lenovo                 SYNAS" / SYNAS2
-                //
-                LT2FecLatencyMs = 57;
-
-                if (bDscMstCapBug3143315)
-                {
-                    //
-                    // Synaptics branch device doesn't support Virtual Peer Devices so DSC
-                    // capability of downstream device should be decided based on device's own
-                    // and its parent's DSC capability
-                    //
-                    bDscCapBasedOnParent = true;
-                }
-            }
-            break;
+        if (buffer->data[offset + i] != (NvU8)name[i])
+            return false;
     }
+
+    return true;
 }
 
-void Edid::applyEdidWorkArounds(NvU32 warFlag, const DpMonitorDenylistData *pDenylistData)
+// Bug 451868: Acer AL1512 monitor has a wrong extension count:
+static bool fixupAcerAL1512(Buffer * buffer)
+{
+    // clear the extension count
+    buffer->data[0x7E] = 0;
+    return true;
+}
+
+//
+// Westinghouse 37" 1080p TV.  LVM-37w3  (Port DVI1 EDID).
+// Westinghouse 42" 1080p TV.  LVM-42w2  (Port DVI1 EDID).
+//
+static bool fixupWestinghouse(Buffer * buffer)
+{
+    // Claims HDMI support, but audio causes picture corruption.
+    // Removing HDMI extension block
+
+    if (buffer->getLength() > 0x80 &&
+        buffer->data[0x7E] == 1 &&             // extension block present
+        buffer->data[0x80] == 0x02 &&          // CEA block
+        buffer->data[0x81] == 0x03 &&          //    revision 3
+        !(buffer->data[0x83] & 0x40))          //  No basic audio, must not be the HDMI port
+    {
+        // clear the extension count
+        buffer->data[0x7E] = 0;
+        return true;
+    }
+
+    return false;
+}
+
+static bool fixupIbmT210(Buffer * buffer)
+{
+    // Override IBM T210. IBM T210 reports 2048x1536x60Hz in the edid but it's
+    // actually 2048x1536x40Hz. See bug 76347. This hack was, earlier, in disp driver
+    // Now it's being moved down to keep all overrides in same place.
+    // This hack was also preventing disp driver from comparing entire edid when
+    // trying to figure out whether or not the edid for some device has changed.
+    buffer->data[0x36] = 0x32;
+    buffer->data[0x37] = 0x3E;
+    return true;
+}
+
+// Some Gateway monitors present the eMachines mfg code, so these two cases are combined.
+// Future fixes may require the two cases to be separated.
+// Fix for Bug 343870.  NOTE: Problem found on G80; fix applied to all GPUs.
+static bool fixupGatewayEMachines(Buffer * buffer)
 {
+    // if detailed pixel clock frequency = 106.50MHz
+    if ( (buffer->data[0x36] == 0x9A) &&
+         (buffer->data[0x37] == 0x29) )
+    {
+        // then change detailed pixel clock frequency to 106.54MHz to fix bug 343870
+        buffer->data[0x36] = 0x9E;
+        buffer->data[0x37] = 0x29;
+        return true;
+    }
 
-    unsigned ManufacturerID = this->getManufId();
-    unsigned ProductID = this->getProductId();
-    unsigned YearWeek = this->getYearWeek();
+    return false;
+}
 
+// INX L15CX monitor has an invalid detailed timing 10x311 @ 78Hz.
+static bool fixupInxL15CX(Buffer * buffer)
+{
+    // remove detailed timing #4: zero out the first 3 bytes of DTD#4 block
+    buffer->data[0x6c] = 0x0;
+    buffer->data[0x6d] = 0x0;
+    buffer->data[0x6e] = 0x0;
+    return true;
+}
+
+//
+// Acer have faulty AUO eDP panels which have
+// wrong HBlank in the EDID. Correcting it here.
+// Bugs 907998, 1001160
+//
+static bool fixupAuoHBlank(Buffer * buffer)
+{
+    buffer->data[0x39] = 0x4B; // new hblank width: 75
+    buffer->data[0x3F] = 0x1B; // new hsync pulse width: 27
+    return true;
+}
+
+//
+// Patch EDID for Quanta - Toshiba LG 1440x900 panel.  See Bug 201428
+// Must 1st verify that we have that panel.  It has MFG id 32, 0C
+//    BUT product ID for this (and other different LG panels) are 0000.
+//    So verify that the last "Custom Timing" area of the EDID has
+//    a "Monitor Description" of type FE = "ASCII Data String" which
+//    has this panel's name = "LP171WX2-A4K5".
+//
+static bool fixupLplQuanta(Buffer * buffer)
+{
+    if (edidMatchesName(buffer, 0x71, "LP171WX2-A4K5"))
+    {
+        //
+        // Was 0x95, 0x25 = -> 0x2595 = 9621 or 96.21 Mhz.
+        //     96,210,000 / 1760 / 912 = 59.939 Hz
+        // Want 60 * 1760 * 912 ~= 9631 or 96.31 MHz
+        //     9631 = 0x259F -> 0x9F 0x25.
+        // So, change byte 36 from 0x95 to 0x9F.
+        //
+        buffer->data[0x36] = 0x9F;
+        return true;
+    }
+
+    return false;
+}
+
+//
+// Patch EDID for MSI - LG LPL 1280x800 panel.  See Bug 359313
+// Must 1st verify that we have that panel.  It has MFG id 32, 0C
+//    BUT product ID for this (and other different LG panels) are E300.
+//    So verify that the last "Custom Timing" area of the EDID has
+//    a "Monitor Description" of type FE = "ASCII Data String" which
+//    has this panel's name = "LP154WX4-TLC3".
+//
+static bool fixupLplMsi(Buffer * buffer)
+{
+    if (edidMatchesName(buffer, 0x71, "LP154WX4-TLC3"))
+    {
+        //
+        // Was 0xBC, 0x1B = -> 0x1BBC = 7100 or 71.00 Mhz.
+        //     71,000,000 / 1488 / 826 = 59.939 Hz
+        // Want 60 * 1488 * 826 ~= 7111 or 71.11 MHz
+        //     7111 = 0x1BC7 -> 0xC7 0x1B.
+        // So, change byte 36 from 0xBC to 0xC7.
+        //
+        buffer->data[0x36] = 0xC7;
+        return true;
+    }
+
+    return false;
+}
+
+//
+// Override for Haier TV to remove resolution
+// 1366x768 from EDID data. Refer bug 351680 & 327891
+// Overriding 18 bytes from offset 0x36.
+//
+static bool fixupHaierTv(Buffer * buffer)
+{
+    static const NvU8 dtd[18] =
+    {
+        0x01, 0x1D, 0x00, 0x72, 0x51, 0xD0, 0x1E, 0x20, 0x6E,
+        0x28, 0x55, 0x00, 0xC4, 0x8E, 0x21, 0x00, 0x00, 0x1E
+    };
+
+    dpMemCopy(&buffer->data[0x36], dtd, sizeof(dtd));
+    return true;
+}
+
+//
+// Bug 200113041
+// Need to be unique to identify this Sharp panel. Besides
+// manufacturer ID and ProductID, we have to add the mode
+// name to make this happen as LQ156D1JW05 in ASCII.
+//
+static bool checkSharpLQ156D1JW05(Buffer * buffer)
+{
+    return edidMatchesName(buffer, 0x71, "LQ156D1JW05\n ");
+}
+
+//
+// Bug 200113041
+// Need to be unique to identify this MEI-Panasonic panel.
+// Besides manufacturer ID and ProductID, we have to add the
+// model name to make this happen as VVX17P051J00^ in ASCII.
+//
+static bool checkPanasonicVVX17P051J00(Buffer * buffer)
+{
+    return edidMatchesName(buffer, 0x71, "VVX17P051J00\n");
+}
+
+#define DP_EDID_WAR_ANY_PRODUCT     0x0000, 0xFFFF
+#define DP_EDID_WAR_PRODUCT(id)     (id), (id)
+#define DP_EDID_WAR_ANY_DATE        0x0000, 0xFFFF
+
+// Sorted by manufacturer ID, then product ID.  See findEdidWorkAround().
+static const EdidWorkAround edidWorkArounds[] =
+{
+    // LPL
+    { 0x0C32, DP_EDID_WAR_PRODUCT(0x0000), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupLplQuanta,
+      "Edid overrid on Quanta - Toshiba LG 1440x900. Correcting pclk. Bug 201428" },
+    { 0x0C32, DP_EDID_WAR_PRODUCT(0xE300), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupLplMsi,
+      "Edid overrid on  MSI - LG LPL 1280x800. Correcting pclk. Bug 359313" },
+
+    // Apple
+    { 0x1006, DP_EDID_WAR_PRODUCT(0x9227), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_POWER_ON_BEFORE_LT, NULL,
+      "WAR for Apple thunderbolt J29 panel. Monitor needs to be powered up before LT. Bug 933051" },
+
+    //
+    // Sharp
+    //
+    // Sharp EDPs that declares DP1.2 but doesn't implement ESI address space
+    // use the Legacy address space for DP1.2 panel.
+    //
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x1414), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "Sharp EDP implements only Legacy interrupt address range" },
+    //
+    // HP Valor QHD+ N15P-Q3 EDP needs 50 ms delay
+    // after D3 to avoid black screen issues.
+    //
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x141C), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DELAY_AFTER_D3, NULL,
+      "HP Valor QHD+ N15P-Q3 Sharp EDP needs 50 ms after D3. bug 1520011" },
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x1430), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "Sharp EDP implements only Legacy interrupt address range" },
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x143B), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, checkSharpLQ156D1JW05,
+      "Sharp EDP implements only Legacy interrupt address range" },
+    { 0x104D, 0x1445, 0x1446, DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "Sharp EDP implements only Legacy interrupt address range" },
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x144C), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "Sharp EDP implements only Legacy interrupt address range" },
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x1450), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "Sharp EDP implements only Legacy interrupt address range" },
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x145E), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "Sharp EDP implements only Legacy interrupt address range" },
+    { 0x104D, DP_EDID_WAR_PRODUCT(0x1467), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "Sharp EDP implements only Legacy interrupt address range" },
+
+    // Unigraf
+    { 0x1863, DP_EDID_WAR_ANY_PRODUCT, DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_KEEP_LINK_ALIVE, NULL,
+      "Unigraf device, keep link alive during detection" },
+
+    // INX
+    { 0x2C0C, DP_EDID_WAR_PRODUCT(0x1502), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupInxL15CX,
+      "Edid overrid on INX L15CX. Removing invalid detailed timing 10x311 @ 78Hz" },
+
+    // IBM T210, 2001 Week 50
+    { 0x4D24, DP_EDID_WAR_PRODUCT(0x1A03), 0x0B32, 0x0B32,
+      DP_EDID_WAR_DATA_FORCED, fixupIbmT210,
+      "Edid overrid on IBM T210. 2048x1536x60Hz(misreported) -> 2048x1536x40Hz. Bug 76347" },
+
+    // Asus
+    { 0x6D1E, DP_EDID_WAR_PRODUCT(0x7707), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_DSC_CAP, NULL,
+      "Panel incorrectly exposing DSC capability. Ignoring it. Bug 3543158" },
+
+    //
+    // This panel advertise DSC capabilities, but panel doesn't support DSC
+    // So ignoring DSC capability on this panel
+    //
+    { 0x6F0E, DP_EDID_WAR_PRODUCT(0x1609), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_DSC_CAP, NULL,
+      "Ignoring DSC capability on Lenovo CSOT 1609 Panel. Bug 3444252" },
+
+    // NCP
+    { 0x7038, DP_EDID_WAR_PRODUCT(0x005F), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_DSC_CAP, NULL,
+      "NCP panels incorrectly exposing DSC capability. Ignoring it." },
+
+    // Acer AL1512
+    { 0x7204, DP_EDID_WAR_PRODUCT(0xAD15), 0x0000, 0x0D01,
+      DP_EDID_WAR_EXTENSION_COUNT_DISABLED | DP_EDID_WAR_DATA_FORCED, fixupAcerAL1512,
+      "Edid override on Acer AL1512. Disabling extension count.Bug 451868" },
+
+    // SKY
+    { 0x794D, DP_EDID_WAR_PRODUCT(0x9880), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupHaierTv,
+      "Edid overrid on  Haier TV. Removing 1366x768. bug 351680 & 327891" },
+
+    // MSI
+    { 0x834C, DP_EDID_WAR_PRODUCT(0x4C48), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "MSI eDP implements only Legacy interrupt address range" },
+
+    // Westinghouse
+    { 0x855C, DP_EDID_WAR_PRODUCT(0x3703), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_EXTENSION_COUNT_DISABLED | DP_EDID_WAR_DATA_FORCED, fixupWestinghouse,
+      "Edid overrid on Westinghouse AL1512 LVM- <37/42> w <2/3>. Disabling extension count." },
+    { 0x855C, DP_EDID_WAR_PRODUCT(0x4202), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_EXTENSION_COUNT_DISABLED | DP_EDID_WAR_DATA_FORCED, fixupWestinghouse,
+      "Edid overrid on Westinghouse AL1512 LVM- <37/42> w <2/3>. Disabling extension count." },
+
+    // Sharp-CerebrEx
+    { 0x8F34, DP_EDID_WAR_PRODUCT(0xAA55), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_FORCE_MAX_LINK_CONFIG, NULL,
+      "Force maximum link config WAR required on Sharp-CerebrEx panel." },
+
+    // EMA (eMachines), product id's range from decimal 1910 to 1913
+    { 0xA115, 0x0776, 0x0779, DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupGatewayEMachines,
+      "Edid overrid on GWY/EMA. 106.50MHz(misreported) -> 106.50MHz.Bug 343870" },
+
+    // MEI-Panasonic
+    { 0xA934, DP_EDID_WAR_PRODUCT(0x96A2), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, checkPanasonicVVX17P051J00,
+      "MEI-Panasonic EDP implements only Legacy interrupt address range" },
+
+    // Dell U2713H has problem with LQA. Disable it.
+    { 0xAC10, DP_EDID_WAR_PRODUCT(0xA092), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_REASSESS_MAX_LINK, NULL,
+      "Dell U2713H reassess max link" },
+    { 0xAC10, DP_EDID_WAR_PRODUCT(0xF046), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_REASSESS_MAX_LINK, NULL,
+      "Dell U2713H reassess max link" },
+
+    // CMN
+    { 0xAE0D, DP_EDID_WAR_PRODUCT(0x1747), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS, NULL,
+      "CMN eDP implements only Legacy interrupt address range" },
+
+    // AUO
+    { 0xAF06, DP_EDID_WAR_PRODUCT(0x103C), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupAuoHBlank,
+      "Edid overrid on AUO eDP panel. Modifying HBlank and HSync pulse width. Bugs 907998, 1001160" },
+    // Bug 1792962 - Panel got glitch on D3 write, also disable DPCD power off.
+    { 0xAF06, DP_EDID_WAR_PRODUCT(0x109B), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS | DP_EDID_WAR_DISABLE_DPCD_POWER_OFF, NULL,
+      "AUO eDP implements only Legacy interrupt address range. Disable DPCD Power Off" },
+    { 0xAF06, DP_EDID_WAR_PRODUCT(0x113C), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupAuoHBlank,
+      "Edid overrid on AUO eDP panel. Modifying HBlank and HSync pulse width. Bugs 907998, 1001160" },
+    { 0xAF06, DP_EDID_WAR_PRODUCT(0x119B), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_USE_LEGACY_ADDRESS | DP_EDID_WAR_DISABLE_DPCD_POWER_OFF, NULL,
+      "AUO eDP implements only Legacy interrupt address range. Disable DPCD Power Off" },
+
+    //
+    // EIZO
+    //
+    // The EIZO FlexScan SX2762W generates a redundant long HPD
+    // pulse after a modeset, which triggers another modeset on GPUs
+    // without flush mode, triggering an infinite link training
+    // loop.
+    //
+    { 0xC315, DP_EDID_WAR_PRODUCT(0x2227), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_REDUNDANT_HOTPLUG, NULL,
+      "EIZO FlexScan SX2762W generates redundant hotplugs (bug 1048796)" },
+
+    // Unigraf
+    { 0xC754, DP_EDID_WAR_ANY_PRODUCT, DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_KEEP_LINK_ALIVE, NULL,
+      "Unigraf device, keep link alive during detection" },
+
+    // BenQ
+    { 0xD109, DP_EDID_WAR_PRODUCT(0x7F2B), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_REDUNDANT_HOTPLUG, NULL,
+      "BenQ GSync power on/off redundant hotplug" },
+    { 0xD109, DP_EDID_WAR_PRODUCT(0x7F2F), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_REDUNDANT_HOTPLUG, NULL,
+      "BenQ GSync power on/off redundant hotplug" },
+
+    // LG display can't be driven at FHD with 2*RBR. Force max link config
+    { 0xE430, DP_EDID_WAR_PRODUCT(0x0469), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_FORCE_MAX_LINK_CONFIG, NULL,
+      "Force maximum link config WAR required on LG panel. bug 1649626" },
+
+    // BOE
+    { 0xE509, DP_EDID_WAR_PRODUCT(0x0974), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_DSC_CAP, NULL,
+      "BOE panels incorrectly exposing DSC capability. Ignoring it." },
+    { 0xE509, DP_EDID_WAR_PRODUCT(0x0977), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_DSC_CAP, NULL,
+      "BOE panels incorrectly exposing DSC capability. Ignoring it." },
+    { 0xE509, DP_EDID_WAR_PRODUCT(0x09D9), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_IGNORE_DSC_CAP, NULL,
+      "BOE panels incorrectly exposing DSC capability. Ignoring it." },
+
+    //
+    // HP
+    //
+    // WAR for bug 1643712 - Issue specific to HP Z1 G2 (Zeus) All-In-One
+    // Putting the Rx in power save mode before BL_EN is deasserted, makes this specific sink unhappy
+    // Bug 1559465 will address the right power down sequence. We need to revisit this WAR once Bug 1559465 is fixed.
+    //
+    { 0xF022, DP_EDID_WAR_PRODUCT(0x192F), DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DISABLE_DPCD_POWER_OFF, NULL,
+      "Disable DPCD Power Off. HP Z1 G2 (Zeus) AIO Bug 1643712" },
+
+    // GWY (Gateway), product id's range from decimal 1910 to 1913
+    { 0xF91E, 0x0776, 0x0779, DP_EDID_WAR_ANY_DATE,
+      DP_EDID_WAR_DATA_FORCED, fixupGatewayEMachines,
+      "Edid overrid on GWY/EMA. 106.50MHz(misreported) -> 106.50MHz.Bug 343870" },
+};
+
+static const EdidWorkAround * findEdidWorkAround(unsigned manufId, unsigned productId, unsigned yearWeek)
+{
+    unsigned low = 0;
+    unsigned high = sizeof(edidWorkArounds) / sizeof(edidWorkArounds[0]);
+
+    while (low < high)
+    {
+        unsigned mid = (low + high) / 2;
+        const EdidWorkAround * war = &edidWorkArounds[mid];
+
+        if (manufId < war->manufId ||
+            (manufId == war->manufId && productId < war->productIdFirst))
+        {
+            high = mid;
+        }
+        else if (manufId > war->manufId || productId > war->productIdLast)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            if (yearWeek < war->yearWeekFirst || yearWeek > war->yearWeekLast)
+                return NULL;
+
+            return war;
+        }
+    }
+
+    return NULL;
+}
+
+void Edid::applyEdidWorkArounds(NvU32 warFlag, const DpMonitorDenylistData *pDenylistData)
+{
     //
     // Work around EDID problems, using manufacturer, product ID, and date of manufacture,
     // to identify each case.
     //
-    switch (ManufacturerID)
-    {
-        // Apple
-        case 0x1006:
-            if (0x9227 == ProductID)
-            {
-                this->WARFlags.powerOnBeforeLt = true;
-                DP_LOG(("DP-WAR> WAR for Apple thunderbolt J29 panel"));
-                DP_LOG(("DP-WAR>     - Monitor needs to be powered up before LT. Bug 933051"));
-            }
-            break;
-
-        // Acer
-        case 0x7204:
-            // Bug 451868: Acer AL1512 monitor has a wrong extension count:
-            if(0xad15 == ProductID && YearWeek <= 0x0d01)
-            {
-                // clear the extension count
-                buffer.data[0x7E] = 0;
-                this->WARFlags.extensionCountDisabled = true;
-                this->WARFlags.dataForced = true;
-                DP_LOG(("DP-WAR> Edid override on Acer AL1512"));
-                DP_LOG(("DP-WAR>     - Disabling extension count.Bug 451868"));
-            }
-            break;
-
-        // Westinghouse
-        case 0x855C:
-
-            // Westinghouse 37" 1080p TV.  LVM-37w3  (Port DVI1 EDID).
-            // Westinghouse 42" 1080p TV.  LVM-42w2  (Port DVI1 EDID).
-            if (ProductID == 0x3703 || ProductID == 0x4202)
-            {
-                // Claims HDMI support, but audio causes picture corruption.
-                // Removing HDMI extension block
-
-                if (buffer.getLength() > 0x80 &&
-                    buffer.data[0x7E] == 1 &&             // extension block present
-                    buffer.data[0x80] == 0x02 &&          // CEA block
-                    buffer.data[0x81] == 0x03 &&          //    revision 3
-                    !(buffer.data[0x83] & 0x40))          //  No basic audio, must not be the HDMI port
-                {
-                    // clear the extension count
-                    buffer.data[0x7E] = 0;
-                    this->WARFlags.extensionCountDisabled = true;
-                    this->WARFlags.dataForced = true;
-                    DP_LOG(("DP-WAR> Edid overrid on Westinghouse AL1512 LVM- <37/42> w <2/3>"));
-                    DP_LOG(("DP-WAR>     - Disabling extension count."));
-                }
-            }
-            break;
-
-        // IBM
-        case 0x4D24:
-            if(ProductID == 0x1A03)
-            {
-                // 2001 Week 50
-                if (YearWeek == 0x0B32)
-                {
-                    // Override IBM T210. IBM T210 reports 2048x1536x60Hz in the edid but it's
-                    // actually 2048x1536x40Hz. See bug 76347. This hack was, earlier, in disp driver
-                    // Now it's being moved down to keep all overrides in same place.
-                    // This hack was also preventing disp driver from comparing entire edid when
-                    // trying to figure out whether or not the edid for some device has changed.
-                    buffer.data[0x36] = 0x32;
-                    buffer.data[0x37] = 0x3E;
-                    this->WARFlags.dataForced = true;
-                    DP_LOG(("DP-WAR> Edid overrid on IBM T210"));
-                    DP_LOG(("DP-WAR>    2048x1536x60Hz(misreported) -> 2048x1536x40Hz. Bug 76347"));
-                }
-            }
-            break;
-        // GWY (Gateway) or EMA (eMachines)
-        case 0xF91E: // GWY
-        case 0xA115: // EMA
-            // Some Gateway monitors present the eMachines mfg code, so these two cases are combined.
-            // Future fixes may require the two cases to be separated.
-            // Fix for Bug 343870.  NOTE: Problem found on G80; fix applied to all GPUs.
-            if ((ProductID >= 0x0776 ) && (ProductID <= 0x0779)) // Product id's range from decimal 1910 to 1913
-            {
-                // if detailed pixel clock frequency = 106.50MHz
-                if ( (buffer.data[0x36] == 0x9A) &&
-                     (buffer.data[0x37] == 0x29) )
-                {
-                    // then change detailed pixel clock frequency to 106.54MHz to fix bug 343870
-                    buffer.data[0x36] = 0x9E;
-                    buffer.data[0x37] = 0x29;
-                    this->WARFlags.dataForced = true;
-                    DP_LOG(("DP-WAR> Edid overrid on GWY/EMA"));
-                    DP_LOG(("DP-WAR>   106.50MHz(misreported) -> 106.50MHz.Bug 343870"));
-                }
-            }
-            break;
-
-        // INX
-        case 0x2C0C:
-            // INX L15CX monitor has an invalid detailed timing 10x311 @ 78Hz.
-            if( ProductID == 0x1502)
-            {
-                // remove detailed timing #4: zero out the first 3 bytes of DTD#4 block
-                buffer.data[0x6c] = 0x0;
-                buffer.data[0x6d] = 0x0;
-                buffer.data[0x6e] = 0x0;
-                this->WARFlags.dataForced = true;
-                DP_LOG(("DP-WAR> Edid overrid on INX L15CX"));
-                DP_LOG(("DP-WAR>   Removing invalid detailed timing 10x311 @ 78Hz"));
-            }
-            break;
-
-        // AUO
-        case 0xAF06:
-            if ((ProductID == 0x103C) || (ProductID == 0x113C))
-            {
-                //
-                // Acer have faulty AUO eDP panels which have
-                // wrong HBlank in the EDID. Correcting it here.
-                //
-                buffer.data[0x39] = 0x4B; // new hblank width: 75
-                buffer.data[0x3F] = 0x1B; // new hsync pulse width: 27
-                this->WARFlags.dataForced = true;
-                DP_LOG(("DP-WAR> Edid overrid on AUO eDP panel"));
-                DP_LOG(("DP-WAR> Modifying HBlank and HSync pulse width."));
-                DP_LOG(("DP-WAR> Bugs 907998, 1001160"));
-            }
-            else if (ProductID == 0x109B || ProductID == 0x119B)
-            {
-                this->WARFlags.useLegacyAddress = true;
-                DP_LOG(("DP-WAR> AUO eDP"));
-                DP_LOG(("implements only Legacy interrupt address range"));
-
-                // Bug 1792962 - Panel got glitch on D3 write, apply this WAR.
-                this->WARFlags.disableDpcdPowerOff = true;
-                DP_LOG(("DP-WAR> Disable DPCD Power Off"));
-            }
-            break;
-
-        // LPL
-        case 0x0C32:
-            if (ProductID == 0x0000)
-            {
-                //
-                // Patch EDID for Quanta - Toshiba LG 1440x900 panel.  See Bug 201428
-                // Must 1st verify that we have that panel.  It has MFG id 32, 0C
-                //    BUT product ID for this (and other different LG panels) are 0000.
-                //    So verify that the last "Custom Timing" area of the EDID has
-                //    a "Monitor Description" of type FE = "ASCII Data String" which
-                //    has this panel's name = "LP171WX2-A4K5".
-                //
-                if ( (buffer.data[0x71] == 0x4C) &&
-                    (buffer.data[0x72] == 0x50) &&
-                    (buffer.data[0x73] == 0x31) &&
-                    (buffer.data[0x74] == 0x37) &&
-                    (buffer.data[0x75] == 0x31) &&
-                    (buffer.data[0x76] == 0x57) &&
-                    (buffer.data[0x77] == 0x58) &&
-                    (buffer.data[0x78] == 0x32) &&
-                    (buffer.data[0x79] == 0x2D) &&
-                    (buffer.data[0x7A] == 0x41) &&
-                    (buffer.data[0x7B] == 0x34) &&
-                    (buffer.data[0x7C] == 0x4B) &&
-                    (buffer.data[0x7D] == 0x35) )
-                {
-                    //
-                    // Was 0x95, 0x25 = -> 0x2595 = 9621 or 96.21 Mhz.
-                    //     96,210,000 / 1760 / 912 = 59.939 Hz
-                    // Want 60 * 1760 * 912 ~= 9631 or 96.31 MHz
-                    //     9631 = 0x259F -> 0x9F 0x25.
-                    // So, change byte 36 from 0x95 to 0x9F.
-                    //
-                    buffer.data[0x36] = 0x9F;
-                    this->WARFlags.dataForced = true;
-                    DP_LOG(("DP-WAR> Edid overrid on Quanta - Toshiba LG 1440x900"));
-                    DP_LOG(("DP-WAR>   Correcting pclk. Bug 201428"));
-                }
-            }
-            else
-            if (ProductID == 0xE300)
-            {
-                //
-                // Patch EDID for MSI - LG LPL 1280x800 panel.  See Bug 359313
-                // Must 1st verify that we have that panel.  It has MFG id 32, 0C
-                //    BUT product ID for this (and other different LG panels) are E300.
-                //    So verify that the last "Custom Timing" area of the EDID has
-                //    a "Monitor Description" of type FE = "ASCII Data String" which
-                //    has this panel's name = "LP154WX4-TLC3".
-                //
-                if ( (buffer.data[0x71] == 0x4C) &&
-                    (buffer.data[0x72] == 0x50) &&
-                    (buffer.data[0x73] == 0x31) &&
-                    (buffer.data[0x74] == 0x35) &&
-                    (buffer.data[0x75] == 0x34) &&
-                    (buffer.data[0x76] == 0x57) &&
-                    (buffer.data[0x77] == 0x58) &&
-                    (buffer.data[0x78] == 0x34) &&
-                    (buffer.data[0x79] == 0x2D) &&
-                    (buffer.data[0x7A] == 0x54) &&
-                    (buffer.data[0x7B] == 0x4C) &&
-                    (buffer.data[0x7C] == 0x43) &&
-                    (buffer.data[0x7D] == 0x33) )
-                {
-                    //
-                    // Was 0xBC, 0x1B = -> 0x1BBC = 7100 or 71.00 Mhz.
-                    //     71,000,000 / 1488 / 826 = 59.939 Hz
-                    // Want 60 * 1488 * 826 ~= 7111 or 71.11 MHz
-                    //     7111 = 0x1BC7 -> 0xC7 0x1B.
-                    // So, change byte 36 from 0xBC to 0xC7.
-                    //
-                    buffer.data[0x36] = 0xC7;
-                    this->WARFlags.dataForced = true;
-                    DP_LOG(("DP-WAR> Edid overrid on  MSI - LG LPL 1280x800"));
-                    DP_LOG(("DP-WAR>   Correcting pclk. Bug 359313"));
-                }
-            }
-            break;
-
-       // SKY
-       case 0x794D:
-            if (ProductID == 0x9880)
-            {
-                //
-                // Override for Haier TV to remove resolution
-                // 1366x768 from EDID data. Refer bug 351680 & 327891
-                // Overriding 18 bytes from offset 0x36.
-                //
-                buffer.data[0x36] = 0x01;
-                buffer.data[0x37] = 0x1D;
-                buffer.data[0x38] = 0x00;
-                buffer.data[0x39] = 0x72;
-                buffer.data[0x3A] = 0x51;
-                buffer.data[0x3B] = 0xD0;
-                buffer.data[0x3C] = 0x1E;
-                buffer.data[0x3D] = 0x20;
-                buffer.data[0x3E] = 0x6E;
-                buffer.data[0x3F] = 0x28;
-                buffer.data[0x40] = 0x55;
-                buffer.data[0x41] = 0x00;
-                buffer.data[0x42] = 0xC4;
-                buffer.data[0x43] = 0x8E;
-                buffer.data[0x44] = 0x21;
-                buffer.data[0x45] = 0x00;
-                buffer.data[0x46] = 0x00;
-                buffer.data[0x47] = 0x1E;
-
-                this->WARFlags.dataForced = true;
-                DP_LOG(("DP-WAR> Edid overrid on  Haier TV."));
-                DP_LOG(("DP-WAR>   Removing 1366x768. bug 351680 & 327891"));
-
-            }
-            break;
-        // HP
-        case 0xF022:
-            switch (ProductID)
-            {
-                case 0x192F:
-                    //
-                    // WAR for bug 1643712 - Issue specific to HP Z1 G2 (Zeus) All-In-One
-                    // Putting the Rx in power save mode before BL_EN is deasserted, makes this specific sink unhappy
-                    // Bug 1559465 will address the right power down sequence. We need to revisit this WAR once Bug 1559465 is fixed.
-                    //
-                    this->WARFlags.disableDpcdPowerOff = true;
-                    DP_LOG(("DP-WAR> Disable DPCD Power Off"));
-                    DP_LOG(("DP-WAR> HP Z1 G2 (Zeus) AIO Bug 1643712"));
-                    break;
-            }
-            break;
-
-        // Sharp
-        case 0x104d:
-            switch (ProductID)
-            {
-                case 0x141c: // HP Valor QHD+ N15P-Q3 Sharp EDP
-                    //
-                    // HP Valor QHD+ N15P-Q3 EDP needs 50 ms delay
-                    // after D3 to avoid black screen issues.
-                    //
-                    this->WARFlags.delayAfterD3 = true;
-                    DP_LOG(("DP-WAR> HP Valor QHD+ N15P-Q3 Sharp EDP needs 50 ms after D3"));
-                    DP_LOG(("DP-WAR> bug 1520011"));
-                    break;
-
-                //Sharp EDPs that declares DP1.2 but doesn't implement ESI address space
-                case 0x1414:
-                case 0x1430:
-                case 0x1445:
-                case 0x1446:
-                case 0x144C:
-                case 0x1450:
-                case 0x1467:
-                case 0x145e:
-                    //
-                    // Use Legacy address space for DP1.2 panel
-                    //
-                    this->WARFlags.useLegacyAddress = true;
-                    DP_LOG(("DP-WAR> Sharp EDP implements only Legacy interrupt address range"));
-                    break;
-
-                case 0x143B:
-                    //
-                    // Bug 200113041
-                    // Need to be unique to identify this Sharp panel. Besides
-                    // manufacturer ID and ProductID, we have to add the mode
-                    // name to make this happen as LQ156D1JW05 in ASCII.
-                    //
-                    if ((buffer.data[0x71] == 0x4C) &&
-                        (buffer.data[0x72] == 0x51) &&
-                        (buffer.data[0x73] == 0x31) &&
-                        (buffer.data[0x74] == 0x35) &&
-                        (buffer.data[0x75] == 0x36) &&
-                        (buffer.data[0x76] == 0x44) &&
-                        (buffer.data[0x77] == 0x31) &&
-                        (buffer.data[0x78] == 0x4A) &&
-                        (buffer.data[0x79] == 0x57) &&
-                        (buffer.data[0x7A] == 0x30) &&
-                        (buffer.data[0x7B] == 0x35) &&
-                        (buffer.data[0x7C] == 0x0A) &&
-                        (buffer.data[0x7D] == 0x20))
-                    {
-                        this->WARFlags.useLegacyAddress = true;
-                        DP_LOG(("DP-WAR> Sharp EDP implements only Legacy interrupt address range"));
-                    }
-                    break;
-            }
-            break;
-
-        // EIZO
-        case 0xc315:
-            if (ProductID == 0x2227)
-            {
-                //
-                // The EIZO FlexScan SX2762W generates a redundant long HPD
-                // pulse after a modeset, which triggers another modeset on GPUs
-                // without flush mode, triggering an infinite link training
-                // loop.
-                //
-                this->WARFlags.ignoreRedundantHotplug = true;
-                DP_LOG(("DP-WAR> EIZO FlexScan SX2762W generates redundant"));
-                DP_LOG(("DP-WAR> hotplugs (bug 1048796)"));
-                break;
-            }
-            break;
-
-        // MEI-Panasonic
-        case 0xa934:
-            if (ProductID == 0x96a2)
-            {
-                //
-                // Bug 200113041
-                // Need to be unique to identify this MEI-Panasonic panel.
-                // Besides manufacturer ID and ProductID, we have to add the
-                // model name to make this happen as VVX17P051J00^ in ASCII.
-                //
-                if ((buffer.data[0x71] == 0x56) &&
-                    (buffer.data[0x72] == 0x56) &&
-                    (buffer.data[0x73] == 0x58) &&
-                    (buffer.data[0x74] == 0x31) &&
-                    (buffer.data[0x75] == 0x37) &&
-                    (buffer.data[0x76] == 0x50) &&
-                    (buffer.data[0x77] == 0x30) &&
-                    (buffer.data[0x78] == 0x35) &&
-                    (buffer.data[0x79] == 0x31) &&
-                    (buffer.data[0x7A] == 0x4A) &&
-                    (buffer.data[0x7B] == 0x30) &&
-                    (buffer.data[0x7C] == 0x30) &&
-                    (buffer.data[0x7D] == 0x0A))
-                {
-                    this->WARFlags.useLegacyAddress = true;
-                    DP_LOG(("DP-WAR> MEI-Panasonic EDP"));
-                    DP_LOG(("implements only Legacy interrupt address range"));
-                }
-            }
-            break;
-
-        // LG
-        case 0xE430:
-            if (ProductID == 0x0469)
-            {
-                //
-                // The LG display can't be driven at FHD with 2*RBR.
-                // Force max link config
-                //
-                this->WARFlags.forceMaxLinkConfig = true;
-                DP_LOG(("DP-WAR> Force maximum link config WAR required on LG panel."));
-                DP_LOG(("DP-WAR>   bug 1649626"));
-                break;
-            }
-            break;
-        case 0x8F34:
-            if (ProductID == 0xAA55)
-            {
-                this->WARFlags.forceMaxLinkConfig = true;
-                DP_LOG(("DP-WAR> Force maximum link config WAR required on Sharp-CerebrEx panel."));
-            }
-            break;
-
-        // Dell
-        case 0xAC10:
-            // Dell U2713H has problem with LQA. Disable it.
-            if ((ProductID == 0xA092) || (ProductID == 0xF046))
-            {
-                this->WARFlags.reassessMaxLink = true;
-            }
-            break;
-
-        // CMN
-        case 0xAE0D:
-            if (ProductID == 0x1747)
-            {
-                this->WARFlags.useLegacyAddress = true;
-                DP_LOG(("DP-WAR> CMN eDP"));
-                DP_LOG(("implements only Legacy interrupt address range"));
-            }
-            break;
-
-        // BenQ
-        case 0xD109:
-            if ((ProductID == 0x7F2B) || (ProductID == 0x7F2F))
-            {
-                this->WARFlags.ignoreRedundantHotplug = true;
-                DP_LOG(("DP-WAR> BenQ GSync power on/off redundant hotplug"));
-            }
-            break;
-
-        // MSI
-        case 0x834C:
-            if (ProductID == 0x4C48)
-            {
-                this->WARFlags.useLegacyAddress = true;
-                DP_LOG(("DP-WAR> MSI eDP\n"));
-                DP_LOG(("implements only Legacy interrupt address range\n"));
-            }
-            break;
-
-        // Unigraf
-        case 0xC754:
-        case 0x1863:
-            {
-                DP_LOG(("DP-WAR> Unigraf device, keep link alive during detection\n"));
-                this->WARFlags.keepLinkAlive = true;
-            }
-            break;
-
-        // BOE
-        case 0xE509:
-            if ((ProductID == 0x977) || (ProductID == 0x974) || (ProductID == 0x9D9))
-            {
-                this->WARFlags.bIgnoreDscCap = true;
-                DP_LOG(("DP-WAR> BOE panels incorrectly exposing DSC capability. Ignoring it."));
-            }
-            break;
-
-        // NCP
-        case 0x7038:
-            if ((ProductID == 0x005F))
-            {
-                this->WARFlags.bIgnoreDscCap = true;
-                DP_LOG(("DP-WAR> NCP panels incorrectly exposing DSC capability. Ignoring it."));
-            }
-            break;
+    const EdidWorkAround * war = findEdidWorkAround(this->getManufId(),
+                                                    this->getProductId(),
+                                                    this->getYearWeek());
+    NvU32 flags = 0;
 
-        //
-        // This panel advertise DSC capabilities, but panel doesn't support DSC
-        // So ignoring DSC capability on this panel
-        //
-        case 0x6F0E:
-            if (ProductID == 0x1609)
-            {
-                this->WARFlags.bIgnoreDscCap = true;
-                DP_LOG(("DP-WAR> Ignoring DSC capability on Lenovo CSOT 1609 Panel."));
-                DP_LOG(("DP-WAR> Bug 3444252"));
-            }
-            break;
-
-        // Asus
-        case 0x6D1E:
-            if(ProductID == 0x7707)
-            {
-                this->WARFlags.bIgnoreDscCap = true;
-                DP_LOG(("DP-WAR> Panel incorrectly exposing DSC capability. Ignoring it."));
-                DP_LOG(("DP-WAR> Bug 3543158"));
-            }
-            break;
-
-        default:
-            break;
+    if (war && (!war->fixup || war->fixup(&buffer)))
+    {
+        flags = war->flags;
+        DP_LOG(("DP-WAR> %s", war->description));
     }
 
+    if (flags & DP_EDID_WAR_EXTENSION_COUNT_DISABLED)
+        this->WARFlags.extensionCountDisabled = true;
+    if (flags & DP_EDID_WAR_DATA_FORCED)
+        this->WARFlags.dataForced = true;
+    if (flags & DP_EDID_WAR_DISABLE_DPCD_POWER_OFF)
+        this->WARFlags.disableDpcdPowerOff = true;
+    if (flags & DP_EDID_WAR_FORCE_MAX_LINK_CONFIG)
+        this->WARFlags.forceMaxLinkConfig = true;
+    if (flags & DP_EDID_WAR_POWER_ON_BEFORE_LT)
+        this->WARFlags.powerOnBeforeLt = true;
+    if (flags & DP_EDID_WAR_IGNORE_REDUNDANT_HOTPLUG)
+        this->WARFlags.ignoreRedundantHotplug = true;
+    if (flags & DP_EDID_WAR_DELAY_AFTER_D3)
+        this->WARFlags.delayAfterD3 = true;
+    if (flags & DP_EDID_WAR_KEEP_LINK_ALIVE)
+        this->WARFlags.keepLinkAlive = true;
+    if (flags & DP_EDID_WAR_USE_LEGACY_ADDRESS)
+        this->WARFlags.useLegacyAddress = true;
+    if (flags & DP_EDID_WAR_REASSESS_MAX_LINK)
+        this->WARFlags.reassessMaxLink = true;
+    if (flags & DP_EDID_WAR_IGNORE_DSC_CAP)
+        this->WARFlags.bIgnoreDscCap = true;
+
     // Find out if the monitor needs a WAR to applied.
     if (warFlag)
     {
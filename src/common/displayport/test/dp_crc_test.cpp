@@ -0,0 +1,256 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************* DisplayPort *******************************\
+*                                                                           *
+* Module: dp_crc_test.cpp                                                   *
+*    Sideband CRCs against the bit-serial versions they replaced.           *
+*                                                                           *
+*    Every bit string of up to 16 bits, and random buffers read at random   *
+*    bit offsets and lengths, must give the same header and body CRC from  *
+*    the table-driven code as from BitSerialCrc, a copy of the original    *
+*    loops.  The byte-array body CRC must match the reader form.  The       *
+*    benchmark times the body CRC of a full 47 byte message box.           *
+*                                                                           *
+*    Usage: dp_crc_test [iterations]                                        *
+*                                                                           *
+\***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dp_internal.h"
+#include "dp_bitstream.h"
+#include "dp_crc.h"
+
+using namespace DisplayPort;
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static unsigned failures;
+
+enum
+{
+    RANDOM_BUFFER_BYTES = 64,
+    MESSAGE_BODY_BYTES  = 47,
+};
+
+//
+//  The bit-serial CRCs the lookup tables replaced, kept as the reference.
+//
+class BitSerialCrc
+{
+public:
+    static unsigned header(BitStreamReader * reader)
+    {
+        unsigned remainder = 0;
+        unsigned bit, i;
+
+        while (reader->read(&bit, 1))
+        {
+            remainder <<= 1;
+            remainder |= bit;
+            if ((remainder & 0x10) == 0x10)
+            {
+                remainder ^= 0x13;
+            }
+        }
+
+        for (i = 4; i != 0; i--)
+        {
+            remainder <<= 1;
+            if ((remainder & 0x10) != 0)
+            {
+                remainder ^= 0x13;
+            }
+        }
+
+        return remainder & 0xF;
+    }
+
+    static unsigned body(BitStreamReader * reader)
+    {
+        unsigned remainder = 0;
+        unsigned bit, i;
+
+        while (reader->read(&bit, 1))
+        {
+            remainder <<= 1;
+            remainder |= bit;
+            if ((remainder & 0x100) == 0x100)
+            {
+                remainder ^= 0xD5;
+            }
+        }
+
+        for (i = 8; i != 0; i--)
+        {
+            remainder <<= 1;
+            if ((remainder & 0x100) != 0)
+            {
+                remainder ^= 0xD5;
+            }
+        }
+
+        return remainder & 0xFF;
+    }
+};
+
+//
+//  Compare both CRCs of 'bits' bits of 'buffer' starting at bit 'offset'
+//
+static void compare(Buffer * buffer, unsigned offset, unsigned bits)
+{
+    BitStreamReader referenceHeader(buffer, offset, bits);
+    BitStreamReader referenceBody(buffer, offset, bits);
+    BitStreamReader header(buffer, offset, bits);
+    BitStreamReader body(buffer, offset, bits);
+
+    CHECK(dpCalculateHeaderCRC(&header) == BitSerialCrc::header(&referenceHeader));
+    CHECK(dpCalculateBodyCRC(&body) == BitSerialCrc::body(&referenceBody));
+
+    if ((offset % 8) == 0 && (bits % 8) == 0)
+    {
+        BitStreamReader reference(buffer, offset, bits);
+
+        CHECK(dpCalculateBodyCRC(buffer->data + offset / 8, bits / 8) ==
+              BitSerialCrc::body(&reference));
+    }
+}
+
+//
+//  Every bit string of 0 to 16 bits, placed at each offset within a byte
+//
+static void testExhaustive()
+{
+    for (unsigned bits = 0; bits <= 16; bits++)
+    {
+        for (unsigned value = 0; value < (1u << bits); value++)
+        {
+            for (unsigned offset = 0; offset < 8; offset++)
+            {
+                NvU8            raw[4] = {0};
+                Buffer          buffer(raw, sizeof(raw));
+                BitStreamWriter writer(&buffer, offset);
+
+                writer.write(value, bits);
+                compare(&buffer, offset, bits);
+            }
+        }
+    }
+}
+
+//
+//  Random buffers read at random bit offsets and lengths
+//
+static void testRandom(unsigned iterations)
+{
+    NvU8 raw[RANDOM_BUFFER_BYTES];
+
+    srand(1);
+    for (unsigned i = 0; i < iterations; i++)
+    {
+        for (unsigned j = 0; j < sizeof(raw); j++)
+            raw[j] = (NvU8)rand();
+
+        Buffer   buffer(raw, sizeof(raw));
+        unsigned offset = rand() % (sizeof(raw) * 8);
+        unsigned bits = rand() % (sizeof(raw) * 8 - offset + 1);
+
+        compare(&buffer, offset, bits);
+
+        // Whole bytes, as the merger and splitter use them
+        offset &= ~7;
+        bits &= ~7;
+        if (offset + bits > sizeof(raw) * 8)
+            bits = sizeof(raw) * 8 - offset;
+        compare(&buffer, offset, bits);
+    }
+}
+
+static double elapsedNs(struct timespec * start, unsigned iterations)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec)) / iterations;
+}
+
+static void benchmark(unsigned iterations)
+{
+    NvU8            raw[MESSAGE_BODY_BYTES];
+    struct timespec start;
+    unsigned        sum = 0;
+    double          bitSerialNs, readerNs, bytesNs;
+
+    for (unsigned i = 0; i < sizeof(raw); i++)
+        raw[i] = (NvU8)(i * 37 + 11);
+
+    Buffer buffer(raw, sizeof(raw));
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned i = 0; i < iterations; i++)
+    {
+        BitStreamReader reader(&buffer, 0, sizeof(raw) * 8);
+        sum += BitSerialCrc::body(&reader);
+    }
+    bitSerialNs = elapsedNs(&start, iterations);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned i = 0; i < iterations; i++)
+    {
+        BitStreamReader reader(&buffer, 0, sizeof(raw) * 8);
+        sum += dpCalculateBodyCRC(&reader);
+    }
+    readerNs = elapsedNs(&start, iterations);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned i = 0; i < iterations; i++)
+        sum += dpCalculateBodyCRC(raw, sizeof(raw));
+    bytesNs = elapsedNs(&start, iterations);
+
+    printf("body CRC, %u bytes: bit-serial %.0f ns, table %.0f ns, table on bytes %.0f ns (%u)\n",
+           (unsigned)sizeof(raw), bitSerialNs, readerNs, bytesNs, sum & 0xFF);
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned iterations = (argc > 1) ? (unsigned)atoi(argv[1]) : 200000;
+
+    testExhaustive();
+    testRandom(iterations);
+    benchmark(iterations);
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,900 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************* DisplayPort *******************************\
+*                                                                           *
+* Module: dp_discovery_test.cpp                                             *
+*    MST topology discovery against a simulated branch tree.                *
+*                                                                           *
+*    FakeMstAux answers the real DPCDHAL, MessageManager and               *
+*    DiscoveryManager as a tree of MST branches and sinks would.  Time is   *
+*    simulated: AUX transactions, sideband hops and branch processing all   *
+*    cost a fixed number of microseconds, and each branch serves its own    *
+*    requests one at a time.  Every device must be reported once with the   *
+*    right address, branch flag and GUID, no branch may ever see two        *
+*    requests with the same MSG_SEQ_NO in flight, and the time to the full  *
+*    topology is reported for each outstanding-request limit.  Further     *
+*    runs NAK some LINK_ADDRESS writes, so sends fail synchronously in the  *
+*    middle of a queue walk.                                                *
+*                                                                           *
+*    Usage: dp_discovery_test [max limit]                                   *
+*                                                                           *
+\***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dp_internal.h"
+#include "dp_auxbus.h"
+#include "dp_bitstream.h"
+#include "dp_configcaps.h"
+#include "dp_crc.h"
+#include "dp_discovery.h"
+#include "dp_messageheader.h"
+#include "dp_messages.h"
+#include "dp_splitter.h"
+#include "dp_timer.h"
+#include "displayport.h"
+
+using namespace DisplayPort;
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static unsigned failures;
+
+enum
+{
+    MAX_NODES           = 64,
+    MAX_REPLIES         = 64,
+    MAX_TRANSACTIONS    = 64,
+    MAX_REPLY_BYTES     = 256,
+    DPCD_SPACE          = 0x100000,
+    GUID_BYTES          = 16,
+};
+
+//
+//  Timing model, in microseconds of simulated time.  A sideband message
+//  costs one hop per branch it crosses in each direction, on top of the
+//  time its target takes to process it.
+//
+#define AUX_TRANSACTION_US      200
+#define SIDEBAND_HOP_US         250
+#define LINK_ADDRESS_US         2000
+#define REMOTE_DPCD_US          1000
+#define POWER_UP_PHY_US         500
+#define POLL_INTERVAL_US        100
+#define DISCOVERY_TIMEOUT_US    (60 * 1000 * 1000ULL)
+
+//
+//  Fake RawTimer: time moves when the test or the fake AUX moves it.
+//  Reading the clock takes a microsecond, since GUIDBuilder spins until
+//  the time changes.
+//
+class FakeRawTimer : public RawTimer
+{
+public:
+    NvU64 now;
+
+    FakeRawTimer() : now(0) {}
+    virtual void queueCallback(Callback * callback, int milliseconds) {}
+    virtual NvU64 getTimeUs() { return now++; }
+    virtual void sleep(int milliseconds) { now += (NvU64)milliseconds * 1000; }
+};
+
+//
+//  A branch or sink of the simulated tree.  A branch's children sit on
+//  output ports 1..childCount, port 0 being its input.
+//
+struct FakeNode
+{
+    Address  address;
+    bool     branch;
+    GUID     guid;                  // branches report it in LINK_ADDRESS,
+                                    // sinks only in their DPCD
+    unsigned childCount;
+    NvU64    busyUntil;
+    unsigned busyMessageNumbers;
+    bool     reported;
+};
+
+struct Topology
+{
+    const char * name;
+    FakeNode     nodes[MAX_NODES];
+    unsigned     nodeCount;
+    unsigned     branchCount;
+};
+
+static FakeNode * findNode(Topology * topology, const Address & address)
+{
+    for (unsigned i = 0; i < topology->nodeCount; i++)
+        if (topology->nodes[i].address == address)
+            return &topology->nodes[i];
+
+    return 0;
+}
+
+static FakeNode * addNode(Topology * topology, const Address & address, bool branch)
+{
+    FakeNode * node = &topology->nodes[topology->nodeCount++];
+
+    node->address = address;
+    node->branch = branch;
+    node->childCount = 0;
+    node->busyUntil = 0;
+    node->busyMessageNumbers = 0;
+    node->reported = false;
+
+    //
+    //  The root branch has no GUID yet, so discovery has to write one
+    //  through the local DPCD.
+    //
+    memset(node->guid.data, 0, sizeof(node->guid.data));
+    if (address.size() > 1)
+    {
+        node->guid.data[0] = 0xA5;
+        node->guid.data[1] = (NvU8)topology->nodeCount;
+        node->guid.data[GUID_BYTES - 1] = branch ? 0xB0 : 0x50;
+    }
+
+    if (branch)
+        topology->branchCount++;
+
+    return node;
+}
+
+//
+//  Every branch has 'sinks' sinks and, above the last level, 'fanout'
+//  branches below it.
+//
+static void buildBranch(Topology * topology, const Address & address,
+                        unsigned levels, unsigned fanout, unsigned sinks)
+{
+    FakeNode * node = addNode(topology, address, true);
+    unsigned   branches = (levels > 1) ? fanout : 0;
+
+    for (unsigned i = 0; i < sinks + branches; i++)
+    {
+        Address child = address;
+        child.append(++node->childCount);
+
+        if (i < sinks)
+            addNode(topology, child, false);
+        else
+            buildBranch(topology, child, levels - 1, fanout, sinks);
+    }
+}
+
+static void buildTopology(Topology * topology, const char * name,
+                          unsigned levels, unsigned fanout, unsigned sinks)
+{
+    topology->name = name;
+    topology->nodeCount = 0;
+    topology->branchCount = 0;
+    buildBranch(topology, Address(0), levels, fanout, sinks);
+}
+
+//
+//  The root branch as seen over AUX.  Down requests written to the
+//  DOWN_REQ box are routed to their target and answered once the model
+//  says the reply is back; replies are handed out one transaction at a
+//  time through the DOWN_REP box and its IRQ bit.
+//
+class FakeMstAux : public AuxBus
+{
+    struct PendingReply
+    {
+        NvU64      ready;
+        FakeNode * node;
+        unsigned   messageNumber;
+        NvU8       body[MAX_REPLY_BYTES];
+        unsigned   length;
+    };
+
+    struct Transaction
+    {
+        NvU8     data[DPCD_MESSAGEBOX_SIZE];
+        unsigned length;
+    };
+
+    FakeRawTimer * raw;
+    Topology     * topology;
+    NvU8           request[DPCD_MESSAGEBOX_SIZE];
+    unsigned       requestLength;
+    PendingReply   replies[MAX_REPLIES];
+    unsigned       replyCount;
+    Transaction    transactions[MAX_TRANSACTIONS];
+    unsigned       transactionHead;
+    unsigned       transactionCount;
+    bool           boxLoaded;
+
+public:
+    NvU8 *   dpcd;
+    unsigned requestCount;
+    unsigned inFlight;
+    unsigned maxInFlight;
+
+    //
+    //  When set, the first AUX write of every nakEvery-th LINK_ADDRESS
+    //  request is NAKed, so the splitter fails it synchronously from
+    //  inside MessageManager's send.
+    //
+    unsigned nakEvery;
+    unsigned linkAddressWrites;
+    unsigned naks;
+
+    FakeMstAux(FakeRawTimer * raw, Topology * topology, unsigned nakEvery)
+        : raw(raw), topology(topology), requestLength(0), replyCount(0),
+          transactionHead(0), transactionCount(0), boxLoaded(false),
+          requestCount(0), inFlight(0), maxInFlight(0),
+          nakEvery(nakEvery), linkAddressWrites(0), naks(0)
+    {
+        dpcd = (NvU8 *)calloc(1, DPCD_SPACE);
+
+        dpcd[NV_DPCD_REV]                = 0x12;
+        dpcd[NV_DPCD_MAX_LINK_BANDWIDTH] = 0x14;
+        dpcd[NV_DPCD_MAX_LANE_COUNT]     = 0x84;
+        dpcd[NV_DPCD_MSTM]               = DRF_DEF(_DPCD, _MSTM, _CAP, _YES);
+        dpcd[NV_DPCD_SINK_COUNT]         = 1;
+    }
+
+    ~FakeMstAux()
+    {
+        free(dpcd);
+    }
+
+    virtual unsigned transactionSize()
+    {
+        return 16;
+    }
+
+    virtual status transaction(Action action, Type type, int address,
+                               NvU8 * buffer, unsigned sizeRequested,
+                               unsigned * sizeCompleted,
+                               unsigned * pNakReason = NULL,
+                               NvU8 offset = 0, NvU8 nWriteTransactions = 0)
+    {
+        raw->now += AUX_TRANSACTION_US;
+        *sizeCompleted = 0;
+
+        if (type != native || address < 0 || address + sizeRequested > DPCD_SPACE)
+            return nack;
+
+        if (action == read)
+        {
+            memcpy(buffer, &dpcd[address], sizeRequested);
+        }
+        else if (address >= NV_DPCD_MBOX_DOWN_REQ &&
+                 address < NV_DPCD_MBOX_DOWN_REQ + DPCD_MESSAGEBOX_SIZE)
+        {
+            if (address == NV_DPCD_MBOX_DOWN_REQ && nakLinkAddress(buffer, sizeRequested))
+            {
+                naks++;
+                return nack;
+            }
+            writeDownRequest(address - NV_DPCD_MBOX_DOWN_REQ, buffer, sizeRequested);
+        }
+        else if (address == NV_DPCD_DEVICE_SERVICE_IRQ_VECTOR ||
+                 address == NV_DPCD_DEVICE_SERVICE_IRQ_VECTOR_ESI0)
+        {
+            // Write one to clear
+            if (FLD_TEST_DRF(_DPCD, _DEVICE_SERVICE_IRQ_VECTOR, _DOWN_REP_MSG_RDY, _YES, buffer[0]))
+            {
+                dpcd[NV_DPCD_DEVICE_SERVICE_IRQ_VECTOR] &=
+                    ~DRF_DEF(_DPCD, _DEVICE_SERVICE_IRQ_VECTOR, _DOWN_REP_MSG_RDY, _YES);
+                dpcd[NV_DPCD_DEVICE_SERVICE_IRQ_VECTOR_ESI0] &=
+                    ~DRF_DEF(_DPCD, _DEVICE_SERVICE_IRQ_VECTOR_ESI0, _DOWN_REP_MSG_RDY, _YES);
+                boxLoaded = false;
+            }
+        }
+        else
+        {
+            memcpy(&dpcd[address], buffer, sizeRequested);
+        }
+
+        *sizeCompleted = sizeRequested;
+        update();
+        return success;
+    }
+
+    //
+    //  Load the next reply transaction into the DOWN_REP box if it is free
+    //
+    void update()
+    {
+        if (boxLoaded)
+            return;
+
+        if (!transactionCount)
+            deliverReply();
+
+        if (!transactionCount)
+            return;
+
+        Transaction * t = &transactions[transactionHead];
+        memcpy(&dpcd[NV_DPCD_MBOX_DOWN_REP], t->data, t->length);
+        transactionHead = (transactionHead + 1) % MAX_TRANSACTIONS;
+        transactionCount--;
+
+        dpcd[NV_DPCD_DEVICE_SERVICE_IRQ_VECTOR] |=
+            DRF_DEF(_DPCD, _DEVICE_SERVICE_IRQ_VECTOR, _DOWN_REP_MSG_RDY, _YES);
+        dpcd[NV_DPCD_DEVICE_SERVICE_IRQ_VECTOR_ESI0] |=
+            DRF_DEF(_DPCD, _DEVICE_SERVICE_IRQ_VECTOR_ESI0, _DOWN_REP_MSG_RDY, _YES);
+        boxLoaded = true;
+    }
+
+    bool irqPending()
+    {
+        update();
+        return boxLoaded;
+    }
+
+    //
+    //  Simulated time at which the next reply reaches the root
+    //
+    NvU64 nextEventUs()
+    {
+        NvU64 next = ~0ULL;
+
+        for (unsigned i = 0; i < replyCount; i++)
+            if (replies[i].ready < next)
+                next = replies[i].ready;
+
+        return next;
+    }
+
+private:
+    bool nakLinkAddress(const NvU8 * data, unsigned length)
+    {
+        if (!nakEvery)
+            return false;
+
+        unsigned LCT = data[0] >> 4;
+        unsigned headerBytes = (8 + (((4 * (LCT - 1)) + 4) & ~7) + 16) / 8;
+        if (headerBytes >= length ||
+            (data[headerBytes] & 0x7f) != NV_DP_SBMSG_REQUEST_ID_LINK_ADDRESS)
+            return false;
+
+        return (++linkAddressWrites % nakEvery) == 0;
+    }
+
+    void writeDownRequest(unsigned offset, const NvU8 * data, unsigned length)
+    {
+        MessageHeader header;
+
+        if (offset == 0)
+            requestLength = 0;
+
+        CHECK(offset == requestLength);
+        if (offset != requestLength || offset + length > sizeof(request))
+            return;
+
+        memcpy(&request[offset], data, length);
+        requestLength += length;
+
+        unsigned LCT = request[0] >> 4;
+        unsigned headerSizeBits = 8 + (((4 * (LCT - 1)) + 4) & ~7) + 16;
+        if (requestLength * 8 < headerSizeBits)
+            return;
+
+        Buffer buffer(request, requestLength);
+        BitStreamReader reader(&buffer, 0, requestLength * 8);
+        if (!decodeHeader(&reader, &header, Address(0)))
+        {
+            CHECK(0 && "corrupt down request header");
+            requestLength = 0;
+            return;
+        }
+
+        unsigned headerBytes = header.headerSizeBits / 8;
+        if (requestLength < headerBytes + header.payloadBytes)
+            return;
+
+        // Every request discovery sends fits in a single transaction
+        CHECK(header.isTransactionStart && header.isTransactionEnd);
+
+        const NvU8 * body = &request[headerBytes];
+        unsigned bodyLength = header.payloadBytes - 1;
+        CHECK(dpCalculateBodyCRC(body, bodyLength) == body[bodyLength]);
+
+        handleRequest(&header, body, bodyLength);
+        requestLength = 0;
+    }
+
+    FakeNode * findChild(FakeNode * node, unsigned port)
+    {
+        Address child = node->address;
+        child.append(port);
+        return findNode(topology, child);
+    }
+
+    void encodeLinkAddress(FakeNode * node, BitStreamWriter * writer)
+    {
+        writer->writeBytes(node->guid.data, GUID_BYTES);
+        writer->write(0 /*zeroes*/, 4);
+        writer->write(1 + node->childCount /*Number_Of_Ports*/, 4);
+
+        // Input port
+        writer->write(1 /*Input_Port*/, 1);
+        writer->write(UpstreamSourceOrSSTBranch, 3);
+        writer->write(0 /*Port_Number*/, 4);
+        writer->write(0 /*Messaging_Capability_Status*/, 1);
+        writer->write(1 /*DisplayPort_Device_Plug_Status*/, 1);
+        writer->write(0 /*zeroes*/, 6);
+
+        for (unsigned port = 1; port <= node->childCount; port++)
+        {
+            FakeNode * child = findChild(node, port);
+            GUID       zero;
+
+            writer->write(0 /*Input_Port*/, 1);
+            writer->write(child->branch ? DownstreamBranch : DownstreamSink, 3);
+            writer->write(port, 4);
+            writer->write(child->branch, 1);
+            writer->write(1 /*DisplayPort_Device_Plug_Status*/, 1);
+            writer->write(0 /*Legacy_Device_Plug_Status*/, 1);
+            writer->write(0 /*zeroes*/, 5);
+            writer->write(0x12 /*DPCD_Revision*/, 8);
+            writer->writeBytes(child->branch ? child->guid.data : zero.data, GUID_BYTES);
+            writer->write(1 /*Number_SDP_Streams*/, 4);
+            writer->write(1 /*Number_SDP_Stream_Sinks*/, 4);
+        }
+    }
+
+    void handleRequest(MessageHeader * header, const NvU8 * body, unsigned length)
+    {
+        FakeNode * node = findNode(topology, header->address);
+
+        CHECK(node && node->branch);
+        CHECK(replyCount < MAX_REPLIES);
+        if (!node || !node->branch || replyCount == MAX_REPLIES)
+            return;
+
+        //
+        //  MSG_SEQ_NO is one bit: a branch can only tell two requests
+        //  apart, and never two with the same number.
+        //
+        CHECK(!(node->busyMessageNumbers & (1 << header->messageNumber)));
+        node->busyMessageNumbers |= 1 << header->messageNumber;
+
+        requestCount++;
+        if (++inFlight > maxInFlight)
+            maxInFlight = inFlight;
+
+        Buffer          in((NvU8 *)body, length);
+        BitStreamReader reader(&in, 0, length * 8);
+        Buffer          out;
+        BitStreamWriter writer(&out, 0);
+        unsigned        serviceUs = 0;
+
+        reader.readOrDefault(1 /*zero*/, 0);
+        unsigned requestIdentifier = reader.readOrDefault(7, 0);
+
+        writer.write(0 /*ACK*/, 1);
+        writer.write(requestIdentifier, 7);
+
+        switch (requestIdentifier)
+        {
+            case NV_DP_SBMSG_REQUEST_ID_LINK_ADDRESS:
+            {
+                serviceUs = LINK_ADDRESS_US;
+                encodeLinkAddress(node, &writer);
+                break;
+            }
+            case NV_DP_SBMSG_REQUEST_ID_REMOTE_DPCD_READ:
+            {
+                unsigned   port = reader.readOrDefault(4, 0);
+                unsigned   dpcdAddress = reader.readOrDefault(20, 0);
+                unsigned   count = reader.readOrDefault(8, 0);
+                FakeNode * child = findChild(node, port);
+
+                CHECK(child != 0);
+                serviceUs = REMOTE_DPCD_US;
+                writer.write(0 /*zeroes*/, 4);
+                writer.write(port, 4);
+                writer.write(count, 8);
+                for (unsigned i = 0; i < count; i++)
+                {
+                    unsigned a = dpcdAddress + i;
+                    bool     inGuid = child && a >= NV_DPCD_GUID && a < NV_DPCD_GUID + GUID_BYTES;
+                    writer.write(inGuid ? child->guid.data[a - NV_DPCD_GUID] : 0, 8);
+                }
+                break;
+            }
+            case NV_DP_SBMSG_REQUEST_ID_REMOTE_DPCD_WRITE:
+            {
+                unsigned   port = reader.readOrDefault(4, 0);
+                unsigned   dpcdAddress = reader.readOrDefault(20, 0);
+                unsigned   count = reader.readOrDefault(8, 0);
+                FakeNode * child = findChild(node, port);
+
+                CHECK(child != 0);
+                if (child && dpcdAddress == NV_DPCD_GUID && count == GUID_BYTES)
+                    reader.readBytes(child->guid.data, GUID_BYTES);
+
+                serviceUs = REMOTE_DPCD_US;
+                writer.write(0 /*zeroes*/, 4);
+                writer.write(port, 4);
+                break;
+            }
+            case NV_DP_SBMSG_REQUEST_ID_POWER_UP_PHY:
+            {
+                unsigned port = reader.readOrDefault(4, 0);
+
+                serviceUs = POWER_UP_PHY_US;
+                writer.write(port, 4);
+                writer.write(0 /*zeroes*/, 4);
+                break;
+            }
+            default:
+                CHECK(0 && "unexpected down request");
+                break;
+        }
+
+        //
+        //  The request reaches its target after one hop per branch on the
+        //  way, waits for the branch to finish anything ahead of it, and
+        //  the reply takes the same hops back.
+        //
+        NvU64 hopsUs = (NvU64)(header->address.size() - 1) * SIDEBAND_HOP_US;
+        NvU64 start  = DP_MAX(raw->now + hopsUs, node->busyUntil);
+
+        node->busyUntil = start + serviceUs;
+
+        PendingReply * reply = &replies[replyCount++];
+        reply->ready = node->busyUntil + hopsUs;
+        reply->node = node;
+        reply->messageNumber = header->messageNumber;
+        reply->length = DP_MIN(out.length, (unsigned)MAX_REPLY_BYTES);
+        memcpy(reply->body, out.data, reply->length);
+    }
+
+    //
+    //  Split the earliest reply that has made it back to the root into
+    //  DOWN_REP transactions
+    //
+    void deliverReply()
+    {
+        unsigned earliest = replyCount;
+
+        for (unsigned i = 0; i < replyCount; i++)
+            if (replies[i].ready <= raw->now &&
+                (earliest == replyCount || replies[i].ready < replies[earliest].ready))
+                earliest = i;
+
+        if (earliest == replyCount)
+            return;
+
+        PendingReply *             reply = &replies[earliest];
+        EncodedMessage             message;
+        MessageTransactionSplitter splitter;
+        Buffer                     assembly;
+
+        message.address = reply->node->address;
+        message.messageNumber = reply->messageNumber;
+        message.buffer = Buffer(reply->body, reply->length);
+
+        splitter.set(&message);
+        while (splitter.get(assembly))
+        {
+            CHECK(transactionCount < MAX_TRANSACTIONS);
+            Transaction * t = &transactions[(transactionHead + transactionCount) % MAX_TRANSACTIONS];
+            t->length = assembly.length;
+            memcpy(t->data, assembly.data, assembly.length);
+            transactionCount++;
+        }
+
+        reply->node->busyMessageNumbers &= ~(1 << reply->messageNumber);
+        inFlight--;
+
+        *reply = replies[--replyCount];
+    }
+};
+
+//
+//  Checks every device discovery reports against the topology
+//
+class DiscoveryRecorder : public DiscoveryManager::DiscoveryManagerEventSink
+{
+public:
+    Topology * topology;
+    unsigned   newDevices;
+    unsigned   lostDevices;
+    bool       detectComplete;
+
+    DiscoveryRecorder(Topology * topology)
+        : topology(topology), newDevices(0), lostDevices(0), detectComplete(false)
+    {}
+
+    virtual void discoveryDetectComplete()
+    {
+        detectComplete = true;
+    }
+
+    virtual void discoveryNewDevice(const DiscoveryManager::Device & device)
+    {
+        FakeNode * node = findNode(topology, device.address);
+
+        CHECK(node != 0);
+        if (!node)
+            return;
+
+        CHECK(!node->reported);
+        CHECK(device.branch == node->branch);
+        CHECK(node->guid.isGuidZero() || device.peerGuid == node->guid);
+
+        node->reported = true;
+        newDevices++;
+    }
+
+    virtual void discoveryLostDevice(const Address & address)
+    {
+        lostDevices++;
+    }
+};
+
+//
+//  The root raises an IRQ for each reply transaction it has ready;
+//  otherwise let time pass until the next reply or timer callback.
+//
+static void step(FakeRawTimer * raw, Timer * timer, FakeMstAux * aux,
+                 DPCDHAL * hal, MessageManager * messageManager)
+{
+    if (aux->irqPending())
+    {
+        hal->notifyIRQ();
+        if (hal->interruptDownReplyReady())
+            messageManager->IRQDownReply();
+        return;
+    }
+
+    NvU64 next = DP_MIN(aux->nextEventUs(), raw->now + POLL_INTERVAL_US);
+    if (next > raw->now)
+        raw->now = next;
+
+    ((RawTimer::Callback &)*timer).expired();
+}
+
+//
+//  Run discovery from a long pulse on the root and return the simulated
+//  time until every device has been reported.
+//
+static NvU64 discover(Topology * topology, unsigned limit, unsigned nakEvery,
+                      FakeMstAux ** stats)
+{
+    FakeRawTimer       raw;
+    Timer              timer(&raw);
+    FakeMstAux *       aux = new FakeMstAux(&raw, topology, nakEvery);
+    DPCDHAL *          hal = MakeDPCDHAL(aux, &timer);
+    DiscoveryRecorder  recorder(topology);
+
+    hal->notifyHPD(true);
+    CHECK(hal->getSupportsMultistream());
+
+    MessageManager *   messageManager = new MessageManager(hal, &timer);
+    DiscoveryManager * discoveryManager = new DiscoveryManager(messageManager, &recorder, &timer, hal);
+
+    messageManager->setMaxOutstandingDownRequests(limit);
+    CHECK(messageManager->getMaxOutstandingDownRequests() == limit);
+
+    NvU64 start = raw.now;
+    discoveryManager->notifyLongPulse(true);
+
+    while (!(recorder.detectComplete && recorder.newDevices == topology->nodeCount) &&
+           raw.now - start < DISCOVERY_TIMEOUT_US)
+    {
+        step(&raw, &timer, aux, hal, messageManager);
+    }
+
+    NvU64 elapsed = raw.now - start;
+
+    CHECK(recorder.detectComplete);
+    CHECK(recorder.newDevices == topology->nodeCount);
+    CHECK(recorder.lostDevices == 0);
+    CHECK(aux->inFlight == 0);
+
+    // The root GUID was written through the local DPCD
+    DiscoveryManager::Device * root = discoveryManager->findDevice(Address(0));
+    CHECK(root != 0);
+    if (root)
+    {
+        CHECK(!root->peerGuid.isGuidZero());
+        CHECK(memcmp(root->peerGuid.data, &aux->dpcd[NV_DPCD_GUID], GUID_BYTES) == 0);
+    }
+
+    delete discoveryManager;
+    delete messageManager;
+    delete hal;
+
+    *stats = aux;
+    return elapsed;
+}
+
+static void sweep(const char * name, unsigned levels, unsigned fanout,
+                  unsigned sinks, unsigned maxLimit)
+{
+    Topology * topology = new Topology();
+    NvU64      serialized = 0;
+
+    for (unsigned limit = 1; limit <= maxLimit; limit *= 2)
+    {
+        FakeMstAux * stats;
+
+        buildTopology(topology, name, levels, fanout, sinks);
+        NvU64 elapsed = discover(topology, limit, 0, &stats);
+
+        printf("%-5s %2u branches %2u sinks  limit %2u: %8.2f ms  %3u requests  %2u max in flight\n",
+               name, topology->branchCount, topology->nodeCount - topology->branchCount,
+               limit, elapsed / 1000.0, stats->requestCount, stats->maxInFlight);
+
+        CHECK(stats->maxInFlight <= limit);
+        if (limit == 1)
+            serialized = elapsed;
+        else
+            CHECK(elapsed <= serialized);
+
+        delete stats;
+    }
+
+    delete topology;
+}
+
+//
+//  Discovery with some LINK_ADDRESS writes NAKed by the root.  Each NAK
+//  fails a message synchronously inside the send of a queue walk, and
+//  the failure starts a nested walk that dequeues messages behind the
+//  outer walk's cursor.  Discovery retries the failed requests and must
+//  still find every device.
+//
+static void sweepNaks(const char * name, unsigned levels, unsigned fanout,
+                      unsigned sinks, unsigned maxLimit)
+{
+    Topology * topology = new Topology();
+
+    for (unsigned limit = 2; limit <= maxLimit; limit *= 2)
+    {
+        FakeMstAux * stats;
+
+        buildTopology(topology, name, levels, fanout, sinks);
+        NvU64 elapsed = discover(topology, limit, 3, &stats);
+
+        printf("%-5s %2u branches %2u sinks  limit %2u: %8.2f ms  %3u requests  %2u NAKs\n",
+               name, topology->branchCount, topology->nodeCount - topology->branchCount,
+               limit, elapsed / 1000.0, stats->requestCount, stats->naks);
+
+        CHECK(stats->naks != 0);
+        CHECK(stats->maxInFlight <= limit);
+
+        delete stats;
+    }
+
+    delete topology;
+}
+
+class MessageRecorder : public MessageManager::Message::MessageEventSink
+{
+public:
+    unsigned                  completed;
+    unsigned                  failed;
+    MessageManager::Message * lastFailed;
+
+    MessageRecorder() : completed(0), failed(0), lastFailed(0) {}
+
+    virtual void messageCompleted(MessageManager::Message * from)
+    {
+        completed++;
+    }
+
+    virtual void messageFailed(MessageManager::Message * from, NakData * nakData)
+    {
+        failed++;
+        lastFailed = from;
+    }
+};
+
+//
+//  Three LINK_ADDRESS requests to sibling branches queue up behind a
+//  window of one.  The window is then opened, and the reply to the first
+//  one starts a walk whose first send is NAKed.  splitterFailed walks the
+//  queue again from inside that send and dequeues the third request, which
+//  the outer walk's cursor was pointing at.  The outer walk must notice
+//  and neither send it twice nor walk off the end of the wrong list.
+//
+static void nestedWalk()
+{
+    Topology *         topology = new Topology();
+    FakeRawTimer       raw;
+    Timer              timer(&raw);
+    MessageRecorder    recorder;
+    LinkAddressMessage messages[3];
+
+    buildTopology(topology, "wide", 2, 3, 0);
+    CHECK(topology->branchCount == 4);
+
+    // Every second LINK_ADDRESS write is NAKed: only the second request's.
+    FakeMstAux *     aux = new FakeMstAux(&raw, topology, 2);
+    DPCDHAL *        hal = MakeDPCDHAL(aux, &timer);
+    hal->notifyHPD(true);
+    MessageManager * messageManager = new MessageManager(hal, &timer);
+
+    messageManager->setMaxOutstandingDownRequests(1);
+    for (unsigned i = 0; i < 3; i++)
+    {
+        messages[i].set(topology->nodes[1 + i].address);
+        messageManager->post(&messages[i], &recorder);
+    }
+    CHECK(aux->requestCount == 1);
+
+    messageManager->setMaxOutstandingDownRequests(4);
+
+    NvU64 start = raw.now;
+    while (recorder.completed + recorder.failed < 3 &&
+           raw.now - start < DISCOVERY_TIMEOUT_US)
+    {
+        step(&raw, &timer, aux, hal, messageManager);
+    }
+
+    printf("nested walk: %u completed, %u failed, %u requests, %u NAKs\n",
+           recorder.completed, recorder.failed, aux->requestCount, aux->naks);
+
+    CHECK(recorder.completed == 2);
+    CHECK(recorder.failed == 1);
+    CHECK(recorder.lastFailed == &messages[1]);
+    CHECK(aux->naks == 1);
+    CHECK(aux->requestCount == 2);
+    CHECK(aux->inFlight == 0);
+
+    for (unsigned i = 0; i < 3; i++)
+        messages[i].clear();
+
+    delete messageManager;
+    delete hal;
+    delete aux;
+    delete topology;
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned maxLimit = (argc > 1) ? (unsigned)atoi(argv[1]) : 16;
+
+    sweep("chain", 5, 1, 1, maxLimit);
+    sweep("wide",  2, 4, 3, maxLimit);
+    sweep("tree",  3, 3, 2, maxLimit);
+
+    sweepNaks("wide", 2, 4, 3, maxLimit);
+    sweepNaks("tree", 3, 3, 2, maxLimit);
+
+    nestedWalk();
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
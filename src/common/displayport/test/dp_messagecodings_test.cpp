@@ -0,0 +1,295 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************* DisplayPort *******************************\
+*                                                                           *
+* Module: dp_messagecodings_test.cpp                                        *
+*    Sideband reply decoding through the real message parsers.              *
+*                                                                           *
+*    A LINK_ADDRESS reply for a 15-port branch is encoded with              *
+*    BitStreamWriter and decoded by LinkAddressMessage, and every field    *
+*    is checked.  Short REMOTE_DPCD_READ and REMOTE_I2C_READ replies must   *
+*    keep the bytes that arrived and zero the rest.  The benchmark times   *
+*    encoding and decoding the LINK_ADDRESS reply.                          *
+*                                                                           *
+*    Usage: dp_messagecodings_test [iterations]                             *
+*                                                                           *
+\***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dp_internal.h"
+#include "dp_bitstream.h"
+#include "dp_messagecodings.h"
+
+using namespace DisplayPort;
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static unsigned failures;
+
+enum
+{
+    BRANCH_PORTS = 15,
+    GUID_BYTES   = 16,
+};
+
+//
+//  The remote read messages keep their parseResponseAck override private.
+//  Reach it through the protected base declaration.
+//
+template <class MessageType>
+class ReplyParser : public MessageType
+{
+public:
+    using MessageManager::Message::parseResponseAck;
+};
+
+static NvU8 guidByte(unsigned port, unsigned i)
+{
+    return (NvU8)(port * 31 + i * 7 + 1);
+}
+
+//
+//  LINK_ADDRESS reply body, as it follows the reply type and request
+//  identifier.  Port 0 is the input port, the others lead to SST sinks.
+//
+static void encodeLinkAddressReply(Buffer * buffer)
+{
+    BitStreamWriter writer(buffer, 0);
+    NvU8 guid[GUID_BYTES];
+
+    writer.reserve((GUID_BYTES + 1 + 2 + (BRANCH_PORTS - 1) * (3 + GUID_BYTES + 1)) * 8);
+
+    for (unsigned i = 0; i < GUID_BYTES; i++)
+        guid[i] = guidByte(BRANCH_PORTS, i);
+    writer.writeBytes(guid, GUID_BYTES);
+    writer.write(0, 4);
+    writer.write(BRANCH_PORTS, 4);
+
+    for (unsigned port = 0; port < BRANCH_PORTS; port++)
+    {
+        bool isInput = (port == 0);
+
+        writer.write(isInput, 1);
+        writer.write(isInput ? 1 : (port % 4), 3);
+        writer.write(port, 4);
+        writer.write(port & 1, 1);
+        writer.write(!isInput, 1);
+
+        if (isInput)
+        {
+            writer.write(0, 6);
+            continue;
+        }
+
+        writer.write((port >> 1) & 1, 1);
+        writer.write(0, 5);
+        writer.write(0x12 + (port & 1), 8);
+        for (unsigned i = 0; i < GUID_BYTES; i++)
+            guid[i] = guidByte(port, i);
+        writer.writeBytes(guid, GUID_BYTES);
+        writer.write(port % 3, 4);
+        writer.write(port % 5, 4);
+    }
+}
+
+static void decodeLinkAddressReply(LinkAddressMessage * message, Buffer * buffer)
+{
+    EncodedMessage encoded;
+    BitStreamReader reader(buffer, 0, buffer->length * 8);
+
+    message->parseResponseAck(&encoded, &reader);
+}
+
+static void testLinkAddress()
+{
+    Buffer buffer;
+    LinkAddressMessage message;
+    GUID guid;
+
+    encodeLinkAddressReply(&buffer);
+    decodeLinkAddressReply(&message, &buffer);
+
+    message.getGUID(guid);
+    for (unsigned i = 0; i < GUID_BYTES; i++)
+        CHECK(guid.data[i] == guidByte(BRANCH_PORTS, i));
+    CHECK(message.resultCount() == BRANCH_PORTS);
+
+    for (unsigned port = 0; port < BRANCH_PORTS; port++)
+    {
+        const LinkAddressMessage::Result * result = message.result(port);
+        bool isInput = (port == 0);
+
+        CHECK(result->isInputPort == isInput);
+        CHECK(result->peerDeviceType == (PeerDevice)(isInput ? 1 : (port % 4)));
+        CHECK(result->portNumber == port);
+        CHECK(result->hasMessaging == !!(port & 1));
+        CHECK(result->dpPlugged == !isInput);
+
+        if (isInput)
+        {
+            CHECK(result->dpcdRevisionMajor == 1 && result->dpcdRevisionMinor == 2);
+            continue;
+        }
+
+        CHECK(result->legacyPlugged == !!((port >> 1) & 1));
+        CHECK(result->dpcdRevisionMajor == 1);
+        CHECK(result->dpcdRevisionMinor == 2 + (port & 1));
+        for (unsigned i = 0; i < GUID_BYTES; i++)
+            CHECK(result->peerGUID.data[i] == guidByte(port, i));
+        CHECK(result->SDPStreams == port % 3);
+        CHECK(result->SDPStreamSinks == port % 5);
+    }
+}
+
+//
+//  Remote read reply body: port, byte count, then 'sent' of the 'claimed'
+//  data bytes.
+//
+static void encodeRemoteReadReply(Buffer * buffer, unsigned port,
+                                  unsigned claimed, unsigned sent, NvU8 seed)
+{
+    BitStreamWriter writer(buffer, 0);
+
+    writer.write(0, 4);
+    writer.write(port, 4);
+    writer.write(claimed, 8);
+    for (unsigned i = 0; i < sent; i++)
+        writer.write((NvU8)(seed + i), 8);
+}
+
+static void testShortRemoteReads()
+{
+    const unsigned port = 3, claimed = 16, sent = 10;
+    ReplyParser<RemoteDpcdReadMessage> dpcdRead;
+    ReplyParser<RemoteI2cReadMessage> i2cRead;
+    EncodedMessage encoded;
+    Buffer full, shortReply;
+    const NvU8 * data;
+    unsigned count;
+
+    encodeRemoteReadReply(&full, port, claimed, claimed, 0xA0);
+    encodeRemoteReadReply(&shortReply, port, claimed, sent, 0x10);
+
+    // A full reply first, so stale bytes would show through
+    dpcdRead.set(Address(), port, 0x100, claimed);
+    {
+        BitStreamReader reader(&full, 0, full.length * 8);
+        CHECK(dpcdRead.parseResponseAck(&encoded, &reader) == ParseResponseSuccess);
+    }
+    {
+        BitStreamReader reader(&shortReply, 0, shortReply.length * 8);
+        CHECK(dpcdRead.parseResponseAck(&encoded, &reader) == ParseResponseSuccess);
+    }
+    data = dpcdRead.replyGetData();
+    CHECK(dpcdRead.replyNumOfBytesReadDPCD() == claimed);
+    for (unsigned i = 0; i < claimed; i++)
+        CHECK(data[i] == ((i < sent) ? (NvU8)(0x10 + i) : 0));
+
+    i2cRead.set(Address(), 0, port, NULL, 0x50, claimed);
+    {
+        BitStreamReader reader(&full, 0, full.length * 8);
+        CHECK(i2cRead.parseResponseAck(&encoded, &reader) == ParseResponseSuccess);
+    }
+    {
+        BitStreamReader reader(&shortReply, 0, shortReply.length * 8);
+        CHECK(i2cRead.parseResponseAck(&encoded, &reader) == ParseResponseSuccess);
+    }
+    data = i2cRead.replyGetI2CData(&count);
+    CHECK(count == claimed);
+    for (unsigned i = 0; i < claimed; i++)
+        CHECK(data[i] == ((i < sent) ? (NvU8)(0x10 + i) : 0));
+
+    // Unaligned stream ending in a partial byte
+    {
+        NvU8 out[4];
+        BitStreamReader reader(&shortReply, 4, 8 * 2 + 5);
+
+        memset(out, 0xFF, sizeof(out));
+        CHECK(!reader.readBytes(out, sizeof(out)));
+        CHECK(out[0] == (NvU8)((port << 4) | (claimed >> 4)));
+        CHECK(out[1] == (NvU8)((claimed << 4) | (0x10 >> 4)));
+        CHECK(out[2] == 0 && out[3] == 0);
+    }
+}
+
+static double seconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void benchmark(unsigned iterations)
+{
+    Buffer buffer;
+    LinkAddressMessage message;
+    unsigned sum = 0;
+    double start, encodeTime, decodeTime;
+
+    start = seconds();
+    for (unsigned i = 0; i < iterations; i++)
+    {
+        Buffer scratch;
+        encodeLinkAddressReply(&scratch);
+        sum += scratch.data[scratch.length - 1];
+    }
+    encodeTime = seconds() - start;
+
+    encodeLinkAddressReply(&buffer);
+    start = seconds();
+    for (unsigned i = 0; i < iterations; i++)
+    {
+        decodeLinkAddressReply(&message, &buffer);
+        sum += message.result(BRANCH_PORTS - 1)->SDPStreamSinks;
+    }
+    decodeTime = seconds() - start;
+
+    printf("LINK_ADDRESS reply, %u ports, %u bytes: encode %.0f ns, decode %.0f ns (%u)\n",
+           BRANCH_PORTS, buffer.length,
+           encodeTime * 1e9 / iterations, decodeTime * 1e9 / iterations, sum);
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned iterations = (argc > 1) ? (unsigned)atoi(argv[1]) : 200000;
+
+    testLinkAddress();
+    testShortRemoteReads();
+    benchmark(iterations);
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************* DisplayPort *******************************\
+*                                                                           *
+* Module: dp_test_host.cpp                                                  *
+*    Host functions for running DisplayPort library code in userspace      *
+*    tests.  Assertions abort the test.                                     *
+*                                                                           *
+\***************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dp_hostimp.h"
+
+extern "C" void * dpMalloc(NvLength size)
+{
+    return malloc(size);
+}
+
+extern "C" void dpFree(void * ptr)
+{
+    free(ptr);
+}
+
+extern "C" void dpDebugBreakpoint()
+{
+    abort();
+}
+
+//
+//  DP_LOG output is only wanted when chasing a failure: set DP_TEST_LOG.
+//
+extern "C" void dpPrint(const char * formatter, ...)
+{
+    va_list args;
+
+    if (!getenv("DP_TEST_LOG"))
+        return;
+
+    va_start(args, formatter);
+    vfprintf(stderr, formatter, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+extern "C" void dpTraceEvent(NV_DP_TRACING_EVENT event,
+                             NV_DP_TRACING_PRIORITY priority, NvU32 numArgs, ...)
+{
+}
+
+#if NV_DP_ASSERT_ENABLED
+extern "C" void dpAssert(const char *expression, const char *file,
+                         const char *function, int line)
+{
+    fprintf(stderr, "DP assertion failed: %s at %s:%d (%s)\n",
+            expression, file, line, function);
+}
+#endif
@@ -0,0 +1,506 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************* DisplayPort *******************************\
+*                                                                           *
+* Module: dp_timer_test.cpp                                                 *
+*    Drives DisplayPort::Timer from a fake RawTimer.                        *
+*                                                                           *
+*    A random script of queue and cancel calls is played against Timer    *
+*    and against ListTimer, a copy of the list-based timer that Timer       *
+*    replaced.  Both must fire the same callbacks in the same pump step.    *
+*    Timer must also fire due callbacks by deadline, FIFO among equal       *
+*    deadlines, honor executeInSleep and cancel exactly what was asked.     *
+*                                                                           *
+*    Usage: dp_timer_test [callbacks]                                       *
+*                                                                           *
+\***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dp_internal.h"
+#include "dp_timer.h"
+
+using namespace DisplayPort;
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static unsigned failures;
+
+//
+//  Fake RawTimer: time only moves when the test moves it.
+//
+class FakeRawTimer : public RawTimer
+{
+public:
+    NvU64 now;
+
+    FakeRawTimer() : now(0) {}
+    virtual void queueCallback(Callback * callback, int milliseconds) {}
+    virtual NvU64 getTimeUs() { return now; }
+    virtual void sleep(int milliseconds) { now += (NvU64)milliseconds * 1000; }
+};
+
+//
+//  The list-based timer Timer replaced, kept as the reference.
+//
+class ListTimer
+{
+    struct PendingCallback : ListElement
+    {
+        Timer::TimerCallback * target;
+        const void *           context;
+        NvU64                  timestamp;
+        bool                   executeInSleep;
+    };
+
+    RawTimer * raw;
+    List       pending;
+
+public:
+    ListTimer(RawTimer * raw) : raw(raw) {}
+
+    void fire(bool fromSleep)
+    {
+    restart:
+        NvU64 now = raw->getTimeUs();
+        for (PendingCallback * i = (PendingCallback *)pending.begin(); i != pending.end(); )
+        {
+            if ((fromSleep && !i->executeInSleep) || now < i->timestamp)
+            {
+                i = (PendingCallback *)i->next;
+                continue;
+            }
+
+            const void * context = i->context;
+            Timer::TimerCallback * target = i->target;
+            delete i;
+            if (target)
+                target->expired(context);
+            goto restart;
+        }
+    }
+
+    void queueCallback(Timer::TimerCallback * target, const void * context, unsigned milliseconds, bool executeInSleep)
+    {
+        PendingCallback * callback = new PendingCallback();
+        callback->target = target;
+        callback->context = context;
+        callback->timestamp = raw->getTimeUs() + milliseconds * 1000;
+        callback->executeInSleep = executeInSleep;
+        pending.insertBack(callback);
+    }
+
+    void queueCallbackInOrder(Timer::TimerCallback * target, const void * context, unsigned milliseconds, bool executeInSleep)
+    {
+        PendingCallback * callback = new PendingCallback();
+        PendingCallback * i;
+
+        callback->target = target;
+        callback->context = context;
+        callback->timestamp = raw->getTimeUs() + milliseconds * 1000;
+        callback->executeInSleep = executeInSleep;
+
+        for (i = (PendingCallback *)pending.begin(); i != pending.end(); i = (PendingCallback *)i->next)
+            if (i->context == context && i->timestamp > callback->timestamp)
+                break;
+
+        if (i == pending.end())
+            pending.insertBack(callback);
+        else
+            pending.insertBefore(i, callback);
+    }
+
+    void cancelCallbacks(Timer::TimerCallback * to)
+    {
+        for (PendingCallback * i = (PendingCallback *)pending.begin(); i != pending.end(); i = (PendingCallback *)i->next)
+            if (i->target == to)
+                i->target = 0;
+    }
+
+    void cancelCallback(Timer::TimerCallback * to, const void * context)
+    {
+        for (PendingCallback * i = (PendingCallback *)pending.begin(); i != pending.end(); i = (PendingCallback *)i->next)
+            if (i->target == to && i->context == context)
+                i->target = 0;
+    }
+
+    void cancelCallbacksWithoutContext(const void * context)
+    {
+        for (PendingCallback * i = (PendingCallback *)pending.begin(); i != pending.end(); i = (PendingCallback *)i->next)
+            if (i->context != context)
+                i->target = 0;
+    }
+
+    bool checkCallbacksOfSameContext(const void * context)
+    {
+        for (PendingCallback * i = (PendingCallback *)pending.begin(); i != pending.end(); i = (PendingCallback *)i->next)
+            if (i->target && i->context == context)
+                return true;
+        return false;
+    }
+};
+
+//
+//  Records every expiry as (pump step, target, context).
+//
+struct FireRecord
+{
+    NvU32 step;
+    NvU32 target;
+    NvU32 context;
+};
+
+struct FireLog
+{
+    FireRecord * records;
+    unsigned     count;
+    unsigned     capacity;
+    NvU32        step;
+};
+
+static void logFire(FireLog * log, NvU32 target, NvU32 context)
+{
+    if (log->count == log->capacity)
+    {
+        log->capacity = log->capacity ? log->capacity * 2 : 1024;
+        log->records = (FireRecord *)realloc(log->records, log->capacity * sizeof(FireRecord));
+    }
+    log->records[log->count].step = log->step;
+    log->records[log->count].target = target;
+    log->records[log->count].context = context;
+    log->count++;
+}
+
+#define TARGET_COUNT    64
+#define CONTEXT_COUNT   16
+
+static char contextTags[CONTEXT_COUNT];
+
+struct LoggingTarget : public Timer::TimerCallback
+{
+    FireLog * log;
+    NvU32     id;
+
+    virtual void expired(const void * context)
+    {
+        logFire(log, id, (NvU32)((const char *)context - contextTags));
+    }
+};
+
+static int compareRecords(const void * a, const void * b)
+{
+    const FireRecord * x = (const FireRecord *)a;
+    const FireRecord * y = (const FireRecord *)b;
+
+    if (x->step != y->step)
+        return x->step < y->step ? -1 : 1;
+    if (x->target != y->target)
+        return x->target < y->target ? -1 : 1;
+    if (x->context != y->context)
+        return x->context < y->context ? -1 : 1;
+    return 0;
+}
+
+static double seconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void fireFromSleep(Timer & timer) { timer.sleep(0); }
+static void fireFromSleep(ListTimer & timer) { timer.fire(true); }
+static void fireFromExpiry(Timer & timer) { ((RawTimer::Callback &)timer).expired(); }
+static void fireFromExpiry(ListTimer & timer) { timer.fire(false); }
+
+//
+//  Play one random script against either timer.  The script only depends on
+//  the seed, so both runs issue identical calls.
+//
+template <class T>
+static double playScript(T & timer, FakeRawTimer & raw, FireLog * log, unsigned count, unsigned seed)
+{
+    LoggingTarget targets[TARGET_COUNT];
+    double start = seconds();
+    unsigned i;
+
+    srand(seed);
+    for (i = 0; i < TARGET_COUNT; i++)
+    {
+        targets[i].log = log;
+        targets[i].id = i;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        LoggingTarget * target = &targets[rand() % TARGET_COUNT];
+        const void * context = &contextTags[rand() % CONTEXT_COUNT];
+        unsigned milliseconds = rand() % 5000;
+        bool executeInSleep = (rand() % 4) != 0;
+
+        if (rand() % 2)
+            timer.queueCallback(target, context, milliseconds, executeInSleep);
+        else
+            timer.queueCallbackInOrder(target, context, milliseconds, executeInSleep);
+
+        if (rand() % 50 == 0)
+            timer.cancelCallback(&targets[rand() % TARGET_COUNT], &contextTags[rand() % CONTEXT_COUNT]);
+        if (rand() % 500 == 0)
+            timer.cancelCallbacks(&targets[rand() % TARGET_COUNT]);
+        if (i == count / 2)
+            timer.cancelCallbacksWithoutContext(&contextTags[rand() % CONTEXT_COUNT]);
+        if (rand() % 100 == 0)
+            logFire(log, 0xFFFFFFFF, timer.checkCallbacksOfSameContext(&contextTags[rand() % CONTEXT_COUNT]));
+
+        // Sub-millisecond steps keep most deadlines distinct
+        raw.now += rand() % 3;
+
+        // Every so often, pump from "sleep" so executeInSleep matters
+        if (rand() % 200 == 0)
+        {
+            log->step++;
+            fireFromSleep(timer);
+        }
+    }
+
+    // Pump in 1ms steps until everything has fired
+    for (i = 0; i < 6000; i++)
+    {
+        raw.now += 1000;
+        log->step++;
+        fireFromExpiry(timer);
+    }
+
+    // Targets must not have anything left queued when they go away
+    for (i = 0; i < TARGET_COUNT; i++)
+        timer.cancelCallbacks(&targets[i]);
+
+    return seconds() - start;
+}
+
+static void testMatchesListTimer(unsigned count)
+{
+    FakeRawTimer newRaw, oldRaw;
+    Timer newTimer(&newRaw);
+    ListTimer oldTimer(&oldRaw);
+    FireLog newLog = {0}, oldLog = {0};
+    double newTime, oldTime;
+
+    newTime = playScript(newTimer, newRaw, &newLog, count, 3);
+    oldTime = playScript(oldTimer, oldRaw, &oldLog, count, 3);
+
+    // Within a pump step the list timer fires in list order rather than by
+    // deadline, so compare what fired in each step.
+    qsort(newLog.records, newLog.count, sizeof(FireRecord), compareRecords);
+    qsort(oldLog.records, oldLog.count, sizeof(FireRecord), compareRecords);
+
+    CHECK(newLog.count == oldLog.count);
+    CHECK(newLog.count > count / 8);
+    if (newLog.count == oldLog.count)
+        CHECK(memcmp(newLog.records, oldLog.records, newLog.count * sizeof(FireRecord)) == 0);
+
+    printf("%u callbacks, %u expiries: heap %.3f ms, list %.3f ms\n",
+           count, newLog.count, newTime * 1e3, oldTime * 1e3);
+
+    free(newLog.records);
+    free(oldLog.records);
+}
+
+//
+//  Records the order in which callbacks fire, by context index.
+//
+struct OrderTarget : public Timer::TimerCallback
+{
+    unsigned * order;
+    unsigned   count;
+    Timer *    timer;
+    unsigned   sleepOnFire;
+
+    virtual void expired(const void * context)
+    {
+        order[count++] = (unsigned)(size_t)context;
+
+        // Sleeping from a callback re-enters fire()
+        if (sleepOnFire && order[count - 1] == sleepOnFire)
+            timer->sleep(1);
+    }
+};
+
+static void testDeadlineOrder()
+{
+    enum { COUNT = 4096 };
+    FakeRawTimer raw;
+    Timer timer(&raw);
+    OrderTarget target;
+    static unsigned order[COUNT];
+    static unsigned deadline[COUNT + 1];
+    unsigned i;
+
+    target.order = order;
+    target.count = 0;
+    target.timer = &timer;
+    target.sleepOnFire = COUNT / 3;
+
+    // Few distinct deadlines, so FIFO among equal ones is exercised. Context
+    // i + 1 identifies the i-th queued callback.
+    srand(7);
+    for (i = 1; i <= COUNT; i++)
+    {
+        deadline[i] = rand() % 64;
+        timer.queueCallback(&target, (const void *)(size_t)i, deadline[i]);
+    }
+
+    raw.now += 100 * 1000;
+    ((RawTimer::Callback &)timer).expired();
+
+    CHECK(target.count == COUNT);
+    for (i = 1; i < target.count; i++)
+    {
+        unsigned a = order[i - 1], b = order[i];
+        CHECK(deadline[a] < deadline[b] || (deadline[a] == deadline[b] && a < b));
+    }
+}
+
+static void testExecuteInSleep()
+{
+    FakeRawTimer raw;
+    Timer timer(&raw);
+    OrderTarget target;
+    unsigned order[4];
+
+    target.order = order;
+    target.count = 0;
+    target.timer = &timer;
+    target.sleepOnFire = 0;
+
+    timer.queueCallback(&target, (const void *)1, 1, false);
+    timer.queueCallback(&target, (const void *)2, 2, true);
+
+    // Only the callback allowed to run from sleep fires while sleeping
+    timer.sleep(5);
+    CHECK(target.count == 1 && order[0] == 2);
+
+    ((RawTimer::Callback &)timer).expired();
+    CHECK(target.count == 2 && order[1] == 1);
+}
+
+static void testCancel()
+{
+    FakeRawTimer raw;
+    Timer timer(&raw);
+    OrderTarget a, b;
+    unsigned orderA[64], orderB[64];
+    Timer::CallbackHandle handle, stale;
+
+    a.order = orderA; a.count = 0; a.timer = &timer; a.sleepOnFire = 0;
+    b.order = orderB; b.count = 0; b.timer = &timer; b.sleepOnFire = 0;
+
+    // Cancel by target and context leaves other contexts and targets alone
+    timer.queueCallback(&a, (const void *)1, 1);
+    timer.queueCallback(&a, (const void *)2, 2);
+    timer.queueCallback(&a, (const void *)1, 3);
+    timer.queueCallback(&b, (const void *)1, 4);
+    timer.cancelCallback(&a, (const void *)1);
+    CHECK(timer.checkCallbacksOfSameContext((const void *)1));
+    raw.now += 10 * 1000;
+    ((RawTimer::Callback &)timer).expired();
+    CHECK(a.count == 1 && orderA[0] == 2);
+    CHECK(b.count == 1 && orderB[0] == 1);
+    CHECK(a.firstPending == (unsigned)-1 && b.firstPending == (unsigned)-1);
+
+    // Cancel by target
+    a.count = b.count = 0;
+    timer.queueCallback(&a, (const void *)1, 1);
+    timer.queueCallback(&b, (const void *)2, 1);
+    timer.queueCallback(&a, (const void *)3, 1);
+    timer.cancelCallbacks(&a);
+    raw.now += 10 * 1000;
+    ((RawTimer::Callback &)timer).expired();
+    CHECK(a.count == 0);
+    CHECK(b.count == 1 && orderB[0] == 2);
+
+    // Cancel by handle, once
+    a.count = 0;
+    handle = timer.queueCallback(&a, (const void *)1, 1);
+    timer.queueCallback(&a, (const void *)2, 1);
+    CHECK(handle != 0);
+    CHECK(timer.cancelCallback(handle));
+    CHECK(!timer.cancelCallback(handle));
+    raw.now += 10 * 1000;
+    ((RawTimer::Callback &)timer).expired();
+    CHECK(a.count == 1 && orderA[0] == 2);
+
+    // A handle goes stale once its callback fired, even if the slot is reused
+    stale = timer.queueCallback(&a, (const void *)3, 1);
+    raw.now += 10 * 1000;
+    ((RawTimer::Callback &)timer).expired();
+    handle = timer.queueCallback(&a, (const void *)4, 1);
+    CHECK(!timer.cancelCallback(stale));
+    CHECK(timer.cancelCallback(handle));
+
+    // Cancel everything except one context
+    a.count = b.count = 0;
+    timer.queueCallback(&a, (const void *)1, 1);
+    timer.queueCallback(&b, (const void *)2, 1, false);
+    timer.queueCallback(&b, (const void *)1, 2, false);
+    timer.queueCallback(&a, (const void *)3, 3);
+    timer.cancelCallbacksWithoutContext((const void *)1);
+    CHECK(!timer.checkCallbacksOfSameContext((const void *)2));
+    CHECK(!timer.checkCallbacksOfSameContext((const void *)3));
+    raw.now += 10 * 1000;
+    ((RawTimer::Callback &)timer).expired();
+    CHECK(a.count == 1 && orderA[0] == 1);
+    CHECK(b.count == 1 && orderB[0] == 1);
+
+    // Cancel everything
+    timer.queueCallback(&a, (const void *)1, 1);
+    timer.queueCallback(&b, (const void *)2, 1, false);
+    timer.cancelAllCallbacks();
+    CHECK(a.firstPending == (unsigned)-1 && b.firstPending == (unsigned)-1);
+    CHECK(!timer.checkCallbacksOfSameContext((const void *)1));
+}
+
+int main(int argc, char ** argv)
+{
+    unsigned count = (argc > 1) ? (unsigned)atoi(argv[1]) : 10000;
+
+    testDeadlineOrder();
+    testExecuteInSleep();
+    testCancel();
+    testMatchesListTimer(count);
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
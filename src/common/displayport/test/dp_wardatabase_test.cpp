@@ -0,0 +1,380 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************* DisplayPort *******************************\
+*                                                                           *
+* Module: dp_wardatabase_test.cpp                                           *
+*    EDID and OUI workaround tables against the switch statements they     *
+*    replaced.                                                              *
+*                                                                           *
+*    Every manufacturer and product ID named by the old code, plus IDs     *
+*    that match nothing, is replayed through Edid::applyEdidWorkArounds    *
+*    and referenceEdidWorkArounds (dp_wardatabase_reference.cpp) with      *
+*    year/week values either side of each boundary, each panel name the    *
+*    fixups look for, the EDID contents the fixups test, and each          *
+*    denylist flag.  WARFlags, WARData and the patched EDID bytes must     *
+*    match.  Mismatches are reported per (manufacturer, product).          *
+*                                                                           *
+*    Each OUI the old code named, and its neighbours, is replayed through   *
+*    applyOuiWorkArounds and referenceOuiWorkArounds with the model names  *
+*    it looked for, every truncation of them and every single character   *
+*    substitution, with and without bDscMstCapBug3143315, starting from    *
+*    cleared and from already set connector state.                         *
+*                                                                           *
+*    Usage: dp_wardatabase_test                                             *
+*                                                                           *
+\***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dp_internal.h"
+#include "dp_edid.h"
+#include "dp_wardatabase.h"
+
+using namespace DisplayPort;
+
+void referenceEdidWorkArounds(Edid & edid, NvU32 warFlag, const DpMonitorDenylistData *pDenylistData);
+void referenceOuiWorkArounds(unsigned ouiId, const char * modelName,
+                             bool bDscMstCapBug3143315, OuiWorkAroundState & state);
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+static unsigned failures;
+
+#define ARRAY_COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+// Every manufacturer the old switch had a case for, and one it did not.
+static const unsigned manufacturerIds[] =
+{
+    0x0C32, 0x1006, 0x104d, 0x1863, 0x2C0C, 0x4D24, 0x6D1E, 0x6F0E,
+    0x7038, 0x7204, 0x794D, 0x834C, 0x855C, 0x8F34, 0xA115, 0xAC10,
+    0xAE0D, 0xAF06, 0xC754, 0xD109, 0xE430, 0xE509, 0xF022, 0xF91E,
+    0xa934, 0xc315,
+    0x1234,
+};
+
+//
+// Every product ID the old code compared against, the ends of its one
+// product range (0x0776..0x0779) and their neighbours, and IDs that
+// match nothing.
+//
+static const unsigned productIds[] =
+{
+    0x0000, 0x005F, 0x0469, 0x0775, 0x0776, 0x0777, 0x0779, 0x077A,
+    0x0974, 0x0977, 0x09D9, 0x103C, 0x109B, 0x113C, 0x119B, 0x1414,
+    0x141c, 0x1430, 0x143B, 0x1445, 0x1446, 0x1447, 0x144C, 0x1450,
+    0x145e, 0x1467, 0x1502, 0x1609, 0x1747, 0x192F, 0x1A03, 0x2227,
+    0x3703, 0x4202, 0x4C48, 0x7707, 0x7F2B, 0x7F2F, 0x9227, 0x96a2,
+    0x9880, 0xA092, 0xAA55, 0xE300, 0xF046, 0xad15,
+    0x5555,
+};
+
+// Either side of the Acer (<= 0x0d01) and IBM (== 0x0B32) date checks.
+static const unsigned yearWeeks[] =
+{
+    0x0000, 0x0B31, 0x0B32, 0x0B33, 0x0d01, 0x0d02, 0xFFFF,
+};
+
+//
+// The 13 byte monitor name at 0x71 that the fixups compare, one that is
+// off in the last byte, and one that matches nothing.
+//
+static const char * panelNames[] =
+{
+    "LP171WX2-A4K5",
+    "LP154WX4-TLC3",
+    "LQ156D1JW05\n ",
+    "VVX17P051J00\n",
+    "LP171WX2-A4K6",
+    "XXXXXXXXXXXXX",
+};
+
+//
+// EDID contents the fixups test: the IBM T210 pixel clock at 0x36, and a
+// CEA extension block with and without basic audio.  The last variant is
+// a base block only.
+//
+enum
+{
+    EDID_T210_CLOCK         = (1 << 0),
+    EDID_CEA_EXTENSION      = (1 << 1),
+    EDID_CEA_AUDIO          = (1 << 2),
+    EDID_BASE_BLOCK_ONLY    = (1 << 3),
+    EDID_VARIANT_COUNT      = (1 << 4),
+};
+
+static const NvU32 denylistFlags[] =
+{
+    0,
+    DP_MONITOR_CAPABILITY_DP_SKIP_REDUNDANT_LT,
+    DP_MONITOR_CAPABILITY_DP_SKIP_CABLE_BW_CHECK,
+    DP_MONITOR_CAPABILITY_DP_WRITE_0x600_BEFORE_LT,
+    DP_MONITOR_CAPABILITY_DP_OVERRIDE_OPTIMAL_LINK_CONFIG,
+    DP_MONITOR_CAPABILITY_DP_OVERRIDE_MAX_LANE_COUNT,
+    DP_MONITOR_CAPABILITY_DP_SKIP_REDUNDANT_LT |
+    DP_MONITOR_CAPABILITY_DP_SKIP_CABLE_BW_CHECK |
+    DP_MONITOR_CAPABILITY_DP_WRITE_0x600_BEFORE_LT |
+    DP_MONITOR_CAPABILITY_DP_OVERRIDE_OPTIMAL_LINK_CONFIG |
+    DP_MONITOR_CAPABILITY_DP_OVERRIDE_MAX_LANE_COUNT,
+};
+
+// The Megachips and Synaptics OUIs, their neighbours, and zero.
+static const unsigned ouiIds[] =
+{
+    0xE18000, 0x24CC90, 0xE18001, 0x24CC91, 0x000000,
+};
+
+// Model names the old code looked for, and near misses.
+static const char * modelNames[] =
+{
+    "Dp1.1", "Dp1.2", "Dp1.3", "dp1.1",
+    "SYNAS1", "SYNAS2", "SYNAS3", "SYNAS#", "SYNAS\"", "SYNAS4", "SYNAS",
+};
+
+// Characters substituted into the model names; NUL ends the name early.
+static const char modelNameChars[] = "Dp1.23SYNA#\"4x";
+
+static const OuiWorkAroundState ouiStartStates[] =
+{
+    { false, false, 0,  false },
+    { true,  true,  10, true  },
+};
+
+static bool sameOuiResult(const OuiWorkAroundState & reference, const OuiWorkAroundState & table)
+{
+    return reference.bKeepOptLinkAlive == table.bKeepOptLinkAlive &&
+           reference.bNoFallbackInPostLQA == table.bNoFallbackInPostLQA &&
+           reference.LT2FecLatencyMs == table.LT2FecLatencyMs &&
+           reference.bDscCapBasedOnParent == table.bDscCapBasedOnParent;
+}
+
+//
+// Replays one model name for every OUI, DSC bug setting and start state.
+// Returns the number of replays that changed the cleared start state, and
+// collects the members they set.
+//
+static unsigned replayModelName(const char * modelName, unsigned & cases, OuiWorkAroundState & reached)
+{
+    unsigned applied = 0;
+    unsigned o, d, s;
+
+    for (o = 0; o < ARRAY_COUNT(ouiIds); o++)
+    for (d = 0; d < 2; d++)
+    for (s = 0; s < ARRAY_COUNT(ouiStartStates); s++)
+    {
+        OuiWorkAroundState reference = ouiStartStates[s];
+        OuiWorkAroundState table = ouiStartStates[s];
+
+        referenceOuiWorkArounds(ouiIds[o], modelName, d != 0, reference);
+        applyOuiWorkArounds(ouiIds[o], modelName, d != 0, table);
+
+        if (!sameOuiResult(reference, table))
+        {
+            printf("FAIL oui 0x%06x model \"%s\" dscBug %u start %u\n",
+                   ouiIds[o], modelName, d, s);
+            failures++;
+        }
+        if (s == 0 && !sameOuiResult(reference, ouiStartStates[0]))
+        {
+            reached.bKeepOptLinkAlive |= reference.bKeepOptLinkAlive;
+            reached.bNoFallbackInPostLQA |= reference.bNoFallbackInPostLQA;
+            reached.LT2FecLatencyMs |= reference.LT2FecLatencyMs;
+            reached.bDscCapBasedOnParent |= reference.bDscCapBasedOnParent;
+            applied++;
+        }
+        cases++;
+    }
+
+    return applied;
+}
+
+static void replayOuiWorkArounds()
+{
+    char modelName[NV_DPCD_SOURCE_DEV_ID_STRING__SIZE + 1];
+    OuiWorkAroundState reached = ouiStartStates[0];
+    unsigned cases = 0, applied = 0;
+    unsigned m, i, c;
+
+    for (m = 0; m < ARRAY_COUNT(modelNames); m++)
+    {
+        // Every truncation, including the empty name
+        for (i = 0; i <= strlen(modelNames[m]); i++)
+        {
+            memset(modelName, 0, sizeof(modelName));
+            memcpy(modelName, modelNames[m], i);
+            applied += replayModelName(modelName, cases, reached);
+        }
+
+        // Every single character substitution, keeping the bytes after a NUL
+        for (i = 0; i < sizeof(modelName) - 1; i++)
+        {
+            for (c = 0; c < sizeof(modelNameChars); c++)
+            {
+                memset(modelName, 0, sizeof(modelName));
+                strncpy(modelName, modelNames[m], sizeof(modelName) - 1);
+                modelName[i] = modelNameChars[c];
+                applied += replayModelName(modelName, cases, reached);
+            }
+        }
+    }
+
+    // Guard against a sweep that never reaches one of the workarounds.
+    printf("%u OUI cases, %u with a workaround\n", cases, applied);
+    CHECK(reached.bKeepOptLinkAlive);
+    CHECK(reached.bNoFallbackInPostLQA);
+    CHECK(reached.LT2FecLatencyMs == 57);
+    CHECK(reached.bDscCapBasedOnParent);
+}
+
+static void buildEdid(Edid & edid, unsigned manufacturerId, unsigned productId,
+                      unsigned yearWeek, const char * name, unsigned variant)
+{
+    Buffer * buffer = edid.getBuffer();
+    unsigned i;
+
+    buffer->resize((variant & EDID_BASE_BLOCK_ONLY) ? 128 : 256);
+    for (i = 0; i < buffer->getLength(); i++)
+        buffer->data[i] = (NvU8)(i * 37 + variant);
+
+    buffer->data[0x08] = manufacturerId & 0xff;
+    buffer->data[0x09] = manufacturerId >> 8;
+    buffer->data[0x0a] = productId & 0xff;
+    buffer->data[0x0b] = productId >> 8;
+    buffer->data[0x10] = yearWeek & 0xff;
+    buffer->data[0x11] = yearWeek >> 8;
+    memcpy(&buffer->data[0x71], name, 13);
+
+    if (variant & EDID_T210_CLOCK)
+    {
+        buffer->data[0x36] = 0x9A;
+        buffer->data[0x37] = 0x29;
+    }
+
+    if (variant & EDID_CEA_EXTENSION)
+    {
+        buffer->data[0x7E] = 1;
+        if (buffer->getLength() > 0x80)
+        {
+            buffer->data[0x80] = 0x02;
+            buffer->data[0x81] = 0x03;
+            buffer->data[0x83] = (variant & EDID_CEA_AUDIO) ? 0x40 : 0x00;
+        }
+    }
+
+    memset(&edid.WARData, 0, sizeof(edid.WARData));
+}
+
+static bool flagsSet(const Edid & edid)
+{
+    static const Edid::_WARFlags none = {0};
+
+    return memcmp(&edid.WARFlags, &none, sizeof(none)) != 0;
+}
+
+static bool sameResult(Edid & reference, Edid & table)
+{
+    Buffer * referenceBuffer = reference.getBuffer();
+    Buffer * tableBuffer = table.getBuffer();
+
+    return memcmp(&reference.WARFlags, &table.WARFlags, sizeof(table.WARFlags)) == 0 &&
+           memcmp(&reference.WARData, &table.WARData, sizeof(table.WARData)) == 0 &&
+           referenceBuffer->getLength() == tableBuffer->getLength() &&
+           memcmp(referenceBuffer->data, tableBuffer->data, tableBuffer->getLength()) == 0;
+}
+
+int main(int argc, char ** argv)
+{
+    DpMonitorDenylistData denylistData;
+    unsigned cases = 0, matchedPairs = 0;
+    unsigned m, p, y, n, v, f;
+
+    denylistData.dpMaxLaneCountOverride = 2;
+    denylistData.dpSkipCheckLink.maxLaneAtHighRate = 2;
+    denylistData.dpSkipCheckLink.maxLaneAtLowRate = 4;
+    denylistData.dpOverrideOptimalLinkConfig.linkRate = 0x14;
+    denylistData.dpOverrideOptimalLinkConfig.laneCount = 4;
+
+    for (m = 0; m < ARRAY_COUNT(manufacturerIds); m++)
+    {
+        for (p = 0; p < ARRAY_COUNT(productIds); p++)
+        {
+            unsigned mismatches = 0;
+            bool matched = false;
+
+            for (y = 0; y < ARRAY_COUNT(yearWeeks); y++)
+            for (n = 0; n < ARRAY_COUNT(panelNames); n++)
+            for (v = 0; v < EDID_VARIANT_COUNT; v++)
+            for (f = 0; f < ARRAY_COUNT(denylistFlags); f++)
+            {
+                Edid reference, table;
+
+                buildEdid(reference, manufacturerIds[m], productIds[p],
+                          yearWeeks[y], panelNames[n], v);
+                buildEdid(table, manufacturerIds[m], productIds[p],
+                          yearWeeks[y], panelNames[n], v);
+
+                referenceEdidWorkArounds(reference, denylistFlags[f], &denylistData);
+                table.applyEdidWorkArounds(denylistFlags[f], &denylistData);
+
+                if (!sameResult(reference, table))
+                    mismatches++;
+                if (!denylistFlags[f] && flagsSet(reference))
+                    matched = true;
+                cases++;
+            }
+
+            if (mismatches)
+            {
+                printf("FAIL manufacturer 0x%04x product 0x%04x: %u mismatches\n",
+                       manufacturerIds[m], productIds[p], mismatches);
+                failures++;
+            }
+            if (matched)
+                matchedPairs++;
+        }
+    }
+
+    //
+    // Guard against a sweep that never reaches a workaround: the old code
+    // applies one to 46 (manufacturer, product) pairs in this sweep, plus
+    // every product of the two Unigraf IDs.
+    //
+    printf("%u cases, %u (manufacturer, product) pairs with a workaround\n",
+           cases, matchedPairs);
+    CHECK(matchedPairs == 46 + 2 * ARRAY_COUNT(productIds));
+
+    replayOuiWorkArounds();
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -178,11 +178,16 @@ extern NVLOG_LOGGER NvLogLogger;
 // STATE - Lock only during state change, do memory copying unlocked
 //         Don't use with tiny buffers that overflow every write or two.
 // FULL  - Keep everything locked for the full duration of the write
+// PERCPU - Writers stage sequence numbered records in per-CPU rings without
+//          taking a lock. Staged records are merged into the buffer in
+//          sequence order when it is read. Ring buffers only. Meant for
+//          buffers with many concurrent writers; no buffer uses it yet.
 //
 #define NVLOG_BUFFER_FLAGS_LOCKING                      6:5
 #define NVLOG_BUFFER_FLAGS_LOCKING_NONE                  0
 #define NVLOG_BUFFER_FLAGS_LOCKING_STATE                 1
 #define NVLOG_BUFFER_FLAGS_LOCKING_FULL                  2
+#define NVLOG_BUFFER_FLAGS_LOCKING_PERCPU                3
 
 // Store this buffer in OCA minidumps
 #define NVLOG_BUFFER_FLAGS_OCA                          7:7
@@ -207,6 +212,8 @@ typedef NvU32 NVLOG_BUFFER_HANDLE;
     FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _TYPE, _RING, pBuffer->flags)
 #define NVLOG_IS_NOWRAP_BUFFER(pBuffer)                                        \
     FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _TYPE, _NOWRAP, pBuffer->flags)
+#define NVLOG_IS_PERCPU_BUFFER(pBuffer)                                        \
+    FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _LOCKING, _PERCPU, pBuffer->flags)
 
 #define NVLOG_PRINT_BUFFER_SIZE(pBuffer)               ((pBuffer)->size)
 #define NVLOG_BUFFER_SIZE(pBuffer)                                             \
@@ -82,4 +82,96 @@ typedef struct NV2080_CTRL_GSP_GET_FEATURES_PARAMS {
 #define NV2080_CTRL_GSP_GET_FEATURES_UVM_ENABLED_FALSE (0x00000000)
 #define NV2080_CTRL_GSP_GET_FEATURES_UVM_ENABLED_TRUE  (0x00000001)
 
+/*
+ * NV2080_CTRL_CMD_GSP_GET_RPC_PROFILE
+ *
+ * This command returns the GSP RPC latency profile collected by the
+ * CPU RM, one entry per RPC function that has completed at least once
+ * since profiling was enabled or last reset.
+ *
+ *   firstFunction
+ *     [IN] First RPC function to report. Start at 0 and pass back
+ *     nextFunction to continue.
+ *   nextFunction
+ *     [OUT] RPC function to resume from, or
+ *     NV2080_CTRL_GSP_RPC_PROFILE_FUNCTION_END once all are reported.
+ *   bEnabled
+ *     [OUT] Whether profiling is enabled. No entries are returned if not.
+ *   entryCount
+ *     [OUT] Number of valid entries.
+ *   entries
+ *     [OUT] Per-function profile:
+ *       function       RPC function number (NV_VGPU_MSG_FUNCTION_*)
+ *       count          Number of completed RPCs
+ *       p50Ns, p99Ns   Median and 99th percentile latency, in ns. These come
+ *                      from a log-linear histogram and are within 1/8 of
+ *                      the true value (256ns for very short RPCs).
+ *       maxNs          Largest latency seen, in ns
+ *       totalNs        Sum of all latencies, in ns
+ *       bytesSent      Total size of the RPC messages sent
+ *       bytesReceived  Total size of the replies received
+ *
+ * Possible status return values are:
+ *   NV_OK
+ *   NV_ERR_NOT_SUPPORTED
+ *   NV_ERR_INVALID_ARGUMENT
+ */
+#define NV2080_CTRL_CMD_GSP_GET_RPC_PROFILE      (0x20803602) /* finn: Evaluated from "(FINN_NV20_SUBDEVICE_0_GSP_INTERFACE_ID << 8) | NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS_MESSAGE_ID" */
+
+#define NV2080_CTRL_GSP_RPC_PROFILE_MAX_ENTRIES  (32)
+#define NV2080_CTRL_GSP_RPC_PROFILE_FUNCTION_END (0xFFFFFFFF)
+
+typedef struct NV2080_CTRL_GSP_RPC_PROFILE_ENTRY {
+    NvU32 function;
+    NV_DECLARE_ALIGNED(NvU64 count, 8);
+    NV_DECLARE_ALIGNED(NvU64 p50Ns, 8);
+    NV_DECLARE_ALIGNED(NvU64 p99Ns, 8);
+    NV_DECLARE_ALIGNED(NvU64 maxNs, 8);
+    NV_DECLARE_ALIGNED(NvU64 totalNs, 8);
+    NV_DECLARE_ALIGNED(NvU64 bytesSent, 8);
+    NV_DECLARE_ALIGNED(NvU64 bytesReceived, 8);
+} NV2080_CTRL_GSP_RPC_PROFILE_ENTRY;
+
+#define NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS_MESSAGE_ID (0x2U)
+
+typedef struct NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS {
+    NvU32  firstFunction;
+    NvU32  nextFunction;
+    NvBool bEnabled;
+    NvU32  entryCount;
+    NV_DECLARE_ALIGNED(NV2080_CTRL_GSP_RPC_PROFILE_ENTRY entries[NV2080_CTRL_GSP_RPC_PROFILE_MAX_ENTRIES], 8);
+} NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS;
+
+/*
+ * NV2080_CTRL_CMD_GSP_SET_RPC_PROFILE
+ *
+ * This command controls GSP RPC latency profiling.
+ *
+ *   cmd
+ *     [IN] One of:
+ *       NV2080_CTRL_GSP_RPC_PROFILE_CMD_DISABLE
+ *         Stop profiling and free the collected profile.
+ *       NV2080_CTRL_GSP_RPC_PROFILE_CMD_ENABLE
+ *         Start profiling. Has no effect if profiling is already enabled.
+ *       NV2080_CTRL_GSP_RPC_PROFILE_CMD_RESET
+ *         Discard the collected profile and keep profiling.
+ *
+ * Possible status return values are:
+ *   NV_OK
+ *   NV_ERR_NOT_SUPPORTED
+ *   NV_ERR_INVALID_ARGUMENT
+ *   NV_ERR_NO_MEMORY
+ */
+#define NV2080_CTRL_CMD_GSP_SET_RPC_PROFILE      (0x20803603) /* finn: Evaluated from "(FINN_NV20_SUBDEVICE_0_GSP_INTERFACE_ID << 8) | NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS_MESSAGE_ID" */
+
+#define NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS_MESSAGE_ID (0x3U)
+
+typedef struct NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS {
+    NvU32 cmd;
+} NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS;
+
+#define NV2080_CTRL_GSP_RPC_PROFILE_CMD_DISABLE  (0x00000000)
+#define NV2080_CTRL_GSP_RPC_PROFILE_CMD_ENABLE   (0x00000001)
+#define NV2080_CTRL_GSP_RPC_PROFILE_CMD_RESET    (0x00000002)
+
 // _ctrl2080gsp_h_
@@ -33,6 +33,7 @@
 #include "nvkms-attributes.h"
 #include "nvkms-utils.h"
 #include "nvkms-3dvision.h"
+#include "nvkms-edid-cache.h"
 
 #include "nv_mode_timings_utils.h"
 
@@ -2023,8 +2024,8 @@ static void PatchAndParseEdid(
 
     /* parse the majority of information from the EDID */
 
-    status = NvTiming_ParseEDIDInfo(pEdid->buffer, pEdid->length,
-                                    &pParsedEdid->info);
+    status = nvEdidCacheParseEdidInfo(pEdid->buffer, pEdid->length,
+                                      &pParsedEdid->info);
 
     if (status != NVT_STATUS_SUCCESS) {
         return;
@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * A small cache of parsed EDIDs.
+ *
+ * Every hotplug, resume and dynamic dpy data query re-parses the EDID of
+ * each display, including the CTA-861 and DisplayID extension blocks, even
+ * though the same monitors keep coming back.  The parse only depends on the
+ * EDID bytes, so the resulting NVT_EDID_INFO is remembered here keyed by the
+ * SHA-256 digest and length of those bytes.
+ *
+ * The cache is bounded to NVKMS_EDID_CACHE_SIZE entries and evicts the
+ * least recently used entry.  All callers hold the nvkms lock, so no
+ * additional locking is needed.
+ */
+
+#include "nvkms-edid-cache.h"
+#include "nvkms-utils.h"
+
+#include "nvSha256.h"
+
+#define NVKMS_EDID_CACHE_SIZE 8
+
+typedef struct {
+    /* Most recently used entries are at the front of the list. */
+    NVListRec lruListEntry;
+
+    NvU8 digest[NV_SHA256_DIGEST_SIZE];
+    NvU32 length;
+
+    NVT_EDID_INFO info;
+} NVEdidCacheEntryRec;
+
+static struct {
+    NVListRec lruList;
+    NvU32 entries;
+    NvU64 hits;
+    NvU64 misses;
+} edidCache = {
+    .lruList = NV_LIST_INIT(&edidCache.lruList),
+};
+
+static NVEdidCacheEntryRec *FindEntry(const NvU8 *digest, NvU32 length)
+{
+    NVEdidCacheEntryRec *pEntry;
+
+    nvListForEachEntry(pEntry, &edidCache.lruList, lruListEntry) {
+        if ((pEntry->length == length) &&
+            (nvkms_memcmp(pEntry->digest, digest,
+                          sizeof(pEntry->digest)) == 0)) {
+            return pEntry;
+        }
+    }
+
+    return NULL;
+}
+
+static NVEdidCacheEntryRec *AllocEntry(void)
+{
+    NVEdidCacheEntryRec *pEntry;
+
+    if (edidCache.entries < NVKMS_EDID_CACHE_SIZE) {
+        pEntry = nvAlloc(sizeof(*pEntry));
+        if (pEntry != NULL) {
+            edidCache.entries++;
+            return pEntry;
+        }
+        if (edidCache.entries == 0) {
+            return NULL;
+        }
+    }
+
+    /* Recycle the least recently used entry. */
+    pEntry = nvListLastEntry(&edidCache.lruList,
+                             NVEdidCacheEntryRec, lruListEntry);
+    nvListDel(&pEntry->lruListEntry);
+
+    return pEntry;
+}
+
+/*!
+ * Parse the EDID with NvTiming_ParseEDIDInfo(), reusing the result of an
+ * earlier parse of identical EDID bytes when one is cached.
+ */
+NVT_STATUS nvEdidCacheParseEdidInfo(const NvU8 *pEdid, NvU32 length,
+                                    NVT_EDID_INFO *pInfo)
+{
+    NVEdidCacheEntryRec *pEntry;
+    NvU8 digest[NV_SHA256_DIGEST_SIZE];
+    NVT_STATUS status;
+
+    if ((pEdid == NULL) || (length == 0)) {
+        return NvTiming_ParseEDIDInfo((NvU8 *)pEdid, length, pInfo);
+    }
+
+    nv_sha256(pEdid, length, digest);
+
+    pEntry = FindEntry(digest, length);
+    if (pEntry != NULL) {
+        edidCache.hits++;
+
+        nvListDel(&pEntry->lruListEntry);
+        nvListAdd(&pEntry->lruListEntry, &edidCache.lruList);
+
+        nvkms_memcpy(pInfo, &pEntry->info, sizeof(*pInfo));
+        return NVT_STATUS_SUCCESS;
+    }
+
+    edidCache.misses++;
+
+    status = NvTiming_ParseEDIDInfo((NvU8 *)pEdid, length, pInfo);
+
+    /* Only successful parses are cached; failures are cheap to repeat. */
+    if (status != NVT_STATUS_SUCCESS) {
+        return status;
+    }
+
+    pEntry = AllocEntry();
+    if (pEntry != NULL) {
+        nvkms_memcpy(pEntry->digest, digest, sizeof(pEntry->digest));
+        pEntry->length = length;
+        nvkms_memcpy(&pEntry->info, pInfo, sizeof(pEntry->info));
+
+        nvListAdd(&pEntry->lruListEntry, &edidCache.lruList);
+    }
+
+    return status;
+}
+
+void nvEdidCacheGetStats(NVEdidCacheStatsRec *pStats)
+{
+    pStats->hits = edidCache.hits;
+    pStats->misses = edidCache.misses;
+    pStats->entries = edidCache.entries;
+}
+
+void nvEdidCacheFlush(void)
+{
+    NVEdidCacheEntryRec *pEntry, *pTmp;
+
+    nvListForEachEntry_safe(pEntry, pTmp, &edidCache.lruList, lruListEntry) {
+        nvListDel(&pEntry->lruListEntry);
+        nvFree(pEntry);
+    }
+
+    edidCache.entries = 0;
+}
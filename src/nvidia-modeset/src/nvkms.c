@@ -43,6 +43,7 @@
 #include "nvkms-cursor.h" /* nvSetCursorImage, nvEvoMoveCursor */
 #include "nvkms-flip.h" /* nvFlipEvo */
 #include "nvkms-vrr.h"
+#include "nvkms-edid-cache.h"
 
 #include "dp/nvdp-connector.h"
 
@@ -4297,6 +4298,28 @@ ProcFsPrintDpyCrcs(
     }
 }
 
+static void
+ProcFsPrintEdidCache(
+    void *data,
+    char *buffer,
+    size_t size,
+    nvkms_procfs_out_string_func_t *outString)
+{
+    NVEdidCacheStatsRec stats;
+    NVEvoInfoStringRec infoString;
+
+    nvEdidCacheGetStats(&stats);
+
+    nvInitInfoString(&infoString, buffer, size);
+    nvEvoLogInfoString(&infoString,
+                       "entries                        : %u", stats.entries);
+    nvEvoLogInfoString(&infoString,
+                       "hits                           : %llu", stats.hits);
+    nvEvoLogInfoString(&infoString,
+                       "misses                         : %llu", stats.misses);
+    outString(data, buffer);
+}
+
 #endif /* NVKMS_PROCFS_ENABLE */
 
 void nvKmsGetProcFiles(const nvkms_procfs_file_t **ppProcFiles)
@@ -4307,6 +4330,7 @@ void nvKmsGetProcFiles(const nvkms_procfs_file_t **ppProcFiles)
         { "surfaces",               ProcFsPrintSurfaces },
         { "deferred-request-fifos", ProcFsPrintDeferredRequestFifos },
         { "crcs",                   ProcFsPrintDpyCrcs },
+        { "edid-cache",             ProcFsPrintEdidCache },
         { NULL, NULL },
     };
 
@@ -4368,6 +4392,8 @@ void nvKmsModuleUnload(void)
 {
     FreeGlobalState();
 
+    nvEdidCacheFlush();
+
     nvAssert(nvListIsEmpty(&nvEvoGlobal.frameLockList));
     nvAssert(nvListIsEmpty(&nvEvoGlobal.devList));
 #if defined(DEBUG)
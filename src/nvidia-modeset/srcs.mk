@@ -135,6 +135,7 @@ SRCS += ../common/modeset/timing/nvt_edidext_displayid20.c
 SRCS += ../common/modeset/timing/nvt_gtf.c
 SRCS += ../common/modeset/timing/nvt_tv.c
 SRCS += ../common/modeset/timing/nvt_util.c
+SRCS += ../common/src/nvSha256.c
 SRCS += ../common/unix/common/utils/nv_memory_tracker.c
 SRCS += ../common/unix/common/utils/nv_mode_timings_utils.c
 SRCS += ../common/unix/common/utils/nv_vasprintf.c
@@ -159,6 +160,7 @@ SRCS += src/nvkms-cursor2.c
 SRCS += src/nvkms-cursor3.c
 SRCS += src/nvkms-dma.c
 SRCS += src/nvkms-dpy.c
+SRCS += src/nvkms-edid-cache.c
 SRCS += src/nvkms-event.c
 SRCS += src/nvkms-evo.c
 SRCS += src/nvkms-evo1.c
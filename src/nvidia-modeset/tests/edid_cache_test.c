@@ -0,0 +1,367 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Parsed EDID cache (nvkms-edid-cache.c) checks and cold/warm benchmark.
+ *
+ * The corpus is a set of synthetic 256 byte EDIDs: an EDID 1.4 base block
+ * with standard timings, a 1080p detailed timing, range limits, name and
+ * serial descriptors, and a CTA-861 extension with a video data block of
+ * up to 24 VICs, audio, speaker allocation, HDMI and HDMI Forum VSDBs,
+ * colorimetry and HDR static metadata blocks and a 720p detailed timing.
+ * Monitors differ in product code, serial, name, VIC list and which
+ * blocks are present.
+ *
+ * Every cached result, from a miss and from a hit, must match an uncached
+ * NvTiming_ParseEDIDInfo() of the same bytes, and the hit and miss counts
+ * must follow the LRU: a working set that fits is all hits after the first
+ * pass, one larger than the cache is all misses.
+ *
+ * The benchmark cycles through the monitors the way repeated hotplugs
+ * and dynamic dpy data queries do, and reports the time per parse for
+ * the uncached parser, a cold cache (flushed before every parse, so each
+ * call hashes, parses and fills an entry) and a warm cache (every call
+ * hits).
+ *
+ *     edid_cache_test [parses per pass]
+ */
+
+#include "nvkms-edid-cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+static unsigned failures;
+
+// Matches NVKMS_EDID_CACHE_SIZE in nvkms-edid-cache.c
+#define CACHE_SIZE      8
+#define MONITOR_COUNT   (CACHE_SIZE + 4)
+#define EDID_SIZE       256
+
+static NvU8 edids[MONITOR_COUNT][EDID_SIZE];
+
+static NvU64 _nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (NvU64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void _checksum(NvU8 *pBlock)
+{
+    NvU8 sum = 0;
+    unsigned i;
+
+    for (i = 0; i < 127; i++)
+        sum += pBlock[i];
+    pBlock[127] = (NvU8)(0x100 - sum);
+}
+
+static void _descriptor(NvU8 *pDesc, NvU8 tag, const char *pText)
+{
+    size_t len = strlen(pText);
+
+    memset(pDesc, 0, 18);
+    pDesc[3] = tag;
+    memset(&pDesc[5], ' ', 13);
+    memcpy(&pDesc[5], pText, len);
+    if (len < 13)
+        pDesc[5 + len] = '\n';
+}
+
+static void _buildEdid(NvU8 *pEdid, unsigned monitor)
+{
+    static const NvU8 header[8] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+    static const NvU8 chroma[10] = { 0xEE, 0x91, 0xA3, 0x54, 0x4C, 0x99, 0x26, 0x0F, 0x50, 0x54 };
+    // 1920x1080@60 and 1280x720@60
+    static const NvU8 dtd1080p[18] = { 0x02, 0x3A, 0x80, 0x18, 0x71, 0x38, 0x2D, 0x40, 0x58,
+                                       0x2C, 0x45, 0x00, 0x56, 0x50, 0x21, 0x00, 0x00, 0x1E };
+    static const NvU8 dtd720p[18]  = { 0x01, 0x1D, 0x00, 0x72, 0x51, 0xD0, 0x1E, 0x20, 0x6E,
+                                       0x28, 0x55, 0x00, 0x56, 0x50, 0x21, 0x00, 0x00, 0x1E };
+    static const NvU8 rangeLimits[18] = { 0x00, 0x00, 0x00, 0xFD, 0x00, 0x38, 0x4B, 0x1E, 0x53,
+                                          0x11, 0x00, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 };
+    static const NvU8 vics[] = { 16, 4, 31, 19, 2, 3, 17, 18, 1, 5, 20, 32,
+                                 33, 34, 93, 94, 95, 97, 96, 98, 63, 64, 107, 108 };
+    NvU8 *pExt = pEdid + 128;
+    NvU32 serial = 0x01000193 * (monitor + 1);
+    unsigned vicCount = 8 + (monitor * 5) % 17;
+    char text[14];
+    unsigned i, p;
+
+    memset(pEdid, 0, EDID_SIZE);
+
+    // Base block
+    memcpy(pEdid, header, sizeof(header));
+    pEdid[8] = 0x3A;                                // "NVD"
+    pEdid[9] = 0xC4;
+    pEdid[10] = (NvU8)(0x40 + monitor);
+    pEdid[11] = 0x12;
+    memcpy(&pEdid[12], &serial, sizeof(serial));
+    pEdid[16] = (NvU8)(1 + monitor);
+    pEdid[17] = 30 + (monitor % 6);
+    pEdid[18] = 1;
+    pEdid[19] = 4;
+    pEdid[20] = 0xA5;
+    pEdid[21] = 60;
+    pEdid[22] = 34;
+    pEdid[23] = 0x78;
+    pEdid[24] = 0x3A;
+    memcpy(&pEdid[25], chroma, sizeof(chroma));
+    pEdid[35] = 0x21;
+    pEdid[36] = 0x08;
+    for (i = 38; i < 54; i++)
+        pEdid[i] = 0x01;
+    pEdid[38] = 0x81;                               // 1280x1024@60
+    pEdid[39] = 0x80;
+    pEdid[40] = 0xB3;                               // 1680x1050@60
+    pEdid[41] = 0x00;
+    pEdid[42] = 0xD1;                               // 1920x1080@60
+    pEdid[43] = 0xC0;
+    memcpy(&pEdid[54], dtd1080p, sizeof(dtd1080p));
+    memcpy(&pEdid[72], rangeLimits, sizeof(rangeLimits));
+    snprintf(text, sizeof(text), "NVTEST %u", monitor);
+    _descriptor(&pEdid[90], 0xFC, text);
+    snprintf(text, sizeof(text), "%08X", serial);
+    _descriptor(&pEdid[108], 0xFF, text);
+    pEdid[126] = 1;
+    _checksum(pEdid);
+
+    // CTA-861 extension
+    pExt[0] = 0x02;
+    pExt[1] = 0x03;
+    pExt[3] = 0xF1;
+    p = 4;
+
+    pExt[p++] = (2 << 5) | vicCount;
+    for (i = 0; i < vicCount; i++)
+        pExt[p++] = vics[(i + monitor) % sizeof(vics)] | (i == 0 ? 0x80 : 0);
+
+    pExt[p++] = (1 << 5) | 3;                       // LPCM 2ch 32/44.1/48 kHz
+    pExt[p++] = 0x09;
+    pExt[p++] = 0x07;
+    pExt[p++] = 0x07;
+
+    pExt[p++] = (4 << 5) | 3;                       // FL/FR
+    pExt[p++] = 0x01;
+    pExt[p++] = 0x00;
+    pExt[p++] = 0x00;
+
+    if (monitor % 3 != 2)
+    {
+        static const NvU8 hdmiVsdb[] = { (3 << 5) | 7, 0x03, 0x0C, 0x00, 0x10, 0x00, 0x38, 0x3C };
+        static const NvU8 hfVsdb[]   = { (3 << 5) | 7, 0xD8, 0x5D, 0xC4, 0x01, 0x78, 0x80, 0x03 };
+
+        memcpy(&pExt[p], hdmiVsdb, sizeof(hdmiVsdb));
+        p += sizeof(hdmiVsdb);
+        if (monitor % 2 == 0)
+        {
+            memcpy(&pExt[p], hfVsdb, sizeof(hfVsdb));
+            p += sizeof(hfVsdb);
+        }
+    }
+
+    if (monitor % 4 != 3)
+    {
+        static const NvU8 colorimetry[] = { (7 << 5) | 3, 0x05, 0xC0, 0x00 };
+        static const NvU8 hdrStatic[]   = { (7 << 5) | 3, 0x06, 0x05, 0x01 };
+
+        memcpy(&pExt[p], colorimetry, sizeof(colorimetry));
+        p += sizeof(colorimetry);
+        memcpy(&pExt[p], hdrStatic, sizeof(hdrStatic));
+        p += sizeof(hdrStatic);
+    }
+
+    pExt[2] = (NvU8)p;
+    memcpy(&pExt[p], dtd720p, sizeof(dtd720p));
+    _checksum(pExt);
+}
+
+//
+// The parser clears the whole NVT_EDID_INFO first, so the result is filled
+// with a pattern beforehand to catch a cache hit that copies only part of it.
+//
+static NVT_EDID_INFO *_parse(const NvU8 *pEdid, NvBool bCached, NVT_STATUS *pStatus)
+{
+    NVT_EDID_INFO *pInfo = malloc(sizeof(*pInfo));
+
+    memset(pInfo, 0xA5, sizeof(*pInfo));
+    *pStatus = bCached ? nvEdidCacheParseEdidInfo(pEdid, EDID_SIZE, pInfo) :
+                         NvTiming_ParseEDIDInfo((NvU8 *)pEdid, EDID_SIZE, pInfo);
+    return pInfo;
+}
+
+static NvBool _sameAsUncached(const NvU8 *pEdid)
+{
+    NVT_STATUS uncachedStatus, cachedStatus;
+    NVT_EDID_INFO *pUncached = _parse(pEdid, NV_FALSE, &uncachedStatus);
+    NVT_EDID_INFO *pCached = _parse(pEdid, NV_TRUE, &cachedStatus);
+    NvBool bSame = (uncachedStatus == NVT_STATUS_SUCCESS) &&
+                   (cachedStatus == NVT_STATUS_SUCCESS) &&
+                   (memcmp(pUncached, pCached, sizeof(*pCached)) == 0);
+
+    free(pUncached);
+    free(pCached);
+    return bSame;
+}
+
+static void _testCorrectness(void)
+{
+    NVEdidCacheStatsRec stats;
+    NVT_EDID_INFO *pInfo;
+    NVT_STATUS status;
+    unsigned m;
+
+    nvEdidCacheFlush();
+
+    // First pass misses, second hits; both must match the uncached parse.
+    for (m = 0; m < CACHE_SIZE; m++)
+        CHECK(_sameAsUncached(edids[m]));
+    for (m = 0; m < CACHE_SIZE; m++)
+        CHECK(_sameAsUncached(edids[m]));
+
+    nvEdidCacheGetStats(&stats);
+    CHECK(stats.misses == CACHE_SIZE);
+    CHECK(stats.hits == CACHE_SIZE);
+    CHECK(stats.entries == CACHE_SIZE);
+
+    // The corpus must exercise the CTA-861 parser, not just the base block.
+    pInfo = _parse(edids[0], NV_TRUE, &status);
+    CHECK(status == NVT_STATUS_SUCCESS);
+    CHECK(pInfo->ext861.total_svd > 0);
+    CHECK(pInfo->total_timings > 8);
+    free(pInfo);
+}
+
+static void _testLru(void)
+{
+    NVEdidCacheStatsRec before, after;
+    unsigned pass, m;
+
+    // One more monitor than fits, cycled in order: LRU evicts each one just
+    // before it comes around again.
+    nvEdidCacheFlush();
+    nvEdidCacheGetStats(&before);
+    for (pass = 0; pass < 3; pass++)
+        for (m = 0; m < CACHE_SIZE + 1; m++)
+            CHECK(_sameAsUncached(edids[m]));
+    nvEdidCacheGetStats(&after);
+    CHECK(after.hits == before.hits);
+    CHECK(after.misses - before.misses == 3 * (CACHE_SIZE + 1));
+    CHECK(after.entries == CACHE_SIZE);
+
+    // Touching monitor 0 keeps it while the others churn through.
+    nvEdidCacheFlush();
+    nvEdidCacheGetStats(&before);
+    for (m = 1; m < MONITOR_COUNT; m++)
+    {
+        CHECK(_sameAsUncached(edids[0]));
+        CHECK(_sameAsUncached(edids[m]));
+    }
+    nvEdidCacheGetStats(&after);
+    CHECK(after.hits - before.hits == MONITOR_COUNT - 2);
+}
+
+typedef enum
+{
+    BENCH_UNCACHED,
+    BENCH_COLD,
+    BENCH_WARM,
+} BENCH_MODE;
+
+static double _bench(BENCH_MODE mode, unsigned monitors, unsigned parses)
+{
+    NVT_EDID_INFO *pInfo = calloc(1, sizeof(*pInfo));
+    NvU64 start, elapsed;
+    unsigned i;
+
+    nvEdidCacheFlush();
+    if (mode == BENCH_WARM)
+    {
+        for (i = 0; i < monitors; i++)
+            nvEdidCacheParseEdidInfo(edids[i], EDID_SIZE, pInfo);
+    }
+
+    start = _nowNs();
+    for (i = 0; i < parses; i++)
+    {
+        const NvU8 *pEdid = edids[i % monitors];
+
+        switch (mode)
+        {
+            case BENCH_UNCACHED:
+                NvTiming_ParseEDIDInfo((NvU8 *)pEdid, EDID_SIZE, pInfo);
+                break;
+            case BENCH_COLD:
+                nvEdidCacheFlush();
+                nvEdidCacheParseEdidInfo(pEdid, EDID_SIZE, pInfo);
+                break;
+            case BENCH_WARM:
+                nvEdidCacheParseEdidInfo(pEdid, EDID_SIZE, pInfo);
+                break;
+        }
+    }
+    elapsed = _nowNs() - start;
+
+    free(pInfo);
+    return (double)elapsed / parses;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned parses = (argc > 1) ? (unsigned)atoi(argv[1]) : 200000;
+    double uncached, cold, warm;
+    unsigned m;
+
+    for (m = 0; m < MONITOR_COUNT; m++)
+        _buildEdid(edids[m], m);
+
+    _testCorrectness();
+    _testLru();
+
+    uncached = _bench(BENCH_UNCACHED, CACHE_SIZE, parses);
+    cold     = _bench(BENCH_COLD, CACHE_SIZE, parses);
+    warm     = _bench(BENCH_WARM, CACHE_SIZE, parses);
+
+    printf("NVT_EDID_INFO is %u bytes\n", (unsigned)sizeof(NVT_EDID_INFO));
+    printf("uncached: %9.0f ns/parse\n", uncached);
+    printf("cold:     %9.0f ns/parse  (%.2fx uncached)\n", cold, cold / uncached);
+    printf("warm:     %9.0f ns/parse  (%.1fx faster than uncached)\n", warm, uncached / warm);
+
+    nvEdidCacheFlush();
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -4404,6 +4404,161 @@ finish:
     NV_EXIT_RM_RUNTIME(sp,fp);
 }
 
+//
+// This function will be called by nv_procfs_read_rpc_profile().
+//
+// Returns up to NV_RPC_PROFILE_MAX_ENTRIES entries of the GSP RPC latency
+// profile, starting at RPC function *pFunction. On return *pFunction is the
+// function to resume from, or NV_RPC_PROFILE_FUNCTION_END once all are
+// reported. NV_ERR_INVALID_STATE is returned if profiling is disabled.
+//
+NV_STATUS NV_API_CALL rm_get_rpc_profile(
+    nvidia_stack_t *sp,
+    nv_state_t *nv,
+    NvU32 *pFunction,
+    nv_rpc_profile_entry_t *pEntries,
+    NvU32 *pEntryCount
+)
+{
+    NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS *pParams;
+    RM_API            *pRmApi;
+    THREAD_STATE_NODE  threadState;
+    NV_STATUS          rmStatus;
+    NvU32              i;
+    void              *fp;
+
+    ct_assert(NV_RPC_PROFILE_MAX_ENTRIES == NV2080_CTRL_GSP_RPC_PROFILE_MAX_ENTRIES);
+    ct_assert(NV_RPC_PROFILE_FUNCTION_END == NV2080_CTRL_GSP_RPC_PROFILE_FUNCTION_END);
+
+    NV_ENTER_RM_RUNTIME(sp,fp);
+
+    *pEntryCount = 0;
+
+    pParams = portMemAllocNonPaged(sizeof(*pParams));
+    if (pParams == NULL)
+    {
+        rmStatus = NV_ERR_NO_MEMORY;
+        goto done;
+    }
+    portMemSet(pParams, 0, sizeof(*pParams));
+    pParams->firstFunction = *pFunction;
+
+    pRmApi = RmUnixRmApiPrologue(nv, &threadState, RM_LOCK_MODULES_GPU);
+    if (pRmApi == NULL)
+    {
+        rmStatus = NV_ERR_INVALID_STATE;
+        goto done;
+    }
+
+    rmStatus = pRmApi->Control(pRmApi,
+                               nv->rmapi.hClient,
+                               nv->rmapi.hSubDevice,
+                               NV2080_CTRL_CMD_GSP_GET_RPC_PROFILE,
+                               pParams,
+                               sizeof(*pParams));
+
+    RmUnixRmApiEpilogue(nv, &threadState);
+
+    if (rmStatus != NV_OK)
+        goto done;
+
+    if (!pParams->bEnabled)
+    {
+        rmStatus = NV_ERR_INVALID_STATE;
+        goto done;
+    }
+
+    for (i = 0; i < pParams->entryCount; i++)
+    {
+        pEntries[i].function      = pParams->entries[i].function;
+        pEntries[i].count         = pParams->entries[i].count;
+        pEntries[i].p50Ns         = pParams->entries[i].p50Ns;
+        pEntries[i].p99Ns         = pParams->entries[i].p99Ns;
+        pEntries[i].maxNs         = pParams->entries[i].maxNs;
+        pEntries[i].totalNs       = pParams->entries[i].totalNs;
+        pEntries[i].bytesSent     = pParams->entries[i].bytesSent;
+        pEntries[i].bytesReceived = pParams->entries[i].bytesReceived;
+    }
+
+    *pEntryCount = pParams->entryCount;
+    *pFunction   = pParams->nextFunction;
+
+done:
+    portMemFree(pParams);
+    NV_EXIT_RM_RUNTIME(sp,fp);
+
+    return rmStatus;
+}
+
+//
+// This function will be called by nv_procfs_read_control_cache().
+//
+// Returns the RM control cache counters. The cache is shared by all GPUs.
+// NV_ERR_INVALID_STATE is returned if the cache is disabled.
+//
+NV_STATUS NV_API_CALL rm_get_control_cache_stats(
+    nvidia_stack_t *sp,
+    nv_control_cache_stats_t *pStats
+)
+{
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NV_STATUS rmStatus;
+    void *fp;
+
+    NV_ENTER_RM_RUNTIME(sp,fp);
+
+    rmStatus = rmapiControlCacheGetStats(&stats);
+
+    pStats->hits       = stats.hits;
+    pStats->misses     = stats.misses;
+    pStats->evictions  = stats.evictions;
+    pStats->entries    = stats.entries;
+    pStats->maxEntries = stats.maxEntries;
+
+    NV_EXIT_RM_RUNTIME(sp,fp);
+
+    return rmStatus;
+}
+
+//
+// This function will be called by nv_procfs_read_resserv_slab().
+//
+// Fills pStats with NV_RESSERV_SLAB_SIZE_CLASS_COUNT entries, one per size
+// class of the resource server's slab allocator. NV_ERR_INVALID_STATE is
+// returned if RM is not initialized and NV_ERR_NOT_SUPPORTED if the
+// resource server does not use a slab allocator.
+//
+NV_STATUS NV_API_CALL rm_get_resserv_slab_stats(
+    nvidia_stack_t *sp,
+    nv_resserv_slab_stats_t *pStats
+)
+{
+    PORT_MEM_SLAB_STATS stats[PORT_MEM_SLAB_SIZE_CLASS_COUNT];
+    NV_STATUS rmStatus;
+    NvU32 i;
+    void *fp;
+
+    ct_assert(NV_RESSERV_SLAB_SIZE_CLASS_COUNT == PORT_MEM_SLAB_SIZE_CLASS_COUNT);
+
+    NV_ENTER_RM_RUNTIME(sp,fp);
+
+    rmStatus = rmapiGetAllocatorStats(stats);
+
+    for (i = 0; i < NV_RESSERV_SLAB_SIZE_CLASS_COUNT; i++)
+    {
+        pStats[i].objectSize     = stats[i].objectSize;
+        pStats[i].allocs         = stats[i].allocs;
+        pStats[i].frees          = stats[i].frees;
+        pStats[i].cacheMisses    = stats[i].cacheMisses;
+        pStats[i].cacheOverflows = stats[i].cacheOverflows;
+        pStats[i].depotExchanges = stats[i].depotExchanges;
+    }
+
+    NV_EXIT_RM_RUNTIME(sp,fp);
+
+    return rmStatus;
+}
+
 //
 // disable GPU SW state persistence
 //
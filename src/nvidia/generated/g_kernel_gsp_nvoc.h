@@ -1021,6 +1021,14 @@ static inline NV_STATUS kgspAllocateBooterUnloadUcodeImage(struct OBJGPU *pGpu,
 
 NV_STATUS rpcRmApiControl_GSP(RM_API *pRmApi, NvHandle hClient, NvHandle hObject,
                               NvU32 cmd, void *pParamStructPtr, NvU32 paramsSize);
+NV_STATUS rpcRmApiControlAsync_GSP(RM_API *pRmApi, NvHandle hClient, NvHandle hObject,
+                                   NvU32 cmd, void *pParamStructPtr, NvU32 paramsSize,
+                                   NvU32 *pSequence);
+NV_STATUS rpcRmApiControlAsyncWait_GSP(RM_API *pRmApi, NvU32 sequence,
+                                       void *pParamStructPtr, NvU32 paramsSize);
+struct RPC_CONTROL_BATCH_ENTRY;
+NV_STATUS rpcRmApiControlBatch_GSP(RM_API *pRmApi, struct RPC_CONTROL_BATCH_ENTRY *pEntries,
+                                   NvU32 numEntries);
 NV_STATUS rpcRmApiAlloc_GSP(RM_API *pRmApi, NvHandle hClient, NvHandle hParent,
                             NvHandle hObject, NvU32 hClass, void *pAllocParams);
 NV_STATUS rpcRmApiDupObject_GSP(RM_API *pRmApi, NvHandle hClient, NvHandle hParent, NvHandle *phObject,
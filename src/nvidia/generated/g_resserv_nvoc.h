@@ -159,7 +159,6 @@ typedef struct RsShared RsShared;
 MAKE_LIST(RsResourceRefList, RsResourceRef*);
 MAKE_LIST(RsResourceList, RsResource*);
 MAKE_LIST(RsHandleList, NvHandle);
-MAKE_LIST(RsClientList, CLIENT_ENTRY*);
 MAKE_LIST(RsShareList, RS_SHARE_POLICY);
 MAKE_MULTIMAP(RsIndex, RsResourceRef*);
 
@@ -196,6 +195,10 @@ typedef void *PUID_TOKEN;
 #define RS_CLIENT_HANDLE_BUCKET_COUNT   0x400  // 1024
 #define RS_CLIENT_HANDLE_BUCKET_MASK    0x3FF
 
+/// Buckets are grouped into shards by the low bits of the client handle.
+#define RS_CLIENT_HANDLE_SHARD_COUNT    0x10   // 16
+#define RS_CLIENT_HANDLE_SHARD_MASK     0xF
+
 
 /// The default maximum number of domains a resource server can allocate
 #define RS_MAX_DOMAINS_DEFAULT          4096
@@ -56,11 +56,25 @@ struct CLIENT_ENTRY
     struct RsClient       *pClient;
     NvHandle        hClient;
     NvU64           lockOwnerTid; ///< Thread id of the lock owner
+    ListNode        node;         ///< Link in the client's bucket
 
 #if LOCK_VAL_ENABLED
     LOCK_VAL_LOCK   lockVal;
 #endif
 };
+MAKE_INTRUSIVE_LIST(RsClientList, CLIENT_ENTRY, node);
+
+/**
+ * A group of client buckets that share a lock. The shard of a client is
+ * selected by the low bits of its handle, so every bucket belongs to
+ * exactly one shard.
+ */
+typedef struct RS_CLIENT_SHARD
+{
+    PORT_SPINLOCK  *pLock;          ///< Protects this shard's buckets and bitmaps
+    NvU64          *pHandleBitmap;  ///< One bit per handle index owned by this shard; set if in use
+    NvU64          *pFullWordMask;  ///< One bit per word of pHandleBitmap; set if that word is full
+} RS_CLIENT_SHARD;
 
 /**
  * Base-class for objects that are shared among multiple
@@ -258,13 +272,12 @@ struct RsServer
     RS_PRIV_LEVEL             privilegeLevel;
 
     RsClientList             *pClientSortedList; ///< Bucket if linked List of clients (and their locks) owned by this server
-    NvU32                     clientCurrentHandleIndex;
+    RS_CLIENT_SHARD          *pClientShards; ///< Locks and free-handle bitmaps for groups of buckets
+    NvU32                     clientCurrentHandleIndex; ///< Cursor for the next client handle allocation
 
     NvBool                    bConstructed; ///< Determines whether the server is ready to be used
     PORT_MEM_ALLOCATOR       *pAllocator; ///< Allocator to use for all objects allocated by the server
 
-    PORT_RWLOCK              *pClientListLock; ///< Lock that needs to be taken when accessing the client list
-
     PORT_SPINLOCK            *pShareMapLock; ///< Lock that needs to be taken when accessing the shared resource map
     RsSharedMap               shareMap; ///< Map of shared resources
 
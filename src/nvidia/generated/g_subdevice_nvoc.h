@@ -452,6 +452,8 @@ struct Subdevice {
     NV_STATUS (*__subdeviceCtrlCmdFlaGetRange__)(struct Subdevice *, NV2080_CTRL_FLA_GET_RANGE_PARAMS *);
     NV_STATUS (*__subdeviceCtrlCmdFlaGetFabricMemStats__)(struct Subdevice *, NV2080_CTRL_FLA_GET_FABRIC_MEM_STATS_PARAMS *);
     NV_STATUS (*__subdeviceCtrlCmdGspGetFeatures__)(struct Subdevice *, NV2080_CTRL_GSP_GET_FEATURES_PARAMS *);
+    NV_STATUS (*__subdeviceCtrlCmdGspGetRpcProfile__)(struct Subdevice *, NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS *);
+    NV_STATUS (*__subdeviceCtrlCmdGspSetRpcProfile__)(struct Subdevice *, NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS *);
     NV_STATUS (*__subdeviceCtrlCmdGpuGetActivePartitionIds__)(struct Subdevice *, NV2080_CTRL_GPU_GET_ACTIVE_PARTITION_IDS_PARAMS *);
     NV_STATUS (*__subdeviceCtrlCmdGpuGetPartitionCapacity__)(struct Subdevice *, NV2080_CTRL_GPU_GET_PARTITION_CAPACITY_PARAMS *);
     NV_STATUS (*__subdeviceCtrlCmdGpuDescribePartitions__)(struct Subdevice *, NV2080_CTRL_GPU_DESCRIBE_PARTITIONS_PARAMS *);
@@ -933,6 +935,8 @@ NV_STATUS __nvoc_objCreate_Subdevice(Subdevice**, Dynamic*, NvU32, struct CALL_C
 #define subdeviceCtrlCmdFlaGetRange(pSubdevice, pParams) subdeviceCtrlCmdFlaGetRange_DISPATCH(pSubdevice, pParams)
 #define subdeviceCtrlCmdFlaGetFabricMemStats(pSubdevice, pParams) subdeviceCtrlCmdFlaGetFabricMemStats_DISPATCH(pSubdevice, pParams)
 #define subdeviceCtrlCmdGspGetFeatures(pSubdevice, pGspFeaturesParams) subdeviceCtrlCmdGspGetFeatures_DISPATCH(pSubdevice, pGspFeaturesParams)
+#define subdeviceCtrlCmdGspGetRpcProfile(pSubdevice, pParams) subdeviceCtrlCmdGspGetRpcProfile_DISPATCH(pSubdevice, pParams)
+#define subdeviceCtrlCmdGspSetRpcProfile(pSubdevice, pParams) subdeviceCtrlCmdGspSetRpcProfile_DISPATCH(pSubdevice, pParams)
 #define subdeviceCtrlCmdGpuGetActivePartitionIds(pSubdevice, pParams) subdeviceCtrlCmdGpuGetActivePartitionIds_DISPATCH(pSubdevice, pParams)
 #define subdeviceCtrlCmdGpuGetPartitionCapacity(pSubdevice, pParams) subdeviceCtrlCmdGpuGetPartitionCapacity_DISPATCH(pSubdevice, pParams)
 #define subdeviceCtrlCmdGpuDescribePartitions(pSubdevice, pParams) subdeviceCtrlCmdGpuDescribePartitions_DISPATCH(pSubdevice, pParams)
@@ -2993,6 +2997,18 @@ static inline NV_STATUS subdeviceCtrlCmdGspGetFeatures_DISPATCH(struct Subdevice
     return pSubdevice->__subdeviceCtrlCmdGspGetFeatures__(pSubdevice, pGspFeaturesParams);
 }
 
+NV_STATUS subdeviceCtrlCmdGspGetRpcProfile_IMPL(struct Subdevice *pSubdevice, NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS *pParams);
+
+static inline NV_STATUS subdeviceCtrlCmdGspGetRpcProfile_DISPATCH(struct Subdevice *pSubdevice, NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS *pParams) {
+    return pSubdevice->__subdeviceCtrlCmdGspGetRpcProfile__(pSubdevice, pParams);
+}
+
+NV_STATUS subdeviceCtrlCmdGspSetRpcProfile_IMPL(struct Subdevice *pSubdevice, NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS *pParams);
+
+static inline NV_STATUS subdeviceCtrlCmdGspSetRpcProfile_DISPATCH(struct Subdevice *pSubdevice, NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS *pParams) {
+    return pSubdevice->__subdeviceCtrlCmdGspSetRpcProfile__(pSubdevice, pParams);
+}
+
 NV_STATUS subdeviceCtrlCmdGpuGetActivePartitionIds_IMPL(struct Subdevice *pSubdevice, NV2080_CTRL_GPU_GET_ACTIVE_PARTITION_IDS_PARAMS *pParams);
 
 static inline NV_STATUS subdeviceCtrlCmdGpuGetActivePartitionIds_DISPATCH(struct Subdevice *pSubdevice, NV2080_CTRL_GPU_GET_ACTIVE_PARTITION_IDS_PARAMS *pParams) {
@@ -57,6 +57,14 @@ NV_STATUS rmapiInitialize(void);
  */
 void rmapiShutdown(void);
 
+/**
+ * Get the per size class counters of the resource server's slab allocator
+ *
+ * May be called before rmapiInitialize and after rmapiShutdown, in which case
+ * NV_ERR_INVALID_STATE is returned.
+ */
+NV_STATUS rmapiGetAllocatorStats(PORT_MEM_SLAB_STATS pStats[PORT_MEM_SLAB_SIZE_CLASS_COUNT]);
+
 // Flags for rmapiLockAcquire
 #define RMAPI_LOCK_FLAGS_NONE                             (0x00000000)  // default no flags
 #define RMAPI_LOCK_FLAGS_COND_ACQUIRE                     NVBIT(0)        // conditional acquire; if lock is
@@ -259,12 +267,25 @@ NV_STATUS RmConfigSetEx   (NvHandle, NvHandle, NvU32, NvP64, NvU32, NvBool);
 /**
  * Control cache API.
  * Every function except rmapiControlCacheInit and rmapiControlCacheFree is thread safe.
+ * rmapiControlCacheGet copies a cached result into params and returns
+ * NV_ERR_OBJECT_NOT_FOUND on a miss.
  */
+typedef struct
+{
+    NvU64 hits;
+    NvU64 misses;
+    NvU64 evictions;
+    NvU64 entries;
+    NvU64 maxEntries;
+} RMAPI_CONTROL_CACHE_STATS;
+
 void rmapiControlCacheInit(void);
 NvBool rmapiControlIsCacheable(NvU32 flags, NvBool isGSPClient);
-void* rmapiControlCacheGet(NvHandle hClient, NvHandle hObject, NvU32 cmd);
+NV_STATUS rmapiControlCacheGet(NvHandle hClient, NvHandle hObject, NvU32 cmd,
+    void* params, NvU32 paramsSize);
 NV_STATUS rmapiControlCacheSet(NvHandle hClient, NvHandle hObject, NvU32 cmd,
     void* params, NvU32 paramsSize);
+NV_STATUS rmapiControlCacheGetStats(RMAPI_CONTROL_CACHE_STATS *pStats);
 void rmapiControlCacheFree(void);
 void rmapiControlCacheFreeClient(NvHandle hClient);
 void rmapiControlCacheFreeObject(NvHandle hClient, NvHandle hObject);
@@ -60,6 +60,15 @@ extern "C" {
  *  * \b None. The container is not thread-safe.
  *  * Locking must be handled by the user if required.
  *
+ * - Backends:
+ *  * By default values are kept in a red-black tree threaded through
+ *    their MapNodes, which never allocates on insertion.
+ *  * Maps initialized with @ref mapInitBTree or @ref mapInitIntrusiveBTree
+ *    index their keys in a B+-tree instead. Lookups touch a few
+ *    cache-line-sized nodes rather than one node per level of a binary
+ *    tree, and iteration follows a sorted list of values. Index nodes come
+ *    from the given allocator, so insertion can fail for intrusive maps too.
+ *
  */
 
 #define MAKE_MAP(mapTypeName, dataType)                                      \
@@ -123,13 +132,18 @@ typedef struct IntrusiveMap IntrusiveMap;
  */
 typedef struct MapIterBase MapIterBase;
 
+/**
+ * @brief Interior or leaf node of the B+-tree backend.
+ */
+typedef struct MapBTreeNode MapBTreeNode;
+
 struct MapNode
 {
     /// @privatesection
     NvU64       key;
     MapNode    *pParent;
-    MapNode    *pLeft;
-    MapNode    *pRight;
+    MapNode    *pLeft;      ///< B+-tree backend: previous value in key order
+    MapNode    *pRight;     ///< B+-tree backend: next value in key order
     NvBool      bIsRed;
 #if PORT_IS_CHECKED_BUILD
     MapBase    *pMap;
@@ -156,6 +170,8 @@ struct MapBase
     MapNode    *pRoot;
     NvS32       nodeOffset;
     NvU32       count;
+    MapBTreeNode       *pBTreeRoot;      ///< Root of the B+-tree key index
+    PORT_MEM_ALLOCATOR *pBTreeAllocator; ///< Set if the map uses the B+-tree backend
 #if PORT_IS_CHECKED_BUILD
     NvU32       versionNumber;
 #endif
@@ -179,6 +195,13 @@ struct IntrusiveMap
 #define mapInitIntrusive(pMap)                                               \
     mapInitIntrusive_IMPL(&((pMap)->real), sizeof(*(pMap)->nodeOffset))
 
+#define mapInitBTree(pMap, pAllocator)                                       \
+    mapInitBTree_IMPL(&((pMap)->real), pAllocator, sizeof(*(pMap)->valueSize))
+
+#define mapInitIntrusiveBTree(pMap, pAllocator)                              \
+    mapInitIntrusiveBTree_IMPL(&((pMap)->real), pAllocator,                  \
+        sizeof(*(pMap)->nodeOffset))
+
 #define mapDestroy(pMap)                                                     \
     CONT_DISPATCH_ON_KIND(pMap,                                              \
         mapDestroy_IMPL((NonIntrusiveMap*)&((pMap)->real)),                  \
@@ -254,6 +277,10 @@ struct IntrusiveMap
 void mapInit_IMPL(NonIntrusiveMap *pMap,
                   PORT_MEM_ALLOCATOR *pAllocator, NvU32 valueSize);
 void mapInitIntrusive_IMPL(IntrusiveMap *pMap, NvS32 nodeOffset);
+void mapInitBTree_IMPL(NonIntrusiveMap *pMap,
+                       PORT_MEM_ALLOCATOR *pAllocator, NvU32 valueSize);
+void mapInitIntrusiveBTree_IMPL(IntrusiveMap *pMap,
+                                PORT_MEM_ALLOCATOR *pAllocator, NvS32 nodeOffset);
 void mapDestroy_IMPL(NonIntrusiveMap *pMap);
 void mapDestroyIntrusive_IMPL(MapBase *pMap);
 
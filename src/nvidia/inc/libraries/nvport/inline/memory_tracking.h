@@ -38,6 +38,10 @@ void *_portMemAllocPagedUntracked(NvLength lengthBytes);
 void *_portMemAllocNonPagedUntracked(NvLength lengthBytes);
 /** @brief Untracked memory free, platform specific */
 void _portMemFreeUntracked(void *pMemory);
+/** @brief Number of CPUs that per-CPU caches are kept for, platform specific */
+NvU32 _portMemGetCpuCount(void);
+/** @brief Index of the CPU the caller is running on, platform specific */
+NvU32 _portMemGetCurrentCpu(void);
 /** @brief Wrapper around pAlloc->_portAlloc() that tracks the allocation */
 void *_portMemAllocatorAlloc(PORT_MEM_ALLOCATOR *pAlloc, NvLength length);
 /** @brief Wrapper around pAlloc->_portFree() that tracks the allocation */
@@ -810,6 +810,64 @@ PORT_MEM_ALLOCATOR *portMemExAllocatorCreateLockedOnExistingBlock(void *pPreallo
 #define portMemExAllocatorCreateLockedOnExistingBlock_SUPPORTED \
                             (PORT_IS_MODULE_SUPPORTED(sync))
 
+/// @brief Number of size classes cached by a slab allocator.
+#define PORT_MEM_SLAB_SIZE_CLASS_COUNT 6
+
+/**
+ * @brief Per size class counters of a slab allocator.
+ */
+typedef struct PORT_MEM_SLAB_STATS
+{
+    /** @brief Largest request served by this size class */
+    NvLength objectSize;
+    /** @brief Number of allocations made from this size class */
+    NvU64 allocs;
+    /** @brief Number of frees made to this size class */
+    NvU64 frees;
+    /** @brief Allocations that had to go to the parent allocator */
+    NvU64 cacheMisses;
+    /** @brief Frees that had to go to the parent allocator */
+    NvU64 cacheOverflows;
+    /** @brief Magazines exchanged between a CPU and the depot */
+    NvU64 depotExchanges;
+} PORT_MEM_SLAB_STATS;
+
+/**
+ * @brief Creates a size-class slab allocator on top of another allocator.
+ *
+ * Small requests are rounded up to one of @ref PORT_MEM_SLAB_SIZE_CLASS_COUNT
+ * size classes. Freed objects are kept in per-CPU magazines and a shared
+ * depot of magazines, and are handed out again without calling into
+ * @p pParent. Larger requests are passed straight through to @p pParent.
+ *
+ * Cached objects are only returned to @p pParent when the depot is full or
+ * when the allocator is released. @p pParent must outlive the slab allocator.
+ *
+ * Memory returned by this allocator is 8-byte aligned.
+ *
+ * @return NULL if creation failed.
+ *
+ * @pre Windows: IRQL <= DISPATCH_LEVEL
+ * @pre Unix:    Non-interrupt context
+ * @note Will not put the thread to sleep.
+ */
+PORT_MEM_ALLOCATOR *portMemExAllocatorCreateSlab(PORT_MEM_ALLOCATOR *pParent);
+#define portMemExAllocatorCreateSlab_SUPPORTED \
+                            (PORT_IS_KERNEL_BUILD && PORT_IS_MODULE_SUPPORTED(sync))
+
+/**
+ * @brief Returns the counters of one size class of a slab allocator.
+ *
+ * @param [in]  pAllocator  Allocator created by @ref portMemExAllocatorCreateSlab
+ * @param [in]  sizeClass   Size class index, below @ref PORT_MEM_SLAB_SIZE_CLASS_COUNT
+ * @param [out] pStats      Counters summed over all CPUs
+ *
+ * @return NV_ERR_INVALID_ARGUMENT if pAllocator is not a slab allocator or
+ *         sizeClass is out of range.
+ */
+NV_STATUS portMemExSlabGetStats(PORT_MEM_ALLOCATOR *pAllocator, NvU32 sizeClass, PORT_MEM_SLAB_STATS *pStats);
+#define portMemExSlabGetStats_SUPPORTED portMemExAllocatorCreateSlab_SUPPORTED
+
 
 /**
  * @brief Maps the given physical address range to nonpaged system space.
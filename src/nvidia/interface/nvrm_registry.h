@@ -702,6 +702,22 @@
 #define NV_REG_STR_RM_CACHEABLE_CONTROLS_GSP_ONLY    1
 #define NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE      2
 
+// Type DWORD
+// Upper bound on the number of cached control results. Once reached, older
+// entries that have not been looked up recently are evicted.
+// 0: use the default
+#define NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_ENTRIES         "RmCacheableControlsMaxEntries"
+#define NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_ENTRIES_DEFAULT (4096)
+
+// Type DWORD
+// Profile GSP RPC latencies from boot. The profile is read back with
+// NV2080_CTRL_CMD_GSP_GET_RPC_PROFILE or the per-GPU rpc_profile procfs file.
+// 0 (default): disabled
+// 1: enabled
+#define NV_REG_STR_RM_RPC_PROFILE                    "RmRpcProfile"
+#define NV_REG_STR_RM_RPC_PROFILE_DISABLE            0
+#define NV_REG_STR_RM_RPC_PROFILE_ENABLE             1
+
 // Type DWORD
 // This regkey forces for Maxwell+ that on FB Unload we wait for FB pull before issuing the
 // L2 clean. WAR for bug 1032432
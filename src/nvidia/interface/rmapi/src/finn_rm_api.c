@@ -124,75 +124,6 @@
 NV_STATUS FinnRmApiSerializeInternal(NvU64 interface, NvU64 message, const char *src, char **dst, NvLength dst_size, NvBool seri_up);
 NV_STATUS FinnRmApiDeserializeInternal(char * const *src, NvLength src_size, char *dst, NvLength dst_size, NvBool deser_up);
 
-static NV_STATUS FinnNv01RootNvdSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01RootNvdDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_ROOT_NVD *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01RootNvdGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01RootNvdGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv01Device0DmaSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01Device0DmaDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_DMA *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01Device0DmaGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01Device0DmaGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv01Device0FbSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01Device0FbDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_FB *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01Device0FbGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01Device0FbGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv01Device0FifoSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01Device0FifoDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_FIFO *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01Device0FifoGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01Device0FifoGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv01Device0GpuSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01Device0GpuDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_GPU *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01Device0GpuGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01Device0GpuGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv01Device0GrSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01Device0GrDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_GR *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01Device0GrGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01Device0GrGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv01Device0HostSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01Device0HostDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_HOST *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01Device0HostGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01Device0HostGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv01Device0MsencSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv01Device0MsencDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_MSENC *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv01Device0MsencGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv01Device0MsencGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv20Subdevice0CeSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv20Subdevice0CeDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_CE *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv20Subdevice0CeGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv20Subdevice0CeGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv20Subdevice0GpuSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv20Subdevice0GpuDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_GPU *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv20Subdevice0GpuGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv20Subdevice0GpuGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv20Subdevice0I2cSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv20Subdevice0I2cDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_I2C *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv20Subdevice0I2cGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv20Subdevice0I2cGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv20Subdevice0NvdSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv20Subdevice0NvdDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_NVD *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv20Subdevice0NvdGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv20Subdevice0NvdGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv20Subdevice0PerfSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv20Subdevice0PerfDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_PERF *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv20Subdevice0PerfGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv20Subdevice0PerfGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv20Subdevice0RcSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv20Subdevice0RcDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_RC *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv20Subdevice0RcGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv20Subdevice0RcGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnNv40I2cI2cSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnNv40I2cI2cDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV40_I2C_I2C *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnNv40I2cI2cGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnNv40I2cI2cGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnGt200DebuggerDebugSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnGt200DebuggerDebugDeserialize(NvU8 **src, const NvU8 *src_max, FINN_GT200_DEBUGGER_DEBUG *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnGt200DebuggerDebugGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnGt200DebuggerDebugGetUnserializedSize(NvU64 message);
-static NV_STATUS FinnMaxwellChannelGpfifoAGpfifoSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
-static NV_STATUS FinnMaxwellChannelGpfifoAGpfifoDeserialize(NvU8 **src, const NvU8 *src_max, FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO *dst, NvLength dst_size, NvBool deser_up);
-static NvU64 FinnMaxwellChannelGpfifoAGpfifoGetSerializedSize(NvU64 message, const NvP64 src);
-static NvU64 FinnMaxwellChannelGpfifoAGpfifoGetUnserializedSize(NvU64 message);
-
 static NV_STATUS Nv0000CtrlNvdGetDumpParamsSerialize(const NV0000_CTRL_NVD_GET_DUMP_PARAMS *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
 static NV_STATUS Nv0000CtrlNvdGetDumpParamsDeserialize(NvU8 **src, const NvU8 *src_max, NV0000_CTRL_NVD_GET_DUMP_PARAMS *dst, NvLength dst_size, NvBool deser_up);
 static NvU64 Nv0000CtrlNvdGetDumpParamsGetSerializedSize(const NV0000_CTRL_NVD_GET_DUMP_PARAMS *src);
@@ -307,6 +238,132 @@ static NV_STATUS Nvb06fCtrlCmdMigrateEngineCtxDataFinnParamsSerialize(const NVB0
 static NV_STATUS Nvb06fCtrlCmdMigrateEngineCtxDataFinnParamsDeserialize(NvU8 **src, const NvU8 *src_max, NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS *dst, NvLength dst_size, NvBool deser_up);
 static NvU64 Nvb06fCtrlCmdMigrateEngineCtxDataFinnParamsGetSerializedSize(const NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS *src);
 
+// Generate type-erased entry points for a message's serialization routines.
+#define FINN_MESSAGE_THUNKS(type, prefix)                                      \
+    static NV_STATUS prefix##SerializeThunk(const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up) \
+    {                                                                          \
+        return prefix##Serialize((const type *) src, dst, dst_max, seri_up);   \
+    }                                                                          \
+    static NV_STATUS prefix##DeserializeThunk(NvU8 **src, const NvU8 *src_max, char *dst, NvLength dst_size, NvBool deser_up) \
+    {                                                                          \
+        return prefix##Deserialize(src, src_max, (type *) dst, dst_size, deser_up); \
+    }                                                                          \
+    static NvU64 prefix##GetSerializedSizeThunk(const char *src)               \
+    {                                                                          \
+        return prefix##GetSerializedSize((const type *) src);                  \
+    }
+
+// Build a dispatch descriptor for a message.
+#define FINN_MESSAGE_DESCRIPTOR_ENTRY(iface, type, prefix)                     \
+    {                                                                          \
+        FINN_INTERFACE_ID(iface), FINN_MESSAGE_ID(type), sizeof(type),         \
+        prefix##SerializeThunk, prefix##DeserializeThunk,                      \
+        prefix##GetSerializedSizeThunk                                         \
+    }
+
+/*
+ * Per-message dispatch descriptor. Serialization entry points resolve the
+ * (interface, message) pair to one of these with a single binary search.
+ */
+typedef struct FINN_MESSAGE_DESCRIPTOR
+{
+    NvU32 interface;
+    NvU32 message;
+    NvU64 unserializedSize;
+    NV_STATUS (*pfnSerialize)(const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up);
+    NV_STATUS (*pfnDeserialize)(NvU8 **src, const NvU8 *src_max, char *dst, NvLength dst_size, NvBool deser_up);
+    NvU64 (*pfnGetSerializedSize)(const char *src);
+} FINN_MESSAGE_DESCRIPTOR;
+
+FINN_MESSAGE_THUNKS(NV0000_CTRL_NVD_GET_DUMP_PARAMS, Nv0000CtrlNvdGetDumpParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS, Nv0080CtrlGpuGetClasslistParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_GR_GET_CAPS_PARAMS, Nv0080CtrlGrGetCapsParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_FB_GET_CAPS_PARAMS, Nv0080CtrlFbGetCapsParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_HOST_GET_CAPS_PARAMS, Nv0080CtrlHostGetCapsParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_FIFO_GET_CAPS_PARAMS, Nv0080CtrlFifoGetCapsParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS, Nv0080CtrlFifoStartSelectedChannelsParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS, Nv0080CtrlFifoGetChannellistParams)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS, Nv0080CtrlDmaUpdatePde2Params)
+FINN_MESSAGE_THUNKS(NV0080_CTRL_MSENC_GET_CAPS_PARAMS, Nv0080CtrlMsencGetCapsParams)
+FINN_MESSAGE_THUNKS(NV2080_CTRL_GPU_GET_ENGINES_PARAMS, Nv2080CtrlGpuGetEnginesParams)
+FINN_MESSAGE_THUNKS(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS, Nv2080CtrlGpuGetEngineClasslistParams)
+FINN_MESSAGE_THUNKS(NV2080_CTRL_I2C_ACCESS_PARAMS, Nv2080CtrlI2cAccessParams)
+
+// Shared sample layout; the header carries the interface and message explicitly.
+static NV_STATUS Nv2080CtrlGpumonSamplesSerializeThunk(const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
+{
+    return Nv2080CtrlGpumonSamplesSerialize((const NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM *) src, dst, dst_max, seri_up, FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_PERF), FINN_MESSAGE_ID(NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM));
+}
+static NV_STATUS Nv2080CtrlGpumonSamplesDeserializeThunk(NvU8 **src, const NvU8 *src_max, char *dst, NvLength dst_size, NvBool deser_up)
+{
+    return Nv2080CtrlGpumonSamplesDeserialize(src, src_max, (NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM *) dst, dst_size, deser_up);
+}
+static NvU64 Nv2080CtrlGpumonSamplesGetSerializedSizeThunk(const char *src)
+{
+    return Nv2080CtrlGpumonSamplesGetSerializedSize((const NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM *) src);
+}
+
+FINN_MESSAGE_THUNKS(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS, Nv2080CtrlRcReadVirtualMemParams)
+FINN_MESSAGE_THUNKS(NV2080_CTRL_NVD_GET_DUMP_PARAMS, Nv2080CtrlNvdGetDumpParams)
+FINN_MESSAGE_THUNKS(NV2080_CTRL_CE_GET_CAPS_PARAMS, Nv2080CtrlCeGetCapsParams)
+FINN_MESSAGE_THUNKS(NV402C_CTRL_I2C_INDEXED_PARAMS, Nv402cCtrlI2cIndexedParams)
+FINN_MESSAGE_THUNKS(NV402C_CTRL_I2C_TRANSACTION_PARAMS, Nv402cCtrlI2cTransactionParams)
+FINN_MESSAGE_THUNKS(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS, Nv83deCtrlDebugReadMemoryParams)
+FINN_MESSAGE_THUNKS(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS, Nv83deCtrlDebugWriteMemoryParams)
+FINN_MESSAGE_THUNKS(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS, Nvb06fCtrlGetEngineCtxDataParams)
+FINN_MESSAGE_THUNKS(NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS, Nvb06fCtrlCmdMigrateEngineCtxDataFinnParams)
+
+// Sorted by interface ID, then message ID.
+static const FINN_MESSAGE_DESCRIPTOR finnMessageDescriptors[] =
+{
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_ROOT_NVD, NV0000_CTRL_NVD_GET_DUMP_PARAMS, Nv0000CtrlNvdGetDumpParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_GPU, NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS, Nv0080CtrlGpuGetClasslistParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_GR, NV0080_CTRL_GR_GET_CAPS_PARAMS, Nv0080CtrlGrGetCapsParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_FB, NV0080_CTRL_FB_GET_CAPS_PARAMS, Nv0080CtrlFbGetCapsParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_HOST, NV0080_CTRL_HOST_GET_CAPS_PARAMS, Nv0080CtrlHostGetCapsParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_FIFO, NV0080_CTRL_FIFO_GET_CAPS_PARAMS, Nv0080CtrlFifoGetCapsParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_FIFO, NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS, Nv0080CtrlFifoStartSelectedChannelsParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_FIFO, NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS, Nv0080CtrlFifoGetChannellistParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_DMA, NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS, Nv0080CtrlDmaUpdatePde2Params),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV01_DEVICE_0_MSENC, NV0080_CTRL_MSENC_GET_CAPS_PARAMS, Nv0080CtrlMsencGetCapsParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV20_SUBDEVICE_0_GPU, NV2080_CTRL_GPU_GET_ENGINES_PARAMS, Nv2080CtrlGpuGetEnginesParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV20_SUBDEVICE_0_GPU, NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS, Nv2080CtrlGpuGetEngineClasslistParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV20_SUBDEVICE_0_I2C, NV2080_CTRL_I2C_ACCESS_PARAMS, Nv2080CtrlI2cAccessParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV20_SUBDEVICE_0_PERF, NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM, Nv2080CtrlGpumonSamples),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV20_SUBDEVICE_0_RC, NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS, Nv2080CtrlRcReadVirtualMemParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV20_SUBDEVICE_0_NVD, NV2080_CTRL_NVD_GET_DUMP_PARAMS, Nv2080CtrlNvdGetDumpParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV20_SUBDEVICE_0_CE, NV2080_CTRL_CE_GET_CAPS_PARAMS, Nv2080CtrlCeGetCapsParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV40_I2C_I2C, NV402C_CTRL_I2C_INDEXED_PARAMS, Nv402cCtrlI2cIndexedParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_NV40_I2C_I2C, NV402C_CTRL_I2C_TRANSACTION_PARAMS, Nv402cCtrlI2cTransactionParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_GT200_DEBUGGER_DEBUG, NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS, Nv83deCtrlDebugReadMemoryParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_GT200_DEBUGGER_DEBUG, NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS, Nv83deCtrlDebugWriteMemoryParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO, NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS, Nvb06fCtrlGetEngineCtxDataParams),
+    FINN_MESSAGE_DESCRIPTOR_ENTRY(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO, NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS, Nvb06fCtrlCmdMigrateEngineCtxDataFinnParams),
+};
+
+static const FINN_MESSAGE_DESCRIPTOR *FinnRmApiLookupMessage(NvU64 interface, NvU64 message)
+{
+    NvLength lo = 0;
+    NvLength hi = sizeof(finnMessageDescriptors) / sizeof(finnMessageDescriptors[0]);
+
+    while (lo < hi)
+    {
+        NvLength mid = lo + (hi - lo) / 2;
+        const FINN_MESSAGE_DESCRIPTOR *desc = &finnMessageDescriptors[mid];
+
+        if (interface == desc->interface && message == desc->message)
+            return desc;
+
+        if (interface < desc->interface ||
+            (interface == desc->interface && message < desc->message))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    return NULL;
+}
+
 NV_STATUS FinnRmApiSerializeUp(NvU64 interface, NvU64 message, const void *src, NvU8 **dst, NvLength dst_size)
 {
     return FinnRmApiSerializeInternal(interface, message, (const char *) src, (char **) dst, dst_size / sizeof(NvU8), NV_TRUE);
@@ -330,7 +387,7 @@ NV_STATUS FinnRmApiDeserializeUp(NvU8 * const *src, NvLength src_size, void *dst
 
 NV_STATUS FinnRmApiSerializeInternal(NvU64 interface, NvU64 message, const char *src, char **dst, NvLength dst_size, NvBool seri_up)
 {
-    const char *dst_max = *dst + dst_size;
+    const FINN_MESSAGE_DESCRIPTOR *desc;
 
     // Input validation
     if (!src || !dst || !(*dst) || !dst_size)
@@ -339,55 +396,21 @@ NV_STATUS FinnRmApiSerializeInternal(NvU64 interface, NvU64 message, const char
         return NV_ERR_INVALID_ARGUMENT;
     }
 
-    // Forward to interface-specific routine
-    switch (interface)
-    {
-        case FINN_INTERFACE_ID(FINN_NV01_ROOT_NVD):
-            return FinnNv01RootNvdSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_DMA):
-            return FinnNv01Device0DmaSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FB):
-            return FinnNv01Device0FbSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FIFO):
-            return FinnNv01Device0FifoSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GPU):
-            return FinnNv01Device0GpuSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GR):
-            return FinnNv01Device0GrSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_HOST):
-            return FinnNv01Device0HostSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_MSENC):
-            return FinnNv01Device0MsencSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_CE):
-            return FinnNv20Subdevice0CeSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_GPU):
-            return FinnNv20Subdevice0GpuSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_I2C):
-            return FinnNv20Subdevice0I2cSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_NVD):
-            return FinnNv20Subdevice0NvdSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_PERF):
-            return FinnNv20Subdevice0PerfSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_RC):
-            return FinnNv20Subdevice0RcSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_NV40_I2C_I2C):
-            return FinnNv40I2cI2cSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_GT200_DEBUGGER_DEBUG):
-            return FinnGt200DebuggerDebugSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        case FINN_INTERFACE_ID(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO):
-            return FinnMaxwellChannelGpfifoAGpfifoSerialize(message, src, (NvU8 **) dst, (const NvU8 *) dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
+    // Forward to message-specific routine
+    desc = FinnRmApiLookupMessage(interface, message);
+    if (!desc)
+    {
+        FINN_ERROR(NV_ERR_NOT_SUPPORTED);
+        return NV_ERR_NOT_SUPPORTED;
     }
+
+    return desc->pfnSerialize(src, (NvU8 **) dst, (const NvU8 *) (*dst + dst_size), seri_up);
 }
 
 
 NV_STATUS FinnRmApiDeserializeInternal(char * const *src, NvLength src_size, char *dst, NvLength dst_size, NvBool deser_up)
 {
-    const char *src_max = *src + src_size;
+    const FINN_MESSAGE_DESCRIPTOR *desc;
 
     // Input validation
     if (!src || !(*src) || !src_size || !dst || !dst_size)
@@ -408,1107 +431,38 @@ NV_STATUS FinnRmApiDeserializeInternal(char * const *src, NvLength src_size, cha
         return NV_ERR_BUFFER_TOO_SMALL;
     }
 
-    // Forward to interface-specific routine
-    switch (((NvU64 *)(*src))[2])
-    {
-        case FINN_INTERFACE_ID(FINN_NV01_ROOT_NVD):
-            return FinnNv01RootNvdDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_ROOT_NVD *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_DMA):
-            return FinnNv01Device0DmaDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_DEVICE_0_DMA *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FB):
-            return FinnNv01Device0FbDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_DEVICE_0_FB *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FIFO):
-            return FinnNv01Device0FifoDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_DEVICE_0_FIFO *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GPU):
-            return FinnNv01Device0GpuDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_DEVICE_0_GPU *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GR):
-            return FinnNv01Device0GrDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_DEVICE_0_GR *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_HOST):
-            return FinnNv01Device0HostDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_DEVICE_0_HOST *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_MSENC):
-            return FinnNv01Device0MsencDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV01_DEVICE_0_MSENC *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_CE):
-            return FinnNv20Subdevice0CeDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV20_SUBDEVICE_0_CE *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_GPU):
-            return FinnNv20Subdevice0GpuDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV20_SUBDEVICE_0_GPU *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_I2C):
-            return FinnNv20Subdevice0I2cDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV20_SUBDEVICE_0_I2C *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_NVD):
-            return FinnNv20Subdevice0NvdDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV20_SUBDEVICE_0_NVD *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_PERF):
-            return FinnNv20Subdevice0PerfDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV20_SUBDEVICE_0_PERF *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_RC):
-            return FinnNv20Subdevice0RcDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV20_SUBDEVICE_0_RC *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_NV40_I2C_I2C):
-            return FinnNv40I2cI2cDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_NV40_I2C_I2C *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_GT200_DEBUGGER_DEBUG):
-            return FinnGt200DebuggerDebugDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_GT200_DEBUGGER_DEBUG *) dst, dst_size, deser_up);
-        case FINN_INTERFACE_ID(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO):
-            return FinnMaxwellChannelGpfifoAGpfifoDeserialize((NvU8 **) src, (const NvU8 *) src_max, (FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-NvU64 FinnRmApiGetSerializedSize(NvU64 interface, NvU64 message, const NvP64 src)
-{
-    // Input validation
-    if (!src)
-        return 0;
-
-    // Forward to interface-specific routine
-    switch (interface)
-    {
-        case FINN_INTERFACE_ID(FINN_NV01_ROOT_NVD):
-            return FinnNv01RootNvdGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_DMA):
-            return FinnNv01Device0DmaGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FB):
-            return FinnNv01Device0FbGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FIFO):
-            return FinnNv01Device0FifoGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GPU):
-            return FinnNv01Device0GpuGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GR):
-            return FinnNv01Device0GrGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_HOST):
-            return FinnNv01Device0HostGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_MSENC):
-            return FinnNv01Device0MsencGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_CE):
-            return FinnNv20Subdevice0CeGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_GPU):
-            return FinnNv20Subdevice0GpuGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_I2C):
-            return FinnNv20Subdevice0I2cGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_NVD):
-            return FinnNv20Subdevice0NvdGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_PERF):
-            return FinnNv20Subdevice0PerfGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_RC):
-            return FinnNv20Subdevice0RcGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_NV40_I2C_I2C):
-            return FinnNv40I2cI2cGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_GT200_DEBUGGER_DEBUG):
-            return FinnGt200DebuggerDebugGetSerializedSize(message, src);
-        case FINN_INTERFACE_ID(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO):
-            return FinnMaxwellChannelGpfifoAGpfifoGetSerializedSize(message, src);
-        default:
-            return 0;
-    }
-}
-
-NvU64 FinnRmApiGetUnserializedSize(NvU64 interface, NvU64 message)
-{
-    // Forward to interface-specific routine
-    switch (interface)
-    {
-        case FINN_INTERFACE_ID(FINN_NV01_ROOT_NVD):
-            return FinnNv01RootNvdGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_DMA):
-            return FinnNv01Device0DmaGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FB):
-            return FinnNv01Device0FbGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_FIFO):
-            return FinnNv01Device0FifoGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GPU):
-            return FinnNv01Device0GpuGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_GR):
-            return FinnNv01Device0GrGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_HOST):
-            return FinnNv01Device0HostGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV01_DEVICE_0_MSENC):
-            return FinnNv01Device0MsencGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_CE):
-            return FinnNv20Subdevice0CeGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_GPU):
-            return FinnNv20Subdevice0GpuGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_I2C):
-            return FinnNv20Subdevice0I2cGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_NVD):
-            return FinnNv20Subdevice0NvdGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_PERF):
-            return FinnNv20Subdevice0PerfGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_RC):
-            return FinnNv20Subdevice0RcGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_NV40_I2C_I2C):
-            return FinnNv40I2cI2cGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_GT200_DEBUGGER_DEBUG):
-            return FinnGt200DebuggerDebugGetUnserializedSize(message);
-        case FINN_INTERFACE_ID(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO):
-            return FinnMaxwellChannelGpfifoAGpfifoGetUnserializedSize(message);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv01RootNvdSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0000_CTRL_NVD_GET_DUMP_PARAMS):
-            return Nv0000CtrlNvdGetDumpParamsSerialize((const NV0000_CTRL_NVD_GET_DUMP_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv01RootNvdDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_ROOT_NVD *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV0000_CTRL_NVD_GET_DUMP_PARAMS):
-            return Nv0000CtrlNvdGetDumpParamsDeserialize(src, src_max, (NV0000_CTRL_NVD_GET_DUMP_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv01RootNvdGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0000_CTRL_NVD_GET_DUMP_PARAMS):
-            return Nv0000CtrlNvdGetDumpParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv01RootNvdGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0000_CTRL_NVD_GET_DUMP_PARAMS):
-            return sizeof(NV0000_CTRL_NVD_GET_DUMP_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv01Device0DmaSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS):
-            return Nv0080CtrlDmaUpdatePde2ParamsSerialize((const NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv01Device0DmaDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_DMA *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS):
-            return Nv0080CtrlDmaUpdatePde2ParamsDeserialize(src, src_max, (NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv01Device0DmaGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS):
-            return Nv0080CtrlDmaUpdatePde2ParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv01Device0DmaGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS):
-            return sizeof(NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv01Device0FbSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FB_GET_CAPS_PARAMS):
-            return Nv0080CtrlFbGetCapsParamsSerialize((const NV0080_CTRL_FB_GET_CAPS_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv01Device0FbDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_FB *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FB_GET_CAPS_PARAMS):
-            return Nv0080CtrlFbGetCapsParamsDeserialize(src, src_max, (NV0080_CTRL_FB_GET_CAPS_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv01Device0FbGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FB_GET_CAPS_PARAMS):
-            return Nv0080CtrlFbGetCapsParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv01Device0FbGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FB_GET_CAPS_PARAMS):
-            return sizeof(NV0080_CTRL_FB_GET_CAPS_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv01Device0FifoSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CAPS_PARAMS):
-            return Nv0080CtrlFifoGetCapsParamsSerialize((const NV0080_CTRL_FIFO_GET_CAPS_PARAMS *) src, dst, dst_max, seri_up);
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS):
-            return Nv0080CtrlFifoStartSelectedChannelsParamsSerialize((const NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS *) src, dst, dst_max, seri_up);
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS):
-            return Nv0080CtrlFifoGetChannellistParamsSerialize((const NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv01Device0FifoDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_FIFO *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CAPS_PARAMS):
-            return Nv0080CtrlFifoGetCapsParamsDeserialize(src, src_max, (NV0080_CTRL_FIFO_GET_CAPS_PARAMS *) dst, dst_size, deser_up);
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS):
-            return Nv0080CtrlFifoStartSelectedChannelsParamsDeserialize(src, src_max, (NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS *) dst, dst_size, deser_up);
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS):
-            return Nv0080CtrlFifoGetChannellistParamsDeserialize(src, src_max, (NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv01Device0FifoGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CAPS_PARAMS):
-            return Nv0080CtrlFifoGetCapsParamsGetSerializedSize(NvP64_VALUE(src));
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS):
-            return Nv0080CtrlFifoStartSelectedChannelsParamsGetSerializedSize(NvP64_VALUE(src));
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS):
-            return Nv0080CtrlFifoGetChannellistParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv01Device0FifoGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CAPS_PARAMS):
-            return sizeof(NV0080_CTRL_FIFO_GET_CAPS_PARAMS);
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS):
-            return sizeof(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS);
-        case FINN_MESSAGE_ID(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS):
-            return sizeof(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv01Device0GpuSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS):
-            return Nv0080CtrlGpuGetClasslistParamsSerialize((const NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv01Device0GpuDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_GPU *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS):
-            return Nv0080CtrlGpuGetClasslistParamsDeserialize(src, src_max, (NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv01Device0GpuGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS):
-            return Nv0080CtrlGpuGetClasslistParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv01Device0GpuGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS):
-            return sizeof(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv01Device0GrSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GR_GET_CAPS_PARAMS):
-            return Nv0080CtrlGrGetCapsParamsSerialize((const NV0080_CTRL_GR_GET_CAPS_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv01Device0GrDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_GR *dst, NvLength dst_size, NvBool deser_up)
-{
     // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
+    desc = FinnRmApiLookupMessage(((NvU64 *)(*src))[2], ((NvU64 *)(*src))[3]);
+    if (!desc)
     {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GR_GET_CAPS_PARAMS):
-            return Nv0080CtrlGrGetCapsParamsDeserialize(src, src_max, (NV0080_CTRL_GR_GET_CAPS_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
+        FINN_ERROR(NV_ERR_NOT_SUPPORTED);
+        return NV_ERR_NOT_SUPPORTED;
     }
-}
 
-static NvU64 FinnNv01Device0GrGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GR_GET_CAPS_PARAMS):
-            return Nv0080CtrlGrGetCapsParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
+    return desc->pfnDeserialize((NvU8 **) src, (const NvU8 *) (*src + src_size), dst, dst_size, deser_up);
 }
 
-static NvU64 FinnNv01Device0GrGetUnserializedSize(NvU64 message)
+NvU64 FinnRmApiGetSerializedSize(NvU64 interface, NvU64 message, const NvP64 src)
 {
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_GR_GET_CAPS_PARAMS):
-            return sizeof(NV0080_CTRL_GR_GET_CAPS_PARAMS);
-        default:
-            return 0;
-    }
-}
+    const FINN_MESSAGE_DESCRIPTOR *desc;
 
-static NV_STATUS FinnNv01Device0HostSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_HOST_GET_CAPS_PARAMS):
-            return Nv0080CtrlHostGetCapsParamsSerialize((const NV0080_CTRL_HOST_GET_CAPS_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
+    // Input validation
+    if (!src)
+        return 0;
 
-static NV_STATUS FinnNv01Device0HostDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_HOST *dst, NvLength dst_size, NvBool deser_up)
-{
     // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_HOST_GET_CAPS_PARAMS):
-            return Nv0080CtrlHostGetCapsParamsDeserialize(src, src_max, (NV0080_CTRL_HOST_GET_CAPS_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
+    desc = FinnRmApiLookupMessage(interface, message);
+    if (!desc)
+        return 0;
 
-static NvU64 FinnNv01Device0HostGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_HOST_GET_CAPS_PARAMS):
-            return Nv0080CtrlHostGetCapsParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
+    return desc->pfnGetSerializedSize((const char *) NvP64_VALUE(src));
 }
 
-static NvU64 FinnNv01Device0HostGetUnserializedSize(NvU64 message)
+NvU64 FinnRmApiGetUnserializedSize(NvU64 interface, NvU64 message)
 {
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_HOST_GET_CAPS_PARAMS):
-            return sizeof(NV0080_CTRL_HOST_GET_CAPS_PARAMS);
-        default:
-            return 0;
-    }
-}
+    const FINN_MESSAGE_DESCRIPTOR *desc = FinnRmApiLookupMessage(interface, message);
 
-static NV_STATUS FinnNv01Device0MsencSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_MSENC_GET_CAPS_PARAMS):
-            return Nv0080CtrlMsencGetCapsParamsSerialize((const NV0080_CTRL_MSENC_GET_CAPS_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv01Device0MsencDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV01_DEVICE_0_MSENC *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_MSENC_GET_CAPS_PARAMS):
-            return Nv0080CtrlMsencGetCapsParamsDeserialize(src, src_max, (NV0080_CTRL_MSENC_GET_CAPS_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv01Device0MsencGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_MSENC_GET_CAPS_PARAMS):
-            return Nv0080CtrlMsencGetCapsParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv01Device0MsencGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV0080_CTRL_MSENC_GET_CAPS_PARAMS):
-            return sizeof(NV0080_CTRL_MSENC_GET_CAPS_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0CeSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_CE_GET_CAPS_PARAMS):
-            return Nv2080CtrlCeGetCapsParamsSerialize((const NV2080_CTRL_CE_GET_CAPS_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0CeDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_CE *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_CE_GET_CAPS_PARAMS):
-            return Nv2080CtrlCeGetCapsParamsDeserialize(src, src_max, (NV2080_CTRL_CE_GET_CAPS_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv20Subdevice0CeGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_CE_GET_CAPS_PARAMS):
-            return Nv2080CtrlCeGetCapsParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv20Subdevice0CeGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_CE_GET_CAPS_PARAMS):
-            return sizeof(NV2080_CTRL_CE_GET_CAPS_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0GpuSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINES_PARAMS):
-            return Nv2080CtrlGpuGetEnginesParamsSerialize((const NV2080_CTRL_GPU_GET_ENGINES_PARAMS *) src, dst, dst_max, seri_up);
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS):
-            return Nv2080CtrlGpuGetEngineClasslistParamsSerialize((const NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0GpuDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_GPU *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINES_PARAMS):
-            return Nv2080CtrlGpuGetEnginesParamsDeserialize(src, src_max, (NV2080_CTRL_GPU_GET_ENGINES_PARAMS *) dst, dst_size, deser_up);
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS):
-            return Nv2080CtrlGpuGetEngineClasslistParamsDeserialize(src, src_max, (NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv20Subdevice0GpuGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINES_PARAMS):
-            return Nv2080CtrlGpuGetEnginesParamsGetSerializedSize(NvP64_VALUE(src));
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS):
-            return Nv2080CtrlGpuGetEngineClasslistParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv20Subdevice0GpuGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINES_PARAMS):
-            return sizeof(NV2080_CTRL_GPU_GET_ENGINES_PARAMS);
-        case FINN_MESSAGE_ID(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS):
-            return sizeof(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0I2cSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_I2C_ACCESS_PARAMS):
-            return Nv2080CtrlI2cAccessParamsSerialize((const NV2080_CTRL_I2C_ACCESS_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0I2cDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_I2C *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_I2C_ACCESS_PARAMS):
-            return Nv2080CtrlI2cAccessParamsDeserialize(src, src_max, (NV2080_CTRL_I2C_ACCESS_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv20Subdevice0I2cGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_I2C_ACCESS_PARAMS):
-            return Nv2080CtrlI2cAccessParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv20Subdevice0I2cGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_I2C_ACCESS_PARAMS):
-            return sizeof(NV2080_CTRL_I2C_ACCESS_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0NvdSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_NVD_GET_DUMP_PARAMS):
-            return Nv2080CtrlNvdGetDumpParamsSerialize((const NV2080_CTRL_NVD_GET_DUMP_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0NvdDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_NVD *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_NVD_GET_DUMP_PARAMS):
-            return Nv2080CtrlNvdGetDumpParamsDeserialize(src, src_max, (NV2080_CTRL_NVD_GET_DUMP_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv20Subdevice0NvdGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_NVD_GET_DUMP_PARAMS):
-            return Nv2080CtrlNvdGetDumpParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv20Subdevice0NvdGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_NVD_GET_DUMP_PARAMS):
-            return sizeof(NV2080_CTRL_NVD_GET_DUMP_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0PerfSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM):
-            return Nv2080CtrlGpumonSamplesSerialize((const NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM *) src, dst, dst_max, seri_up, FINN_INTERFACE_ID(FINN_NV20_SUBDEVICE_0_PERF), FINN_MESSAGE_ID(NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM));
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0PerfDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_PERF *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM):
-            return Nv2080CtrlGpumonSamplesDeserialize(src, src_max, (NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv20Subdevice0PerfGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM):
-            return Nv2080CtrlGpumonSamplesGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv20Subdevice0PerfGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM):
-            return sizeof(NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0RcSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS):
-            return Nv2080CtrlRcReadVirtualMemParamsSerialize((const NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv20Subdevice0RcDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV20_SUBDEVICE_0_RC *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS):
-            return Nv2080CtrlRcReadVirtualMemParamsDeserialize(src, src_max, (NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv20Subdevice0RcGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS):
-            return Nv2080CtrlRcReadVirtualMemParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv20Subdevice0RcGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS):
-            return sizeof(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnNv40I2cI2cSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_INDEXED_PARAMS):
-            return Nv402cCtrlI2cIndexedParamsSerialize((const NV402C_CTRL_I2C_INDEXED_PARAMS *) src, dst, dst_max, seri_up);
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_TRANSACTION_PARAMS):
-            return Nv402cCtrlI2cTransactionParamsSerialize((const NV402C_CTRL_I2C_TRANSACTION_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnNv40I2cI2cDeserialize(NvU8 **src, const NvU8 *src_max, FINN_NV40_I2C_I2C *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_INDEXED_PARAMS):
-            return Nv402cCtrlI2cIndexedParamsDeserialize(src, src_max, (NV402C_CTRL_I2C_INDEXED_PARAMS *) dst, dst_size, deser_up);
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_TRANSACTION_PARAMS):
-            return Nv402cCtrlI2cTransactionParamsDeserialize(src, src_max, (NV402C_CTRL_I2C_TRANSACTION_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnNv40I2cI2cGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_INDEXED_PARAMS):
-            return Nv402cCtrlI2cIndexedParamsGetSerializedSize(NvP64_VALUE(src));
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_TRANSACTION_PARAMS):
-            return Nv402cCtrlI2cTransactionParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnNv40I2cI2cGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_INDEXED_PARAMS):
-            return sizeof(NV402C_CTRL_I2C_INDEXED_PARAMS);
-        case FINN_MESSAGE_ID(NV402C_CTRL_I2C_TRANSACTION_PARAMS):
-            return sizeof(NV402C_CTRL_I2C_TRANSACTION_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnGt200DebuggerDebugSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS):
-            return Nv83deCtrlDebugReadMemoryParamsSerialize((const NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS *) src, dst, dst_max, seri_up);
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS):
-            return Nv83deCtrlDebugWriteMemoryParamsSerialize((const NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnGt200DebuggerDebugDeserialize(NvU8 **src, const NvU8 *src_max, FINN_GT200_DEBUGGER_DEBUG *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS):
-            return Nv83deCtrlDebugReadMemoryParamsDeserialize(src, src_max, (NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS *) dst, dst_size, deser_up);
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS):
-            return Nv83deCtrlDebugWriteMemoryParamsDeserialize(src, src_max, (NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnGt200DebuggerDebugGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS):
-            return Nv83deCtrlDebugReadMemoryParamsGetSerializedSize(NvP64_VALUE(src));
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS):
-            return Nv83deCtrlDebugWriteMemoryParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnGt200DebuggerDebugGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS):
-            return sizeof(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS);
-        case FINN_MESSAGE_ID(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS):
-            return sizeof(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS);
-        default:
-            return 0;
-    }
-}
-
-static NV_STATUS FinnMaxwellChannelGpfifoAGpfifoSerialize(NvU64 message, const char *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS):
-            return Nvb06fCtrlGetEngineCtxDataParamsSerialize((const NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS *) src, dst, dst_max, seri_up);
-        case FINN_MESSAGE_ID(NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS):
-            return Nvb06fCtrlCmdMigrateEngineCtxDataFinnParamsSerialize((const NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS *) src, dst, dst_max, seri_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NV_STATUS FinnMaxwellChannelGpfifoAGpfifoDeserialize(NvU8 **src, const NvU8 *src_max, FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO *dst, NvLength dst_size, NvBool deser_up)
-{
-    // Forward to message-specific routine
-    switch (((NvU64 *)(*src))[3])
-    {
-        case FINN_MESSAGE_ID(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS):
-            return Nvb06fCtrlGetEngineCtxDataParamsDeserialize(src, src_max, (NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS *) dst, dst_size, deser_up);
-        case FINN_MESSAGE_ID(NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS):
-            return Nvb06fCtrlCmdMigrateEngineCtxDataFinnParamsDeserialize(src, src_max, (NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS *) dst, dst_size, deser_up);
-        default:
-        {
-            FINN_ERROR(NV_ERR_NOT_SUPPORTED);
-            return NV_ERR_NOT_SUPPORTED;
-        }
-    }
-}
-
-static NvU64 FinnMaxwellChannelGpfifoAGpfifoGetSerializedSize(NvU64 message, const NvP64 src)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS):
-            return Nvb06fCtrlGetEngineCtxDataParamsGetSerializedSize(NvP64_VALUE(src));
-        case FINN_MESSAGE_ID(NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS):
-            return Nvb06fCtrlCmdMigrateEngineCtxDataFinnParamsGetSerializedSize(NvP64_VALUE(src));
-        default:
-            return 0;
-    }
-}
-
-static NvU64 FinnMaxwellChannelGpfifoAGpfifoGetUnserializedSize(NvU64 message)
-{
-    // Forward to message-specific routine
-    switch (message)
-    {
-        case FINN_MESSAGE_ID(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS):
-            return sizeof(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS);
-        case FINN_MESSAGE_ID(NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS):
-            return sizeof(NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS);
-        default:
-            return 0;
-    }
+    return desc ? desc->unserializedSize : 0;
 }
 
 static NV_STATUS Nv0000CtrlNvdGetDumpParamsSerialize(const NV0000_CTRL_NVD_GET_DUMP_PARAMS *src, NvU8 **dst, const NvU8 *dst_max, NvBool seri_up)
@@ -1967,7 +921,6 @@ static NvU64 Nv0080CtrlDmaUpdatePde2ParamsGetSerializedSize(const NV0080_CTRL_DM
     NvU64 size = 168;
 
     // Add sizes that require runtime calculation
-    size += 112;
     // Increment size to account for the data presence byte.
     ++size;
 
@@ -37,6 +37,7 @@
 #include "ctrl/ctrl0080/ctrl0080fb.h" // rmcontrol params (from hal)
 #include "ctrl/ctrl0080/ctrl0080dma.h" // rmcontrol params (from hal)
 #include "gpu/gsp/message_queue.h"
+#include "vgpu/rpc_async.h"
 
 
 typedef struct GSP_FIRMWARE GSP_FIRMWARE;
@@ -45,6 +46,60 @@ typedef struct _object_vgpu OBJVGPU, *POBJVGPU;
 #include "g_rpc_hal.h" // For RPC_HAL_IFACES
 #include "g_rpc_odb.h" // For RPC_HAL_IFACES
 
+//
+// One control of a batch issued with rpcRmApiControlBatch_GSP().
+//
+typedef struct RPC_CONTROL_BATCH_ENTRY
+{
+    NvHandle   hClient;
+    NvHandle   hObject;
+    NvU32      cmd;
+    void      *pParams;
+    NvU32      paramsSize;
+    NV_STATUS  status;                      // [out] Result of this control
+} RPC_CONTROL_BATCH_ENTRY;
+
+//
+// RPC latency profile.
+// Each RPC function gets a log-linear histogram of its round-trip latency:
+// RPC_PROFILE_SUB_BUCKETS buckets per power of two, so a bucket is never wider
+// than a quarter of its lower bound. Histograms are allocated the first time
+// a function is issued while profiling is enabled, and are updated under the
+// GPU lock that already serializes the RPC path.
+//
+#define RPC_PROFILE_SUB_BUCKET_BITS 2
+#define RPC_PROFILE_SUB_BUCKETS     (1U << RPC_PROFILE_SUB_BUCKET_BITS)
+#define RPC_PROFILE_UNIT_SHIFT      8       // 256ns resolution for the fastest RPCs
+#define RPC_PROFILE_MAX_MSB         26      // ~34s; anything slower lands in the overflow bucket
+#define RPC_PROFILE_NUM_BUCKETS     (((RPC_PROFILE_MAX_MSB - RPC_PROFILE_SUB_BUCKET_BITS + 2) * \
+                                      RPC_PROFILE_SUB_BUCKETS) + 1)
+
+typedef struct RPC_PROFILE_FUNCTION
+{
+    NvU64 count;
+    NvU64 totalNs;
+    NvU64 maxNs;
+    NvU64 bytesSent;
+    NvU64 bytesReceived;
+    NvU64 buckets[RPC_PROFILE_NUM_BUCKETS];
+} RPC_PROFILE_FUNCTION;
+
+typedef struct RPC_PROFILE
+{
+    RPC_PROFILE_FUNCTION *pFunctions[NV_VGPU_MSG_FUNCTION_NUM_FUNCTIONS];
+} RPC_PROFILE;
+
+typedef struct RPC_PROFILE_STATS
+{
+    NvU64 count;
+    NvU64 p50Ns;
+    NvU64 p99Ns;
+    NvU64 maxNs;
+    NvU64 totalNs;
+    NvU64 bytesSent;
+    NvU64 bytesReceived;
+} RPC_PROFILE_STATS;
+
 struct OBJRPC{
     OBJECT_BASE_DEFINITION(RPC);
 
@@ -71,6 +126,12 @@ struct OBJRPC{
     struct _message_queue_info *pMessageQueueInfo;
     RmPhysAddr                  messageQueuePhysMem;
 
+    /* Outstanding asynchronous RPCs */
+    RPC_ASYNC_TABLE             async;
+
+    /* Latency profile, NULL while profiling is disabled */
+    RPC_PROFILE                *pProfile;
+
 };
 
 //
@@ -102,6 +163,18 @@ void _freeRpcMemDesc(OBJGPU *pGpu, MEMORY_DESCRIPTOR **ppMemDesc, void **ppMemBu
 NV_STATUS vgpuGspSetupBuffers(OBJGPU *pGpu);
 void vgpuGspTeardownBuffers(OBJGPU *pGpu);
 
+// Asynchronous RPC submission and completion
+NV_STATUS rpcAsyncSubmit(OBJGPU *pGpu, OBJRPC *pRpc, NvBool bDiscardReply, NvU32 *pSequence);
+NV_STATUS rpcAsyncPoll(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 sequence);
+NV_STATUS rpcAsyncWait(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 sequence);
+NV_STATUS rpcAsyncCompleteReply(OBJGPU *pGpu, OBJRPC *pRpc);
+void rpcAsyncCancelAll(OBJGPU *pGpu, OBJRPC *pRpc);
+
+// RPC latency profiling
+NV_STATUS rpcProfileEnable(OBJGPU *pGpu, OBJRPC *pRpc, NvBool bEnable);
+void rpcProfileReset(OBJGPU *pGpu, OBJRPC *pRpc);
+NV_STATUS rpcProfileGetStats(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 function, RPC_PROFILE_STATS *pStats);
+
 //
 // OBJGPU RPC member accessors.
 // Historically, they have been defined inline by the following macros.
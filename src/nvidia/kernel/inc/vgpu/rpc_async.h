@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef _RPC_ASYNC_H_
+#define _RPC_ASYNC_H_
+
+#include "nvtypes.h"
+#include "nvstatus.h"
+
+//
+// Asynchronous RPC tracking.
+// Several RPCs may sit in the command queue at once. Each one is stamped with
+// a sequence number in its message header and recorded here; replies drained
+// from the status queue are matched back to their entry (by sequence if GSP
+// echoes it, otherwise oldest-first, as GSP services the queue in order) and
+// parked until the submitter collects them, in any order.
+//
+// Slots are handed out from a free mask, so an entry that is never collected
+// only takes its own slot. An entry whose waiter gave up is kept as a
+// tombstone that swallows the late reply. GSP answers in order, so a
+// tombstone older than any reply that arrives is retired as well.
+//
+// Synchronous RPCs are sent with sequence 0. Once GSP is seen to echo
+// sequences, a reply without one belongs to a synchronous RPC and is never
+// matched against the table.
+//
+#define RPC_ASYNC_MAX_OUTSTANDING 32
+
+typedef struct RPC_ASYNC_ENTRY
+{
+    NvU32                 sequence;
+    NvU32                 function;
+    NvBool                bInUse;
+    NvBool                bComplete;
+    NvBool                bDiscardReply;    // Fire-and-forget: free on completion
+    NvBool                bAbandoned;       // Tombstone: the waiter gave up
+    NV_STATUS             status;
+    NvU32                 sentBytes;        // Message length, for the RPC profile
+    NvU64                 submitTimeNs;     // Submission time, 0 unless profiling
+    void                 *pReply;           // Copy of the reply message, owned by the entry
+} RPC_ASYNC_ENTRY;
+
+typedef struct RPC_ASYNC_TABLE
+{
+    RPC_ASYNC_ENTRY entries[RPC_ASYNC_MAX_OUTSTANDING];
+    NvU32           usedMask;               // Bit per entry in use, tombstones included
+    NvU32           nextSequence;
+    NvU32           waitSequence;           // Sequence rpcAsyncWait() is polling for, or 0
+    NvBool          bSequenceEchoed;        // GSP echoes sequences: unsequenced replies are synchronous
+    NvBool          bDeferDoorbell;         // Batch being queued: hold back the doorbell
+    NvBool          bDoorbellPending;       // Commands queued since the last doorbell
+} RPC_ASYNC_TABLE;
+
+RPC_ASYNC_ENTRY *rpcAsyncTableAlloc(RPC_ASYNC_TABLE *pTable, NvU32 function);
+RPC_ASYNC_ENTRY *rpcAsyncTableFind(RPC_ASYNC_TABLE *pTable, NvU32 sequence);
+RPC_ASYNC_ENTRY *rpcAsyncTableMatchReply(RPC_ASYNC_TABLE *pTable, NvU32 sequence, NvU32 function);
+void rpcAsyncTableAbandon(RPC_ASYNC_TABLE *pTable, RPC_ASYNC_ENTRY *pEntry);
+void rpcAsyncTableRelease(RPC_ASYNC_TABLE *pTable, RPC_ASYNC_ENTRY *pEntry);
+void rpcAsyncTableReset(RPC_ASYNC_TABLE *pTable);
+
+#endif // _RPC_ASYNC_H_
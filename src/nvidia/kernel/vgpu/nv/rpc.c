@@ -72,23 +72,6 @@
 
 #include "gpu/gsp/message_queue_priv.h"
 
-static NvBool bProfileRPC = NV_FALSE;
-
-typedef struct rpc_meter_list
-{
-    RPC_METER_ENTRY rpcData;
-    struct rpc_meter_list *pNext;
-} RPC_METER_LIST;
-
-typedef struct rpc_meter_head
-{
-    RPC_METER_LIST *pHead;
-    RPC_METER_LIST *pTail;
-} RPC_METER_HEAD;
-
-static RPC_METER_HEAD rpcMeterHead;
-static NvU32 rpcProfilerEntryCount;
-
 typedef struct rpc_vgx_version
 {
     NvU32 majorNum;
@@ -120,6 +103,7 @@ NV_STATUS rpcConstruct_IMPL(OBJGPU *pGpu, OBJRPC *pRpc)
 
 void rpcDestroy_IMPL(OBJGPU *pGpu, OBJRPC *pRpc)
 {
+    rpcProfileEnable(pGpu, pRpc, NV_FALSE);
 }
 
 NV_STATUS rpcSendMessage_IMPL(OBJGPU *pGpu, OBJRPC *pRpc)
@@ -134,41 +118,238 @@ NV_STATUS rpcRecvPoll_IMPL(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 expectedFunc)
     return NV_ERR_NOT_SUPPORTED;
 }
 
-static NV_STATUS _issueRpcAndWait(OBJGPU *pGpu, OBJRPC *pRpc)
+static NV_STATUS _rpcCheckResult(OBJRPC *pRpc)
 {
-    NV_STATUS status = NV_OK;
-    RPC_METER_LIST *pNewEntry = NULL;
+    if (vgpu_rpc_message_header_v->rpc_result != NV_VGPU_MSG_RESULT_SUCCESS)
+    {
+        NV_PRINTF(LEVEL_WARNING, "RPC failed with status 0x%08x for fn %d!\n",
+                  vgpu_rpc_message_header_v->rpc_result,
+                  vgpu_rpc_message_header_v->function);
 
-    // should not be called in broadcast mode
-    NV_ASSERT_OR_RETURN(!gpumgrGetBcEnabledStatus(pGpu), NV_ERR_INVALID_STATE);
+        if (vgpu_rpc_message_header_v->rpc_result < DRF_BASE(NV_VGPU_MSG_RESULT__VMIOP))
+            return vgpu_rpc_message_header_v->rpc_result;
+
+        return NV_ERR_GENERIC;
+    }
+
+    return NV_OK;
+}
+
+/*!
+ * Map a latency to its histogram bucket.
+ *
+ * The first RPC_PROFILE_SUB_BUCKETS buckets are linear in units of
+ * 1 << RPC_PROFILE_UNIT_SHIFT ns; after that every power of two is split
+ * into RPC_PROFILE_SUB_BUCKETS equal buckets.
+ */
+static NvU32 _rpcProfileBucket(NvU64 latencyNs)
+{
+    NvU64 units = latencyNs >> RPC_PROFILE_UNIT_SHIFT;
+    NvU32 msb;
 
-    if (bProfileRPC)
+    if (units < RPC_PROFILE_SUB_BUCKETS)
+        return (NvU32)units;
+
+    msb = 63 - portUtilCountLeadingZeros64(units);
+    if (msb > RPC_PROFILE_MAX_MSB)
+        return RPC_PROFILE_NUM_BUCKETS - 1;
+
+    return ((msb - RPC_PROFILE_SUB_BUCKET_BITS + 1) * RPC_PROFILE_SUB_BUCKETS) +
+           (NvU32)((units >> (msb - RPC_PROFILE_SUB_BUCKET_BITS)) & (RPC_PROFILE_SUB_BUCKETS - 1));
+}
+
+/*!
+ * Midpoint of a histogram bucket, in ns.
+ */
+static NvU64 _rpcProfileBucketValue(NvU32 bucket)
+{
+    NvU32 octave = bucket / RPC_PROFILE_SUB_BUCKETS;
+    NvU32 sub    = bucket % RPC_PROFILE_SUB_BUCKETS;
+    NvU32 shift;
+
+    if (octave == 0)
+        return ((NvU64)sub << RPC_PROFILE_UNIT_SHIFT) + (1ULL << (RPC_PROFILE_UNIT_SHIFT - 1));
+
+    shift = octave - 1 + RPC_PROFILE_UNIT_SHIFT;
+
+    return ((NvU64)(RPC_PROFILE_SUB_BUCKETS + sub) << shift) + (1ULL << shift) / 2;
+}
+
+/*!
+ * Latency below which the given percentage of samples fall.
+ */
+static NvU64 _rpcProfilePercentile(const RPC_PROFILE_FUNCTION *pFunction, NvU32 percent)
+{
+    NvU64 rank = ((pFunction->count * percent) + 99) / 100;
+    NvU64 seen = 0;
+    NvU32 i;
+
+    for (i = 0; i < RPC_PROFILE_NUM_BUCKETS; i++)
     {
-        // Create a new entry for our RPC profiler
-        pNewEntry = portMemAllocNonPaged(sizeof(RPC_METER_LIST));
-        if (pNewEntry == NULL)
+        seen += pFunction->buckets[i];
+        if (seen >= rank)
         {
-            NV_PRINTF(LEVEL_ERROR, "failed to allocate RPC meter memory!\n");
-            NV_ASSERT(0);
-            return NV_ERR_INSUFFICIENT_RESOURCES;
+            // The overflow bucket has no upper bound to take a midpoint of.
+            if (i == RPC_PROFILE_NUM_BUCKETS - 1)
+                return pFunction->maxNs;
+
+            return NV_MIN(_rpcProfileBucketValue(i), pFunction->maxNs);
         }
+    }
 
-        portMemSet(pNewEntry, 0, sizeof(RPC_METER_LIST));
+    return pFunction->maxNs;
+}
 
-        if (rpcMeterHead.pHead == NULL)
-            rpcMeterHead.pHead = pNewEntry;
-        else
-            rpcMeterHead.pTail->pNext = pNewEntry;
+/*!
+ * Account one completed RPC in the profile. Does nothing while profiling is
+ * disabled, or if the RPC was issued before it was enabled.
+ */
+static void _rpcProfileRecord
+(
+    OBJRPC *pRpc,
+    NvU32   function,
+    NvU64   startTimeNs,
+    NvU32   sentBytes,
+    NvU32   receivedBytes
+)
+{
+    RPC_PROFILE *pProfile = pRpc->pProfile;
+    RPC_PROFILE_FUNCTION *pFunction;
+    NvU64 endTimeNs;
+    NvU64 latencyNs;
 
-        rpcMeterHead.pTail = pNewEntry;
+    if ((pProfile == NULL) || (startTimeNs == 0) ||
+        (function >= NV_VGPU_MSG_FUNCTION_NUM_FUNCTIONS))
+    {
+        return;
+    }
 
-        pNewEntry->rpcData.rpcDataTag = vgpu_rpc_message_header_v->function;
+    osGetPerformanceCounter(&endTimeNs);
+    latencyNs = (endTimeNs > startTimeNs) ? (endTimeNs - startTimeNs) : 0;
 
-        rpcProfilerEntryCount++;
+    pFunction = pProfile->pFunctions[function];
+    if (pFunction == NULL)
+    {
+        pFunction = portMemAllocNonPaged(sizeof(*pFunction));
+        if (pFunction == NULL)
+            return;
 
-        osGetPerformanceCounter(&pNewEntry->rpcData.startTimeInNs);
+        portMemSet(pFunction, 0, sizeof(*pFunction));
+        pProfile->pFunctions[function] = pFunction;
     }
 
+    pFunction->count++;
+    pFunction->totalNs       += latencyNs;
+    pFunction->maxNs          = NV_MAX(pFunction->maxNs, latencyNs);
+    pFunction->bytesSent     += sentBytes;
+    pFunction->bytesReceived += receivedBytes;
+    pFunction->buckets[_rpcProfileBucket(latencyNs)]++;
+}
+
+static NvU64 _rpcProfileStart(OBJRPC *pRpc)
+{
+    NvU64 timeNs = 0;
+
+    if (pRpc->pProfile != NULL)
+        osGetPerformanceCounter(&timeNs);
+
+    return timeNs;
+}
+
+/*!
+ * Enable or disable RPC latency profiling. Disabling discards the profile.
+ */
+NV_STATUS rpcProfileEnable(OBJGPU *pGpu, OBJRPC *pRpc, NvBool bEnable)
+{
+    NV_ASSERT_OR_RETURN(pRpc != NULL, NV_ERR_INVALID_STATE);
+
+    if (bEnable)
+    {
+        if (pRpc->pProfile == NULL)
+        {
+            pRpc->pProfile = portMemAllocNonPaged(sizeof(*pRpc->pProfile));
+            NV_ASSERT_OR_RETURN(pRpc->pProfile != NULL, NV_ERR_NO_MEMORY);
+            portMemSet(pRpc->pProfile, 0, sizeof(*pRpc->pProfile));
+        }
+    }
+    else if (pRpc->pProfile != NULL)
+    {
+        rpcProfileReset(pGpu, pRpc);
+        portMemFree(pRpc->pProfile);
+        pRpc->pProfile = NULL;
+    }
+
+    return NV_OK;
+}
+
+/*!
+ * Drop all samples collected so far, leaving profiling enabled.
+ */
+void rpcProfileReset(OBJGPU *pGpu, OBJRPC *pRpc)
+{
+    NvU32 i;
+
+    if ((pRpc == NULL) || (pRpc->pProfile == NULL))
+        return;
+
+    for (i = 0; i < NV_VGPU_MSG_FUNCTION_NUM_FUNCTIONS; i++)
+    {
+        portMemFree(pRpc->pProfile->pFunctions[i]);
+        pRpc->pProfile->pFunctions[i] = NULL;
+    }
+}
+
+/*!
+ * Summarize the profile of one RPC function.
+ *
+ * @return NV_ERR_INVALID_STATE if profiling is disabled,
+ *         NV_ERR_OBJECT_NOT_FOUND if the function has no samples.
+ */
+NV_STATUS rpcProfileGetStats
+(
+    OBJGPU            *pGpu,
+    OBJRPC            *pRpc,
+    NvU32              function,
+    RPC_PROFILE_STATS *pStats
+)
+{
+    const RPC_PROFILE_FUNCTION *pFunction;
+
+    NV_ASSERT_OR_RETURN(pStats != NULL, NV_ERR_INVALID_ARGUMENT);
+
+    if ((pRpc == NULL) || (pRpc->pProfile == NULL))
+        return NV_ERR_INVALID_STATE;
+
+    if (function >= NV_VGPU_MSG_FUNCTION_NUM_FUNCTIONS)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    pFunction = pRpc->pProfile->pFunctions[function];
+    if ((pFunction == NULL) || (pFunction->count == 0))
+        return NV_ERR_OBJECT_NOT_FOUND;
+
+    pStats->count         = pFunction->count;
+    pStats->p50Ns         = _rpcProfilePercentile(pFunction, 50);
+    pStats->p99Ns         = _rpcProfilePercentile(pFunction, 99);
+    pStats->maxNs         = pFunction->maxNs;
+    pStats->totalNs       = pFunction->totalNs;
+    pStats->bytesSent     = pFunction->bytesSent;
+    pStats->bytesReceived = pFunction->bytesReceived;
+
+    return NV_OK;
+}
+
+static NV_STATUS _issueRpcAndWait(OBJGPU *pGpu, OBJRPC *pRpc)
+{
+    NV_STATUS status = NV_OK;
+    NvU32 function   = vgpu_rpc_message_header_v->function;
+    NvU32 sentBytes  = vgpu_rpc_message_header_v->length;
+    NvU64 startTimeNs;
+
+    // should not be called in broadcast mode
+    NV_ASSERT_OR_RETURN(!gpumgrGetBcEnabledStatus(pGpu), NV_ERR_INVALID_STATE);
+
+    startTimeNs = _rpcProfileStart(pRpc);
+
     status = rpcSendMessage(pGpu, pRpc);
     if (status != NV_OK)
     {
@@ -201,23 +382,11 @@ static NV_STATUS _issueRpcAndWait(OBJGPU *pGpu, OBJRPC *pRpc)
         return status;
     }
 
-    if (bProfileRPC)
-        osGetPerformanceCounter(&pNewEntry->rpcData.endTimeInNs);
+    _rpcProfileRecord(pRpc, function, startTimeNs, sentBytes,
+                      vgpu_rpc_message_header_v->length);
 
     // Now check if RPC really succeeded
-    if (vgpu_rpc_message_header_v->rpc_result != NV_VGPU_MSG_RESULT_SUCCESS)
-    {
-        NV_PRINTF(LEVEL_WARNING, "RPC failed with status 0x%08x for fn %d!\n",
-                  vgpu_rpc_message_header_v->rpc_result,
-                  vgpu_rpc_message_header_v->function);
-
-        if (vgpu_rpc_message_header_v->rpc_result < DRF_BASE(NV_VGPU_MSG_RESULT__VMIOP))
-            return vgpu_rpc_message_header_v->rpc_result;
-
-        return NV_ERR_GENERIC;
-    }
-
-    return NV_OK;
+    return _rpcCheckResult(pRpc);
 }
 
 static NV_STATUS _issueRpcAsync(OBJGPU *pGpu, OBJRPC *pRpc)
@@ -245,6 +414,182 @@ static NV_STATUS _issueRpcAsync(OBJGPU *pGpu, OBJRPC *pRpc)
     return NV_OK;
 }
 
+/*!
+ * Send the RPC in the message buffer without waiting for its reply.
+ *
+ * The RPC is stamped with a sequence number and recorded in the completion
+ * table. Its reply is picked up by whoever next drains the status queue (an
+ * interrupt, another RPC's poll, or rpcAsyncWait()).
+ *
+ * @param[in]  bDiscardReply  Free the entry on completion; failures are only logged
+ * @param[out] pSequence      Sequence to pass to rpcAsyncPoll()/rpcAsyncWait()
+ *
+ * @return NV_ERR_BUSY_RETRY if RPC_ASYNC_MAX_OUTSTANDING RPCs are already in flight.
+ */
+NV_STATUS rpcAsyncSubmit(OBJGPU *pGpu, OBJRPC *pRpc, NvBool bDiscardReply, NvU32 *pSequence)
+{
+    RPC_ASYNC_TABLE *pTable = &pRpc->async;
+    RPC_ASYNC_ENTRY *pEntry;
+    NV_STATUS status;
+
+    NV_ASSERT_OR_RETURN(bDiscardReply || (pSequence != NULL), NV_ERR_INVALID_ARGUMENT);
+
+    pEntry = rpcAsyncTableAlloc(pTable, vgpu_rpc_message_header_v->function);
+    if (pEntry == NULL)
+        return NV_ERR_BUSY_RETRY;
+
+    vgpu_rpc_message_header_v->sequence = pEntry->sequence;
+
+    pEntry->bDiscardReply = bDiscardReply;
+    pEntry->status        = NV_OK;
+    pEntry->sentBytes     = vgpu_rpc_message_header_v->length;
+    pEntry->submitTimeNs  = _rpcProfileStart(pRpc);
+
+    status = _issueRpcAsync(pGpu, pRpc);
+    if (status != NV_OK)
+    {
+        rpcAsyncTableRelease(pTable, pEntry);
+        return status;
+    }
+
+    if (pSequence != NULL)
+        *pSequence = pEntry->sequence;
+
+    return NV_OK;
+}
+
+/*!
+ * Check whether an asynchronous RPC has completed, without draining the queue.
+ *
+ * @return
+ *   NV_OK                              if the reply is ready for rpcAsyncWait().
+ *   NV_WARN_MORE_PROCESSING_REQUIRED   if the RPC is still outstanding.
+ *   NV_ERR_OBJECT_NOT_FOUND            if the sequence is unknown.
+ */
+NV_STATUS rpcAsyncPoll(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 sequence)
+{
+    RPC_ASYNC_ENTRY *pEntry = rpcAsyncTableFind(&pRpc->async, sequence);
+
+    if ((pEntry == NULL) || pEntry->bAbandoned)
+        return NV_ERR_OBJECT_NOT_FOUND;
+
+    return pEntry->bComplete ? NV_OK : NV_WARN_MORE_PROCESSING_REQUIRED;
+}
+
+/*!
+ * Wait for an asynchronous RPC and place its reply in the message buffer, as
+ * a synchronous RPC would have. The RPC can only be waited on once. If the
+ * wait fails before the reply arrives, the entry stays behind as a tombstone
+ * that swallows the late reply.
+ */
+NV_STATUS rpcAsyncWait(OBJGPU *pGpu, OBJRPC *pRpc, NvU32 sequence)
+{
+    RPC_ASYNC_TABLE *pTable = &pRpc->async;
+    RPC_ASYNC_ENTRY *pEntry = rpcAsyncTableFind(pTable, sequence);
+    rpc_message_header_v *pReply;
+    NV_STATUS status;
+
+    NV_ASSERT_OR_RETURN((pEntry != NULL) && !pEntry->bAbandoned, NV_ERR_OBJECT_NOT_FOUND);
+    NV_ASSERT_OR_RETURN(!pEntry->bDiscardReply, NV_ERR_INVALID_STATE);
+
+    while (!pEntry->bComplete)
+    {
+        pTable->waitSequence = sequence;
+        status = rpcRecvPoll(pGpu, pRpc, pEntry->function);
+        pTable->waitSequence = 0;
+
+        if (status != NV_OK)
+        {
+            NV_PRINTF(LEVEL_ERROR, "rpcRecvPoll failed with status 0x%08x for fn %d (seq %u)!\n",
+                      status, pEntry->function, sequence);
+            rpcAsyncTableAbandon(pTable, pEntry);
+            return status;
+        }
+    }
+
+    status = pEntry->status;
+    if (status == NV_OK)
+    {
+        pReply = pEntry->pReply;
+        portMemCopy(pRpc->message_buffer, pRpc->maxRpcSize, pReply, pReply->length);
+        status = _rpcCheckResult(pRpc);
+    }
+
+    rpcAsyncTableRelease(pTable, pEntry);
+
+    return status;
+}
+
+/*!
+ * Match the reply in the message buffer against the outstanding asynchronous
+ * RPCs and, if it belongs to one, move it into the completion table.
+ *
+ * @return
+ *   NV_OK                              if the reply was consumed.
+ *   NV_WARN_MORE_PROCESSING_REQUIRED   if it was consumed and rpcAsyncWait() is waiting for it.
+ *   NV_WARN_NOTHING_TO_DO              if it is an event or belongs to a synchronous RPC.
+ */
+NV_STATUS rpcAsyncCompleteReply(OBJGPU *pGpu, OBJRPC *pRpc)
+{
+    RPC_ASYNC_TABLE *pTable = &pRpc->async;
+    rpc_message_header_v *pMsgHdr = vgpu_rpc_message_header_v;
+    RPC_ASYNC_ENTRY *pEntry;
+
+    if ((pTable->usedMask == 0) || (pMsgHdr->function >= NV_VGPU_MSG_EVENT_FIRST_EVENT))
+        return NV_WARN_NOTHING_TO_DO;
+
+    pEntry = rpcAsyncTableMatchReply(pTable, pMsgHdr->sequence, pMsgHdr->function);
+    if (pEntry == NULL)
+        return NV_WARN_NOTHING_TO_DO;
+
+    if (pEntry->bAbandoned)
+    {
+        NV_PRINTF(LEVEL_WARNING, "Late reply for abandoned RPC fn %d (seq %u) dropped\n",
+                  pMsgHdr->function, pEntry->sequence);
+        rpcAsyncTableRelease(pTable, pEntry);
+        return NV_OK;
+    }
+
+    pEntry->bComplete = NV_TRUE;
+
+    _rpcProfileRecord(pRpc, pEntry->function, pEntry->submitTimeNs,
+                      pEntry->sentBytes, pMsgHdr->length);
+
+    if (pEntry->bDiscardReply)
+    {
+        if (pMsgHdr->rpc_result != NV_VGPU_MSG_RESULT_SUCCESS)
+        {
+            NV_PRINTF(LEVEL_WARNING, "Async RPC failed with status 0x%08x for fn %d (seq %u)!\n",
+                      pMsgHdr->rpc_result, pMsgHdr->function, pEntry->sequence);
+        }
+        rpcAsyncTableRelease(pTable, pEntry);
+        return NV_OK;
+    }
+
+    NV_ASSERT_OR_ELSE(pMsgHdr->length <= pRpc->maxRpcSize,
+        { pEntry->status = NV_ERR_INVALID_STATE; goto done; });
+
+    pEntry->pReply = portMemAllocNonPaged(pMsgHdr->length);
+    if (pEntry->pReply == NULL)
+    {
+        pEntry->status = NV_ERR_NO_MEMORY;
+        goto done;
+    }
+
+    portMemCopy(pEntry->pReply, pMsgHdr->length, pMsgHdr, pMsgHdr->length);
+
+done:
+    return (pEntry->sequence == pTable->waitSequence) ? NV_WARN_MORE_PROCESSING_REQUIRED : NV_OK;
+}
+
+/*!
+ * Drop all outstanding asynchronous RPCs, e.g. on RPC teardown.
+ */
+void rpcAsyncCancelAll(OBJGPU *pGpu, OBJRPC *pRpc)
+{
+    rpcAsyncTableReset(&pRpc->async);
+}
+
 static NV_STATUS _issueRpcLarge
 (
     OBJGPU *pGpu,
@@ -422,9 +767,21 @@ static NV_STATUS _issueRpcAndWaitLarge
     NvBool bBidirectional
 )
 {
-    return _issueRpcLarge(pGpu, pRpc, bufSize, pBuffer,
-                          bBidirectional,
-                          NV_TRUE);  //bWait
+    NvU32 function = ((const rpc_message_header_v *)pBuffer)->function;
+    NvU64 startTimeNs = _rpcProfileStart(pRpc);
+    NV_STATUS status;
+
+    status = _issueRpcLarge(pGpu, pRpc, bufSize, pBuffer,
+                            bBidirectional,
+                            NV_TRUE);  //bWait
+
+    if (status == NV_OK)
+    {
+        _rpcProfileRecord(pRpc, function, startTimeNs, bufSize,
+                          bBidirectional ? bufSize : vgpu_rpc_message_header_v->length);
+    }
+
+    return status;
 }
 
 static NV_STATUS _issueRpcAsyncLarge
@@ -1448,14 +1805,72 @@ void osAssertFailed(void);
 #define RPC_LOCK_DEBUG_DUMP_STACK()
 #endif
 
-NV_STATUS rpcRmApiControl_GSP
+/*!
+ * Copy the results of a GSP_RM_CONTROL reply back into the caller's params.
+ *
+ * @param[in] pSerBuffer  Start of the serialized results, if the params were serialized
+ */
+static NV_STATUS _rpcGspRmControlUnmarshal
+(
+    rpc_gsp_rm_control_v03_00 *rpc_params,
+    NvBool bSerialized,
+    NvU8 *pSerBuffer,
+    NvU32 paramsSize,
+    void *pParamStructPtr,
+    NvU32 origParamsSize
+)
+{
+    NV_STATUS status = NV_OK;
+
+    // If FINN was used to serialize the params, they must be deserialized on the way back,
+    // otherwise do a flat memcpy
+    if (bSerialized)
+    {
+        NvU8 *pRetBuffer = pSerBuffer;
+
+        // Deserialize from the second half of the RPC buffer.
+        status = FinnRmApiDeserializeUp(&pSerBuffer, paramsSize / 2,
+                                        pParamStructPtr, origParamsSize);
+        if (status != NV_OK)
+        {
+            NV_PRINTF(LEVEL_ERROR,
+                      "GspRmControl: Deserialization failed for cmd 0x%x with status %s (0x%x) at index 0x%llx\n",
+                      rpc_params->cmd, nvAssertStatusToString(status), status,
+                      (NvUPtr)(pSerBuffer - pRetBuffer));
+            return status;
+        }
+    }
+    else
+    {
+        if (paramsSize != 0)
+        {
+            portMemCopy(pParamStructPtr, paramsSize, rpc_params->params, paramsSize);
+        }
+    }
+
+    if (rpc_params->status != NV_OK)
+        status = rpc_params->status;
+
+    return status;
+}
+
+/*!
+ * Marshal an RM control into a GSP_RM_CONTROL RPC and issue it.
+ *
+ * @param[in]  bAsync     Submit without waiting. The params are not written back;
+ *                        collect the results with rpcRmApiControlAsyncWait_GSP().
+ * @param[out] pSequence  Async sequence number, or NULL to discard the reply
+ */
+static NV_STATUS _rpcRmApiControlGsp
 (
     RM_API *pRmApi,
     NvHandle hClient,
     NvHandle hObject,
     NvU32 cmd,
     void *pParamStructPtr,
-    NvU32 paramsSize
+    NvU32 paramsSize,
+    NvBool bAsync,
+    NvU32 *pSequence
 )
 {
     NV_STATUS status = NV_ERR_NOT_SUPPORTED;
@@ -1489,11 +1904,45 @@ NV_STATUS rpcRmApiControl_GSP
                 GPU_LOCK_FLAGS_SAFE_LOCK_UPGRADE, RM_LOCK_MODULES_RPC, &gpuMaskRelease));
     }
 
-    // Attempt to calculate the serialized size of the param struct using FINN.
-    serializedSize = FinnRmApiGetSerializedSize(interface_id, message_id, pParamStructPtr);
+    // Write the header assuming one record.  The length is fixed up below once
+    // paramsSize is known, and again by _issueRpcAndWaitLarge if continuation
+    // records are used.
+    NV_ASSERT_OK_OR_GOTO(status,
+        rpcWriteCommonHeader(pGpu, pRpc, NV_VGPU_MSG_FUNCTION_GSP_RM_CONTROL, sizeof(*rpc_params)),
+        done);
+
+    //
+    // Attempt to serialize the param struct straight into the RPC buffer using
+    // FINN. Only the first half of the space is offered so the return buffer
+    // always fits behind it; the serializer sizes the message as it goes, so
+    // no separate sizing pass is needed. NV_ERR_NOT_SUPPORTED means this is a
+    // flat API and paramsSize is the param struct size.
+    //
+    if (pParamStructPtr != NULL)
+    {
+        pSerBuffer = (NvU8 *)rpc_params->params;
+        status = FinnRmApiSerializeDown(interface_id, message_id, pParamStructPtr,
+                                        &pSerBuffer, message_buffer_remaining / 2);
+        if (status == NV_OK)
+        {
+            serializedSize = (NvU32)((FINN_RM_API *)rpc_params->params)->payloadSize;
+        }
+        else if (status == NV_ERR_BUFFER_TOO_SMALL)
+        {
+            // Too big for the shared buffer, serialized into a local copy below.
+            serializedSize = FinnRmApiGetSerializedSize(interface_id, message_id, pParamStructPtr);
+        }
+        else if (status != NV_ERR_NOT_SUPPORTED)
+        {
+            NV_PRINTF(LEVEL_ERROR,
+                      "GspRmControl: Serialization failed for cmd 0x%x with status %s (0x%x) at index 0x%llx\n",
+                      cmd, nvAssertStatusToString(status), status,
+                      (NvUPtr)(pSerBuffer - (NvU8 *)rpc_params->params));
+            goto done;
+        }
+        status = NV_OK;
+    }
 
-    // If successful, this is a serializable API and rpc_params->params is a serialized buffer.
-    // otherwise this is a flat API and paramsSize is the param struct size
     if (serializedSize != 0)
     {
         // Allocate twice the amount to account for the return buffer
@@ -1503,12 +1952,7 @@ NV_STATUS rpcRmApiControl_GSP
     // Initialize these values now that paramsSize is known
     rpc_params_size = sizeof(*rpc_params) + paramsSize;
     total_size = fixed_param_size + paramsSize;
-
-    // Write the header assuming one record.  If continuation records are used,
-    // then the length in the header will be overwritten by _issueRpcAndWaitLarge
-    NV_ASSERT_OK_OR_GOTO(status,
-        rpcWriteCommonHeader(pGpu, pRpc, NV_VGPU_MSG_FUNCTION_GSP_RM_CONTROL, rpc_params_size),
-        done);
+    vgpu_rpc_message_header_v->length = sizeof(rpc_message_header_v) + rpc_params_size;
 
     rpc_params->hClient    = hClient;
     rpc_params->hObject    = hObject;
@@ -1525,24 +1969,30 @@ NV_STATUS rpcRmApiControl_GSP
         message_buffer_remaining = total_size - fixed_param_size;
     }
 
-    // If this is a serializable API, attempt to serialize the param struct using FINN,
+    // Serializable APIs that did not fit are serialized into the local copy,
     // otherwise do a flat memcpy
     if (serializedSize != 0)
     {
         rpc_params->serialized = NV_TRUE;
         pSerBuffer = (NvU8 *)rpc_params->params;
 
-        // Serialize into the first half of the RPC buffer.
-        status = FinnRmApiSerializeDown(interface_id, message_id, pParamStructPtr,
-                                    &pSerBuffer, message_buffer_remaining);
-        if (status != NV_OK)
+        if (large_message_copy != NULL)
         {
-            NV_PRINTF(LEVEL_ERROR,
-                      "GspRmControl: Serialization failed for cmd 0x%x with status %s (0x%x) at index 0x%llx\n",
-                      cmd, nvAssertStatusToString(status), status,
-                      (NvUPtr)(pSerBuffer - (NvU8 *)rpc_params->params));
-            goto done;
+            // Serialize into the first half of the RPC buffer.
+            status = FinnRmApiSerializeDown(interface_id, message_id, pParamStructPtr,
+                                        &pSerBuffer, message_buffer_remaining);
+            if (status != NV_OK)
+            {
+                NV_PRINTF(LEVEL_ERROR,
+                          "GspRmControl: Serialization failed for cmd 0x%x with status %s (0x%x) at index 0x%llx\n",
+                          cmd, nvAssertStatusToString(status), status,
+                          (NvUPtr)(pSerBuffer - (NvU8 *)rpc_params->params));
+                goto done;
+            }
         }
+
+        // GSP writes the serialized results right behind the serialized request.
+        pSerBuffer = (NvU8 *)rpc_params->params + serializedSize;
     }
     else
     {
@@ -1586,7 +2036,20 @@ NV_STATUS rpcRmApiControl_GSP
     }
 
     // Issue RPC
-    if (large_message_copy)
+    if (bAsync)
+    {
+        // Continuation records cannot be interleaved with other RPCs.
+        if (large_message_copy)
+        {
+            status = NV_ERR_NOT_SUPPORTED;
+        }
+        else
+        {
+            status = rpcAsyncSubmit(pGpu, pRpc, (pSequence == NULL), pSequence);
+        }
+        goto done;
+    }
+    else if (large_message_copy)
     {
         status = _issueRpcAndWaitLarge(pGpu, pRpc, total_size, large_message_copy, NV_TRUE);
     }
@@ -1597,34 +2060,8 @@ NV_STATUS rpcRmApiControl_GSP
 
     if (status == NV_OK)
     {
-        // If FINN was used to serialize the params, they must be deserialized on the way back,
-        // otherwise do a flat memcpy
-        if (serializedSize != 0)
-        {
-            NvU8 *pRetBuffer = pSerBuffer;
-
-            // Deserialize from the second half of the RPC buffer.
-            status = FinnRmApiDeserializeUp(&pSerBuffer, paramsSize / 2,
-                                            pParamStructPtr, origParamsSize);
-            if (status != NV_OK)
-            {
-                NV_PRINTF(LEVEL_ERROR,
-                          "GspRmControl: Deserialization failed for cmd 0x%x with status %s (0x%x) at index 0x%llx\n",
-                          cmd, nvAssertStatusToString(status), status,
-                          (NvUPtr)(pSerBuffer - pRetBuffer));
-                goto done;
-            }
-        }
-        else
-        {
-            if (paramsSize != 0)
-            {
-                portMemCopy(pParamStructPtr, paramsSize, rpc_params->params, paramsSize);
-            }
-        }
-
-        if (rpc_params->status != NV_OK)
-            status = rpc_params->status;
+        status = _rpcGspRmControlUnmarshal(rpc_params, (serializedSize != 0), pSerBuffer,
+                                           paramsSize, pParamStructPtr, origParamsSize);
     }
 
     if (status != NV_OK)
@@ -1645,6 +2082,209 @@ done:
     return status;
 }
 
+NV_STATUS rpcRmApiControl_GSP
+(
+    RM_API *pRmApi,
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32 cmd,
+    void *pParamStructPtr,
+    NvU32 paramsSize
+)
+{
+    return _rpcRmApiControlGsp(pRmApi, hClient, hObject, cmd, pParamStructPtr, paramsSize,
+                               NV_FALSE, NULL);
+}
+
+/*!
+ * Queue an RM control to GSP without waiting for it to complete.
+ *
+ * Several controls may be outstanding at once; GSP works through them while
+ * the caller keeps going. The caller must hold the GPU lock across the submit
+ * and the matching rpcRmApiControlAsyncWait_GSP().
+ *
+ * @param[out] pSequence  Sequence to wait on, or NULL if the results are not
+ *                        needed (failures are then only logged).
+ *
+ * @return NV_ERR_NOT_SUPPORTED if the control is too large for a single
+ *         record; NV_ERR_BUSY_RETRY if too many RPCs are in flight. The caller
+ *         should fall back to rpcRmApiControl_GSP() in either case.
+ */
+NV_STATUS rpcRmApiControlAsync_GSP
+(
+    RM_API *pRmApi,
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32 cmd,
+    void *pParamStructPtr,
+    NvU32 paramsSize,
+    NvU32 *pSequence
+)
+{
+    OBJGPU *pGpu = (OBJGPU*)pRmApi->pPrivateContext;
+
+    NV_ASSERT_OR_RETURN(rmDeviceGpuLockIsOwner(pGpu->gpuInstance), NV_ERR_INVALID_LOCK_STATE);
+
+    return _rpcRmApiControlGsp(pRmApi, hClient, hObject, cmd, pParamStructPtr, paramsSize,
+                               NV_TRUE, pSequence);
+}
+
+/*!
+ * Wait for a control queued by rpcRmApiControlAsync_GSP() and write its
+ * results back into pParamStructPtr. Controls may be collected in any order.
+ */
+NV_STATUS rpcRmApiControlAsyncWait_GSP
+(
+    RM_API *pRmApi,
+    NvU32 sequence,
+    void *pParamStructPtr,
+    NvU32 paramsSize
+)
+{
+    NV_STATUS status;
+
+    OBJGPU *pGpu = (OBJGPU*)pRmApi->pPrivateContext;
+    OBJRPC *pRpc = GPU_GET_RPC(pGpu);
+
+    rpc_gsp_rm_control_v03_00 *rpc_params = &rpc_message->gsp_rm_control_v03_00;
+
+    NV_ASSERT_OR_RETURN(rmDeviceGpuLockIsOwner(pGpu->gpuInstance), NV_ERR_INVALID_LOCK_STATE);
+
+    status = rpcAsyncWait(pGpu, pRpc, sequence);
+    if (status == NV_OK)
+    {
+        NV_ASSERT_OR_RETURN(rpc_params->serialized || (rpc_params->paramsSize <= paramsSize),
+                            NV_ERR_BUFFER_TOO_SMALL);
+
+        // The serialized results follow the serialized request, as in the synchronous path.
+        status = _rpcGspRmControlUnmarshal(rpc_params, rpc_params->serialized,
+                                           (NvU8 *)rpc_params->params + rpc_params->paramsSize / 2,
+                                           rpc_params->paramsSize, pParamStructPtr, paramsSize);
+    }
+
+    if (status != NV_OK)
+    {
+        NV_PRINTF(LEVEL_WARNING,
+                  "GspRmControl async wait failed: seq=%u; cmd=0x%08x; status=0x%08x\n",
+                  sequence, rpc_params->cmd, status);
+    }
+
+    return status;
+}
+
+/*!
+ * Issue a batch of independent RM controls to GSP.
+ *
+ * All controls are queued before any reply is awaited, and GSP is notified
+ * once for the whole batch, so the batch costs roughly one round trip instead
+ * of one per control. Controls are executed in order. Those that cannot be
+ * pipelined (continuation records, full completion table) are issued
+ * synchronously in their place.
+ *
+ * @return NV_OK if the batch was issued. Per-control results are returned in
+ *         pEntries[i].status. If the batch could not be issued at all, the
+ *         error is returned and also stored in every pEntries[i].status.
+ */
+NV_STATUS rpcRmApiControlBatch_GSP
+(
+    RM_API *pRmApi,
+    RPC_CONTROL_BATCH_ENTRY *pEntries,
+    NvU32 numEntries
+)
+{
+    NV_STATUS status = NV_OK;
+
+    OBJGPU *pGpu = (OBJGPU*)pRmApi->pPrivateContext;
+    OBJRPC *pRpc = GPU_GET_RPC(pGpu);
+
+    NvU32 *pSequences = NULL;
+    NvU32 gpuMaskRelease = 0;
+    NvU32 i;
+
+    if (numEntries == 0)
+        return NV_OK;
+
+    NV_ASSERT_OR_RETURN(pEntries != NULL, NV_ERR_INVALID_ARGUMENT);
+
+    if (!rmDeviceGpuLockIsOwner(pGpu->gpuInstance))
+    {
+        NV_PRINTF(LEVEL_WARNING, "Calling RPC RmControl batch without adequate locks!\n");
+        RPC_LOCK_DEBUG_DUMP_STACK();
+
+        NV_ASSERT_OK_OR_GOTO(status,
+            rmGpuGroupLockAcquire(pGpu->gpuInstance, GPU_LOCK_GRP_SUBDEVICE,
+                GPU_LOCK_FLAGS_SAFE_LOCK_UPGRADE, RM_LOCK_MODULES_RPC, &gpuMaskRelease),
+            done);
+    }
+
+    pSequences = portMemAllocNonPaged(numEntries * sizeof(*pSequences));
+    if (pSequences == NULL)
+    {
+        status = NV_ERR_NO_MEMORY;
+        goto done;
+    }
+
+    pRpc->async.bDeferDoorbell = NV_TRUE;
+
+    for (i = 0; i < numEntries; i++)
+    {
+        RPC_CONTROL_BATCH_ENTRY *pEntry = &pEntries[i];
+
+        pSequences[i] = 0;
+        pEntry->status = _rpcRmApiControlGsp(pRmApi, pEntry->hClient, pEntry->hObject,
+                                             pEntry->cmd, pEntry->pParams, pEntry->paramsSize,
+                                             NV_TRUE, &pSequences[i]);
+
+        if ((pEntry->status == NV_ERR_NOT_SUPPORTED) || (pEntry->status == NV_ERR_BUSY_RETRY))
+        {
+            //
+            // Issue it in place. Sending it rings the doorbell for everything
+            // queued so far, and GSP replies in order, so ordering is preserved.
+            //
+            pRpc->async.bDeferDoorbell = NV_FALSE;
+            pEntry->status = _rpcRmApiControlGsp(pRmApi, pEntry->hClient, pEntry->hObject,
+                                                 pEntry->cmd, pEntry->pParams, pEntry->paramsSize,
+                                                 NV_FALSE, NULL);
+            pRpc->async.bDeferDoorbell = NV_TRUE;
+            pSequences[i] = 0;
+        }
+        else if (pEntry->status != NV_OK)
+        {
+            pSequences[i] = 0;
+        }
+    }
+
+    pRpc->async.bDeferDoorbell = NV_FALSE;
+
+    for (i = 0; i < numEntries; i++)
+    {
+        RPC_CONTROL_BATCH_ENTRY *pEntry = &pEntries[i];
+
+        if (pSequences[i] != 0)
+        {
+            pEntry->status = rpcRmApiControlAsyncWait_GSP(pRmApi, pSequences[i],
+                                                          pEntry->pParams, pEntry->paramsSize);
+        }
+    }
+
+done:
+    if (status != NV_OK)
+    {
+        for (i = 0; i < numEntries; i++)
+            pEntries[i].status = status;
+    }
+
+    pRpc->async.bDeferDoorbell = NV_FALSE;
+    portMemFree(pSequences);
+
+    if (gpuMaskRelease != 0)
+    {
+        rmGpuGroupLockRelease(gpuMaskRelease, GPUS_LOCK_FLAGS_NONE);
+    }
+
+    return status;
+}
+
 NV_STATUS rpcRmApiAlloc_GSP
 (
     RM_API  *pRmApi,
@@ -0,0 +1,228 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * @file
+ * @brief Completion table for asynchronous RPCs.
+ *
+ * Only the bookkeeping lives here; sending, draining the status queue and
+ * profiling stay in rpc.c.
+ */
+
+#include "vgpu/rpc_async.h"
+#include "nvport/nvport.h"
+#include "nvctassert.h"
+#include "nvmisc.h"
+
+ct_assert(RPC_ASYNC_MAX_OUTSTANDING <= 32);
+
+#define RPC_ASYNC_ALL_SLOTS ((NvU32)(NVBIT64(RPC_ASYNC_MAX_OUTSTANDING) - 1))
+
+// Whether sequence a was issued before sequence b, across wraparound.
+static NvBool
+_rpcAsyncSequenceBefore(NvU32 a, NvU32 b)
+{
+    return (NvS32)(a - b) < 0;
+}
+
+/*!
+ * Take a free entry for an RPC about to be sent and give it the next
+ * sequence number.
+ *
+ * @return NULL if RPC_ASYNC_MAX_OUTSTANDING entries are in use.
+ */
+RPC_ASYNC_ENTRY *
+rpcAsyncTableAlloc
+(
+    RPC_ASYNC_TABLE *pTable,
+    NvU32            function
+)
+{
+    RPC_ASYNC_ENTRY *pEntry;
+    NvU32 slot;
+
+    if (pTable->usedMask == RPC_ASYNC_ALL_SLOTS)
+        return NULL;
+
+    for (slot = 0; (pTable->usedMask & NVBIT32(slot)) != 0; slot++)
+        ;
+
+    // Sequence 0 marks synchronous RPCs.
+    if (++pTable->nextSequence == 0)
+        pTable->nextSequence = 1;
+
+    pEntry = &pTable->entries[slot];
+    portMemSet(pEntry, 0, sizeof(*pEntry));
+    pEntry->sequence = pTable->nextSequence;
+    pEntry->function = function;
+    pEntry->bInUse   = NV_TRUE;
+
+    pTable->usedMask |= NVBIT32(slot);
+
+    return pEntry;
+}
+
+RPC_ASYNC_ENTRY *
+rpcAsyncTableFind
+(
+    RPC_ASYNC_TABLE *pTable,
+    NvU32            sequence
+)
+{
+    NvU32 slot;
+
+    FOR_EACH_INDEX_IN_MASK(32, slot, pTable->usedMask)
+    {
+        if (pTable->entries[slot].sequence == sequence)
+            return &pTable->entries[slot];
+    }
+    FOR_EACH_INDEX_IN_MASK_END;
+
+    return NULL;
+}
+
+// Retire the tombstones issued before sequence; their replies are not coming.
+static void
+_rpcAsyncRetireTombstones(RPC_ASYNC_TABLE *pTable, NvU32 sequence)
+{
+    NvU32 slot;
+
+    FOR_EACH_INDEX_IN_MASK(32, slot, pTable->usedMask)
+    {
+        RPC_ASYNC_ENTRY *pEntry = &pTable->entries[slot];
+
+        if (pEntry->bAbandoned && _rpcAsyncSequenceBefore(pEntry->sequence, sequence))
+            rpcAsyncTableRelease(pTable, pEntry);
+    }
+    FOR_EACH_INDEX_IN_MASK_END;
+}
+
+/*!
+ * Find the entry a reply belongs to.
+ *
+ * Replies that carry a sequence are matched on it. A reply without one is for
+ * a synchronous RPC once GSP is known to echo sequences; that RPC was sent
+ * after every entry still in the table, so no tombstone will get its reply
+ * any more. Otherwise GSP serviced the command queue in order, so the reply
+ * can only belong to the oldest entry still waiting for one. Tombstones older
+ * than the match never get their reply and are retired.
+ *
+ * @return NULL if the reply does not belong to an outstanding entry.
+ */
+RPC_ASYNC_ENTRY *
+rpcAsyncTableMatchReply
+(
+    RPC_ASYNC_TABLE *pTable,
+    NvU32            sequence,
+    NvU32            function
+)
+{
+    RPC_ASYNC_ENTRY *pMatch = NULL;
+    NvU32 slot;
+
+    if (sequence != 0)
+    {
+        pTable->bSequenceEchoed = NV_TRUE;
+        pMatch = rpcAsyncTableFind(pTable, sequence);
+    }
+    else if (pTable->bSequenceEchoed)
+    {
+        _rpcAsyncRetireTombstones(pTable, pTable->nextSequence + 1);
+        return NULL;
+    }
+    else
+    {
+        FOR_EACH_INDEX_IN_MASK(32, slot, pTable->usedMask)
+        {
+            RPC_ASYNC_ENTRY *pEntry = &pTable->entries[slot];
+
+            if (!pEntry->bComplete &&
+                ((pMatch == NULL) || _rpcAsyncSequenceBefore(pEntry->sequence, pMatch->sequence)))
+            {
+                pMatch = pEntry;
+            }
+        }
+        FOR_EACH_INDEX_IN_MASK_END;
+    }
+
+    if ((pMatch == NULL) || pMatch->bComplete || (pMatch->function != function))
+        return NULL;
+
+    _rpcAsyncRetireTombstones(pTable, pMatch->sequence);
+
+    return pMatch;
+}
+
+/*!
+ * Turn an entry whose waiter gave up into a tombstone. GSP still owes the
+ * reply; the tombstone swallows it instead of it being taken for an event.
+ */
+void
+rpcAsyncTableAbandon
+(
+    RPC_ASYNC_TABLE *pTable,
+    RPC_ASYNC_ENTRY *pEntry
+)
+{
+    if (pEntry->bComplete)
+    {
+        rpcAsyncTableRelease(pTable, pEntry);
+        return;
+    }
+
+    pEntry->bAbandoned    = NV_TRUE;
+    pEntry->bDiscardReply = NV_TRUE;
+}
+
+void
+rpcAsyncTableRelease
+(
+    RPC_ASYNC_TABLE *pTable,
+    RPC_ASYNC_ENTRY *pEntry
+)
+{
+    NvU32 slot = (NvU32)(pEntry - pTable->entries);
+
+    portMemFree(pEntry->pReply);
+    portMemSet(pEntry, 0, sizeof(*pEntry));
+    pTable->usedMask &= ~NVBIT32(slot);
+}
+
+void
+rpcAsyncTableReset
+(
+    RPC_ASYNC_TABLE *pTable
+)
+{
+    NvU32 slot;
+
+    FOR_EACH_INDEX_IN_MASK(32, slot, pTable->usedMask)
+    {
+        portMemFree(pTable->entries[slot].pReply);
+    }
+    FOR_EACH_INDEX_IN_MASK_END;
+
+    portMemSet(pTable->entries, 0, sizeof(pTable->entries));
+    pTable->usedMask     = 0;
+    pTable->waitSequence = 0;
+}
@@ -33,6 +33,7 @@
 //
 NvBool nvlogRingBufferPush  (NVLOG_BUFFER *pBuffer, NvU8 *pData, NvU32 dataSize);
 NvBool nvlogNowrapBufferPush(NVLOG_BUFFER *pBuffer, NvU8 *pData, NvU32 dataSize);
+NvBool nvlogPerCpuRingBufferPush(NVLOG_BUFFER *pBuffer, NvU8 *pData, NvU32 dataSize);
 NvBool nvlogStringBufferPush(NVLOG_BUFFER *unused,  NvU8 *pData, NvU32 dataSize);
 NvBool nvlogKernelLogPush(NVLOG_BUFFER *unused, NvU8 *pData, NvU32 dataSize);
 
@@ -40,6 +41,83 @@ static void _printBase64(NvU8 *pData, NvU32 dataSize);
 static NV_STATUS _allocateNvlogBuffer(NvU32 size, NvU32 flags, NvU32 tag,
                                       NVLOG_BUFFER **ppBuffer);
 static void _deallocateNvlogBuffer(NVLOG_BUFFER *pBuffer);
+static void _nvlogRingBufferAppend(NVLOG_BUFFER *pBuffer, const NvU8 *pData, NvU32 dataSize);
+static void _nvlogPerCpuDrain(NVLOG_BUFFER *pBuffer);
+
+//
+// Staging area of NVLOG_BUFFER_FLAGS_LOCKING_PERCPU ring buffers.
+//
+// It lives in the same allocation, right after the buffer data, so it is not
+// part of NVLOG_BUFFER_SIZE() and never shows up in dumps. Each CPU has a
+// power of two sized ring with a single writer at a time: a writer claims the
+// ring of the CPU it is running on with a compare-and-swap on its busy flag,
+// and if that fails (it interrupted another writer on the same CPU, or
+// migrated) it moves on to the next ring instead of waiting. The record is
+// published by moving the head past it, so everything before the head is
+// complete. Records are only consumed under the main lock, by
+// _nvlogPerCpuDrain(), which merges the rings into the buffer data.
+//
+#define NVLOG_PERCPU_RECORD_ALIGN       8
+#define NVLOG_PERCPU_RING_SIZE_MIN      0x100
+#define NVLOG_PERCPU_RING_SIZE_MAX      0x1000
+
+typedef struct NVLOG_PERCPU_RECORD_HEADER
+{
+    /** Payload size in bytes, the payload follows the header */
+    NvU32          size;
+    /** Order in which records were completed, shared by all CPUs */
+    NvU32          seq;
+} NVLOG_PERCPU_RECORD_HEADER;
+
+#define NVLOG_PERCPU_RECORD_SIZE(dataSize)                                     \
+    (sizeof(NVLOG_PERCPU_RECORD_HEADER) +                                      \
+     NV_ALIGN_UP((dataSize), NVLOG_PERCPU_RECORD_ALIGN))
+
+typedef struct NVLOG_PERCPU_RING
+{
+    /** Free running offset past the newest record, only moved by writers */
+    volatile NvU32 head;
+    /** Free running offset of the oldest record, only moved by the drain */
+    volatile NvU32 tail;
+    /** Nonzero while a writer owns the ring */
+    volatile NvU32 busy;
+    /** Head when the current drain started, only used by the drain */
+    NvU32          drainHead;
+    /** Keep the counters of each CPU on their own cache line */
+    NvU8           padding[48];
+} NVLOG_PERCPU_RING;
+
+typedef struct NVLOG_PERCPU_STAGING
+{
+    /** Last sequence number handed out to a writer */
+    volatile NvU32 lastSeq;
+    NvU32          cpuCount;
+    NvU32          ringSize;
+    NvU8           padding[52];
+} NVLOG_PERCPU_STAGING;
+
+#define NVLOG_PERCPU_SEQ_BEFORE(a, b)   (((NvS32)((a) - (b))) < 0)
+
+static NV_INLINE NVLOG_PERCPU_STAGING *
+_nvlogPerCpuStaging(NVLOG_BUFFER *pBuffer)
+{
+    return (NVLOG_PERCPU_STAGING *)
+        &pBuffer->data[NV_ALIGN_UP(pBuffer->size, NVLOG_PERCPU_RECORD_ALIGN)];
+}
+
+static NV_INLINE NVLOG_PERCPU_RING *
+_nvlogPerCpuRing(NVLOG_PERCPU_STAGING *pStaging, NvU32 cpu)
+{
+    NvU32 stride = sizeof(NVLOG_PERCPU_RING) + pStaging->ringSize;
+
+    return (NVLOG_PERCPU_RING *)((NvU8 *)(pStaging + 1) + (NvLength)cpu * stride);
+}
+
+static NV_INLINE NvU8 *
+_nvlogPerCpuRingData(NVLOG_PERCPU_RING *pRing)
+{
+    return (NvU8 *)(pRing + 1);
+}
 
 volatile NvU32 nvlogInitCount;
 static void *nvlogRegRoot;
@@ -127,6 +205,9 @@ _allocateNvlogBuffer
 {
     NVLOG_BUFFER          *pBuffer;
     NVLOG_BUFFER_PUSHFUNC  pushfunc;
+    NvU32                  allocSize;
+    NvU32                  cpuCount = 0;
+    NvU32                  ringSize = 0;
 
     // Sanity check on some invalid combos:
     if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _EXPANDABLE, _YES, flags))
@@ -138,6 +219,12 @@ _allocateNvlogBuffer
         if (!FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _LOCKING, _FULL, flags))
             return NV_ERR_INVALID_ARGUMENT;
     }
+    if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _LOCKING, _PERCPU, flags))
+    {
+        // Only ring buffers can be staged per CPU
+        if (!FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _TYPE, _RING, flags))
+            return NV_ERR_INVALID_ARGUMENT;
+    }
 
     if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _TYPE, _SYSTEMLOG, flags))
     {
@@ -149,7 +236,21 @@ _allocateNvlogBuffer
     {
         NV_ASSERT_OR_RETURN(size > 0, NV_ERR_INVALID_ARGUMENT);
 
-        if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _TYPE, _RING, flags))
+        if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _TYPE, _RING, flags) &&
+            FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _LOCKING, _PERCPU, flags))
+        {
+            pushfunc = (NVLOG_BUFFER_PUSHFUNC) nvlogPerCpuRingBufferPush;
+
+            //
+            // CPU rings are a power of two in size, and no larger than the
+            // buffer itself unless that is tiny.
+            //
+            cpuCount = NV_MAX(osGetCpuCount(), 1);
+            ringSize = NVLOG_PERCPU_RING_SIZE_MAX;
+            while ((ringSize > NVLOG_PERCPU_RING_SIZE_MIN) && (ringSize > size))
+                ringSize >>= 1;
+        }
+        else if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _TYPE, _RING, flags))
         {
             pushfunc = (NVLOG_BUFFER_PUSHFUNC) nvlogRingBufferPush;
         }
@@ -163,15 +264,23 @@ _allocateNvlogBuffer
         }
     }
 
+    allocSize = sizeof(*pBuffer) + size;
+    if (cpuCount != 0)
+    {
+        allocSize = sizeof(*pBuffer) + NV_ALIGN_UP(size, NVLOG_PERCPU_RECORD_ALIGN) +
+                    sizeof(NVLOG_PERCPU_STAGING) +
+                    cpuCount * (sizeof(NVLOG_PERCPU_RING) + ringSize);
+    }
+
     if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _NONPAGED, _YES, flags))
-        pBuffer = portMemAllocNonPaged(sizeof(*pBuffer) + size);
+        pBuffer = portMemAllocNonPaged(allocSize);
     else
-        pBuffer = portMemAllocPaged(sizeof(*pBuffer) + size);
+        pBuffer = portMemAllocPaged(allocSize);
 
     if (!pBuffer)
         return NV_ERR_NO_MEMORY;
 
-    portMemSet(pBuffer, 0, sizeof(*pBuffer) + size);
+    portMemSet(pBuffer, 0, allocSize);
     if (FLD_TEST_DRF(LOG_BUFFER, _FLAGS, _OCA, _YES, flags))
     {
         osAddRecordForCrashLog(pBuffer, NV_OFFSETOF(NVLOG_BUFFER, data) + size);
@@ -182,6 +291,14 @@ _allocateNvlogBuffer
     pBuffer->flags    = flags;
     pBuffer->tag      = tag;
 
+    if (cpuCount != 0)
+    {
+        NVLOG_PERCPU_STAGING *pStaging = _nvlogPerCpuStaging(pBuffer);
+
+        pStaging->cpuCount = cpuCount;
+        pStaging->ringSize = ringSize;
+    }
+
     *ppBuffer = pBuffer;
 
     return NV_OK;
@@ -342,6 +459,8 @@ nvlogExtractBufferChunk
     *pChunkSize = NV_MIN(*pChunkSize, (pBuffer->size - index));
 
     portSyncSpinlockAcquire(NvLogLogger.mainLock);
+    if ((chunkNum == 0) && NVLOG_IS_PERCPU_BUFFER(pBuffer))
+        _nvlogPerCpuDrain(pBuffer);
     portMemCopy(pDest, *pChunkSize, &pBuffer->data[index], *pChunkSize);
     portSyncSpinlockRelease(NvLogLogger.mainLock);
 
@@ -416,6 +535,14 @@ nvlogPauseLoggingToBuffer
         ? FLD_SET_DRF(LOG, _BUFFER_FLAGS, _DISABLED, _YES, pBuffer->flags)
         : FLD_SET_DRF(LOG, _BUFFER_FLAGS, _DISABLED, _NO,  pBuffer->flags);
 
+    // Readers pause the buffer first, so hand them everything staged so far.
+    if (bPause && NVLOG_IS_PERCPU_BUFFER(pBuffer))
+    {
+        portSyncSpinlockAcquire(NvLogLogger.mainLock);
+        _nvlogPerCpuDrain(pBuffer);
+        portSyncSpinlockRelease(NvLogLogger.mainLock);
+    }
+
     return NV_OK;
 }
 
@@ -475,6 +602,8 @@ nvlogGetBufferSnapshot
                         NV_ERR_BUFFER_TOO_SMALL);
 
     portSyncSpinlockAcquire(NvLogLogger.mainLock);
+    if (NVLOG_IS_PERCPU_BUFFER(pBuffer))
+        _nvlogPerCpuDrain(pBuffer);
     portMemCopy(pDest, NVLOG_BUFFER_SIZE(pBuffer), pBuffer, NVLOG_BUFFER_SIZE(pBuffer));
     portSyncSpinlockRelease(NvLogLogger.mainLock);
 
@@ -612,6 +741,216 @@ nvlogNowrapBufferPush
     return NV_TRUE;
 }
 
+//
+// Appends to a ring buffer with the main lock held.
+//
+static void
+_nvlogRingBufferAppend
+(
+    NVLOG_BUFFER *pBuffer,
+    const NvU8   *pData,
+    NvU32         dataSize
+)
+{
+    NvU32 writeSize;
+    NvU32 oldPos = pBuffer->pos;
+
+    pBuffer->extra.ring.overflow += (pBuffer->pos + dataSize) / pBuffer->size;
+    pBuffer->pos                  = (pBuffer->pos + dataSize) % pBuffer->size;
+
+    while (dataSize > 0)
+    {
+        writeSize = NV_MIN(pBuffer->size - oldPos, dataSize);
+        portMemCopy(&pBuffer->data[oldPos], writeSize, pData, writeSize);
+        oldPos = 0;
+        dataSize -= writeSize;
+        pData    += writeSize;
+    }
+}
+
+//
+// Moves staged records out of the per-CPU rings and into the buffer data, in
+// sequence number order. Must be called with the main lock held.
+//
+// Each ring is already in sequence order, so this is a merge of the oldest
+// records of all rings. Sequence numbers are taken when a write completes,
+// so a record that was complete before another one was started is always
+// merged first, including all records of a given thread.
+//
+static void
+_nvlogPerCpuDrain
+(
+    NVLOG_BUFFER *pBuffer
+)
+{
+    NVLOG_PERCPU_STAGING       *pStaging = _nvlogPerCpuStaging(pBuffer);
+    NvU32                       ringMask = pStaging->ringSize - 1;
+    NvU32                       lastSeq;
+    NVLOG_PERCPU_RECORD_HEADER *pHeader;
+    NVLOG_PERCPU_RECORD_HEADER *pOldestHeader;
+    NVLOG_PERCPU_RING          *pRing;
+    NVLOG_PERCPU_RING          *pOldest;
+    NvU8                       *pRingData;
+    NvU32                       offset;
+    NvU32                       chunk;
+    NvU32                       cpu;
+
+    //
+    // Records completed after this point are left for the next drain. Any
+    // record completed before one numbered at or before lastSeq was started
+    // is within the heads read below.
+    //
+    lastSeq = pStaging->lastSeq;
+    portAtomicMemoryFenceLoad();
+
+    for (cpu = 0; cpu < pStaging->cpuCount; cpu++)
+    {
+        pRing            = _nvlogPerCpuRing(pStaging, cpu);
+        pRing->drainHead = pRing->head;
+    }
+
+    // Don't read any record before the heads that cover it.
+    portAtomicMemoryFenceLoad();
+
+    for (;;)
+    {
+        pOldest       = NULL;
+        pOldestHeader = NULL;
+
+        for (cpu = 0; cpu < pStaging->cpuCount; cpu++)
+        {
+            pRing = _nvlogPerCpuRing(pStaging, cpu);
+            if (pRing->tail == pRing->drainHead)
+                continue;
+
+            pHeader = (NVLOG_PERCPU_RECORD_HEADER *)
+                &_nvlogPerCpuRingData(pRing)[pRing->tail & ringMask];
+
+            if (NVLOG_PERCPU_SEQ_BEFORE(lastSeq, pHeader->seq))
+                continue;
+
+            if ((pOldestHeader == NULL) ||
+                NVLOG_PERCPU_SEQ_BEFORE(pHeader->seq, pOldestHeader->seq))
+            {
+                pOldest       = pRing;
+                pOldestHeader = pHeader;
+            }
+        }
+
+        if (pOldest == NULL)
+            break;
+
+        // The payload may wrap around the end of the ring.
+        pRingData = _nvlogPerCpuRingData(pOldest);
+        offset    = (pOldest->tail + sizeof(*pOldestHeader)) & ringMask;
+        chunk     = NV_MIN(pOldestHeader->size, pStaging->ringSize - offset);
+        _nvlogRingBufferAppend(pBuffer, &pRingData[offset], chunk);
+        _nvlogRingBufferAppend(pBuffer, pRingData, pOldestHeader->size - chunk);
+
+        // Hand the space back only once the record has been copied out.
+        portAtomicMemoryFenceFull();
+        pOldest->tail = pOldest->tail + NVLOG_PERCPU_RECORD_SIZE(pOldestHeader->size);
+    }
+}
+
+//
+// Stages a record without taking any lock, in the ring of the current CPU or,
+// if that one is busy or full, the next one that is not. Returns NV_FALSE if
+// no ring had room for it.
+//
+static NvBool
+_nvlogPerCpuStage
+(
+    NVLOG_PERCPU_STAGING *pStaging,
+    NvU8                 *pData,
+    NvU32                 dataSize
+)
+{
+    NvU32                       ringMask   = pStaging->ringSize - 1;
+    NvU32                       recordSize = NVLOG_PERCPU_RECORD_SIZE(dataSize);
+    NVLOG_PERCPU_RECORD_HEADER *pHeader;
+    NVLOG_PERCPU_RING          *pRing;
+    NvU8                       *pRingData;
+    NvU32                       head;
+    NvU32                       offset;
+    NvU32                       chunk;
+    NvU32                       cpu;
+    NvU32                       i;
+
+    // The CPU number is only a hint, the thread may migrate right after.
+    cpu = osGetCurrentProcessorNumber();
+
+    for (i = 0; i < pStaging->cpuCount; i++)
+    {
+        pRing = _nvlogPerCpuRing(pStaging, (cpu + i) % pStaging->cpuCount);
+
+        if (!portAtomicCompareAndSwapU32(&pRing->busy, 1, 0))
+            continue;
+
+        head = pRing->head;
+        if (head + recordSize - pRing->tail > pStaging->ringSize)
+        {
+            portAtomicSetU32(&pRing->busy, 0);
+            continue;
+        }
+
+        pRingData = _nvlogPerCpuRingData(pRing);
+        pHeader   = (NVLOG_PERCPU_RECORD_HEADER *)&pRingData[head & ringMask];
+
+        offset = (head + sizeof(*pHeader)) & ringMask;
+        chunk  = NV_MIN(dataSize, pStaging->ringSize - offset);
+        portMemCopy(&pRingData[offset], chunk, pData, chunk);
+        portMemCopy(pRingData, dataSize - chunk, pData + chunk, dataSize - chunk);
+
+        pHeader->size = dataSize;
+        pHeader->seq  = portAtomicIncrementU32(&pStaging->lastSeq);
+
+        // Publish the record only once its contents are visible.
+        portAtomicMemoryFenceStore();
+        pRing->head = head + recordSize;
+        portAtomicSetU32(&pRing->busy, 0);
+
+        return NV_TRUE;
+    }
+
+    return NV_FALSE;
+}
+
+NvBool
+nvlogPerCpuRingBufferPush
+(
+    NVLOG_BUFFER *pBuffer,
+    NvU8         *pData,
+    NvU32         dataSize
+)
+{
+    NVLOG_PERCPU_STAGING *pStaging = _nvlogPerCpuStaging(pBuffer);
+    NvBool                bFits    = (NVLOG_PERCPU_RECORD_SIZE(dataSize) <= pStaging->ringSize);
+
+    if (bFits && _nvlogPerCpuStage(pStaging, pData, dataSize))
+        return NV_TRUE;
+
+    //
+    // Every ring is busy or full, or the record can never fit in one. Make
+    // room by draining what has been staged so far, which includes everything
+    // completed before this call, then write this record directly if there is
+    // still no room.
+    //
+    // A record written directly takes no sequence number, but it still keeps
+    // the merge order: the drain under the lock has already placed every
+    // record that completed before this call started, and any record still
+    // staged completed after the drain began, so it overlapped this call and
+    // may land on either side of it.
+    //
+    portSyncSpinlockAcquire(NvLogLogger.mainLock);
+    _nvlogPerCpuDrain(pBuffer);
+    if (!bFits || !_nvlogPerCpuStage(pStaging, pData, dataSize))
+        _nvlogRingBufferAppend(pBuffer, pData, dataSize);
+    portSyncSpinlockRelease(NvLogLogger.mainLock);
+
+    return NV_TRUE;
+}
+
 NvBool
 nvlogStringBufferPush
 (
@@ -687,6 +1026,13 @@ void nvlogDumpToKernelLog(NvBool bDumpUnchangedBuffersOnlyOnce)
 
         if (pBuf && pBuf->size)
         {
+            if (NVLOG_IS_PERCPU_BUFFER(pBuf))
+            {
+                portSyncSpinlockAcquire(NvLogLogger.mainLock);
+                _nvlogPerCpuDrain(pBuf);
+                portSyncSpinlockRelease(NvLogLogger.mainLock);
+            }
+
             if (bDumpUnchangedBuffersOnlyOnce)
             {
                 NvU32 pos = pBuf->pos + (pBuf->size * pBuf->extra.ring.overflow);
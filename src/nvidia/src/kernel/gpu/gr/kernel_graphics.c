@@ -44,6 +44,7 @@
 
 #include "vgpu/vgpu_events.h"
 #include "vgpu/rpc.h"
+#include "gpu/gsp/kernel_gsp.h"
 
 #include "class/clb0c0.h"
 #include "class/clb1c0.h"
@@ -718,6 +719,68 @@ cleanup:
     return status;
 }
 
+//
+// Static info controls issued by kgraphicsLoadStaticInfo_KERNEL, in issue order.
+//
+enum
+{
+    KGRAPHICS_STATIC_INFO_CAPS,
+    KGRAPHICS_STATIC_INFO_INFO,
+    KGRAPHICS_STATIC_INFO_FLOORSWEEPING_MASKS,
+    KGRAPHICS_STATIC_INFO_GLOBAL_SM_ORDER,
+    KGRAPHICS_STATIC_INFO_PPC_MASKS,
+    KGRAPHICS_STATIC_INFO_ZCULL_INFO,
+    KGRAPHICS_STATIC_INFO_ROP_INFO,
+    KGRAPHICS_STATIC_INFO_SM_ISSUE_RATE_MODIFIER,
+    KGRAPHICS_STATIC_INFO_FECS_RECORD_SIZE,
+    KGRAPHICS_STATIC_INFO_FECS_TRACE_DEFINES,
+    KGRAPHICS_STATIC_INFO_PDB_PROPERTIES,
+    KGRAPHICS_STATIC_INFO_COUNT
+};
+
+/*!
+ * Issue the static info controls, filling in each entry's status.
+ *
+ * On GSP clients these controls are all routed to GSP, so they are sent as one
+ * batch rather than paying a round trip each.
+ *
+ * @return an error if the controls could not be issued at all
+ */
+static NV_STATUS
+_kgraphicsIssueStaticInfoControls
+(
+    OBJGPU *pGpu,
+    RM_API *pRmApi,
+    RPC_CONTROL_BATCH_ENTRY *pBatch,
+    NvU32 numControls
+)
+{
+    NvU32 i;
+
+    // Entries that are never issued must not read as successful.
+    for (i = 0; i < numControls; i++)
+        pBatch[i].status = NV_ERR_INVALID_STATE;
+
+    if (IS_GSP_CLIENT(pGpu))
+    {
+        RM_API *pPhysicalRmApi = GPU_GET_PHYSICAL_RMAPI(pGpu);
+
+        return rpcRmApiControlBatch_GSP(pPhysicalRmApi, pBatch, numControls);
+    }
+
+    for (i = 0; i < numControls; i++)
+    {
+        pBatch[i].status = pRmApi->Control(pRmApi,
+                                           pBatch[i].hClient,
+                                           pBatch[i].hObject,
+                                           pBatch[i].cmd,
+                                           pBatch[i].pParams,
+                                           pBatch[i].paramsSize);
+    }
+
+    return NV_OK;
+}
+
 NV_STATUS
 kgraphicsLoadStaticInfo_KERNEL
 (
@@ -734,7 +797,7 @@ kgraphicsLoadStaticInfo_KERNEL
     NvU32 grIdx = pKernelGraphics->instance;
     NV_STATUS status = NV_OK;
     NvBool bBcState = gpumgrGetBcEnabledStatus(pGpu);
-    union
+    struct
     {
         NV2080_CTRL_INTERNAL_STATIC_GR_GET_CAPS_PARAMS                   caps;
         NV2080_CTRL_INTERNAL_STATIC_GR_GET_INFO_PARAMS                   info;
@@ -748,6 +811,8 @@ kgraphicsLoadStaticInfo_KERNEL
         NV2080_CTRL_INTERNAL_STATIC_GR_GET_FECS_TRACE_DEFINES_PARAMS     fecsTraceDefines;
         NV2080_CTRL_INTERNAL_STATIC_GR_GET_PDB_PROPERTIES_PARAMS         pdbProperties;
     } *pParams = NULL;
+    RPC_CONTROL_BATCH_ENTRY batch[KGRAPHICS_STATIC_INFO_COUNT];
+    NvU32 numControls;
 
     NV_ASSERT_OR_RETURN(pPrivate != NULL, NV_ERR_INVALID_STATE);
 
@@ -769,6 +834,7 @@ kgraphicsLoadStaticInfo_KERNEL
         status = NV_ERR_NO_MEMORY;
         goto cleanup;
     }
+    portMemSet(pParams, 0, sizeof(*pParams));
 
     if (IS_MIG_IN_USE(pGpu))
     {
@@ -792,30 +858,64 @@ kgraphicsLoadStaticInfo_KERNEL
         grIdx = NV2080_ENGINE_TYPE_GR_IDX(localEngineType);
     }
 
+    //
+    // The static info controls are independent of each other, so issue them
+    // all up front. Only CAPS, INFO and floorsweeping masks are used on AMODEL.
+    //
+#define KGRAPHICS_STATIC_INFO_CONTROL(idx, ctrlCmd, member)                 \
+    do {                                                                    \
+        batch[idx].hClient    = hClient;                                    \
+        batch[idx].hObject    = hSubdevice;                                 \
+        batch[idx].cmd        = ctrlCmd;                                    \
+        batch[idx].pParams    = &pParams->member;                           \
+        batch[idx].paramsSize = sizeof(pParams->member);                    \
+    } while (0)
+
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_CAPS,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_CAPS, caps);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_INFO,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_INFO, info);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_FLOORSWEEPING_MASKS,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_FLOORSWEEPING_MASKS, floorsweepingMasks);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_GLOBAL_SM_ORDER,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_GLOBAL_SM_ORDER, globalSmOrder);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_PPC_MASKS,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_PPC_MASKS, ppcMasks);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_ZCULL_INFO,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_ZCULL_INFO, zcullInfo);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_ROP_INFO,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_ROP_INFO, ropInfo);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_SM_ISSUE_RATE_MODIFIER,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_SM_ISSUE_RATE_MODIFIER, smIssueRateModifier);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_FECS_RECORD_SIZE,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_FECS_RECORD_SIZE, fecsRecordSize);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_FECS_TRACE_DEFINES,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_FECS_TRACE_DEFINES, fecsTraceDefines);
+    KGRAPHICS_STATIC_INFO_CONTROL(KGRAPHICS_STATIC_INFO_PDB_PROPERTIES,
+        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_PDB_PROPERTIES, pdbProperties);
+
+#undef KGRAPHICS_STATIC_INFO_CONTROL
+
+    numControls = IS_MODS_AMODEL(pGpu) ? (KGRAPHICS_STATIC_INFO_FLOORSWEEPING_MASKS + 1) :
+                                         KGRAPHICS_STATIC_INFO_COUNT;
+    NV_CHECK_OK_OR_GOTO(
+        status,
+        LEVEL_ERROR,
+        _kgraphicsIssueStaticInfoControls(pGpu, pRmApi, batch, numControls),
+        cleanup);
+
     // GR Caps
-    portMemSet(pParams, 0, sizeof(*pParams));
     NV_CHECK_OK_OR_GOTO(
         status,
         LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        hClient,
-                        hSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_CAPS,
-                        pParams,
-                        sizeof(pParams->caps)),
+        batch[KGRAPHICS_STATIC_INFO_CAPS].status,
         cleanup);
 
     portMemCopy(&pPrivate->staticInfo.grCaps, sizeof(pPrivate->staticInfo.grCaps),
                 &pParams->caps.engineCaps[grIdx], sizeof(pParams->caps.engineCaps[grIdx]));
 
     // GR Info
-    portMemSet(pParams, 0, sizeof(*pParams));
-    status = pRmApi->Control(pRmApi,
-                             hClient,
-                             hSubdevice,
-                             NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_INFO,
-                             pParams,
-                             sizeof(pParams->info));
+    status = batch[KGRAPHICS_STATIC_INFO_INFO].status;
 
     if (status == NV_OK)
     {
@@ -834,16 +934,10 @@ kgraphicsLoadStaticInfo_KERNEL
     }
 
     // Floorsweeping masks
-    portMemSet(pParams, 0, sizeof(*pParams));
     NV_CHECK_OK_OR_GOTO(
         status,
         LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        hClient,
-                        hSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_FLOORSWEEPING_MASKS,
-                        pParams,
-                        sizeof(pParams->floorsweepingMasks)),
+        batch[KGRAPHICS_STATIC_INFO_FLOORSWEEPING_MASKS].status,
         cleanup);
 
     portMemCopy(&pPrivate->staticInfo.floorsweepingMasks, sizeof(pPrivate->staticInfo.floorsweepingMasks),
@@ -868,27 +962,15 @@ kgraphicsLoadStaticInfo_KERNEL
     }
 
     // GR Global SM Order
-    portMemSet(pParams, 0, sizeof(*pParams));
     NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        hClient,
-                        hSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_GLOBAL_SM_ORDER,
-                        pParams,
-                        sizeof(pParams->globalSmOrder)),
+        batch[KGRAPHICS_STATIC_INFO_GLOBAL_SM_ORDER].status,
         cleanup);
 
     portMemCopy(&pPrivate->staticInfo.globalSmOrder, sizeof(pPrivate->staticInfo.globalSmOrder),
                 &pParams->globalSmOrder.globalSmOrder[grIdx], sizeof(pParams->globalSmOrder.globalSmOrder[grIdx]));
 
     // PPC Mask
-    portMemSet(pParams, 0, sizeof(*pParams));
-    status = pRmApi->Control(pRmApi,
-                             hClient,
-                             hSubdevice,
-                             NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_PPC_MASKS,
-                             pParams,
-                             sizeof(pParams->ppcMasks));
+    status = batch[KGRAPHICS_STATIC_INFO_PPC_MASKS].status;
 
     if (status == NV_OK)
     {
@@ -911,13 +993,7 @@ kgraphicsLoadStaticInfo_KERNEL
         status = NV_OK;
     }
 
-    portMemSet(pParams, 0, sizeof(*pParams));
-    status = pRmApi->Control(pRmApi,
-                             hClient,
-                             hSubdevice,
-                             NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_ZCULL_INFO,
-                             pParams,
-                             sizeof(pParams->zcullInfo));
+    status = batch[KGRAPHICS_STATIC_INFO_ZCULL_INFO].status;
 
     if (status == NV_OK)
     {
@@ -941,13 +1017,7 @@ kgraphicsLoadStaticInfo_KERNEL
     }
 
     // ROP Info
-    portMemSet(pParams, 0, sizeof(*pParams));
-    status = pRmApi->Control(pRmApi,
-                             hClient,
-                             hSubdevice,
-                             NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_ROP_INFO,
-                             pParams,
-                             sizeof(pParams->ropInfo));
+    status = batch[KGRAPHICS_STATIC_INFO_ROP_INFO].status;
 
     if (status == NV_OK)
     {
@@ -971,13 +1041,7 @@ kgraphicsLoadStaticInfo_KERNEL
     }
 
     // SM Issue Rate Modifier
-    portMemSet(pParams, 0, sizeof(*pParams));
-    status = pRmApi->Control(pRmApi,
-                             hClient,
-                             hSubdevice,
-                             NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_SM_ISSUE_RATE_MODIFIER,
-                             pParams,
-                             sizeof(pParams->smIssueRateModifier));
+    status = batch[KGRAPHICS_STATIC_INFO_SM_ISSUE_RATE_MODIFIER].status;
 
     if (status == NV_OK)
     {
@@ -997,26 +1061,14 @@ kgraphicsLoadStaticInfo_KERNEL
     }
 
     // FECS Record Size
-    portMemSet(pParams, 0, sizeof(*pParams));
     NV_CHECK_OK_OR_GOTO(status, LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        hClient,
-                        hSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_FECS_RECORD_SIZE,
-                        pParams,
-                        sizeof(pParams->fecsRecordSize)),
+        batch[KGRAPHICS_STATIC_INFO_FECS_RECORD_SIZE].status,
         cleanup);
 
     pPrivate->staticInfo.fecsRecordSize.fecsRecordSize = pParams->fecsRecordSize.fecsRecordSize[grIdx].fecsRecordSize;
 
     // FECS Trace Defines
-    portMemSet(pParams, 0, sizeof(*pParams));
-    status = pRmApi->Control(pRmApi,
-                        hClient,
-                        hSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_FECS_TRACE_DEFINES,
-                        pParams,
-                        sizeof(pParams->fecsTraceDefines));
+    status = batch[KGRAPHICS_STATIC_INFO_FECS_TRACE_DEFINES].status;
     if (status == NV_OK)
     {
         pPrivate->staticInfo.pFecsTraceDefines = portMemAllocNonPaged(sizeof(*pPrivate->staticInfo.pFecsTraceDefines));
@@ -1034,16 +1086,10 @@ kgraphicsLoadStaticInfo_KERNEL
     }
 
     // PDB Properties
-    portMemSet(pParams, 0, sizeof(*pParams));
     NV_CHECK_OK_OR_GOTO(
         status,
         LEVEL_ERROR,
-        pRmApi->Control(pRmApi,
-                        hClient,
-                        hSubdevice,
-                        NV2080_CTRL_CMD_INTERNAL_STATIC_KGR_GET_PDB_PROPERTIES,
-                        pParams,
-                        sizeof(pParams->pdbProperties)),
+        batch[KGRAPHICS_STATIC_INFO_PDB_PROPERTIES].status,
         cleanup);
 
     portMemCopy(&pPrivate->staticInfo.pdbTable, sizeof(pPrivate->staticInfo.pdbTable),
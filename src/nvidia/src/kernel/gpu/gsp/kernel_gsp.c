@@ -37,6 +37,7 @@
 
 #include "logdecode.h"
 #include "nverror.h"
+#include "nvrm_registry.h"
 #include "nvtypes.h"
 #include "objrpc.h"
 #include "objtmr.h"
@@ -103,6 +104,22 @@ static NV_STATUS _kgspGetAndClearSignatureFromBinary(OBJGPU *pGpu, KernelGsp *pK
 static NV_STATUS _kgspCreateRadix3(OBJGPU *pGpu, MEMORY_DESCRIPTOR **ppMemdescRadix3,
                                    MEMORY_DESCRIPTOR *pMemdescData, const void *pData, NvU64 size);
 
+/*!
+ * Notify GSP of new commands in the command queue.
+ */
+static void
+_kgspRpcRingDoorbell
+(
+    OBJGPU    *pGpu,
+    KernelGsp *pKernelGsp,
+    OBJRPC    *pRpc
+)
+{
+    // GSPRM TODO: Use this call to pass the actual index.
+    kgspSetCmdQueueHead_HAL(pGpu, pKernelGsp, 0, 0);
+    pRpc->async.bDoorbellPending = NV_FALSE;
+}
+
 /*!
  * GSP client RM RPC send routine
  */
@@ -125,8 +142,19 @@ _kgspRpcSendMessage
         return nvStatus;
     }
 
-    // GSPRM TODO: Use this call to pass the actual index.
-    kgspSetCmdQueueHead_HAL(pGpu, pKernelGsp, 0, 0);
+    //
+    // While a batch is being queued, GSP is notified once for the whole batch
+    // (by the first poll), unless the queue may not fit another full command.
+    //
+    if (pRpc->async.bDeferDoorbell &&
+        (msgqTxGetFreeSpace(pRpc->pMessageQueueInfo->hQueue) >=
+         GSP_MSG_QUEUE_BYTES_TO_ELEMENTS(GSP_MSG_QUEUE_ELEMENT_SIZE_MAX)))
+    {
+        pRpc->async.bDoorbellPending = NV_TRUE;
+        return NV_OK;
+    }
+
+    _kgspRpcRingDoorbell(pGpu, pKernelGsp, pRpc);
 
     return NV_OK;
 }
@@ -658,10 +686,13 @@ _kgspProcessRpcEvent
  * Handle a single RPC event from GSP unless the event is [an RPC return for] expectedFunc,
  * or there are no events available in the buffer.
  *
+ * Returns for outstanding asynchronous RPCs are moved to the completion table first.
+ *
  * @return
  *   NV_OK                              if the event is successfully handled.
  *   NV_WARN_NOTHING_TO_DO              if there are no events available.
  *   NV_WARN_MORE_PROCESSING_REQUIRED   if the event is expectedFunc: it is unhandled and in the staging area.
+ *                                        Also returned once the reply rpcAsyncWait() is polling for is parked.
  *   (Another status)                   if event reading or processing fails.
  */
 static NV_STATUS
@@ -684,6 +715,12 @@ _kgspRpcDrainOneEvent
     if (nvStatus == NV_OK)
     {
         rpc_message_header_v *pMsgHdr = RPC_HDR;
+
+        // Replies to asynchronous RPCs are parked in the completion table.
+        nvStatus = rpcAsyncCompleteReply(pGpu, pRpc);
+        if (nvStatus != NV_WARN_NOTHING_TO_DO)
+            return nvStatus;
+
         if (pMsgHdr->function == expectedFunc)
             return NV_WARN_MORE_PROCESSING_REQUIRED;
 
@@ -839,6 +876,9 @@ _kgspRpcRecvPoll
     NV_ASSERT(rmDeviceGpuLockIsOwner(pGpu->gpuInstance));
     gpuSetTimeout(pGpu, timeoutUs, &timeout, 0);
 
+    if (pRpc->async.bDoorbellPending)
+        _kgspRpcRingDoorbell(pGpu, pKernelGsp, pRpc);
+
     for (;;)
     {
         nvStatus = _kgspRpcDrainEvents(pGpu, pKernelGsp, expectedFunc);
@@ -883,6 +923,7 @@ _kgspInitRpcInfrastructure
 )
 {
     NV_STATUS nvStatus = NV_OK;
+    NvU32 data;
 
     pKernelGsp->pRpc = initRpcObject(pGpu);
     if (pKernelGsp->pRpc == NULL)
@@ -915,6 +956,13 @@ _kgspInitRpcInfrastructure
     rpcSendMessage_FNPTR(pKernelGsp->pRpc) = _kgspRpcSendMessage;
     rpcRecvPoll_FNPTR(pKernelGsp->pRpc)    = _kgspRpcRecvPoll;
 
+    // Profiling is diagnostic only; carry on without it if it cannot be set up.
+    if ((osReadRegistryDword(pGpu, NV_REG_STR_RM_RPC_PROFILE, &data) == NV_OK) &&
+        (data == NV_REG_STR_RM_RPC_PROFILE_ENABLE))
+    {
+        NV_ASSERT_OK(rpcProfileEnable(pGpu, pRpc, NV_TRUE));
+    }
+
     return NV_OK;
 }
 
@@ -927,6 +975,7 @@ _kgspFreeRpcInfrastructure
 {
     if (pKernelGsp->pRpc != NULL)
     {
+        rpcAsyncCancelAll(pGpu, pKernelGsp->pRpc);
         GspMsgQueueCleanup(&pKernelGsp->pRpc->pMessageQueueInfo);
         rpcDestroy(pGpu, pKernelGsp->pRpc);
         portMemFree(pKernelGsp->pRpc);
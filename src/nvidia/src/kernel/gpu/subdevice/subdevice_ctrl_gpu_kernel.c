@@ -2370,3 +2370,97 @@ subdeviceCtrlCmdGpuSetFabricAddr_IMPL
 
     return knvlinkSetUniqueFabricBaseAddress(pGpu, pKernelNvlink, pParams->fabricBaseAddr);
 }
+
+//
+// subdeviceCtrlCmdGspGetRpcProfile
+//
+// Lock Requirements:
+//      Assert that API lock and GPUs lock held on entry
+//
+NV_STATUS
+subdeviceCtrlCmdGspGetRpcProfile_IMPL
+(
+    Subdevice *pSubdevice,
+    NV2080_CTRL_GSP_GET_RPC_PROFILE_PARAMS *pParams
+)
+{
+    OBJGPU *pGpu = GPU_RES_GET_GPU(pSubdevice);
+    OBJRPC *pRpc = GPU_GET_RPC(pGpu);
+    NvU32   function;
+
+    LOCK_ASSERT_AND_RETURN(rmApiLockIsOwner() && rmGpuLockIsOwner());
+
+    if (pRpc == NULL)
+        return NV_ERR_NOT_SUPPORTED;
+
+    pParams->bEnabled     = (pRpc->pProfile != NULL);
+    pParams->entryCount   = 0;
+    pParams->nextFunction = NV2080_CTRL_GSP_RPC_PROFILE_FUNCTION_END;
+
+    if (!pParams->bEnabled)
+        return NV_OK;
+
+    for (function = pParams->firstFunction;
+         function < NV_VGPU_MSG_FUNCTION_NUM_FUNCTIONS;
+         function++)
+    {
+        NV2080_CTRL_GSP_RPC_PROFILE_ENTRY *pEntry;
+        RPC_PROFILE_STATS stats;
+
+        if (rpcProfileGetStats(pGpu, pRpc, function, &stats) != NV_OK)
+            continue;
+
+        if (pParams->entryCount == NV2080_CTRL_GSP_RPC_PROFILE_MAX_ENTRIES)
+        {
+            pParams->nextFunction = function;
+            break;
+        }
+
+        pEntry = &pParams->entries[pParams->entryCount++];
+        pEntry->function      = function;
+        pEntry->count         = stats.count;
+        pEntry->p50Ns         = stats.p50Ns;
+        pEntry->p99Ns         = stats.p99Ns;
+        pEntry->maxNs         = stats.maxNs;
+        pEntry->totalNs       = stats.totalNs;
+        pEntry->bytesSent     = stats.bytesSent;
+        pEntry->bytesReceived = stats.bytesReceived;
+    }
+
+    return NV_OK;
+}
+
+//
+// subdeviceCtrlCmdGspSetRpcProfile
+//
+// Lock Requirements:
+//      Assert that API lock and GPUs lock held on entry
+//
+NV_STATUS
+subdeviceCtrlCmdGspSetRpcProfile_IMPL
+(
+    Subdevice *pSubdevice,
+    NV2080_CTRL_GSP_SET_RPC_PROFILE_PARAMS *pParams
+)
+{
+    OBJGPU *pGpu = GPU_RES_GET_GPU(pSubdevice);
+    OBJRPC *pRpc = GPU_GET_RPC(pGpu);
+
+    LOCK_ASSERT_AND_RETURN(rmApiLockIsOwner() && rmGpuLockIsOwner());
+
+    if (pRpc == NULL)
+        return NV_ERR_NOT_SUPPORTED;
+
+    switch (pParams->cmd)
+    {
+        case NV2080_CTRL_GSP_RPC_PROFILE_CMD_DISABLE:
+            return rpcProfileEnable(pGpu, pRpc, NV_FALSE);
+        case NV2080_CTRL_GSP_RPC_PROFILE_CMD_ENABLE:
+            return rpcProfileEnable(pGpu, pRpc, NV_TRUE);
+        case NV2080_CTRL_GSP_RPC_PROFILE_CMD_RESET:
+            rpcProfileReset(pGpu, pRpc);
+            return NV_OK;
+        default:
+            return NV_ERR_INVALID_ARGUMENT;
+    }
+}
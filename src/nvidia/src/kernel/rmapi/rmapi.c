@@ -52,6 +52,13 @@ static RM_API     g_RmApiList[RMAPI_TYPE_MAX];
 static NvBool     g_bResServInit = NV_FALSE;
 static RMAPI_LOCK g_RmApiLock;
 
+//
+// Admits rmapiGetAllocatorStats() callers: the OPEN bit is set while
+// g_resServ's allocator exists, the low bits count callers reading it.
+//
+static volatile NvS32 g_resServStatsGate;
+#define RMAPI_RESSERV_STATS_OPEN NVBIT(30)
+
 static void _rmapiInitInterface(RM_API *pRmApi, API_SECURITY_INFO *pDefaultSecurityInfo, NvBool bTlsInternal,
                                 NvBool bApiLockInternal, NvBool bGpuLockInternal);
 static NV_STATUS _rmapiLockAlloc(void);
@@ -106,6 +113,7 @@ rmapiInitialize
     rmapiInitStubInterface(&g_RmApiList[RMAPI_STUBS]);
 
     g_bResServInit = NV_TRUE;
+    portAtomicOrS32(&g_resServStatsGate, RMAPI_RESSERV_STATS_OPEN);
 
     return status;
 }
@@ -119,6 +127,11 @@ rmapiShutdown
     if (!g_bResServInit)
         return;
 
+    // Turn new stats readers away, then wait for those already reading.
+    portAtomicAndS32(&g_resServStatsGate, ~RMAPI_RESSERV_STATS_OPEN);
+    while (!portAtomicCompareAndSwapS32(&g_resServStatsGate, 0, 0))
+        osSpinLoop();
+
     serverFreeDomain(&g_resServ, 0);
     serverDestruct(&g_resServ);
     _rmapiLockFree();
@@ -128,6 +141,53 @@ rmapiShutdown
     g_bResServInit = NV_FALSE;
 }
 
+//
+// Safe to call at any time, including before RM API init and while it is
+// torn down (it backs /proc/driver/nvidia/resserv_slab): callers pass the
+// stats gate, which rmapiShutdown() closes and drains before it destroys
+// the resource server.
+// Returns NV_ERR_INVALID_STATE if the resource server is not set up and
+// NV_ERR_NOT_SUPPORTED if its allocator is not a slab allocator.
+//
+NV_STATUS
+rmapiGetAllocatorStats
+(
+    PORT_MEM_SLAB_STATS pStats[PORT_MEM_SLAB_SIZE_CLASS_COUNT]
+)
+{
+    NV_STATUS status = NV_ERR_NOT_SUPPORTED;
+    NvS32 gate;
+
+    portMemSet(pStats, 0, sizeof(*pStats) * PORT_MEM_SLAB_SIZE_CLASS_COUNT);
+
+    do
+    {
+        gate = g_resServStatsGate;
+        if (!(gate & RMAPI_RESSERV_STATS_OPEN))
+            return NV_ERR_INVALID_STATE;
+    } while (!portAtomicCompareAndSwapS32(&g_resServStatsGate, gate + 1, gate));
+
+#if PORT_IS_FUNC_SUPPORTED(portMemExSlabGetStats)
+    {
+        NvU32 i;
+
+        for (i = 0; i < PORT_MEM_SLAB_SIZE_CLASS_COUNT; i++)
+        {
+            status = portMemExSlabGetStats(g_resServ.pAllocator, i, &pStats[i]);
+            if (status != NV_OK)
+            {
+                status = NV_ERR_NOT_SUPPORTED;
+                break;
+            }
+        }
+    }
+#endif
+
+    portAtomicDecrementS32(&g_resServStatsGate);
+
+    return status;
+}
+
 static void
 _rmapiInitInterface
 (
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2020-2021 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2020-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: MIT
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
@@ -20,21 +20,43 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
  * DEALINGS IN THE SOFTWARE.
  */
+#include "containers/list.h"
 #include "containers/map.h"
 #include "containers/multimap.h"
 #include "nvctassert.h"
+#include "nvport/atomic.h"
 #include "nvport/sync.h"
 #include "nvrm_registry.h"
 #include "os/os.h"
 #include "rmapi/control.h"
 #include "rmapi/rmapi.h"
 
+//
+// The cache is split into shards selected by a hash of (hClient, hObject).
+// Each shard is protected by its own reader/writer lock, so lookups only
+// ever take a shared lock on one shard and never serialize against each
+// other.  Writers (insertion, eviction and frees) only block the shard they
+// modify.
+//
+#define RMAPI_CONTROL_CACHE_SHARD_COUNT 16
+
 typedef struct
 {
-    void* params;
+    void    *params;
+    NvU32    paramsSize;
+    NvU64    submapKey;
+
+    //
+    // Set by lookups and cleared when the eviction clock hand passes over
+    // the entry, giving recently used entries a second chance.  Readers
+    // race on it benignly.
+    //
+    volatile NvU32 bReferenced;
+    ListNode clockNode;
 } RmapiControlCacheEntry;
 
 MAKE_MULTIMAP(CachedCallParams, RmapiControlCacheEntry);
+MAKE_INTRUSIVE_LIST(CachedCallParamsClock, RmapiControlCacheEntry, clockNode);
 
 ct_assert(sizeof(NvHandle) <= 4);
 
@@ -50,13 +72,46 @@ static NvU64 handlesToKey(NvHandle hClient, NvHandle hObject)
     return ((NvU64)hClient << CLIENT_KEY_SHIFT) | hObject;
 }
 
+typedef struct
+{
+    CachedCallParams      cachedCallParams;
+
+    // All entries of the shard in insertion order; the head is the clock hand
+    CachedCallParamsClock clock;
+
+    PORT_RWLOCK          *pLock;
+
+    // Statistics, updated atomically since lookups only hold a shared lock
+    volatile NvU64        hits;
+    volatile NvU64        misses;
+    volatile NvU64        evictions;
+} RmapiControlCacheShard;
+
 static struct {
-    /* NOTE: Size unbounded for now */
-    CachedCallParams cachedCallParams;
+    RmapiControlCacheShard shards[RMAPI_CONTROL_CACHE_SHARD_COUNT];
+    NvU32 maxEntriesPerShard;
     NvU32 mode;
-    PORT_MUTEX *mtx;
+
+    //
+    // Admits rmapiControlCacheGetStats() callers: the OPEN bit is set while
+    // the shards exist, the low bits count callers currently reading them.
+    //
+    volatile NvS32 statsGate;
 } RmapiControlCache;
 
+#define RMAPI_CONTROL_CACHE_STATS_OPEN NVBIT(30)
+
+static RmapiControlCacheShard *handlesToShard(NvHandle hClient, NvHandle hObject)
+{
+    NvU32 hash = (hClient * 0x9E3779B1U) ^ hObject;
+
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+
+    return &RmapiControlCache.shards[hash % RMAPI_CONTROL_CACHE_SHARD_COUNT];
+}
+
 NvBool rmapiControlIsCacheable(NvU32 flags, NvBool isGSPClient)
 {
     if (RmapiControlCache.mode == NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE)
@@ -72,35 +127,142 @@ NvBool rmapiControlIsCacheable(NvU32 flags, NvBool isGSPClient)
     return NV_FALSE;
 }
 
+static void destroyShards(NvU32 count)
+{
+    NvU32 i;
+
+    for (i = 0; i < count; i++)
+    {
+        RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
+
+        listDestroy(&pShard->clock);
+        multimapDestroy(&pShard->cachedCallParams);
+        portSyncRwLockDestroy(pShard->pLock);
+        pShard->pLock = NULL;
+    }
+}
+
 void rmapiControlCacheInit()
 {
+    NvU32 maxEntries = NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_ENTRIES_DEFAULT;
+    NvU32 i;
+
     RmapiControlCache.mode = NV_REG_STR_RM_CACHEABLE_CONTROLS_GSP_ONLY;
 
     osReadRegistryDword(NULL, NV_REG_STR_RM_CACHEABLE_CONTROLS, &RmapiControlCache.mode);
+    osReadRegistryDword(NULL, NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_ENTRIES, &maxEntries);
     NV_PRINTF(LEVEL_INFO, "using cache mode %d\n", RmapiControlCache.mode);
 
+    if (maxEntries == 0)
+        maxEntries = NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_ENTRIES_DEFAULT;
+
+    RmapiControlCache.maxEntriesPerShard =
+        NV_MAX(1, maxEntries / RMAPI_CONTROL_CACHE_SHARD_COUNT);
+
     if (RmapiControlCache.mode)
     {
-        multimapInit(&RmapiControlCache.cachedCallParams, portMemAllocatorGetGlobalNonPaged());
-        RmapiControlCache.mtx = portSyncMutexCreate(portMemAllocatorGetGlobalNonPaged());
-        if (!RmapiControlCache.mtx)
+        for (i = 0; i < RMAPI_CONTROL_CACHE_SHARD_COUNT; i++)
         {
-            NV_PRINTF(LEVEL_ERROR, "failed to create mutex");
-            RmapiControlCache.mode = NV_REG_STR_RM_CACHEABLE_CONTROLS_DISABLE;
+            RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
+
+            pShard->pLock = portSyncRwLockCreate(portMemAllocatorGetGlobalNonPaged());
+            if (!pShard->pLock)
+            {
+                NV_PRINTF(LEVEL_ERROR, "failed to create rwlock");
+                destroyShards(i);
+                RmapiControlCache.mode = NV_REG_STR_RM_CACHEABLE_CONTROLS_DISABLE;
+                return;
+            }
+
+            multimapInit(&pShard->cachedCallParams, portMemAllocatorGetGlobalNonPaged());
+            listInitIntrusive(&pShard->clock);
+            pShard->hits = 0;
+            pShard->misses = 0;
+            pShard->evictions = 0;
         }
+
+        portAtomicOrS32(&RmapiControlCache.statsGate, RMAPI_CONTROL_CACHE_STATS_OPEN);
     }
 }
 
-void* rmapiControlCacheGet(NvHandle hClient, NvHandle hObject, NvU32 cmd)
+NV_STATUS rmapiControlCacheGet
+(
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32 cmd,
+    void* params,
+    NvU32 paramsSize
+)
 {
+    RmapiControlCacheShard *pShard = handlesToShard(hClient, hObject);
+    RmapiControlCacheEntry *entry;
+    NV_STATUS status = NV_ERR_OBJECT_NOT_FOUND;
+
     NV_PRINTF(LEVEL_INFO, "cache lookup for 0x%x 0x%x 0x%x\n", hClient, hObject, cmd);
-    portSyncMutexAcquire(RmapiControlCache.mtx);
-    RmapiControlCacheEntry* entry = multimapFindItem(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject), cmd);
-    portSyncMutexRelease(RmapiControlCache.mtx);
-    NV_PRINTF(LEVEL_INFO, "cache entry for 0x%x 0x%x 0x%x: entry 0x%p\n", hClient, hObject, cmd, entry);
-    if (entry)
-        return entry->params;
-    return NULL;
+
+    portSyncRwLockAcquireRead(pShard->pLock);
+    entry = multimapFindItem(&pShard->cachedCallParams, handlesToKey(hClient, hObject), cmd);
+
+    //
+    // The params are copied out while the shard is still locked, since a
+    // concurrent free or eviction could otherwise release them under us.
+    //
+    if (entry && entry->paramsSize == paramsSize)
+    {
+        portMemCopy(params, paramsSize, entry->params, paramsSize);
+        entry->bReferenced = NV_TRUE;
+        status = NV_OK;
+    }
+    portSyncRwLockReleaseRead(pShard->pLock);
+
+    NV_PRINTF(LEVEL_INFO, "cache entry for 0x%x 0x%x 0x%x: %s\n", hClient, hObject, cmd,
+              (status == NV_OK) ? "hit" : "miss");
+
+    if (status == NV_OK)
+        portAtomicExIncrementU64(&pShard->hits);
+    else
+        portAtomicExIncrementU64(&pShard->misses);
+
+    return status;
+}
+
+static void removeEntry(RmapiControlCacheShard *pShard, RmapiControlCacheEntry *entry)
+{
+    listRemove(&pShard->clock, entry);
+    portMemFree(entry->params);
+    multimapRemoveItem(&pShard->cachedCallParams, entry);
+}
+
+//
+// Evict one entry using the CLOCK policy: entries looked up since the hand
+// last passed over them are moved to the back of the clock instead.
+//
+static void evictEntry(RmapiControlCacheShard *pShard)
+{
+    RmapiControlCacheEntry *entry;
+
+    while ((entry = listHead(&pShard->clock)) != NULL)
+    {
+        if (entry->bReferenced)
+        {
+            entry->bReferenced = NV_FALSE;
+            listRemove(&pShard->clock, entry);
+            listAppendExisting(&pShard->clock, entry);
+            continue;
+        }
+
+        NvU64 submapKey = entry->submapKey;
+        CachedCallParamsSubmap *submap;
+
+        removeEntry(pShard, entry);
+
+        submap = multimapFindSubmap(&pShard->cachedCallParams, submapKey);
+        if (submap && multimapCountSubmapItems(&pShard->cachedCallParams, submap) == 0)
+            multimapRemoveSubmap(&pShard->cachedCallParams, submap);
+
+        portAtomicExIncrementU64(&pShard->evictions);
+        return;
+    }
 }
 
 NV_STATUS rmapiControlCacheSet
@@ -112,143 +274,222 @@ NV_STATUS rmapiControlCacheSet
     NvU32 paramsSize
 )
 {
-    portSyncMutexAcquire(RmapiControlCache.mtx);
+    RmapiControlCacheShard *pShard = handlesToShard(hClient, hObject);
+    NvU64 submapKey = handlesToKey(hClient, hObject);
     NV_STATUS status = NV_OK;
-    RmapiControlCacheEntry* entry = multimapFindItem(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject), cmd);
+    RmapiControlCacheEntry* entry;
     CachedCallParamsSubmap* insertedSubmap = NULL;
+    void *paramsCopy;
 
-    if (!entry)
+    // Most callers race to cache the same result; avoid the copy if it is there
+    portSyncRwLockAcquireRead(pShard->pLock);
+    entry = multimapFindItem(&pShard->cachedCallParams, submapKey, cmd);
+    portSyncRwLockReleaseRead(pShard->pLock);
+    if (entry)
+        return NV_OK;
+
+    // Copy the params before taking the lock to keep the write section short
+    paramsCopy = portMemAllocNonPaged(paramsSize);
+    if (!paramsCopy)
+        return NV_ERR_NO_MEMORY;
+
+    portMemCopy(paramsCopy, paramsSize, params, paramsSize);
+
+    portSyncRwLockAcquireWrite(pShard->pLock);
+
+    // Another thread may have cached the same control while we were copying
+    entry = multimapFindItem(&pShard->cachedCallParams, submapKey, cmd);
+    if (entry)
+        goto done;
+
+    if (listCount(&pShard->clock) >= RmapiControlCache.maxEntriesPerShard)
+        evictEntry(pShard);
+
+    if (!multimapFindSubmap(&pShard->cachedCallParams, submapKey))
     {
-        if (!multimapFindSubmap(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject)))
+        insertedSubmap = multimapInsertSubmap(&pShard->cachedCallParams, submapKey);
+        if (!insertedSubmap)
         {
-            insertedSubmap = multimapInsertSubmap(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject));
-            if (!insertedSubmap)
-            {
-                status = NV_ERR_NO_MEMORY;
-                goto done;
-            }
+            status = NV_ERR_NO_MEMORY;
+            goto done;
         }
-
-        entry = multimapInsertItemNew(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject), cmd);
     }
 
+    entry = multimapInsertItemNew(&pShard->cachedCallParams, submapKey, cmd);
     if (!entry)
     {
-        status = NV_ERR_NO_MEMORY;
-        goto done;
-    }
+        /* To avoid leaking memory, remove the newly inserted empty submap */
+        if (insertedSubmap)
+            multimapRemoveSubmap(&pShard->cachedCallParams, insertedSubmap);
 
-    entry->params = portMemAllocNonPaged(paramsSize);
-    if (!entry->params)
-    {
         status = NV_ERR_NO_MEMORY;
         goto done;
     }
 
-    portMemCopy(entry->params, paramsSize, params, paramsSize);
+    entry->params = paramsCopy;
+    entry->paramsSize = paramsSize;
+    entry->submapKey = submapKey;
+    entry->bReferenced = NV_FALSE;
+    listAppendExisting(&pShard->clock, entry);
+    paramsCopy = NULL;
 
 done:
-    if (status != NV_OK)
-    {
-        /* To avoid leaking memory, remove the newly inserted empty submap and entry */
-        if (entry)
-        {
-            portMemFree(entry->params);
-            multimapRemoveItem(&RmapiControlCache.cachedCallParams, entry);
-        }
-
-        if (insertedSubmap)
-            multimapRemoveSubmap(&RmapiControlCache.cachedCallParams, insertedSubmap);
-    }
+    portSyncRwLockReleaseWrite(pShard->pLock);
 
-    portSyncMutexRelease(RmapiControlCache.mtx);
+    portMemFree(paramsCopy);
 
     return status;
 }
 
-static void freeSubmap(CachedCallParamsSubmap* submap)
+static void freeSubmap(RmapiControlCacheShard *pShard, CachedCallParamsSubmap* submap)
 {
     /* (Sub)map modification invalidates the iterator, so we have to restart */
     while (NV_TRUE)
     {
-        CachedCallParamsIter it = multimapSubmapIterItems(&RmapiControlCache.cachedCallParams, submap);
+        CachedCallParamsIter it = multimapSubmapIterItems(&pShard->cachedCallParams, submap);
 
         if (multimapItemIterNext(&it))
         {
-            RmapiControlCacheEntry* entry = it.pValue;
-            portMemFree(entry->params);
-            multimapRemoveItem(&RmapiControlCache.cachedCallParams, entry);
+            removeEntry(pShard, it.pValue);
         }
         else
         {
             break;
         }
     }
-    multimapRemoveSubmap(&RmapiControlCache.cachedCallParams, submap);
+    multimapRemoveSubmap(&pShard->cachedCallParams, submap);
 }
 
 void rmapiControlCacheFreeClient(NvHandle hClient)
 {
+    NvU32 i;
+
     if (!RmapiControlCache.mode)
         return;
 
-    portSyncMutexAcquire(RmapiControlCache.mtx);
-    while (NV_TRUE)
+    // The client's objects hash to any shard, so visit each of them
+    for (i = 0; i < RMAPI_CONTROL_CACHE_SHARD_COUNT; i++)
     {
-        CachedCallParamsSubmap* start = multimapFindSubmapGEQ(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, 0));
-        CachedCallParamsSubmap* end = multimapFindSubmapLEQ(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, NV_U32_MAX));
+        RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
 
-        if (!start || !end ||
-            keyToClient(multimapSubmapKey(&RmapiControlCache.cachedCallParams, start)) != hClient ||
-            keyToClient(multimapSubmapKey(&RmapiControlCache.cachedCallParams, end)) != hClient)
+        portSyncRwLockAcquireWrite(pShard->pLock);
+        while (NV_TRUE)
         {
-            break;
-        }
+            CachedCallParamsSubmap* start = multimapFindSubmapGEQ(&pShard->cachedCallParams, handlesToKey(hClient, 0));
+            CachedCallParamsSubmap* end = multimapFindSubmapLEQ(&pShard->cachedCallParams, handlesToKey(hClient, NV_U32_MAX));
+
+            if (!start || !end ||
+                keyToClient(multimapSubmapKey(&pShard->cachedCallParams, start)) != hClient ||
+                keyToClient(multimapSubmapKey(&pShard->cachedCallParams, end)) != hClient)
+            {
+                break;
+            }
 
-        CachedCallParamsSupermapIter it = multimapSubmapIterRange(&RmapiControlCache.cachedCallParams, start, end);
+            CachedCallParamsSupermapIter it = multimapSubmapIterRange(&pShard->cachedCallParams, start, end);
 
-        if (multimapSubmapIterNext(&it))
-        {
-            CachedCallParamsSubmap* submap = it.pValue;
-            freeSubmap(submap);
-        }
-        else
-        {
-            break;
+            if (multimapSubmapIterNext(&it))
+            {
+                CachedCallParamsSubmap* submap = it.pValue;
+                freeSubmap(pShard, submap);
+            }
+            else
+            {
+                break;
+            }
         }
+        portSyncRwLockReleaseWrite(pShard->pLock);
     }
-    portSyncMutexRelease(RmapiControlCache.mtx);
 }
 
 void rmapiControlCacheFreeObject(NvHandle hClient, NvHandle hObject)
 {
+    RmapiControlCacheShard *pShard;
     CachedCallParamsSubmap* submap;
 
     if (!RmapiControlCache.mode)
         return;
 
-    portSyncMutexAcquire(RmapiControlCache.mtx);
+    pShard = handlesToShard(hClient, hObject);
+
+    portSyncRwLockAcquireWrite(pShard->pLock);
 
-    submap = multimapFindSubmap(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject));
+    submap = multimapFindSubmap(&pShard->cachedCallParams, handlesToKey(hClient, hObject));
     if (submap)
-        freeSubmap(submap);
+        freeSubmap(pShard, submap);
 
-    portSyncMutexRelease(RmapiControlCache.mtx);
+    portSyncRwLockReleaseWrite(pShard->pLock);
+}
+
+//
+// Safe to call at any time, including before the cache is set up and while
+// it is torn down (it backs /proc/driver/nvidia/control_cache): callers pass
+// the stats gate, which rmapiControlCacheFree() closes and drains before it
+// destroys the shards, and read each shard under its lock.
+// The result is a snapshot and may be slightly out of date under load.
+// Returns NV_ERR_INVALID_STATE if the cache is disabled.
+//
+NV_STATUS rmapiControlCacheGetStats(RMAPI_CONTROL_CACHE_STATS *pStats)
+{
+    NvS32 gate;
+    NvU32 i;
+
+    portMemSet(pStats, 0, sizeof(*pStats));
+
+    do
+    {
+        gate = RmapiControlCache.statsGate;
+        if (!(gate & RMAPI_CONTROL_CACHE_STATS_OPEN))
+            return NV_ERR_INVALID_STATE;
+    } while (!portAtomicCompareAndSwapS32(&RmapiControlCache.statsGate, gate + 1, gate));
+
+    for (i = 0; i < RMAPI_CONTROL_CACHE_SHARD_COUNT; i++)
+    {
+        RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
+
+        portSyncRwLockAcquireRead(pShard->pLock);
+        pStats->hits      += pShard->hits;
+        pStats->misses    += pShard->misses;
+        pStats->evictions += pShard->evictions;
+        pStats->entries   += listCount(&pShard->clock);
+        portSyncRwLockReleaseRead(pShard->pLock);
+    }
+
+    pStats->maxEntries = (NvU64)RmapiControlCache.maxEntriesPerShard *
+                         RMAPI_CONTROL_CACHE_SHARD_COUNT;
+
+    portAtomicDecrementS32(&RmapiControlCache.statsGate);
+
+    return NV_OK;
 }
 
 void rmapiControlCacheFree(void) {
-    CachedCallParamsIter it;
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NvU32 i;
 
     if (!RmapiControlCache.mode)
         return;
 
-    it = multimapItemIterAll(&RmapiControlCache.cachedCallParams);
-    while (multimapItemIterNext(&it))
+    rmapiControlCacheGetStats(&stats);
+    NV_PRINTF(LEVEL_INFO, "control cache: %llu hits, %llu misses, %llu evictions\n",
+              stats.hits, stats.misses, stats.evictions);
+
+    // Turn new stats readers away, then wait for those already reading.
+    portAtomicAndS32(&RmapiControlCache.statsGate, ~RMAPI_CONTROL_CACHE_STATS_OPEN);
+    while (!portAtomicCompareAndSwapS32(&RmapiControlCache.statsGate, 0, 0))
+        osSpinLoop();
+
+    for (i = 0; i < RMAPI_CONTROL_CACHE_SHARD_COUNT; i++)
     {
-        RmapiControlCacheEntry* entry = it.pValue;
-        portMemFree(entry->params);
+        RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
+        CachedCallParamsIter it = multimapItemIterAll(&pShard->cachedCallParams);
+
+        while (multimapItemIterNext(&it))
+        {
+            RmapiControlCacheEntry* entry = it.pValue;
+            portMemFree(entry->params);
+        }
     }
 
-    multimapDestroy(&RmapiControlCache.cachedCallParams);
-    portSyncMutexDestroy(RmapiControlCache.mtx);
+    destroyShards(RMAPI_CONTROL_CACHE_SHARD_COUNT);
+    RmapiControlCache.mode = NV_REG_STR_RM_CACHEABLE_CONTROLS_DISABLE;
 }
@@ -82,6 +82,8 @@ OBJRPC *initRpcObject(OBJGPU *pGpu)
         return NULL;
     }
 
+    portMemSet(&pRpc->async, 0, sizeof(pRpc->async));
+
     // VIRTUALIZATION is disabled on DCE. Only run the below code on VGPU and GSP.
     rpcSetIpVersion(pGpu, pRpc,
                     RPC_VERSION_FROM_VGX_VERSION(VGX_MAJOR_VERSION_NUMBER,
@@ -50,6 +50,40 @@ static void _mapAdoptChildrenNodes(MapNode *pTargetNode, MapNode *pNewNode);
  */
 static NvBool _mapInsertBase(MapBase *pMap, NvU64 key, void *pValue);
 
+//
+// B+-tree backend.
+//
+// Values keep their MapNode, but pLeft/pRight chain them in key order
+// instead of forming a binary tree, and lookups go through a B+-tree of
+// keys whose leaves point at the MapNodes. Each tree node is four cache
+// lines, so a lookup touches log16(N) nodes rather than log2(N).
+//
+// Full nodes are split on the way down during insertion and minimal nodes
+// are refilled on the way down during removal, so each operation is a
+// single descent and a failed allocation leaves a valid tree behind.
+//
+#define MAP_BTREE_MAX_KEYS  15
+#define MAP_BTREE_MIN_KEYS  (MAP_BTREE_MAX_KEYS / 2)
+
+struct MapBTreeNode
+{
+    NvU64       keys[MAP_BTREE_MAX_KEYS];
+    void       *pSlots[MAP_BTREE_MAX_KEYS + 1]; ///< Children, or MapNodes in a leaf
+    NvU32       count;                          ///< Number of keys
+    NvBool      bLeaf;
+};
+
+static NV_FORCEINLINE NvBool _mapIsBTree(MapBase *pMap)
+{
+    return pMap->pBTreeAllocator != NULL;
+}
+
+static MapNode *_mapBTreeFindGEQ(MapBase *pMap, NvU64 keyMin);
+static MapNode *_mapBTreeFindLEQ(MapBase *pMap, NvU64 keyMax);
+static NvBool _mapBTreeInsert(MapBase *pMap, NvU64 key, MapNode *pNode);
+static void _mapBTreeRemove(MapBase *pMap, MapNode *pNode);
+static void _mapBTreeDestroy(MapBase *pMap, PORT_MEM_ALLOCATOR *pAllocator);
+
 void mapInit_IMPL
 (
     NonIntrusiveMap     *pMap,
@@ -78,12 +112,41 @@ void mapInitIntrusive_IMPL
     pMap->base.nodeOffset = nodeOffset;
 }
 
+void mapInitBTree_IMPL
+(
+    NonIntrusiveMap     *pMap,
+    PORT_MEM_ALLOCATOR  *pAllocator,
+    NvU32               valueSize
+)
+{
+    mapInit_IMPL(pMap, pAllocator, valueSize);
+    pMap->base.pBTreeAllocator = pAllocator;
+}
+
+void mapInitIntrusiveBTree_IMPL
+(
+    IntrusiveMap        *pMap,
+    PORT_MEM_ALLOCATOR  *pAllocator,
+    NvS32               nodeOffset
+)
+{
+    NV_ASSERT_OR_RETURN_VOID(NULL != pAllocator);
+    mapInitIntrusive_IMPL(pMap, nodeOffset);
+    pMap->base.pBTreeAllocator = pAllocator;
+}
+
 static void _mapDestroy(MapBase *pMap, PORT_MEM_ALLOCATOR *pAllocator)
 {
     MapNode *pNode;
 
     NV_ASSERT_OR_RETURN_VOID(NULL != pMap);
 
+    if (_mapIsBTree(pMap))
+    {
+        _mapBTreeDestroy(pMap, pAllocator);
+        return;
+    }
+
     pNode = pMap->pRoot;
     while (NULL != pNode)
     {
@@ -251,6 +314,12 @@ void mapRemoveIntrusive_IMPL
     NV_ASSERT_OR_RETURN_VOID(NULL != z);
     NV_ASSERT_CHECKED(z->pMap == pMap);
 
+    if (_mapIsBTree(pMap))
+    {
+        _mapBTreeRemove(pMap, z);
+        goto done;
+    }
+
     if (z->pLeft == NULL || z->pRight == NULL)
     {
         // z has at least one empty successor, y = z
@@ -293,6 +362,7 @@ void mapRemoveIntrusive_IMPL
         _mapDeleteFixup(&(pMap->pRoot), parentOfX, x);
 
     // 6. update the count
+done:
     NV_CHECKED_ONLY(pMap->versionNumber++);
     NV_CHECKED_ONLY(z->pMap = NULL);
     pMap->count--;
@@ -325,6 +395,16 @@ void *mapFind_IMPL
 {
     MapNode *pCurrent;
     NV_ASSERT_OR_RETURN(NULL != pMap, NULL);
+
+    if (_mapIsBTree(pMap))
+    {
+        pCurrent = _mapBTreeFindGEQ(pMap, key);
+        if ((pCurrent == NULL) || (pCurrent->key != key))
+            return NULL;
+
+        return mapNodeToValue(pMap, pCurrent);
+    }
+
     pCurrent = pMap->pRoot;
 
     while (pCurrent != NULL)
@@ -349,6 +429,10 @@ void *mapFindGEQ_IMPL
     MapNode *pCurrent;
     MapNode *pResult;
     NV_ASSERT_OR_RETURN(NULL != pMap, NULL);
+
+    if (_mapIsBTree(pMap))
+        return mapNodeToValue(pMap, _mapBTreeFindGEQ(pMap, keyMin));
+
     pCurrent = pMap->pRoot;
     pResult = NULL;
 
@@ -381,6 +465,10 @@ void *mapFindLEQ_IMPL
     MapNode *pCurrent;
     MapNode *pResult;
     NV_ASSERT_OR_RETURN(NULL != pMap, NULL);
+
+    if (_mapIsBTree(pMap))
+        return mapNodeToValue(pMap, _mapBTreeFindLEQ(pMap, keyMax));
+
     pCurrent = pMap->pRoot;
     pResult = NULL;
 
@@ -415,6 +503,9 @@ void *mapNext_IMPL
     NV_ASSERT_OR_RETURN(NULL != pNode, NULL);
     NV_ASSERT_CHECKED(pNode->pMap == pMap);
 
+    if (_mapIsBTree(pMap))
+        return mapNodeToValue(pMap, pNode->pRight);
+
     if (NULL != (pCurrent = pNode->pRight))
     {
         while (pCurrent->pLeft != NULL)
@@ -455,6 +546,9 @@ void *mapPrev_IMPL
     NV_ASSERT_OR_RETURN(NULL != pNode, NULL);
     NV_ASSERT_CHECKED(pNode->pMap == pMap);
 
+    if (_mapIsBTree(pMap))
+        return mapNodeToValue(pMap, pNode->pLeft);
+
     if (NULL != (pCurrent = pNode->pLeft))
     {
         while (pCurrent->pRight != NULL)
@@ -851,6 +945,18 @@ static NvBool _mapInsertBase
     MapNode *pParent;
     MapNode *pNode;
     pNode = mapValueToNode(pMap, pValue);
+
+    if (_mapIsBTree(pMap))
+    {
+        if (!_mapBTreeInsert(pMap, key, pNode))
+            return NV_FALSE;
+
+        NV_CHECKED_ONLY(pNode->pMap = pMap);
+        NV_CHECKED_ONLY(pMap->versionNumber++);
+        pMap->count++;
+        return NV_TRUE;
+    }
+
     // 1. locate parent leaf node for the new node
     pCurrent = pMap->pRoot;
     pParent = NULL;
@@ -897,6 +1003,503 @@ static NvBool _mapInsertBase
     return NV_TRUE;
 }
 
+static MapBTreeNode *_mapBTreeNodeCreate
+(
+    MapBase *pMap,
+    NvBool   bLeaf
+)
+{
+    MapBTreeNode *pTreeNode = PORT_ALLOC(pMap->pBTreeAllocator, sizeof(MapBTreeNode));
+
+    if (pTreeNode == NULL)
+        return NULL;
+
+    portMemSet(pTreeNode, 0, sizeof(*pTreeNode));
+    pTreeNode->bLeaf = bLeaf;
+    return pTreeNode;
+}
+
+/**
+ * @brief Index of the child of an interior node that covers key.
+ */
+static NV_FORCEINLINE NvU32 _mapBTreeChildIndex
+(
+    MapBTreeNode *pTreeNode,
+    NvU64         key
+)
+{
+    NvU32 i = 0;
+
+    while ((i < pTreeNode->count) && (pTreeNode->keys[i] <= key))
+        i++;
+
+    return i;
+}
+
+/**
+ * @brief Index of the first key in a leaf that is not less than key.
+ */
+static NV_FORCEINLINE NvU32 _mapBTreeLeafIndex
+(
+    MapBTreeNode *pTreeNode,
+    NvU64         key
+)
+{
+    NvU32 i = 0;
+
+    while ((i < pTreeNode->count) && (pTreeNode->keys[i] < key))
+        i++;
+
+    return i;
+}
+
+static MapBTreeNode *_mapBTreeFindLeaf
+(
+    MapBase *pMap,
+    NvU64    key
+)
+{
+    MapBTreeNode *pTreeNode = pMap->pBTreeRoot;
+
+    while ((pTreeNode != NULL) && !pTreeNode->bLeaf)
+        pTreeNode = pTreeNode->pSlots[_mapBTreeChildIndex(pTreeNode, key)];
+
+    return pTreeNode;
+}
+
+static MapNode *_mapBTreeFindGEQ
+(
+    MapBase *pMap,
+    NvU64    keyMin
+)
+{
+    MapBTreeNode *pLeaf = _mapBTreeFindLeaf(pMap, keyMin);
+    NvU32 i;
+
+    if ((pLeaf == NULL) || (pLeaf->count == 0))
+        return NULL;
+
+    i = _mapBTreeLeafIndex(pLeaf, keyMin);
+    if (i < pLeaf->count)
+        return pLeaf->pSlots[i];
+
+    // Everything in this leaf is smaller; the answer starts the next leaf
+    return ((MapNode *)pLeaf->pSlots[pLeaf->count - 1])->pRight;
+}
+
+static MapNode *_mapBTreeFindLEQ
+(
+    MapBase *pMap,
+    NvU64    keyMax
+)
+{
+    MapBTreeNode *pLeaf = _mapBTreeFindLeaf(pMap, keyMax);
+    NvU32 i;
+
+    if ((pLeaf == NULL) || (pLeaf->count == 0))
+        return NULL;
+
+    i = _mapBTreeLeafIndex(pLeaf, keyMax);
+    if ((i < pLeaf->count) && (pLeaf->keys[i] == keyMax))
+        return pLeaf->pSlots[i];
+
+    if (i > 0)
+        return pLeaf->pSlots[i - 1];
+
+    // Everything in this leaf is larger; the answer ends the previous leaf
+    return ((MapNode *)pLeaf->pSlots[0])->pLeft;
+}
+
+/**
+ * @brief Split the full child at index idx of an interior node in two.
+ */
+static NvBool _mapBTreeSplitChild
+(
+    MapBase      *pMap,
+    MapBTreeNode *pParent,
+    NvU32         idx
+)
+{
+    MapBTreeNode *pLeft = pParent->pSlots[idx];
+    MapBTreeNode *pRight;
+    NvU64         separator;
+    NvU32         i;
+
+    pRight = _mapBTreeNodeCreate(pMap, pLeft->bLeaf);
+    if (pRight == NULL)
+        return NV_FALSE;
+
+    if (pLeft->bLeaf)
+    {
+        // Leaves keep every key; the right half's first key is copied up
+        pRight->count = MAP_BTREE_MAX_KEYS - MAP_BTREE_MIN_KEYS;
+        for (i = 0; i < pRight->count; i++)
+        {
+            pRight->keys[i]   = pLeft->keys[MAP_BTREE_MIN_KEYS + i];
+            pRight->pSlots[i] = pLeft->pSlots[MAP_BTREE_MIN_KEYS + i];
+        }
+        separator = pRight->keys[0];
+    }
+    else
+    {
+        // The middle key of an interior node moves up
+        pRight->count = MAP_BTREE_MAX_KEYS - MAP_BTREE_MIN_KEYS - 1;
+        for (i = 0; i < pRight->count; i++)
+            pRight->keys[i] = pLeft->keys[MAP_BTREE_MIN_KEYS + 1 + i];
+        for (i = 0; i <= pRight->count; i++)
+            pRight->pSlots[i] = pLeft->pSlots[MAP_BTREE_MIN_KEYS + 1 + i];
+        separator = pLeft->keys[MAP_BTREE_MIN_KEYS];
+    }
+    pLeft->count = MAP_BTREE_MIN_KEYS;
+
+    for (i = pParent->count; i > idx; i--)
+    {
+        pParent->keys[i]       = pParent->keys[i - 1];
+        pParent->pSlots[i + 1] = pParent->pSlots[i];
+    }
+    pParent->keys[idx]       = separator;
+    pParent->pSlots[idx + 1] = pRight;
+    pParent->count++;
+
+    return NV_TRUE;
+}
+
+static NvBool _mapBTreeInsert
+(
+    MapBase *pMap,
+    NvU64    key,
+    MapNode *pNode
+)
+{
+    MapBTreeNode *pTreeNode;
+    MapNode      *pPrev;
+    MapNode      *pNext;
+    NvU32         i;
+
+    if (pMap->pBTreeRoot == NULL)
+    {
+        pMap->pBTreeRoot = _mapBTreeNodeCreate(pMap, NV_TRUE);
+        if (pMap->pBTreeRoot == NULL)
+            return NV_FALSE;
+    }
+
+    if (pMap->pBTreeRoot->count == MAP_BTREE_MAX_KEYS)
+    {
+        MapBTreeNode *pNewRoot = _mapBTreeNodeCreate(pMap, NV_FALSE);
+        if (pNewRoot == NULL)
+            return NV_FALSE;
+
+        pNewRoot->pSlots[0] = pMap->pBTreeRoot;
+        if (!_mapBTreeSplitChild(pMap, pNewRoot, 0))
+        {
+            PORT_FREE(pMap->pBTreeAllocator, pNewRoot);
+            return NV_FALSE;
+        }
+        pMap->pBTreeRoot = pNewRoot;
+    }
+
+    pTreeNode = pMap->pBTreeRoot;
+    while (!pTreeNode->bLeaf)
+    {
+        MapBTreeNode *pChild;
+
+        i = _mapBTreeChildIndex(pTreeNode, key);
+        pChild = pTreeNode->pSlots[i];
+
+        if (pChild->count == MAP_BTREE_MAX_KEYS)
+        {
+            if (!_mapBTreeSplitChild(pMap, pTreeNode, i))
+                return NV_FALSE;
+
+            if (key >= pTreeNode->keys[i])
+                i++;
+            pChild = pTreeNode->pSlots[i];
+        }
+
+        pTreeNode = pChild;
+    }
+
+    i = _mapBTreeLeafIndex(pTreeNode, key);
+    if ((i < pTreeNode->count) && (pTreeNode->keys[i] == key))
+    {
+        // duplication detected
+        return NV_FALSE;
+    }
+
+    // Find the neighbours in key order before the leaf is shifted
+    if (i < pTreeNode->count)
+    {
+        pNext = pTreeNode->pSlots[i];
+        pPrev = pNext->pLeft;
+    }
+    else if (pTreeNode->count > 0)
+    {
+        pPrev = pTreeNode->pSlots[pTreeNode->count - 1];
+        pNext = pPrev->pRight;
+    }
+    else
+    {
+        pPrev = NULL;
+        pNext = NULL;
+    }
+
+    portMemMove(&pTreeNode->keys[i + 1], sizeof(NvU64) * (pTreeNode->count - i),
+                &pTreeNode->keys[i], sizeof(NvU64) * (pTreeNode->count - i));
+    portMemMove(&pTreeNode->pSlots[i + 1], sizeof(void *) * (pTreeNode->count - i),
+                &pTreeNode->pSlots[i], sizeof(void *) * (pTreeNode->count - i));
+    pTreeNode->keys[i]   = key;
+    pTreeNode->pSlots[i] = pNode;
+    pTreeNode->count++;
+
+    pNode->key     = key;
+    pNode->pParent = NULL;
+    pNode->bIsRed  = NV_FALSE;
+    pNode->pLeft   = pPrev;
+    pNode->pRight  = pNext;
+    if (pPrev != NULL)
+        pPrev->pRight = pNode;
+    if (pNext != NULL)
+        pNext->pLeft = pNode;
+
+    return NV_TRUE;
+}
+
+/**
+ * @brief Merge the child at idx + 1 of an interior node into the child at idx.
+ */
+static void _mapBTreeMergeChildren
+(
+    MapBase      *pMap,
+    MapBTreeNode *pParent,
+    NvU32         idx
+)
+{
+    MapBTreeNode *pLeft  = pParent->pSlots[idx];
+    MapBTreeNode *pRight = pParent->pSlots[idx + 1];
+    NvU32         i;
+
+    if (pLeft->bLeaf)
+    {
+        for (i = 0; i < pRight->count; i++)
+        {
+            pLeft->keys[pLeft->count + i]   = pRight->keys[i];
+            pLeft->pSlots[pLeft->count + i] = pRight->pSlots[i];
+        }
+        pLeft->count += pRight->count;
+    }
+    else
+    {
+        pLeft->keys[pLeft->count] = pParent->keys[idx];
+        for (i = 0; i < pRight->count; i++)
+            pLeft->keys[pLeft->count + 1 + i] = pRight->keys[i];
+        for (i = 0; i <= pRight->count; i++)
+            pLeft->pSlots[pLeft->count + 1 + i] = pRight->pSlots[i];
+        pLeft->count += pRight->count + 1;
+    }
+
+    for (i = idx; i + 1 < pParent->count; i++)
+    {
+        pParent->keys[i]       = pParent->keys[i + 1];
+        pParent->pSlots[i + 1] = pParent->pSlots[i + 2];
+    }
+    pParent->count--;
+
+    PORT_FREE(pMap->pBTreeAllocator, pRight);
+}
+
+/**
+ * @brief Make sure the child at idx has more than the minimum number of keys
+ *        by borrowing from or merging with a sibling.
+ * @return The index of the child that now covers the same keys.
+ */
+static NvU32 _mapBTreeRefillChild
+(
+    MapBase      *pMap,
+    MapBTreeNode *pParent,
+    NvU32         idx
+)
+{
+    MapBTreeNode *pChild = pParent->pSlots[idx];
+    MapBTreeNode *pSibling;
+    NvU32         i;
+
+    if ((idx > 0) &&
+        (((MapBTreeNode *)pParent->pSlots[idx - 1])->count > MAP_BTREE_MIN_KEYS))
+    {
+        // Borrow the last entry of the left sibling
+        pSibling = pParent->pSlots[idx - 1];
+
+        for (i = pChild->count; i > 0; i--)
+            pChild->keys[i] = pChild->keys[i - 1];
+        for (i = pChild->count + (pChild->bLeaf ? 0 : 1); i > 0; i--)
+            pChild->pSlots[i] = pChild->pSlots[i - 1];
+
+        if (pChild->bLeaf)
+        {
+            pChild->keys[0]   = pSibling->keys[pSibling->count - 1];
+            pChild->pSlots[0] = pSibling->pSlots[pSibling->count - 1];
+            pParent->keys[idx - 1] = pChild->keys[0];
+        }
+        else
+        {
+            pChild->keys[0]   = pParent->keys[idx - 1];
+            pChild->pSlots[0] = pSibling->pSlots[pSibling->count];
+            pParent->keys[idx - 1] = pSibling->keys[pSibling->count - 1];
+        }
+
+        pSibling->count--;
+        pChild->count++;
+        return idx;
+    }
+
+    if ((idx < pParent->count) &&
+        (((MapBTreeNode *)pParent->pSlots[idx + 1])->count > MAP_BTREE_MIN_KEYS))
+    {
+        // Borrow the first entry of the right sibling
+        pSibling = pParent->pSlots[idx + 1];
+
+        if (pChild->bLeaf)
+        {
+            pChild->keys[pChild->count]   = pSibling->keys[0];
+            pChild->pSlots[pChild->count] = pSibling->pSlots[0];
+        }
+        else
+        {
+            pChild->keys[pChild->count]       = pParent->keys[idx];
+            pChild->pSlots[pChild->count + 1] = pSibling->pSlots[0];
+            pParent->keys[idx] = pSibling->keys[0];
+        }
+        pChild->count++;
+
+        for (i = 0; i + 1 < pSibling->count; i++)
+            pSibling->keys[i] = pSibling->keys[i + 1];
+        for (i = 0; i + 1 < pSibling->count + (pSibling->bLeaf ? 0 : 1); i++)
+            pSibling->pSlots[i] = pSibling->pSlots[i + 1];
+        pSibling->count--;
+
+        if (pChild->bLeaf)
+            pParent->keys[idx] = pSibling->keys[0];
+
+        return idx;
+    }
+
+    // Both siblings are minimal, so a merge fits in one node
+    if (idx > 0)
+    {
+        _mapBTreeMergeChildren(pMap, pParent, idx - 1);
+        return idx - 1;
+    }
+
+    _mapBTreeMergeChildren(pMap, pParent, idx);
+    return idx;
+}
+
+static void _mapBTreeRemove
+(
+    MapBase *pMap,
+    MapNode *pNode
+)
+{
+    MapBTreeNode *pTreeNode = pMap->pBTreeRoot;
+    NvU64         key       = pNode->key;
+    NvU32         i;
+
+    NV_ASSERT_OR_RETURN_VOID(pTreeNode != NULL);
+
+    while (!pTreeNode->bLeaf)
+    {
+        i = _mapBTreeChildIndex(pTreeNode, key);
+
+        if (((MapBTreeNode *)pTreeNode->pSlots[i])->count <= MAP_BTREE_MIN_KEYS)
+        {
+            i = _mapBTreeRefillChild(pMap, pTreeNode, i);
+
+            // Only the root can be left without keys, after its last merge
+            if (pTreeNode->count == 0)
+            {
+                NV_ASSERT(pTreeNode == pMap->pBTreeRoot);
+                pMap->pBTreeRoot = pTreeNode->pSlots[0];
+                PORT_FREE(pMap->pBTreeAllocator, pTreeNode);
+                pTreeNode = pMap->pBTreeRoot;
+                continue;
+            }
+        }
+
+        pTreeNode = pTreeNode->pSlots[i];
+    }
+
+    i = _mapBTreeLeafIndex(pTreeNode, key);
+    NV_ASSERT_OR_RETURN_VOID((i < pTreeNode->count) && (pTreeNode->pSlots[i] == pNode));
+
+    portMemMove(&pTreeNode->keys[i], sizeof(NvU64) * (pTreeNode->count - i - 1),
+                &pTreeNode->keys[i + 1], sizeof(NvU64) * (pTreeNode->count - i - 1));
+    portMemMove(&pTreeNode->pSlots[i], sizeof(void *) * (pTreeNode->count - i - 1),
+                &pTreeNode->pSlots[i + 1], sizeof(void *) * (pTreeNode->count - i - 1));
+    pTreeNode->count--;
+
+    if (pTreeNode->count == 0)
+    {
+        NV_ASSERT(pTreeNode == pMap->pBTreeRoot);
+        PORT_FREE(pMap->pBTreeAllocator, pTreeNode);
+        pMap->pBTreeRoot = NULL;
+    }
+
+    if (pNode->pLeft != NULL)
+        pNode->pLeft->pRight = pNode->pRight;
+    if (pNode->pRight != NULL)
+        pNode->pRight->pLeft = pNode->pLeft;
+    pNode->pLeft  = NULL;
+    pNode->pRight = NULL;
+}
+
+static void _mapBTreeFreeNodes
+(
+    MapBase      *pMap,
+    MapBTreeNode *pTreeNode
+)
+{
+    NvU32 i;
+
+    if (!pTreeNode->bLeaf)
+    {
+        for (i = 0; i <= pTreeNode->count; i++)
+            _mapBTreeFreeNodes(pMap, pTreeNode->pSlots[i]);
+    }
+
+    PORT_FREE(pMap->pBTreeAllocator, pTreeNode);
+}
+
+static void _mapBTreeDestroy
+(
+    MapBase            *pMap,
+    PORT_MEM_ALLOCATOR *pAllocator
+)
+{
+    MapNode *pNode = _mapBTreeFindGEQ(pMap, 0);
+
+    while (pNode != NULL)
+    {
+        MapNode *pNext = pNode->pRight;
+
+        pNode->pLeft  = NULL;
+        pNode->pRight = NULL;
+        NV_CHECKED_ONLY(pNode->pMap = NULL);
+        if (NULL != pAllocator)
+        {
+            PORT_FREE(pAllocator, pNode);
+        }
+
+        pNode = pNext;
+    }
+
+    if (pMap->pBTreeRoot != NULL)
+        _mapBTreeFreeNodes(pMap, pMap->pBTreeRoot);
+
+    pMap->pBTreeRoot = NULL;
+    pMap->count = 0;
+    NV_CHECKED_ONLY(pMap->versionNumber++);
+}
+
 NvBool mapIsValid_IMPL(void *pMap)
 {
 #if NV_TYPEOF_SUPPORTED
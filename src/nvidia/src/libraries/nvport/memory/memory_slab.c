@@ -0,0 +1,534 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ * @brief MEMORY module size-class slab allocator
+ *
+ * Requests are rounded up to a power-of-two block, including an 8 byte
+ * header that records the size class. Freed blocks are cached in
+ * magazines: each CPU owns two magazines per size class, and a per-class
+ * depot holds full magazines and spare empty ones. A CPU only touches the
+ * depot when both of its magazines are empty (on alloc) or full (on free),
+ * so most calls take just the uncontended per-CPU lock.
+ */
+
+#include "nvport/nvport.h"
+
+#if !PORT_IS_MODULE_SUPPORTED(sync)
+#error "SYNC module must be present for the slab allocator"
+#endif
+
+/// Blocks of the smallest size class are 32 bytes, header included
+#define PORT_MEM_SLAB_MIN_BLOCK_SHIFT   5
+#define PORT_MEM_SLAB_HEADER_SIZE       sizeof(NvU64)
+#define PORT_MEM_SLAB_BLOCK_SIZE(c)     (((NvLength)1) << (PORT_MEM_SLAB_MIN_BLOCK_SHIFT + (c)))
+
+/// Size class recorded in the header of blocks passed through to the parent
+#define PORT_MEM_SLAB_LARGE             PORT_MEM_SLAB_SIZE_CLASS_COUNT
+
+/// Number of blocks held by one magazine
+#define PORT_MEM_SLAB_MAGAZINE_SIZE     16
+/// Number of full magazines a depot keeps before frees go to the parent
+#define PORT_MEM_SLAB_DEPOT_MAX_FULL    4
+
+typedef struct PORT_MEM_SLAB_MAGAZINE
+{
+    struct PORT_MEM_SLAB_MAGAZINE *pNext;
+    NvU32                          count;
+    void                          *pBlocks[PORT_MEM_SLAB_MAGAZINE_SIZE];
+} PORT_MEM_SLAB_MAGAZINE;
+
+typedef struct PORT_MEM_SLAB_CPU_CACHE
+{
+    PORT_SPINLOCK           *pLock;
+    PORT_MEM_SLAB_MAGAZINE  *pLoaded;
+    PORT_MEM_SLAB_MAGAZINE  *pPrevious;
+    PORT_MEM_SLAB_STATS      stats;
+} PORT_MEM_SLAB_CPU_CACHE;
+
+typedef struct PORT_MEM_SLAB_CLASS
+{
+    PORT_SPINLOCK           *pDepotLock;
+    PORT_MEM_SLAB_MAGAZINE  *pFull;
+    PORT_MEM_SLAB_MAGAZINE  *pEmpty;
+    NvU32                    fullCount;
+    PORT_MEM_SLAB_CPU_CACHE *pCpuCaches;
+} PORT_MEM_SLAB_CLASS;
+
+typedef struct PORT_MEM_SLAB
+{
+    PORT_MEM_ALLOCATOR      *pParent;
+    NvU32                    cpuCount;
+    PORT_MEM_SLAB_CLASS      classes[PORT_MEM_SLAB_SIZE_CLASS_COUNT];
+} PORT_MEM_SLAB;
+
+static void *_portMemSlabAlloc(PORT_MEM_ALLOCATOR *pAlloc, NvLength length);
+static void _portMemSlabFree(PORT_MEM_ALLOCATOR *pAlloc, void *pMem);
+static void _portMemSlabRelease(PORT_MEM_ALLOCATOR *pAlloc);
+
+static NV_INLINE PORT_MEM_SLAB *
+_portMemSlabFromAllocator
+(
+    PORT_MEM_ALLOCATOR *pAlloc
+)
+{
+    return (PORT_MEM_SLAB *)pAlloc->pImpl;
+}
+
+static NV_INLINE NvU32
+_portMemSlabSizeClass
+(
+    NvLength length
+)
+{
+    NvLength blockSize = length + PORT_MEM_SLAB_HEADER_SIZE;
+    NvU32 shift;
+
+    if ((blockSize < length) ||
+        (blockSize > PORT_MEM_SLAB_BLOCK_SIZE(PORT_MEM_SLAB_SIZE_CLASS_COUNT - 1)))
+    {
+        return PORT_MEM_SLAB_LARGE;
+    }
+
+    if (blockSize <= PORT_MEM_SLAB_BLOCK_SIZE(0))
+        return 0;
+
+    // Round up to the next power of two
+    shift = 64 - portUtilCountLeadingZeros64(blockSize - 1);
+    return shift - PORT_MEM_SLAB_MIN_BLOCK_SHIFT;
+}
+
+static PORT_MEM_SLAB_MAGAZINE *
+_portMemSlabMagazineCreate
+(
+    PORT_MEM_SLAB *pSlab
+)
+{
+    PORT_MEM_SLAB_MAGAZINE *pMagazine;
+
+    pMagazine = PORT_ALLOC(pSlab->pParent, sizeof(*pMagazine));
+    if (pMagazine != NULL)
+        portMemSet(pMagazine, 0, sizeof(*pMagazine));
+
+    return pMagazine;
+}
+
+static void
+_portMemSlabMagazineDestroy
+(
+    PORT_MEM_SLAB          *pSlab,
+    PORT_MEM_SLAB_MAGAZINE *pMagazine
+)
+{
+    NvU32 i;
+
+    if (pMagazine == NULL)
+        return;
+
+    for (i = 0; i < pMagazine->count; i++)
+        PORT_FREE(pSlab->pParent, pMagazine->pBlocks[i]);
+
+    PORT_FREE(pSlab->pParent, pMagazine);
+}
+
+/**
+ * @brief Take a cached block of the given size class, or NULL on a miss.
+ */
+static void *
+_portMemSlabCacheAlloc
+(
+    PORT_MEM_SLAB *pSlab,
+    NvU32          sizeClass
+)
+{
+    PORT_MEM_SLAB_CLASS     *pClass = &pSlab->classes[sizeClass];
+    PORT_MEM_SLAB_CPU_CACHE *pCache;
+    PORT_MEM_SLAB_MAGAZINE  *pMagazine;
+    void                    *pBlock = NULL;
+
+    pCache = &pClass->pCpuCaches[_portMemGetCurrentCpu() % pSlab->cpuCount];
+
+    portSyncSpinlockAcquire(pCache->pLock);
+
+    pCache->stats.allocs++;
+
+    if ((pCache->pLoaded->count == 0) && (pCache->pPrevious->count != 0))
+    {
+        pMagazine          = pCache->pLoaded;
+        pCache->pLoaded    = pCache->pPrevious;
+        pCache->pPrevious  = pMagazine;
+    }
+
+    if (pCache->pLoaded->count == 0)
+    {
+        // Both magazines are empty; trade one for a full one from the depot
+        portSyncSpinlockAcquire(pClass->pDepotLock);
+        if (pClass->pFull != NULL)
+        {
+            pMagazine       = pClass->pFull;
+            pClass->pFull   = pMagazine->pNext;
+            pClass->fullCount--;
+
+            pCache->pPrevious->pNext = pClass->pEmpty;
+            pClass->pEmpty           = pCache->pPrevious;
+
+            pCache->pPrevious = pCache->pLoaded;
+            pCache->pLoaded   = pMagazine;
+            pCache->stats.depotExchanges++;
+        }
+        portSyncSpinlockRelease(pClass->pDepotLock);
+    }
+
+    if (pCache->pLoaded->count != 0)
+        pBlock = pCache->pLoaded->pBlocks[--pCache->pLoaded->count];
+    else
+        pCache->stats.cacheMisses++;
+
+    portSyncSpinlockRelease(pCache->pLock);
+
+    return pBlock;
+}
+
+/**
+ * @brief Cache a freed block of the given size class.
+ * @return NV_FALSE if the block must be returned to the parent instead.
+ */
+static NvBool
+_portMemSlabCacheFree
+(
+    PORT_MEM_SLAB *pSlab,
+    NvU32          sizeClass,
+    void          *pBlock
+)
+{
+    PORT_MEM_SLAB_CLASS     *pClass = &pSlab->classes[sizeClass];
+    PORT_MEM_SLAB_CPU_CACHE *pCache;
+    PORT_MEM_SLAB_MAGAZINE  *pMagazine;
+    PORT_MEM_SLAB_MAGAZINE  *pSpare = NULL;
+    NvBool                   bTriedSpare = NV_FALSE;
+    NvBool                   bCached;
+
+    for (;;)
+    {
+        NvBool bDepotFull = NV_FALSE;
+
+        pCache = &pClass->pCpuCaches[_portMemGetCurrentCpu() % pSlab->cpuCount];
+
+        portSyncSpinlockAcquire(pCache->pLock);
+
+        if ((pCache->pLoaded->count == PORT_MEM_SLAB_MAGAZINE_SIZE) &&
+            (pCache->pPrevious->count != PORT_MEM_SLAB_MAGAZINE_SIZE))
+        {
+            pMagazine          = pCache->pLoaded;
+            pCache->pLoaded    = pCache->pPrevious;
+            pCache->pPrevious  = pMagazine;
+        }
+
+        if (pCache->pLoaded->count == PORT_MEM_SLAB_MAGAZINE_SIZE)
+        {
+            // Both magazines are full; trade one for an empty one from the depot
+            portSyncSpinlockAcquire(pClass->pDepotLock);
+            if (pClass->fullCount < PORT_MEM_SLAB_DEPOT_MAX_FULL)
+            {
+                if ((pClass->pEmpty == NULL) && (pSpare != NULL))
+                {
+                    pSpare->pNext  = NULL;
+                    pClass->pEmpty = pSpare;
+                    pSpare         = NULL;
+                }
+
+                if (pClass->pEmpty != NULL)
+                {
+                    pMagazine      = pClass->pEmpty;
+                    pClass->pEmpty = pMagazine->pNext;
+
+                    pCache->pPrevious->pNext = pClass->pFull;
+                    pClass->pFull            = pCache->pPrevious;
+                    pClass->fullCount++;
+
+                    pCache->pPrevious = pCache->pLoaded;
+                    pCache->pLoaded   = pMagazine;
+                    pCache->stats.depotExchanges++;
+                }
+            }
+            bDepotFull = (pClass->fullCount >= PORT_MEM_SLAB_DEPOT_MAX_FULL);
+            portSyncSpinlockRelease(pClass->pDepotLock);
+        }
+
+        if (pCache->pLoaded->count != PORT_MEM_SLAB_MAGAZINE_SIZE)
+        {
+            pCache->pLoaded->pBlocks[pCache->pLoaded->count++] = pBlock;
+            pCache->stats.frees++;
+            bCached = NV_TRUE;
+        }
+        else if (bDepotFull || bTriedSpare)
+        {
+            pCache->stats.frees++;
+            pCache->stats.cacheOverflows++;
+            bCached = NV_FALSE;
+        }
+        else
+        {
+            // The depot has room but no empty magazine; make one unlocked
+            portSyncSpinlockRelease(pCache->pLock);
+            pSpare = _portMemSlabMagazineCreate(pSlab);
+            bTriedSpare = NV_TRUE;
+            continue;
+        }
+
+        portSyncSpinlockRelease(pCache->pLock);
+        break;
+    }
+
+    if (pSpare != NULL)
+        PORT_FREE(pSlab->pParent, pSpare);
+
+    return bCached;
+}
+
+static void *
+_portMemSlabAlloc
+(
+    PORT_MEM_ALLOCATOR *pAlloc,
+    NvLength            length
+)
+{
+    PORT_MEM_SLAB *pSlab     = _portMemSlabFromAllocator(pAlloc);
+    NvU32          sizeClass = _portMemSlabSizeClass(length);
+    NvU64         *pHeader;
+    NvLength       blockSize;
+
+    if (sizeClass != PORT_MEM_SLAB_LARGE)
+    {
+        pHeader = _portMemSlabCacheAlloc(pSlab, sizeClass);
+        if (pHeader != NULL)
+            return pHeader + 1;
+
+        blockSize = PORT_MEM_SLAB_BLOCK_SIZE(sizeClass);
+    }
+    else if (!portSafeAddLength(length, PORT_MEM_SLAB_HEADER_SIZE, &blockSize))
+    {
+        return NULL;
+    }
+
+    pHeader = PORT_ALLOC(pSlab->pParent, blockSize);
+    if (pHeader == NULL)
+        return NULL;
+
+    *pHeader = sizeClass;
+    return pHeader + 1;
+}
+
+static void
+_portMemSlabFree
+(
+    PORT_MEM_ALLOCATOR *pAlloc,
+    void               *pMem
+)
+{
+    PORT_MEM_SLAB *pSlab   = _portMemSlabFromAllocator(pAlloc);
+    NvU64         *pHeader = (NvU64 *)pMem - 1;
+    NvU32          sizeClass = (NvU32)*pHeader;
+
+    PORT_ASSERT_CHECKED(sizeClass <= PORT_MEM_SLAB_LARGE);
+
+    if ((sizeClass == PORT_MEM_SLAB_LARGE) ||
+        !_portMemSlabCacheFree(pSlab, sizeClass, pHeader))
+    {
+        PORT_FREE(pSlab->pParent, pHeader);
+    }
+}
+
+/**
+ * @brief Free everything the slab owns, including a partially constructed one.
+ */
+static void
+_portMemSlabDestroy
+(
+    PORT_MEM_ALLOCATOR *pAlloc
+)
+{
+    PORT_MEM_SLAB *pSlab = _portMemSlabFromAllocator(pAlloc);
+    NvU32 c, cpu;
+
+    for (c = 0; c < PORT_MEM_SLAB_SIZE_CLASS_COUNT; c++)
+    {
+        PORT_MEM_SLAB_CLASS *pClass = &pSlab->classes[c];
+
+        for (cpu = 0; cpu < pSlab->cpuCount; cpu++)
+        {
+            PORT_MEM_SLAB_CPU_CACHE *pCache = &pClass->pCpuCaches[cpu];
+
+            _portMemSlabMagazineDestroy(pSlab, pCache->pLoaded);
+            _portMemSlabMagazineDestroy(pSlab, pCache->pPrevious);
+            if (pCache->pLock != NULL)
+                portSyncSpinlockDestroy(pCache->pLock);
+        }
+
+        while (pClass->pFull != NULL)
+        {
+            PORT_MEM_SLAB_MAGAZINE *pNext = pClass->pFull->pNext;
+            _portMemSlabMagazineDestroy(pSlab, pClass->pFull);
+            pClass->pFull = pNext;
+        }
+
+        while (pClass->pEmpty != NULL)
+        {
+            PORT_MEM_SLAB_MAGAZINE *pNext = pClass->pEmpty->pNext;
+            _portMemSlabMagazineDestroy(pSlab, pClass->pEmpty);
+            pClass->pEmpty = pNext;
+        }
+
+        if (pClass->pDepotLock != NULL)
+            portSyncSpinlockDestroy(pClass->pDepotLock);
+    }
+
+    PORT_FREE(pSlab->pParent, pAlloc);
+}
+
+static void
+_portMemSlabRelease
+(
+    PORT_MEM_ALLOCATOR *pAlloc
+)
+{
+    _portMemSlabDestroy(pAlloc);
+}
+
+PORT_MEM_ALLOCATOR *
+portMemExAllocatorCreateSlab
+(
+    PORT_MEM_ALLOCATOR *pParent
+)
+{
+    PORT_MEM_ALLOCATOR          *pAllocator;
+    PORT_MEM_ALLOCATOR_TRACKING *pTracking;
+    PORT_MEM_SLAB               *pSlab;
+    PORT_MEM_SLAB_CPU_CACHE     *pCpuCaches;
+    NvU32                        cpuCount = _portMemGetCpuCount();
+    NvLength                     size;
+    NvU32                        c, cpu;
+
+    if (pParent == NULL)
+    {
+        PORT_BREAKPOINT_CHECKED();
+        return NULL;
+    }
+
+    if (cpuCount == 0)
+        cpuCount = 1;
+
+    size = sizeof(PORT_MEM_ALLOCATOR) + sizeof(PORT_MEM_ALLOCATOR_TRACKING) +
+           sizeof(PORT_MEM_SLAB) +
+           sizeof(PORT_MEM_SLAB_CPU_CACHE) * PORT_MEM_SLAB_SIZE_CLASS_COUNT * cpuCount;
+
+    pAllocator = PORT_ALLOC(pParent, size);
+    if (pAllocator == NULL)
+        return NULL;
+
+    portMemSet(pAllocator, 0, size);
+    pTracking  = (PORT_MEM_ALLOCATOR_TRACKING *)(pAllocator + 1);
+    pSlab      = (PORT_MEM_SLAB *)(pTracking + 1);
+    pCpuCaches = (PORT_MEM_SLAB_CPU_CACHE *)(pSlab + 1);
+
+    pAllocator->pImpl        = (PORT_MEM_ALLOCATOR_IMPL *)pSlab;
+    pAllocator->_portAlloc   = _portMemSlabAlloc;
+    pAllocator->_portFree    = _portMemSlabFree;
+    pAllocator->_portRelease = _portMemSlabRelease;
+
+    pSlab->pParent  = pParent;
+    pSlab->cpuCount = cpuCount;
+
+    for (c = 0; c < PORT_MEM_SLAB_SIZE_CLASS_COUNT; c++)
+    {
+        PORT_MEM_SLAB_CLASS *pClass = &pSlab->classes[c];
+
+        pClass->pCpuCaches = &pCpuCaches[c * cpuCount];
+        pClass->pDepotLock = portSyncSpinlockCreate(pParent);
+        if (pClass->pDepotLock == NULL)
+            goto fail;
+
+        for (cpu = 0; cpu < cpuCount; cpu++)
+        {
+            PORT_MEM_SLAB_CPU_CACHE *pCache = &pClass->pCpuCaches[cpu];
+
+            pCache->stats.objectSize = PORT_MEM_SLAB_BLOCK_SIZE(c) - PORT_MEM_SLAB_HEADER_SIZE;
+            pCache->pLock     = portSyncSpinlockCreate(pParent);
+            pCache->pLoaded   = _portMemSlabMagazineCreate(pSlab);
+            pCache->pPrevious = _portMemSlabMagazineCreate(pSlab);
+            if ((pCache->pLock == NULL) || (pCache->pLoaded == NULL) ||
+                (pCache->pPrevious == NULL))
+            {
+                goto fail;
+            }
+        }
+    }
+
+    portMemInitializeAllocatorTracking(pAllocator, pTracking);
+    return pAllocator;
+
+fail:
+    _portMemSlabDestroy(pAllocator);
+    return NULL;
+}
+
+NV_STATUS
+portMemExSlabGetStats
+(
+    PORT_MEM_ALLOCATOR  *pAllocator,
+    NvU32                sizeClass,
+    PORT_MEM_SLAB_STATS *pStats
+)
+{
+    PORT_MEM_SLAB       *pSlab;
+    PORT_MEM_SLAB_CLASS *pClass;
+    NvU32                cpu;
+
+    if ((pAllocator == NULL) || (pAllocator->_portAlloc != _portMemSlabAlloc) ||
+        (sizeClass >= PORT_MEM_SLAB_SIZE_CLASS_COUNT) || (pStats == NULL))
+    {
+        return NV_ERR_INVALID_ARGUMENT;
+    }
+
+    pSlab  = _portMemSlabFromAllocator(pAllocator);
+    pClass = &pSlab->classes[sizeClass];
+
+    portMemSet(pStats, 0, sizeof(*pStats));
+    pStats->objectSize = PORT_MEM_SLAB_BLOCK_SIZE(sizeClass) - PORT_MEM_SLAB_HEADER_SIZE;
+
+    for (cpu = 0; cpu < pSlab->cpuCount; cpu++)
+    {
+        PORT_MEM_SLAB_CPU_CACHE *pCache = &pClass->pCpuCaches[cpu];
+
+        portSyncSpinlockAcquire(pCache->pLock);
+        pStats->allocs         += pCache->stats.allocs;
+        pStats->frees          += pCache->stats.frees;
+        pStats->cacheMisses    += pCache->stats.cacheMisses;
+        pStats->cacheOverflows += pCache->stats.cacheOverflows;
+        pStats->depotExchanges += pCache->stats.depotExchanges;
+        portSyncSpinlockRelease(pCache->pLock);
+    }
+
+    return NV_OK;
+}
@@ -76,6 +76,22 @@ _portMemFreeUntracked
     }
 }
 
+NvU32
+_portMemGetCpuCount(void)
+{
+    return os_get_cpu_count();
+}
+
+/**
+ * @note The caller may be migrated right after this returns; the result is
+ *       only a hint for picking a per-CPU cache.
+ */
+NvU32
+_portMemGetCurrentCpu(void)
+{
+    return os_get_cpu_number();
+}
+
 void *
 portMemCopy
 (
@@ -102,7 +102,7 @@ clientConstruct_IMPL
     pClient->type = type;
     pClient->hClient = pParams->hClient;
 
-    mapInit(&pClient->resourceMap, pAllocator);
+    mapInitBTree(&pClient->resourceMap, pAllocator);
     listInitIntrusive(&pClient->pendingFreeList);
 
     listInit(&pClient->accessBackRefList, pAllocator);
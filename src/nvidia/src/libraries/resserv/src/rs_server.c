@@ -48,19 +48,36 @@ static NV_STATUS _serverFindClient(RsServer *pServer, NvHandle hClient, RsClient
 static NV_STATUS _serverFindClientEntry(RsServer *pServer, NvHandle hClient, NvBool bFindPartial, CLIENT_ENTRY **ppClientEntry);
 
 /**
- * Insert a CLIENT_ENTRY in the server database without taking locks
+ * Insert a CLIENT_ENTRY with a caller-chosen handle in the server database.
+ * Takes the shard lock.
  * @param[in]   pServer
  * @param[in]   pClientEntry The client entry associated with the handle
  */
-static NV_STATUS _serverInsertClientEntry(RsServer *pServer, CLIENT_ENTRY *pClientEntry, CLIENT_ENTRY **ppClientNext);
+static NV_STATUS _serverInsertClientEntry(RsServer *pServer, CLIENT_ENTRY *pClientEntry);
 
 /**
- * Find the next available client handle in bucket.
+ * Remove a CLIENT_ENTRY from the server database and release its handle.
+ * Takes the shard lock.
  * @param[in]   pServer
- * @param[in]   hClientIn
- * @param[out]  pClientOut
+ * @param[in]   pClientEntry The client entry to remove
+ * @param[in]   hClient The handle the entry was inserted with
  */
-static NV_STATUS _serverFindNextAvailableClientHandleInBucket(RsServer *pServer, NvHandle hClientIn, NvHandle *phClientOut, CLIENT_ENTRY  ***pppClientNext);
+static void _serverRemoveClientEntry(RsServer *pServer, CLIENT_ENTRY *pClientEntry, NvHandle hClient);
+
+/**
+ * Pick a free client handle and insert the CLIENT_ENTRY under it.
+ * Takes the shard lock.
+ * @param[in]   pServer
+ * @param[in]   hBase Handle prefix to encode the new handle with
+ * @param[in]   pClientEntry The client entry; hClient is filled in on success
+ */
+static NV_STATUS _serverAllocClientHandle(RsServer *pServer, NvHandle hBase, CLIENT_ENTRY *pClientEntry);
+
+/**
+ * Free the per-shard locks and bitmaps of the client database.
+ * @param[in]   pServer
+ */
+static void _serverDestroyClientShards(RsServer *pServer);
 
 /**
  * Create a client entry and a client lock for a client that does not exist yet. Used during client
@@ -208,6 +225,19 @@ NV_STATUS serverFreeResourceRpcUnderLock(RsServer *pServer, RS_RES_FREE_PARAMS *
 #define CLIENT_ENCODEHANDLE(index)                  (RS_CLIENT_HANDLE_BASE | index)
 #define CLIENT_ENCODEHANDLE_INTERNAL(internalBase, index)   (internalBase | index)
 
+//
+// Each shard owns the handle indices whose low bits match its number, and
+// tracks which of them are in use in a bitmap. A second, smaller bitmap
+// marks the words of the first that are full so a free index can be found
+// without walking the whole map.
+//
+#define RS_CLIENT_SHARD_INDEX_COUNT     ((RS_CLIENT_HANDLE_DECODE_MASK + 1) / RS_CLIENT_HANDLE_SHARD_COUNT)
+#define RS_CLIENT_SHARD_BITMAP_WORDS    (RS_CLIENT_SHARD_INDEX_COUNT / 64)
+#define RS_CLIENT_SHARD_SUMMARY_WORDS   (RS_CLIENT_SHARD_BITMAP_WORDS / 64)
+
+#define CLIENT_SHARD(pServer, handle)       (&(pServer)->pClientShards[(handle) & RS_CLIENT_HANDLE_SHARD_MASK])
+#define CLIENT_SHARD_INDEX(handle)          (CLIENT_DECODEHANDLE(handle) / RS_CLIENT_HANDLE_SHARD_COUNT)
+
 NV_STATUS
 serverConstruct
 (
@@ -217,7 +247,14 @@ serverConstruct
 )
 {
     NvU32 i;
-    PORT_MEM_ALLOCATOR *pAllocator = portMemAllocatorCreateNonPaged();
+    PORT_MEM_ALLOCATOR *pAllocator = NULL;
+
+#if PORT_IS_FUNC_SUPPORTED(portMemExAllocatorCreateSlab)
+    // Clients, refs and their map nodes churn in small fixed sizes
+    pAllocator = portMemExAllocatorCreateSlab(portMemAllocatorGetGlobalNonPaged());
+#endif
+    if (pAllocator == NULL)
+        pAllocator = portMemAllocatorCreateNonPaged();
 
     pServer->privilegeLevel     = privilegeLevel;
     pServer->bConstructed       = NV_TRUE;
@@ -236,14 +273,32 @@ serverConstruct
 
     for (i = 0; i < RS_CLIENT_HANDLE_BUCKET_COUNT; i++)
     {
-        listInit(&pServer->pClientSortedList[i], pAllocator);
+        listInitIntrusive(&pServer->pClientSortedList[i]);
     }
     pServer->clientCurrentHandleIndex = 0;
 
-    pServer->pClientListLock = portSyncRwLockCreate(pAllocator);
-    if (pServer->pClientListLock == NULL)
+    pServer->pClientShards = PORT_ALLOC(pAllocator, sizeof(RS_CLIENT_SHARD)*RS_CLIENT_HANDLE_SHARD_COUNT);
+    if (pServer->pClientShards == NULL)
         goto fail;
 
+    portMemSet(pServer->pClientShards, 0, sizeof(RS_CLIENT_SHARD)*RS_CLIENT_HANDLE_SHARD_COUNT);
+    for (i = 0; i < RS_CLIENT_HANDLE_SHARD_COUNT; i++)
+    {
+        RS_CLIENT_SHARD *pShard = &pServer->pClientShards[i];
+        NvLength bitmapSize = sizeof(NvU64) * (RS_CLIENT_SHARD_BITMAP_WORDS + RS_CLIENT_SHARD_SUMMARY_WORDS);
+
+        pShard->pLock = portSyncSpinlockCreate(pAllocator);
+        if (pShard->pLock == NULL)
+            goto fail;
+
+        pShard->pHandleBitmap = PORT_ALLOC(pAllocator, bitmapSize);
+        if (pShard->pHandleBitmap == NULL)
+            goto fail;
+
+        portMemSet(pShard->pHandleBitmap, 0, bitmapSize);
+        pShard->pFullWordMask = pShard->pHandleBitmap + RS_CLIENT_SHARD_BITMAP_WORDS;
+    }
+
 #if RS_STANDALONE
     RS_LOCK_VALIDATOR_INIT(&pServer->topLockVal, LOCK_VAL_LOCK_CLASS_API, 0xdead0000);
     pServer->pTopLock = portSyncRwLockCreate(pAllocator);
@@ -284,8 +339,7 @@ fail:
         portSyncRwLockDestroy(pServer->pTopLock);
 #endif
 
-    if (pServer->pClientListLock != NULL)
-        portSyncRwLockDestroy(pServer->pClientListLock);
+    _serverDestroyClientShards(pServer);
 
     if (pServer->pShareMapLock != NULL)
         portSyncSpinlockDestroy(pServer->pShareMapLock);
@@ -321,13 +375,13 @@ serverDestruct
 
     for (i = 0; i < RS_CLIENT_HANDLE_BUCKET_COUNT; i++)
     {
-        CLIENT_ENTRY **ppClientEntry;
+        CLIENT_ENTRY *pClientEntry;
         NvHandle hClient = 0;
 
-        while ((ppClientEntry = listHead(&pServer->pClientSortedList[i])) != NULL)
+        while ((pClientEntry = listHead(&pServer->pClientSortedList[i])) != NULL)
         {
             RS_RES_FREE_PARAMS_INTERNAL freeParams;
-            lockInfo.pClient = (*ppClientEntry)->pClient;
+            lockInfo.pClient = pClientEntry->pClient;
             hClient = lockInfo.pClient->hClient;
             serverInitFreeParams_Recursive(hClient, hClient, &lockInfo, &freeParams);
             serverFreeResourceTree(pServer, &freeParams);
@@ -347,7 +401,7 @@ serverDestruct
 #endif
 
     portSyncSpinlockDestroy(pServer->pShareMapLock);
-    portSyncRwLockDestroy(pServer->pClientListLock);
+    _serverDestroyClientShards(pServer);
 
     portMemAllocatorRelease(pServer->pAllocator);
 
@@ -368,6 +422,7 @@ _serverFreeClient_underlock
     NvHandle hClient;
     NV_STATUS status;
     PORT_RWLOCK *pLock = NULL;
+    RS_CLIENT_SHARD *pShard;
 
     status =_serverFindClientEntry(pServer, pClient->hClient, NV_FALSE, &pClientEntry);
     if (status != NV_OK)
@@ -378,14 +433,19 @@ _serverFreeClient_underlock
     NV_ASSERT(pClientEntry->pClient != NULL);
 
     hClient = pClient->hClient;
+    pShard = CLIENT_SHARD(pServer, hClient);
+
+    // Hide the entry from lookups while the client is torn down
+    portSyncSpinlockAcquire(pShard->pLock);
     pClientEntry->pClient = NULL;
     pClientEntry->hClient = 0;
+    portSyncSpinlockRelease(pShard->pLock);
 
     clientFreeAccessBackRefs(pClient, pServer);
 
     objDelete(pClient);
 
-    listRemoveFirstByValue(&pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK], &pClientEntry);
+    _serverRemoveClientEntry(pServer, pClientEntry, hClient);
     pLock = pClientEntry->pLock;
 
     RS_RWLOCK_RELEASE_WRITE_EXT(pLock, &pClientEntry->lockVal, NV_TRUE);
@@ -417,23 +477,26 @@ serverFreeDomain
     NvU32 bucket;
     for (bucket = 0; bucket < RS_CLIENT_HANDLE_BUCKET_COUNT; bucket ++)
     {
-        RsClientList  *pClientList = &(pServer->pClientSortedList[bucket]);
-        CLIENT_ENTRY **ppClientEntry = listHead(pClientList);
-        while (ppClientEntry != NULL)
+        RsClientList    *pClientList = &(pServer->pClientSortedList[bucket]);
+        RS_CLIENT_SHARD *pShard      = CLIENT_SHARD(pServer, bucket);
+
+        for (;;)
         {
-            CLIENT_ENTRY *pClientEntry = *ppClientEntry;
+            CLIENT_ENTRY *pClientEntry;
             RS_CLIENT_FREE_PARAMS params;
 
             portMemSet(&params, 0, sizeof(params));
+
+            portSyncSpinlockAcquire(pShard->pLock);
+            pClientEntry = listHead(pClientList);
+            if (pClientEntry != NULL)
+                params.hClient = pClientEntry->hClient;
+            portSyncSpinlockRelease(pShard->pLock);
+
             if (pClientEntry == NULL)
-            {
-                ppClientEntry = listNext(pClientList, ppClientEntry);
-                continue;
-            }
-            params.hClient = pClientEntry->hClient;
+                break;
 
             serverFreeClient(pServer, &params);
-            ppClientEntry = listHead(pClientList);
         }
     }
     return NV_OK;
@@ -523,11 +586,12 @@ done:
     if (bLockedClient)
         _serverUnlockClient(pServer, LOCK_ACCESS_WRITE, pParams->hClient);
 
-    if ((status != NV_OK) && (status != NV_ERR_INSERT_DUPLICATE_NAME) && (hClient != 0))
+    // Only tear down the entry if this call created it
+    if ((status != NV_OK) && bLockedClient)
     {
         if (_serverFindClientEntry(pServer, hClient, NV_TRUE, &pClientEntry) == NV_OK)
         {
-            listRemoveFirstByValue(&pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK], &pClientEntry);
+            _serverRemoveClientEntry(pServer, pClientEntry, hClient);
             portSyncRwLockDestroy(pClientEntry->pLock);
             PORT_FREE(pServer->pAllocator, pClientEntry);
         }
@@ -1930,7 +1994,7 @@ serverReleaseClient
 
 static
 NV_STATUS
-_serverFindClientEntry
+_serverFindClientEntryUnderLock
 (
     RsServer      *pServer,
     NvHandle       hClient,
@@ -1938,21 +2002,15 @@ _serverFindClientEntry
     CLIENT_ENTRY **ppClientEntry
 )
 {
-    RsClientList  *pClientList       = &(pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK]);
-    CLIENT_ENTRY **ppClientEntryLoop = listHead(pClientList);
+    RsClientList  *pClientList  = &(pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK]);
+    CLIENT_ENTRY  *pClientEntry = listHead(pClientList);
 
     if (ppClientEntry != NULL)
         *ppClientEntry = NULL;
 
-    while (ppClientEntryLoop != NULL)
+    for (; pClientEntry != NULL; pClientEntry = listNext(pClientList, pClientEntry))
     {
-        CLIENT_ENTRY *pClientEntry = *ppClientEntryLoop;
-        ppClientEntryLoop = listNext(pClientList, ppClientEntryLoop);
-        if (pClientEntry == NULL)
-        {
-            continue;
-        }
-        else if (pClientEntry->hClient == hClient)
+        if (pClientEntry->hClient == hClient)
         {
             // Client may not have finished constructing yet
             if (pClientEntry->pClient == NULL && !bFindPartial)
@@ -1973,6 +2031,28 @@ _serverFindClientEntry
     return NV_ERR_INVALID_OBJECT_HANDLE;
 }
 
+//
+// Lookups do not take the shard lock. Clients are only allocated and freed
+// with the top lock (the RM API lock) held for write, and callers hold it
+// at least for read, so no bucket changes under a lookup and the returned
+// entry stays valid. Taking the shard spinlock here only added a shared
+// cache line write to every lookup (see tests/rs_client_table_test.c).
+// Lock-bypass and raised-IRQL controls skip the top lock, so they can race
+// with a client free, as they could before the table was sharded.
+//
+static
+NV_STATUS
+_serverFindClientEntry
+(
+    RsServer      *pServer,
+    NvHandle       hClient,
+    NvBool         bFindPartial,
+    CLIENT_ENTRY **ppClientEntry
+)
+{
+    return _serverFindClientEntryUnderLock(pServer, hClient, bFindPartial, ppClientEntry);
+}
+
 static
 NV_STATUS
 _serverFindClient
@@ -1994,175 +2074,285 @@ _serverFindClient
     return NV_OK;
 }
 
-static
-NV_STATUS
-_serverInsertClientEntry
+static void
+_serverClientShardSetIndex
 (
-    RsServer      *pServer,
-    CLIENT_ENTRY  *pClientEntry,
-    CLIENT_ENTRY **ppClientNext
+    RS_CLIENT_SHARD *pShard,
+    NvU32            index
 )
 {
-    RsClientList  *pClientList;
-    CLIENT_ENTRY **ppClientEntry;
-    NvHandle       hClient = pClientEntry->hClient;
+    NvU32 word = index / 64;
 
-    if (hClient == 0)
+    pShard->pHandleBitmap[word] |= NVBIT64(index % 64);
+    if (pShard->pHandleBitmap[word] == NV_U64_MAX)
+        pShard->pFullWordMask[word / 64] |= NVBIT64(word % 64);
+}
+
+static void
+_serverClientShardClearIndex
+(
+    RS_CLIENT_SHARD *pShard,
+    NvU32            index
+)
+{
+    NvU32 word = index / 64;
+
+    pShard->pHandleBitmap[word] &= ~NVBIT64(index % 64);
+    pShard->pFullWordMask[word / 64] &= ~NVBIT64(word % 64);
+}
+
+/**
+ * Return the first word in [first, last) of the shard bitmap that still has a
+ * clear bit, or last if there is none.
+ */
+static NvU32
+_serverClientShardFindWord
+(
+    RS_CLIENT_SHARD *pShard,
+    NvU32            first,
+    NvU32            last
+)
+{
+    while (first < last)
     {
-        return NV_ERR_INVALID_OBJECT_HANDLE;
+        NvU64 notFull = ~pShard->pFullWordMask[first / 64] & (NV_U64_MAX << (first % 64));
+
+        if (notFull != 0)
+        {
+            NvU32 word = (first & ~63U) + portUtilCountTrailingZeros64(notFull);
+            return NV_MIN(word, last);
+        }
+
+        first = (first & ~63U) + 64;
     }
 
-    pClientList  = &(pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK]);
+    return last;
+}
 
-    if (ppClientNext == NULL)
+/**
+ * Find a clear bit in the shard bitmap, searching upwards from start and
+ * wrapping around once.
+ */
+static NvBool
+_serverClientShardFindFreeIndex
+(
+    RS_CLIENT_SHARD *pShard,
+    NvU32            start,
+    NvU32           *pIndex
+)
+{
+    NvU32 word = start / 64;
+    NvU64 freeBits = ~pShard->pHandleBitmap[word] & (NV_U64_MAX << (start % 64));
+
+    if (freeBits == 0)
     {
-        ppClientEntry = (CLIENT_ENTRY **)listAppendNew(pClientList);
+        word = _serverClientShardFindWord(pShard, word + 1, RS_CLIENT_SHARD_BITMAP_WORDS);
+        if (word == RS_CLIENT_SHARD_BITMAP_WORDS)
+        {
+            // Wrap around; this includes the bits of the first word below start
+            word = _serverClientShardFindWord(pShard, 0, (start / 64) + 1);
+            if (word == (start / 64) + 1)
+                return NV_FALSE;
+        }
+        freeBits = ~pShard->pHandleBitmap[word];
     }
-    else
+
+    *pIndex = (word * 64) + portUtilCountTrailingZeros64(freeBits);
+    return NV_TRUE;
+}
+
+static
+NV_STATUS
+_serverInsertClientEntryUnderLock
+(
+    RsServer      *pServer,
+    CLIENT_ENTRY  *pClientEntry
+)
+{
+    NvHandle       hClient     = pClientEntry->hClient;
+    RsClientList  *pClientList = &(pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK]);
+    CLIENT_ENTRY  *pClientNext;
+
+    //
+    // The list is ordered by increasing client handles. Entries that are
+    // being freed have a zero handle and sort first.
+    //
+    for (pClientNext = listHead(pClientList);
+         pClientNext != NULL;
+         pClientNext = listNext(pClientList, pClientNext))
     {
-        ppClientEntry = (CLIENT_ENTRY **)listInsertNew(pClientList, ppClientNext);
+        if (pClientNext->hClient == hClient)
+            return NV_ERR_INSERT_DUPLICATE_NAME;
+
+        if (pClientNext->hClient > hClient)
+            break;
     }
-    *ppClientEntry = pClientEntry;
+
+    if (pClientNext == NULL)
+        listAppendExisting(pClientList, pClientEntry);
+    else
+        listInsertExisting(pClientList, pClientNext, pClientEntry);
+
+    _serverClientShardSetIndex(CLIENT_SHARD(pServer, hClient), CLIENT_SHARD_INDEX(hClient));
 
     return NV_OK;
 }
 
 static
 NV_STATUS
-_serverFindNextAvailableClientHandleInBucket
+_serverInsertClientEntry
 (
-    RsServer        *pServer,
-    NvHandle         hClientIn,
-    NvHandle         *phClientOut,
-    CLIENT_ENTRY  ***pppClientNext
+    RsServer      *pServer,
+    CLIENT_ENTRY  *pClientEntry
 )
 {
-    NvHandle        hPrefixIn, hPrefixOut;
-    RsClientList   *pClientList  = &(pServer->pClientSortedList[hClientIn & RS_CLIENT_HANDLE_BUCKET_MASK]);
-    NvHandle        hClientOut   = hClientIn;
-    CLIENT_ENTRY **ppClientEntry = listHead(pClientList);
+    NvHandle         hClient = pClientEntry->hClient;
+    RS_CLIENT_SHARD *pShard;
+    NV_STATUS        status;
 
-    *pppClientNext = NULL;
-    if (ppClientEntry == NULL)
+    if (hClient == 0)
     {
-        *phClientOut = hClientOut;
-        return NV_OK;
+        return NV_ERR_INVALID_OBJECT_HANDLE;
     }
 
+    pShard = CLIENT_SHARD(pServer, hClient);
+
+    portSyncSpinlockAcquire(pShard->pLock);
+    status = _serverInsertClientEntryUnderLock(pServer, pClientEntry);
+    portSyncSpinlockRelease(pShard->pLock);
+
+    return status;
+}
+
+static void
+_serverRemoveClientEntry
+(
+    RsServer      *pServer,
+    CLIENT_ENTRY  *pClientEntry,
+    NvHandle       hClient
+)
+{
+    RsClientList    *pClientList = &(pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK]);
+    RS_CLIENT_SHARD *pShard      = CLIENT_SHARD(pServer, hClient);
+    CLIENT_ENTRY    *pOther;
+
+    portSyncSpinlockAcquire(pShard->pLock);
+
+    listRemove(pClientList, pClientEntry);
+
     //
-    // The list is ordered by increased client handles
-    // We need to find a value to insert or change the handle
+    // Handles with a different prefix (e.g. internal and external clients)
+    // share an index, so only release it when no other client uses it.
     //
-    while (ppClientEntry != NULL)
+    for (pOther = listHead(pClientList); pOther != NULL; pOther = listNext(pClientList, pOther))
     {
-        CLIENT_ENTRY *pClientEntry = *ppClientEntry;
-        if ((pClientEntry == NULL) || (pClientEntry->hClient < hClientOut))
-        {
-            ppClientEntry = listNext(pClientList, ppClientEntry);
-            continue;
-        }
-        else if (pClientEntry->hClient == hClientOut)
-        {
-            // Increase client handle by one unit in same bucket
-            hClientOut = hClientOut + RS_CLIENT_HANDLE_BUCKET_COUNT;
-            NV_ASSERT((hClientIn & RS_CLIENT_HANDLE_BUCKET_MASK) == (hClientOut & RS_CLIENT_HANDLE_BUCKET_MASK));
-        }
-        else // last pClientEntry->hClient > hClientOut
+        if ((pOther->hClient != 0) &&
+            (CLIENT_DECODEHANDLE(pOther->hClient) == CLIENT_DECODEHANDLE(hClient)))
         {
             break;
         }
-        ppClientEntry = listNext(pClientList, ppClientEntry);
     }
 
-    hPrefixIn = hClientIn & ~RS_CLIENT_HANDLE_DECODE_MASK;
-    hPrefixOut = hClientOut & ~RS_CLIENT_HANDLE_DECODE_MASK;
-    if (hPrefixIn != hPrefixOut)
-        return NV_ERR_INSUFFICIENT_RESOURCES;
+    if (pOther == NULL)
+        _serverClientShardClearIndex(pShard, CLIENT_SHARD_INDEX(hClient));
 
-    *phClientOut = hClientOut;
-    if (ppClientEntry != NULL)
-    {
-        *pppClientNext = ppClientEntry;
-    }
-    return  NV_OK;
+    portSyncSpinlockRelease(pShard->pLock);
 }
 
-
 static
 NV_STATUS
-_serverCreateEntryAndLockForNewClient
+_serverAllocClientHandle
 (
     RsServer      *pServer,
-    NvHandle      *phClient,
-    NvBool         bInternalHandle,
-    CLIENT_ENTRY **ppClientEntry
+    NvHandle       hBase,
+    CLIENT_ENTRY  *pClientEntry
 )
 {
-    CLIENT_ENTRY  *pClientEntry;
-    NV_STATUS      status = NV_OK;
-    NvHandle       hClient = *phClient;
-    CLIENT_ENTRY **ppClientNext = 0;
-    PORT_RWLOCK    *pLock=NULL;
+    //
+    // Each call takes the next cursor value, which picks a shard, and takes
+    // the lowest free index in that shard at or after the cursor's, wrapping
+    // within the shard. A shard with no free index defers to the next one.
+    // So successive handles walk the shards round-robin. A busy handle is
+    // skipped in steps of RS_CLIENT_HANDLE_SHARD_COUNT within its shard,
+    // where before sharding it was skipped in steps of
+    // RS_CLIENT_HANDLE_BUCKET_COUNT within its bucket. Handles therefore
+    // only follow the old sequence while nothing in the way is allocated.
+    //
+    NvU32 cursor = portAtomicIncrementU32(&pServer->clientCurrentHandleIndex) - 1;
+    NvU32 start  = CLIENT_SHARD_INDEX(cursor);
+    NvU32 i;
 
-    if (hClient == 0)
+    for (i = 0; i < RS_CLIENT_HANDLE_SHARD_COUNT; i++)
     {
-        NvU32 clientHandleIndex = pServer->clientCurrentHandleIndex;
-        NvU16 clientHandleBucketInit = clientHandleIndex & RS_CLIENT_HANDLE_BUCKET_MASK;
-        do
+        NvU32            shard  = (cursor + i) & RS_CLIENT_HANDLE_SHARD_MASK;
+        RS_CLIENT_SHARD *pShard = &pServer->pClientShards[shard];
+        NvU32            index;
+        NV_STATUS        status = NV_ERR_INSUFFICIENT_RESOURCES;
+
+        portSyncSpinlockAcquire(pShard->pLock);
+        if (_serverClientShardFindFreeIndex(pShard, start, &index))
         {
-            hClient = bInternalHandle
-                ? CLIENT_ENCODEHANDLE_INTERNAL(pServer->internalHandleBase, clientHandleIndex)
-                : CLIENT_ENCODEHANDLE(clientHandleIndex);
+            pClientEntry->hClient = hBase | (index * RS_CLIENT_HANDLE_SHARD_COUNT) | shard;
 
-            clientHandleIndex++;
-            if (clientHandleIndex > RS_CLIENT_HANDLE_DECODE_MASK)
-            {
-                // We will override the client base, loop over
-                clientHandleIndex = 0;
-            }
-            if (clientHandleBucketInit == (clientHandleIndex & RS_CLIENT_HANDLE_BUCKET_MASK))
-            {
-                // We looked through all buckets and we did not find any available client (very unlikely)
-                status = NV_ERR_INSUFFICIENT_RESOURCES;
-                goto _serverCreateEntryAndLockForNewClient_exit;
-            }
+            // A clear bit means no client of any prefix holds this index
+            status = _serverInsertClientEntryUnderLock(pServer, pClientEntry);
+            NV_ASSERT(status == NV_OK);
         }
-        while (_serverFindNextAvailableClientHandleInBucket(pServer, hClient, &hClient, &ppClientNext) != NV_OK);
+        portSyncSpinlockRelease(pShard->pLock);
 
-        pServer->clientCurrentHandleIndex = clientHandleIndex;
+        if (status == NV_OK)
+            return NV_OK;
     }
-    else
+
+    // We looked through all shards and we did not find any available client (very unlikely)
+    pClientEntry->hClient = 0;
+    return NV_ERR_INSUFFICIENT_RESOURCES;
+}
+
+static void
+_serverDestroyClientShards
+(
+    RsServer *pServer
+)
+{
+    NvU32 i;
+
+    if (pServer->pClientShards == NULL)
+        return;
+
+    for (i = 0; i < RS_CLIENT_HANDLE_SHARD_COUNT; i++)
     {
-        NvHandle hClientOut = 0;
+        RS_CLIENT_SHARD *pShard = &pServer->pClientShards[i];
 
-#if !(RS_COMPATABILITY_MODE)
-        // Re-encode handle so it matches expected format
-        NvU32 clientIndex = CLIENT_DECODEHANDLE(hClient);
-        hClient = bInternalHandle
-            ? CLIENT_ENCODEHANDLE_INTERNAL(clientIndex)
-            : CLIENT_ENCODEHANDLE(clientIndex);
-#endif
+        if (pShard->pLock != NULL)
+            portSyncSpinlockDestroy(pShard->pLock);
 
-        if (_serverFindClientEntry(pServer, hClient, NV_FALSE, NULL) == NV_OK)
-        {
-            // The handle already exists
-            status = NV_ERR_INSERT_DUPLICATE_NAME;
-            goto _serverCreateEntryAndLockForNewClient_exit;
-        }
-        status = _serverFindNextAvailableClientHandleInBucket(pServer, hClient, &hClientOut, &ppClientNext);
-        if (status != NV_OK)
-        {
-             goto _serverCreateEntryAndLockForNewClient_exit;
-        }
-        if (hClient != hClientOut)
-        {
-            // This should not happen as we checked for duplicates already
-            NV_PRINTF(LEVEL_ERROR, "Client handle mismatch: %x != %x.\n", hClient, hClientOut);
-            status = NV_ERR_INVALID_STATE;
-            goto _serverCreateEntryAndLockForNewClient_exit;
-        }
+        PORT_FREE(pServer->pAllocator, pShard->pHandleBitmap);
     }
 
+    PORT_FREE(pServer->pAllocator, pServer->pClientShards);
+    pServer->pClientShards = NULL;
+}
+
+static
+NV_STATUS
+_serverCreateEntryAndLockForNewClient
+(
+    RsServer      *pServer,
+    NvHandle      *phClient,
+    NvBool         bInternalHandle,
+    CLIENT_ENTRY **ppClientEntry
+)
+{
+    CLIENT_ENTRY  *pClientEntry = NULL;
+    NV_STATUS      status = NV_OK;
+    NvHandle       hClient = *phClient;
+    PORT_RWLOCK   *pLock = NULL;
+
+    //
+    // Allocate the entry and its lock up front so that nothing is allocated
+    // while the shard lock is held.
+    //
     pLock = portSyncRwLockCreate(pServer->pAllocator);
     if (pLock == NULL)
     {
@@ -2170,7 +2360,6 @@ _serverCreateEntryAndLockForNewClient
         goto _serverCreateEntryAndLockForNewClient_exit;
     }
 
-    // At this point we have a hClient,  we know in which bucket and where in the bucket to insert the entry.
     pClientEntry = (CLIENT_ENTRY *)PORT_ALLOC(pServer->pAllocator, sizeof(CLIENT_ENTRY));
     if (pClientEntry == NULL)
     {
@@ -2179,21 +2368,40 @@ _serverCreateEntryAndLockForNewClient
     }
     portMemSet(pClientEntry, 0, sizeof(*pClientEntry));
 
-    pClientEntry->hClient = hClient;
     pClientEntry->pLock = pLock;
 
+    if (hClient == 0)
+    {
+        status = _serverAllocClientHandle(pServer,
+                                          bInternalHandle ? pServer->internalHandleBase : RS_CLIENT_HANDLE_BASE,
+                                          pClientEntry);
+    }
+    else
+    {
+#if !(RS_COMPATABILITY_MODE)
+        // Re-encode handle so it matches expected format
+        NvU32 clientIndex = CLIENT_DECODEHANDLE(hClient);
+        hClient = bInternalHandle
+            ? CLIENT_ENCODEHANDLE_INTERNAL(clientIndex)
+            : CLIENT_ENCODEHANDLE(clientIndex);
+#endif
 
-    RS_LOCK_VALIDATOR_INIT(&pClientEntry->lockVal,
-                           bInternalHandle ? LOCK_VAL_LOCK_CLASS_CLIENT_INTERNAL : LOCK_VAL_LOCK_CLASS_CLIENT,
-                           hClient);
+        // Fails with NV_ERR_INSERT_DUPLICATE_NAME if the handle already exists
+        pClientEntry->hClient = hClient;
+        status = _serverInsertClientEntry(pServer, pClientEntry);
+    }
 
-    status = _serverInsertClientEntry(pServer, pClientEntry, ppClientNext);
     if (status != NV_OK)
     {
-        PORT_FREE(pServer->pAllocator, pClientEntry);
         goto _serverCreateEntryAndLockForNewClient_exit;
     }
 
+    hClient = pClientEntry->hClient;
+
+    RS_LOCK_VALIDATOR_INIT(&pClientEntry->lockVal,
+                           bInternalHandle ? LOCK_VAL_LOCK_CLASS_CLIENT_INTERNAL : LOCK_VAL_LOCK_CLASS_CLIENT,
+                           hClient);
+
     RS_RWLOCK_ACQUIRE_WRITE(pClientEntry->pLock, &pClientEntry->lockVal);
     pClientEntry->lockOwnerTid = portThreadGetCurrentThreadId();
 
@@ -2201,13 +2409,18 @@ _serverCreateEntryAndLockForNewClient
     *ppClientEntry = pClientEntry;
 
 _serverCreateEntryAndLockForNewClient_exit:
-    if (status != NV_OK && pLock != NULL)
-        portSyncRwLockDestroy(pLock);
+    if (status != NV_OK)
+    {
+        if (pClientEntry != NULL)
+            PORT_FREE(pServer->pAllocator, pClientEntry);
+
+        if (pLock != NULL)
+            portSyncRwLockDestroy(pLock);
+    }
 
     return status;
 }
 
-
 static
 NV_STATUS
 _serverLockClient
@@ -241,6 +241,7 @@ SRCS += interface/rmapi/src/finn_rm_api.c
 SRCS += kernel/nvd/nv/dbgbuffer.c
 SRCS += kernel/nvd/nv/nvdctrl.c
 SRCS += kernel/vgpu/nv/rpc.c
+SRCS += kernel/vgpu/nv/rpc_async.c
 SRCS += src/kernel/compute/fabric.c
 SRCS += src/kernel/compute/fm_session_api.c
 SRCS += src/kernel/compute/mps_api.c
@@ -628,6 +629,7 @@ SRCS += src/libraries/nvport/core/core.c
 SRCS += src/libraries/nvport/cpu/cpu_common.c
 SRCS += src/libraries/nvport/cpu/cpu_x86_amd64.c
 SRCS += src/libraries/nvport/crypto/crypto_random_xorshift.c
+SRCS += src/libraries/nvport/memory/memory_slab.c
 SRCS += src/libraries/nvport/memory/memory_tracking.c
 SRCS += src/libraries/nvport/memory/memory_unix_kernel_os.c
 SRCS += src/libraries/nvport/string/string_generic.c
@@ -0,0 +1,528 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Round trip every FINN message through the GSP_RM_CONTROL buffer layout.
+ *
+ * rpcRmApiControl_GSP() serializes the request at the start of the params
+ * buffer and reserves the same amount of space behind it for the reply:
+ *
+ *     params[0, n)     request, serialized down by the client
+ *     params[n, 2n)    reply, serialized up by GSP
+ *
+ * The fake responder below plays the GSP side: it deserializes the request,
+ * "executes" the control by inverting every byte of the variable-length
+ * buffers, and serializes the reply into the second half. The client side
+ * then deserializes the reply exactly as rpc.c does, so reading the request
+ * back by mistake shows up as uninverted buffers.
+ *
+ * Every message in the FINN descriptor table is covered. Both the path that
+ * serializes straight into the RPC buffer and the fallback that sizes the
+ * message first and serializes into a larger local copy are exercised.
+ */
+
+#include "finn_rm_api.h"
+#include "ctrl/ctrl0000/ctrl0000nvd.h"
+#include "ctrl/ctrl0080/ctrl0080dma.h"
+#include "ctrl/ctrl0080/ctrl0080fb.h"
+#include "ctrl/ctrl0080/ctrl0080fifo.h"
+#include "ctrl/ctrl0080/ctrl0080gpu.h"
+#include "ctrl/ctrl0080/ctrl0080gr.h"
+#include "ctrl/ctrl0080/ctrl0080host.h"
+#include "ctrl/ctrl0080/ctrl0080msenc.h"
+#include "ctrl/ctrl2080/ctrl2080ce.h"
+#include "ctrl/ctrl2080/ctrl2080gpu.h"
+#include "ctrl/ctrl2080/ctrl2080i2c.h"
+#include "ctrl/ctrl2080/ctrl2080nvd.h"
+#include "ctrl/ctrl2080/ctrl2080perf.h"
+#include "ctrl/ctrl2080/ctrl2080rc.h"
+#include "ctrl/ctrl402c.h"
+#include "ctrl/ctrl83de/ctrl83dedebug.h"
+#include "ctrl/ctrlb06f.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FINN_TEST_NONE          0xFFFFFFFFU
+#define FINN_TEST_MAX_ELEMENTS  64
+#define FINN_TEST_MAX_PARAMS    4096
+#define FINN_TEST_RPC_BUFFER    (64 * 1024)
+
+//
+// One variable-length payload per message: up to two NvP64 buffers that share
+// an element count. Messages without a count carry a single fixed-size buffer,
+// or none at all.
+//
+typedef struct
+{
+    const char *name;
+    NvU32 interface;
+    NvU32 message;
+    NvU32 paramsSize;
+    NvU32 countOffset;
+    NvU32 ptrOffset[2];
+    NvU32 elemSize;
+    NvU32 maxCount;
+} FINN_TEST_MESSAGE;
+
+#define FINN_TEST_ENTRY(iface, type, count, ptr0, ptr1, elem, max)                        \
+    { #type, FINN_INTERFACE_ID(iface), FINN_MESSAGE_ID(type), sizeof(type),                \
+      count, { ptr0, ptr1 }, elem, max }
+
+#define FINN_TEST_FIELD(type, field)    ((NvU32)offsetof(type, field))
+
+#define FINN_TEST_CAPS(iface, type, tblSize)                                               \
+    FINN_TEST_ENTRY(iface, type, FINN_TEST_FIELD(type, capsTblSize),                       \
+                    FINN_TEST_FIELD(type, capsTbl), FINN_TEST_NONE, 1, tblSize)
+
+static const FINN_TEST_MESSAGE finnTestMessages[] =
+{
+    FINN_TEST_ENTRY(FINN_NV01_ROOT_NVD, NV0000_CTRL_NVD_GET_DUMP_PARAMS,
+                    FINN_TEST_FIELD(NV0000_CTRL_NVD_GET_DUMP_PARAMS, size),
+                    FINN_TEST_FIELD(NV0000_CTRL_NVD_GET_DUMP_PARAMS, pBuffer), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV01_DEVICE_0_GPU, NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS,
+                    FINN_TEST_FIELD(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS, numClasses),
+                    FINN_TEST_FIELD(NV0080_CTRL_GPU_GET_CLASSLIST_PARAMS, classList), FINN_TEST_NONE,
+                    sizeof(NvU32), FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_CAPS(FINN_NV01_DEVICE_0_GR, NV0080_CTRL_GR_GET_CAPS_PARAMS, NV0080_CTRL_GR_CAPS_TBL_SIZE),
+    FINN_TEST_CAPS(FINN_NV01_DEVICE_0_FB, NV0080_CTRL_FB_GET_CAPS_PARAMS, NV0080_CTRL_FB_CAPS_TBL_SIZE),
+    FINN_TEST_CAPS(FINN_NV01_DEVICE_0_HOST, NV0080_CTRL_HOST_GET_CAPS_PARAMS, NV0080_CTRL_HOST_CAPS_TBL_SIZE),
+    FINN_TEST_CAPS(FINN_NV01_DEVICE_0_FIFO, NV0080_CTRL_FIFO_GET_CAPS_PARAMS, NV0080_CTRL_FIFO_CAPS_TBL_SIZE),
+    FINN_TEST_ENTRY(FINN_NV01_DEVICE_0_FIFO, NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS,
+                    FINN_TEST_FIELD(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS, fifoStartChannelListSize),
+                    FINN_TEST_FIELD(NV0080_CTRL_FIFO_START_SELECTED_CHANNELS_PARAMS, fifoStartChannelList),
+                    FINN_TEST_NONE, sizeof(NV0080_CTRL_FIFO_CHANNEL), FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV01_DEVICE_0_FIFO, NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS,
+                    FINN_TEST_FIELD(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS, numChannels),
+                    FINN_TEST_FIELD(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS, pChannelHandleList),
+                    FINN_TEST_FIELD(NV0080_CTRL_FIFO_GET_CHANNELLIST_PARAMS, pChannelList),
+                    sizeof(NvU32), FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV01_DEVICE_0_DMA, NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS, FINN_TEST_NONE,
+                    FINN_TEST_FIELD(NV0080_CTRL_DMA_UPDATE_PDE_2_PARAMS, pPdeBuffer), FINN_TEST_NONE,
+                    sizeof(NvU64), 1),
+    FINN_TEST_CAPS(FINN_NV01_DEVICE_0_MSENC, NV0080_CTRL_MSENC_GET_CAPS_PARAMS, NV0080_CTRL_MSENC_CAPS_TBL_SIZE),
+    FINN_TEST_ENTRY(FINN_NV20_SUBDEVICE_0_GPU, NV2080_CTRL_GPU_GET_ENGINES_PARAMS,
+                    FINN_TEST_FIELD(NV2080_CTRL_GPU_GET_ENGINES_PARAMS, engineCount),
+                    FINN_TEST_FIELD(NV2080_CTRL_GPU_GET_ENGINES_PARAMS, engineList), FINN_TEST_NONE,
+                    sizeof(NvU32), FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV20_SUBDEVICE_0_GPU, NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS,
+                    FINN_TEST_FIELD(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS, numClasses),
+                    FINN_TEST_FIELD(NV2080_CTRL_GPU_GET_ENGINE_CLASSLIST_PARAMS, classList), FINN_TEST_NONE,
+                    sizeof(NvU32), FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV20_SUBDEVICE_0_I2C, NV2080_CTRL_I2C_ACCESS_PARAMS,
+                    FINN_TEST_FIELD(NV2080_CTRL_I2C_ACCESS_PARAMS, dataBuffSize),
+                    FINN_TEST_FIELD(NV2080_CTRL_I2C_ACCESS_PARAMS, data), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV20_SUBDEVICE_0_PERF, NV2080_CTRL_PERF_GET_GPUMON_PERFMON_UTIL_SAMPLES_PARAM,
+                    FINN_TEST_FIELD(NV2080_CTRL_GPUMON_SAMPLES, bufSize),
+                    FINN_TEST_FIELD(NV2080_CTRL_GPUMON_SAMPLES, pSamples), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV20_SUBDEVICE_0_RC, NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS,
+                    FINN_TEST_FIELD(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS, bufferSize),
+                    FINN_TEST_FIELD(NV2080_CTRL_RC_READ_VIRTUAL_MEM_PARAMS, bufferPtr), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV20_SUBDEVICE_0_NVD, NV2080_CTRL_NVD_GET_DUMP_PARAMS,
+                    FINN_TEST_FIELD(NV2080_CTRL_NVD_GET_DUMP_PARAMS, size),
+                    FINN_TEST_FIELD(NV2080_CTRL_NVD_GET_DUMP_PARAMS, pBuffer), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_CAPS(FINN_NV20_SUBDEVICE_0_CE, NV2080_CTRL_CE_GET_CAPS_PARAMS, NV2080_CTRL_CE_CAPS_TBL_SIZE),
+    FINN_TEST_ENTRY(FINN_NV40_I2C_I2C, NV402C_CTRL_I2C_INDEXED_PARAMS,
+                    FINN_TEST_FIELD(NV402C_CTRL_I2C_INDEXED_PARAMS, messageLength),
+                    FINN_TEST_FIELD(NV402C_CTRL_I2C_INDEXED_PARAMS, pMessage), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_NV40_I2C_I2C, NV402C_CTRL_I2C_TRANSACTION_PARAMS, FINN_TEST_NONE,
+                    FINN_TEST_NONE, FINN_TEST_NONE, 0, 0),
+    FINN_TEST_ENTRY(FINN_GT200_DEBUGGER_DEBUG, NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS,
+                    FINN_TEST_FIELD(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS, length),
+                    FINN_TEST_FIELD(NV83DE_CTRL_DEBUG_READ_MEMORY_PARAMS, buffer), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_GT200_DEBUGGER_DEBUG, NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS,
+                    FINN_TEST_FIELD(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS, length),
+                    FINN_TEST_FIELD(NV83DE_CTRL_DEBUG_WRITE_MEMORY_PARAMS, buffer), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO, NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS,
+                    FINN_TEST_FIELD(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS, size),
+                    FINN_TEST_FIELD(NVB06F_CTRL_GET_ENGINE_CTX_DATA_PARAMS, pEngineCtxBuff), FINN_TEST_NONE,
+                    1, FINN_TEST_MAX_ELEMENTS),
+    FINN_TEST_ENTRY(FINN_MAXWELL_CHANNEL_GPFIFO_A_GPFIFO, NVB06F_CTRL_CMD_MIGRATE_ENGINE_CTX_DATA_FINN_PARAMS,
+                    FINN_TEST_NONE, FINN_TEST_NONE, FINN_TEST_NONE, 0, 0),
+};
+
+#define FINN_TEST_MESSAGE_COUNT (sizeof(finnTestMessages) / sizeof(finnTestMessages[0]))
+
+// Parameter storage, aligned for the NvU64 fields in every params struct.
+typedef union
+{
+    NvU64 align;
+    NvU8  bytes[FINN_TEST_MAX_PARAMS];
+} FINN_TEST_PARAMS;
+
+typedef struct
+{
+    FINN_TEST_PARAMS params;
+    NvU8 buffer[2][FINN_TEST_MAX_ELEMENTS * 64];
+    NvU32 count;
+} FINN_TEST_CASE;
+
+static NvU64 rngState = 0x9e3779b97f4a7c15ULL;
+static unsigned failures;
+
+#define CHECK(cond, msg, name)                                                  \
+    do {                                                                        \
+        if (!(cond))                                                            \
+        {                                                                       \
+            printf("FAIL %s: %s (%s:%d)\n", (name), (msg), __FILE__, __LINE__); \
+            failures++;                                                         \
+            return;                                                             \
+        }                                                                       \
+    } while (0)
+
+static NvU64 _rand64(void)
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+static void _randBytes(NvU8 *pDst, NvU32 size)
+{
+    NvU32 i;
+
+    for (i = 0; i < size; i++)
+        pDst[i] = (NvU8)_rand64();
+}
+
+static const FINN_TEST_MESSAGE *_lookup(NvU64 interface, NvU64 message)
+{
+    NvU32 i;
+
+    for (i = 0; i < FINN_TEST_MESSAGE_COUNT; i++)
+    {
+        if (finnTestMessages[i].interface == interface &&
+            finnTestMessages[i].message == message)
+            return &finnTestMessages[i];
+    }
+    return NULL;
+}
+
+static NvU32 _bufferSize(const FINN_TEST_MESSAGE *pMsg, NvU32 count)
+{
+    return (pMsg->countOffset == FINN_TEST_NONE) ? pMsg->elemSize : count * pMsg->elemSize;
+}
+
+static NvU8 *_bufferPtr(const FINN_TEST_MESSAGE *pMsg, NvU8 *pParams, NvU32 i)
+{
+    NvP64 ptr;
+
+    if (pMsg->ptrOffset[i] == FINN_TEST_NONE)
+        return NULL;
+
+    memcpy(&ptr, pParams + pMsg->ptrOffset[i], sizeof(ptr));
+    return (NvU8 *)NvP64_VALUE(ptr);
+}
+
+//
+// Build a request: random scalar fields for messages whose only pointers are
+// the ones described, a random element count and random buffer contents.
+//
+static void _buildCase(const FINN_TEST_MESSAGE *pMsg, FINN_TEST_CASE *pCase, NvBool bRandomScalars)
+{
+    NvBool bPresent;
+    NvU32 i;
+
+    memset(pCase, 0, sizeof(*pCase));
+
+    if (bRandomScalars && pMsg->countOffset != FINN_TEST_NONE)
+        _randBytes(pCase->params.bytes, pMsg->paramsSize);
+
+    //
+    // Leave the buffers out now and then to cover the NULL presence byte. The
+    // generated deserializers reject empty element arrays, so a present
+    // buffer always has at least one element.
+    //
+    bPresent = (_rand64() % 8) != 0;
+
+    if (pMsg->countOffset != FINN_TEST_NONE)
+    {
+        pCase->count = (NvU32)(_rand64() % (pMsg->maxCount + 1));
+        if (bPresent && pCase->count == 0)
+            pCase->count = 1;
+        memcpy(pCase->params.bytes + pMsg->countOffset, &pCase->count, sizeof(NvU32));
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        NvP64 ptr = NvP64_NULL;
+
+        if (pMsg->ptrOffset[i] == FINN_TEST_NONE)
+            continue;
+
+        if (bPresent)
+        {
+            _randBytes(pCase->buffer[i], _bufferSize(pMsg, pCase->count));
+            ptr = NV_PTR_TO_NvP64(pCase->buffer[i]);
+        }
+        memcpy(pCase->params.bytes + pMsg->ptrOffset[i], &ptr, sizeof(ptr));
+    }
+}
+
+//
+// Fake GSP responder: deserialize the request from the first half of the
+// params, run the "control", and serialize the reply into the second half.
+// The request is handled from a private copy, as GSP does, so the first half
+// of the shared buffer still holds the unmodified request afterwards.
+//
+static NV_STATUS _gspHandleControl(NvU8 *pParams, NvU32 paramsSize)
+{
+    FINN_RM_API *pHeader = (FINN_RM_API *)pParams;
+    FINN_TEST_PARAMS local;
+    const FINN_TEST_MESSAGE *pMsg;
+    NvU8 *pCopy = malloc(paramsSize / 2);
+    NvU8 *pReq = pCopy;
+    NvU8 *pRep = pParams + paramsSize / 2;
+    NvU64 interface = pHeader->interface;
+    NvU64 message = pHeader->message;
+    NV_STATUS status;
+    NvU32 count = 0;
+    NvU32 i, j;
+
+    if (pCopy == NULL)
+        return NV_ERR_NO_MEMORY;
+
+    memcpy(pCopy, pParams, paramsSize / 2);
+    memset(&local, 0, sizeof(local));
+    status = FinnRmApiDeserializeDown(&pReq, paramsSize / 2, local.bytes, sizeof(local));
+    if (status != NV_OK)
+        goto done;
+
+    pMsg = _lookup(interface, message);
+    if (pMsg == NULL)
+    {
+        status = NV_ERR_NOT_SUPPORTED;
+        goto done;
+    }
+
+    if (pMsg->countOffset != FINN_TEST_NONE)
+        memcpy(&count, local.bytes + pMsg->countOffset, sizeof(count));
+
+    for (i = 0; i < 2; i++)
+    {
+        NvU8 *pBuf = _bufferPtr(pMsg, local.bytes, i);
+
+        for (j = 0; pBuf != NULL && j < _bufferSize(pMsg, count); j++)
+            pBuf[j] = ~pBuf[j];
+    }
+
+    status = FinnRmApiSerializeUp(interface, message, local.bytes, &pRep, paramsSize / 2);
+
+done:
+    free(pCopy);
+    return status;
+}
+
+//
+// Client side, laid out like _rpcRmApiControlGsp(): try to serialize into the
+// first half of the RPC buffer, fall back to sizing the message and using a
+// larger local copy, then deserialize the reply from behind the request.
+//
+static void _roundTrip(const FINN_TEST_MESSAGE *pMsg, NvBool bRandomScalars, NvBool bForceLarge)
+{
+    static NvU8 rpcBuffer[FINN_TEST_RPC_BUFFER] __attribute__((aligned(8)));
+    FINN_TEST_CASE request, expected;
+    NvU8 *pParamsBuf = rpcBuffer;
+    NvU8 *pLarge = NULL;
+    NvU8 *pSerBuffer = rpcBuffer;
+    NvU32 offered = bForceLarge ? 32 : FINN_TEST_RPC_BUFFER / 2;
+    NvU64 sizedSize;
+    NvU32 serializedSize;
+    NvU32 paramsSize;
+    NV_STATUS status;
+    NvU32 i;
+
+    _buildCase(pMsg, &request, bRandomScalars);
+
+    sizedSize = FinnRmApiGetSerializedSize(pMsg->interface, pMsg->message,
+                                           NV_PTR_TO_NvP64(request.params.bytes));
+    CHECK(sizedSize != 0, "message missing from the descriptor table", pMsg->name);
+
+    status = FinnRmApiSerializeDown(pMsg->interface, pMsg->message, request.params.bytes,
+                                    &pSerBuffer, offered);
+    if (status == NV_ERR_BUFFER_TOO_SMALL)
+    {
+        CHECK(bForceLarge, "unexpected BUFFER_TOO_SMALL", pMsg->name);
+        serializedSize = (NvU32)sizedSize;
+        pLarge = malloc(2 * serializedSize);
+        CHECK(pLarge != NULL, "out of memory", pMsg->name);
+        pParamsBuf = pLarge;
+        pSerBuffer = pLarge;
+        status = FinnRmApiSerializeDown(pMsg->interface, pMsg->message, request.params.bytes,
+                                        &pSerBuffer, serializedSize);
+    }
+    else if (status == NV_OK)
+    {
+        serializedSize = (NvU32)((FINN_RM_API *)rpcBuffer)->payloadSize;
+    }
+
+    if (status == NV_ERR_OUT_OF_RANGE && bRandomScalars)
+    {
+        // Random scalars tripped a range check, retry with them cleared.
+        free(pLarge);
+        _roundTrip(pMsg, NV_FALSE, bForceLarge);
+        return;
+    }
+    CHECK(status == NV_OK, "serialize down failed", pMsg->name);
+
+    CHECK(serializedSize == sizedSize, "serialized size differs from sizing pass", pMsg->name);
+    CHECK(pSerBuffer == pParamsBuf + serializedSize, "serializer wrote other than payloadSize", pMsg->name);
+    CHECK(((FINN_RM_API *)pParamsBuf)->interface == pMsg->interface &&
+          ((FINN_RM_API *)pParamsBuf)->message == pMsg->message,
+          "dispatched to the wrong message serializer", pMsg->name);
+
+    paramsSize = 2 * serializedSize;
+    status = _gspHandleControl(pParamsBuf, paramsSize);
+
+    CHECK(status == NV_OK, "responder failed", pMsg->name);
+
+    // The reply must land in the caller's struct and buffers.
+    expected = request;
+    for (i = 0; i < 2; i++)
+    {
+        NvU8 *pBuf = _bufferPtr(pMsg, request.params.bytes, i);
+        NvU32 j;
+
+        for (j = 0; pBuf != NULL && j < _bufferSize(pMsg, request.count); j++)
+            expected.buffer[i][j] = ~pBuf[j];
+    }
+
+    pSerBuffer = pParamsBuf + serializedSize;
+    status = FinnRmApiDeserializeUp(&pSerBuffer, paramsSize / 2, request.params.bytes, pMsg->paramsSize);
+    CHECK(status == NV_OK, "deserialize up failed", pMsg->name);
+    CHECK(memcmp(request.params.bytes, expected.params.bytes, pMsg->paramsSize) == 0,
+          "params changed across the round trip", pMsg->name);
+    CHECK(memcmp(request.buffer, expected.buffer, sizeof(request.buffer)) == 0,
+          "reply buffers not written back", pMsg->name);
+
+    free(pLarge);
+}
+
+static void _checkUnknownMessage(void)
+{
+    static NvU8 buf[256] __attribute__((aligned(8)));
+    FINN_TEST_PARAMS params;
+    NvU8 *pBuf = buf;
+
+    memset(&params, 0, sizeof(params));
+    if (FinnRmApiSerializeDown(0xFFFF, 0xFF, params.bytes, &pBuf, sizeof(buf)) != NV_ERR_NOT_SUPPORTED ||
+        FinnRmApiGetSerializedSize(0xFFFF, 0xFF, NV_PTR_TO_NvP64(params.bytes)) != 0 ||
+        FinnRmApiGetUnserializedSize(0xFFFF, 0xFF) != 0)
+    {
+        printf("FAIL unknown message was not rejected\n");
+        failures++;
+    }
+}
+
+static double _now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Time the client-side size + serialize + deserialize of each message.
+static void _benchmark(NvU32 iterations)
+{
+    static NvU8 buf[FINN_TEST_RPC_BUFFER] __attribute__((aligned(8)));
+    NvU32 i, n;
+
+    for (i = 0; i < FINN_TEST_MESSAGE_COUNT; i++)
+    {
+        const FINN_TEST_MESSAGE *pMsg = &finnTestMessages[i];
+        FINN_TEST_CASE request;
+        FINN_TEST_PARAMS out;
+        double start;
+        volatile NvU64 sink = 0;
+
+        do
+        {
+            _buildCase(pMsg, &request, NV_FALSE);
+        } while (pMsg->countOffset != FINN_TEST_NONE && request.count == 0);
+
+        start = _now();
+        for (n = 0; n < iterations; n++)
+        {
+            NvU8 *pBuf = buf;
+
+            sink += FinnRmApiGetSerializedSize(pMsg->interface, pMsg->message,
+                                               NV_PTR_TO_NvP64(request.params.bytes));
+            FinnRmApiSerializeDown(pMsg->interface, pMsg->message, request.params.bytes,
+                                   &pBuf, sizeof(buf) / 2);
+            pBuf = buf;
+            out = request.params;
+            FinnRmApiDeserializeUp(&pBuf, sizeof(buf) / 2, out.bytes, pMsg->paramsSize);
+        }
+        printf("  %-58s %7.1f ns/op\n", pMsg->name, (_now() - start) * 1e9 / iterations);
+        (void)sink;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    NvU32 iterations = (argc > 1) ? (NvU32)strtoul(argv[1], NULL, 0) : 2000;
+    NvU32 i, n;
+
+    if (FINN_TEST_MESSAGE_COUNT != 23)
+    {
+        printf("FAIL expected 23 FINN messages, have %u\n", (unsigned)FINN_TEST_MESSAGE_COUNT);
+        return 1;
+    }
+
+    for (i = 0; i < FINN_TEST_MESSAGE_COUNT; i++)
+    {
+        const FINN_TEST_MESSAGE *pMsg = &finnTestMessages[i];
+
+        if (FinnRmApiGetUnserializedSize(pMsg->interface, pMsg->message) != pMsg->paramsSize)
+        {
+            printf("FAIL %s: wrong unserialized size\n", pMsg->name);
+            failures++;
+        }
+
+        for (n = 0; n < iterations; n++)
+            _roundTrip(pMsg, (n % 2) != 0, (n % 5) == 0);
+    }
+
+    _checkUnknownMessage();
+
+    printf("finn_rm_api_test: %u messages x %u round trips, %u failures\n",
+           (unsigned)FINN_TEST_MESSAGE_COUNT, iterations, failures);
+
+    if (argc > 2)
+        _benchmark((NvU32)strtoul(argv[2], NULL, 0));
+
+    return failures != 0;
+}
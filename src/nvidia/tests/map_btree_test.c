@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Map container (map.c): the B+-tree backend against the red-black tree.
+ *
+ * The fuzz test drives a red-black tree map and a B+-tree map with the same
+ * random inserts, removes, finds, GEQ/LEQ lookups, mapPrev steps and full
+ * iterations, over key ranges small enough to hit duplicates constantly and
+ * large enough to build a deep tree. Every result and the counts must agree.
+ * It then drains the B+-tree by key and checks that the index is freed. The
+ * intrusive test covers mapInsertExisting() duplicates, mapNext and removal
+ * on an intrusive B+-tree map.
+ *
+ * The benchmark reports ns per operation for insert, find, full iteration
+ * and remove on both backends, from 1000 entries up to the given size, with
+ * random keys and with sequential keys (like the RM handles in a client's
+ * resource map).
+ *
+ *     map_btree_test [max entries]
+ */
+
+#include "containers/map.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+MAKE_MAP(TestMap, NvU64);
+
+typedef struct
+{
+    NvU64   value;
+    MapNode node;
+} TEST_INTRUSIVE_VALUE;
+
+MAKE_INTRUSIVE_MAP(TestIntrusiveMap, TEST_INTRUSIVE_VALUE, node);
+
+static unsigned failures;
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+static NvU64 _rngState = 88172645463325252ULL;
+
+static NvU64 _rand(void)
+{
+    _rngState ^= _rngState << 13;
+    _rngState ^= _rngState >> 7;
+    _rngState ^= _rngState << 17;
+    return _rngState;
+}
+
+static NvU64 _nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (NvU64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static NvBool _sameIteration(TestMap *pRbTree, TestMap *pBTree)
+{
+    TestMapIter rbIt = mapIterAll(pRbTree);
+    TestMapIter bIt = mapIterAll(pBTree);
+
+    while (mapIterNext(&rbIt))
+    {
+        if (!mapIterNext(&bIt) || (*rbIt.pValue != *bIt.pValue) ||
+            (mapKey(pBTree, bIt.pValue) != *rbIt.pValue))
+        {
+            return NV_FALSE;
+        }
+    }
+    return !mapIterNext(&bIt);
+}
+
+static void _fuzz(NvU64 keyRange, NvU32 operations)
+{
+    TestMap rbTree, bTree;
+    NvU64 *pRb, *pB;
+    NvU32 i;
+
+    mapInit(&rbTree, portMemAllocatorGetGlobalNonPaged());
+    mapInitBTree(&bTree, portMemAllocatorGetGlobalNonPaged());
+
+    for (i = 0; i < operations; i++)
+    {
+        NvU64 key = _rand() % keyRange;
+        NvU32 op = _rand() % 10;
+
+        if (op < 4)
+        {
+            pRb = mapInsertNew(&rbTree, key);
+            pB = mapInsertNew(&bTree, key);
+            CHECK(!pRb == !pB);
+            if (pRb != NULL && pB != NULL)
+            {
+                *pRb = key;
+                *pB = key;
+            }
+        }
+        else if (op < 7)
+        {
+            pRb = mapFind(&rbTree, key);
+            pB = mapFind(&bTree, key);
+            CHECK(!pRb == !pB);
+            if (pRb != NULL && pB != NULL)
+            {
+                CHECK(*pB == key);
+                mapRemove(&rbTree, pRb);
+                mapRemove(&bTree, pB);
+            }
+        }
+        else if (op < 8)
+        {
+            pRb = mapFindGEQ(&rbTree, key);
+            pB = mapFindGEQ(&bTree, key);
+            CHECK(!pRb == !pB);
+            if (pRb != NULL && pB != NULL)
+                CHECK(*pRb == *pB);
+        }
+        else if (op < 9)
+        {
+            pRb = mapFindLEQ(&rbTree, key);
+            pB = mapFindLEQ(&bTree, key);
+            CHECK(!pRb == !pB);
+            if (pRb != NULL && pB != NULL)
+            {
+                CHECK(*pRb == *pB);
+                pRb = mapPrev(&rbTree, pRb);
+                pB = mapPrev(&bTree, pB);
+                CHECK(!pRb == !pB);
+                if (pRb != NULL && pB != NULL)
+                    CHECK(*pRb == *pB);
+            }
+        }
+        else if (i % 97 == 0)
+        {
+            CHECK(_sameIteration(&rbTree, &bTree));
+        }
+
+        CHECK(mapCount(&rbTree) == mapCount(&bTree));
+        if (failures)
+            break;
+    }
+
+    // Drain in random order by key; the B+-tree index must be gone after.
+    while (mapCount(&bTree) != 0)
+    {
+        NvU64 key;
+
+        pB = mapFindGEQ(&bTree, _rand() % keyRange);
+        if (pB == NULL)
+            pB = mapFindLEQ(&bTree, NV_U64_MAX);
+
+        key = *pB;
+        mapRemoveByKey(&bTree, key);
+        mapRemoveByKey(&rbTree, key);
+        CHECK(mapFind(&bTree, key) == NULL);
+    }
+    CHECK(mapCount(&rbTree) == 0);
+    CHECK(bTree.real.base.pBTreeRoot == NULL);
+
+    // Destroying a populated B+-tree map frees its values and index.
+    for (i = 0; i < 1000; i++)
+        mapInsertNew(&bTree, _rand());
+
+    mapDestroy(&rbTree);
+    mapDestroy(&bTree);
+    CHECK(mapCount(&bTree) == 0);
+}
+
+static void _testIntrusive(void)
+{
+    TestIntrusiveMap map;
+    TEST_INTRUSIVE_VALUE *pValues = calloc(10000, sizeof(*pValues));
+    NvU32 i;
+
+    mapInitIntrusiveBTree(&map, portMemAllocatorGetGlobalNonPaged());
+
+    for (i = 0; i < 10000; i++)
+    {
+        pValues[i].value = i * 7;
+        CHECK(mapInsertExisting(&map, pValues[i].value, &pValues[i]));
+    }
+    CHECK(!mapInsertExisting(&map, 7, &pValues[0]));
+
+    CHECK(mapFind(&map, 70) == &pValues[10]);
+    CHECK(mapNext(&map, &pValues[10]) == &pValues[11]);
+
+    for (i = 0; i < 10000; i += 2)
+        mapRemove(&map, &pValues[i]);
+
+    CHECK(mapCount(&map) == 5000);
+    CHECK(mapFindGEQ(&map, 1) == &pValues[1]);
+
+    mapDestroy(&map);
+    free(pValues);
+}
+
+static void _benchmark(NvBool bBTree, NvBool bSequential, NvU64 count)
+{
+    TestMap map;
+    NvU64 *pKeys = malloc(count * sizeof(*pKeys));
+    NvU64 t0, t1, t2, t3, t4, i;
+    volatile NvU64 sink = 0;
+
+    for (i = 0; i < count; i++)
+        pKeys[i] = bSequential ? (0xcaf00000 + i) : _rand();
+
+    if (bBTree)
+        mapInitBTree(&map, portMemAllocatorGetGlobalNonPaged());
+    else
+        mapInit(&map, portMemAllocatorGetGlobalNonPaged());
+
+    t0 = _nowNs();
+    for (i = 0; i < count; i++)
+        mapInsertNew(&map, pKeys[i]);
+
+    t1 = _nowNs();
+    for (i = 0; i < count; i++)
+        sink += (NvU64)(NvUPtr)mapFind(&map, pKeys[(i * 2654435761ULL) % count]);
+
+    t2 = _nowNs();
+    {
+        TestMapIter it = mapIterAll(&map);
+
+        while (mapIterNext(&it))
+            sink += (NvU64)(NvUPtr)it.pValue;
+    }
+
+    t3 = _nowNs();
+    for (i = 0; i < count; i++)
+        mapRemoveByKey(&map, pKeys[i]);
+    t4 = _nowNs();
+
+    CHECK(mapCount(&map) == 0);
+
+    printf("%-6s %-10s n=%-9llu insert %7.1f  find %7.1f  iter %6.1f  remove %7.1f ns/op\n",
+           bBTree ? "btree" : "rbtree", bSequential ? "sequential" : "random",
+           (unsigned long long)count,
+           (double)(t1 - t0) / count, (double)(t2 - t1) / count,
+           (double)(t3 - t2) / count, (double)(t4 - t3) / count);
+
+    mapDestroy(&map);
+    free(pKeys);
+}
+
+int main(int argc, char **argv)
+{
+    NvU64 maxCount = (argc > 1) ? strtoull(argv[1], NULL, 0) : 1000000;
+    NvU64 count;
+
+    _fuzz(64, 200000);
+    _fuzz(2000, 2000000);
+    _fuzz(1ULL << 40, 300000);
+    _testIntrusive();
+
+    for (count = 1000; count <= maxCount; count *= 10)
+    {
+        _benchmark(NV_FALSE, NV_FALSE, count);
+        _benchmark(NV_TRUE, NV_FALSE, count);
+        _benchmark(NV_FALSE, NV_TRUE, count);
+        _benchmark(NV_TRUE, NV_TRUE, count);
+    }
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
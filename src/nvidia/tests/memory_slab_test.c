@@ -0,0 +1,339 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * NvPort slab allocator (memory_slab.c) functional checks and churn benchmark.
+ *
+ * The functional checks cover the size class boundaries, block alignment,
+ * magazine reuse, pass-through of large requests, the counters reported by
+ * portMemExSlabGetStats() and its argument checks, and that releasing the
+ * slab returns every block it cached to the parent allocator.
+ *
+ * The churn benchmark runs threads that each keep a working set of slots and
+ * randomly allocate or free them with sizes of 8..1208 bytes, the range of
+ * the resource server's client, ref and map node allocations plus some
+ * larger ones. Every block is tagged on allocation and checked on free. The
+ * same mix is run against the parent allocator directly for comparison, and
+ * the per size class miss and overflow rates are reported.
+ *
+ *     memory_slab_test [operations per thread] [max threads]
+ */
+
+#include "nvport/nvport.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define WORKING_SET     256
+#define MIN_SIZE        8
+#define MAX_SIZE        1208
+
+static unsigned failures;
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+// Parent allocator counting the blocks it has outstanding
+static volatile NvS32 _parentBlocks;
+
+static void *_parentAlloc(PORT_MEM_ALLOCATOR *pAlloc, NvLength length)
+{
+    void *pMem = malloc(length);
+
+    if (pMem != NULL)
+        portAtomicIncrementS32(&_parentBlocks);
+    return pMem;
+}
+
+static void _parentFree(PORT_MEM_ALLOCATOR *pAlloc, void *pMem)
+{
+    portAtomicDecrementS32(&_parentBlocks);
+    free(pMem);
+}
+
+static PORT_MEM_ALLOCATOR _parent =
+{
+    ._portAlloc = _parentAlloc,
+    ._portFree  = _parentFree,
+};
+
+static NvU64 _nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (NvU64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static NvU64 _sumAllocs(PORT_MEM_ALLOCATOR *pSlab, PORT_MEM_SLAB_STATS *pStats)
+{
+    NvU64 allocs = 0;
+    NvU32 c;
+
+    for (c = 0; c < PORT_MEM_SLAB_SIZE_CLASS_COUNT; c++)
+    {
+        CHECK(portMemExSlabGetStats(pSlab, c, &pStats[c]) == NV_OK);
+        allocs += pStats[c].allocs;
+    }
+    return allocs;
+}
+
+static void _testSizeClasses(void)
+{
+    PORT_MEM_ALLOCATOR *pSlab = portMemExAllocatorCreateSlab(&_parent);
+    PORT_MEM_SLAB_STATS stats[PORT_MEM_SLAB_SIZE_CLASS_COUNT];
+    PORT_MEM_SLAB_STATS classStats;
+    NvLength objectSize;
+    NvU8 *pBlock;
+    NvU32 c;
+
+    CHECK(pSlab != NULL);
+    if (pSlab == NULL)
+        return;
+
+    // The smallest class serves 1..24 bytes, each one doubles the block.
+    for (c = 0; c < PORT_MEM_SLAB_SIZE_CLASS_COUNT; c++)
+    {
+        CHECK(portMemExSlabGetStats(pSlab, c, &classStats) == NV_OK);
+        objectSize = classStats.objectSize;
+        CHECK(objectSize == (32u << c) - 8);
+
+        pBlock = PORT_ALLOC(pSlab, objectSize);
+        CHECK(((NvUPtr)pBlock & 7) == 0);
+        memset(pBlock, 0xA5, objectSize);
+        PORT_FREE(pSlab, pBlock);
+
+        pBlock = PORT_ALLOC(pSlab, objectSize + 1);
+        memset(pBlock, 0x5A, objectSize + 1);
+        PORT_FREE(pSlab, pBlock);
+
+        CHECK(portMemExSlabGetStats(pSlab, c, &classStats) == NV_OK);
+        CHECK(classStats.allocs == ((c == 0) ? 1 : 2));
+        CHECK(classStats.frees == classStats.allocs);
+    }
+
+    // 1017 bytes and up pass straight through to the parent.
+    CHECK(_sumAllocs(pSlab, stats) == 2 * PORT_MEM_SLAB_SIZE_CLASS_COUNT - 1);
+    CHECK(stats[PORT_MEM_SLAB_SIZE_CLASS_COUNT - 1].allocs == 2);
+
+    CHECK(portMemExSlabGetStats(pSlab, PORT_MEM_SLAB_SIZE_CLASS_COUNT, &classStats) == NV_ERR_INVALID_ARGUMENT);
+    CHECK(portMemExSlabGetStats(&_parent, 0, &classStats) == NV_ERR_INVALID_ARGUMENT);
+    CHECK(portMemExSlabGetStats(NULL, 0, &classStats) == NV_ERR_INVALID_ARGUMENT);
+
+    portMemAllocatorRelease(pSlab);
+    CHECK(_parentBlocks == 0);
+}
+
+static void _testReuse(void)
+{
+    PORT_MEM_ALLOCATOR *pSlab = portMemExAllocatorCreateSlab(&_parent);
+    PORT_MEM_SLAB_STATS stats;
+    void *pBlocks[200];
+    void *pFirst, *pAgain;
+    NvS32 parentBlocks;
+    NvU32 i;
+
+    CHECK(pSlab != NULL);
+    if (pSlab == NULL)
+        return;
+
+    // A freed block is handed out again without calling the parent.
+    pFirst = PORT_ALLOC(pSlab, 40);
+    parentBlocks = _parentBlocks;
+    PORT_FREE(pSlab, pFirst);
+    pAgain = PORT_ALLOC(pSlab, 33);
+    CHECK(pAgain == pFirst);
+    CHECK(_parentBlocks == parentBlocks);
+    PORT_FREE(pSlab, pAgain);
+
+    //
+    // Free more blocks than the CPU magazines and a full depot can hold:
+    // the rest overflow to the parent, and none are lost.
+    //
+    for (i = 0; i < 200; i++)
+        pBlocks[i] = PORT_ALLOC(pSlab, 100);
+    for (i = 0; i < 200; i++)
+        PORT_FREE(pSlab, pBlocks[i]);
+
+    CHECK(portMemExSlabGetStats(pSlab, 2, &stats) == NV_OK);
+    CHECK(stats.allocs == 200);
+    CHECK(stats.frees == 200);
+    CHECK(stats.cacheMisses > 0);
+    CHECK(stats.cacheOverflows > 0);
+    CHECK(stats.depotExchanges > 0);
+
+    // The cached blocks come back before any new parent allocation.
+    parentBlocks = _parentBlocks;
+    for (i = 0; i < 200 - stats.cacheOverflows; i++)
+        pBlocks[i] = PORT_ALLOC(pSlab, 100);
+    CHECK(_parentBlocks == parentBlocks);
+    for (i = 0; i < 200 - stats.cacheOverflows; i++)
+        PORT_FREE(pSlab, pBlocks[i]);
+
+    portMemAllocatorRelease(pSlab);
+    CHECK(_parentBlocks == 0);
+}
+
+typedef struct
+{
+    PORT_MEM_ALLOCATOR *pAllocator;
+    NvU32               seed;
+    NvU32               operations;
+    NvU32               badBlocks;
+} CHURN_THREAD;
+
+static NvU32 _rand(NvU32 *pSeed)
+{
+    *pSeed = *pSeed * 1103515245u + 12345u;
+    return *pSeed >> 8;
+}
+
+static void *_churnThread(void *pArg)
+{
+    CHURN_THREAD *pThread = pArg;
+    NvU32 *pSlots[WORKING_SET] = { 0 };
+    NvU32 sizes[WORKING_SET];
+    NvU32 i, slot, tag;
+
+    for (i = 0; i < pThread->operations; i++)
+    {
+        slot = _rand(&pThread->seed) % WORKING_SET;
+
+        if (pSlots[slot] != NULL)
+        {
+            tag = (NvU32)(NvUPtr)&pSlots[slot] ^ sizes[slot];
+            if ((pSlots[slot][0] != tag) || (pSlots[slot][sizes[slot] / 4 - 1] != tag))
+                pThread->badBlocks++;
+            PORT_FREE(pThread->pAllocator, pSlots[slot]);
+            pSlots[slot] = NULL;
+        }
+        else
+        {
+            sizes[slot] = MIN_SIZE + (_rand(&pThread->seed) % (MAX_SIZE - MIN_SIZE + 1)) / 4 * 4;
+            pSlots[slot] = PORT_ALLOC(pThread->pAllocator, sizes[slot]);
+            if (pSlots[slot] == NULL)
+            {
+                pThread->badBlocks++;
+                continue;
+            }
+            tag = (NvU32)(NvUPtr)&pSlots[slot] ^ sizes[slot];
+            pSlots[slot][0] = tag;
+            pSlots[slot][sizes[slot] / 4 - 1] = tag;
+        }
+    }
+
+    for (slot = 0; slot < WORKING_SET; slot++)
+    {
+        if (pSlots[slot] != NULL)
+            PORT_FREE(pThread->pAllocator, pSlots[slot]);
+    }
+
+    return NULL;
+}
+
+static void _churn(NvU32 threadCount, NvU32 operations, NvBool bSlab)
+{
+    PORT_MEM_ALLOCATOR *pAllocator = bSlab ? portMemExAllocatorCreateSlab(&_parent) : &_parent;
+    PORT_MEM_SLAB_STATS stats[PORT_MEM_SLAB_SIZE_CLASS_COUNT];
+    CHURN_THREAD threads[64];
+    pthread_t tids[64];
+    NvU32 badBlocks = 0;
+    NvU64 start, elapsed;
+    NvU32 i, c;
+
+    CHECK(pAllocator != NULL);
+    if (pAllocator == NULL)
+        return;
+
+    for (i = 0; i < threadCount; i++)
+    {
+        threads[i].pAllocator = pAllocator;
+        threads[i].seed       = 0x51ab + i;
+        threads[i].operations = operations;
+        threads[i].badBlocks  = 0;
+    }
+
+    start = _nowNs();
+    for (i = 0; i < threadCount; i++)
+        pthread_create(&tids[i], NULL, _churnThread, &threads[i]);
+    for (i = 0; i < threadCount; i++)
+        pthread_join(tids[i], NULL);
+    elapsed = _nowNs() - start;
+
+    for (i = 0; i < threadCount; i++)
+        badBlocks += threads[i].badBlocks;
+    CHECK(badBlocks == 0);
+
+    printf("%-6s threads %2u: %9.0f ops/s\n", bSlab ? "slab" : "parent", threadCount,
+           (double)threadCount * operations * 1e9 / (double)elapsed);
+
+    if (bSlab)
+    {
+        _sumAllocs(pAllocator, stats);
+        for (c = 0; c < PORT_MEM_SLAB_SIZE_CLASS_COUNT; c++)
+        {
+            CHECK(stats[c].allocs == stats[c].frees);
+            printf("    %4llu bytes: %9llu allocs  %5.2f%% misses  %5.2f%% overflows  %llu exchanges\n",
+                   (unsigned long long)stats[c].objectSize,
+                   (unsigned long long)stats[c].allocs,
+                   stats[c].allocs ? 100.0 * stats[c].cacheMisses / stats[c].allocs : 0.0,
+                   stats[c].frees ? 100.0 * stats[c].cacheOverflows / stats[c].frees : 0.0,
+                   (unsigned long long)stats[c].depotExchanges);
+        }
+        portMemAllocatorRelease(pAllocator);
+    }
+
+    CHECK(_parentBlocks == 0);
+}
+
+int main(int argc, char **argv)
+{
+    NvU32 operations = (argc > 1) ? (NvU32)atoi(argv[1]) : 2000000;
+    NvU32 maxThreads = (argc > 2) ? (NvU32)atoi(argv[2]) : 16;
+    NvU32 t;
+
+    if (maxThreads > 64)
+        maxThreads = 64;
+
+    _testSizeClasses();
+    _testReuse();
+
+    for (t = 1; t <= maxThreads; t *= 2)
+    {
+        _churn(t, operations, NV_FALSE);
+        _churn(t, operations, NV_TRUE);
+    }
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,375 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * NvLog per-CPU staged ring buffers (nvlog.c, LOCKING_PERCPU) stress test.
+ *
+ * Writer threads push records through nvlogWriteToBuffer() on a per-CPU
+ * buffer, with the current CPU simulated per thread and migrating now and
+ * then, optionally while a reader drains the rings by extracting chunks as
+ * a log dump would. Some records are larger than a CPU ring, so they go
+ * through the locked direct write path, and rings fill up when no reader
+ * is draining them.
+ *
+ * The merged buffer must hold every record exactly once and intact, and in
+ * an order consistent with real time: a record whose write returned before
+ * another one's write started must come first. Each record carries a
+ * global counter value read before its write, and the counter is bumped
+ * after the write returns, which is enough to find any such inversion.
+ * A FULL locking buffer is run alongside for the write rate.
+ *
+ *     nvlog_percpu_test [records per thread] [max threads]
+ */
+
+#include "nvlog/nvlog.h"
+#include "os/os.h"
+#include "tls/tls.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SIM_CPU_COUNT     8
+#define RECORD_MAGIC      0x4e564c47
+#define RECORD_EXTRA_MAX  200
+
+// Every OVERSIZE_EVERY-th record is too large for any CPU ring.
+#define OVERSIZE_EVERY    128
+#define OVERSIZE_SIZE     0x1100
+
+#define TEST_TAG          0x54534554
+
+typedef struct
+{
+    NvU32 magic;
+    NvU32 thread;
+    NvU32 count;
+    NvU32 size;
+    NvU32 start;
+    NvU32 sum;
+} TEST_RECORD;
+
+static unsigned failures;
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+//
+// OS and library functions used by nvlog.c. Each thread runs on a simulated
+// CPU and moves to another one about every 64 calls.
+//
+static __thread NvU32 _threadCpu;
+static __thread NvU32 _threadRand;
+
+NvU32 osGetCpuCount(void)
+{
+    return SIM_CPU_COUNT;
+}
+
+NvU32 osGetCurrentProcessorNumber(void)
+{
+    _threadRand = _threadRand * 1103515245 + 12345;
+    if (((_threadRand >> 16) & 63) == 0)
+        _threadCpu = (_threadRand >> 8) % SIM_CPU_COUNT;
+    return _threadCpu;
+}
+
+void osAddRecordForCrashLog(void *pData, NvU32 size)
+{
+}
+
+void osDeleteRecordForCrashLog(void *pData)
+{
+}
+
+NV_STATUS osReadRegistryDword(OBJGPU *pGpu, const char *pRegParmStr, NvU32 *pData)
+{
+    return NV_ERR_OBJECT_NOT_FOUND;
+}
+
+int NV_API_CALL nv_printf(NvU32 debuglevel, const char *printf_format, ...)
+{
+    va_list args;
+    int ret;
+
+    va_start(args, printf_format);
+    ret = vprintf(printf_format, args);
+    va_end(args);
+    return ret;
+}
+
+NV_STATUS tlsInitialize(void)
+{
+    return NV_OK;
+}
+
+void tlsShutdown(void)
+{
+}
+
+typedef struct
+{
+    NVLOG_BUFFER_HANDLE hBuffer;
+    NvU32               thread;
+    NvU32               records;
+    NvU32              *pCompleted;
+} WRITER_ARGS;
+
+// Bumped after every write returns; records carry its value from before.
+static volatile NvU32 _clock;
+static volatile NvBool _bDone;
+
+static NvU64 _nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (NvU64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static NvU32 _recordSize(NvU32 thread, NvU32 count)
+{
+    if ((count % OVERSIZE_EVERY) == OVERSIZE_EVERY - 1)
+        return OVERSIZE_SIZE;
+    return sizeof(TEST_RECORD) + (count * 37 + thread * 11) % RECORD_EXTRA_MAX;
+}
+
+static NvU8 _payloadByte(NvU32 thread, NvU32 count, NvU32 offset)
+{
+    return (NvU8)(offset ^ count ^ (thread << 4));
+}
+
+static void *_writer(void *pArg)
+{
+    WRITER_ARGS *pArgs = pArg;
+    NvU8        *pRecord = malloc(OVERSIZE_SIZE);
+    TEST_RECORD *pHeader = (TEST_RECORD *)pRecord;
+    NvU32        i;
+    NvU32        j;
+
+    _threadCpu  = pArgs->thread % SIM_CPU_COUNT;
+    _threadRand = pArgs->thread * 7919 + 1;
+
+    for (i = 0; i < pArgs->records; i++)
+    {
+        pHeader->magic  = RECORD_MAGIC;
+        pHeader->thread = pArgs->thread;
+        pHeader->count  = i;
+        pHeader->size   = _recordSize(pArgs->thread, i);
+        pHeader->sum    = 0;
+        for (j = sizeof(TEST_RECORD); j < pHeader->size; j++)
+        {
+            pRecord[j] = _payloadByte(pArgs->thread, i, j);
+            pHeader->sum += pRecord[j];
+        }
+
+        pHeader->start = __atomic_load_n(&_clock, __ATOMIC_SEQ_CST);
+        CHECK(nvlogWriteToBuffer(pArgs->hBuffer, pRecord, pHeader->size) == NV_OK);
+        pArgs->pCompleted[i] = __atomic_add_fetch(&_clock, 1, __ATOMIC_SEQ_CST);
+    }
+
+    free(pRecord);
+    return NULL;
+}
+
+static void *_reader(void *pArg)
+{
+    NVLOG_BUFFER_HANDLE hBuffer = *(NVLOG_BUFFER_HANDLE *)pArg;
+    struct timespec     delay   = { 0, 200000 };
+    NvU8                chunk[256];
+    NvU32               chunkSize;
+
+    // The first chunk of a dump merges everything staged so far.
+    while (!__atomic_load_n(&_bDone, __ATOMIC_ACQUIRE))
+    {
+        chunkSize = sizeof(chunk);
+        CHECK(nvlogExtractBufferChunk(hBuffer, 0, &chunkSize, chunk) == NV_OK);
+        nanosleep(&delay, NULL);
+    }
+    return NULL;
+}
+
+//
+// Walks the merged records, checking each one and that no record comes
+// after one that started only once it had completed.
+//
+static NvU64 _verify(const NVLOG_BUFFER *pBuffer, NvU32 threads, NvU32 records,
+                     NvU32 **ppCompleted)
+{
+    NvU32  total    = threads * records;
+    NvU32 *pNext    = calloc(threads, sizeof(*pNext));
+    NvU32 *pStart   = malloc(total * sizeof(*pStart));
+    NvU32 *pMinDone = malloc((total + 1) * sizeof(*pMinDone));
+    NvU32  pos      = 0;
+    NvU32  found    = 0;
+    NvU32  i;
+
+    CHECK(pBuffer->extra.ring.overflow == 0);
+
+    while (pos < pBuffer->pos)
+    {
+        TEST_RECORD header;
+        NvU32       sum = 0;
+        NvU32       j;
+
+        memcpy(&header, &pBuffer->data[pos], sizeof(header));
+        if ((header.magic != RECORD_MAGIC) || (header.thread >= threads) ||
+            (header.count >= records) ||
+            (header.size != _recordSize(header.thread, header.count)) ||
+            (pos + header.size > pBuffer->pos) || (found == total))
+        {
+            CHECK(!"torn or unexpected record");
+            break;
+        }
+
+        for (j = sizeof(TEST_RECORD); j < header.size; j++)
+        {
+            CHECK(pBuffer->data[pos + j] == _payloadByte(header.thread, header.count, j));
+            sum += pBuffer->data[pos + j];
+        }
+        CHECK(sum == header.sum);
+        CHECK(header.count == pNext[header.thread]);
+        pNext[header.thread] = header.count + 1;
+
+        pStart[found]   = header.start;
+        pMinDone[found] = ppCompleted[header.thread][header.count];
+        found++;
+        pos += header.size;
+    }
+
+    for (i = 0; i < threads; i++)
+        CHECK(pNext[i] == records);
+
+    // pMinDone[i] becomes the earliest completion of any record from i on.
+    pMinDone[found] = ~0U;
+    for (i = found; i-- > 0; )
+        pMinDone[i] = NV_MIN(pMinDone[i], pMinDone[i + 1]);
+
+    for (i = 0; i < found; i++)
+        CHECK(pStart[i] < pMinDone[i + 1]);
+
+    free(pNext);
+    free(pStart);
+    free(pMinDone);
+    return found;
+}
+
+static void _stress(NvU32 locking, NvU32 threads, NvU32 records, NvBool bReader)
+{
+    pthread_t           writers[64];
+    pthread_t           reader;
+    WRITER_ARGS         args[64];
+    NvU32              *pCompleted[64];
+    NVLOG_BUFFER_HANDLE hBuffer;
+    NVLOG_BUFFER       *pSnapshot;
+    NvU32               size;
+    NvU32               snapshotSize;
+    NvU64               found;
+    NvU64               start;
+    NvU64               elapsed;
+    NvU32               i;
+
+    // Room for every record, so the buffer never wraps.
+    size = threads * records * (sizeof(TEST_RECORD) + RECORD_EXTRA_MAX) +
+           threads * (records / OVERSIZE_EVERY + 1) * OVERSIZE_SIZE;
+
+    CHECK(nvlogAllocBuffer(size,
+                           DRF_DEF(LOG, _BUFFER_FLAGS, _TYPE, _RING) |
+                           DRF_NUM(LOG, _BUFFER_FLAGS, _LOCKING, locking),
+                           TEST_TAG, &hBuffer) == NV_OK);
+
+    _clock = 0;
+    _bDone = NV_FALSE;
+
+    start = _nowNs();
+    if (bReader)
+        pthread_create(&reader, NULL, _reader, &hBuffer);
+    for (i = 0; i < threads; i++)
+    {
+        pCompleted[i] = malloc(records * sizeof(NvU32));
+        args[i].hBuffer    = hBuffer;
+        args[i].thread     = i;
+        args[i].records    = records;
+        args[i].pCompleted = pCompleted[i];
+        pthread_create(&writers[i], NULL, _writer, &args[i]);
+    }
+    for (i = 0; i < threads; i++)
+        pthread_join(writers[i], NULL);
+    elapsed = _nowNs() - start;
+
+    __atomic_store_n(&_bDone, NV_TRUE, __ATOMIC_RELEASE);
+    if (bReader)
+        pthread_join(reader, NULL);
+
+    // Taking the snapshot merges whatever is still staged.
+    snapshotSize = NV_OFFSETOF(NVLOG_BUFFER, data) + size;
+    pSnapshot = malloc(snapshotSize);
+    CHECK(nvlogGetBufferSnapshot(hBuffer, (NvU8 *)pSnapshot, snapshotSize) == NV_OK);
+
+    found = _verify(pSnapshot, threads, records, pCompleted);
+    CHECK(found == (NvU64)threads * records);
+
+    printf("%-6s reader=%d threads=%2u records=%8llu %7.2f Mrec/s\n",
+           (locking == NVLOG_BUFFER_FLAGS_LOCKING_PERCPU) ? "percpu" : "full",
+           bReader, threads, (unsigned long long)found,
+           (double)threads * records * 1000.0 / (double)elapsed);
+
+    for (i = 0; i < threads; i++)
+        free(pCompleted[i]);
+    free(pSnapshot);
+    nvlogDeallocBuffer(hBuffer);
+}
+
+int main(int argc, char **argv)
+{
+    NvU32 records    = (argc > 1) ? (NvU32)atoi(argv[1]) : 200000;
+    NvU32 maxThreads = (argc > 2) ? (NvU32)atoi(argv[2]) : 16;
+    NvU32 t;
+
+    if (maxThreads > 64)
+        maxThreads = 64;
+
+    CHECK(nvlogInit(NULL) == NV_OK);
+
+    for (t = 1; t <= maxThreads; t *= 2)
+    {
+        _stress(NVLOG_BUFFER_FLAGS_LOCKING_FULL, t, records, NV_FALSE);
+        _stress(NVLOG_BUFFER_FLAGS_LOCKING_PERCPU, t, records, NV_FALSE);
+        _stress(NVLOG_BUFFER_FLAGS_LOCKING_PERCPU, t, records, NV_TRUE);
+    }
+
+    nvlogDestroy();
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * NvPort memory, sync and debug functions for userspace tests that build RM
+ * sources with RM_CFLAGS. Only what the covered sources use is provided.
+ * Allocators are malloc based, spinlocks and reader/writer locks are pthread
+ * locks freed through the allocator they came from, and assertions abort
+ * the test.
+ */
+
+#define _GNU_SOURCE // sched_getcpu()
+
+#include "nvport/nvport.h"
+#include "utils/nvassert.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct PORT_SPINLOCK
+{
+    pthread_spinlock_t  spinlock;
+    PORT_MEM_ALLOCATOR *pAllocator;
+};
+
+struct PORT_RWLOCK
+{
+    pthread_rwlock_t    rwlock;
+    PORT_MEM_ALLOCATOR *pAllocator;
+};
+
+NV_STATUS portInitialize(void)
+{
+    return NV_OK;
+}
+
+void portShutdown(void)
+{
+}
+
+void *portMemAllocNonPaged(NvLength lengthBytes)
+{
+    return malloc(lengthBytes);
+}
+
+void *portMemAllocPaged(NvLength lengthBytes)
+{
+    return malloc(lengthBytes);
+}
+
+NvBool portMemExSafeForPagedAlloc(void)
+{
+    return NV_TRUE;
+}
+
+NvBool portMemExSafeForNonPagedAlloc(void)
+{
+    return NV_TRUE;
+}
+
+void portMemFree(void *pData)
+{
+    free(pData);
+}
+
+void *portMemCopy(void *pDestination, NvLength destSize, const void *pSource, NvLength srcSize)
+{
+    return memcpy(pDestination, pSource, srcSize);
+}
+
+void *portMemMove(void *pDestination, NvLength destSize, const void *pSource, NvLength srcSize)
+{
+    return memmove(pDestination, pSource, srcSize);
+}
+
+void *portMemSet(void *pData, NvU8 value, NvLength lengthBytes)
+{
+    return memset(pData, value, lengthBytes);
+}
+
+NvS32 portMemCmp(const void *pData0, const void *pData1, NvLength lengthBytes)
+{
+    return memcmp(pData0, pData1, lengthBytes);
+}
+
+static void *_testAlloc(PORT_MEM_ALLOCATOR *pAlloc, NvLength length)
+{
+    return malloc(length);
+}
+
+static void _testFree(PORT_MEM_ALLOCATOR *pAlloc, void *pMem)
+{
+    free(pMem);
+}
+
+static PORT_MEM_ALLOCATOR _testAllocator =
+{
+    ._portAlloc = _testAlloc,
+    ._portFree  = _testFree,
+};
+
+PORT_MEM_ALLOCATOR *portMemAllocatorGetGlobalNonPaged(void)
+{
+    return &_testAllocator;
+}
+
+PORT_MEM_ALLOCATOR *portMemAllocatorCreateNonPaged(void)
+{
+    PORT_MEM_ALLOCATOR *pAllocator = malloc(sizeof(*pAllocator));
+
+    if (pAllocator != NULL)
+        *pAllocator = _testAllocator;
+
+    return pAllocator;
+}
+
+void portMemAllocatorRelease(PORT_MEM_ALLOCATOR *pAllocator)
+{
+    if (pAllocator->_portRelease != NULL)
+        pAllocator->_portRelease(pAllocator);
+    else if (pAllocator != &_testAllocator)
+        free(pAllocator);
+}
+
+void portMemInitializeAllocatorTracking(PORT_MEM_ALLOCATOR *pAllocator, PORT_MEM_ALLOCATOR_TRACKING *pTracking)
+{
+    pAllocator->pTracking = NULL;
+}
+
+NvU32 _portMemGetCpuCount(void)
+{
+    return (NvU32)sysconf(_SC_NPROCESSORS_CONF);
+}
+
+NvU32 _portMemGetCurrentCpu(void)
+{
+    int cpu = sched_getcpu();
+
+    return (cpu < 0) ? 0 : (NvU32)cpu;
+}
+
+void *_portMemAllocatorAlloc(PORT_MEM_ALLOCATOR *pAlloc, NvLength length)
+{
+    return pAlloc->_portAlloc(pAlloc, length);
+}
+
+void _portMemAllocatorFree(PORT_MEM_ALLOCATOR *pAlloc, void *pMem)
+{
+    pAlloc->_portFree(pAlloc, pMem);
+}
+
+PORT_SPINLOCK *portSyncSpinlockCreate(PORT_MEM_ALLOCATOR *pAllocator)
+{
+    PORT_SPINLOCK *pSpinlock = PORT_ALLOC(pAllocator, sizeof(*pSpinlock));
+
+    if (pSpinlock != NULL)
+    {
+        pthread_spin_init(&pSpinlock->spinlock, PTHREAD_PROCESS_PRIVATE);
+        pSpinlock->pAllocator = pAllocator;
+    }
+
+    return pSpinlock;
+}
+
+void portSyncSpinlockDestroy(PORT_SPINLOCK *pSpinlock)
+{
+    pthread_spin_destroy(&pSpinlock->spinlock);
+    PORT_FREE(pSpinlock->pAllocator, pSpinlock);
+}
+
+void portSyncSpinlockAcquire(PORT_SPINLOCK *pSpinlock)
+{
+    pthread_spin_lock(&pSpinlock->spinlock);
+}
+
+void portSyncSpinlockRelease(PORT_SPINLOCK *pSpinlock)
+{
+    pthread_spin_unlock(&pSpinlock->spinlock);
+}
+
+PORT_RWLOCK *portSyncRwLockCreate(PORT_MEM_ALLOCATOR *pAllocator)
+{
+    PORT_RWLOCK *pLock = PORT_ALLOC(pAllocator, sizeof(*pLock));
+
+    if (pLock != NULL)
+    {
+        pthread_rwlock_init(&pLock->rwlock, NULL);
+        pLock->pAllocator = pAllocator;
+    }
+
+    return pLock;
+}
+
+void portSyncRwLockDestroy(PORT_RWLOCK *pLock)
+{
+    pthread_rwlock_destroy(&pLock->rwlock);
+    PORT_FREE(pLock->pAllocator, pLock);
+}
+
+void portSyncRwLockAcquireRead(PORT_RWLOCK *pLock)
+{
+    pthread_rwlock_rdlock(&pLock->rwlock);
+}
+
+void portSyncRwLockReleaseRead(PORT_RWLOCK *pLock)
+{
+    pthread_rwlock_unlock(&pLock->rwlock);
+}
+
+void portSyncRwLockAcquireWrite(PORT_RWLOCK *pLock)
+{
+    pthread_rwlock_wrlock(&pLock->rwlock);
+}
+
+void portSyncRwLockReleaseWrite(PORT_RWLOCK *pLock)
+{
+    pthread_rwlock_unlock(&pLock->rwlock);
+}
+
+NvU64 portThreadGetCurrentThreadId(void)
+{
+    return (NvU64)pthread_self();
+}
+
+void nvAssertFailedNoLog(NV_ASSERT_FAILED_FUNC_TYPE)
+{
+    abort();
+}
+
+void nvAssertOkFailedNoLog(NvU32 status NV_ASSERT_FAILED_FUNC_COMMA_TYPE)
+{
+    abort();
+}
+
+void NV_API_CALL out_string(const char *str)
+{
+    fputs(str, stderr);
+}
+
+NvBool nvDbgBreakpointEnabled(void)
+{
+    return NV_FALSE;
+}
+
+void NV_API_CALL os_dbg_breakpoint(void)
+{
+    abort();
+}
@@ -0,0 +1,435 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * RM control cache (rmapi_cache.c) functional checks and stress test.
+ *
+ * The functional checks cover a lookup round trip, a size mismatch, a
+ * repeated insert not replacing the cached params, object and client frees,
+ * CLOCK eviction giving a recently read entry a second chance, and the
+ * counters reported by rmapiControlCacheGetStats().
+ *
+ * The stress test runs threads that mix lookups, inserts and object and
+ * client frees on a small set of handles, with the cache bounded well below
+ * the working set so entries are evicted all the time. Every hit must carry
+ * the payload stored for its (client, object, command), hits plus misses
+ * must equal the lookups made, and the live entry count must stay within
+ * the bound. A read-only pass over a fully cached working set reports the
+ * lookup rate per thread count.
+ *
+ *     rmapi_cache_test [operations per thread] [max threads]
+ */
+
+#include "nvrm_registry.h"
+#include "rmapi/rmapi.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PARAMS_WORDS   16
+#define CLIENT_COUNT   4
+#define OBJECT_COUNT   64
+#define COMMAND_COUNT  8
+
+static unsigned failures;
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+// Registry values seen by rmapiControlCacheInit()
+static NvU32 _regMode = NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE;
+static NvU32 _regMaxEntries;
+
+NV_STATUS osReadRegistryDword(OBJGPU *pGpu, const char *pRegParmStr, NvU32 *pData)
+{
+    if (strcmp(pRegParmStr, NV_REG_STR_RM_CACHEABLE_CONTROLS) == 0)
+    {
+        *pData = _regMode;
+        return NV_OK;
+    }
+    if (strcmp(pRegParmStr, NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_ENTRIES) == 0)
+    {
+        *pData = _regMaxEntries;
+        return NV_OK;
+    }
+    return NV_ERR_OBJECT_NOT_FOUND;
+}
+
+void osSpinLoop(void)
+{
+    sched_yield();
+}
+
+static void _cacheInit(NvU32 mode, NvU32 maxEntries)
+{
+    _regMode = mode;
+    _regMaxEntries = maxEntries;
+    rmapiControlCacheInit();
+}
+
+static NvU64 _nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (NvU64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static NvHandle _client(NvU32 i)  { return 0xc1d00000 + i; }
+static NvHandle _object(NvU32 i)  { return 0x5c000000 + i; }
+static NvU32    _command(NvU32 i) { return 0x20800100 + i; }
+
+static void _fillParams(NvU32 *pParams, NvHandle hClient, NvHandle hObject, NvU32 cmd)
+{
+    NvU32 i;
+
+    for (i = 0; i < PARAMS_WORDS; i++)
+        pParams[i] = hClient ^ hObject ^ cmd ^ i;
+}
+
+static NvBool _checkParams(const NvU32 *pParams, NvHandle hClient, NvHandle hObject, NvU32 cmd)
+{
+    NvU32 i;
+
+    for (i = 0; i < PARAMS_WORDS; i++)
+    {
+        if (pParams[i] != (hClient ^ hObject ^ cmd ^ i))
+            return NV_FALSE;
+    }
+    return NV_TRUE;
+}
+
+static NV_STATUS _set(NvHandle hClient, NvHandle hObject, NvU32 cmd)
+{
+    NvU32 params[PARAMS_WORDS];
+
+    _fillParams(params, hClient, hObject, cmd);
+    return rmapiControlCacheSet(hClient, hObject, cmd, params, sizeof(params));
+}
+
+static NvBool _hit(NvHandle hClient, NvHandle hObject, NvU32 cmd)
+{
+    NvU32 params[PARAMS_WORDS];
+
+    if (rmapiControlCacheGet(hClient, hObject, cmd, params, sizeof(params)) != NV_OK)
+        return NV_FALSE;
+
+    CHECK(_checkParams(params, hClient, hObject, cmd));
+    return NV_TRUE;
+}
+
+static void _testRoundTrip(void)
+{
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NvU32 params[PARAMS_WORDS];
+
+    _cacheInit(NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE, 0);
+
+    CHECK(!_hit(_client(0), _object(0), _command(0)));
+    CHECK(_set(_client(0), _object(0), _command(0)) == NV_OK);
+    CHECK(_hit(_client(0), _object(0), _command(0)));
+
+    // A different size is a miss, not a partial copy.
+    CHECK(rmapiControlCacheGet(_client(0), _object(0), _command(0),
+                               params, sizeof(params) / 2) == NV_ERR_OBJECT_NOT_FOUND);
+
+    // Caching the same control again keeps the first result.
+    _fillParams(params, 0, 0, 0);
+    CHECK(rmapiControlCacheSet(_client(0), _object(0), _command(0),
+                               params, sizeof(params)) == NV_OK);
+    CHECK(_hit(_client(0), _object(0), _command(0)));
+
+    CHECK(rmapiControlCacheGetStats(&stats) == NV_OK);
+    CHECK(stats.hits == 2);
+    CHECK(stats.misses == 2);
+    CHECK(stats.evictions == 0);
+    CHECK(stats.entries == 1);
+    CHECK(stats.maxEntries == NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_ENTRIES_DEFAULT);
+
+    rmapiControlCacheFree();
+}
+
+static void _testFree(void)
+{
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NvU32 c, o, k;
+
+    _cacheInit(NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE, 0);
+
+    for (c = 0; c < 2; c++)
+        for (o = 0; o < 2; o++)
+            for (k = 0; k < 2; k++)
+                CHECK(_set(_client(c), _object(o), _command(k)) == NV_OK);
+
+    rmapiControlCacheFreeObject(_client(0), _object(0));
+    CHECK(!_hit(_client(0), _object(0), _command(0)));
+    CHECK(!_hit(_client(0), _object(0), _command(1)));
+    CHECK(_hit(_client(0), _object(1), _command(0)));
+    CHECK(_hit(_client(1), _object(0), _command(0)));
+
+    rmapiControlCacheFreeClient(_client(0));
+    CHECK(!_hit(_client(0), _object(1), _command(0)));
+    CHECK(_hit(_client(1), _object(0), _command(1)));
+    CHECK(_hit(_client(1), _object(1), _command(1)));
+
+    CHECK(rmapiControlCacheGetStats(&stats) == NV_OK);
+    CHECK(stats.entries == 4);
+    CHECK(stats.evictions == 0);
+
+    rmapiControlCacheFree();
+}
+
+//
+// Commands of one object share a shard. With two entries per shard, an
+// entry read since it was cached survives the next insert and the other
+// one is evicted.
+//
+static void _testEviction(void)
+{
+    RMAPI_CONTROL_CACHE_STATS stats;
+
+    _cacheInit(NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE, 32);
+
+    CHECK(_set(_client(0), _object(0), _command(0)) == NV_OK);
+    CHECK(_set(_client(0), _object(0), _command(1)) == NV_OK);
+    CHECK(_hit(_client(0), _object(0), _command(0)));
+    CHECK(_set(_client(0), _object(0), _command(2)) == NV_OK);
+
+    CHECK(_hit(_client(0), _object(0), _command(0)));
+    CHECK(!_hit(_client(0), _object(0), _command(1)));
+    CHECK(_hit(_client(0), _object(0), _command(2)));
+
+    CHECK(rmapiControlCacheGetStats(&stats) == NV_OK);
+    CHECK(stats.evictions == 1);
+    CHECK(stats.entries == 2);
+    CHECK(stats.maxEntries == 32);
+
+    // Freeing the object drops the survivors and their submap.
+    rmapiControlCacheFreeObject(_client(0), _object(0));
+    CHECK(rmapiControlCacheGetStats(&stats) == NV_OK);
+    CHECK(stats.entries == 0);
+
+    rmapiControlCacheFree();
+}
+
+static void _testDisabled(void)
+{
+    RMAPI_CONTROL_CACHE_STATS stats;
+
+    _cacheInit(NV_REG_STR_RM_CACHEABLE_CONTROLS_DISABLE, 0);
+    CHECK(rmapiControlCacheGetStats(&stats) == NV_ERR_INVALID_STATE);
+    CHECK(stats.hits == 0 && stats.entries == 0);
+    rmapiControlCacheFree();
+
+    // The counters read as disabled once the cache is torn down.
+    _cacheInit(NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE, 0);
+    CHECK(_set(_client(0), _object(0), _command(0)) == NV_OK);
+    rmapiControlCacheFree();
+    CHECK(rmapiControlCacheGetStats(&stats) == NV_ERR_INVALID_STATE);
+}
+
+static volatile NvBool _bStatsStop;
+
+static void *_statsThread(void *pArg)
+{
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NvU64 *pReads = pArg;
+
+    while (!_bStatsStop)
+    {
+        if (rmapiControlCacheGetStats(&stats) == NV_OK)
+            (*pReads)++;
+        sched_yield();
+    }
+    return NULL;
+}
+
+//
+// procfs readers may call rmapiControlCacheGetStats() while RM brings the
+// cache up or tears it down; they must never see a half-built shard.
+//
+static void _testStatsRace(NvU32 cycles)
+{
+    pthread_t tid;
+    NvU64 reads = 0;
+    NvU32 i;
+
+    _bStatsStop = NV_FALSE;
+    pthread_create(&tid, NULL, _statsThread, &reads);
+
+    for (i = 0; i < cycles; i++)
+    {
+        _cacheInit(NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE, 0);
+        CHECK(_set(_client(i), _object(i), _command(i)) == NV_OK);
+        sched_yield();
+        rmapiControlCacheFree();
+        sched_yield();
+    }
+
+    _bStatsStop = NV_TRUE;
+    pthread_join(tid, NULL);
+    printf("stats race: %u init/free cycles, %llu stats reads\n",
+           cycles, (unsigned long long)reads);
+}
+
+typedef struct
+{
+    NvU32           seed;
+    NvU32           operations;
+    NvBool          bReadOnly;
+    NvU64           lookups;
+    NvU32           badPayloads;
+} STRESS_THREAD;
+
+static void *_stressThread(void *pArg)
+{
+    STRESS_THREAD *pThread = pArg;
+    NvU32 params[PARAMS_WORDS];
+    NvU32 i;
+
+    for (i = 0; i < pThread->operations; i++)
+    {
+        NvHandle hClient = _client(rand_r(&pThread->seed) % CLIENT_COUNT);
+        NvHandle hObject = _object(rand_r(&pThread->seed) % OBJECT_COUNT);
+        NvU32 cmd = _command(rand_r(&pThread->seed) % COMMAND_COUNT);
+        NvU32 op = rand_r(&pThread->seed) % 1000;
+
+        if (pThread->bReadOnly || (op < 900))
+        {
+            pThread->lookups++;
+            if ((rmapiControlCacheGet(hClient, hObject, cmd, params, sizeof(params)) == NV_OK) &&
+                !_checkParams(params, hClient, hObject, cmd))
+            {
+                pThread->badPayloads++;
+            }
+        }
+        else if (op < 990)
+        {
+            _set(hClient, hObject, cmd);
+        }
+        else if (op < 998)
+        {
+            rmapiControlCacheFreeObject(hClient, hObject);
+        }
+        else
+        {
+            rmapiControlCacheFreeClient(hClient);
+        }
+    }
+
+    return NULL;
+}
+
+static void _stress(NvU32 threadCount, NvU32 operations, NvBool bReadOnly, NvU32 maxEntries)
+{
+    STRESS_THREAD threads[64];
+    pthread_t tids[64];
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NvU64 lookups = 0, start, elapsed;
+    NvU32 badPayloads = 0;
+    NvU32 c, o, k, i;
+
+    _cacheInit(NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE, maxEntries);
+
+    if (bReadOnly)
+    {
+        for (c = 0; c < CLIENT_COUNT; c++)
+            for (o = 0; o < OBJECT_COUNT; o++)
+                for (k = 0; k < COMMAND_COUNT; k++)
+                    CHECK(_set(_client(c), _object(o), _command(k)) == NV_OK);
+    }
+
+    start = _nowNs();
+    for (i = 0; i < threadCount; i++)
+    {
+        threads[i].seed = i * 7919 + 1;
+        threads[i].operations = operations;
+        threads[i].bReadOnly = bReadOnly;
+        threads[i].lookups = 0;
+        threads[i].badPayloads = 0;
+        pthread_create(&tids[i], NULL, _stressThread, &threads[i]);
+    }
+    for (i = 0; i < threadCount; i++)
+    {
+        pthread_join(tids[i], NULL);
+        lookups += threads[i].lookups;
+        badPayloads += threads[i].badPayloads;
+    }
+    elapsed = _nowNs() - start;
+
+    CHECK(rmapiControlCacheGetStats(&stats) == NV_OK);
+    CHECK(badPayloads == 0);
+    CHECK(stats.hits + stats.misses == lookups);
+    CHECK(stats.entries <= stats.maxEntries);
+    if (bReadOnly)
+        CHECK(stats.misses == 0);
+
+    printf("%-9s threads %2u: %9.0f ops/s  hits %llu misses %llu evictions %llu entries %llu/%llu\n",
+           bReadOnly ? "read-only" : "mixed", threadCount, threadCount * (double)operations * 1e9 / elapsed,
+           (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+           (unsigned long long)stats.evictions, (unsigned long long)stats.entries,
+           (unsigned long long)stats.maxEntries);
+
+    rmapiControlCacheFree();
+}
+
+int main(int argc, char **argv)
+{
+    NvU32 operations = (argc > 1) ? (NvU32)atoi(argv[1]) : 400000;
+    NvU32 maxThreads = (argc > 2) ? (NvU32)atoi(argv[2]) : 16;
+    NvU32 t;
+
+    if (maxThreads > 64)
+        maxThreads = 64;
+
+    _testRoundTrip();
+    _testFree();
+    _testEviction();
+    _testDisabled();
+    _testStatsRace(2000);
+
+    // 256 entries for a working set of 2048 controls
+    for (t = 1; t <= maxThreads; t *= 2)
+        _stress(t, operations, NV_FALSE, 256);
+
+    //
+    // Room for the whole working set in any one shard, so shard imbalance
+    // cannot evict anything and every lookup hits.
+    //
+    for (t = 1; t <= maxThreads; t *= 2)
+        _stress(t, operations, NV_TRUE, 16 * CLIENT_COUNT * OBJECT_COUNT * COMMAND_COUNT);
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
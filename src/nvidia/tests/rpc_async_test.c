@@ -0,0 +1,828 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Asynchronous GSP RPCs against a loopback GSP.
+ *
+ * The GSP client RPC path is built as shipped: kernel_gsp.c is included for
+ * its send, poll and drain routines, and rpc.c and rpc_async.c are linked
+ * unchanged. Controls are issued through rpcRmApiControl_GSP(),
+ * rpcRmApiControlAsync_GSP(), rpcRmApiControlAsyncWait_GSP() and
+ * rpcRmApiControlBatch_GSP(). Only the message queue and the doorbell are
+ * replaced: GspMsgQueueSendCommand() appends to a command ring, the doorbell
+ * (kgspSetCmdQueueHead) hands what was appended to the responder, and
+ * GspMsgQueueReceiveStatus() pops the status ring. The responder answers the
+ * commands it was handed in order, like GSP, adding one to every word of the
+ * control params so replies handed to the wrong RPC are caught. It either
+ * echoes the sequence or leaves it 0.
+ *
+ * The functional checks drive the responder from osSpinLoop(), i.e. from the
+ * poll loop in _kgspRpcRecvPoll(): replies collected out of order, a full
+ * table, an entry that is never collected, async replies parked by
+ * _kgspRpcDrainOneEvent() while a synchronous RPC polls, events passed on
+ * to event handling, tombstones that swallow late replies or are retired,
+ * a synchronous reply with the same function as a tombstone, sequence
+ * wraparound, and the batch doorbell being deferred, forced when the
+ * command queue fills up, and ordered around controls issued in place.
+ *
+ * The benchmarks run the responder on its own thread with a fixed delay
+ * between the doorbell and a command being picked up (doorbell and
+ * scheduling latency) and a fixed service time. The first reports RPCs per
+ * second with 1..32 RPCs kept in flight, collected in random order. The
+ * second compares controls issued one at a time against batches of 4..32
+ * issued with rpcRmApiControlBatch_GSP().
+ *
+ *     rpc_async_test [rpcs per depth] [latency us] [service us]
+ */
+
+#include "../src/kernel/gpu/gsp/kernel_gsp.c"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOOPBACK_QUEUE_SIZE 64
+#define LOOPBACK_MSG_SIZE   4096
+
+// A flat control FINN does not know, so its params are copied as they are
+#define TEST_CMD            0xDEAD0101
+#define TEST_PARAM_WORDS    8
+
+typedef struct
+{
+    NvU32 words[TEST_PARAM_WORDS];
+} TEST_PARAMS;
+
+typedef struct
+{
+    NvU8  *pMsgs;
+    NvU64  postNs[LOOPBACK_QUEUE_SIZE];     // When the doorbell handed the command over
+    NvU32  capacity;
+    NvU32  put;
+    NvU32  get;
+} LOOPBACK_QUEUE;
+
+static struct
+{
+    LOOPBACK_QUEUE   cmdQueue;
+    LOOPBACK_QUEUE   statusQueue;
+    NvU32            handedOver;        // Commands before this were announced by the doorbell
+    NvU32            doorbells;
+    NvU32            replies;           // Replies sent, stamped into the last param word
+    NvBool           bEchoSequence;
+    NvU32            dropReplies;       // Replies GSP loses
+    NvBool           bAutoRespond;      // osSpinLoop() answers one command
+    NvBool           bThreaded;         // The responder runs on its own thread
+    NvU32            timeoutPolls;      // Timeout checks left before one fails, 0 for none
+    NvU64            latencyNs;
+    NvU64            serviceNs;
+    NvBool           bStop;
+
+    NvU32            unexpected;        // Messages _kgspProcessRpcEvent() did not know
+    NvU32            swallowed;         // Late replies dropped by rpcAsyncCompleteReply()
+    NvU32            stalls;            // Sends that found the queue full and nothing handed over
+} _gsp;
+
+static OBJGPU             *_pGpu;
+static OBJRPC             *_pRpc;
+static MESSAGE_QUEUE_INFO  _mqi;
+static RM_API              _rmApi;
+
+static unsigned failures;
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+static NvU64 _nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (NvU64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static rpc_message_header_v *_queueSlot(LOOPBACK_QUEUE *pQueue, NvU32 index)
+{
+    return (rpc_message_header_v *)(pQueue->pMsgs + (index % LOOPBACK_QUEUE_SIZE) * LOOPBACK_MSG_SIZE);
+}
+
+static NvU32 _queueUsed(LOOPBACK_QUEUE *pQueue)
+{
+    return __atomic_load_n(&pQueue->put, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&pQueue->get, __ATOMIC_ACQUIRE);
+}
+
+//
+// GSP side: answer the oldest command the doorbell handed over, or drop the
+// reply if GSP is to lose it.
+//
+static NvBool _gspRespondOne(void)
+{
+    LOOPBACK_QUEUE *pCmdQueue = &_gsp.cmdQueue;
+    LOOPBACK_QUEUE *pStatusQueue = &_gsp.statusQueue;
+    rpc_message_header_v *pCmd, *pReply;
+    NvU32 get = pCmdQueue->get;
+    NvU64 start;
+
+    if (get == __atomic_load_n(&_gsp.handedOver, __ATOMIC_ACQUIRE))
+        return NV_FALSE;
+
+    pCmd = _queueSlot(pCmdQueue, get);
+
+    if (_gsp.bThreaded)
+    {
+        while (_nowNs() < pCmdQueue->postNs[get % LOOPBACK_QUEUE_SIZE] + _gsp.latencyNs)
+            sched_yield();
+        start = _nowNs();
+        while (_nowNs() < start + _gsp.serviceNs)
+            ;
+    }
+
+    if (_gsp.dropReplies != 0)
+    {
+        _gsp.dropReplies--;
+        __atomic_store_n(&pCmdQueue->get, get + 1, __ATOMIC_RELEASE);
+        return NV_TRUE;
+    }
+
+    while (_queueUsed(pStatusQueue) == pStatusQueue->capacity)
+        sched_yield();
+
+    pReply = _queueSlot(pStatusQueue, pStatusQueue->put);
+    memcpy(pReply, pCmd, pCmd->length);
+    pReply->rpc_result = NV_VGPU_MSG_RESULT_SUCCESS;
+    pReply->sequence   = _gsp.bEchoSequence ? pCmd->sequence : 0;
+
+    if (pCmd->function == NV_VGPU_MSG_FUNCTION_GSP_RM_CONTROL)
+    {
+        rpc_gsp_rm_control_v03_00 *pControl = &pReply->rpc_message_data->gsp_rm_control_v03_00;
+        TEST_PARAMS *pParams = (TEST_PARAMS *)pControl->params;
+        NvU32 i;
+
+        for (i = 0; i < TEST_PARAM_WORDS - 1; i++)
+            pParams->words[i]++;
+        pParams->words[TEST_PARAM_WORDS - 1] = _gsp.replies++;
+        pControl->status = NV_OK;
+    }
+
+    __atomic_store_n(&pStatusQueue->put, pStatusQueue->put + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&pCmdQueue->get, get + 1, __ATOMIC_RELEASE);
+    return NV_TRUE;
+}
+
+// Put an event straight into the status queue, as GSP would on its own.
+static void _gspSendEvent(NvU32 function, NvU32 sequence)
+{
+    LOOPBACK_QUEUE *pStatusQueue = &_gsp.statusQueue;
+    rpc_message_header_v *pEvent = _queueSlot(pStatusQueue, pStatusQueue->put);
+
+    memset(pEvent, 0, sizeof(*pEvent));
+    pEvent->length     = sizeof(*pEvent);
+    pEvent->function   = function;
+    pEvent->sequence   = sequence;
+    pEvent->rpc_result = NV_VGPU_MSG_RESULT_SUCCESS;
+    __atomic_store_n(&pStatusQueue->put, pStatusQueue->put + 1, __ATOMIC_RELEASE);
+}
+
+static void *_gspThread(void *pArg)
+{
+    while (!__atomic_load_n(&_gsp.bStop, __ATOMIC_ACQUIRE))
+    {
+        if (!_gspRespondOne())
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+//
+// The message queue, doorbell and platform functions the RPC path calls.
+//
+
+NV_STATUS GspMsgQueueSendCommand(MESSAGE_QUEUE_INFO *pMQI, OBJGPU *pGpu)
+{
+    LOOPBACK_QUEUE *pCmdQueue = &_gsp.cmdQueue;
+
+    // GSP keeps draining what it was handed while the queue is full.
+    while (_queueUsed(pCmdQueue) == pCmdQueue->capacity)
+    {
+        if (pCmdQueue->get == __atomic_load_n(&_gsp.handedOver, __ATOMIC_ACQUIRE))
+        {
+            _gsp.stalls++;
+            return NV_ERR_BUSY_RETRY;
+        }
+        if (_gsp.bThreaded || !_gspRespondOne())
+            sched_yield();
+    }
+
+    memcpy(_queueSlot(pCmdQueue, pCmdQueue->put), pMQI->pRpcMsgBuf, pMQI->pRpcMsgBuf->length);
+    __atomic_store_n(&pCmdQueue->put, pCmdQueue->put + 1, __ATOMIC_RELEASE);
+    return NV_OK;
+}
+
+NV_STATUS GspMsgQueueReceiveStatus(MESSAGE_QUEUE_INFO *pMQI)
+{
+    LOOPBACK_QUEUE *pStatusQueue = &_gsp.statusQueue;
+    rpc_message_header_v *pReply;
+
+    if (_queueUsed(pStatusQueue) == 0)
+        return NV_WARN_NOTHING_TO_DO;
+
+    pReply = _queueSlot(pStatusQueue, pStatusQueue->get);
+    memcpy(pMQI->pRpcMsgBuf, pReply, pReply->length);
+    __atomic_store_n(&pStatusQueue->get, pStatusQueue->get + 1, __ATOMIC_RELEASE);
+    return NV_OK;
+}
+
+unsigned msgqTxGetFreeSpace(msgqHandle handle)
+{
+    return (_gsp.cmdQueue.capacity - _queueUsed(&_gsp.cmdQueue)) *
+           GSP_MSG_QUEUE_BYTES_TO_ELEMENTS(GSP_MSG_QUEUE_ELEMENT_SIZE_MAX);
+}
+
+// The doorbell: hand everything queued so far to GSP.
+NV_STATUS kgspSetCmdQueueHead_TU102(OBJGPU *pGpu, KernelGsp *pKernelGsp, NvU32 queueIdx, NvU32 value)
+{
+    NvU32 put = __atomic_load_n(&_gsp.cmdQueue.put, __ATOMIC_ACQUIRE);
+    NvU64 now = _nowNs();
+    NvU32 i;
+
+    for (i = _gsp.handedOver; i != put; i++)
+        _gsp.cmdQueue.postNs[i % LOOPBACK_QUEUE_SIZE] = now;
+
+    __atomic_store_n(&_gsp.handedOver, put, __ATOMIC_RELEASE);
+    _gsp.doorbells++;
+    return NV_OK;
+}
+
+void kgspHealthCheck_TU102(OBJGPU *pGpu, KernelGsp *pKernelGsp)
+{
+}
+
+OBJRPC *gpuGetRpc(OBJGPU *pGpu)
+{
+    return _pRpc;
+}
+
+NvBool rmDeviceGpuLockIsOwner(NvU32 gpuInst)
+{
+    return NV_TRUE;
+}
+
+void osSpinLoop(void)
+{
+    if (_gsp.bThreaded || !_gsp.bAutoRespond || !_gspRespondOne())
+        sched_yield();
+}
+
+void timeoutSet(TIMEOUT_DATA *pTD, RMTIMEOUT *pTimeout, NvU32 timeoutUs, NvU32 flags)
+{
+    pTimeout->timeout = _nowNs() + 10000000000ULL;
+}
+
+NV_STATUS timeoutCheck(TIMEOUT_DATA *pTD, RMTIMEOUT *pTimeout, NvU32 lineNum)
+{
+    if ((_gsp.timeoutPolls != 0) && (--_gsp.timeoutPolls == 0))
+        return NV_ERR_TIMEOUT;
+
+    return (_nowNs() > pTimeout->timeout) ? NV_ERR_TIMEOUT : NV_OK;
+}
+
+void nvErrorLog_va(void *pGpu, NvU32 num, const char *pFormat, ...)
+{
+}
+
+void osAssertFailed(void)
+{
+}
+
+void nvCheckFailedNoLog(NvU32 level NV_ASSERT_FAILED_FUNC_COMMA_TYPE)
+{
+}
+
+const char *nvAssertStatusToString(NV_STATUS nvStatusIn)
+{
+    return "";
+}
+
+// Count the log lines that show where a reply went.
+void nvDbg_Printf(const char *file, int line, const char *function, int debuglevel, const char *s, ...)
+{
+    if (strstr(s, "Unexpected RPC function") != NULL)
+        _gsp.unexpected++;
+    else if (strstr(s, "Late reply for abandoned RPC") != NULL)
+        _gsp.swallowed++;
+}
+
+//
+// Test setup, as _kgspInitRpcInfrastructure() does it.
+//
+static void _reset(NvBool bEcho)
+{
+    static NvU8 cmdMsgs[LOOPBACK_QUEUE_SIZE * LOOPBACK_MSG_SIZE];
+    static NvU8 statusMsgs[LOOPBACK_QUEUE_SIZE * LOOPBACK_MSG_SIZE];
+    static NvU32 msgBuf[LOOPBACK_MSG_SIZE / sizeof(NvU32)];
+    KernelGsp *pKernelGsp;
+
+    if (_pGpu == NULL)
+    {
+        _pGpu      = calloc(1, sizeof(*_pGpu));
+        pKernelGsp = calloc(1, sizeof(*pKernelGsp));
+        _pRpc      = calloc(1, sizeof(*_pRpc));
+        _pGpu->pKernelGsp = pKernelGsp;
+        pKernelGsp->pRpc  = _pRpc;
+        _rmApi.pPrivateContext = _pGpu;
+    }
+
+    rpcAsyncCancelAll(_pGpu, _pRpc);
+    memset(&_pRpc->async, 0, sizeof(_pRpc->async));
+
+    memset(&_gsp, 0, sizeof(_gsp));
+    _gsp.cmdQueue.pMsgs       = cmdMsgs;
+    _gsp.cmdQueue.capacity    = LOOPBACK_QUEUE_SIZE;
+    _gsp.statusQueue.pMsgs    = statusMsgs;
+    _gsp.statusQueue.capacity = LOOPBACK_QUEUE_SIZE;
+    _gsp.bEchoSequence        = bEcho;
+    _gsp.bAutoRespond         = NV_TRUE;
+
+    _mqi.pRpcMsgBuf          = (rpc_message_header_v *)msgBuf;
+    _pRpc->pMessageQueueInfo = &_mqi;
+    _pRpc->message_buffer    = msgBuf;
+    _pRpc->maxRpcSize        = LOOPBACK_MSG_SIZE;
+
+    rpcSendMessage_FNPTR(_pRpc) = _kgspRpcSendMessage;
+    rpcRecvPoll_FNPTR(_pRpc)    = _kgspRpcRecvPoll;
+}
+
+static void _fill(TEST_PARAMS *pParams, NvU32 base)
+{
+    NvU32 i;
+
+    for (i = 0; i < TEST_PARAM_WORDS; i++)
+        pParams->words[i] = base + i;
+}
+
+// The reply to the params filled with base, or -1 if it is not
+static NvS64 _replyOrder(const TEST_PARAMS *pParams, NvU32 base)
+{
+    NvU32 i;
+
+    for (i = 0; i < TEST_PARAM_WORDS - 1; i++)
+    {
+        if (pParams->words[i] != base + i + 1)
+            return -1;
+    }
+    return pParams->words[TEST_PARAM_WORDS - 1];
+}
+
+static NV_STATUS _control(NvU32 base, TEST_PARAMS *pParams)
+{
+    _fill(pParams, base);
+    return rpcRmApiControl_GSP(&_rmApi, 0xc1d00001, 0x5000, TEST_CMD, pParams, sizeof(*pParams));
+}
+
+static NV_STATUS _submit(NvU32 base, NvU32 *pSequence)
+{
+    TEST_PARAMS params;
+
+    _fill(&params, base);
+    return rpcRmApiControlAsync_GSP(&_rmApi, 0xc1d00001, 0x5000, TEST_CMD, &params, sizeof(params),
+                                    pSequence);
+}
+
+static NV_STATUS _collect(NvU32 sequence, TEST_PARAMS *pParams)
+{
+    return rpcRmApiControlAsyncWait_GSP(&_rmApi, sequence, pParams, sizeof(*pParams));
+}
+
+// Submit one RPC and collect it, so the table learns whether GSP echoes sequences.
+static void _roundTrip(void)
+{
+    TEST_PARAMS params;
+    NvU32 sequence;
+
+    CHECK(_submit(7, &sequence) == NV_OK);
+    CHECK(_collect(sequence, &params) == NV_OK);
+    CHECK(_replyOrder(&params, 7) >= 0);
+}
+
+static void _testOutOfOrder(NvBool bEcho)
+{
+    NvU32 seq[RPC_ASYNC_MAX_OUTSTANDING];
+    TEST_PARAMS params;
+    NvU32 extra;
+    NvU32 i;
+
+    _reset(bEcho);
+
+    for (i = 0; i < RPC_ASYNC_MAX_OUTSTANDING; i++)
+        CHECK(_submit(1000 * i, &seq[i]) == NV_OK);
+    CHECK(_submit(0, &extra) == NV_ERR_BUSY_RETRY);
+
+    // Outside a batch every submission rings the doorbell.
+    CHECK(_gsp.doorbells == RPC_ASYNC_MAX_OUTSTANDING);
+
+    // Collect back to front, then check the table drained.
+    for (i = RPC_ASYNC_MAX_OUTSTANDING; i > 0; i--)
+    {
+        CHECK(_collect(seq[i - 1], &params) == NV_OK);
+        CHECK(_replyOrder(&params, 1000 * (i - 1)) == i - 1);
+    }
+    CHECK(_pRpc->async.usedMask == 0);
+    CHECK(_gsp.unexpected == 0);
+}
+
+//
+// An entry that is never collected only takes its own slot; the others keep
+// being reused around it.
+//
+static void _testUncollected(void)
+{
+    TEST_PARAMS params;
+    NvU32 stuck, seq;
+    NvU32 i;
+
+    _reset(NV_TRUE);
+
+    CHECK(_submit(5, &stuck) == NV_OK);
+
+    for (i = 0; i < 10 * RPC_ASYNC_MAX_OUTSTANDING; i++)
+    {
+        CHECK(_submit(100 * i, &seq) == NV_OK);
+        CHECK(_collect(seq, &params) == NV_OK);
+        CHECK(_replyOrder(&params, 100 * i) >= 0);
+    }
+
+    CHECK(__builtin_popcount(_pRpc->async.usedMask) == 1);
+    CHECK(rpcAsyncPoll(_pGpu, _pRpc, stuck) == NV_OK);
+    CHECK(_collect(stuck, &params) == NV_OK);
+    CHECK(_replyOrder(&params, 5) == 0);
+    CHECK(_pRpc->async.usedMask == 0);
+}
+
+//
+// _kgspRpcDrainOneEvent() hands replies to rpcAsyncCompleteReply() before it
+// looks for the function being polled for, and events never go to the table.
+//
+static void _testDrainHook(NvBool bEcho)
+{
+    TEST_PARAMS params;
+    NvU32 a, b;
+
+    _reset(bEcho);
+
+    CHECK(_submit(100, &a) == NV_OK);
+    CHECK(_submit(200, &b) == NV_OK);
+    CHECK(rpcAsyncPoll(_pGpu, _pRpc, a) == NV_WARN_MORE_PROCESSING_REQUIRED);
+
+    // A synchronous control with the same function, polled for after A and B.
+    CHECK(_control(300, &params) == NV_OK);
+    CHECK(_replyOrder(&params, 300) == 2);
+
+    // Its poll parked A's and B's replies on the way.
+    CHECK(rpcAsyncPoll(_pGpu, _pRpc, a) == NV_OK);
+    CHECK(rpcAsyncPoll(_pGpu, _pRpc, b) == NV_OK);
+    _gsp.bAutoRespond = NV_FALSE;
+    CHECK(_collect(b, &params) == NV_OK && _replyOrder(&params, 200) == 1);
+    CHECK(_collect(a, &params) == NV_OK && _replyOrder(&params, 100) == 0);
+    _gsp.bAutoRespond = NV_TRUE;
+
+    // An event carrying an outstanding sequence is still an event.
+    CHECK(_submit(400, &a) == NV_OK);
+    _gspSendEvent(NV_VGPU_MSG_EVENT_GSP_INIT_DONE, a);
+    CHECK(_collect(a, &params) == NV_OK && _replyOrder(&params, 400) >= 0);
+    CHECK(_gsp.unexpected == 1);
+    CHECK(_pRpc->async.usedMask == 0);
+}
+
+static void _testTombstone(NvBool bEcho)
+{
+    TEST_PARAMS params;
+    NvU32 a, b, c;
+
+    _reset(bEcho);
+    _roundTrip();
+
+    //
+    // The wait on A gives up before GSP answers. A's late reply must be
+    // swallowed by the tombstone rather than passed on as an event, and must
+    // not be taken for B's.
+    //
+    CHECK(_submit(100, &a) == NV_OK);
+    CHECK(_submit(200, &b) == NV_OK);
+    _gsp.bAutoRespond = NV_FALSE;
+    _gsp.timeoutPolls = 1;
+    CHECK(_collect(a, &params) == NV_ERR_TIMEOUT);
+    CHECK(rpcAsyncPoll(_pGpu, _pRpc, a) == NV_ERR_OBJECT_NOT_FOUND);
+    CHECK(__builtin_popcount(_pRpc->async.usedMask) == 2);
+
+    _gsp.bAutoRespond = NV_TRUE;
+    CHECK(_collect(b, &params) == NV_OK && _replyOrder(&params, 200) >= 0);
+    CHECK(_gsp.swallowed == 1);
+    CHECK(_gsp.unexpected == 0);
+    CHECK(_pRpc->async.usedMask == 0);
+
+    //
+    // A reply that never comes: the tombstone goes once a later RPC is
+    // answered, since GSP answers in order. Without echoed sequences a lost
+    // reply cannot be told apart from a late one, so only check it here.
+    //
+    if (!bEcho)
+        return;
+
+    CHECK(_submit(300, &a) == NV_OK);
+    _gsp.bAutoRespond = NV_FALSE;
+    _gsp.timeoutPolls = 1;
+    CHECK(_collect(a, &params) == NV_ERR_TIMEOUT);
+    _gsp.bAutoRespond = NV_TRUE;
+    _gsp.dropReplies = 1;
+    CHECK(_submit(400, &c) == NV_OK);
+    CHECK(_collect(c, &params) == NV_OK && _replyOrder(&params, 400) >= 0);
+    CHECK(_pRpc->async.usedMask == 0);
+    CHECK(_gsp.unexpected == 0);
+}
+
+//
+// A synchronous RPC with the same function as a tombstone. Its reply has
+// sequence 0 and must reach the synchronous caller.
+//
+static void _testTombstoneSyncReply(NvBool bEcho)
+{
+    TEST_PARAMS params;
+    NvU32 a;
+
+    _reset(bEcho);
+    _roundTrip();
+
+    CHECK(_submit(100, &a) == NV_OK);
+    _gsp.bAutoRespond = NV_FALSE;
+    _gsp.timeoutPolls = 1;
+    CHECK(_collect(a, &params) == NV_ERR_TIMEOUT);
+    _gsp.bAutoRespond = NV_TRUE;
+
+    //
+    // With echoed sequences GSP may lose A's reply outright: the tombstone
+    // must not take the synchronous reply for it. Without them, A's late
+    // reply arrives first and is the one swallowed.
+    //
+    if (bEcho)
+        _gsp.dropReplies = 1;
+
+    CHECK(_control(200, &params) == NV_OK);
+    CHECK(_replyOrder(&params, 200) >= 0);
+    CHECK(_gsp.swallowed == (bEcho ? 0 : 1));
+    CHECK(_gsp.unexpected == 0);
+    CHECK(_pRpc->async.usedMask == 0);
+}
+
+static void _testSequenceWrap(void)
+{
+    TEST_PARAMS params;
+    NvU32 seq[4];
+    NvU32 i;
+
+    // Oldest-first matching must hold across the wrap, which skips 0.
+    _reset(NV_FALSE);
+    _pRpc->async.nextSequence = 0xFFFFFFFE;
+
+    for (i = 0; i < 4; i++)
+        CHECK(_submit(10 * i, &seq[i]) == NV_OK);
+    CHECK(seq[0] == 0xFFFFFFFF && seq[1] == 1);
+
+    for (i = 4; i > 0; i--)
+        CHECK(_collect(seq[i - 1], &params) == NV_OK && _replyOrder(&params, 10 * (i - 1)) == i - 1);
+    CHECK(_pRpc->async.usedMask == 0);
+}
+
+static void _batch(RPC_CONTROL_BATCH_ENTRY *pEntries, TEST_PARAMS *pParams, NvU32 count, NvU32 base)
+{
+    NvU32 i;
+
+    for (i = 0; i < count; i++)
+    {
+        _fill(&pParams[i], base + 100 * i);
+        pEntries[i].hClient    = 0xc1d00001;
+        pEntries[i].hObject    = 0x5000;
+        pEntries[i].cmd        = TEST_CMD;
+        pEntries[i].pParams    = &pParams[i];
+        pEntries[i].paramsSize = sizeof(pParams[i]);
+        pEntries[i].status     = NV_ERR_GENERIC;
+    }
+
+    CHECK(rpcRmApiControlBatch_GSP(&_rmApi, pEntries, count) == NV_OK);
+}
+
+//
+// _kgspRpcSendMessage() holds the doorbell back while a batch is queued, and
+// the first poll rings it once for all of them.
+//
+static void _testBatchDoorbell(void)
+{
+    RPC_CONTROL_BATCH_ENTRY entries[40];
+    TEST_PARAMS params[40];
+    NvS64 order, lastOrder;
+    NvU32 i;
+
+    _reset(NV_TRUE);
+    _batch(entries, params, 8, 0);
+    CHECK(_gsp.doorbells == 1);
+    for (i = 0; i < 8; i++)
+        CHECK(entries[i].status == NV_OK && _replyOrder(&params[i], 100 * i) == i);
+    CHECK(_pRpc->async.usedMask == 0);
+
+    // A queue that may not fit another command is handed over right away.
+    _reset(NV_TRUE);
+    _gsp.cmdQueue.capacity = 4;
+    _batch(entries, params, 12, 0);
+    CHECK(_gsp.doorbells > 1);
+    CHECK(_gsp.stalls == 0);
+    for (i = 0; i < 12; i++)
+        CHECK(entries[i].status == NV_OK && _replyOrder(&params[i], 100 * i) == i);
+
+    //
+    // More controls than the table holds: the rest are issued in place, and
+    // GSP still sees them all in order.
+    //
+    _reset(NV_FALSE);
+    _batch(entries, params, 40, 0);
+    lastOrder = -1;
+    for (i = 0; i < 40; i++)
+    {
+        order = _replyOrder(&params[i], 100 * i);
+        CHECK(entries[i].status == NV_OK && order > lastOrder);
+        lastOrder = order;
+    }
+    CHECK(_pRpc->async.usedMask == 0);
+    CHECK(_gsp.unexpected == 0);
+}
+
+static void _benchmark(NvU32 count, NvU64 latencyNs, NvU64 serviceNs)
+{
+    static const NvU32 depths[] = { 1, 2, 4, 8, 16, 32 };
+    NvU32 d;
+
+    for (d = 0; d < sizeof(depths) / sizeof(depths[0]); d++)
+    {
+        NvU32 outstanding[RPC_ASYNC_MAX_OUTSTANDING];
+        NvU32 bases[RPC_ASYNC_MAX_OUTSTANDING];
+        NvU32 numOutstanding = 0, submitted = 0, collected = 0;
+        NvU32 rng = 12345;
+        TEST_PARAMS params;
+        pthread_t thread;
+        NvU64 start, elapsed;
+
+        _reset(NV_TRUE);
+        _gsp.bThreaded = NV_TRUE;
+        _gsp.latencyNs = latencyNs;
+        _gsp.serviceNs = serviceNs;
+        pthread_create(&thread, NULL, _gspThread, NULL);
+
+        start = _nowNs();
+        while (collected < count)
+        {
+            if ((submitted < count) && (numOutstanding < depths[d]))
+            {
+                bases[numOutstanding] = 16 * submitted;
+                CHECK(_submit(bases[numOutstanding], &outstanding[numOutstanding]) == NV_OK);
+                numOutstanding++;
+                submitted++;
+            }
+            else
+            {
+                NvU32 pick;
+
+                rng = rng * 1103515245 + 12345;
+                pick = (rng >> 16) % numOutstanding;
+
+                CHECK(_collect(outstanding[pick], &params) == NV_OK);
+                CHECK(_replyOrder(&params, bases[pick]) >= 0);
+
+                outstanding[pick] = outstanding[numOutstanding - 1];
+                bases[pick] = bases[numOutstanding - 1];
+                numOutstanding--;
+                collected++;
+            }
+        }
+        elapsed = _nowNs() - start;
+
+        __atomic_store_n(&_gsp.bStop, NV_TRUE, __ATOMIC_RELEASE);
+        pthread_join(thread, NULL);
+
+        CHECK(_pRpc->async.usedMask == 0);
+        CHECK(_gsp.unexpected == 0);
+
+        printf("depth %2u: %8.0f RPCs/s\n", depths[d], count * 1e9 / elapsed);
+    }
+}
+
+//
+// Controls issued one at a time with rpcRmApiControl_GSP() against the same
+// controls issued with rpcRmApiControlBatch_GSP(), one doorbell per batch.
+//
+static void _benchmarkBatch(NvU32 count, NvU64 latencyNs, NvU64 serviceNs)
+{
+    static const NvU32 batchSizes[] = { 1, 4, 8, 16, 32 };
+    static RPC_CONTROL_BATCH_ENTRY entries[RPC_ASYNC_MAX_OUTSTANDING];
+    static TEST_PARAMS params[RPC_ASYNC_MAX_OUTSTANDING];
+    NvU32 b;
+
+    for (b = 0; b < sizeof(batchSizes) / sizeof(batchSizes[0]); b++)
+    {
+        NvU32 batchSize = batchSizes[b];
+        NvU32 done = 0;
+        pthread_t thread;
+        NvU64 start, elapsed;
+        NvU32 i;
+
+        _reset(NV_TRUE);
+        _gsp.bThreaded = NV_TRUE;
+        _gsp.latencyNs = latencyNs;
+        _gsp.serviceNs = serviceNs;
+        pthread_create(&thread, NULL, _gspThread, NULL);
+
+        start = _nowNs();
+        while (done < count)
+        {
+            if (batchSize == 1)
+            {
+                CHECK(_control(16 * done, &params[0]) == NV_OK);
+                CHECK(_replyOrder(&params[0], 16 * done) >= 0);
+                done++;
+                continue;
+            }
+
+            _batch(entries, params, batchSize, 16 * done);
+            for (i = 0; i < batchSize; i++)
+                CHECK(entries[i].status == NV_OK && _replyOrder(&params[i], 16 * done + 100 * i) >= 0);
+            done += batchSize;
+        }
+        elapsed = _nowNs() - start;
+
+        __atomic_store_n(&_gsp.bStop, NV_TRUE, __ATOMIC_RELEASE);
+        pthread_join(thread, NULL);
+
+        CHECK(_pRpc->async.usedMask == 0);
+        CHECK(_gsp.unexpected == 0);
+
+        printf("%-10s %2u: %8.0f RPCs/s, %u doorbells\n",
+               (batchSize == 1) ? "individual" : "batch", batchSize,
+               done * 1e9 / elapsed, _gsp.doorbells);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    NvU32 count     = (argc > 1) ? (NvU32)atoi(argv[1]) : 20000;
+    NvU64 latencyNs = (argc > 2) ? (NvU64)atoi(argv[2]) * 1000 : 20000;
+    NvU64 serviceNs = (argc > 3) ? (NvU64)atoi(argv[3]) * 1000 : 1000;
+
+    _testOutOfOrder(NV_TRUE);
+    _testOutOfOrder(NV_FALSE);
+    _testUncollected();
+    _testDrainHook(NV_TRUE);
+    _testDrainHook(NV_FALSE);
+    _testTombstone(NV_TRUE);
+    _testTombstone(NV_FALSE);
+    _testTombstoneSyncReply(NV_TRUE);
+    _testTombstoneSyncReply(NV_FALSE);
+    _testSequenceWrap();
+    _testBatchDoorbell();
+
+    printf("loopback latency %llu us, service %llu us\n",
+           (unsigned long long)latencyNs / 1000, (unsigned long long)serviceNs / 1000);
+    _benchmark(count, latencyNs, serviceNs);
+    _benchmarkBatch(count, latencyNs, serviceNs);
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Functions the GSP client RPC path references but rpc_async_test never
+ * reaches: event handlers and the RM services behind them. Each one aborts
+ * if called. They are declared without their RM prototypes; only the symbols
+ * matter.
+ */
+
+#include <stdlib.h>
+
+void *g_pSys;
+
+#define RPC_TEST_UNREACHABLE(fn) void fn(void) { abort(); }
+
+// Event handlers
+RPC_TEST_UNREACHABLE(CliGetEventInfo)
+RPC_TEST_UNREACHABLE(dispswReleaseSemaphoreAndNotifierFill)
+RPC_TEST_UNREACHABLE(gpuGetKernelFifoShared_IMPL)
+RPC_TEST_UNREACHABLE(gpuacctProcessGpuUtil)
+RPC_TEST_UNREACHABLE(heapStorePendingBlackList_IMPL)
+RPC_TEST_UNREACHABLE(kPerfGpuBoostSyncBridgelessUpdateInfo)
+RPC_TEST_UNREACHABLE(kdispInvokeRgLineCallback_KERNEL)
+RPC_TEST_UNREACHABLE(kfifoChidMgrGetKernelChannel_IMPL)
+RPC_TEST_UNREACHABLE(kfifoGetChidMgrFromType_IMPL)
+RPC_TEST_UNREACHABLE(kfifoGetChidMgr_IMPL)
+RPC_TEST_UNREACHABLE(kperfDoSyncGpuBoostLimits_IMPL)
+RPC_TEST_UNREACHABLE(kpmuLogBuf_IMPL)
+RPC_TEST_UNREACHABLE(krcCheckBusError_KERNEL)
+RPC_TEST_UNREACHABLE(krcErrorSendEventNotifications_KERNEL)
+RPC_TEST_UNREACHABLE(osEventNotification)
+RPC_TEST_UNREACHABLE(osNotifyEvent)
+RPC_TEST_UNREACHABLE(osQueueMMUFaultHandler)
+RPC_TEST_UNREACHABLE(sysGetOs_IMPL)
+
+// GSP log decoding, only with a GSP ELF loaded
+RPC_TEST_UNREACHABLE(libosExtractLogs)
+
+// Register access and delays outside the RPC path
+RPC_TEST_UNREACHABLE(osDelayUs)
+RPC_TEST_UNREACHABLE(regRead032)
+RPC_TEST_UNREACHABLE(regWrite032)
+
+// Lock upgrade, only without the GPU lock
+RPC_TEST_UNREACHABLE(rmGpuGroupLockAcquire)
+RPC_TEST_UNREACHABLE(rmGpuGroupLockRelease)
+
+// RPC profiling, only while enabled
+RPC_TEST_UNREACHABLE(osGetPerformanceCounter)
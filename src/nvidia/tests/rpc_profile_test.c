@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Accuracy of the RPC latency profile.
+ *
+ * rpc.c is included as shipped. Samples drawn from uniform, log-normal and
+ * exponential distributions are recorded with _rpcProfileRecord(), timed
+ * against a clock the test controls, and read back with rpcProfileGetStats().
+ * The reported p50 and p99 must lie within the bucket error of the exact
+ * percentiles of the same samples: an eighth of the value (half a bucket,
+ * buckets being a quarter of their lower bound wide), or half the 256ns
+ * resolution for the fastest RPCs.
+ *
+ *     rpc_profile_test [samples]
+ */
+
+#include "../kernel/vgpu/nv/rpc.c"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_FUNCTION   NV_VGPU_MSG_FUNCTION_GSP_RM_CONTROL
+#define TEST_CLOCK_NS   (1ULL << 40)
+
+static unsigned failures;
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+NV_STATUS osGetPerformanceCounter(NvU64 *pTime)
+{
+    *pTime = TEST_CLOCK_NS;
+    return NV_OK;
+}
+
+static NvU64 _rng = 0x9E3779B97F4A7C15ULL;
+
+// Uniform in (0, 1)
+static double _random(void)
+{
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 7;
+    _rng ^= _rng << 17;
+    return ((_rng >> 11) + 0.5) / 9007199254740992.0;
+}
+
+// 1us to 1ms
+static double _uniform(void)
+{
+    return 1000.0 + _random() * 999000.0;
+}
+
+// Median 50us, sigma 1
+static double _logNormal(void)
+{
+    double z = sqrt(-2.0 * log(_random())) * cos(2.0 * M_PI * _random());
+
+    return 50000.0 * exp(z);
+}
+
+// Mean 100us
+static double _exponential(void)
+{
+    return -100000.0 * log(_random());
+}
+
+static int _compare(const void *a, const void *b)
+{
+    NvU64 x = *(const NvU64 *)a;
+    NvU64 y = *(const NvU64 *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Exact percentile, with the rank rule _rpcProfilePercentile() uses
+static NvU64 _exactPercentile(const NvU64 *pSorted, NvU32 count, NvU32 percent)
+{
+    NvU64 rank = (((NvU64)count * percent) + 99) / 100;
+
+    return pSorted[rank - 1];
+}
+
+static NvBool _withinBucketError(NvU64 reported, NvU64 exact)
+{
+    NvU64 error = (reported > exact) ? (reported - exact) : (exact - reported);
+    NvU64 bound = NV_MAX(exact / 8, 1ULL << (RPC_PROFILE_UNIT_SHIFT - 1));
+
+    return error <= bound;
+}
+
+static void _testDistribution(const char *pName, double (*pSample)(void), NvU32 count)
+{
+    OBJRPC rpc = { 0 };
+    RPC_PROFILE_STATS stats;
+    NvU64 *pLatencies = malloc(count * sizeof(*pLatencies));
+    NvU64 p50, p99;
+    NvU32 i;
+
+    CHECK(rpcProfileEnable(NULL, &rpc, NV_TRUE) == NV_OK);
+
+    for (i = 0; i < count; i++)
+    {
+        pLatencies[i] = (NvU64)pSample();
+        _rpcProfileRecord(&rpc, TEST_FUNCTION, TEST_CLOCK_NS - pLatencies[i], 64, 64);
+    }
+
+    CHECK(rpcProfileGetStats(NULL, &rpc, TEST_FUNCTION, &stats) == NV_OK);
+    CHECK(stats.count == count);
+
+    qsort(pLatencies, count, sizeof(*pLatencies), _compare);
+    p50 = _exactPercentile(pLatencies, count, 50);
+    p99 = _exactPercentile(pLatencies, count, 99);
+
+    CHECK(stats.maxNs == pLatencies[count - 1]);
+    CHECK(_withinBucketError(stats.p50Ns, p50));
+    CHECK(_withinBucketError(stats.p99Ns, p99));
+
+    printf("%-12s p50 %8llu ns (exact %8llu, %+5.1f%%)  p99 %9llu ns (exact %9llu, %+5.1f%%)\n",
+           pName,
+           (unsigned long long)stats.p50Ns, (unsigned long long)p50,
+           100.0 * ((double)stats.p50Ns - p50) / p50,
+           (unsigned long long)stats.p99Ns, (unsigned long long)p99,
+           100.0 * ((double)stats.p99Ns - p99) / p99);
+
+    CHECK(rpcProfileEnable(NULL, &rpc, NV_FALSE) == NV_OK);
+    free(pLatencies);
+}
+
+//
+// Every bucket boundary: a sample on either side of it must report within
+// the bucket error, and samples past the last bucket are clamped to the max.
+//
+static void _testBoundaries(void)
+{
+    OBJRPC rpc = { 0 };
+    RPC_PROFILE_STATS stats;
+    NvU32 msb;
+
+    for (msb = RPC_PROFILE_UNIT_SHIFT; msb <= RPC_PROFILE_MAX_MSB + RPC_PROFILE_UNIT_SHIFT; msb++)
+    {
+        NvU64 values[] = { (1ULL << msb) - 1, 1ULL << msb, (1ULL << msb) + (1ULL << msb) / 4 };
+        NvU32 i;
+
+        for (i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+        {
+            CHECK(rpcProfileEnable(NULL, &rpc, NV_TRUE) == NV_OK);
+            _rpcProfileRecord(&rpc, TEST_FUNCTION, TEST_CLOCK_NS - values[i], 0, 0);
+            CHECK(rpcProfileGetStats(NULL, &rpc, TEST_FUNCTION, &stats) == NV_OK);
+            CHECK(_withinBucketError(stats.p50Ns, values[i]));
+            CHECK(rpcProfileEnable(NULL, &rpc, NV_FALSE) == NV_OK);
+        }
+    }
+
+    CHECK(rpcProfileEnable(NULL, &rpc, NV_TRUE) == NV_OK);
+    _rpcProfileRecord(&rpc, TEST_FUNCTION, TEST_CLOCK_NS - (1ULL << 38), 0, 0);
+    CHECK(rpcProfileGetStats(NULL, &rpc, TEST_FUNCTION, &stats) == NV_OK);
+    CHECK(stats.p99Ns == (1ULL << 38));
+    CHECK(rpcProfileEnable(NULL, &rpc, NV_FALSE) == NV_OK);
+}
+
+int main(int argc, char **argv)
+{
+    NvU32 count = (argc > 1) ? (NvU32)atoi(argv[1]) : 1000000;
+
+    _testBoundaries();
+    _testDistribution("uniform", _uniform, count);
+    _testDistribution("log-normal", _logNormal, count);
+    _testDistribution("exponential", _exponential, count);
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,340 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Resource server client table (rs_server.c) checks and benchmark.
+ *
+ * rs_server.c is included directly so the table helpers can be driven
+ * without NVOC client objects: a client here is a CLIENT_ENTRY whose
+ * pClient points at a per-thread marker. Locking follows RM: allocating
+ * and freeing a client holds the top lock for write, looking one up holds
+ * it for read.
+ *
+ * The functional checks cover handle allocation, lookups of live, freed
+ * and partially constructed clients, and caller-chosen duplicate handles.
+ *
+ * The benchmark runs threads that mix lookups of their own live clients
+ * with allocations and frees, and checks every lookup finds its client.
+ * It reports the operation rate per thread count for lookups as shipped
+ * and for lookups that also take the owning shard's spinlock, with a
+ * lookup-only mix and a churning one.
+ *
+ *     rs_client_table_test [operations per thread] [max threads]
+ */
+
+#include "resserv/src/rs_server.c"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CHECK(cond)                                                           \
+    do                                                                        \
+    {                                                                         \
+        if (!(cond))                                                          \
+        {                                                                     \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+static unsigned failures;
+
+#define ARRAY_COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+// Live clients each benchmark thread keeps
+#define THREAD_CLIENTS  64
+
+static RsServer    _server;
+static PORT_RWLOCK *_pTopLock;
+
+NV_STATUS serverInitGlobalSharePolicies(RsServer *pServer)
+{
+    return NV_OK;
+}
+
+static NvU64 _nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (NvU64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static NvU32 _random(NvU32 *pSeed)
+{
+    *pSeed = *pSeed * 1103515245 + 12345;
+    return *pSeed >> 8;
+}
+
+//
+// serverDestruct() without freeing clients, which needs NVOC objects; every
+// test frees the clients it allocated.
+//
+static void _serverDestruct(void)
+{
+    NvU32 i;
+
+    for (i = 0; i < RS_CLIENT_HANDLE_BUCKET_COUNT; i++)
+    {
+        CHECK(listHead(&_server.pClientSortedList[i]) == NULL);
+        listDestroy(&_server.pClientSortedList[i]);
+    }
+
+    PORT_FREE(_server.pAllocator, _server.pClientSortedList);
+    mapDestroy(&_server.shareMap);
+    listDestroy(&_server.defaultInheritedSharePolicyList);
+    listDestroy(&_server.globalInternalSharePolicyList);
+    portSyncSpinlockDestroy(_server.pShareMapLock);
+    _serverDestroyClientShards(&_server);
+    portMemAllocatorRelease(_server.pAllocator);
+}
+
+// serverAllocClient() without the NVOC client object
+static NvHandle _allocClient(NvHandle hClient, RsClient *pClient)
+{
+    CLIENT_ENTRY *pClientEntry;
+
+    portSyncRwLockAcquireWrite(_pTopLock);
+    if (_serverCreateEntryAndLockForNewClient(&_server, &hClient, NV_FALSE, &pClientEntry) != NV_OK)
+    {
+        hClient = 0;
+    }
+    else
+    {
+        pClientEntry->pClient = pClient;
+        _serverUnlockClient(&_server, LOCK_ACCESS_WRITE, hClient);
+    }
+    portSyncRwLockReleaseWrite(_pTopLock);
+
+    return hClient;
+}
+
+// _serverFreeClient_underlock() without the NVOC client object
+static void _freeClient(NvHandle hClient)
+{
+    RS_CLIENT_SHARD *pShard = CLIENT_SHARD(&_server, hClient);
+    CLIENT_ENTRY *pClientEntry;
+    PORT_RWLOCK *pLock;
+
+    portSyncRwLockAcquireWrite(_pTopLock);
+    if (_serverFindClientEntry(&_server, hClient, NV_FALSE, &pClientEntry) == NV_OK)
+    {
+        pLock = pClientEntry->pLock;
+        RS_RWLOCK_ACQUIRE_WRITE(pLock, &pClientEntry->lockVal);
+
+        portSyncSpinlockAcquire(pShard->pLock);
+        pClientEntry->pClient = NULL;
+        pClientEntry->hClient = 0;
+        portSyncSpinlockRelease(pShard->pLock);
+
+        _serverRemoveClientEntry(&_server, pClientEntry, hClient);
+
+        RS_RWLOCK_RELEASE_WRITE_EXT(pLock, &pClientEntry->lockVal, NV_TRUE);
+        portSyncRwLockDestroy(pLock);
+        PORT_FREE(_server.pAllocator, pClientEntry);
+    }
+    portSyncRwLockReleaseWrite(_pTopLock);
+}
+
+// The lookup with the shard spinlock around it, for comparison
+static NV_STATUS _findClientEntryShardLocked(NvHandle hClient, CLIENT_ENTRY **ppClientEntry)
+{
+    RS_CLIENT_SHARD *pShard = CLIENT_SHARD(&_server, hClient);
+    NV_STATUS status;
+
+    portSyncSpinlockAcquire(pShard->pLock);
+    status = _serverFindClientEntryUnderLock(&_server, hClient, NV_FALSE, ppClientEntry);
+    portSyncSpinlockRelease(pShard->pLock);
+
+    return status;
+}
+
+static NV_STATUS _findClientEntry(NvHandle hClient, NvBool bShardLocked, CLIENT_ENTRY **ppClientEntry)
+{
+    NV_STATUS status;
+
+    portSyncRwLockAcquireRead(_pTopLock);
+    status = bShardLocked ? _findClientEntryShardLocked(hClient, ppClientEntry) :
+                            _serverFindClientEntry(&_server, hClient, NV_FALSE, ppClientEntry);
+    portSyncRwLockReleaseRead(_pTopLock);
+
+    return status;
+}
+
+static void _testFunctional(void)
+{
+    static RsClient marker;
+    NvHandle handles[3 * RS_CLIENT_HANDLE_SHARD_COUNT];
+    CLIENT_ENTRY *pClientEntry;
+    NvHandle hPartial = 0;
+    NvU32 i, j;
+
+    for (i = 0; i < ARRAY_COUNT(handles); i++)
+    {
+        handles[i] = _allocClient(0, &marker);
+        CHECK(handles[i] != 0);
+        CHECK((handles[i] & ~RS_CLIENT_HANDLE_DECODE_MASK) == RS_CLIENT_HANDLE_BASE);
+        for (j = 0; j < i; j++)
+            CHECK(handles[j] != handles[i]);
+    }
+
+    for (i = 0; i < ARRAY_COUNT(handles); i++)
+    {
+        CHECK(_findClientEntry(handles[i], NV_FALSE, &pClientEntry) == NV_OK);
+        CHECK(pClientEntry != NULL && pClientEntry->hClient == handles[i]);
+        CHECK(pClientEntry != NULL && pClientEntry->pClient == &marker);
+    }
+
+    // A caller-chosen handle that is taken fails, a free one is used as is.
+    CHECK(_allocClient(handles[0], &marker) == 0);
+    CHECK(_allocClient(RS_CLIENT_HANDLE_BASE | 0x5000, &marker) == (RS_CLIENT_HANDLE_BASE | 0x5000));
+    _freeClient(RS_CLIENT_HANDLE_BASE | 0x5000);
+
+    // Freed clients are gone; their neighbours are not.
+    for (i = 0; i < ARRAY_COUNT(handles); i += 2)
+        _freeClient(handles[i]);
+    for (i = 0; i < ARRAY_COUNT(handles); i++)
+        CHECK((_findClientEntry(handles[i], NV_FALSE, &pClientEntry) == NV_OK) == (i % 2 == 1));
+
+    // A client still being constructed is only found as a partial entry.
+    portSyncRwLockAcquireWrite(_pTopLock);
+    CHECK(_serverCreateEntryAndLockForNewClient(&_server, &hPartial, NV_FALSE, &pClientEntry) == NV_OK);
+    CHECK(_serverFindClientEntry(&_server, hPartial, NV_FALSE, &pClientEntry) != NV_OK);
+    CHECK(_serverFindClientEntry(&_server, hPartial, NV_TRUE, &pClientEntry) == NV_OK);
+    pClientEntry->pClient = &marker;
+    _serverUnlockClient(&_server, LOCK_ACCESS_WRITE, hPartial);
+    portSyncRwLockReleaseWrite(_pTopLock);
+    _freeClient(hPartial);
+
+    for (i = 1; i < ARRAY_COUNT(handles); i += 2)
+        _freeClient(handles[i]);
+}
+
+typedef struct
+{
+    NvU32       seed;
+    NvU32       operations;
+    NvU32       churnPercent;
+    NvBool      bShardLocked;
+    RsClient    marker;
+    NvU32       badLookups;
+} BENCH_THREAD;
+
+static void *_benchThread(void *pArg)
+{
+    BENCH_THREAD *pThread = pArg;
+    NvHandle handles[THREAD_CLIENTS];
+    CLIENT_ENTRY *pClientEntry;
+    NvU32 i;
+
+    for (i = 0; i < THREAD_CLIENTS; i++)
+        handles[i] = _allocClient(0, &pThread->marker);
+
+    for (i = 0; i < pThread->operations; i++)
+    {
+        NvU32 r = _random(&pThread->seed);
+        NvU32 slot = r % THREAD_CLIENTS;
+
+        if ((r >> 16) % 100 < pThread->churnPercent)
+        {
+            _freeClient(handles[slot]);
+            handles[slot] = _allocClient(0, &pThread->marker);
+        }
+        else if ((_findClientEntry(handles[slot], pThread->bShardLocked, &pClientEntry) != NV_OK) ||
+                 (pClientEntry->pClient != &pThread->marker))
+        {
+            pThread->badLookups++;
+        }
+    }
+
+    for (i = 0; i < THREAD_CLIENTS; i++)
+        _freeClient(handles[i]);
+
+    return NULL;
+}
+
+static void _bench(NvU32 threadCount, NvU32 operations, NvU32 churnPercent, NvBool bShardLocked)
+{
+    BENCH_THREAD threads[64];
+    pthread_t tids[64];
+    NvU32 badLookups = 0;
+    NvU64 start, elapsed;
+    NvU32 i;
+
+    start = _nowNs();
+    for (i = 0; i < threadCount; i++)
+    {
+        portMemSet(&threads[i], 0, sizeof(threads[i]));
+        threads[i].seed = 0x9E3779B9 * (i + 1);
+        threads[i].operations = operations;
+        threads[i].churnPercent = churnPercent;
+        threads[i].bShardLocked = bShardLocked;
+        pthread_create(&tids[i], NULL, _benchThread, &threads[i]);
+    }
+    for (i = 0; i < threadCount; i++)
+    {
+        pthread_join(tids[i], NULL);
+        badLookups += threads[i].badLookups;
+    }
+    elapsed = _nowNs() - start;
+
+    CHECK(badLookups == 0);
+    CHECK(_server.activeClientCount == 0);
+
+    printf("%-12s churn %2u%% threads %2u: %10.0f ops/s\n",
+           bShardLocked ? "shard-locked" : "shipped", churnPercent, threadCount,
+           (double)threadCount * operations * 1e9 / elapsed);
+}
+
+int main(int argc, char **argv)
+{
+    NvU32 operations = (argc > 1) ? (NvU32)atoi(argv[1]) : 1000000;
+    NvU32 maxThreads = (argc > 2) ? (NvU32)atoi(argv[2]) : 16;
+    NvU32 churn[] = { 0, 10 };
+    NvU32 c, t;
+
+    if (maxThreads > 64)
+        maxThreads = 64;
+
+    CHECK(serverConstruct(&_server, RS_PRIV_LEVEL_USER, 0) == NV_OK);
+    _pTopLock = portSyncRwLockCreate(portMemAllocatorGetGlobalNonPaged());
+
+    _testFunctional();
+
+    for (c = 0; c < ARRAY_COUNT(churn); c++)
+    {
+        for (t = 1; t <= maxThreads; t *= 2)
+        {
+            _bench(t, operations, churn[c], NV_FALSE);
+            _bench(t, operations, churn[c], NV_TRUE);
+        }
+    }
+
+    portSyncRwLockDestroy(_pTopLock);
+    _serverDestruct();
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}